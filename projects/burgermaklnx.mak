@@ -273,6 +273,7 @@ OBJS:= $(TEMP_DIR)/bradler16.o \
 	$(TEMP_DIR)/brcompressdeflate.o \
 	$(TEMP_DIR)/brcompresslbmrle.o \
 	$(TEMP_DIR)/brcompresslzss.o \
+	$(TEMP_DIR)/brconcurrenthashmap.o \
 	$(TEMP_DIR)/brconditionvariable.o \
 	$(TEMP_DIR)/brconditionvariableunix.o \
 	$(TEMP_DIR)/brconsolemanager.o \
@@ -325,6 +326,7 @@ OBJS:= $(TEMP_DIR)/bradler16.o \
 	$(TEMP_DIR)/brfiletga.o \
 	$(TEMP_DIR)/brfileunix.o \
 	$(TEMP_DIR)/brfilexml.o \
+	$(TEMP_DIR)/brxmlreader.o \
 	$(TEMP_DIR)/brfixedmatrix3d.o \
 	$(TEMP_DIR)/brfixedmatrix4d.o \
 	$(TEMP_DIR)/brfixedpoint.o \
@@ -349,6 +351,7 @@ OBJS:= $(TEMP_DIR)/bradler16.o \
 	$(TEMP_DIR)/brfpinfo.o \
 	$(TEMP_DIR)/brfplargeint.o \
 	$(TEMP_DIR)/brfpprintinfo.o \
+	$(TEMP_DIR)/brfpdecimal.o \
 	$(TEMP_DIR)/brgameapp.o \
 	$(TEMP_DIR)/brglobalmemorymanager.o \
 	$(TEMP_DIR)/brglobals.o \
@@ -402,6 +405,7 @@ OBJS:= $(TEMP_DIR)/bradler16.o \
 	$(TEMP_DIR)/brpoint2d.o \
 	$(TEMP_DIR)/brpoweroftwo.o \
 	$(TEMP_DIR)/brprintf.o \
+	$(TEMP_DIR)/brlogsink.o \
 	$(TEMP_DIR)/brqueue.o \
 	$(TEMP_DIR)/brrandom.o \
 	$(TEMP_DIR)/brrandombase.o \
@@ -432,6 +436,7 @@ OBJS:= $(TEMP_DIR)/bradler16.o \
 	$(TEMP_DIR)/brstaticrtti.o \
 	$(TEMP_DIR)/brstdouthelpers.o \
 	$(TEMP_DIR)/brstring.o \
+	$(TEMP_DIR)/brstringatom.o \
 	$(TEMP_DIR)/brstring16.o \
 	$(TEMP_DIR)/brstring32.o \
 	$(TEMP_DIR)/brstringfunctions.o \
@@ -499,6 +504,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 	$(TEMP_DIR)/brcompressdeflate.d \
 	$(TEMP_DIR)/brcompresslbmrle.d \
 	$(TEMP_DIR)/brcompresslzss.d \
+	$(TEMP_DIR)/brconcurrenthashmap.d \
 	$(TEMP_DIR)/brconditionvariable.d \
 	$(TEMP_DIR)/brconditionvariableunix.d \
 	$(TEMP_DIR)/brconsolemanager.d \
@@ -551,6 +557,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 	$(TEMP_DIR)/brfiletga.d \
 	$(TEMP_DIR)/brfileunix.d \
 	$(TEMP_DIR)/brfilexml.d \
+	$(TEMP_DIR)/brxmlreader.d \
 	$(TEMP_DIR)/brfixedmatrix3d.d \
 	$(TEMP_DIR)/brfixedmatrix4d.d \
 	$(TEMP_DIR)/brfixedpoint.d \
@@ -575,6 +582,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 	$(TEMP_DIR)/brfpinfo.d \
 	$(TEMP_DIR)/brfplargeint.d \
 	$(TEMP_DIR)/brfpprintinfo.d \
+	$(TEMP_DIR)/brfpdecimal.d \
 	$(TEMP_DIR)/brgameapp.d \
 	$(TEMP_DIR)/brglobalmemorymanager.d \
 	$(TEMP_DIR)/brglobals.d \
@@ -628,6 +636,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 	$(TEMP_DIR)/brpoint2d.d \
 	$(TEMP_DIR)/brpoweroftwo.d \
 	$(TEMP_DIR)/brprintf.d \
+	$(TEMP_DIR)/brlogsink.d \
 	$(TEMP_DIR)/brqueue.d \
 	$(TEMP_DIR)/brrandom.d \
 	$(TEMP_DIR)/brrandombase.d \
@@ -658,6 +667,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 	$(TEMP_DIR)/brstaticrtti.d \
 	$(TEMP_DIR)/brstdouthelpers.d \
 	$(TEMP_DIR)/brstring.d \
+	$(TEMP_DIR)/brstringatom.d \
 	$(TEMP_DIR)/brstring16.d \
 	$(TEMP_DIR)/brstring32.d \
 	$(TEMP_DIR)/brstringfunctions.d \
@@ -742,6 +752,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 ../source/compression/brcompressdeflate.cpp \
 ../source/compression/brcompresslbmrle.cpp \
 ../source/compression/brcompresslzss.cpp \
+../source/compression/brconcurrenthashmap.cpp \
 ../source/compression/brcrc16.cpp \
 ../source/compression/brcrc32.cpp \
 ../source/compression/brdecompress.cpp \
@@ -779,6 +790,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 ../source/file/brinputmemorystream.cpp \
 ../source/file/broutputmemorystream.cpp \
 ../source/file/brrezfile.cpp \
+../source/file/brxmlreader.cpp \
 ../source/flashplayer/brflashaction.cpp \
 ../source/flashplayer/brflashactionvalue.cpp \
 ../source/flashplayer/brflashavm2.cpp \
@@ -870,6 +882,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 ../source/math/brfpinfo.cpp \
 ../source/math/brfplargeint.cpp \
 ../source/math/brfpprintinfo.cpp \
+../source/math/brfpdecimal.cpp \
 ../source/math/brmatrix3d.cpp \
 ../source/math/brmatrix4d.cpp \
 ../source/math/brpoweroftwo.cpp \
@@ -921,10 +934,12 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 ../source/text/brnumberto.cpp \
 ../source/text/brosstringfunctions.cpp \
 ../source/text/brprintf.cpp \
+../source/text/brlogsink.cpp \
 ../source/text/brsimplestring.cpp \
 ../source/text/brstring.cpp \
 ../source/text/brstring16.cpp \
 ../source/text/brstring32.cpp \
+../source/text/brstringatom.cpp \
 ../source/text/brstringfunctions.cpp \
 ../source/text/brutf16.cpp \
 ../source/text/brutf32.cpp \
@@ -1018,6 +1033,8 @@ $(TEMP_DIR)/brcompresslbmrle.o: ../source/compression/brcompresslbmrle.cpp ; $(B
 
 $(TEMP_DIR)/brcompresslzss.o: ../source/compression/brcompresslzss.cpp ; $(BUILD_CPP)
 
+$(TEMP_DIR)/brconcurrenthashmap.o: ../source/compression/brconcurrenthashmap.cpp ; $(BUILD_CPP)
+
 $(TEMP_DIR)/brcrc16.o: ../source/compression/brcrc16.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/brcrc32.o: ../source/compression/brcrc32.cpp ; $(BUILD_CPP)
@@ -1086,6 +1103,8 @@ $(TEMP_DIR)/brfiletga.o: ../source/file/brfiletga.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/brfilexml.o: ../source/file/brfilexml.cpp ; $(BUILD_CPP)
 
+$(TEMP_DIR)/brxmlreader.o: ../source/file/brxmlreader.cpp ; $(BUILD_CPP)
+
 $(TEMP_DIR)/brinputmemorystream.o: ../source/file/brinputmemorystream.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/broutputmemorystream.o: ../source/file/broutputmemorystream.cpp ; $(BUILD_CPP)
@@ -1274,6 +1293,8 @@ $(TEMP_DIR)/brfplargeint.o: ../source/math/brfplargeint.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/brfpprintinfo.o: ../source/math/brfpprintinfo.cpp ; $(BUILD_CPP)
 
+$(TEMP_DIR)/brfpdecimal.o: ../source/math/brfpdecimal.cpp ; $(BUILD_CPP)
+
 $(TEMP_DIR)/brmatrix3d.o: ../source/math/brmatrix3d.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/brmatrix4d.o: ../source/math/brmatrix4d.cpp ; $(BUILD_CPP)
@@ -1376,10 +1397,14 @@ $(TEMP_DIR)/brosstringfunctions.o: ../source/text/brosstringfunctions.cpp ; $(BU
 
 $(TEMP_DIR)/brprintf.o: ../source/text/brprintf.cpp ; $(BUILD_CPP)
 
+$(TEMP_DIR)/brlogsink.o: ../source/text/brlogsink.cpp ; $(BUILD_CPP)
+
 $(TEMP_DIR)/brsimplestring.o: ../source/text/brsimplestring.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/brstring.o: ../source/text/brstring.cpp ; $(BUILD_CPP)
 
+$(TEMP_DIR)/brstringatom.o: ../source/text/brstringatom.cpp ; $(BUILD_CPP)
+
 $(TEMP_DIR)/brstring16.o: ../source/text/brstring16.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/brstring32.o: ../source/text/brstring32.cpp ; $(BUILD_CPP)
@@ -274,6 +274,7 @@ OBJS:= $(TEMP_DIR)/bradler16.o \
 	$(TEMP_DIR)/brcompressdeflate.o \
 	$(TEMP_DIR)/brcompresslbmrle.o \
 	$(TEMP_DIR)/brcompresslzss.o \
+	$(TEMP_DIR)/brconcurrenthashmap.o \
 	$(TEMP_DIR)/brconditionvariable.o \
 	$(TEMP_DIR)/brconditionvariableunix.o \
 	$(TEMP_DIR)/brconsolemanager.o \
@@ -326,6 +327,7 @@ OBJS:= $(TEMP_DIR)/bradler16.o \
 	$(TEMP_DIR)/brfiletga.o \
 	$(TEMP_DIR)/brfileunix.o \
 	$(TEMP_DIR)/brfilexml.o \
+	$(TEMP_DIR)/brxmlreader.o \
 	$(TEMP_DIR)/brfixedmatrix3d.o \
 	$(TEMP_DIR)/brfixedmatrix4d.o \
 	$(TEMP_DIR)/brfixedpoint.o \
@@ -350,6 +352,7 @@ OBJS:= $(TEMP_DIR)/bradler16.o \
 	$(TEMP_DIR)/brfpinfo.o \
 	$(TEMP_DIR)/brfplargeint.o \
 	$(TEMP_DIR)/brfpprintinfo.o \
+	$(TEMP_DIR)/brfpdecimal.o \
 	$(TEMP_DIR)/brgameapp.o \
 	$(TEMP_DIR)/brglobalmemorymanager.o \
 	$(TEMP_DIR)/brglobals.o \
@@ -403,6 +406,7 @@ OBJS:= $(TEMP_DIR)/bradler16.o \
 	$(TEMP_DIR)/brpoint2d.o \
 	$(TEMP_DIR)/brpoweroftwo.o \
 	$(TEMP_DIR)/brprintf.o \
+	$(TEMP_DIR)/brlogsink.o \
 	$(TEMP_DIR)/brqueue.o \
 	$(TEMP_DIR)/brrandom.o \
 	$(TEMP_DIR)/brrandombase.o \
@@ -433,6 +437,7 @@ OBJS:= $(TEMP_DIR)/bradler16.o \
 	$(TEMP_DIR)/brstaticrtti.o \
 	$(TEMP_DIR)/brstdouthelpers.o \
 	$(TEMP_DIR)/brstring.o \
+	$(TEMP_DIR)/brstringatom.o \
 	$(TEMP_DIR)/brstring16.o \
 	$(TEMP_DIR)/brstring32.o \
 	$(TEMP_DIR)/brstringfunctions.o \
@@ -475,6 +480,12 @@ OBJS:= $(TEMP_DIR)/bradler16.o \
 	$(TEMP_DIR)/testbralgorithm.o \
 	$(TEMP_DIR)/testbrcodelibrary.o \
 	$(TEMP_DIR)/testbrcompression.o \
+	$(TEMP_DIR)/testbrimage.o \
+	$(TEMP_DIR)/testbrdxt.o \
+	$(TEMP_DIR)/testbrfilepng.o \
+	$(TEMP_DIR)/testbrfilegif.o \
+	$(TEMP_DIR)/testbrfileini.o \
+	$(TEMP_DIR)/testbrfilerle.o \
 	$(TEMP_DIR)/testbrdisplay.o \
 	$(TEMP_DIR)/testbrendian.o \
 	$(TEMP_DIR)/testbrfileloaders.o \
@@ -489,8 +500,11 @@ OBJS:= $(TEMP_DIR)/bradler16.o \
 	$(TEMP_DIR)/testbrprintf.o \
 	$(TEMP_DIR)/testbrstaticrtti.o \
 	$(TEMP_DIR)/testbrstrings.o \
+	$(TEMP_DIR)/testbrstringatom.o \
 	$(TEMP_DIR)/testbrtimedate.o \
 	$(TEMP_DIR)/testbrtypes.o \
+	$(TEMP_DIR)/testbroutputmemorystream.o \
+	$(TEMP_DIR)/testbrxmlreader.o \
 	$(TEMP_DIR)/testcharset.o \
 	$(TEMP_DIR)/testmacros.o \
 	$(TEMP_DIR)/unix_dbus.o \
@@ -522,6 +536,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 	$(TEMP_DIR)/brcompressdeflate.d \
 	$(TEMP_DIR)/brcompresslbmrle.d \
 	$(TEMP_DIR)/brcompresslzss.d \
+	$(TEMP_DIR)/brconcurrenthashmap.d \
 	$(TEMP_DIR)/brconditionvariable.d \
 	$(TEMP_DIR)/brconditionvariableunix.d \
 	$(TEMP_DIR)/brconsolemanager.d \
@@ -574,6 +589,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 	$(TEMP_DIR)/brfiletga.d \
 	$(TEMP_DIR)/brfileunix.d \
 	$(TEMP_DIR)/brfilexml.d \
+	$(TEMP_DIR)/brxmlreader.d \
 	$(TEMP_DIR)/brfixedmatrix3d.d \
 	$(TEMP_DIR)/brfixedmatrix4d.d \
 	$(TEMP_DIR)/brfixedpoint.d \
@@ -598,6 +614,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 	$(TEMP_DIR)/brfpinfo.d \
 	$(TEMP_DIR)/brfplargeint.d \
 	$(TEMP_DIR)/brfpprintinfo.d \
+	$(TEMP_DIR)/brfpdecimal.d \
 	$(TEMP_DIR)/brgameapp.d \
 	$(TEMP_DIR)/brglobalmemorymanager.d \
 	$(TEMP_DIR)/brglobals.d \
@@ -651,6 +668,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 	$(TEMP_DIR)/brpoint2d.d \
 	$(TEMP_DIR)/brpoweroftwo.d \
 	$(TEMP_DIR)/brprintf.d \
+	$(TEMP_DIR)/brlogsink.d \
 	$(TEMP_DIR)/brqueue.d \
 	$(TEMP_DIR)/brrandom.d \
 	$(TEMP_DIR)/brrandombase.d \
@@ -681,6 +699,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 	$(TEMP_DIR)/brstaticrtti.d \
 	$(TEMP_DIR)/brstdouthelpers.d \
 	$(TEMP_DIR)/brstring.d \
+	$(TEMP_DIR)/brstringatom.d \
 	$(TEMP_DIR)/brstring16.d \
 	$(TEMP_DIR)/brstring32.d \
 	$(TEMP_DIR)/brstringfunctions.d \
@@ -723,6 +742,12 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 	$(TEMP_DIR)/testbralgorithm.d \
 	$(TEMP_DIR)/testbrcodelibrary.d \
 	$(TEMP_DIR)/testbrcompression.d \
+	$(TEMP_DIR)/testbrimage.d \
+	$(TEMP_DIR)/testbrdxt.d \
+	$(TEMP_DIR)/testbrfilepng.d \
+	$(TEMP_DIR)/testbrfilegif.d \
+	$(TEMP_DIR)/testbrfileini.d \
+	$(TEMP_DIR)/testbrfilerle.d \
 	$(TEMP_DIR)/testbrdisplay.d \
 	$(TEMP_DIR)/testbrendian.d \
 	$(TEMP_DIR)/testbrfileloaders.d \
@@ -737,8 +762,11 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 	$(TEMP_DIR)/testbrprintf.d \
 	$(TEMP_DIR)/testbrstaticrtti.d \
 	$(TEMP_DIR)/testbrstrings.d \
+	$(TEMP_DIR)/testbrstringatom.d \
 	$(TEMP_DIR)/testbrtimedate.d \
 	$(TEMP_DIR)/testbrtypes.d \
+	$(TEMP_DIR)/testbroutputmemorystream.d \
+	$(TEMP_DIR)/testbrxmlreader.d \
 	$(TEMP_DIR)/testcharset.d \
 	$(TEMP_DIR)/testmacros.d \
 	$(TEMP_DIR)/unix_dbus.d \
@@ -787,6 +815,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 ../source/compression/brcompressdeflate.cpp \
 ../source/compression/brcompresslbmrle.cpp \
 ../source/compression/brcompresslzss.cpp \
+../source/compression/brconcurrenthashmap.cpp \
 ../source/compression/brcrc16.cpp \
 ../source/compression/brcrc32.cpp \
 ../source/compression/brdecompress.cpp \
@@ -824,6 +853,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 ../source/file/brinputmemorystream.cpp \
 ../source/file/broutputmemorystream.cpp \
 ../source/file/brrezfile.cpp \
+../source/file/brxmlreader.cpp \
 ../source/flashplayer/brflashaction.cpp \
 ../source/flashplayer/brflashactionvalue.cpp \
 ../source/flashplayer/brflashavm2.cpp \
@@ -915,6 +945,7 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 ../source/math/brfpinfo.cpp \
 ../source/math/brfplargeint.cpp \
 ../source/math/brfpprintinfo.cpp \
+../source/math/brfpdecimal.cpp \
 ../source/math/brmatrix3d.cpp \
 ../source/math/brmatrix4d.cpp \
 ../source/math/brpoweroftwo.cpp \
@@ -966,10 +997,12 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 ../source/text/brnumberto.cpp \
 ../source/text/brosstringfunctions.cpp \
 ../source/text/brprintf.cpp \
+../source/text/brlogsink.cpp \
 ../source/text/brsimplestring.cpp \
 ../source/text/brstring.cpp \
 ../source/text/brstring16.cpp \
 ../source/text/brstring32.cpp \
+../source/text/brstringatom.cpp \
 ../source/text/brstringfunctions.cpp \
 ../source/text/brutf16.cpp \
 ../source/text/brutf32.cpp \
@@ -987,6 +1020,12 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 ../unittest/testbrfixedpoint.cpp \
 ../unittest/testbrfloatingpoint.cpp \
 ../unittest/testbrhashes.cpp \
+../unittest/testbrimage.cpp \
+../unittest/testbrdxt.cpp \
+../unittest/testbrfilepng.cpp \
+../unittest/testbrfilegif.cpp \
+../unittest/testbrfileini.cpp \
+../unittest/testbrfilerle.cpp \
 ../unittest/testbrmatrix3d.cpp \
 ../unittest/testbrmatrix4d.cpp \
 ../unittest/testbrnumberto.cpp \
@@ -994,8 +1033,11 @@ DEPS:= $(TEMP_DIR)/bradler16.d \
 ../unittest/testbrprintf.cpp \
 ../unittest/testbrstaticrtti.cpp \
 ../unittest/testbrstrings.cpp \
+../unittest/testbrstringatom.cpp \
 ../unittest/testbrtimedate.cpp \
 ../unittest/testbrtypes.cpp \
+../unittest/testbroutputmemorystream.cpp \
+../unittest/testbrxmlreader.cpp \
 ../unittest/testcharset.cpp \
 ../unittest/testmacros.cpp \
 	: ;
@@ -1085,6 +1127,8 @@ $(TEMP_DIR)/brcompresslbmrle.o: ../source/compression/brcompresslbmrle.cpp ; $(B
 
 $(TEMP_DIR)/brcompresslzss.o: ../source/compression/brcompresslzss.cpp ; $(BUILD_CPP)
 
+$(TEMP_DIR)/brconcurrenthashmap.o: ../source/compression/brconcurrenthashmap.cpp ; $(BUILD_CPP)
+
 $(TEMP_DIR)/brcrc16.o: ../source/compression/brcrc16.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/brcrc32.o: ../source/compression/brcrc32.cpp ; $(BUILD_CPP)
@@ -1153,6 +1197,8 @@ $(TEMP_DIR)/brfiletga.o: ../source/file/brfiletga.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/brfilexml.o: ../source/file/brfilexml.cpp ; $(BUILD_CPP)
 
+$(TEMP_DIR)/brxmlreader.o: ../source/file/brxmlreader.cpp ; $(BUILD_CPP)
+
 $(TEMP_DIR)/brinputmemorystream.o: ../source/file/brinputmemorystream.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/broutputmemorystream.o: ../source/file/broutputmemorystream.cpp ; $(BUILD_CPP)
@@ -1341,6 +1387,8 @@ $(TEMP_DIR)/brfplargeint.o: ../source/math/brfplargeint.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/brfpprintinfo.o: ../source/math/brfpprintinfo.cpp ; $(BUILD_CPP)
 
+$(TEMP_DIR)/brfpdecimal.o: ../source/math/brfpdecimal.cpp ; $(BUILD_CPP)
+
 $(TEMP_DIR)/brmatrix3d.o: ../source/math/brmatrix3d.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/brmatrix4d.o: ../source/math/brmatrix4d.cpp ; $(BUILD_CPP)
@@ -1443,10 +1491,14 @@ $(TEMP_DIR)/brosstringfunctions.o: ../source/text/brosstringfunctions.cpp ; $(BU
 
 $(TEMP_DIR)/brprintf.o: ../source/text/brprintf.cpp ; $(BUILD_CPP)
 
+$(TEMP_DIR)/brlogsink.o: ../source/text/brlogsink.cpp ; $(BUILD_CPP)
+
 $(TEMP_DIR)/brsimplestring.o: ../source/text/brsimplestring.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/brstring.o: ../source/text/brstring.cpp ; $(BUILD_CPP)
 
+$(TEMP_DIR)/brstringatom.o: ../source/text/brstringatom.cpp ; $(BUILD_CPP)
+
 $(TEMP_DIR)/brstring16.o: ../source/text/brstring16.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/brstring32.o: ../source/text/brstring32.cpp ; $(BUILD_CPP)
@@ -1471,6 +1523,18 @@ $(TEMP_DIR)/testbrcodelibrary.o: ../unittest/testbrcodelibrary.cpp ; $(BUILD_CPP
 
 $(TEMP_DIR)/testbrcompression.o: ../unittest/testbrcompression.cpp ; $(BUILD_CPP)
 
+$(TEMP_DIR)/testbrimage.o: ../unittest/testbrimage.cpp ; $(BUILD_CPP)
+
+$(TEMP_DIR)/testbrdxt.o: ../unittest/testbrdxt.cpp ; $(BUILD_CPP)
+
+$(TEMP_DIR)/testbrfilepng.o: ../unittest/testbrfilepng.cpp ; $(BUILD_CPP)
+
+$(TEMP_DIR)/testbrfilegif.o: ../unittest/testbrfilegif.cpp ; $(BUILD_CPP)
+
+$(TEMP_DIR)/testbrfileini.o: ../unittest/testbrfileini.cpp ; $(BUILD_CPP)
+
+$(TEMP_DIR)/testbrfilerle.o: ../unittest/testbrfilerle.cpp ; $(BUILD_CPP)
+
 $(TEMP_DIR)/testbrdisplay.o: ../unittest/testbrdisplay.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/testbrendian.o: ../unittest/testbrendian.cpp ; $(BUILD_CPP)
@@ -1499,10 +1563,16 @@ $(TEMP_DIR)/testbrstaticrtti.o: ../unittest/testbrstaticrtti.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/testbrstrings.o: ../unittest/testbrstrings.cpp ; $(BUILD_CPP)
 
+$(TEMP_DIR)/testbrstringatom.o: ../unittest/testbrstringatom.cpp ; $(BUILD_CPP)
+
 $(TEMP_DIR)/testbrtimedate.o: ../unittest/testbrtimedate.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/testbrtypes.o: ../unittest/testbrtypes.cpp ; $(BUILD_CPP)
 
+$(TEMP_DIR)/testbroutputmemorystream.o: ../unittest/testbroutputmemorystream.cpp ; $(BUILD_CPP)
+
+$(TEMP_DIR)/testbrxmlreader.o: ../unittest/testbrxmlreader.cpp ; $(BUILD_CPP)
+
 $(TEMP_DIR)/testcharset.o: ../unittest/testcharset.cpp ; $(BUILD_CPP)
 
 $(TEMP_DIR)/testmacros.o: ../unittest/testmacros.cpp ; $(BUILD_CPP)
@@ -105,3 +105,48 @@ uint32_t BURGER_API Burger::calc_adler32(const void* pInput,
 	// Return the result
 	return uAdler32;
 }
+
+/*! ************************************
+
+	\brief Combine two Adler-32 checksums
+
+	Given the Adler-32 checksums of two buffers and the length of the
+	second buffer, return the Adler-32 checksum of both buffers as if they
+	were one. This allows pieces of a data stream to be checksummed in
+	parallel.
+
+	\param uAdler1 Adler-32 of the first buffer
+	\param uAdler2 Adler-32 of the second buffer
+	\param uLength2 Number of bytes in the second buffer
+
+	\return 32 bit Adler-32 checksum of both buffers
+
+	\sa calc_adler32(const void *, uintptr_t, uint32_t)
+
+***************************************/
+
+uint32_t BURGER_API Burger::combine_adler32(
+	uint32_t uAdler1, uint32_t uAdler2, uintptr_t uLength2) BURGER_NOEXCEPT
+{
+	// The factorial sum of the first buffer is added once per byte of the
+	// second buffer
+	const uint32_t uRemainder = static_cast<uint32_t>(uLength2 % LARGESTPRIME);
+	uint32_t uAdditive = uAdler1 & 0xFFFFU;
+	uint32_t uFactorial = (uRemainder * uAdditive) % LARGESTPRIME;
+	uAdditive += (uAdler2 & 0xFFFFU) + LARGESTPRIME - 1U;
+	uFactorial += (uAdler1 >> 16U) + (uAdler2 >> 16U) + LARGESTPRIME -
+		uRemainder;
+	if (uAdditive >= LARGESTPRIME) {
+		uAdditive -= LARGESTPRIME;
+	}
+	if (uAdditive >= LARGESTPRIME) {
+		uAdditive -= LARGESTPRIME;
+	}
+	if (uFactorial >= (LARGESTPRIME << 1U)) {
+		uFactorial -= (LARGESTPRIME << 1U);
+	}
+	if (uFactorial >= LARGESTPRIME) {
+		uFactorial -= LARGESTPRIME;
+	}
+	return (uFactorial << 16U) | uAdditive;
+}
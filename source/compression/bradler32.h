@@ -27,6 +27,8 @@
 namespace Burger {
 extern uint32_t BURGER_API calc_adler32(const void* pInput,
 	uintptr_t uInputLength, uint32_t uAdler32 = 1) BURGER_NOEXCEPT;
+extern uint32_t BURGER_API combine_adler32(
+	uint32_t uAdler1, uint32_t uAdler2, uintptr_t uLength2) BURGER_NOEXCEPT;
 }
 /* END */
 
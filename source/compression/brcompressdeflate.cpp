@@ -121,6 +121,15 @@ BURGER_CREATE_STATICRTTI_PARENT(Burger::CompressDeflate,Burger::Compress);
 
 ***************************************/
 
+/*! ************************************
+
+	\struct Burger::CompressDeflate::Config_t
+	\brief Match search settings for a compression level
+
+	\sa Burger::CompressDeflate::SetLevel(uint_t)
+
+***************************************/
+
 // extra bits for each length code
 
 const int Burger::CompressDeflate::g_ExtraLengthBits[LENGTH_CODES] = {
@@ -265,6 +274,20 @@ const uint8_t Burger::CompressDeflate::g_LengthCodes[MAX_MATCH-MIN_MATCH+1]= {
 	27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 28
 };
 
+// Match search settings for levels 1 through 9 (Same as zlib)
+
+const Burger::CompressDeflate::Config_t Burger::CompressDeflate::g_Configurations[9] = {
+	{4,4,8,4},			// 1 Fastest, greedy
+	{4,5,16,8},			// 2
+	{4,6,32,32},		// 3
+	{4,4,16,16},		// 4 Lazy matches
+	{8,16,32,32},		// 5
+	{8,16,128,128},		// 6 Default
+	{8,32,128,256},		// 7
+	{32,128,258,1024},	// 8
+	{32,258,258,4096}	// 9 Smallest
+};
+
 const int Burger::CompressDeflate::g_BaseLengths[LENGTH_CODES] = {
 	0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 14, 16, 20, 24, 28, 32, 40, 48, 56,
 	64, 80, 96, 112, 128, 160, 192, 224, 0
@@ -1183,12 +1206,12 @@ void Burger::CompressDeflate::FlushPending(void)
 
 uint_t Burger::CompressDeflate::LongestMatch(uint_t cur_match)
 {
-    unsigned chain_length = c_uMaxChainLength;/* max hash chain length */
+    unsigned chain_length = m_Config.m_uMaxChainLength;/* max hash chain length */
     uint8_t *scan = m_Window + m_uStringStart; /* current string */
     uint8_t *match;                       /* matched string */
     int len;                           /* length of current match */
     int best_len = static_cast<int>(m_uPreviousLength);              /* best match length so far */
-    int nice_match = c_iNiceMatch;             /* stop if match long enough */
+    int nice_match = m_Config.m_uNiceMatch;             /* stop if match long enough */
     uint_t limit = m_uStringStart > (uint_t)(c_uWSize-MIN_LOOKAHEAD) ?
         m_uStringStart - (uint_t)(c_uWSize-MIN_LOOKAHEAD) : 0;
     /* Stop when cur_match becomes <= limit. To simplify the code,
@@ -1210,7 +1233,7 @@ uint_t Burger::CompressDeflate::LongestMatch(uint_t cur_match)
      */
 
     /* Do not waste too much time if we already have a good match: */
-    if (m_uPreviousLength >= c_uGoodMatch) {
+    if (m_uPreviousLength >= m_Config.m_uGoodMatch) {
         chain_length >>= 2;
     }
     /* Do not look for matches beyond the end of the input. This is necessary
@@ -1269,6 +1292,88 @@ uint_t Burger::CompressDeflate::LongestMatch(uint_t cur_match)
     return m_uLookAhead;
 }
 
+/* ===========================================================================
+ * Compress as much as possible from the input stream, return the current
+ * block state.
+ * This function does not perform lazy evaluation of matches and inserts
+ * new strings in the dictionary only for unmatched strings or for short
+ * matches. It is used only for the fast compression options.
+ */
+Burger::CompressDeflate::eBlockState Burger::CompressDeflate::DeflateFast(int flush)
+{
+    uint_t hash_head = 0;    /* head of the hash chain */
+    int bflush;              /* set if current block must be flushed */
+
+    for (;;) {
+        /* Make sure that we always have enough lookahead, except
+         * at the end of the input file. We need MAX_MATCH bytes
+         * for the next match, plus MIN_MATCH bytes to insert the
+         * string following the next match.
+         */
+        if (m_uLookAhead < MIN_LOOKAHEAD) {
+            FillWindow();
+            if (m_uLookAhead < MIN_LOOKAHEAD && flush == Z_NO_FLUSH) {
+                return STATE_NEEDMORE;
+            }
+            if (m_uLookAhead == 0) break; /* flush the current block */
+        }
+
+        /* Insert the string window[strstart .. strstart+2] in the
+         * dictionary, and set hash_head to the head of the hash chain:
+         */
+        if (m_uLookAhead >= MIN_MATCH) {
+            hash_head = InsertString(m_uStringStart);
+        }
+
+        /* Find the longest match, discarding those <= prev_length.
+         * At this point we have always match_length < MIN_MATCH
+         */
+        if (hash_head != 0 && m_uStringStart - hash_head <= (c_uWSize-MIN_LOOKAHEAD)) {
+            /* To simplify the code, we prevent matches with the string
+             * of window index 0 (in particular we have to avoid a match
+             * of the string with itself at the start of the input file).
+             */
+            m_uMatchLength = LongestMatch(hash_head);
+            /* longest_match() sets match_start */
+        }
+        if (m_uMatchLength >= MIN_MATCH) {
+            bflush = static_cast<int>(TallyDistance(m_uStringStart - m_uMatchStart,m_uMatchLength - MIN_MATCH));
+
+            m_uLookAhead -= m_uMatchLength;
+
+            /* Insert new strings in the hash table only if the match length
+             * is not too large. This saves time but degrades compression.
+             */
+            if (m_uMatchLength <= m_Config.m_uMaxLazyMatch && m_uLookAhead >= MIN_MATCH) {
+                m_uMatchLength--; /* string at strstart already in hash table */
+                do {
+                    m_uStringStart++;
+                    hash_head = InsertString(m_uStringStart);
+                    /* strstart never exceeds WSIZE-MAX_MATCH, so there are
+                     * always MIN_MATCH bytes ahead.
+                     */
+                } while (--m_uMatchLength != 0);
+                m_uStringStart++;
+            } else {
+                m_uStringStart += m_uMatchLength;
+                m_uMatchLength = 0;
+                m_uInsertHash = UpdateHash(m_Window[m_uStringStart],m_Window[m_uStringStart+1]);
+                /* If lookahead < MIN_MATCH, ins_h is garbage, but it does not
+                 * matter since it will be recomputed at next deflate call.
+                 */
+            }
+        } else {
+            /* No match, output a literal byte */
+            bflush = static_cast<int>(TallyLiteral(m_Window[m_uStringStart]));
+            m_uLookAhead--;
+            m_uStringStart++;
+        }
+        if (bflush) FlushBlock(0);
+    }
+    FlushBlock(flush == Z_FINISH);
+    return flush == Z_FINISH ? STATE_FINISHDONE : STATE_BLOCKDONE;
+}
+
 /* ===========================================================================
  * Same as above, but achieves better compression. We use a lazy
  * evaluation for matches: a match is finally adopted only if there is
@@ -1307,7 +1412,7 @@ Burger::CompressDeflate::eBlockState Burger::CompressDeflate::DeflateSlow(int fl
 		m_uPreviousMatch = m_uMatchStart;
         m_uMatchLength = MIN_MATCH-1;
 
-        if (hash_head != 0 && m_uPreviousLength < c_uMaxLazyMatch &&
+        if (hash_head != 0 && m_uPreviousLength < m_Config.m_uMaxLazyMatch &&
             m_uStringStart - hash_head <= (c_uWSize-MIN_LOOKAHEAD)) {
             /* To simplify the code, we prevent matches with the string
              * of window index 0 (in particular we have to avoid a match
@@ -1510,8 +1615,9 @@ int Burger::CompressDeflate::DeflateInit(void)
 	m_uMatches = 0;
 	m_uLastEOBLength = 0;
 	m_uBitIndexBuffer = 0;
-    m_bNoHeader = 0;
+    m_bNoHeader = m_bRawMode ? 1 : 0;
     m_bMethod = (uint8_t)Z_DEFLATED;
+    m_Config = g_Configurations[m_uLevel-1];
 
     return DeflateReset();
 }
@@ -1536,7 +1642,7 @@ int Burger::CompressDeflate::PerformDeflate(int flush)
 	if (m_eState == INIT_STATE) {
 
 		uint_t header = (Z_DEFLATED + ((c_uWBits-8)<<4)) << 8;
-		uint_t level_flags = (Z_BEST_COMPRESSION-1) >> 1;
+		uint_t level_flags = (m_uLevel-1) >> 1;
 
 		if (level_flags > 3) level_flags = 3;
 		header |= (level_flags << 6);
@@ -1578,7 +1684,11 @@ int Burger::CompressDeflate::PerformDeflate(int flush)
 		(flush != Z_NO_FLUSH && m_eState != FINISH_STATE)) {
 		eBlockState bstate;
 
-		bstate = DeflateSlow(flush);
+		if (m_uLevel<=3) {
+			bstate = DeflateFast(flush);
+		} else {
+			bstate = DeflateSlow(flush);
+		}
 
 		if (bstate == STATE_FINISHSTARTED || bstate == STATE_FINISHDONE) {
 			m_eState = FINISH_STATE;
@@ -1633,7 +1743,9 @@ int Burger::CompressDeflate::PerformDeflate(int flush)
 
 Burger::CompressDeflate::CompressDeflate() :
 	Compress(),
-	m_bInitialized(FALSE)
+	m_bInitialized(FALSE),
+	m_uLevel(LEVEL_BEST),
+	m_bRawMode(FALSE)
 {
 	m_uSignature = Signature;
 }
@@ -1704,6 +1816,98 @@ Burger::eError Burger::CompressDeflate::Finalize(void)
 	return kErrorNone;
 }
 
+/*! ************************************
+
+	\brief Flush the compressed data to a byte boundary
+
+	Compress all of the data passed to Process() so far and append an empty
+	stored block so the output ends on a byte boundary. The stream is not
+	finished, so more data can be passed to Process() afterwards.
+
+	Streams compressed in pieces with SetRawMode(TRUE) and ended with
+	Flush() can be concatenated into a single deflate stream, as long as the
+	last piece is ended with Finalize().
+
+	\return Zero if no error, non-zero on error
+	\sa Finalize() or SetRawMode(uint_t)
+
+***************************************/
+
+Burger::eError BURGER_API Burger::CompressDeflate::Flush(void)
+{
+	if (!m_bInitialized) {
+		if (DeflateInit()!=Z_OK) {
+			return kErrorOutOfMemory;
+		}
+	}
+	m_pInput = 0;
+	m_uInputLength = 0;
+	int err = PerformDeflate(Z_SYNC_FLUSH);
+	if (err!=Z_OK && err!=Z_BUF_ERROR) {
+		return kErrorOutOfMemory;
+	}
+	return kErrorNone;
+}
+
+/*! ************************************
+
+	\brief Set the compression level
+
+	Level 1 is the fastest and level 9 creates the smallest output. Levels
+	1 through 3 use greedy matching and levels 4 through 9 use lazy
+	matching with longer searches as the level increases. The default is
+	\ref LEVEL_BEST. Call this before the first call to Process() or after
+	Init().
+
+	\param uLevel Compression level 1 through 9, out of range values are clamped
+	\sa GetLevel() const
+
+***************************************/
+
+void BURGER_API Burger::CompressDeflate::SetLevel(uint_t uLevel)
+{
+	if (uLevel<LEVEL_FASTEST) {
+		uLevel = LEVEL_FASTEST;
+	} else if (uLevel>LEVEL_BEST) {
+		uLevel = LEVEL_BEST;
+	}
+	m_uLevel = uLevel;
+}
+
+/*! ************************************
+
+	\fn uint_t Burger::CompressDeflate::GetLevel(void) const
+	\brief Get the compression level
+
+	\return Compression level 1 through 9
+	\sa SetLevel(uint_t)
+
+***************************************/
+
+/*! ************************************
+
+	\fn void Burger::CompressDeflate::SetRawMode(uint_t bRawMode)
+	\brief Enable or disable the zlib wrapper
+
+	If \ref TRUE, the output is a raw deflate stream without the two byte
+	zlib header and the Adler-32 checksum. Call this before the first call
+	to Process() or after Init().
+
+	\param bRawMode \ref TRUE to omit the zlib header and checksum
+	\sa GetRawMode() const or Flush()
+
+***************************************/
+
+/*! ************************************
+
+	\fn uint_t Burger::CompressDeflate::GetRawMode(void) const
+	\brief Get the zlib wrapper setting
+
+	\return \ref TRUE if the zlib header and checksum are omitted
+	\sa SetRawMode(uint_t)
+
+***************************************/
+
 /*! ************************************
 
 	\var const Burger::StaticRTTI Burger::CompressDeflate::g_StaticRTTI
@@ -127,10 +127,13 @@ protected:
 	static const uint_t c_uHashShift = ((c_uHashBits+MIN_MATCH-1)/MIN_MATCH);		///< Number of bits by which m_uInsertHash must be shifted at each input step. It must be such that after MIN_MATCH steps, the oldest byte no longer takes part in the hash key, that is: hash_shift * MIN_MATCH >= hash_bits
 	static const uint_t c_uLiteralBufferSize = 1 << (MAX_MEM_LEVEL + 6);	///< 16K elements by default
 	static const uint_t c_uWindowSize = 2*c_uWSize;		///< Actual size of window: 2*wSize, except when the user input buffer is directly used as sliding window.
-	static const uint_t c_uMaxLazyMatch = 258;	///< Attempt to find a better match only when the current match is strictly smaller than this value. This mechanism is used only for compression levels >= 4.
-	static const uint_t c_uGoodMatch = 32;
-	static const int c_iNiceMatch = 258;		///< Stop searching when current match exceeds this
-	static const uint_t c_uMaxChainLength = 4096;	///< To speed up deflation, hash chains are never searched beyond this length.  A higher limit improves compression ratio but degrades the speed.
+
+	struct Config_t {
+		uint16_t m_uGoodMatch;		///< Reduce the search when the previous match is at least this long
+		uint16_t m_uMaxLazyMatch;	///< Attempt to find a better match only when the current match is strictly smaller than this value. For levels 1-3, the longest match that is inserted into the hash table.
+		uint16_t m_uNiceMatch;		///< Stop searching when current match exceeds this
+		uint16_t m_uMaxChainLength;	///< To speed up deflation, hash chains are never searched beyond this length.  A higher limit improves compression ratio but degrades the speed.
+	};
 
 	const uint8_t *m_pInput;		///< Next input byte
 	uint8_t *m_pPendingOutput;	///< Next pending byte to output to the stream
@@ -152,6 +155,9 @@ protected:
 	uint_t m_uBitIndexBuffer;		///< Number of valid bits in bi_buf.  All bits above the last valid bit are always zero.
 	uint_t m_uBitIndexValid;		///< Number of bits in the output buffer
 	uint_t m_bInitialized;		///< \ref TRUE if initialized
+	uint_t m_uLevel;			///< Compression level (1-9)
+	uint_t m_bRawMode;			///< \ref TRUE to omit the zlib header and checksum
+	Config_t m_Config;			///< Match search settings for m_uLevel
 	uint_t m_uLastEOBLength;		///< bit length of EOB code for last block
 	int m_iPending;				///< Number of bytes in the pending buffer
 	int m_bNoHeader;			///< Suppress zlib header and adler32
@@ -301,6 +307,7 @@ protected:
 	void FlushBlock(const uint8_t *buf,uint32_t stored_len,uint_t bEOF);
 	void FlushPending(void);
 	uint_t LongestMatch(uint_t cur_match);
+	eBlockState DeflateFast(int flush);
 	eBlockState DeflateSlow(int flush);
 	void Align(void);
 	int DeflateEnd(void);
@@ -322,12 +329,23 @@ protected:
 	static const StaticTreeDesc_t g_StaticBitLengthDescription;
 	static const uint8_t g_DistanceCodes[DIST_CODE_LEN];
 	static const uint8_t g_LengthCodes[MAX_MATCH-MIN_MATCH+1];
+	static const Config_t g_Configurations[9];
 public:
+	enum {
+		LEVEL_FASTEST=1,		///< Fastest compression, greedy matching
+		LEVEL_DEFAULT=6,		///< Balance between speed and size
+		LEVEL_BEST=9			///< Smallest output (Default)
+	};
 	static const uint32_t Signature = 0x5A4C4942;		///< 'ZLIB'
 	CompressDeflate(void);
 	eError Init(void) BURGER_OVERRIDE;
 	eError Process(const void *pInput, uintptr_t uInputLength) BURGER_OVERRIDE;
 	eError Finalize(void) BURGER_OVERRIDE;
+	eError BURGER_API Flush(void);
+	void BURGER_API SetLevel(uint_t uLevel);
+	BURGER_INLINE uint_t GetLevel(void) const { return m_uLevel; }
+	BURGER_INLINE void SetRawMode(uint_t bRawMode) { m_bRawMode = bRawMode; }
+	BURGER_INLINE uint_t GetRawMode(void) const { return m_bRawMode; }
 };
 }
 /* END */
@@ -0,0 +1,443 @@
+/***************************************
+
+	Concurrent HashMap template for sharing a key to data lookup between
+	threads
+
+	Copyright (c) 1995-2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#include "brconcurrenthashmap.h"
+#include "brglobalmemorymanager.h"
+#include "brpoweroftwo.h"
+
+/*! ************************************
+
+	\class Burger::ConcurrentHashMapShared
+	\brief Base class for ConcurrentHashMap
+
+	ConcurrentHashMap splits its key space into a power of 2 number of shards,
+	each one a HashMap guarded by its own Mutex. Threads that access keys that
+	land in different shards never contend for the same lock.
+
+	This class contains the code that doesn't depend on the key or data types,
+	namely the shard allocation and the selection of a shard from a key.
+
+	\note This class is not intended to be directly used,
+		it's intended to be derived to allow its functionality
+		to be shared with different ConcurrentHashMap template types
+
+	\sa ConcurrentHashMap or HashMap
+
+***************************************/
+
+/*! ************************************
+
+	\brief Default constructor
+
+	Initialize the shared variables. No memory is allocated, the derived class
+	must call AllocateShards() to create the shard array.
+
+	\param pHashFunction Function that hashes the key value
+	\param uShardSize Size in bytes of each shard object
+
+	\sa AllocateShards(uintptr_t)
+
+***************************************/
+
+Burger::ConcurrentHashMapShared::ConcurrentHashMapShared(
+	HashProc pHashFunction, uintptr_t uShardSize) BURGER_NOEXCEPT
+	: m_pAllocation(nullptr),
+	  m_pShards(nullptr),
+	  m_uShardStride(
+		  (uShardSize + (kShardAlignment - 1)) & (~(kShardAlignment - 1))),
+	  m_uShardMask(0),
+	  m_pHashFunction(pHashFunction)
+{
+}
+
+/*! ************************************
+
+	\brief Allocate memory for the shards
+
+	Round the shard count up to the nearest power of 2 and allocate the memory
+	for the shards. Each shard is padded to \ref kShardAlignment bytes and the
+	array itself starts on a \ref kShardAlignment boundary so that two locks
+	never share a cache line. The shards are not constructed, that's the job of
+	the derived class.
+
+	\param uShardCount Number of shards requested, zero is treated as one.
+
+	\return Pointer to the shard memory or \ref nullptr on failure.
+
+	\sa ReleaseShards(void)
+
+***************************************/
+
+void* BURGER_API Burger::ConcurrentHashMapShared::AllocateShards(
+	uintptr_t uShardCount) BURGER_NOEXCEPT
+{
+	// The shard index is taken from a 16 bit field, cap it.
+	if (uShardCount > 0x10000U) {
+		uShardCount = 0x10000U;
+	}
+	if (!uShardCount) {
+		uShardCount = 1;
+	}
+	uShardCount = power_of_two(uShardCount);
+
+	// The memory manager doesn't guarantee cache line alignment, so allocate
+	// extra memory and align the start of the array manually.
+	void* pAllocation = allocate_memory_clear(
+		(uShardCount * m_uShardStride) + (kShardAlignment - 1));
+	m_pAllocation = pAllocation;
+	uint8_t* pShards = nullptr;
+	if (pAllocation) {
+		pShards = reinterpret_cast<uint8_t*>(
+			(reinterpret_cast<uintptr_t>(pAllocation) +
+				(kShardAlignment - 1)) &
+			(~(kShardAlignment - 1)));
+		m_uShardMask = uShardCount - 1;
+	}
+	m_pShards = pShards;
+	return pShards;
+}
+
+/*! ************************************
+
+	\brief Release memory for the shards
+
+	Release the memory allocated by AllocateShards(uintptr_t). The derived
+	class must have destroyed the shard objects before calling this function.
+
+	\sa AllocateShards(uintptr_t)
+
+***************************************/
+
+void BURGER_API Burger::ConcurrentHashMapShared::ReleaseShards(
+	void) BURGER_NOEXCEPT
+{
+	free_memory(m_pAllocation);
+	m_pAllocation = nullptr;
+	m_pShards = nullptr;
+	m_uShardMask = 0;
+}
+
+/*! ************************************
+
+	\brief Select the shard for a key
+
+	Hash the key with the same function the shards use and scramble the result
+	so the shard index is taken from different bits than the ones each HashMap
+	uses for its bucket index. This keeps the buckets in every shard evenly
+	filled.
+
+	\param pKey Pointer to the key value
+	\param uKeySize Size in bytes of the key
+
+	\return Index of the shard that holds the key
+
+	\sa GetShard(uintptr_t) const
+
+***************************************/
+
+uintptr_t BURGER_API Burger::ConcurrentHashMapShared::GetShardIndex(
+	const void* pKey, uintptr_t uKeySize) const BURGER_NOEXCEPT
+{
+	// Fibonacci hashing, the upper bits are influenced by every input bit
+	const uint32_t uHash =
+		static_cast<uint32_t>(m_pHashFunction(pKey, uKeySize)) * 0x9E3779B1U;
+	return static_cast<uintptr_t>(uHash >> 16U) & m_uShardMask;
+}
+
+/*! ************************************
+
+	\fn void *Burger::ConcurrentHashMapShared::GetShard(uintptr_t uIndex) const
+	\brief Get the pointer to a shard
+
+	\param uIndex Index of the shard
+	\return Pointer to the shard object
+
+	\sa GetShardIndex(const void*, uintptr_t) const
+
+***************************************/
+
+/*! ************************************
+
+	\fn uint_t Burger::ConcurrentHashMapShared::is_valid(void) const
+	\brief Test if the shards were allocated
+
+	If the memory for the shards couldn't be allocated, the map is always
+	empty, lookups fail and set(const T&, const U&) returns \ref
+	kErrorOutOfMemory.
+
+	\return \ref TRUE if the map is usable, \ref FALSE if out of memory.
+
+***************************************/
+
+/*! ************************************
+
+	\fn uintptr_t Burger::ConcurrentHashMapShared::get_shard_count(void) const
+	\brief Get the number of shards
+
+	\return Number of shards, always a power of 2, or zero if out of memory.
+
+***************************************/
+
+/*! ************************************
+
+	\class Burger::ConcurrentHashMap
+	\brief Key / data pair hash that can be shared between threads
+
+	ConcurrentHashMap is a template class that performs the same job as HashMap
+	but can be accessed by multiple threads at the same time without an
+	external lock.
+
+	The keys are spread across a power of 2 number of shards, each shard is a
+	HashMap with its own Mutex. Only the shard that contains the key is locked
+	for an operation, so threads working on different keys rarely block each
+	other.
+
+	Since another thread can modify the map at any time, data is never returned
+	by reference. All lookups copy the data into a buffer supplied by the
+	caller.
+
+	\sa ConcurrentHashMapShared, HashMap, ConcurrentHashMapString or
+		ConcurrentHashMapStringCase
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::ConcurrentHashMap::ConcurrentHashMap(HashProc pHashFunction,
+		uintptr_t uShardCount)
+	\brief Default constructor
+
+	Create an empty hash with the requested number of shards.
+
+	\param pHashFunction Function that hashes the key value
+	\param uShardCount Number of shards, rounded up to a power of 2
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::ConcurrentHashMap::ConcurrentHashMap(HashProc pHashFunction,
+		TestProc pTestFunction, uintptr_t uShardCount)
+	\brief Constructor with custom key test
+
+	Create an empty hash with the requested number of shards and use a custom
+	function to test for key equality.
+
+	\param pHashFunction Function that hashes the key value
+	\param pTestFunction Function that returns \ref TRUE if the keys match
+	\param uShardCount Number of shards, rounded up to a power of 2
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::ConcurrentHashMap::~ConcurrentHashMap()
+	\brief Destructor
+
+	Release all of the shards and their contents. No other thread may be
+	accessing this class when it's destroyed.
+
+***************************************/
+
+/*! ************************************
+
+	\fn uint_t Burger::ConcurrentHashMap::find(const T& rKey,U* pOutput) const
+	\brief Find data and copy it out
+
+	Look up the key and if found, copy the data into pOutput.
+
+	\param rKey Reference to the key to look up
+	\param pOutput Pointer to the buffer to receive the data
+
+	\return \ref TRUE if found, \ref FALSE if not and pOutput is untouched.
+
+	\sa contains(const T&) const or find_or_insert(const T&, const U&, U*)
+
+***************************************/
+
+/*! ************************************
+
+	\fn uint_t Burger::ConcurrentHashMap::contains(const T& rKey) const
+	\brief Test if a key is in the hash
+
+	\param rKey Reference to the key to look up
+
+	\return \ref TRUE if found, \ref FALSE if not.
+
+	\sa find(const T&, U*) const
+
+***************************************/
+
+/*! ************************************
+
+	\fn eError Burger::ConcurrentHashMap::set(const T& rKey,const U& rValue)
+	\brief Set a new or existing value under the key
+
+	\param rKey Reference to the key to set
+	\param rValue Reference to the data to store
+
+	\return \ref kErrorNone or \ref kErrorOutOfMemory if the shards couldn't
+		be allocated.
+
+	\sa find_or_insert(const T&, const U&, U*)
+
+***************************************/
+
+/*! ************************************
+
+	\fn uint_t Burger::ConcurrentHashMap::find_or_insert(const T& rKey,
+		const U& rValue,U* pOutput)
+	\brief Find existing data or insert new data
+
+	As a single atomic operation, look up the key. If it exists, the existing
+	data is copied into pOutput, otherwise rValue is inserted under the key and
+	copied into pOutput. This allows multiple threads to race to create an
+	entry and all of them will agree on the result.
+
+	\param rKey Reference to the key to look up
+	\param rValue Reference to the data to insert if the key is not present
+	\param pOutput Pointer to the buffer to receive the data, can be \ref
+		nullptr
+
+	\return \ref TRUE if rValue was inserted, \ref FALSE if the key already
+		existed or the shards couldn't be allocated.
+
+	\sa find(const T&, U*) const or set(const T&, const U&)
+
+***************************************/
+
+/*! ************************************
+
+	\fn void Burger::ConcurrentHashMap::erase(const T& rKey)
+	\brief Remove an entry
+
+	If the key is in the hash, remove it.
+
+	\param rKey Reference to the key to remove
+
+***************************************/
+
+/*! ************************************
+
+	\fn void Burger::ConcurrentHashMap::clear(void)
+	\brief Remove all entries
+
+	Each shard is locked and cleared in turn. Entries inserted by other threads
+	into shards that were already cleared will remain.
+
+***************************************/
+
+/*! ************************************
+
+	\fn uintptr_t Burger::ConcurrentHashMap::size(void) const
+	\brief Get the number of entries
+
+	Each shard is locked and counted in turn, so if other threads are
+	modifying the map, the value is only an approximation.
+
+	\return Number of entries in all of the shards
+
+***************************************/
+
+/*! ************************************
+
+	\fn void Burger::ConcurrentHashMap::for_each(ForEachProc pProc,
+		void* pContext) const
+	\brief Call a function for every entry
+
+	Each shard is locked in turn and every entry in it is passed to the
+	callback. The contents of a shard are consistent during the callback, but
+	shards already visited may be modified by other threads.
+
+	\note The callback must not call back into this ConcurrentHashMap or a
+		deadlock will occur.
+
+	\param pProc Function to call for each entry
+	\param pContext Pointer passed to the callback
+
+	\sa snapshot(HashMap<T, U>*) const
+
+***************************************/
+
+/*! ************************************
+
+	\fn void Burger::ConcurrentHashMap::snapshot(HashMap<T, U>* pOutput) const
+	\brief Copy all entries into a HashMap
+
+	Each shard is locked in turn and its contents are copied into a HashMap
+	that the caller can iterate over without holding any locks. Entries already
+	in pOutput are kept or replaced.
+
+	\param pOutput Pointer to the HashMap to receive the entries
+
+	\sa for_each(ForEachProc, void*) const
+
+***************************************/
+
+/*! ************************************
+
+	\class Burger::ConcurrentHashMapString
+	\brief String key / data pair hash that can be shared between threads
+
+	ConcurrentHashMapString is a ConcurrentHashMap using a String as a key
+	value, with the same hashing as HashMapString.
+
+	\note String hashing is case sensitive. For case insensitive
+		hashing, use ConcurrentHashMapStringCase
+
+	\sa DJB2StringHashXorFunctor, ConcurrentHashMap or HashMapString
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::ConcurrentHashMapString::ConcurrentHashMapString(
+		uintptr_t uShardCount)
+	\brief Default constructor.
+
+	Create an empty hash and select to a case sensitive String hash algorithm.
+
+	\param uShardCount Number of shards, rounded up to a power of 2
+
+***************************************/
+
+/*! ************************************
+
+	\class Burger::ConcurrentHashMapStringCase
+	\brief Case insensitive String key / data pair hash that can be shared
+		between threads
+
+	ConcurrentHashMapStringCase is a ConcurrentHashMap using a String as a key
+	value, with the same hashing as HashMapStringCase.
+
+	\note String hashing is case insensitive. For case sensitive hashing, use
+		ConcurrentHashMapString
+
+	\sa DJB2StringHashXorCaseFunctor, ConcurrentHashMap or HashMapStringCase
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::ConcurrentHashMapStringCase::ConcurrentHashMapStringCase(
+		uintptr_t uShardCount)
+	\brief Default constructor.
+
+	Create an empty hash and select to a case insensitive String hash
+	algorithm.
+
+	\param uShardCount Number of shards, rounded up to a power of 2
+
+***************************************/
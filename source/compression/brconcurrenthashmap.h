@@ -0,0 +1,313 @@
+/***************************************
+
+	Concurrent HashMap template for sharing a key to data lookup between
+	threads
+
+	Copyright (c) 1995-2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#ifndef __BRCONCURRENTHASHMAP_H__
+#define __BRCONCURRENTHASHMAP_H__
+
+#ifndef __BRTYPES_H__
+#include "brtypes.h"
+#endif
+
+#ifndef __BRERROR_H__
+#include "brerror.h"
+#endif
+
+#ifndef __BRHASHMAP_H__
+#include "brhashmap.h"
+#endif
+
+#ifndef __BRMUTEX_H__
+#include "brmutex.h"
+#endif
+
+/* BEGIN */
+namespace Burger {
+class ConcurrentHashMapShared {
+	BURGER_DISABLE_COPY(ConcurrentHashMapShared);
+
+public:
+	/** Default number of shards, must be a power of 2 */
+	static const uintptr_t kDefaultShardCount = 16;
+	/** Each shard is padded to this size to avoid false sharing */
+	static const uintptr_t kShardAlignment = 64;
+
+protected:
+	/** Function prototype for user supplied hash generator */
+	typedef uintptr_t(BURGER_API* HashProc)(
+		const void* pData, uintptr_t uDataSize);
+	/** Function prototype for testing keys */
+	typedef uint_t(BURGER_API* TestProc)(const void* pA, const void* pB);
+
+	/** Pointer to the memory block holding the shards, used for freeing */
+	void* m_pAllocation;
+	/** Pointer to the array of shards, aligned to \ref kShardAlignment */
+	uint8_t* m_pShards;
+	/** Size in bytes of each shard, rounded up to \ref kShardAlignment */
+	uintptr_t m_uShardStride;
+	/** (Power of 2)-1 mask for the shard index */
+	uintptr_t m_uShardMask;
+	/** Pointer to the hash function used for shard selection */
+	HashProc m_pHashFunction;
+
+	ConcurrentHashMapShared(
+		HashProc pHashFunction, uintptr_t uShardSize) BURGER_NOEXCEPT;
+	void* BURGER_API AllocateShards(uintptr_t uShardCount) BURGER_NOEXCEPT;
+	void BURGER_API ReleaseShards(void) BURGER_NOEXCEPT;
+	uintptr_t BURGER_API GetShardIndex(
+		const void* pKey, uintptr_t uKeySize) const BURGER_NOEXCEPT;
+
+	BURGER_INLINE void* GetShard(uintptr_t uIndex) const BURGER_NOEXCEPT
+	{
+		BURGER_ASSERT(m_pShards && (uIndex <= m_uShardMask));
+		return m_pShards + (uIndex * m_uShardStride);
+	}
+
+public:
+	BURGER_INLINE uint_t is_valid(void) const BURGER_NOEXCEPT
+	{
+		return m_pShards != nullptr;
+	}
+	BURGER_INLINE uintptr_t get_shard_count(void) const BURGER_NOEXCEPT
+	{
+		return m_pShards ? m_uShardMask + 1 : 0;
+	}
+};
+
+template<class T, class U>
+class ConcurrentHashMap: public ConcurrentHashMapShared {
+	BURGER_DISABLE_COPY(ConcurrentHashMap);
+
+public:
+	/** Function prototype for for_each() callbacks */
+	typedef void(BURGER_API* ForEachProc)(
+		const T& rKey, const U& rValue, void* pContext);
+
+private:
+	struct Shard {
+		/** Lock for this shard */
+		Mutex m_Lock;
+		/** Hash table for this shard */
+		HashMap<T, U> m_Map;
+
+		Shard(HashProc pHashFunction, TestProc pTestFunction) BURGER_NOEXCEPT
+			: m_Lock(),
+			  m_Map(pHashFunction, pTestFunction)
+		{
+		}
+	};
+
+	static uint_t BURGER_API EqualsTest(
+		const void* pA, const void* pB) BURGER_NOEXCEPT
+	{
+		return static_cast<const T*>(pA)[0] == static_cast<const T*>(pB)[0];
+	}
+
+	void Init(TestProc pTestFunction, uintptr_t uShardCount) BURGER_NOEXCEPT
+	{
+		void* pShards = AllocateShards(uShardCount);
+		if (pShards) {
+			uintptr_t i = 0;
+			do {
+				new (GetShard(i)) Shard(m_pHashFunction, pTestFunction);
+			} while (++i <= m_uShardMask);
+		}
+	}
+
+	BURGER_INLINE Shard* GetShardByKey(const T& rKey) const BURGER_NOEXCEPT
+	{
+		if (!m_pShards) {
+			return nullptr;
+		}
+		return static_cast<Shard*>(GetShard(GetShardIndex(&rKey, sizeof(T))));
+	}
+
+public:
+	ConcurrentHashMap(HashProc pHashFunction = SDBMHashFunctor,
+		uintptr_t uShardCount = kDefaultShardCount) BURGER_NOEXCEPT
+		: ConcurrentHashMapShared(pHashFunction, sizeof(Shard))
+	{
+		Init(EqualsTest, uShardCount);
+	}
+	ConcurrentHashMap(HashProc pHashFunction, TestProc pTestFunction,
+		uintptr_t uShardCount = kDefaultShardCount) BURGER_NOEXCEPT
+		: ConcurrentHashMapShared(pHashFunction, sizeof(Shard))
+	{
+		Init(pTestFunction, uShardCount);
+	}
+	~ConcurrentHashMap()
+	{
+		if (m_pShards) {
+			uintptr_t i = 0;
+			do {
+				static_cast<Shard*>(GetShard(i))->~Shard();
+			} while (++i <= m_uShardMask);
+			ReleaseShards();
+		}
+	}
+
+	uint_t find(const T& rKey, U* pOutput) const BURGER_NOEXCEPT
+	{
+		Shard* pShard = GetShardByKey(rKey);
+		if (!pShard) {
+			return FALSE;
+		}
+		MutexLock Lock(&pShard->m_Lock);
+		return pShard->m_Map.GetData(rKey, pOutput);
+	}
+
+	uint_t contains(const T& rKey) const BURGER_NOEXCEPT
+	{
+		Shard* pShard = GetShardByKey(rKey);
+		if (!pShard) {
+			return FALSE;
+		}
+		MutexLock Lock(&pShard->m_Lock);
+		return pShard->m_Map.GetData(rKey) != nullptr;
+	}
+
+	eError set(const T& rKey, const U& rValue) BURGER_NOEXCEPT
+	{
+		Shard* pShard = GetShardByKey(rKey);
+		if (!pShard) {
+			return kErrorOutOfMemory;
+		}
+		MutexLock Lock(&pShard->m_Lock);
+		pShard->m_Map.Set(rKey, rValue);
+		return kErrorNone;
+	}
+
+	uint_t find_or_insert(
+		const T& rKey, const U& rValue, U* pOutput = nullptr) BURGER_NOEXCEPT
+	{
+		Shard* pShard = GetShardByKey(rKey);
+		if (!pShard) {
+			return FALSE;
+		}
+		MutexLock Lock(&pShard->m_Lock);
+		const U* pFound = pShard->m_Map.GetData(rKey);
+		if (pFound) {
+			if (pOutput) {
+				pOutput[0] = pFound[0];
+			}
+			return FALSE;
+		}
+		pShard->m_Map.add(rKey, rValue);
+		if (pOutput) {
+			pOutput[0] = rValue;
+		}
+		return TRUE;
+	}
+
+	void erase(const T& rKey) BURGER_NOEXCEPT
+	{
+		Shard* pShard = GetShardByKey(rKey);
+		if (pShard) {
+			MutexLock Lock(&pShard->m_Lock);
+			pShard->m_Map.erase(rKey);
+		}
+	}
+
+	void clear(void) BURGER_NOEXCEPT
+	{
+		if (!m_pShards) {
+			return;
+		}
+		uintptr_t i = 0;
+		do {
+			Shard* pShard = static_cast<Shard*>(GetShard(i));
+			MutexLock Lock(&pShard->m_Lock);
+			pShard->m_Map.Clear();
+		} while (++i <= m_uShardMask);
+	}
+
+	uintptr_t size(void) const BURGER_NOEXCEPT
+	{
+		uintptr_t uCount = 0;
+		if (!m_pShards) {
+			return uCount;
+		}
+		uintptr_t i = 0;
+		do {
+			Shard* pShard = static_cast<Shard*>(GetShard(i));
+			MutexLock Lock(&pShard->m_Lock);
+			uCount += pShard->m_Map.GetEntryCount();
+		} while (++i <= m_uShardMask);
+		return uCount;
+	}
+
+	void for_each(ForEachProc pProc, void* pContext) const BURGER_NOEXCEPT
+	{
+		if (!m_pShards) {
+			return;
+		}
+		uintptr_t i = 0;
+		do {
+			Shard* pShard = static_cast<Shard*>(GetShard(i));
+			MutexLock Lock(&pShard->m_Lock);
+			typename HashMap<T, U>::const_iterator it =
+				static_cast<const HashMap<T, U>&>(pShard->m_Map).begin();
+			while (!it.IsEnd()) {
+				pProc(it->first, it->second, pContext);
+				++it;
+			}
+		} while (++i <= m_uShardMask);
+	}
+
+	void snapshot(HashMap<T, U>* pOutput) const BURGER_NOEXCEPT
+	{
+		if (!m_pShards) {
+			return;
+		}
+		uintptr_t i = 0;
+		do {
+			Shard* pShard = static_cast<Shard*>(GetShard(i));
+			MutexLock Lock(&pShard->m_Lock);
+			typename HashMap<T, U>::const_iterator it =
+				static_cast<const HashMap<T, U>&>(pShard->m_Map).begin();
+			while (!it.IsEnd()) {
+				pOutput->Set(it->first, it->second);
+				++it;
+			}
+		} while (++i <= m_uShardMask);
+	}
+};
+
+template<class U>
+class ConcurrentHashMapString: public ConcurrentHashMap<String, U> {
+public:
+	ConcurrentHashMapString(uintptr_t uShardCount =
+								ConcurrentHashMapShared::kDefaultShardCount)
+		BURGER_NOEXCEPT
+		: ConcurrentHashMap<String, U>(DJB2StringHashXorFunctor, uShardCount)
+	{
+	}
+};
+
+template<class U>
+class ConcurrentHashMapStringCase: public ConcurrentHashMap<String, U> {
+public:
+	ConcurrentHashMapStringCase(uintptr_t uShardCount =
+									ConcurrentHashMapShared::kDefaultShardCount)
+		BURGER_NOEXCEPT
+		: ConcurrentHashMap<String, U>(DJB2StringHashXorCaseFunctor,
+			  HashMapStringCaseTest, uShardCount)
+	{
+	}
+};
+
+}
+/* END */
+
+#endif
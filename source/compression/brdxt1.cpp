@@ -14,6 +14,19 @@
 
 #include "brdxt1.h"
 #include "brendian.h"
+#include "brrenderer.h"
+#include "brfloatingpoint.h"
+#include "brmemoryfunctions.h"
+#include "brthread.h"
+
+// Select the vector units used for the index search
+#if defined(BURGER_SSE2) && defined(BURGER_INTEL) && !defined(DOXYGEN)
+#define USE_SSE2
+#include <emmintrin.h>
+#elif defined(BURGER_NEON) && defined(BURGER_ARM64) && !defined(DOXYGEN)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
 
 /*! ************************************
 
@@ -125,34 +138,1172 @@ void Burger::Dxt1Packet_t::Decompress(RGBAWord8_t *pOutput,uintptr_t uStride) co
 	} while (--i);
 }
 
-#if 0
+#if !defined(DOXYGEN)
+
+// Largest number of threads CompressDXTImage() will start
+static const uint_t kDXTMaxThreads = 16;
+
+// A band of block rows for CompressDXTImage() or DecompressDXTImage()
+struct DXTJob_t {
+	uint8_t *m_pOutput;				// First packet or pixel of the band
+	uintptr_t m_uOutputStride;		// Bytes per row of packets or pixels
+	uintptr_t m_uPacketSize;		// Bytes per packet
+	const uint8_t *m_pInput;		// First pixel or packet of the band
+	uintptr_t m_uInputStride;		// Bytes per row of pixels or packets
+	uint_t m_uWidth;				// Width in pixels
+	uint_t m_uHeight;				// Height of the band in pixels
+	uint_t m_uFlags;				// eDXTCompress or eDXTDecompress flags
+	Burger::DXTBlockProc_t m_pProc;	// Block compressor
+	Burger::DXTRowProc_t m_pRowProc;	// Row of blocks decompressor
+};
+
+/***************************************
+
+	Copy a 4x4 block of pixels into a linear array
+
+***************************************/
+
+static void BURGER_API DXTLoadBlock(Burger::RGBAWord8_t *pOutput,const Burger::RGBAWord8_t *pInput,uintptr_t uStride) BURGER_NOEXCEPT
+{
+	uint_t i = 4;
+	do {
+		Burger::memory_copy(pOutput,pInput,sizeof(Burger::RGBAWord8_t)*4);
+		pOutput+=4;
+		pInput = reinterpret_cast<const Burger::RGBAWord8_t *>(reinterpret_cast<const uint8_t *>(pInput)+uStride);
+	} while (--i);
+}
+
+/***************************************
+
+	Create the palette for a pair of R5:G6:B5 endpoints exactly like
+	Dxt1Packet_t::Decompress() does. Alpha is not set.
+
+***************************************/
+
+static void BURGER_API DXTColorPalette(Burger::RGBAWord8_t *pColors,uint_t uColor1,uint_t uColor2,uint_t b4Colors) BURGER_NOEXCEPT
+{
+	Burger::Palette::FromRGB16(&pColors[0],uColor1);
+	Burger::Palette::FromRGB16(&pColors[1],uColor2);
+	const uint8_t *pColor1 = &pColors[0].m_uRed;
+	const uint8_t *pColor2 = &pColors[1].m_uRed;
+	uint_t i = 0;
+	do {
+		const uint_t uValue1 = pColor1[i];
+		const uint_t uValue2 = pColor2[i];
+		if (b4Colors) {
+			(&pColors[2].m_uRed)[i] = static_cast<uint8_t>(((uValue1*2U)+uValue2)/3U);
+			(&pColors[3].m_uRed)[i] = static_cast<uint8_t>((uValue1+(uValue2*2U))/3U);
+		} else {
+			(&pColors[2].m_uRed)[i] = static_cast<uint8_t>((uValue1+uValue2)/2U);
+			(&pColors[3].m_uRed)[i] = 0;
+		}
+	} while (++i<3);
+}
+
+/***************************************
+
+	Find the closest palette entry for each of the 16 pixels and return the
+	2 bit indexes, pixel 0 in the lowest bits. Transparent pixels get index
+	3 and don't count towards the error. Only pColors[0] to pColors[2] are
+	used if b4Colors is FALSE.
+
+***************************************/
+
+static uint32_t BURGER_API DXTColorIndexes(uint32_t *pError,const Burger::RGBAWord8_t *pPixels,const Burger::RGBAWord8_t *pColors,uint_t uTransparent,uint_t b4Colors) BURGER_NOEXCEPT
+{
+	// Index 3 is transparent in 3 color mode, make it a copy of index 0
+	uint32_t Colors[4];
+	uint_t i = 0;
+	do {
+		const Burger::RGBAWord8_t *pColor = &pColors[((i==3) && !b4Colors) ? 0 : i];
+		Colors[i] = static_cast<uint32_t>(pColor->m_uRed)|(static_cast<uint32_t>(pColor->m_uGreen)<<8U)|(static_cast<uint32_t>(pColor->m_uBlue)<<16U);
+	} while (++i<4);
+
+	BURGER_ALIGN(uint32_t,Best[16],16);
+	BURGER_ALIGN(uint32_t,Indexes[16],16);
+#if defined(USE_SSE2)
+	const __m128i vMask = _mm_set1_epi32(0x00FFFFFF);
+	const __m128i vZero = _mm_setzero_si128();
+	__m128i vColors[4];
+	i = 0;
+	do {
+		vColors[i] = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(Colors[i])),vZero);
+	} while (++i<4);
+	i = 0;
+	do {
+		const __m128i vPixels = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pPixels+(i*4))),vMask);
+		const __m128i vLow = _mm_unpacklo_epi8(vPixels,vZero);
+		const __m128i vHigh = _mm_unpackhi_epi8(vPixels,vZero);
+		__m128i vBest = _mm_setzero_si128();
+		__m128i vIndex = _mm_setzero_si128();
+		uint_t j = 0;
+		do {
+			// Squared distance of 4 pixels, pmaddwd sums R+G and B+A
+			__m128i vTemp1 = _mm_sub_epi16(vLow,vColors[j]);
+			__m128i vTemp2 = _mm_sub_epi16(vHigh,vColors[j]);
+			vTemp1 = _mm_madd_epi16(vTemp1,vTemp1);
+			vTemp2 = _mm_madd_epi16(vTemp2,vTemp2);
+			const __m128i vDistance = _mm_add_epi32(
+				_mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(vTemp1),_mm_castsi128_ps(vTemp2),_MM_SHUFFLE(2,0,2,0))),
+				_mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(vTemp1),_mm_castsi128_ps(vTemp2),_MM_SHUFFLE(3,1,3,1))));
+			if (!j) {
+				vBest = vDistance;
+			} else {
+				const __m128i vLess = _mm_cmplt_epi32(vDistance,vBest);
+				vBest = _mm_or_si128(_mm_and_si128(vLess,vDistance),_mm_andnot_si128(vLess,vBest));
+				vIndex = _mm_or_si128(_mm_and_si128(vLess,_mm_set1_epi32(static_cast<int>(j))),_mm_andnot_si128(vLess,vIndex));
+			}
+		} while (++j<4);
+		_mm_store_si128(reinterpret_cast<__m128i *>(Best+(i*4)),vBest);
+		_mm_store_si128(reinterpret_cast<__m128i *>(Indexes+(i*4)),vIndex);
+	} while (++i<4);
+#elif defined(USE_NEON)
+	const uint8x16_t vMask = vreinterpretq_u8_u32(vdupq_n_u32(0x00FFFFFFU));
+	i = 0;
+	do {
+		const uint8x16_t vPixels = vandq_u8(vld1q_u8(&pPixels[i*4].m_uRed),vMask);
+		uint32x4_t vBest = vdupq_n_u32(0);
+		uint32x4_t vIndex = vdupq_n_u32(0);
+		uint_t j = 0;
+		do {
+			// Squared distance of 4 pixels
+			const uint8x16_t vDelta = vabdq_u8(vPixels,vreinterpretq_u8_u32(vdupq_n_u32(Colors[j])));
+			const uint32x4_t vDistance = vpaddq_u32(
+				vpaddlq_u16(vmull_u8(vget_low_u8(vDelta),vget_low_u8(vDelta))),
+				vpaddlq_u16(vmull_high_u8(vDelta,vDelta)));
+			if (!j) {
+				vBest = vDistance;
+			} else {
+				const uint32x4_t vLess = vcltq_u32(vDistance,vBest);
+				vBest = vbslq_u32(vLess,vDistance,vBest);
+				vIndex = vbslq_u32(vLess,vdupq_n_u32(j),vIndex);
+			}
+		} while (++j<4);
+		vst1q_u32(Best+(i*4),vBest);
+		vst1q_u32(Indexes+(i*4),vIndex);
+	} while (++i<4);
+#else
+	i = 0;
+	do {
+		const Burger::RGBAWord8_t *pPixel = &pPixels[i];
+		uint_t j = 0;
+		do {
+			const int iRed = static_cast<int>(pPixel->m_uRed)-static_cast<int>(Colors[j]&0xFFU);
+			const int iGreen = static_cast<int>(pPixel->m_uGreen)-static_cast<int>((Colors[j]>>8U)&0xFFU);
+			const int iBlue = static_cast<int>(pPixel->m_uBlue)-static_cast<int>(Colors[j]>>16U);
+			const uint32_t uDistance = static_cast<uint32_t>((iRed*iRed)+(iGreen*iGreen)+(iBlue*iBlue));
+			if (!j || (uDistance<Best[i])) {
+				Best[i] = uDistance;
+				Indexes[i] = j;
+			}
+		} while (++j<4);
+	} while (++i<16);
+#endif
+
+	// Pack the indexes and total the error
+	uint32_t uResult = 0;
+	uint32_t uError = 0;
+	i = 0;
+	do {
+		if ((uTransparent>>i)&1U) {
+			uResult |= 3U<<(i*2);
+		} else {
+			uResult |= Indexes[i]<<(i*2);
+			uError += Best[i];
+		}
+	} while (++i<16);
+	pError[0] = uError;
+	return uResult;
+}
+
+/***************************************
+
+	Convert an 8 bit per component color into R5:G6:B5 with rounding
+
+***************************************/
+
+static BURGER_INLINE uint_t DXTToRGB16(uint_t uRed,uint_t uGreen,uint_t uBlue) BURGER_NOEXCEPT
+{
+	return (((uRed*31U+127U)/255U)<<11U)|(((uGreen*63U+127U)/255U)<<5U)|((uBlue*31U+127U)/255U);
+}
+
+/***************************************
+
+	Fast endpoint selection. The bounding box of the colors is inset by
+	1/16th to reduce the error of the interpolated colors and the diagonal
+	is flipped to match the sign of the covariance of red and blue against
+	green.
+
+***************************************/
+
+static void BURGER_API DXTRangeFit(uint_t *pColor1,uint_t *pColor2,const Burger::RGBAWord8_t *pPixels) BURGER_NOEXCEPT
+{
+	uint_t uMin[3];
+	uint_t uMax[3];
+#if defined(USE_SSE2)
+	const __m128i *pRows = reinterpret_cast<const __m128i *>(pPixels);
+	__m128i vRow0 = _mm_loadu_si128(pRows);
+	__m128i vRow1 = _mm_loadu_si128(pRows+1);
+	__m128i vRow2 = _mm_loadu_si128(pRows+2);
+	__m128i vRow3 = _mm_loadu_si128(pRows+3);
+	__m128i vMin = _mm_min_epu8(_mm_min_epu8(vRow0,vRow1),_mm_min_epu8(vRow2,vRow3));
+	__m128i vMax = _mm_max_epu8(_mm_max_epu8(vRow0,vRow1),_mm_max_epu8(vRow2,vRow3));
+	vMin = _mm_min_epu8(vMin,_mm_shuffle_epi32(vMin,_MM_SHUFFLE(1,0,3,2)));
+	vMax = _mm_max_epu8(vMax,_mm_shuffle_epi32(vMax,_MM_SHUFFLE(1,0,3,2)));
+	vMin = _mm_min_epu8(vMin,_mm_shuffle_epi32(vMin,_MM_SHUFFLE(2,3,0,1)));
+	vMax = _mm_max_epu8(vMax,_mm_shuffle_epi32(vMax,_MM_SHUFFLE(2,3,0,1)));
+	const uint32_t uMinimum = static_cast<uint32_t>(_mm_cvtsi128_si32(vMin));
+	const uint32_t uMaximum = static_cast<uint32_t>(_mm_cvtsi128_si32(vMax));
+	uMin[0] = uMinimum&0xFFU;
+	uMin[1] = (uMinimum>>8U)&0xFFU;
+	uMin[2] = (uMinimum>>16U)&0xFFU;
+	uMax[0] = uMaximum&0xFFU;
+	uMax[1] = (uMaximum>>8U)&0xFFU;
+	uMax[2] = (uMaximum>>16U)&0xFFU;
+#elif defined(USE_NEON)
+	const uint8_t *pBytes = &pPixels[0].m_uRed;
+	uint8x16_t vRow0 = vld1q_u8(pBytes);
+	uint8x16_t vRow1 = vld1q_u8(pBytes+16);
+	uint8x16_t vRow2 = vld1q_u8(pBytes+32);
+	uint8x16_t vRow3 = vld1q_u8(pBytes+48);
+	uint8x16_t vMin = vminq_u8(vminq_u8(vRow0,vRow1),vminq_u8(vRow2,vRow3));
+	uint8x16_t vMax = vmaxq_u8(vmaxq_u8(vRow0,vRow1),vmaxq_u8(vRow2,vRow3));
+	vMin = vminq_u8(vMin,vextq_u8(vMin,vMin,8));
+	vMax = vmaxq_u8(vMax,vextq_u8(vMax,vMax,8));
+	vMin = vminq_u8(vMin,vextq_u8(vMin,vMin,4));
+	vMax = vmaxq_u8(vMax,vextq_u8(vMax,vMax,4));
+	uMin[0] = vgetq_lane_u8(vMin,0);
+	uMin[1] = vgetq_lane_u8(vMin,1);
+	uMin[2] = vgetq_lane_u8(vMin,2);
+	uMax[0] = vgetq_lane_u8(vMax,0);
+	uMax[1] = vgetq_lane_u8(vMax,1);
+	uMax[2] = vgetq_lane_u8(vMax,2);
+#else
+	uMin[0] = uMin[1] = uMin[2] = 255;
+	uMax[0] = uMax[1] = uMax[2] = 0;
+	uint_t i = 0;
+	do {
+		const uint8_t *pPixel = &pPixels[i].m_uRed;
+		uint_t j = 0;
+		do {
+			const uint_t uValue = pPixel[j];
+			if (uValue<uMin[j]) {
+				uMin[j] = uValue;
+			}
+			if (uValue>uMax[j]) {
+				uMax[j] = uValue;
+			}
+		} while (++j<3);
+	} while (++i<16);
+#endif
+
+	// Covariance of red and blue against green
+	int iRedGreen = 0;
+	int iBlueGreen = 0;
+	uint_t uIndex = 0;
+	do {
+		const Burger::RGBAWord8_t *pPixel = &pPixels[uIndex];
+		const int iGreen = (static_cast<int>(pPixel->m_uGreen)*2)-static_cast<int>(uMin[1]+uMax[1]);
+		iRedGreen += ((static_cast<int>(pPixel->m_uRed)*2)-static_cast<int>(uMin[0]+uMax[0]))*iGreen;
+		iBlueGreen += ((static_cast<int>(pPixel->m_uBlue)*2)-static_cast<int>(uMin[2]+uMax[2]))*iGreen;
+	} while (++uIndex<16);
+
+	// Inset the box
+	uIndex = 0;
+	do {
+		const uint_t uInset = (uMax[uIndex]-uMin[uIndex])>>4U;
+		uMin[uIndex] += uInset;
+		uMax[uIndex] -= uInset;
+	} while (++uIndex<3);
+
+	// Use the other diagonal?
+	if (iRedGreen<0) {
+		const uint_t uTemp = uMin[0];
+		uMin[0] = uMax[0];
+		uMax[0] = uTemp;
+	}
+	if (iBlueGreen<0) {
+		const uint_t uTemp = uMin[2];
+		uMin[2] = uMax[2];
+		uMax[2] = uTemp;
+	}
+	pColor1[0] = DXTToRGB16(uMax[0],uMax[1],uMax[2]);
+	pColor2[0] = DXTToRGB16(uMin[0],uMin[1],uMin[2]);
+}
+
+/***************************************
+
+	Snap a least squares endpoint to the closest color that R5:G6:B5 can
+	represent. The R5:G6:B5 value is returned.
+
+***************************************/
+
+static uint_t BURGER_API DXTSnapColor(float *pColor) BURGER_NOEXCEPT
+{
+	static const float g_Scales[3] = {31.0f/255.0f,63.0f/255.0f,31.0f/255.0f};
+	uint_t uResult = 0;
+	uint_t i = 0;
+	do {
+		float fValue = pColor[i];
+		if (fValue<0.0f) {
+			fValue = 0.0f;
+		} else if (fValue>255.0f) {
+			fValue = 255.0f;
+		}
+		const uint_t uValue = static_cast<uint_t>((fValue*g_Scales[i])+0.5f);
+		if (i==1) {
+			pColor[i] = static_cast<float>(Burger::Renderer::RGB6ToRGB8Table[uValue]);
+			uResult = (uResult<<6U)|uValue;
+		} else {
+			pColor[i] = static_cast<float>(Burger::Renderer::RGB5ToRGB8Table[uValue]);
+			uResult = (uResult<<5U)|uValue;
+		}
+	} while (++i<3);
+	return uResult;
+}
+
+/***************************************
+
+	High quality endpoint selection. The opaque colors are sorted along
+	their principal axis and every way of splitting them into 3 or 4 ordered
+	clusters is tried. The endpoints for each split are solved with least
+	squares, snapped to R5:G6:B5 and the split with the lowest error wins.
+
+	Return FALSE if there are no opaque colors.
+
+***************************************/
+
+static uint_t BURGER_API DXTClusterFit(uint_t *pColor1,uint_t *pColor2,const Burger::RGBAWord8_t *pPixels,uint_t uTransparent,uint_t b4Colors) BURGER_NOEXCEPT
+{
+	// Gather the opaque colors and their average
+	float Points[16][3];
+	float Mean[3] = {0.0f,0.0f,0.0f};
+	uint_t uCount = 0;
+	uint_t i = 0;
+	do {
+		if (!((uTransparent>>i)&1U)) {
+			float *pPoint = Points[uCount];
+			pPoint[0] = static_cast<float>(pPixels[i].m_uRed);
+			pPoint[1] = static_cast<float>(pPixels[i].m_uGreen);
+			pPoint[2] = static_cast<float>(pPixels[i].m_uBlue);
+			Mean[0] += pPoint[0];
+			Mean[1] += pPoint[1];
+			Mean[2] += pPoint[2];
+			++uCount;
+		}
+	} while (++i<16);
+	if (!uCount) {
+		return FALSE;
+	}
+	const float fInverse = 1.0f/static_cast<float>(uCount);
+	Mean[0] *= fInverse;
+	Mean[1] *= fInverse;
+	Mean[2] *= fInverse;
+
+	// Covariance matrix, RR, RG, RB, GG, GB, BB
+	float Covariance[6] = {0.0f,0.0f,0.0f,0.0f,0.0f,0.0f};
+	i = 0;
+	do {
+		const float fRed = Points[i][0]-Mean[0];
+		const float fGreen = Points[i][1]-Mean[1];
+		const float fBlue = Points[i][2]-Mean[2];
+		Covariance[0] += fRed*fRed;
+		Covariance[1] += fRed*fGreen;
+		Covariance[2] += fRed*fBlue;
+		Covariance[3] += fGreen*fGreen;
+		Covariance[4] += fGreen*fBlue;
+		Covariance[5] += fBlue*fBlue;
+	} while (++i<uCount);
+
+	// Power iteration for the principal axis
+	float Axis[3] = {1.0f,1.0f,1.0f};
+	i = 0;
+	do {
+		const float fRed = (Axis[0]*Covariance[0])+(Axis[1]*Covariance[1])+(Axis[2]*Covariance[2]);
+		const float fGreen = (Axis[0]*Covariance[1])+(Axis[1]*Covariance[3])+(Axis[2]*Covariance[4]);
+		const float fBlue = (Axis[0]*Covariance[2])+(Axis[1]*Covariance[4])+(Axis[2]*Covariance[5]);
+		float fLargest = Burger::absolute(fRed);
+		if (Burger::absolute(fGreen)>fLargest) {
+			fLargest = Burger::absolute(fGreen);
+		}
+		if (Burger::absolute(fBlue)>fLargest) {
+			fLargest = Burger::absolute(fBlue);
+		}
+		// Single color, any axis will do
+		if (fLargest<=0.0f) {
+			break;
+		}
+		fLargest = 1.0f/fLargest;
+		Axis[0] = fRed*fLargest;
+		Axis[1] = fGreen*fLargest;
+		Axis[2] = fBlue*fLargest;
+	} while (++i<8);
+
+	// Insertion sort of the colors along the axis
+	float Sorted[16][3];
+	float Dots[16];
+	i = 0;
+	do {
+		const float fDot = (Points[i][0]*Axis[0])+(Points[i][1]*Axis[1])+(Points[i][2]*Axis[2]);
+		uint_t j = i;
+		while (j && (Dots[j-1]>fDot)) {
+			Dots[j] = Dots[j-1];
+			Sorted[j][0] = Sorted[j-1][0];
+			Sorted[j][1] = Sorted[j-1][1];
+			Sorted[j][2] = Sorted[j-1][2];
+			--j;
+		}
+		Dots[j] = fDot;
+		Sorted[j][0] = Points[i][0];
+		Sorted[j][1] = Points[i][1];
+		Sorted[j][2] = Points[i][2];
+	} while (++i<uCount);
+
+	float Total[3] = {Mean[0]*static_cast<float>(uCount),Mean[1]*static_cast<float>(uCount),Mean[2]*static_cast<float>(uCount)};
+
+	// Weight of the first endpoint for each cluster
+	float fBestError = Burger::g_fMax;
+	uint_t uBest1 = 0;
+	uint_t uBest2 = 0;
+	float Part0[3] = {0.0f,0.0f,0.0f};
+	i = 0;
+	for (;;) {
+		float Part1[3] = {0.0f,0.0f,0.0f};
+		uint_t j = i;
+		for (;;) {
+			float Part2[3] = {0.0f,0.0f,0.0f};
+			uint_t k = j;
+			for (;;) {
+				// Clusters are [0,i), [i,j), [j,k) and [k,uCount)
+				float fAlpha2;
+				float fBeta2;
+				float fAlphaBeta;
+				float AlphaX[3];
+				const float fCount0 = static_cast<float>(i);
+				const float fCount1 = static_cast<float>(j-i);
+				if (b4Colors) {
+					const float fCount2 = static_cast<float>(k-j);
+					const float fCount3 = static_cast<float>(uCount-k);
+					fAlpha2 = fCount0+(fCount1*(4.0f/9.0f))+(fCount2*(1.0f/9.0f));
+					fBeta2 = fCount3+(fCount2*(4.0f/9.0f))+(fCount1*(1.0f/9.0f));
+					fAlphaBeta = (fCount1+fCount2)*(2.0f/9.0f);
+					AlphaX[0] = Part0[0]+(Part1[0]*(2.0f/3.0f))+(Part2[0]*(1.0f/3.0f));
+					AlphaX[1] = Part0[1]+(Part1[1]*(2.0f/3.0f))+(Part2[1]*(1.0f/3.0f));
+					AlphaX[2] = Part0[2]+(Part1[2]*(2.0f/3.0f))+(Part2[2]*(1.0f/3.0f));
+				} else {
+					// Clusters are [0,i), [i,j) and [j,uCount)
+					const float fCount2 = static_cast<float>(uCount-j);
+					fAlpha2 = fCount0+(fCount1*0.25f);
+					fBeta2 = fCount2+(fCount1*0.25f);
+					fAlphaBeta = fCount1*0.25f;
+					AlphaX[0] = Part0[0]+(Part1[0]*0.5f);
+					AlphaX[1] = Part0[1]+(Part1[1]*0.5f);
+					AlphaX[2] = Part0[2]+(Part1[2]*0.5f);
+				}
+				const float fDeterminant = (fAlpha2*fBeta2)-(fAlphaBeta*fAlphaBeta);
+				// All the colors in one cluster is handled by the range fit
+				if (fDeterminant>(1.0f/4096.0f)) {
+					const float fFactor = 1.0f/fDeterminant;
+					float Start[3];
+					float End[3];
+					float fError = 0.0f;
+					uint_t uChannel = 0;
+					do {
+						const float fBetaX = Total[uChannel]-AlphaX[uChannel];
+						Start[uChannel] = ((AlphaX[uChannel]*fBeta2)-(fBetaX*fAlphaBeta))*fFactor;
+						End[uChannel] = ((fBetaX*fAlpha2)-(AlphaX[uChannel]*fAlphaBeta))*fFactor;
+					} while (++uChannel<3);
+					const uint_t uColor1 = DXTSnapColor(Start);
+					const uint_t uColor2 = DXTSnapColor(End);
+					uChannel = 0;
+					do {
+						// Squared error minus the constant sum of x squared
+						const float fStart = Start[uChannel];
+						const float fEnd = End[uChannel];
+						fError += (fStart*fStart*fAlpha2)+(fEnd*fEnd*fBeta2)+
+							(2.0f*((fStart*fEnd*fAlphaBeta)-(fStart*AlphaX[uChannel])-(fEnd*(Total[uChannel]-AlphaX[uChannel]))));
+					} while (++uChannel<3);
+					if (fError<fBestError) {
+						fBestError = fError;
+						uBest1 = uColor1;
+						uBest2 = uColor2;
+					}
+				}
+				if (!b4Colors || (k>=uCount)) {
+					break;
+				}
+				Part2[0] += Sorted[k][0];
+				Part2[1] += Sorted[k][1];
+				Part2[2] += Sorted[k][2];
+				++k;
+			}
+			if (j>=uCount) {
+				break;
+			}
+			Part1[0] += Sorted[j][0];
+			Part1[1] += Sorted[j][1];
+			Part1[2] += Sorted[j][2];
+			++j;
+		}
+		if (i>=uCount) {
+			break;
+		}
+		Part0[0] += Sorted[i][0];
+		Part0[1] += Sorted[i][1];
+		Part0[2] += Sorted[i][2];
+		++i;
+	}
+	// Only one distinct split is possible, let the range fit handle it
+	if (fBestError==Burger::g_fMax) {
+		return FALSE;
+	}
+	pColor1[0] = uBest1;
+	pColor2[0] = uBest2;
+	return TRUE;
+}
+
+/***************************************
+
+	Order a pair of endpoints for the 4 or 3 color mode, find the indexes
+	and return the error.
+
+***************************************/
+
+static uint32_t BURGER_API DXTTryColors(Burger::Dxt1Packet_t *pOutput,const Burger::RGBAWord8_t *pPixels,uint_t uColor1,uint_t uColor2,uint_t uTransparent,uint_t b4Colors) BURGER_NOEXCEPT
+{
+	// 4 color mode needs Color1>Color2, 3 color mode needs Color1<=Color2
+	if (b4Colors ? (uColor1<uColor2) : (uColor1>uColor2)) {
+		const uint_t uTemp = uColor1;
+		uColor1 = uColor2;
+		uColor2 = uTemp;
+	}
+	Burger::RGBAWord8_t Colors[4];
+	DXTColorPalette(Colors,uColor1,uColor2,b4Colors);
+	uint32_t uError;
+	const uint32_t uIndexes = DXTColorIndexes(&uError,pPixels,Colors,uTransparent,b4Colors);
+	Burger::LittleEndian::store(&pOutput->m_uRGB565Color1,static_cast<uint16_t>(uColor1));
+	Burger::LittleEndian::store(&pOutput->m_uRGB565Color2,static_cast<uint16_t>(uColor2));
+	pOutput->m_uColorIndexes[0] = static_cast<uint8_t>(uIndexes);
+	pOutput->m_uColorIndexes[1] = static_cast<uint8_t>(uIndexes>>8U);
+	pOutput->m_uColorIndexes[2] = static_cast<uint8_t>(uIndexes>>16U);
+	pOutput->m_uColorIndexes[3] = static_cast<uint8_t>(uIndexes>>24U);
+	return uError;
+}
+
+/***************************************
+
+	Encode the color of a 4x4 block. Transparent pixels force the 3 color
+	mode, otherwise the 3 color mode is only tried by the cluster fit and
+	only if b3Colors is TRUE.
+
+***************************************/
+
+static void BURGER_API DXTCompressColor(Burger::Dxt1Packet_t *pOutput,const Burger::RGBAWord8_t *pPixels,uint_t uTransparent,uint_t uFlags,uint_t b3Colors) BURGER_NOEXCEPT
+{
+	// All transparent?
+	if (uTransparent==0xFFFFU) {
+		pOutput->m_uRGB565Color1 = 0;
+		pOutput->m_uRGB565Color2 = 0;
+		Burger::memory_set(pOutput->m_uColorIndexes,0xFF,sizeof(pOutput->m_uColorIndexes));
+		return;
+	}
+
+	// Replace the transparent pixels with an opaque one for the range fit
+	Burger::RGBAWord8_t Opaque[16];
+	const Burger::RGBAWord8_t *pFit = pPixels;
+	if (uTransparent) {
+		uint_t uFirst = 0;
+		while ((uTransparent>>uFirst)&1U) {
+			++uFirst;
+		}
+		uint_t i = 0;
+		do {
+			Opaque[i] = pPixels[((uTransparent>>i)&1U) ? uFirst : i];
+		} while (++i<16);
+		pFit = Opaque;
+	}
+
+	const uint_t b4Colors = !uTransparent;
+	uint_t uColor1;
+	uint_t uColor2;
+	DXTRangeFit(&uColor1,&uColor2,pFit);
+	uint32_t uBestError = DXTTryColors(pOutput,pPixels,uColor1,uColor2,uTransparent,b4Colors);
+
+	if ((uFlags&Burger::DXTCOMPRESS_CLUSTERFIT) && uBestError) {
+		Burger::Dxt1Packet_t Trial;
+		uint_t uMode = b4Colors;
+		do {
+			if (DXTClusterFit(&uColor1,&uColor2,pPixels,uTransparent,uMode)) {
+				const uint32_t uError = DXTTryColors(&Trial,pPixels,uColor1,uColor2,uTransparent,uMode);
+				if (uError<uBestError) {
+					uBestError = uError;
+					pOutput[0] = Trial;
+				}
+			}
+			// Opaque blocks can also try the 3 color mode
+		} while (uMode-- && b3Colors);
+	}
+}
+
+/***************************************
+
+	Compress the block rows of a band
+
+***************************************/
+
+static uintptr_t BURGER_API DXTCompressBand(void *pThis) BURGER_NOEXCEPT
+{
+	const DXTJob_t *pJob = static_cast<const DXTJob_t *>(pThis);
+	uint_t uHeight = pJob->m_uHeight;
+	if (uHeight) {
+		const uint8_t *pInput = pJob->m_pInput;
+		uint8_t *pOutput = pJob->m_pOutput;
+		const uintptr_t uInputStride = pJob->m_uInputStride;
+		Burger::RGBAWord8_t Pixels[16];
+		do {
+			const uint8_t *pWork = pInput;
+			uint8_t *pPacket = pOutput;
+			uint_t uX = 0;
+			do {
+				const uint_t uWidth = pJob->m_uWidth-uX;
+				if ((uWidth<4) || (uHeight<4)) {
+					// Replicate the edge pixels to fill the block
+					uint_t uY = 0;
+					do {
+						const Burger::RGBAWord8_t *pRow = reinterpret_cast<const Burger::RGBAWord8_t *>(pWork+(((uY<uHeight) ? uY : (uHeight-1))*uInputStride));
+						uint_t uX2 = 0;
+						do {
+							Pixels[(uY*4)+uX2] = pRow[(uX2<uWidth) ? uX2 : (uWidth-1)];
+						} while (++uX2<4);
+					} while (++uY<4);
+					pJob->m_pProc(pPacket,Pixels,sizeof(Burger::RGBAWord8_t)*4,pJob->m_uFlags);
+				} else {
+					pJob->m_pProc(pPacket,reinterpret_cast<const Burger::RGBAWord8_t *>(pWork),uInputStride,pJob->m_uFlags);
+				}
+				pWork+=sizeof(Burger::RGBAWord8_t)*4;
+				pPacket+=pJob->m_uPacketSize;
+				uX+=4;
+			} while (uX<pJob->m_uWidth);
+			if (uHeight<4) {
+				break;
+			}
+			uHeight-=4;
+			pInput+=uInputStride*4;
+			pOutput+=pJob->m_uOutputStride;
+		} while (uHeight);
+	}
+	return 0;
+}
+
+/***************************************
+
+	Split the block rows of a job into bands and run them on uThreadCount
+	threads. The calling thread does the last band and if a thread can't
+	be started, its band is done here too. uInputStep and uOutputStep are
+	the bytes per row of blocks of the input and output.
+
+***************************************/
+
+static void BURGER_API DXTRunBands(DXTJob_t *pJob,uintptr_t uInputStep,uintptr_t uOutputStep,uint_t uThreadCount,Burger::Thread::function_proc_t pBand,const char *pName) BURGER_NOEXCEPT
+{
+	const uint_t uBlockRows = (pJob->m_uHeight+3U)>>2U;
+	if (uThreadCount>kDXTMaxThreads) {
+		uThreadCount = kDXTMaxThreads;
+	}
+	if (uThreadCount>uBlockRows) {
+		uThreadCount = uBlockRows;
+	}
+	if (uThreadCount<2) {
+		pBand(pJob);
+	} else {
+		DXTJob_t Jobs[kDXTMaxThreads];
+		Burger::Thread Threads[kDXTMaxThreads];
+		uint_t uRow = 0;
+		uint_t i = 0;
+		do {
+			const uint_t uNextRow = (uBlockRows*(i+1))/uThreadCount;
+			Jobs[i] = pJob[0];
+			Jobs[i].m_pInput = pJob->m_pInput+(uRow*uInputStep);
+			Jobs[i].m_pOutput = pJob->m_pOutput+(uRow*uOutputStep);
+			Jobs[i].m_uHeight = ((uNextRow==uBlockRows) ? pJob->m_uHeight : (uNextRow*4U))-(uRow*4U);
+			uRow = uNextRow;
+		} while (++i<uThreadCount);
+
+		const uint_t uThreads = uThreadCount-1U;
+		i = 0;
+		do {
+			if (Threads[i].start(pBand,&Jobs[i],pName)) {
+				pBand(&Jobs[i]);
+			}
+		} while (++i<uThreads);
+		pBand(&Jobs[uThreads]);
+		i = 0;
+		do {
+			if (Threads[i].is_initialized()) {
+				Threads[i].wait();
+			}
+		} while (++i<uThreads);
+	}
+}
+
+/***************************************
+
+	Create the palettes of up to 4 color blocks exactly like
+	Dxt1Packet_t::Decompress() does. Each palette is 4 RGBA colors. If
+	bAlpha is TRUE, the 3 color mode is never used and the alpha is zero
+	so it can be merged with the DXT3 or DXT5 alpha.
+
+***************************************/
+
+static void BURGER_API DXTColorPalettes(uint32_t *pPalettes,const Burger::Dxt1Packet_t *pInput,uintptr_t uInputStep,uint_t uCount,uint_t bAlpha) BURGER_NOEXCEPT
+{
+	// Gather the endpoints, repeat the last block to fill out the batch
+	BURGER_ALIGN(uint32_t,Color1[4],16);
+	BURGER_ALIGN(uint32_t,Color2[4],16);
+	uint_t i = 0;
+	do {
+		Color1[i] = Burger::LittleEndian::load(&pInput->m_uRGB565Color1);
+		Color2[i] = Burger::LittleEndian::load(&pInput->m_uRGB565Color2);
+		if ((i+1)<uCount) {
+			pInput = reinterpret_cast<const Burger::Dxt1Packet_t *>(reinterpret_cast<const uint8_t *>(pInput)+uInputStep);
+		}
+	} while (++i<4);
+
+#if defined(USE_SSE2)
+	const __m128i vColor1 = _mm_load_si128(reinterpret_cast<const __m128i *>(Color1));
+	const __m128i vColor2 = _mm_load_si128(reinterpret_cast<const __m128i *>(Color2));
+	const __m128i vAlpha = _mm_set1_epi32(bAlpha ? 0 : static_cast<int>(0xFF000000U));
+	const __m128i vMask5 = _mm_set1_epi32(0x1F);
+	const __m128i vMask6 = _mm_set1_epi32(0x3F);
+
+	// R5:G6:B5 to RGBA by replicating the high bits into the low bits
+	__m128i vRed = _mm_and_si128(_mm_srli_epi32(vColor1,11),vMask5);
+	__m128i vGreen = _mm_and_si128(_mm_srli_epi32(vColor1,5),vMask6);
+	__m128i vBlue = _mm_and_si128(vColor1,vMask5);
+	const __m128i vColor0 = _mm_or_si128(_mm_or_si128(_mm_or_si128(_mm_slli_epi32(vRed,3),_mm_srli_epi32(vRed,2)),
+		_mm_slli_epi32(_mm_or_si128(_mm_slli_epi32(vGreen,2),_mm_srli_epi32(vGreen,4)),8)),
+		_mm_or_si128(_mm_slli_epi32(_mm_or_si128(_mm_slli_epi32(vBlue,3),_mm_srli_epi32(vBlue,2)),16),vAlpha));
+	vRed = _mm_and_si128(_mm_srli_epi32(vColor2,11),vMask5);
+	vGreen = _mm_and_si128(_mm_srli_epi32(vColor2,5),vMask6);
+	vBlue = _mm_and_si128(vColor2,vMask5);
+	const __m128i vColorB = _mm_or_si128(_mm_or_si128(_mm_or_si128(_mm_slli_epi32(vRed,3),_mm_srli_epi32(vRed,2)),
+		_mm_slli_epi32(_mm_or_si128(_mm_slli_epi32(vGreen,2),_mm_srli_epi32(vGreen,4)),8)),
+		_mm_or_si128(_mm_slli_epi32(_mm_or_si128(_mm_slli_epi32(vBlue,3),_mm_srli_epi32(vBlue,2)),16),vAlpha));
+
+	// Interpolate in 16 bits, x*21846>>16 is x/3 for x<=765
+	const __m128i vZero = _mm_setzero_si128();
+	const __m128i vThird = _mm_set1_epi16(21846);
+	__m128i vLow1 = _mm_unpacklo_epi8(vColor0,vZero);
+	__m128i vLow2 = _mm_unpacklo_epi8(vColorB,vZero);
+	__m128i vHigh1 = _mm_unpackhi_epi8(vColor0,vZero);
+	__m128i vHigh2 = _mm_unpackhi_epi8(vColorB,vZero);
+	__m128i vColor3 = _mm_packus_epi16(
+		_mm_mulhi_epu16(_mm_add_epi16(_mm_add_epi16(vLow1,vLow1),vLow2),vThird),
+		_mm_mulhi_epu16(_mm_add_epi16(_mm_add_epi16(vHigh1,vHigh1),vHigh2),vThird));
+	__m128i vColor4 = _mm_packus_epi16(
+		_mm_mulhi_epu16(_mm_add_epi16(_mm_add_epi16(vLow2,vLow2),vLow1),vThird),
+		_mm_mulhi_epu16(_mm_add_epi16(_mm_add_epi16(vHigh2,vHigh2),vHigh1),vThird));
+	if (!bAlpha) {
+		// 3 color mode is the average and transparent black
+		const __m128i vFour = _mm_cmpgt_epi32(vColor1,vColor2);
+		const __m128i vHalf = _mm_packus_epi16(_mm_srli_epi16(_mm_add_epi16(vLow1,vLow2),1),
+			_mm_srli_epi16(_mm_add_epi16(vHigh1,vHigh2),1));
+		vColor3 = _mm_or_si128(_mm_and_si128(vFour,vColor3),_mm_andnot_si128(vFour,vHalf));
+		vColor4 = _mm_and_si128(vFour,vColor4);
+	}
+
+	// Transpose so each block has its 4 colors together
+	vLow1 = _mm_unpacklo_epi32(vColor0,vColorB);
+	vLow2 = _mm_unpacklo_epi32(vColor3,vColor4);
+	vHigh1 = _mm_unpackhi_epi32(vColor0,vColorB);
+	vHigh2 = _mm_unpackhi_epi32(vColor3,vColor4);
+	__m128i *pOutput = reinterpret_cast<__m128i *>(pPalettes);
+	_mm_store_si128(pOutput,_mm_unpacklo_epi64(vLow1,vLow2));
+	_mm_store_si128(pOutput+1,_mm_unpackhi_epi64(vLow1,vLow2));
+	_mm_store_si128(pOutput+2,_mm_unpacklo_epi64(vHigh1,vHigh2));
+	_mm_store_si128(pOutput+3,_mm_unpackhi_epi64(vHigh1,vHigh2));
+
+#elif defined(USE_NEON)
+	const uint32x4_t vColor1 = vld1q_u32(Color1);
+	const uint32x4_t vColor2 = vld1q_u32(Color2);
+	const uint32x4_t vAlpha = vdupq_n_u32(bAlpha ? 0U : 0xFF000000U);
+	const uint32x4_t vMask5 = vdupq_n_u32(0x1FU);
+	const uint32x4_t vMask6 = vdupq_n_u32(0x3FU);
+
+	// R5:G6:B5 to RGBA by replicating the high bits into the low bits
+	uint32x4_t vRed = vandq_u32(vshrq_n_u32(vColor1,11),vMask5);
+	uint32x4_t vGreen = vandq_u32(vshrq_n_u32(vColor1,5),vMask6);
+	uint32x4_t vBlue = vandq_u32(vColor1,vMask5);
+	const uint32x4_t vColor0 = vorrq_u32(vorrq_u32(vorrq_u32(vshlq_n_u32(vRed,3),vshrq_n_u32(vRed,2)),
+		vshlq_n_u32(vorrq_u32(vshlq_n_u32(vGreen,2),vshrq_n_u32(vGreen,4)),8)),
+		vorrq_u32(vshlq_n_u32(vorrq_u32(vshlq_n_u32(vBlue,3),vshrq_n_u32(vBlue,2)),16),vAlpha));
+	vRed = vandq_u32(vshrq_n_u32(vColor2,11),vMask5);
+	vGreen = vandq_u32(vshrq_n_u32(vColor2,5),vMask6);
+	vBlue = vandq_u32(vColor2,vMask5);
+	const uint32x4_t vColorB = vorrq_u32(vorrq_u32(vorrq_u32(vshlq_n_u32(vRed,3),vshrq_n_u32(vRed,2)),
+		vshlq_n_u32(vorrq_u32(vshlq_n_u32(vGreen,2),vshrq_n_u32(vGreen,4)),8)),
+		vorrq_u32(vshlq_n_u32(vorrq_u32(vshlq_n_u32(vBlue,3),vshrq_n_u32(vBlue,2)),16),vAlpha));
+
+	// Interpolate in 16 bits, x*21846>>16 is x/3 for x<=765
+	const uint8x16_t vBytes1 = vreinterpretq_u8_u32(vColor0);
+	const uint8x16_t vBytes2 = vreinterpretq_u8_u32(vColorB);
+	const uint16x8_t vLow1 = vmovl_u8(vget_low_u8(vBytes1));
+	const uint16x8_t vLow2 = vmovl_u8(vget_low_u8(vBytes2));
+	const uint16x8_t vHigh1 = vmovl_high_u8(vBytes1);
+	const uint16x8_t vHigh2 = vmovl_high_u8(vBytes2);
+	uint16x8_t vTemp1 = vaddq_u16(vaddq_u16(vLow1,vLow1),vLow2);
+	uint16x8_t vTemp2 = vaddq_u16(vaddq_u16(vHigh1,vHigh1),vHigh2);
+	uint32x4_t vColor3 = vreinterpretq_u32_u8(vcombine_u8(
+		vmovn_u16(vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(vTemp1),21846),16),vshrn_n_u32(vmull_high_n_u16(vTemp1,21846),16))),
+		vmovn_u16(vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(vTemp2),21846),16),vshrn_n_u32(vmull_high_n_u16(vTemp2,21846),16)))));
+	vTemp1 = vaddq_u16(vaddq_u16(vLow2,vLow2),vLow1);
+	vTemp2 = vaddq_u16(vaddq_u16(vHigh2,vHigh2),vHigh1);
+	uint32x4_t vColor4 = vreinterpretq_u32_u8(vcombine_u8(
+		vmovn_u16(vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(vTemp1),21846),16),vshrn_n_u32(vmull_high_n_u16(vTemp1,21846),16))),
+		vmovn_u16(vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(vTemp2),21846),16),vshrn_n_u32(vmull_high_n_u16(vTemp2,21846),16)))));
+	if (!bAlpha) {
+		// 3 color mode is the average and transparent black
+		const uint32x4_t vFour = vcgtq_u32(vColor1,vColor2);
+		const uint32x4_t vHalf = vreinterpretq_u32_u8(vhaddq_u8(vBytes1,vBytes2));
+		vColor3 = vbslq_u32(vFour,vColor3,vHalf);
+		vColor4 = vandq_u32(vFour,vColor4);
+	}
+
+	// Interleave so each block has its 4 colors together
+	uint32x4x4_t vPalettes;
+	vPalettes.val[0] = vColor0;
+	vPalettes.val[1] = vColorB;
+	vPalettes.val[2] = vColor3;
+	vPalettes.val[3] = vColor4;
+	vst4q_u32(pPalettes,vPalettes);
+
+#else
+	i = 0;
+	do {
+		Burger::RGBAWord8_t Colors[4];
+		const uint_t b4Colors = bAlpha || (Color1[i]>Color2[i]);
+		DXTColorPalette(Colors,Color1[i],Color2[i],b4Colors);
+		uint_t j = 0;
+		do {
+			uint_t uAlpha = bAlpha ? 0U : 0xFFU;
+			if ((j==3) && !b4Colors) {
+				uAlpha = 0;
+			}
+			pPalettes[(i*4)+j] = static_cast<uint32_t>(Colors[j].m_uRed)|(static_cast<uint32_t>(Colors[j].m_uGreen)<<8U)|
+				(static_cast<uint32_t>(Colors[j].m_uBlue)<<16U)|(static_cast<uint32_t>(uAlpha)<<24U);
+		} while (++j<4);
+	} while (++i<4);
+#endif
+}
+
+/***************************************
+
+	Write a 4x4 block of pixels from a palette and the 2 bit indexes. If
+	pAlphas is not NULL, it's 16 alphas that are merged into the pixels.
+
+***************************************/
+
+#if defined(USE_SSE2)
+static BURGER_INLINE __m128i DXTSelectRow(uint_t uIndexes,__m128i vColor0,__m128i vColor1,__m128i vColor2,__m128i vColor3) BURGER_NOEXCEPT
+{
+	// Multiply to shift each pixel's index to bit 6 of its lane
+	const __m128i vIndex = _mm_and_si128(_mm_srli_epi32(_mm_mullo_epi16(_mm_set1_epi32(static_cast<int>(uIndexes)),
+		_mm_set_epi32(1,4,16,64)),6),_mm_set1_epi32(3));
+	const __m128i vResult = _mm_or_si128(_mm_and_si128(_mm_cmpeq_epi32(vIndex,_mm_setzero_si128()),vColor0),
+		_mm_and_si128(_mm_cmpeq_epi32(vIndex,_mm_set1_epi32(1)),vColor1));
+	return _mm_or_si128(vResult,_mm_or_si128(_mm_and_si128(_mm_cmpeq_epi32(vIndex,_mm_set1_epi32(2)),vColor2),
+		_mm_and_si128(_mm_cmpeq_epi32(vIndex,_mm_set1_epi32(3)),vColor3)));
+}
+#endif
+
+static void BURGER_API DXTWriteBlock(uint8_t *pOutput,uintptr_t uStride,const uint32_t *pPalette,const uint8_t *pIndexes,const uint8_t *pAlphas) BURGER_NOEXCEPT
+{
+#if defined(USE_SSE2)
+	const __m128i vPalette = _mm_load_si128(reinterpret_cast<const __m128i *>(pPalette));
+	const __m128i vColor0 = _mm_shuffle_epi32(vPalette,0x00);
+	const __m128i vColor1 = _mm_shuffle_epi32(vPalette,0x55);
+	const __m128i vColor2 = _mm_shuffle_epi32(vPalette,0xAA);
+	const __m128i vColor3 = _mm_shuffle_epi32(vPalette,0xFF);
+	__m128i vRow0 = DXTSelectRow(pIndexes[0],vColor0,vColor1,vColor2,vColor3);
+	__m128i vRow1 = DXTSelectRow(pIndexes[1],vColor0,vColor1,vColor2,vColor3);
+	__m128i vRow2 = DXTSelectRow(pIndexes[2],vColor0,vColor1,vColor2,vColor3);
+	__m128i vRow3 = DXTSelectRow(pIndexes[3],vColor0,vColor1,vColor2,vColor3);
+	if (pAlphas) {
+		// Move each alpha byte to the top of its pixel
+		const __m128i vZero = _mm_setzero_si128();
+		const __m128i vAlphas = _mm_load_si128(reinterpret_cast<const __m128i *>(pAlphas));
+		const __m128i vLow = _mm_unpacklo_epi8(vZero,vAlphas);
+		const __m128i vHigh = _mm_unpackhi_epi8(vZero,vAlphas);
+		vRow0 = _mm_or_si128(vRow0,_mm_unpacklo_epi16(vZero,vLow));
+		vRow1 = _mm_or_si128(vRow1,_mm_unpackhi_epi16(vZero,vLow));
+		vRow2 = _mm_or_si128(vRow2,_mm_unpacklo_epi16(vZero,vHigh));
+		vRow3 = _mm_or_si128(vRow3,_mm_unpackhi_epi16(vZero,vHigh));
+	}
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput),vRow0);
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput+uStride),vRow1);
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput+(uStride*2)),vRow2);
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput+(uStride*3)),vRow3);
+
+#elif defined(USE_NEON)
+	// Byte lookups of the palette, out of range lookups are zero
+	static const int32_t g_Shifts[4] = {0,-2,-4,-6};
+	static const uint8_t g_AlphaLookups[4][16] = {
+		{0xFF,0xFF,0xFF,0,0xFF,0xFF,0xFF,1,0xFF,0xFF,0xFF,2,0xFF,0xFF,0xFF,3},
+		{0xFF,0xFF,0xFF,4,0xFF,0xFF,0xFF,5,0xFF,0xFF,0xFF,6,0xFF,0xFF,0xFF,7},
+		{0xFF,0xFF,0xFF,8,0xFF,0xFF,0xFF,9,0xFF,0xFF,0xFF,10,0xFF,0xFF,0xFF,11},
+		{0xFF,0xFF,0xFF,12,0xFF,0xFF,0xFF,13,0xFF,0xFF,0xFF,14,0xFF,0xFF,0xFF,15}};
+	const uint8x16_t vPalette = vld1q_u8(reinterpret_cast<const uint8_t *>(pPalette));
+	const int32x4_t vShifts = vld1q_s32(g_Shifts);
+	const uint32x4_t vThree = vdupq_n_u32(3);
+	const uint32x4_t vBytes = vdupq_n_u32(0x03020100U);
+	uint8x16_t vAlphas = vdupq_n_u8(0);
+	if (pAlphas) {
+		vAlphas = vld1q_u8(pAlphas);
+	}
+	uint_t i = 0;
+	do {
+		const uint32x4_t vIndex = vandq_u32(vshlq_u32(vdupq_n_u32(pIndexes[i]),vShifts),vThree);
+		uint8x16_t vRow = vqtbl1q_u8(vPalette,vreinterpretq_u8_u32(vmlaq_n_u32(vBytes,vIndex,0x04040404U)));
+		if (pAlphas) {
+			vRow = vorrq_u8(vRow,vqtbl1q_u8(vAlphas,vld1q_u8(g_AlphaLookups[i])));
+		}
+		vst1q_u8(pOutput,vRow);
+		pOutput+=uStride;
+	} while (++i<4);
+
+#else
+	uint_t i = 0;
+	do {
+		uint_t uIndex = pIndexes[i];
+		uint32_t *pRow = reinterpret_cast<uint32_t *>(pOutput);
+		uint_t j = 0;
+		do {
+			uint32_t uColor = pPalette[uIndex&3U];
+			uIndex>>=2U;
+			if (pAlphas) {
+				uColor |= static_cast<uint32_t>(pAlphas[(i*4)+j])<<24U;
+			}
+			// Store as bytes, the palette is in RGBA memory order
+			reinterpret_cast<uint8_t *>(pRow+j)[0] = static_cast<uint8_t>(uColor);
+			reinterpret_cast<uint8_t *>(pRow+j)[1] = static_cast<uint8_t>(uColor>>8U);
+			reinterpret_cast<uint8_t *>(pRow+j)[2] = static_cast<uint8_t>(uColor>>16U);
+			reinterpret_cast<uint8_t *>(pRow+j)[3] = static_cast<uint8_t>(uColor>>24U);
+		} while (++j<4);
+		pOutput+=uStride;
+	} while (++i<4);
+#endif
+}
+
+/***************************************
+
+	Decompress the block rows of a band
+
+***************************************/
+
+static uintptr_t BURGER_API DXTDecompressBand(void *pThis) BURGER_NOEXCEPT
+{
+	const DXTJob_t *pJob = static_cast<const DXTJob_t *>(pThis);
+	uint_t uHeight = pJob->m_uHeight;
+	if (uHeight) {
+		const uint8_t *pInput = pJob->m_pInput;
+		uint8_t *pOutput = pJob->m_pOutput;
+		const uintptr_t uOutputStride = pJob->m_uOutputStride;
+		const uintptr_t uPacketSize = pJob->m_uPacketSize;
+		const uint_t uBlocks = (pJob->m_uWidth+3U)>>2U;
+		const Burger::DXTRowProc_t pRowProc = pJob->m_pRowProc;
+		do {
+			if (pJob->m_uFlags&Burger::DXTDECOMPRESS_TILED) {
+				// Tiles are always complete
+				pRowProc(reinterpret_cast<Burger::RGBAWord8_t *>(pOutput),sizeof(Burger::RGBAWord8_t)*4,sizeof(Burger::RGBAWord8_t)*16,pInput,uBlocks);
+				pOutput+=uOutputStride;
+			} else {
+				// Decompress all the complete blocks at once
+				uint_t uX = 0;
+				if (uHeight>=4) {
+					uX = pJob->m_uWidth>>2U;
+					if (uX) {
+						pRowProc(reinterpret_cast<Burger::RGBAWord8_t *>(pOutput),uOutputStride,sizeof(Burger::RGBAWord8_t)*4,pInput,uX);
+					}
+				}
+				// Clip the rest
+				while (uX<uBlocks) {
+					BURGER_ALIGN(Burger::RGBAWord8_t,Local[16],16);
+					pRowProc(Local,sizeof(Burger::RGBAWord8_t)*4,sizeof(Burger::RGBAWord8_t)*16,pInput+(uX*uPacketSize),1);
+					const uint_t uWidth = pJob->m_uWidth-(uX*4U);
+					const uintptr_t uLength = ((uWidth<4) ? uWidth : 4U)*sizeof(Burger::RGBAWord8_t);
+					const uint_t uRows = (uHeight<4) ? uHeight : 4U;
+					uint8_t *pDest = pOutput+(uX*sizeof(Burger::RGBAWord8_t)*4);
+					uint_t uY = 0;
+					do {
+						Burger::memory_copy(pDest,&Local[uY*4],uLength);
+						pDest+=uOutputStride;
+					} while (++uY<uRows);
+					++uX;
+				}
+				pOutput+=uOutputStride*4;
+			}
+			pInput+=pJob->m_uInputStride;
+			if (uHeight<4) {
+				break;
+			}
+			uHeight-=4;
+		} while (uHeight);
+	}
+	return 0;
+}
+
+/***************************************
+
+	DXTRowProc_t for Dxt1Packet_t
+
+***************************************/
+
+static void BURGER_API DXT1DecompressRow(Burger::RGBAWord8_t *pOutput,uintptr_t uStride,uintptr_t uBlockStep,const void *pInput,uint_t uCount) BURGER_NOEXCEPT
+{
+	Burger::Dxt1Packet_t::DecompressRow(pOutput,uStride,uBlockStep,static_cast<const Burger::Dxt1Packet_t *>(pInput),sizeof(Burger::Dxt1Packet_t),uCount);
+}
+
+/***************************************
+
+	DXTBlockProc_t for Dxt1Packet_t
+
+***************************************/
+
+static void BURGER_API DXT1CompressBlock(void *pOutput,const Burger::RGBAWord8_t *pInput,uintptr_t uStride,uint_t uFlags) BURGER_NOEXCEPT
+{
+	static_cast<Burger::Dxt1Packet_t *>(pOutput)->Compress(pInput,uStride,uFlags);
+}
+
+#endif
+
+/*! ************************************
+
+	\enum Burger::eDXTCompress
+	\brief Quality settings for DXT compression
+
+	\ref DXTCOMPRESS_RANGEFIT is quick enough to compress textures as they
+	are loaded, \ref DXTCOMPRESS_CLUSTERFIT is much slower and is meant for
+	offline texture builds.
+
+	\sa Burger::Dxt1Packet_t::Compress(const RGBAWord8_t *,uintptr_t,uint_t)
+
+***************************************/
+
+/*! ************************************
+
+	\typedef Burger::DXTBlockProc_t
+	\brief Function to compress a single 4x4 block
+
+	\sa Burger::CompressDXTImage()
+
+***************************************/
+
 /*! ************************************
 
 	\brief Compress a single 4x4 block with DXT1
 
-	Given an 8 byte block of RGBA data, compress it into a 4x4 DXT1
-	color block. 
+	Given a 4x4 block of RGBA data, compress it into an 8 byte DXT1
+	color block. Pixels with an alpha less than 128 are encoded as
+	transparent, which forces the 3 color mode.
+
+	\ref DXTCOMPRESS_RANGEFIT uses the inset bounding box of the colors
+	as the endpoints. \ref DXTCOMPRESS_CLUSTERFIT also tries every ordered
+	split of the colors along their principal axis in both the 4 and the 3
+	color modes and keeps the result with the lowest error.
 
 	\param pInput Pointer to the start of an array of sixteen \ref RGBAWord8_t encoded 32 bit
 	pixels
 	\param uStride Byte width of each scan line for the block of uncompressed data. The default
 	is sizeof(\ref RGBAWord8_t)*4 to create a single array of 16 RGBAWord8_t pixels in a linear row.
+	\param uFlags \ref DXTCOMPRESS_RANGEFIT or \ref DXTCOMPRESS_CLUSTERFIT
+
+	\sa CompressColor(const RGBAWord8_t *,uintptr_t,uint_t)
 
 ***************************************/
 
-void Burger::Dxt1Packet_t::Compress(const RGBAWord8_t *pInput,uintptr_t uStride)
+void Burger::Dxt1Packet_t::Compress(const RGBAWord8_t *pInput,uintptr_t uStride,uint_t uFlags)
 {
-	// No alpha detected
-	uint_t Unique[16];
-	uint_t uUnique = 0;
-	uint_t uAlpha = FALSE;
-	uint_t i=4;
+	RGBAWord8_t Pixels[16];
+	DXTLoadBlock(Pixels,pInput,uStride);
+	uint_t uTransparent = 0;
+	uint_t i = 0;
 	do {
-		uint_t uColor = Palette::ToRGB16(pInput);
-		pInput = reinterpret_cast<const RGBAWord8_t *>(reinterpret_cast<const uint8_t *>(pInput)+uStride);
-	} while (--i);
+		if (Pixels[i].m_uAlpha<128U) {
+			uTransparent |= 1U<<i;
+		}
+	} while (++i<16);
+	DXTCompressColor(this,Pixels,uTransparent,uFlags,TRUE);
+}
+
+/*! ************************************
+
+	\brief Compress the color of a 4x4 block with DXT1 ignoring alpha
+
+	The block is always encoded in the 4 color mode, as needed by the color
+	half of Dxt3Packet_t and Dxt5Packet_t.
+
+	\param pInput Pointer to the start of an array of sixteen \ref RGBAWord8_t encoded 32 bit
+	pixels
+	\param uStride Byte width of each scan line for the block of uncompressed data. The default
+	is sizeof(\ref RGBAWord8_t)*4 to create a single array of 16 RGBAWord8_t pixels in a linear row.
+	\param uFlags \ref DXTCOMPRESS_RANGEFIT or \ref DXTCOMPRESS_CLUSTERFIT
+
+	\sa Compress(const RGBAWord8_t *,uintptr_t,uint_t)
+
+***************************************/
+
+void Burger::Dxt1Packet_t::CompressColor(const RGBAWord8_t *pInput,uintptr_t uStride,uint_t uFlags)
+{
+	RGBAWord8_t Pixels[16];
+	DXTLoadBlock(Pixels,pInput,uStride);
+	DXTCompressColor(this,Pixels,0,uFlags,FALSE);
+}
+
+/*! ************************************
+
+	\brief Decompress a row of 4x4 blocks compressed with DXT1
+
+	Decompress uCount blocks at once. The palettes of 4 blocks are created
+	in each pass and the pixels are selected from them with SSE2 or NEON
+	when the CPU has them. The output is identical to Decompress().
+
+	If pAlphas is not \ref NULL, it points to 16 alphas for each block to
+	use instead of the DXT1 transparency and the blocks are always in the
+	4 color mode. This is how Dxt3Packet_t and Dxt5Packet_t decompress
+	their colors.
+
+	\param pOutput Pointer to the output of the first block
+	\param uStride Byte width of each scan line of the output
+	\param uBlockStep Bytes between the output of each block, sizeof(\ref RGBAWord8_t)*4 for a
+	bit map or sizeof(\ref RGBAWord8_t)*16 for tiles
+	\param pInput Pointer to the first block to decompress
+	\param uInputStep Bytes between each block of the input
+	\param uCount Number of blocks to decompress
+	\param pAlphas \ref NULL or a 16 byte aligned array of 16 alphas per block
+
+	\sa Decompress(RGBAWord8_t *,uintptr_t) const or DecompressDXTImage()
+
+***************************************/
+
+void BURGER_API Burger::Dxt1Packet_t::DecompressRow(RGBAWord8_t *pOutput,uintptr_t uStride,uintptr_t uBlockStep,const Dxt1Packet_t *pInput,uintptr_t uInputStep,uint_t uCount,const uint8_t *pAlphas)
+{
+	uint8_t *pWork = reinterpret_cast<uint8_t *>(pOutput);
+	while (uCount) {
+		const uint_t uBatch = (uCount<4) ? uCount : 4U;
+		BURGER_ALIGN(uint32_t,Palettes[16],16);
+		DXTColorPalettes(Palettes,pInput,uInputStep,uBatch,pAlphas!=NULL);
+		uint_t i = 0;
+		do {
+			DXTWriteBlock(pWork,uStride,Palettes+(i*4),pInput->m_uColorIndexes,pAlphas);
+			pWork+=uBlockStep;
+			if (pAlphas) {
+				pAlphas+=16;
+			}
+			pInput = reinterpret_cast<const Dxt1Packet_t *>(reinterpret_cast<const uint8_t *>(pInput)+uInputStep);
+		} while (++i<uBatch);
+		uCount-=uBatch;
+	}
 }
-#endif
 
 /*! ************************************
 
@@ -166,67 +1317,139 @@ void Burger::Dxt1Packet_t::Compress(const RGBAWord8_t *pInput,uintptr_t uStride)
 
 	\param pOutput Pointer to the start of a bitmap in the size of uWidth and uHeight \ref RGBAWord8_t encoded 32 bit
 	pixels.
-	\param uOutputStride Number of bytes per scan line of the output bit map (Usually it's uWidth*4)
+	\param uOutputStride Number of bytes per scan line of the output bit map (Usually it's uWidth*4), or
+	bytes per row of tiles if \ref DXTDECOMPRESS_TILED is used
 	\param uWidth Width of the output bitmap in pixels
 	\param uHeight Height of the output bitmap in pixels
 	\param pInput Pointer to a matching bitmap of DXT1 compressed pixels
-	\param uInputStride Byte width of each scan line for the block of compressed data. (Usually it's uWidth*4)
+	\param uInputStride Byte width of each scan line for the block of compressed data. (Usually it's ((uWidth+3)/4)*8)
+	\param uFlags \ref DXTDECOMPRESS_LINEAR or \ref DXTDECOMPRESS_TILED
+	\param uThreadCount Number of threads to use, 0 or 1 for none
+
+	\sa Dxt1Packet_t::DecompressRow() or DecompressDXTImage()
 
 ***************************************/
 
-void BURGER_API Burger::DecompressImage(RGBAWord8_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const Dxt1Packet_t *pInput,uintptr_t uInputStride)
+void BURGER_API Burger::DecompressImage(RGBAWord8_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const Dxt1Packet_t *pInput,uintptr_t uInputStride,uint_t uFlags,uint_t uThreadCount)
+{
+	DecompressDXTImage(pOutput,uOutputStride,uWidth,uHeight,pInput,uInputStride,sizeof(Dxt1Packet_t),uFlags,uThreadCount,DXT1DecompressRow);
+}
+
+/*! ************************************
+
+	\brief Decompress an array of 4x4 DXT blocks
+
+	This is the engine for the DecompressImage() functions. Each row of
+	blocks is decompressed with one call to pProc, only the blocks on the
+	right and bottom edges of a bit map that isn't divisible by four are
+	decompressed one at a time and clipped.
+
+	With \ref DXTDECOMPRESS_TILED, the output isn't a bit map, each block
+	is written as 16 contiguous pixels with the blocks in the same order
+	as the input. Tiles are never clipped, uOutputStride is the number of
+	bytes per row of tiles, usually ((uWidth+3)/4)*64.
+
+	If uThreadCount is greater than one, the rows of blocks are split into
+	bands that are decompressed by that many threads at once.
+
+	\param pOutput Pointer to the output bit map or tiles
+	\param uOutputStride Bytes per scan line or bytes per row of tiles
+	\param uWidth Width of the bitmap in pixels
+	\param uHeight Height of the bitmap in pixels
+	\param pInput Pointer to the first compressed block
+	\param uInputStride Byte width of each row of compressed blocks
+	\param uPacketSize Size in bytes of each compressed block
+	\param uFlags \ref DXTDECOMPRESS_LINEAR or \ref DXTDECOMPRESS_TILED
+	\param uThreadCount Number of threads to use, 0 or 1 for none
+	\param pProc Function to decompress a row of blocks
+
+***************************************/
+
+void BURGER_API Burger::DecompressDXTImage(RGBAWord8_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const void *pInput,uintptr_t uInputStride,uintptr_t uPacketSize,uint_t uFlags,uint_t uThreadCount,DXTRowProc_t pProc)
 {
 	// Anything to process?
 	if (uWidth && uHeight) {
-		// Process a line of blocks
-		do {
-			// Init the steppers
-			uint_t uTempWidth = uWidth;
-			const Dxt1Packet_t *pDXTInput = pInput;
-			RGBAWord8_t *pDest = pOutput;
-			do {
-				// Handle clipping
-				if ((uTempWidth<4) || (uHeight<4)) {
-					// Decompress the block locally
-					RGBAWord8_t LocalPixels[16];
-					pDXTInput->Decompress(LocalPixels,sizeof(RGBAWord8_t)*4);
-					// Write the decompressed pixels to the correct image locations
-					const RGBAWord8_t *pLocal = LocalPixels;
-					RGBAWord8_t *pDest2 = pDest;
-					uint_t uHeightTemp = uHeight;
-					do {
-						uint_t uTempWidth2 = uTempWidth;
-						do {
-							// Copy the pixel value
-							pDest2[0] = pLocal[0];
-							// skip this pixel as its outside the image
-							++pLocal;
-							++pDest2;
-						} while (--uTempWidth2);
-						pLocal = pLocal+(4-uTempWidth);
-						pDest2 = reinterpret_cast<RGBAWord8_t *>(reinterpret_cast<uint8_t *>(pDest2)+uOutputStride)-(4-uTempWidth);
-					} while (--uHeightTemp);
-					if (uTempWidth<4) {
-						break;
-					}
-				} else {
-					// Decompress directly into the output
-					pDXTInput->Decompress(pDest,uOutputStride);
-				}
-				++pDXTInput;		// Next cell
-				pDest+=4;			// Skip 4 pixels
-				uTempWidth-=4;
-			} while (uTempWidth);
+		DXTJob_t Job;
+		Job.m_pOutput = reinterpret_cast<uint8_t *>(pOutput);
+		Job.m_uOutputStride = uOutputStride;
+		Job.m_uPacketSize = uPacketSize;
+		Job.m_pInput = static_cast<const uint8_t *>(pInput);
+		Job.m_uInputStride = uInputStride;
+		Job.m_uWidth = uWidth;
+		Job.m_uHeight = uHeight;
+		Job.m_uFlags = uFlags;
+		Job.m_pProc = NULL;
+		Job.m_pRowProc = pProc;
+		DXTRunBands(&Job,uInputStride,(uFlags&DXTDECOMPRESS_TILED) ? uOutputStride : (uOutputStride*4U),uThreadCount,DXTDecompressBand,"DecompressDXTImage");
+	}
+}
 
-			// Clipped?
-			if (uHeight<4) {
-				break;
-			}
-			uHeight -= 4;
-			// Step to the next line of compressed pixels
-			pInput = reinterpret_cast<const Dxt1Packet_t *>(reinterpret_cast<const uint8_t *>(pInput)+uInputStride);
-			// Step to the next 4 lines
-			pOutput = reinterpret_cast<RGBAWord8_t *>(reinterpret_cast<uint8_t *>(pOutput)+(uOutputStride*4));
-		} while (uHeight);
+/*! ************************************
+
+	\brief Compress a bit map into an array of 4x4 DXT blocks
+
+	This is the engine for the CompressImage() functions. The bit map is
+	split into 4x4 blocks and each one is compressed with pProc. Blocks on
+	the right and bottom edges of a bit map that isn't divisible by four
+	are filled out by repeating the last column and row.
+
+	If uThreadCount is greater than one, the rows of blocks are split into
+	bands that are compressed by that many threads at once.
+
+	\param pOutput Pointer to the first compressed block
+	\param uOutputStride Byte width of each row of compressed blocks
+	\param uPacketSize Size in bytes of each compressed block
+	\param uWidth Width of the input bitmap in pixels
+	\param uHeight Height of the input bitmap in pixels
+	\param pInput Pointer to the bitmap of \ref RGBAWord8_t pixels
+	\param uInputStride Number of bytes per scan line of the input bit map
+	\param uFlags Flags passed to pProc
+	\param uThreadCount Number of threads to use, 0 or 1 for none
+	\param pProc Function to compress a single block
+
+***************************************/
+
+void BURGER_API Burger::CompressDXTImage(void *pOutput,uintptr_t uOutputStride,uintptr_t uPacketSize,uint_t uWidth,uint_t uHeight,const RGBAWord8_t *pInput,uintptr_t uInputStride,uint_t uFlags,uint_t uThreadCount,DXTBlockProc_t pProc)
+{
+	// Anything to process?
+	if (uWidth && uHeight) {
+		DXTJob_t Job;
+		Job.m_pOutput = static_cast<uint8_t *>(pOutput);
+		Job.m_uOutputStride = uOutputStride;
+		Job.m_uPacketSize = uPacketSize;
+		Job.m_pInput = reinterpret_cast<const uint8_t *>(pInput);
+		Job.m_uInputStride = uInputStride;
+		Job.m_uWidth = uWidth;
+		Job.m_uHeight = uHeight;
+		Job.m_uFlags = uFlags;
+		Job.m_pProc = pProc;
+		Job.m_pRowProc = NULL;
+		DXTRunBands(&Job,uInputStride*4U,uOutputStride,uThreadCount,DXTCompressBand,"CompressDXTImage");
 	}
 }
+
+/*! ************************************
+
+	\brief Compress a bit map into an array of 4x4 blocks with DXT1
+
+	\note This function will handle clipping if the source bitmap is not divisible by
+	four in the width or height
+
+	\param pOutput Pointer to a bitmap of DXT1 compressed pixels
+	\param uOutputStride Byte width of each scan line for the block of compressed data. (Usually it's ((uWidth+3)/4)*8)
+	\param uWidth Width of the input bitmap in pixels
+	\param uHeight Height of the input bitmap in pixels
+	\param pInput Pointer to the start of a bitmap in the size of uWidth and uHeight \ref RGBAWord8_t encoded 32 bit
+	pixels.
+	\param uInputStride Number of bytes per scan line of the input bit map (Usually it's uWidth*4)
+	\param uFlags \ref DXTCOMPRESS_RANGEFIT or \ref DXTCOMPRESS_CLUSTERFIT
+	\param uThreadCount Number of threads to use, 0 or 1 for none
+
+	\sa Dxt1Packet_t::Compress(const RGBAWord8_t *,uintptr_t,uint_t)
+
+***************************************/
+
+void BURGER_API Burger::CompressImage(Dxt1Packet_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const RGBAWord8_t *pInput,uintptr_t uInputStride,uint_t uFlags,uint_t uThreadCount)
+{
+	CompressDXTImage(pOutput,uOutputStride,sizeof(Dxt1Packet_t),uWidth,uHeight,pInput,uInputStride,uFlags,uThreadCount,DXT1CompressBlock);
+}
@@ -25,14 +25,29 @@
 
 /* BEGIN */
 namespace Burger {
+enum eDXTCompress {
+	DXTCOMPRESS_RANGEFIT=0,		///< Fast bounding box fit for load time compression
+	DXTCOMPRESS_CLUSTERFIT=1	///< Slow exhaustive cluster fit for the highest quality
+};
+enum eDXTDecompress {
+	DXTDECOMPRESS_LINEAR=0,		///< Decompress into a bit map
+	DXTDECOMPRESS_TILED=1		///< Decompress into 4x4 tiles of 16 contiguous pixels
+};
+typedef void (BURGER_API *DXTBlockProc_t)(void *pOutput,const RGBAWord8_t *pInput,uintptr_t uStride,uint_t uFlags);
+typedef void (BURGER_API *DXTRowProc_t)(RGBAWord8_t *pOutput,uintptr_t uStride,uintptr_t uBlockStep,const void *pInput,uint_t uCount);
 struct Dxt1Packet_t {
 	uint16_t m_uRGB565Color1;			///< First color endpoint in R5:G6:B5 little endian format
 	uint16_t m_uRGB565Color2;			///< Second color endpoint in R5:G6:B5 little endian format
 	uint8_t m_uColorIndexes[4];		///< 2 bits per pixel color indexes for 4x4 tile
 	void Decompress(RGBAWord8_t *pOutput,uintptr_t uStride = sizeof(RGBAWord8_t)*4) const;
-	void Compress(const RGBAWord8_t *pInput,uintptr_t uStride = sizeof(RGBAWord8_t)*4);
+	void Compress(const RGBAWord8_t *pInput,uintptr_t uStride = sizeof(RGBAWord8_t)*4,uint_t uFlags = DXTCOMPRESS_RANGEFIT);
+	void CompressColor(const RGBAWord8_t *pInput,uintptr_t uStride = sizeof(RGBAWord8_t)*4,uint_t uFlags = DXTCOMPRESS_RANGEFIT);
+	static void BURGER_API DecompressRow(RGBAWord8_t *pOutput,uintptr_t uStride,uintptr_t uBlockStep,const Dxt1Packet_t *pInput,uintptr_t uInputStep,uint_t uCount,const uint8_t *pAlphas = NULL);
 };
-extern void BURGER_API DecompressImage(RGBAWord8_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const Dxt1Packet_t *pInput,uintptr_t uInputStride);
+extern void BURGER_API DecompressImage(RGBAWord8_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const Dxt1Packet_t *pInput,uintptr_t uInputStride,uint_t uFlags = DXTDECOMPRESS_LINEAR,uint_t uThreadCount = 1);
+extern void BURGER_API DecompressDXTImage(RGBAWord8_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const void *pInput,uintptr_t uInputStride,uintptr_t uPacketSize,uint_t uFlags,uint_t uThreadCount,DXTRowProc_t pProc);
+extern void BURGER_API CompressImage(Dxt1Packet_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const RGBAWord8_t *pInput,uintptr_t uInputStride,uint_t uFlags = DXTCOMPRESS_RANGEFIT,uint_t uThreadCount = 1);
+extern void BURGER_API CompressDXTImage(void *pOutput,uintptr_t uOutputStride,uintptr_t uPacketSize,uint_t uWidth,uint_t uHeight,const RGBAWord8_t *pInput,uintptr_t uInputStride,uint_t uFlags,uint_t uThreadCount,DXTBlockProc_t pProc);
 }
 /* END */
 
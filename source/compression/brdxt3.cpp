@@ -15,6 +15,15 @@
 #include "brdxt3.h"
 #include "brendian.h"
 
+// Select the vector units used for expanding the alpha
+#if defined(BURGER_SSE2) && defined(BURGER_INTEL) && !defined(DOXYGEN)
+#define USE_SSE2
+#include <emmintrin.h>
+#elif defined(BURGER_NEON) && defined(BURGER_ARM64) && !defined(DOXYGEN)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
+
 /*! ************************************
 
 	\struct Burger::Dxt3Packet_t
@@ -116,6 +125,116 @@ void Burger::Dxt3Packet_t::Decompress(RGBAWord8_t *pOutput,uintptr_t uStride) co
 	} while (--j);
 }
 
+/*! ************************************
+
+	\brief Compress a single 4x4 block with DXT3
+
+	Given a 4x4 block of RGBA data, compress it into a 16 byte DXT3
+	block. Alpha is rounded to the nearest 4 bit value and the color is
+	compressed with Dxt1Packet_t::CompressColor().
+
+	\param pInput Pointer to the start of an array of sixteen \ref RGBAWord8_t encoded 32 bit
+	pixels
+	\param uStride Byte width of each scan line for the block of uncompressed data. The default
+	is sizeof(\ref RGBAWord8_t)*4 to create a single array of 16 RGBAWord8_t pixels in a linear row.
+	\param uFlags \ref DXTCOMPRESS_RANGEFIT or \ref DXTCOMPRESS_CLUSTERFIT
+
+***************************************/
+
+void Burger::Dxt3Packet_t::Compress(const RGBAWord8_t *pInput,uintptr_t uStride,uint_t uFlags)
+{
+	uint8_t *pAlpha = m_uAlpha;
+	const RGBAWord8_t *pRow = pInput;
+	uint_t i = 4;
+	do {
+		// (a+8)/17 is the closest of the 16 values a*17
+		pAlpha[0] = static_cast<uint8_t>(((pRow[0].m_uAlpha+8U)/17U)|(((pRow[1].m_uAlpha+8U)/17U)<<4U));
+		pAlpha[1] = static_cast<uint8_t>(((pRow[2].m_uAlpha+8U)/17U)|(((pRow[3].m_uAlpha+8U)/17U)<<4U));
+		pAlpha+=2;
+		pRow = reinterpret_cast<const RGBAWord8_t *>(reinterpret_cast<const uint8_t *>(pRow)+uStride);
+	} while (--i);
+	reinterpret_cast<Dxt1Packet_t *>(&m_uRGB565Color1)->CompressColor(pInput,uStride,uFlags);
+}
+
+#if !defined(DOXYGEN)
+/***************************************
+
+	DXTRowProc_t for Dxt3Packet_t
+
+***************************************/
+
+static void BURGER_API DXT3DecompressRow(Burger::RGBAWord8_t *pOutput,uintptr_t uStride,uintptr_t uBlockStep,const void *pInput,uint_t uCount) BURGER_NOEXCEPT
+{
+	Burger::Dxt3Packet_t::DecompressRow(pOutput,uStride,uBlockStep,static_cast<const Burger::Dxt3Packet_t *>(pInput),uCount);
+}
+
+/***************************************
+
+	DXTBlockProc_t for Dxt3Packet_t
+
+***************************************/
+
+static void BURGER_API DXT3CompressBlock(void *pOutput,const Burger::RGBAWord8_t *pInput,uintptr_t uStride,uint_t uFlags) BURGER_NOEXCEPT
+{
+	static_cast<Burger::Dxt3Packet_t *>(pOutput)->Compress(pInput,uStride,uFlags);
+}
+#endif
+
+/*! ************************************
+
+	\brief Decompress a row of 4x4 blocks compressed with DXT3
+
+	The 4 bit alphas of up to 4 blocks are expanded at once and the colors
+	are decompressed with Dxt1Packet_t::DecompressRow(). The output is
+	identical to Decompress().
+
+	\param pOutput Pointer to the output of the first block
+	\param uStride Byte width of each scan line of the output
+	\param uBlockStep Bytes between the output of each block, sizeof(\ref RGBAWord8_t)*4 for a
+	bit map or sizeof(\ref RGBAWord8_t)*16 for tiles
+	\param pInput Pointer to the first block to decompress
+	\param uCount Number of blocks to decompress
+
+	\sa Decompress(RGBAWord8_t *,uintptr_t) const or DecompressDXTImage()
+
+***************************************/
+
+void BURGER_API Burger::Dxt3Packet_t::DecompressRow(RGBAWord8_t *pOutput,uintptr_t uStride,uintptr_t uBlockStep,const Dxt3Packet_t *pInput,uint_t uCount)
+{
+	BURGER_ALIGN(uint8_t,Alphas[16*4],16);
+	while (uCount) {
+		const uint_t uBatch = (uCount<4) ? uCount : 4U;
+		uint_t i = 0;
+		do {
+			const uint8_t *pAlpha = pInput[i].m_uAlpha;
+			uint8_t *pDest = Alphas+(i*16);
+#if defined(USE_SSE2)
+			// Split the nibbles, interleave them and scale by 17
+			const __m128i vMask = _mm_set1_epi8(0x0F);
+			const __m128i vPacked = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(pAlpha));
+			const __m128i vNibbles = _mm_unpacklo_epi8(_mm_and_si128(vPacked,vMask),_mm_and_si128(_mm_srli_epi16(vPacked,4),vMask));
+			_mm_store_si128(reinterpret_cast<__m128i *>(pDest),_mm_or_si128(vNibbles,_mm_slli_epi16(vNibbles,4)));
+#elif defined(USE_NEON)
+			const uint8x8_t vPacked = vld1_u8(pAlpha);
+			const uint8x8x2_t vNibbles = vzip_u8(vand_u8(vPacked,vdup_n_u8(0x0F)),vshr_n_u8(vPacked,4));
+			const uint8x16_t vAlphas = vcombine_u8(vNibbles.val[0],vNibbles.val[1]);
+			vst1q_u8(pDest,vorrq_u8(vAlphas,vshlq_n_u8(vAlphas,4)));
+#else
+			uint_t j = 0;
+			do {
+				const uint_t uAlpha = pAlpha[j];
+				pDest[j*2] = static_cast<uint8_t>((uAlpha&0xFU)|(uAlpha<<4U));
+				pDest[(j*2)+1] = static_cast<uint8_t>((uAlpha>>4U)|(uAlpha&0xF0U));
+			} while (++j<8);
+#endif
+		} while (++i<uBatch);
+		Dxt1Packet_t::DecompressRow(pOutput,uStride,uBlockStep,reinterpret_cast<const Dxt1Packet_t *>(&pInput->m_uRGB565Color1),sizeof(Dxt3Packet_t),uBatch,Alphas);
+		pOutput = reinterpret_cast<RGBAWord8_t *>(reinterpret_cast<uint8_t *>(pOutput)+(uBlockStep*uBatch));
+		pInput+=uBatch;
+		uCount-=uBatch;
+	}
+}
+
 /*! ************************************
 
 	\brief Decompress an array of 4x4 block compressed with DXT3
@@ -128,67 +247,46 @@ void Burger::Dxt3Packet_t::Decompress(RGBAWord8_t *pOutput,uintptr_t uStride) co
 
 	\param pOutput Pointer to the start of a bitmap in the size of uWidth and uHeight \ref RGBAWord8_t encoded 32 bit
 	pixels.
-	\param uOutputStride Number of bytes per scan line of the output bit map (Usually it's uWidth*4)
+	\param uOutputStride Number of bytes per scan line of the output bit map (Usually it's uWidth*4), or
+	bytes per row of tiles if \ref DXTDECOMPRESS_TILED is used
 	\param uWidth Width of the output bitmap in pixels
 	\param uHeight Height of the output bitmap in pixels
 	\param pInput Pointer to a matching bitmap of DXT3 compressed pixels
-	\param uInputStride Byte width of each scan line for the block of compressed data. (Usually it's uWidth*4)
+	\param uInputStride Byte width of each scan line for the block of compressed data. (Usually it's ((uWidth+3)/4)*16)
+	\param uFlags \ref DXTDECOMPRESS_LINEAR or \ref DXTDECOMPRESS_TILED
+	\param uThreadCount Number of threads to use, 0 or 1 for none
+
+	\sa Dxt3Packet_t::DecompressRow() or DecompressDXTImage()
 
 ***************************************/
 
-void BURGER_API Burger::DecompressImage(RGBAWord8_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const Dxt3Packet_t *pInput,uintptr_t uInputStride)
+void BURGER_API Burger::DecompressImage(RGBAWord8_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const Dxt3Packet_t *pInput,uintptr_t uInputStride,uint_t uFlags,uint_t uThreadCount)
 {
-	// Anything to process?
-	if (uWidth && uHeight) {
-		// Process a line of blocks
-		do {
-			// Init the steppers
-			uint_t uTempWidth = uWidth;
-			const Dxt3Packet_t *pDXTInput = pInput;
-			RGBAWord8_t *pDest = pOutput;
-			do {
-				// Handle clipping
-				if ((uTempWidth<4) || (uHeight<4)) {
-					// Decompress the block locally
-					RGBAWord8_t LocalPixels[16];
-					pDXTInput->Decompress(LocalPixels,sizeof(RGBAWord8_t)*4);
-					// Write the decompressed pixels to the correct image locations
-					const RGBAWord8_t *pLocal = LocalPixels;
-                    RGBAWord8_t *pDest2 = pDest;
-                    uint_t uHeightTemp = uHeight;
-					do {
-						uint_t uTempWidth2 = uTempWidth;
-						do {
-							// Copy the pixel value
-							pDest2[0] = pLocal[0];
-							// skip this pixel as its outside the image
-							++pLocal;
-							++pDest2;
-						} while (--uTempWidth2);
-						pLocal = pLocal+(4-uTempWidth);
-						pDest2 = reinterpret_cast<RGBAWord8_t *>(reinterpret_cast<uint8_t *>(pDest2)+uOutputStride)-(4-uTempWidth);
-					} while (--uHeightTemp);
-					if (uTempWidth<4) {
-						break;
-					}
-				} else {
-					// Decompress directly into the output
-					pDXTInput->Decompress(pDest,uOutputStride);
-				}
-				++pDXTInput;		// Next cell
-				pDest+=4;			// Skip 4 pixels
-				uTempWidth-=4;
-			} while (uTempWidth);
-
-			// Clipped?
-			if (uHeight<4) {
-				break;
-			}
-			uHeight -= 4;
-			// Step to the next line of compressed pixels
-			pInput = reinterpret_cast<const Dxt3Packet_t *>(reinterpret_cast<const uint8_t *>(pInput)+uInputStride);
-			// Step to the next 4 lines
-			pOutput = reinterpret_cast<RGBAWord8_t *>(reinterpret_cast<uint8_t *>(pOutput)+(uOutputStride*4));
-		} while (uHeight);
-	}
+	DecompressDXTImage(pOutput,uOutputStride,uWidth,uHeight,pInput,uInputStride,sizeof(Dxt3Packet_t),uFlags,uThreadCount,DXT3DecompressRow);
+}
+
+/*! ************************************
+
+	\brief Compress a bit map into an array of 4x4 blocks with DXT3
+
+	\note This function will handle clipping if the source bitmap is not divisible by
+	four in the width or height
+
+	\param pOutput Pointer to a bitmap of DXT3 compressed pixels
+	\param uOutputStride Byte width of each scan line for the block of compressed data. (Usually it's ((uWidth+3)/4)*16)
+	\param uWidth Width of the input bitmap in pixels
+	\param uHeight Height of the input bitmap in pixels
+	\param pInput Pointer to the start of a bitmap in the size of uWidth and uHeight \ref RGBAWord8_t encoded 32 bit
+	pixels.
+	\param uInputStride Number of bytes per scan line of the input bit map (Usually it's uWidth*4)
+	\param uFlags \ref DXTCOMPRESS_RANGEFIT or \ref DXTCOMPRESS_CLUSTERFIT
+	\param uThreadCount Number of threads to use, 0 or 1 for none
+
+	\sa Dxt3Packet_t::Compress(const RGBAWord8_t *,uintptr_t,uint_t) or CompressDXTImage()
+
+***************************************/
+
+void BURGER_API Burger::CompressImage(Dxt3Packet_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const RGBAWord8_t *pInput,uintptr_t uInputStride,uint_t uFlags,uint_t uThreadCount)
+{
+	CompressDXTImage(pOutput,uOutputStride,sizeof(Dxt3Packet_t),uWidth,uHeight,pInput,uInputStride,uFlags,uThreadCount,DXT3CompressBlock);
 }
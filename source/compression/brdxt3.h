@@ -23,6 +23,10 @@
 #include "brpalette.h"
 #endif
 
+#ifndef __BRDXT1_H__
+#include "brdxt1.h"
+#endif
+
 /* BEGIN */
 namespace Burger {
 struct Dxt3Packet_t {
@@ -31,9 +35,11 @@ struct Dxt3Packet_t {
 	uint16_t m_uRGB565Color2;			///< Second color endpoint in R5:G6:B5 little endian format
 	uint8_t m_uColorIndexes[4];		///< 2 bits per pixel color indexes for 4x4 tile
 	void Decompress(RGBAWord8_t *pOutput,uintptr_t uStride = sizeof(RGBAWord8_t)*4) const;
-	void Compress(const RGBAWord8_t *pInput,uintptr_t uStride = sizeof(RGBAWord8_t)*4);
+	void Compress(const RGBAWord8_t *pInput,uintptr_t uStride = sizeof(RGBAWord8_t)*4,uint_t uFlags = DXTCOMPRESS_RANGEFIT);
+	static void BURGER_API DecompressRow(RGBAWord8_t *pOutput,uintptr_t uStride,uintptr_t uBlockStep,const Dxt3Packet_t *pInput,uint_t uCount);
 };
-extern void BURGER_API DecompressImage(RGBAWord8_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const Dxt3Packet_t *pInput,uintptr_t uInputStride);
+extern void BURGER_API DecompressImage(RGBAWord8_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const Dxt3Packet_t *pInput,uintptr_t uInputStride,uint_t uFlags = DXTDECOMPRESS_LINEAR,uint_t uThreadCount = 1);
+extern void BURGER_API CompressImage(Dxt3Packet_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const RGBAWord8_t *pInput,uintptr_t uInputStride,uint_t uFlags = DXTCOMPRESS_RANGEFIT,uint_t uThreadCount = 1);
 }
 /* END */
 
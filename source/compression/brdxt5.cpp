@@ -14,6 +14,16 @@
 
 #include "brdxt5.h"
 #include "brendian.h"
+#include "brmemoryfunctions.h"
+
+// Select the vector units used for the alpha index search
+#if defined(BURGER_SSE2) && defined(BURGER_INTEL) && !defined(DOXYGEN)
+#define USE_SSE2
+#include <emmintrin.h>
+#elif defined(BURGER_NEON) && defined(BURGER_ARM64) && !defined(DOXYGEN)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
 
 /*! ************************************
 
@@ -141,6 +151,330 @@ void Burger::Dxt5Packet_t::Decompress(RGBAWord8_t *pOutput,uintptr_t uStride) co
 	} while (--i);
 }
 
+#if !defined(DOXYGEN)
+
+/***************************************
+
+	Create the alpha palette exactly like Dxt5Packet_t::Decompress() does
+
+***************************************/
+
+static void BURGER_API DXT5AlphaPalette(uint8_t *pAlphas,uint_t uAlpha1,uint_t uAlpha2) BURGER_NOEXCEPT
+{
+	pAlphas[0] = static_cast<uint8_t>(uAlpha1);
+	pAlphas[1] = static_cast<uint8_t>(uAlpha2);
+	if (uAlpha1<=uAlpha2) {
+		uint_t i = 1;
+		do {
+			pAlphas[i+1] = static_cast<uint8_t>((((5U-i)*uAlpha1)+(i*uAlpha2))/5U);
+		} while (++i<5);
+		pAlphas[6] = 0;
+		pAlphas[7] = 255;
+	} else {
+		uint_t i = 1;
+		do {
+			pAlphas[i+1] = static_cast<uint8_t>((((7U-i)*uAlpha1)+(i*uAlpha2))/7U);
+		} while (++i<7);
+	}
+}
+
+/***************************************
+
+	Find the closest of the 8 alphas for each of the 16 pixels, store the
+	3 bit indexes and return the squared error.
+
+***************************************/
+
+static uint32_t BURGER_API DXT5AlphaIndexes(uint8_t *pIndexes,const uint8_t *pInput,uint_t uAlpha1,uint_t uAlpha2) BURGER_NOEXCEPT
+{
+	BURGER_ALIGN(uint8_t,Alphas[16],16);
+	DXT5AlphaPalette(Alphas,uAlpha1,uAlpha2);
+
+	BURGER_ALIGN(uint8_t,Best[16],16);
+#if defined(USE_SSE2)
+	const __m128i vInput = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput));
+	const __m128i vZero = _mm_setzero_si128();
+	__m128i vAlpha = _mm_set1_epi8(static_cast<char>(Alphas[0]));
+	__m128i vBest = _mm_or_si128(_mm_subs_epu8(vInput,vAlpha),_mm_subs_epu8(vAlpha,vInput));
+	__m128i vIndex = vZero;
+	uint_t i = 1;
+	do {
+		vAlpha = _mm_set1_epi8(static_cast<char>(Alphas[i]));
+		const __m128i vDistance = _mm_or_si128(_mm_subs_epu8(vInput,vAlpha),_mm_subs_epu8(vAlpha,vInput));
+		// Keep the old index where Best<=Distance
+		const __m128i vKeep = _mm_cmpeq_epi8(_mm_subs_epu8(vBest,vDistance),vZero);
+		vIndex = _mm_or_si128(_mm_and_si128(vKeep,vIndex),_mm_andnot_si128(vKeep,_mm_set1_epi8(static_cast<char>(i))));
+		vBest = _mm_min_epu8(vBest,vDistance);
+	} while (++i<8);
+	_mm_store_si128(reinterpret_cast<__m128i *>(Best),vBest);
+	BURGER_ALIGN(uint8_t,Indexes[16],16);
+	_mm_store_si128(reinterpret_cast<__m128i *>(Indexes),vIndex);
+#elif defined(USE_NEON)
+	const uint8x16_t vInput = vld1q_u8(pInput);
+	uint8x16_t vBest = vabdq_u8(vInput,vdupq_n_u8(Alphas[0]));
+	uint8x16_t vIndex = vdupq_n_u8(0);
+	uint_t i = 1;
+	do {
+		const uint8x16_t vDistance = vabdq_u8(vInput,vdupq_n_u8(Alphas[i]));
+		vIndex = vbslq_u8(vcltq_u8(vDistance,vBest),vdupq_n_u8(static_cast<uint8_t>(i)),vIndex);
+		vBest = vminq_u8(vBest,vDistance);
+	} while (++i<8);
+	vst1q_u8(Best,vBest);
+	BURGER_ALIGN(uint8_t,Indexes[16],16);
+	vst1q_u8(Indexes,vIndex);
+#else
+	uint8_t Indexes[16];
+	uint_t i = 0;
+	do {
+		const uint_t uInput = pInput[i];
+		uint_t uBest = 256;
+		uint_t j = 0;
+		do {
+			const uint_t uDistance = (uInput>Alphas[j]) ? (uInput-Alphas[j]) : (Alphas[j]-uInput);
+			if (uDistance<uBest) {
+				uBest = uDistance;
+				Indexes[i] = static_cast<uint8_t>(j);
+			}
+		} while (++j<8);
+		Best[i] = static_cast<uint8_t>(uBest);
+	} while (++i<16);
+#endif
+
+	// Pack the indexes into two 24 bit little endian values
+	uint32_t uError = 0;
+	i = 0;
+	do {
+		uError += static_cast<uint32_t>(Best[i])*Best[i];
+	} while (++i<16);
+	i = 0;
+	do {
+		const uint8_t *pWork = Indexes+(i*8);
+		const uint32_t uBits = static_cast<uint32_t>(pWork[0])|(static_cast<uint32_t>(pWork[1])<<3U)|
+			(static_cast<uint32_t>(pWork[2])<<6U)|(static_cast<uint32_t>(pWork[3])<<9U)|
+			(static_cast<uint32_t>(pWork[4])<<12U)|(static_cast<uint32_t>(pWork[5])<<15U)|
+			(static_cast<uint32_t>(pWork[6])<<18U)|(static_cast<uint32_t>(pWork[7])<<21U);
+		pIndexes[(i*3)] = static_cast<uint8_t>(uBits);
+		pIndexes[(i*3)+1] = static_cast<uint8_t>(uBits>>8U);
+		pIndexes[(i*3)+2] = static_cast<uint8_t>(uBits>>16U);
+	} while (++i<2);
+	return uError;
+}
+
+/***************************************
+
+	Refine a pair of 8 alpha mode endpoints with a least squares fit to
+	the indexes they produced. Return FALSE if the fit is degenerate.
+
+***************************************/
+
+static uint_t BURGER_API DXT5AlphaLeastSquares(uint_t *pAlpha1,uint_t *pAlpha2,const uint8_t *pIndexes,const uint8_t *pInput) BURGER_NOEXCEPT
+{
+	// Weight of the first endpoint for each index
+	static const float g_Weights[8] = {1.0f,0.0f,6.0f/7.0f,5.0f/7.0f,4.0f/7.0f,3.0f/7.0f,2.0f/7.0f,1.0f/7.0f};
+	float fAlpha2 = 0.0f;
+	float fBeta2 = 0.0f;
+	float fAlphaBeta = 0.0f;
+	float fAlphaX = 0.0f;
+	float fBetaX = 0.0f;
+	uint_t i = 0;
+	do {
+		const uint32_t uBits = static_cast<uint32_t>(pIndexes[(i>>3U)*3U])|(static_cast<uint32_t>(pIndexes[((i>>3U)*3U)+1])<<8U)|(static_cast<uint32_t>(pIndexes[((i>>3U)*3U)+2])<<16U);
+		const float fAlpha = g_Weights[(uBits>>((i&7U)*3U))&7U];
+		const float fBeta = 1.0f-fAlpha;
+		const float fInput = static_cast<float>(pInput[i]);
+		fAlpha2 += fAlpha*fAlpha;
+		fBeta2 += fBeta*fBeta;
+		fAlphaBeta += fAlpha*fBeta;
+		fAlphaX += fAlpha*fInput;
+		fBetaX += fBeta*fInput;
+	} while (++i<16);
+	const float fDeterminant = (fAlpha2*fBeta2)-(fAlphaBeta*fAlphaBeta);
+	if (fDeterminant<=(1.0f/4096.0f)) {
+		return FALSE;
+	}
+	const float fFactor = 1.0f/fDeterminant;
+	float Endpoints[2];
+	Endpoints[0] = ((fAlphaX*fBeta2)-(fBetaX*fAlphaBeta))*fFactor;
+	Endpoints[1] = ((fBetaX*fAlpha2)-(fAlphaX*fAlphaBeta))*fFactor;
+	i = 0;
+	do {
+		float fValue = Endpoints[i]+0.5f;
+		if (fValue<0.0f) {
+			fValue = 0.0f;
+		} else if (fValue>255.0f) {
+			fValue = 255.0f;
+		}
+		Endpoints[i] = fValue;
+	} while (++i<2);
+	pAlpha1[0] = static_cast<uint_t>(Endpoints[0]);
+	pAlpha2[0] = static_cast<uint_t>(Endpoints[1]);
+	// Must stay in the 8 alpha mode
+	return pAlpha1[0]>pAlpha2[0];
+}
+
+/***************************************
+
+	DXTRowProc_t for Dxt5Packet_t
+
+***************************************/
+
+static void BURGER_API DXT5DecompressRow(Burger::RGBAWord8_t *pOutput,uintptr_t uStride,uintptr_t uBlockStep,const void *pInput,uint_t uCount) BURGER_NOEXCEPT
+{
+	Burger::Dxt5Packet_t::DecompressRow(pOutput,uStride,uBlockStep,static_cast<const Burger::Dxt5Packet_t *>(pInput),uCount);
+}
+
+/***************************************
+
+	DXTBlockProc_t for Dxt5Packet_t
+
+***************************************/
+
+static void BURGER_API DXT5CompressBlock(void *pOutput,const Burger::RGBAWord8_t *pInput,uintptr_t uStride,uint_t uFlags) BURGER_NOEXCEPT
+{
+	static_cast<Burger::Dxt5Packet_t *>(pOutput)->Compress(pInput,uStride,uFlags);
+}
+
+#endif
+
+/*! ************************************
+
+	\brief Compress a single 4x4 block with DXT5
+
+	Given a 4x4 block of RGBA data, compress it into a 16 byte DXT5
+	block. The color is compressed with Dxt1Packet_t::CompressColor().
+
+	\ref DXTCOMPRESS_RANGEFIT uses the smallest and largest alpha as the
+	endpoints of the 8 alpha mode. \ref DXTCOMPRESS_CLUSTERFIT also refines
+	them with a least squares fit and tries the 6 alpha mode with explicit
+	0 and 255, keeping the one with the lowest error.
+
+	\param pInput Pointer to the start of an array of sixteen \ref RGBAWord8_t encoded 32 bit
+	pixels
+	\param uStride Byte width of each scan line for the block of uncompressed data. The default
+	is sizeof(\ref RGBAWord8_t)*4 to create a single array of 16 RGBAWord8_t pixels in a linear row.
+	\param uFlags \ref DXTCOMPRESS_RANGEFIT or \ref DXTCOMPRESS_CLUSTERFIT
+
+***************************************/
+
+void Burger::Dxt5Packet_t::Compress(const RGBAWord8_t *pInput,uintptr_t uStride,uint_t uFlags)
+{
+	// Gather the alphas and their range
+	uint8_t Input[16];
+	uint_t uMin = 255;
+	uint_t uMax = 0;
+	uint_t uInnerMin = 255;
+	uint_t uInnerMax = 0;
+	const RGBAWord8_t *pRow = pInput;
+	uint_t i = 0;
+	do {
+		const uint_t uAlpha = pRow[i&3U].m_uAlpha;
+		Input[i] = static_cast<uint8_t>(uAlpha);
+		if (uAlpha<uMin) {
+			uMin = uAlpha;
+		}
+		if (uAlpha>uMax) {
+			uMax = uAlpha;
+		}
+		// Range without 0 and 255 for the 6 alpha mode
+		if (uAlpha && (uAlpha!=255U)) {
+			if (uAlpha<uInnerMin) {
+				uInnerMin = uAlpha;
+			}
+			if (uAlpha>uInnerMax) {
+				uInnerMax = uAlpha;
+			}
+		}
+		if ((i&3U)==3U) {
+			pRow = reinterpret_cast<const RGBAWord8_t *>(reinterpret_cast<const uint8_t *>(pRow)+uStride);
+		}
+	} while (++i<16);
+
+	// The 8 alpha mode with the full range
+	uint32_t uBestError = DXT5AlphaIndexes(m_uAlphaIndexes[0],Input,uMax,uMin);
+	m_uAlpha1 = static_cast<uint8_t>(uMax);
+	m_uAlpha2 = static_cast<uint8_t>(uMin);
+
+	if ((uFlags&DXTCOMPRESS_CLUSTERFIT) && uBestError) {
+		uint8_t Indexes[6];
+		uint_t uAlpha1;
+		uint_t uAlpha2;
+		if (DXT5AlphaLeastSquares(&uAlpha1,&uAlpha2,m_uAlphaIndexes[0],Input)) {
+			const uint32_t uError = DXT5AlphaIndexes(Indexes,Input,uAlpha1,uAlpha2);
+			if (uError<uBestError) {
+				uBestError = uError;
+				m_uAlpha1 = static_cast<uint8_t>(uAlpha1);
+				m_uAlpha2 = static_cast<uint8_t>(uAlpha2);
+				memory_copy(m_uAlphaIndexes,Indexes,sizeof(Indexes));
+			}
+		}
+		// The 6 alpha mode, only 0 and 255?
+		if (uInnerMin>uInnerMax) {
+			uInnerMin = 0;
+			uInnerMax = 0;
+		}
+		const uint32_t uError = DXT5AlphaIndexes(Indexes,Input,uInnerMin,uInnerMax);
+		if (uError<uBestError) {
+			m_uAlpha1 = static_cast<uint8_t>(uInnerMin);
+			m_uAlpha2 = static_cast<uint8_t>(uInnerMax);
+			memory_copy(m_uAlphaIndexes,Indexes,sizeof(Indexes));
+		}
+	}
+	reinterpret_cast<Dxt1Packet_t *>(&m_uRGB565Color1)->CompressColor(pInput,uStride,uFlags);
+}
+
+/*! ************************************
+
+	\brief Decompress a row of 4x4 blocks compressed with DXT5
+
+	The alphas of up to 4 blocks are looked up at once and the colors are
+	decompressed with Dxt1Packet_t::DecompressRow(). The output is
+	identical to Decompress().
+
+	\param pOutput Pointer to the output of the first block
+	\param uStride Byte width of each scan line of the output
+	\param uBlockStep Bytes between the output of each block, sizeof(\ref RGBAWord8_t)*4 for a
+	bit map or sizeof(\ref RGBAWord8_t)*16 for tiles
+	\param pInput Pointer to the first block to decompress
+	\param uCount Number of blocks to decompress
+
+	\sa Decompress(RGBAWord8_t *,uintptr_t) const or DecompressDXTImage()
+
+***************************************/
+
+void BURGER_API Burger::Dxt5Packet_t::DecompressRow(RGBAWord8_t *pOutput,uintptr_t uStride,uintptr_t uBlockStep,const Dxt5Packet_t *pInput,uint_t uCount)
+{
+	BURGER_ALIGN(uint8_t,Alphas[16*4],16);
+	while (uCount) {
+		const uint_t uBatch = (uCount<4) ? uCount : 4U;
+		uint_t i = 0;
+		do {
+			const Dxt5Packet_t *pBlock = &pInput[i];
+			uint8_t Palette[8];
+			DXT5AlphaPalette(Palette,pBlock->m_uAlpha1,pBlock->m_uAlpha2);
+			uint8_t *pDest = Alphas+(i*16);
+			uint_t j = 0;
+			do {
+				// Two 24 bit little endian groups of 3 bit indexes
+				const uint8_t *pIndexes = pBlock->m_uAlphaIndexes[j];
+				const uint_t uIndexes = static_cast<uint_t>(pIndexes[0])|(static_cast<uint_t>(pIndexes[1])<<8U)|(static_cast<uint_t>(pIndexes[2])<<16U);
+				pDest[0] = Palette[uIndexes&7U];
+				pDest[1] = Palette[(uIndexes>>3U)&7U];
+				pDest[2] = Palette[(uIndexes>>6U)&7U];
+				pDest[3] = Palette[(uIndexes>>9U)&7U];
+				pDest[4] = Palette[(uIndexes>>12U)&7U];
+				pDest[5] = Palette[(uIndexes>>15U)&7U];
+				pDest[6] = Palette[(uIndexes>>18U)&7U];
+				pDest[7] = Palette[uIndexes>>21U];
+				pDest+=8;
+			} while (++j<2);
+		} while (++i<uBatch);
+		Dxt1Packet_t::DecompressRow(pOutput,uStride,uBlockStep,reinterpret_cast<const Dxt1Packet_t *>(&pInput->m_uRGB565Color1),sizeof(Dxt5Packet_t),uBatch,Alphas);
+		pOutput = reinterpret_cast<RGBAWord8_t *>(reinterpret_cast<uint8_t *>(pOutput)+(uBlockStep*uBatch));
+		pInput+=uBatch;
+		uCount-=uBatch;
+	}
+}
+
 /*! ************************************
 
 	\brief Decompress an array of 4x4 block compressed with DXT5
@@ -153,67 +487,46 @@ void Burger::Dxt5Packet_t::Decompress(RGBAWord8_t *pOutput,uintptr_t uStride) co
 
 	\param pOutput Pointer to the start of a bitmap in the size of uWidth and uHeight \ref RGBAWord8_t encoded 32 bit
 	pixels.
-	\param uOutputStride Number of bytes per scan line of the output bit map (Usually it's uWidth*4)
+	\param uOutputStride Number of bytes per scan line of the output bit map (Usually it's uWidth*4), or
+	bytes per row of tiles if \ref DXTDECOMPRESS_TILED is used
 	\param uWidth Width of the output bitmap in pixels
 	\param uHeight Height of the output bitmap in pixels
 	\param pInput Pointer to a matching bitmap of DXT5 compressed pixels
-	\param uInputStride Byte width of each scan line for the block of compressed data. (Usually it's uWidth*4)
+	\param uInputStride Byte width of each scan line for the block of compressed data. (Usually it's ((uWidth+3)/4)*16)
+	\param uFlags \ref DXTDECOMPRESS_LINEAR or \ref DXTDECOMPRESS_TILED
+	\param uThreadCount Number of threads to use, 0 or 1 for none
+
+	\sa Dxt5Packet_t::DecompressRow() or DecompressDXTImage()
 
 ***************************************/
 
-void BURGER_API Burger::DecompressImage(RGBAWord8_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const Dxt5Packet_t *pInput,uintptr_t uInputStride)
+void BURGER_API Burger::DecompressImage(RGBAWord8_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const Dxt5Packet_t *pInput,uintptr_t uInputStride,uint_t uFlags,uint_t uThreadCount)
 {
-	// Anything to process?
-	if (uWidth && uHeight) {
-		// Process a line of blocks
-		do {
-			// Init the steppers
-			uint_t uTempWidth = uWidth;
-			const Dxt5Packet_t *pDXTInput = pInput;
-			RGBAWord8_t *pDest = pOutput;
-			do {
-				// Handle clipping
-				if ((uTempWidth<4) || (uHeight<4)) {
-					// Decompress the block locally
-					RGBAWord8_t LocalPixels[16];
-					pDXTInput->Decompress(LocalPixels,sizeof(RGBAWord8_t)*4);
-					// Write the decompressed pixels to the correct image locations
-					const RGBAWord8_t *pLocal = LocalPixels;
-					RGBAWord8_t *pDest2 = pDest;
-					uint_t uHeightTemp = uHeight;
-					do {
-						uint_t uTempWidth2 = uTempWidth;
-						do {
-							// Copy the pixel value
-							pDest2[0] = pLocal[0];
-							// skip this pixel as its outside the image
-							++pLocal;
-							++pDest2;
-						} while (--uTempWidth2);
-						pLocal = pLocal+(4-uTempWidth);
-						pDest2 = reinterpret_cast<RGBAWord8_t *>(reinterpret_cast<uint8_t *>(pDest2)+uOutputStride)-(4-uTempWidth);
-					} while (--uHeightTemp);
-					if (uTempWidth<4) {
-						break;
-					}
-				} else {
-					// Decompress directly into the output
-					pDXTInput->Decompress(pDest,uOutputStride);
-				}
-				++pDXTInput;		// Next cell
-				pDest+=4;			// Skip 4 pixels
-				uTempWidth-=4;
-			} while (uTempWidth);
-
-			// Clipped?
-			if (uHeight<4) {
-				break;
-			}
-			uHeight -= 4;
-			// Step to the next line of compressed pixels
-			pInput = reinterpret_cast<const Dxt5Packet_t *>(reinterpret_cast<const uint8_t *>(pInput)+uInputStride);
-			// Step to the next 4 lines
-			pOutput = reinterpret_cast<RGBAWord8_t *>(reinterpret_cast<uint8_t *>(pOutput)+(uOutputStride*4));
-		} while (uHeight);
-	}
+	DecompressDXTImage(pOutput,uOutputStride,uWidth,uHeight,pInput,uInputStride,sizeof(Dxt5Packet_t),uFlags,uThreadCount,DXT5DecompressRow);
+}
+
+/*! ************************************
+
+	\brief Compress a bit map into an array of 4x4 blocks with DXT5
+
+	\note This function will handle clipping if the source bitmap is not divisible by
+	four in the width or height
+
+	\param pOutput Pointer to a bitmap of DXT5 compressed pixels
+	\param uOutputStride Byte width of each scan line for the block of compressed data. (Usually it's ((uWidth+3)/4)*16)
+	\param uWidth Width of the input bitmap in pixels
+	\param uHeight Height of the input bitmap in pixels
+	\param pInput Pointer to the start of a bitmap in the size of uWidth and uHeight \ref RGBAWord8_t encoded 32 bit
+	pixels.
+	\param uInputStride Number of bytes per scan line of the input bit map (Usually it's uWidth*4)
+	\param uFlags \ref DXTCOMPRESS_RANGEFIT or \ref DXTCOMPRESS_CLUSTERFIT
+	\param uThreadCount Number of threads to use, 0 or 1 for none
+
+	\sa Dxt5Packet_t::Compress(const RGBAWord8_t *,uintptr_t,uint_t) or CompressDXTImage()
+
+***************************************/
+
+void BURGER_API Burger::CompressImage(Dxt5Packet_t *pOutput,uintptr_t uOutputStride,uint_t uWidth,uint_t uHeight,const RGBAWord8_t *pInput,uintptr_t uInputStride,uint_t uFlags,uint_t uThreadCount)
+{
+	CompressDXTImage(pOutput,uOutputStride,sizeof(Dxt5Packet_t),uWidth,uHeight,pInput,uInputStride,uFlags,uThreadCount,DXT5CompressBlock);
 }
@@ -628,6 +628,46 @@ Burger::eError BURGER_API Burger::File::set_creation_time(
 }
 #endif
 
+/*! ************************************
+
+	\brief Write several buffers into an open file
+
+	Write each buffer in order as if write(const void*, uintptr_t) was called
+	for each one. On platforms with a gather write call like writev(), all
+	the buffers are passed to the operating system at once.
+
+	Stops on the first buffer that can't be completely written.
+
+	\param pInput Pointer to an array of buffers to write
+	\param uCount Number of entries in the array
+
+	\return Number of bytes written (Can be less than what was requested due to
+		EOF or write errors)
+
+	\sa write(const void*, uintptr_t)
+
+***************************************/
+
+#if !defined(BURGER_UNIX) || defined(DOXYGEN)
+uintptr_t BURGER_API Burger::File::write_gather(
+	const IOVector_t* pInput, uintptr_t uCount) BURGER_NOEXCEPT
+{
+	uintptr_t uResult = 0;
+	if (uCount) {
+		do {
+			const uintptr_t uWritten =
+				write(pInput->m_pData, pInput->m_uLength);
+			uResult += uWritten;
+			if (uWritten != pInput->m_uLength) {
+				break;
+			}
+			++pInput;
+		} while (--uCount);
+	}
+	return uResult;
+}
+#endif
+
 /*! ************************************
 
 	\brief Open a file asynchronously.
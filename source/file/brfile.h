@@ -48,6 +48,14 @@ public:
 		kReadWrite
 	};
 
+	/** Pointer and length of one buffer for write_gather() */
+	struct IOVector_t {
+		/** Pointer to the data to write */
+		const void* m_pData;
+		/** Number of bytes to write */
+		uintptr_t m_uLength;
+	};
+
 protected:
 	/** Open file reference */
 	void* m_pFile;
@@ -108,6 +116,8 @@ public:
 		void* pOutput, uintptr_t uSize) BURGER_NOEXCEPT;
 	uintptr_t BURGER_API write(
 		const void* pInput, uintptr_t uSize) BURGER_NOEXCEPT;
+	uintptr_t BURGER_API write_gather(
+		const IOVector_t* pInput, uintptr_t uCount) BURGER_NOEXCEPT;
 	uint64_t BURGER_API get_mark(void) BURGER_NOEXCEPT;
 	eError BURGER_API set_mark(uint64_t uMark) BURGER_NOEXCEPT;
 	eError BURGER_API set_mark_at_EOF(void) BURGER_NOEXCEPT;
@@ -196,37 +196,61 @@ void BURGER_API Burger::FileBMP::CompressRLE8(OutputMemoryStream* pOutput,
 		2 : Delta, get two bytes for a pen move code (Not used)
 		3-0xFF absolute run (But uint16_t align the source pointer after run)
 
+	The data is read directly from memory, runs are filled and absolute runs
+	are copied a block at a time. The end of data token is not consumed so
+	decompressing more lines will stop at it.
+
 	\param pOutput Buffer to accept the decompressed data
 	\param uOutputLength Length of the buffer for decompressed data
-	\param pInput Data stream to read compressed data from
+	\param pInput Pointer to the compressed data
+	\param uInputLength Number of bytes of compressed data
+	\param pInputUsed Pointer to receive the number of bytes consumed
 
 	\return \ref NULL if success or a pointer to a string describing the error
+	\sa DecompressRLE8(uint8_t*, uintptr_t, InputMemoryStream*)
 
 ***************************************/
 
-const char* BURGER_API Burger::FileBMP::DecompressRLE8(
-	uint8_t* pOutput, uintptr_t uOutputLength, InputMemoryStream* pInput)
+const char* BURGER_API Burger::FileBMP::DecompressRLE8(uint8_t* pOutput,
+	uintptr_t uOutputLength, const uint8_t* pInput, uintptr_t uInputLength,
+	uintptr_t* pInputUsed)
 {
 	const char* pBadNews = NULL;
+	const uint8_t* pWork = pInput;
+	const uint8_t* pEnd = pInput + uInputLength;
 	// Any data to parse?
 	if (uOutputLength) {
 		for (;;) {
-			uint_t uToken = pInput->GetByte(); // Get the token
-			if (uToken) {                      // Is it a run length?
-				if (uOutputLength < uToken) {  // Too big for the output?
+			// Missing data reads as an end of line token
+			if ((pEnd - pWork) < 2) {
+				pWork = pEnd;
+				if (uOutputLength) {
+					pBadNews = "Insufficient data in RLE8 packed array!";
+				}
+				break;
+			}
+			uint_t uToken = pWork[0]; // Get the token
+			if (uToken) {             // Is it a run length?
+				if (uOutputLength < uToken) { // Too big for the output?
 					// Abort
 					pBadNews = "Run length is too large in RLE8 BMP file!";
 					break;
 				}
 				uOutputLength = uOutputLength - uToken; // Remove the length
-				uint8_t uFill = pInput->GetByte();      // Get the fill byte
-				do {
-					pOutput[0] = uFill; // Fill the buffer
-					++pOutput;
-				} while (--uToken); // Run done?
+				const uint8_t uFill = pWork[1];         // Get the fill byte
+				if (uToken >= 16U) {
+					memory_set(pOutput, uFill, uToken); // Fill the buffer
+					pOutput += uToken;
+				} else {
+					do {
+						pOutput[0] = uFill; // Fill the buffer
+						++pOutput;
+					} while (--uToken); // Run done?
+				}
+				pWork += 2;
 			} else {
-				uToken = pInput->GetByte(); // Get the uncompressed run size
-				if (uToken < 3) {           // End of file or line?
+				uToken = pWork[1]; // Get the uncompressed run size
+				if (uToken < 3) {  // End of file or line?
 					if (uToken == 2) {
 						pBadNews = "Can't accept a jump RLE opcode!";
 						break;
@@ -236,8 +260,9 @@ const char* BURGER_API Burger::FileBMP::DecompressRLE8(
 						pBadNews = "Insufficient data in RLE8 packed array!";
 						break;
 					}
-					if (uToken == 1) {
-						pInput->SkipBack(2); // Force this token permanently!
+					// Leave the end of data token for the next line
+					if (uToken == 0) {
+						pWork += 2;
 					}
 					break; // Exit processing
 				}
@@ -246,19 +271,55 @@ const char* BURGER_API Burger::FileBMP::DecompressRLE8(
 					break;
 				}
 				uOutputLength = uOutputLength - uToken; // Remove the length
-				pInput->Get(pOutput, uToken);
-				pOutput += uToken; // Adjust the output pointer
-				if (uToken & 1) {
-					pInput->GetByte(); // Skip a single byte
+				pWork += 2;
+				uintptr_t uAvailable = static_cast<uintptr_t>(pEnd - pWork);
+				if (uAvailable < uToken) {
+					// Truncated, zero the rest
+					memory_copy(pOutput, pWork, uAvailable);
+					memory_clear(pOutput + uAvailable, uToken - uAvailable);
+					pWork = pEnd;
+				} else {
+					memory_copy(pOutput, pWork, uToken);
+					// Runs are padded to 16 bits
+					pWork += uToken + (uToken & 1U);
+					if (pWork > pEnd) {
+						pWork = pEnd;
+					}
 				}
+				pOutput += uToken; // Adjust the output pointer
 			}
 		}
 	}
+	pInputUsed[0] = static_cast<uintptr_t>(pWork - pInput);
 
 	// Was there an error?
 	return pBadNews;
 }
 
+/*! ************************************
+
+	\brief Unpack a single line of RLE data for a BMP file using RLE8 format.
+
+	\param pOutput Buffer to accept the decompressed data
+	\param uOutputLength Length of the buffer for decompressed data
+	\param pInput Data stream to read compressed data from
+
+	\return \ref NULL if success or a pointer to a string describing the error
+	\sa DecompressRLE8(uint8_t*, uintptr_t, const uint8_t*, uintptr_t,
+		uintptr_t*)
+
+***************************************/
+
+const char* BURGER_API Burger::FileBMP::DecompressRLE8(
+	uint8_t* pOutput, uintptr_t uOutputLength, InputMemoryStream* pInput)
+{
+	uintptr_t uUsed;
+	const char* pBadNews = DecompressRLE8(pOutput, uOutputLength,
+		pInput->GetPtr(), pInput->BytesRemaining(), &uUsed);
+	pInput->SkipForward(uUsed);
+	return pBadNews;
+}
+
 /*! ************************************
 
 	\brief Default constructor
@@ -430,67 +491,70 @@ uint_t BURGER_API Burger::FileBMP::Load(
 		// Get the pointer to the BOTTOM scan line to flip
 		// the image
 		uint8_t* pData = pOutput->GetImage() + ((uHeight - 1) * uStride);
+		const uint8_t* pSource = pInput->GetPtr();
+		const uint8_t* pEnd = pSource + pInput->BytesRemaining();
 		if (uCompression == BMP_RLE8) {
 			uint_t i = uHeight;
 			do {
-				pBadNews = DecompressRLE8(pData, uWidth, pInput);
+				uintptr_t uUsed;
+				pBadNews = DecompressRLE8(pData, uWidth, pSource,
+					static_cast<uintptr_t>(pEnd - pSource), &uUsed);
+				pSource += uUsed;
 				if (pBadNews) { // Error?
 					break;
 				}
 				pData = pData - uStride; // Next line up
 			} while (--i);               // All done?
 		} else {
+			uint_t uPixelSize = uBitDepth >> 3U;
+			uintptr_t uRowSize = uWidth * uPixelSize;
+			uint_t uBMPPadding = static_cast<uint_t>((0 - uRowSize) & 3);
 			uint_t i = uHeight;
-			if (uBitDepth == 8) {
-				uint_t uBMPPadding = (0 - uWidth) & 3;
-				do {
-					pInput->Get(pData, uWidth);       // Copy the line
-					pInput->SkipForward(uBMPPadding); // Handle padding
-					pData = pData - uStride;          // Next line up
-				} while (--i);
-			} else if (uBitDepth == 16) {
-				uint_t uBMPPadding = (0 - (uWidth * 2)) & 3;
-				do {
-					uint_t j = uWidth; // Pixel count
+			do {
+				uintptr_t uAvailable = static_cast<uintptr_t>(pEnd - pSource);
+				if (uAvailable < uRowSize) {
+					// Truncated file, the rest of the image stays zero
+					uintptr_t uPixels = uAvailable / uPixelSize;
+					if (uPixels) {
+						// Only convert the whole pixels
+						i = 1;
+						uAvailable = uPixels;
+					} else {
+						break;
+					}
+				} else {
+					uAvailable = uWidth;
+				}
+				if (uBitDepth == 8) {
+					memory_copy(pData, pSource, uAvailable); // Copy the line
+				} else if (uBitDepth == 16) {
 					uint8_t* pDest = pData;
+					const uint8_t* pWork = pSource;
+					uintptr_t j = uAvailable; // Pixel count
 					do {
 						reinterpret_cast<uint16_t*>(pDest)[0] =
-							static_cast<uint16_t>(pInput->GetShort() & 0x7FFF);
-						pDest = pDest + 2;            // Next pixel
-					} while (--j);                    // Count down
-					pInput->SkipForward(uBMPPadding); // Handle padding
-					pData = pData - uStride;          // Next line up
-				} while (--i);
-			} else if (uBitDepth == 24) {
-				uint_t uBMPPadding = (0 - (uWidth * 3)) & 3;
-				do {
-					uint_t j = uWidth; // Pixel count
-					uint8_t* pDest = pData;
-					do {
-						pDest[2] = pInput->GetByte(); // Blue
-						pDest[1] = pInput->GetByte(); // Green
-						pDest[0] = pInput->GetByte(); // Red
-						pDest = pDest + 3;            // Next pixel
-					} while (--j);                    // Count down
-					pInput->SkipForward(uBMPPadding); // Handle padding
-					pData = pData - uStride;          // Next line up
-				} while (--i);
-			} else {
-				// RGBA
-				do {
-					uint_t j = uWidth; // Pixel count
-					uint8_t* pDest = pData;
-					do {
-						pDest[2] = pInput->GetByte(); // Blue
-						pDest[1] = pInput->GetByte(); // Green
-						pDest[0] = pInput->GetByte(); // Red
-						pDest[3] = pInput->GetByte(); // Alpha
-						pDest = pDest + 4;            // Next pixel
-					} while (--j);                    // Count down
-					pData = pData - uStride;          // Next line up
-				} while (--i);
-			}
+							static_cast<uint16_t>(
+								(pWork[0] + (pWork[1] << 8U)) & 0x7FFF);
+						pWork += 2;
+						pDest = pDest + 2; // Next pixel
+					} while (--j);         // Count down
+				} else if (uBitDepth == 24) {
+					Image::SwapRedBlue24(pData, pSource, uAvailable);
+				} else {
+					// RGBA
+					Image::SwapRedBlue32(pData, pSource, uAvailable);
+				}
+				pSource += uAvailable * uPixelSize;
+				// Handle padding
+				if (static_cast<uintptr_t>(pEnd - pSource) < uBMPPadding) {
+					pSource = pEnd;
+				} else {
+					pSource += uBMPPadding;
+				}
+				pData = pData - uStride; // Next line up
+			} while (--i);
 		}
+		pInput->SkipForward(static_cast<uintptr_t>(pSource - pInput->GetPtr()));
 	}
 
 	// If there was an error, clean up
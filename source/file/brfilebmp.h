@@ -47,6 +47,7 @@ class FileBMP {
 	RGBAWord8_t m_Palette[256];		///< Palette found in the image
 public:
 	static void BURGER_API CompressRLE8(OutputMemoryStream *pOutput,const uint8_t *pInput,uintptr_t uInputLength,uint_t bSendEOP);
+	static const char * BURGER_API DecompressRLE8(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength,uintptr_t *pInputUsed);
 	static const char * BURGER_API DecompressRLE8(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput);
 	enum {
 		BMP_RGB=0,			///< Raw pixels
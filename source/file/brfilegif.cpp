@@ -17,6 +17,14 @@
 #include "brglobalmemorymanager.h"
 #include "brmemoryfunctions.h"
 
+#if defined(BURGER_SSE2) && defined(BURGER_INTEL) && !defined(DOXYGEN)
+#define USE_SSE2
+#include <emmintrin.h>
+#elif defined(BURGER_NEON) && defined(BURGER_ARM64) && !defined(DOXYGEN)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
+
 /***************************************
 
 	The structures below are for reference only
@@ -160,8 +168,9 @@ Burger::GIFEncoder * BURGER_API Burger::GIFEncoder::new_object(void)
 	\fn uint_t Burger::GIFEncoder::GetHashKey(uint_t uInput)
 	\brief Create a hash key
 
-	Given a 16 bit value of the current and previous pixel, return a hash
-	value to index into the hash table
+	Given a 20 bit value of the current LZW code and the next pixel, return a
+	hash value to index into the hash table. A multiplicative hash is used so
+	codes that only differ in the pixel are spread across the table.
 
 	\param uInput Value with LZW code shifted left by 8 bits and the pixel in the lower 8 bits
 	\return Hash of the key
@@ -481,10 +490,21 @@ void Burger::GIFEncoder::WritePixels(const uint8_t *pInput,uintptr_t uInputLengt
 			--uInputLength;
 			// Create a hash key based on the current pixel and the previous one
 			uint_t uKey = (uCurrentCode << 8U) + uPixel;
-			uint_t uHashCode = LookupHash(uKey);
-			if (uHashCode != UINT32_MAX) {
+
+			// Probe the hash only once, on a miss, uHashKey is left on the
+			// empty entry the new string goes into
+			uint_t uHashKey = GetHashKey(uKey);
+			uint_t uEntry;
+			while ((uEntry = m_HashTable[uHashKey]) != UINT32_MAX) {
+				if (GetKey(uEntry) == uKey) {
+					break;
+				}
+				// Index to the next hash entry (With table wrap)
+				uHashKey = (uHashKey+1U) & cHashKeyMask;
+			}
+			if (uEntry != UINT32_MAX) {
 				// Key is found!
-				uCurrentCode = uHashCode;
+				uCurrentCode = GetCode(uEntry);
 			} else {
 				// Not found, add it to the hash
 				WriteCode(uCurrentCode);
@@ -500,10 +520,10 @@ void Burger::GIFEncoder::WritePixels(const uint8_t *pInput,uintptr_t uInputLengt
 					ClearHash();
 				} else {
 					// Add this to the hash
-					AddHashEntry(uKey,m_uRunningCode);
+					m_HashTable[uHashKey] = PutKey(uKey) | PutCode(m_uRunningCode);
 					++m_uRunningCode;
 				}
-			}	
+			}
 		}
 
 		// Save the last code checked
@@ -512,14 +532,6 @@ void Burger::GIFEncoder::WritePixels(const uint8_t *pInput,uintptr_t uInputLengt
 }
 
 
-/***************************************
-
-	These variables are used by the LZW decompresser
-
-***************************************/
-
-static const uint_t g_MaskTable[] = {0x1,0x2,0x4,0x8,0x10,0x20,0x40,0x80,0x100,0x200,0x400,0x800,0x1FFF};
-
 /*! ************************************
 
 	\class Burger::GIFDecoder
@@ -527,105 +539,76 @@ static const uint_t g_MaskTable[] = {0x1,0x2,0x4,0x8,0x10,0x20,0x40,0x80,0x100,0
 
 	This class will decompress LZW data in the GIF format
 
+	The data blocks are first gathered into one buffer so codes can be
+	read from a 32 bit window at any bit position instead of one bit at a
+	time. Each dictionary entry points to the first place its string was
+	written in the output, so strings are copied forward from the output
+	without walking a chain of prefixes.
+
 	\sa FileGIF or GIFEncoder
 
 ***************************************/
 
-/*! ************************************
-
-	\brief Init the LZW permanent tokens
+#if !defined(DOXYGEN)
 
-***************************************/
+//
+// Copy a string that was already decoded, 16 bytes at a time if there is
+// room at the end of the output. The source always ends at or before the
+// start of the destination.
+//
 
-void Burger::GIFDecoder::Init(void)
+static BURGER_INLINE void GIFCopyString(uint8_t *pOutput,const uint8_t *pInput,uintptr_t uLength,const uint8_t *pEnd)
 {
-	m_uBitBucket = 0;
-	m_uBitCount = 0;
-    m_uChunkCount = 0;
-    uintptr_t i = 0;
-	uint8_t *pDest = m_LZWArray;
-
-	// Note, only the first 256 entries of m_LZWSize
-	// and m_LZWTable need to be initialized
-
+#if defined(USE_SSE2) || defined(USE_NEON)
+	if ((pOutput+uLength+15U)<=pEnd) {
+		do {
+#if defined(USE_SSE2)
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput),_mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput)));
+#else
+			vst1q_u8(pOutput,vld1q_u8(pInput));
+#endif
+			pOutput += 16;
+			pInput += 16;
+			if (uLength<=16U) {
+				break;
+			}
+			uLength -= 16U;
+		} while (uLength);
+		return;
+	}
+#else
+	BURGER_UNUSED(pEnd);
+#endif
 	do {
-		pDest[0] = static_cast<uint8_t>(i);	// 0-255
-		m_LZWSize[i] = 1;					// All are 1 byte in size
-		m_LZWTable[i] = pDest;				// Init pointers to LZWArray table
-		++pDest;
-	} while (++i<256);
+		pOutput[0] = pInput[0];
+		++pOutput;
+		++pInput;
+	} while (--uLength);
 }
 
-/*! ************************************
-
-	\brief Reset the LZW token tree
-
-***************************************/
-
-void Burger::GIFDecoder::Reset(void)
-{
-	uint_t i = 256;				// Generated tokens
-	do {
-		m_LZWSize[i] = 0;		// Nothing here!
-		m_LZWTable[i] = NULL;	// No pointers
-	} while (++i<4096);			// All of them
-}
+#endif
 
 /*! ************************************
 
-	\brief Get an LZW code token
-
-	\param uBitsRequested Number of bits to pull from the byte stream
-	\return Value pulled from the bit stream (Zero if data is depleted)
+	\brief Initialize a GIFDecoder
 
 ***************************************/
 
-uint_t Burger::GIFDecoder::GetCode(uint_t uBitsRequested)
+Burger::GIFDecoder::GIFDecoder() :
+	m_pPacked(NULL),
+	m_uPackedSize(0)
 {
-	uint_t uMask = 1;		// Bit or mask
-	uint_t uResult = 0;	// Init returned value
-	uint_t uBitBucket = m_uBitBucket;		// Get the bit bucket
-	uint_t uBitCount = m_uBitCount;		// Get the valid bit count
-	do {
-		if (!uBitCount) {					// Empty?
-			uBitCount = m_uChunkCount;		// Any more fresh data?
-			if (!uBitCount) {				// No more!
-				uBitCount = m_pInput->GetByte();	// Get the packet count
-				if (!uBitCount) {		// If zero then keep returning zeros
-					m_pInput->SkipBack(1);		// Revert the fetch
-					uResult = 0;	// Exit now
-					break;
-				}
-			}
-			--uBitCount;				// I accept a byte
-			m_uChunkCount = uBitCount;	// Save result
-			uBitBucket = m_pInput->GetByte();	// Get next byte
-			uBitCount = 8;				// 8 valid bits!
-		}
-		--uBitCount;					// Accept a bit
-		if (uBitBucket&1) {				// Return true or false
-			uResult |= uMask;			// Blend...
-		}
-		uBitBucket = uBitBucket>>1U;	// Shift out a bit
-		uMask <<= 1U;					// Shift up the mask
-	} while (--uBitsRequested);			// More?
-	m_uBitCount=uBitCount;				// Save new count
-	m_uBitBucket=uBitBucket;			// Save new bit bucket
-	return uResult;						// Return the code
 }
 
 /*! ************************************
 
-	\brief Initialize a GIFDecoder
+	\brief Release the LZW data buffer
 
 ***************************************/
 
-Burger::GIFDecoder::GIFDecoder() :
-	m_pInput(NULL),
-	m_uLZWCodeSize(0)
+Burger::GIFDecoder::~GIFDecoder()
 {
-//	Init();
-	Reset();
+	free_memory(m_pPacked);
 }
 
 /*! ************************************
@@ -646,93 +629,163 @@ Burger::GIFDecoder * BURGER_API Burger::GIFDecoder::new_object(void)
 
 /*! ************************************
 
-	\brief Decompress the image
+	\brief Decompress LZW data from a buffer
 
-	Decompress the LZW compressed image data into a linear buffer
+	The input buffer must have 3 bytes of padding after the data so the
+	code window can be read past the last code.
 
 	\param pOutput Buffer to accept the decompressed data
 	\param uOutputLength Length of the buffer for decompressed data
-	\param pInput Data stream to read compressed data from
+	\param pInput LZW data without the block counts
+	\param uInputLength Number of bytes of LZW data
+	\param uCodeSize Number of bits in a pixel (2-8)
 	\return \ref NULL if success or a pointer to a string describing the error
 
 ***************************************/
 
-const char * Burger::GIFDecoder::Unpack(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput)
+const char *Burger::GIFDecoder::Decode(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength,uint_t uCodeSize)
 {
-	m_pInput = pInput;
-	m_uLZWCodeSize = pInput->GetByte();	// Number of bits for code size
-	Init();
-
-	uint_t uCount;				// Temp index counter
-	const uint8_t *pPreviousMark=NULL;	// Pointer from previous loop
-	uint_t uPreviousCode = static_cast<uint_t>(-1);
-	uint_t uNewCode = 256+2;		// Newest token being generated
-	uint_t uCodeBitSize = m_uLZWCodeSize+1U;
-	uint_t uCodeMask = g_MaskTable[uCodeBitSize];		// NewCode number to match to increase token bit size
-	do {
-		uint_t uLZWCode = GetCode(uCodeBitSize);		// Get LZW token
-		if (uLZWCode == 257) {			// End token?
+	const uint_t uClearCode = 1U<<uCodeSize;
+	const uint_t uEOFCode = uClearCode+1U;
+	uint_t uCodeBitSize = uCodeSize+1U;
+	uint_t uCodeMask = (1U<<uCodeBitSize)-1U;
+	uint_t uNewCode = uClearCode+2U;		// Newest token being generated
+	uintptr_t uBitIndex = 0;
+	const uintptr_t uBitCount = uInputLength<<3U;
+	uint8_t *pWork = pOutput;
+	uint8_t *pEnd = pOutput+uOutputLength;
+	const uint8_t *pPreviousMark = NULL;	// Output of the previous code, NULL after a reset
+	uintptr_t uPreviousSize = 0;
+	const char *pBadNews = NULL;
+
+	while (pWork<pEnd) {
+		if ((uBitIndex+uCodeBitSize)>uBitCount) {
+			pBadNews = "GIF LZW data ended early.";
 			break;
 		}
-		
-		if (uLZWCode==256) {		// Reset token?
-			Reset();	// Reset the dictionary
-			uNewCode = 256+2;		// Reset next new token
-			uCodeBitSize = m_uLZWCodeSize+1;	// 9 bits again
-			uCodeMask = g_MaskTable[uCodeBitSize];	// Reset the mask
-			uPreviousCode = static_cast<uint_t>(-1);
-			pPreviousMark = pOutput;
+		// Codes are at most 12 bits, so a 24 bit window at any bit offset holds one
+		const uint8_t *pBits = pInput+(uBitIndex>>3U);
+		uint_t uLZWCode = ((static_cast<uint_t>(pBits[0])|(static_cast<uint_t>(pBits[1])<<8U)|
+			(static_cast<uint_t>(pBits[2])<<16U))>>(uBitIndex&7U))&uCodeMask;
+		uBitIndex += uCodeBitSize;
+
+		uintptr_t uCount;
+		if (uLZWCode<uClearCode) {
+			// A single pixel is the most common case
+			pWork[0] = static_cast<uint8_t>(uLZWCode);
+			uCount = 1;
+		} else if (uLZWCode==uClearCode) {
+			uCodeBitSize = uCodeSize+1U;
+			uCodeMask = (1U<<uCodeBitSize)-1U;
+			uNewCode = uClearCode+2U;
+			pPreviousMark = NULL;
 			continue;
+		} else if (uLZWCode==uEOFCode) {
+			break;
+		} else if (uLZWCode<uNewCode) {
+			uCount = m_LZWSize[uLZWCode];
+			if (uCount>static_cast<uintptr_t>(pEnd-pWork)) {
+				// Extra data is ignored
+				uCount = static_cast<uintptr_t>(pEnd-pWork);
+			}
+			GIFCopyString(pWork,m_LZWTable[uLZWCode],uCount,pEnd);
+		} else if ((uLZWCode==uNewCode) && pPreviousMark) {
+			// The string being defined, the previous string and its first pixel
+			uCount = uPreviousSize+1U;
+			if (uCount>static_cast<uintptr_t>(pEnd-pWork)) {
+				uCount = static_cast<uintptr_t>(pEnd-pWork);
+				GIFCopyString(pWork,pPreviousMark,uCount,pEnd);
+			} else {
+				GIFCopyString(pWork,pPreviousMark,uPreviousSize,pEnd);
+				pWork[uPreviousSize] = pPreviousMark[0];
+			}
+		} else {
+			pBadNews = "Invalid code in GIF LZW data.";
+			break;
 		}
 
-		const uint8_t *pPreviousOutput = pOutput;
-		const uint8_t *pTable = m_LZWTable[uLZWCode];	// Get the string pointer
-		if (pTable) {					// Valid pointer?
-			uCount = m_LZWSize[uLZWCode];		// Size of the string
-			uOutputLength -= uCount;						// Remove from failsafe
-			do {
-				pOutput[0] = pTable[0];	// Copy the string
-				++pOutput;
-				++pTable;
-			} while (--uCount);
-			if (uPreviousCode==static_cast<uint_t>(-1)) {	// First pass?
-				// Then don't make a new record
-				uPreviousCode = uLZWCode;			// Set the new previous index
-				pPreviousMark = pPreviousOutput;	// Pointer to this work data
-				continue;
+		// Add the previous string and the first pixel of this one, once
+		// the dictionary is full, codes are used as is until a clear code
+		if (pPreviousMark && (uNewCode<cTableSize)) {
+			m_LZWTable[uNewCode] = pPreviousMark;
+			m_LZWSize[uNewCode] = static_cast<uint_t>(uPreviousSize+1U);
+			if ((++uNewCode>uCodeMask) && (uCodeBitSize<cLZBits)) {
+				++uCodeBitSize;
+				uCodeMask = (1U<<uCodeBitSize)-1U;
 			}
-		} else {
-			uCount = m_LZWSize[uPreviousCode]+1;	// Get the previous match
-			uOutputLength -= uCount;		// Remove from length
-			pTable = pPreviousMark;			// Set the pointer
-			do {
-				pOutput[0] = pTable[0];		// Copy the string
-				++pOutput;
-				++pTable;
-			} while (--uCount);
 		}
-		m_LZWSize[uNewCode] = m_LZWSize[uPreviousCode]+1;	// Set the new length
-		m_LZWTable[uNewCode] = pPreviousMark;		// Data pointer
-		++uNewCode;		// Next new LZW code
+		pPreviousMark = pWork;
+		uPreviousSize = uCount;
+		pWork += uCount;
+	}
+	return pBadNews;
+}
 
-		if (uNewCode==uCodeMask) {		// Do I need another bit next pass?
-			++uCodeBitSize;				// Increase the bit size
-			uCodeMask = g_MaskTable[uCodeBitSize];	// Use table
+/*! ************************************
+
+	\brief Decompress the image
+
+	Decompress the LZW compressed image data into a linear buffer. The
+	stream is left after the block terminator of the image data.
+
+	\param pOutput Buffer to accept the decompressed data
+	\param uOutputLength Length of the buffer for decompressed data
+	\param pInput Data stream to read compressed data from
+	\return \ref NULL if success or a pointer to a string describing the error
+
+***************************************/
+
+const char * Burger::GIFDecoder::Unpack(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput)
+{
+	uint_t uCodeSize = pInput->GetByte();	// Number of bits for code size
+	if ((uCodeSize<2U) || (uCodeSize>8U)) {
+		return "Invalid GIF LZW code size.";
+	}
+
+	// Find the size of all the data blocks
+	const uint8_t *pBlocks = pInput->GetPtr();
+	uintptr_t uRemaining = pInput->BytesRemaining();
+	uintptr_t uOffset = 0;
+	uintptr_t uPackedLength = 0;
+	for (;;) {
+		if (uOffset>=uRemaining) {
+			return "GIF LZW data is missing the block terminator.";
 		}
-		uPreviousCode = uLZWCode;				// Set the new previous index
-		pPreviousMark = pPreviousOutput;		// Pointer to this work data
-	} while (uOutputLength);
+		uintptr_t uCount = pBlocks[uOffset];
+		if (!uCount) {
+			break;
+		}
+		uPackedLength += uCount;
+		uOffset += uCount+1U;
+	}
+	if (uOffset>=uRemaining) {
+		return "GIF LZW data is missing the block terminator.";
+	}
 
-	// Exit
- 	if (!uOutputLength) {	// Check if properly decompressed
-		uCount = m_uChunkCount;
-		do {
-			pInput->SkipForward(uCount);	// Move the pointer
-			uCount = pInput->GetByte();	// Get the data count
-		} while (uCount);		// Still more data?
-		return NULL;		// Good!
+	// Gather the blocks with padding for the code window
+	if (m_uPackedSize<(uPackedLength+4U)) {
+		free_memory(m_pPacked);
+		m_uPackedSize = uPackedLength+4U;
+		m_pPacked = static_cast<uint8_t *>(allocate_memory(m_uPackedSize));
+		if (!m_pPacked) {
+			m_uPackedSize = 0;
+			return "Out of memory.";
+		}
+	}
+	uint8_t *pPacked = m_pPacked;
+	const uint8_t *pWork = pBlocks;
+	uintptr_t uCount;
+	while ((uCount = pWork[0])!=0) {
+		memory_copy(pPacked,pWork+1,uCount);
+		pPacked += uCount;
+		pWork += uCount+1U;
 	}
-	return "Error in GIF decompression.";
+	pPacked[0] = 0;
+	pPacked[1] = 0;
+	pPacked[2] = 0;
+	pPacked[3] = 0;
+	pInput->SkipForward(uOffset+1U);
+	return Decode(pOutput,uOutputLength,m_pPacked,uPackedLength,uCodeSize);
 }
 
 /*! ************************************
@@ -798,6 +851,10 @@ const char *Burger::FileGIF::ParseHeader(InputMemoryStream *pInput)
 					m_bGIF89 = TRUE;
 				}
 			}
+			// The logical screen is the image size, it can't be empty
+			if (!pBadNews && (!m_uLogicalWidth || !m_uLogicalHeight)) {
+				pBadNews = "GIF logical screen has no width or height.";
+			}
 		}
 
 		// Was it identified as GIF?
@@ -851,6 +908,7 @@ const char *Burger::FileGIF::ParseExtension(InputMemoryStream *pInput)
 		m_uFrameDelay = pInput->GetShort();
 		m_bTransparentColor = pInput->GetByte();
 		m_bTransparentColorEnable = static_cast<uint8_t>(uFlags&1U);
+		m_uDisposalMethod = static_cast<uint8_t>((uFlags>>2U)&7U);
 		if (pInput->GetByte()!=0) {
 			pBadNews = "Graphic Control Extension has an non zero terminator.";
 		}
@@ -896,62 +954,139 @@ const char *Burger::FileGIF::ParseExtension(InputMemoryStream *pInput)
 
 /*! ************************************
 
-	\brief Parse a GIF image block
+	\brief Parse a GIF image block into color indexes
 
-	\param pOutput Pointer to an Image record to store the new image into
-	\param pInput Pointer to the input stream
+	Read the image descriptor, the optional local palette and decompress
+	the pixels into an internal buffer. Interlaced images are put back into
+	top to bottom order. The position and size of the image are stored so
+	the caller can place the pixels on the logical screen.
+
+	\param pInput Pointer to the input stream after the ',' token
+	\return \ref NULL if the image was read successfully, or a pointer to an
+	English error message with the reason for failure.
 
 ***************************************/
 
-const char * Burger::FileGIF::ParseImage(Image *pOutput,InputMemoryStream *pInput)
+const char * Burger::FileGIF::ParseFrame(InputMemoryStream *pInput)
 {
-	const char *pBadNews = NULL;
-
-	uint_t uOriginX = pInput->GetShort();
-	uint_t uOriginY = pInput->GetShort();
-	if (uOriginX|uOriginY) {
-		pBadNews = "Origin of GIF image is not zero.";
+	if (pInput->BytesRemaining()<9) {
+		return "Insufficient data for GIF image descriptor. 9 bytes required.";
+	}
+	m_uFrameLeft = pInput->GetShort();
+	m_uFrameTop = pInput->GetShort();
+	const uint_t uWidth = pInput->GetShort();
+	const uint_t uHeight = pInput->GetShort();
+	m_uFrameWidth = uWidth;
+	m_uFrameHeight = uHeight;
+	// Local image descriptor
+	const uint_t uDescriptor = pInput->GetByte();
+	if (uDescriptor&0x80U) {
+		// Get the number of colors in the palette
+		uint_t uColorCount = 1U<<((uDescriptor&7U)+1U);
+		RGBAWord8_t *pWork = m_Palette;
+		uint_t uColorShift = m_uColorShift;
+		do {
+			pWork->m_uRed = static_cast<uint8_t>(pInput->GetByte()<<uColorShift);		// Read in the palette
+			pWork->m_uGreen = static_cast<uint8_t>(pInput->GetByte()<<uColorShift);
+			pWork->m_uBlue = static_cast<uint8_t>(pInput->GetByte()<<uColorShift);
+			pWork->m_uAlpha = 255;
+			++pWork;
+		} while (--uColorCount);
 	} else {
-		uint_t uImageWidth = pInput->GetShort();
-		uint_t uImageHeight = pInput->GetShort();
-		if ((uImageWidth!=m_uLogicalWidth) || (uImageHeight!=m_uLogicalHeight)) {
-			pBadNews = "Image parsed is not the same size as total image.";
-		} else {
-			// Local image descriptor
-			uint_t uDescriptor = pInput->GetByte();
-			if (uDescriptor&0x80U) {
-				// Get the number of colors in the palette
-				uint_t uColorCount = 1U<<((uDescriptor&7U)+1U);
-				RGBAWord8_t *pWork = m_Palette;
-				uint_t uColorShift = m_uColorShift;
-				do {
-					pWork->m_uRed = static_cast<uint8_t>(pInput->GetByte()<<uColorShift);		// Read in the palette
-					pWork->m_uGreen = static_cast<uint8_t>(pInput->GetByte()<<uColorShift);
-					pWork->m_uBlue = static_cast<uint8_t>(pInput->GetByte()<<uColorShift);
-					pWork->m_uAlpha = 255;
-					++pWork;
-				} while (--uColorCount);
+		// Use the global palette
+		memory_copy(m_Palette,m_GlobalPalette,sizeof(m_GlobalPalette));
+	}
+	if (!uWidth || !uHeight) {
+		return "GIF image has no pixels.";
+	}
+
+	// Interlaced images are decoded after the final image
+	const uintptr_t uPixels = static_cast<uintptr_t>(uWidth)*uHeight;
+	const uint_t bInterlaced = (uDescriptor&0x40U)!=0;
+	const uintptr_t uNeeded = bInterlaced ? uPixels*2U : uPixels;
+	if (m_uFrameBufferSize<uNeeded) {
+		free_memory(m_pFrame);
+		m_pFrame = static_cast<uint8_t *>(allocate_memory(uNeeded));
+		m_uFrameBufferSize = m_pFrame ? uNeeded : 0;
+	}
+	if (!m_pDecoder) {
+		m_pDecoder = GIFDecoder::new_object();
+	}
+	if (!m_pFrame || !m_pDecoder) {
+		return "Out of memory.";
+	}
+	uint8_t *pDecoded = m_pFrame+(bInterlaced ? uPixels : 0);
+	const char *pBadNews = m_pDecoder->Unpack(pDecoded,uPixels,pInput);
+	if (!pBadNews && bInterlaced) {
+		// Rows are stored every 8th row from 0, every 8th from 4, every 4th from 2, then every 2nd from 1
+		uint_t uStart = 0;
+		uint_t uStep = 8;
+		do {
+			uint_t uY = uStart;
+			while (uY<uHeight) {
+				memory_copy(m_pFrame+(static_cast<uintptr_t>(uY)*uWidth),pDecoded,uWidth);
+				pDecoded += uWidth;
+				uY += uStep;
+			}
+			if (!uStart) {
+				uStart = 4;
 			} else {
-				// Use the global palette
-				memory_copy(m_Palette,m_GlobalPalette,sizeof(m_GlobalPalette));
+				uStep = uStart;
+				uStart >>= 1U;
 			}
-		}
+		} while (uStart);
 	}
+	return pBadNews;
+}
+
+/*! ************************************
+
+	\brief Parse a GIF image block
+
+	Decompress an image and place it on an 8 bit image the size of the
+	logical screen. Areas not covered by the image are set to the background
+	color index.
+
+	\param pOutput Pointer to an Image record to store the new image into
+	\param pInput Pointer to the input stream
 
-	// Header is good, get the bitmap
+***************************************/
+
+const char * Burger::FileGIF::ParseImage(Image *pOutput,InputMemoryStream *pInput)
+{
+	const char *pBadNews = ParseFrame(pInput);
+
+	// Header is good, place the bitmap
 
 	if (!pBadNews) {
 		uint_t uResult = pOutput->Init(m_uLogicalWidth,m_uLogicalHeight,Image::PIXELTYPE8BIT);
 		if (uResult) {
 			pBadNews = "Out of memory.";
 		} else {
-			pOutput->ClearBitmap();
-			GIFDecoder *pDecoder = GIFDecoder::new_object();
-			if (pDecoder) {
-				pBadNews = pDecoder->Unpack(pOutput->GetImage(),m_uLogicalWidth*m_uLogicalHeight,pInput);	// Decompress it
-				delete_object(pDecoder);
-			} else {
-				pBadNews = "Out of memory.";
+			const uintptr_t uStride = pOutput->GetStride();
+			uint8_t *pImage = pOutput->GetImage();
+			uint_t uWidth = 0;
+			uint_t uHeight = 0;
+			if (m_uFrameLeft<m_uLogicalWidth) {
+				uWidth = minimum(m_uFrameWidth,m_uLogicalWidth-m_uFrameLeft);
+			}
+			if (m_uFrameTop<m_uLogicalHeight) {
+				uHeight = minimum(m_uFrameHeight,m_uLogicalHeight-m_uFrameTop);
+			}
+			if ((uWidth!=m_uLogicalWidth) || (uHeight!=m_uLogicalHeight)) {
+				uint_t uY = 0;
+				do {
+					memory_set(pImage+(uY*uStride),m_bBackgroundColorIndex,m_uLogicalWidth);
+				} while (++uY<m_uLogicalHeight);
+			}
+			if (uWidth && uHeight) {
+				const uint8_t *pFrame = m_pFrame;
+				pImage += (m_uFrameTop*uStride)+m_uFrameLeft;
+				do {
+					memory_copy(pImage,pFrame,uWidth);
+					pImage += uStride;
+					pFrame += m_uFrameWidth;
+				} while (--uHeight);
 			}
 		}
 	}
@@ -1163,12 +1298,43 @@ Burger::FileGIF::FileGIF() :
 	m_bTransparentColorEnable(FALSE),	// Disable transparent color
 	m_bAspectRatio(0),		// No aspect ratio (Default)
 	m_bBackgroundColorIndex(0),
-	m_bGIF89(TRUE)			// Default to GIF89a
+	m_bGIF89(TRUE),			// Default to GIF89a
+	m_uDisposalMethod(DISPOSE_NONE),
+	m_pDecoder(NULL),
+	m_pFrame(NULL),
+	m_uFrameBufferSize(0),
+	m_pSaved(NULL),
+	m_uSavedBufferSize(0),
+	m_uFrameLeft(0),
+	m_uFrameTop(0),
+	m_uFrameWidth(0),
+	m_uFrameHeight(0),
+	m_uDisposeLeft(0),
+	m_uDisposeTop(0),
+	m_uDisposeWidth(0),
+	m_uDisposeHeight(0),
+	m_uDisposeMethod(DISPOSE_NONE),
+	m_uFrameIndex(0)
 {
 	ClearPalette(m_Palette,BURGER_ARRAYSIZE(m_Palette));
 	ClearPalette(m_GlobalPalette,BURGER_ARRAYSIZE(m_GlobalPalette));
 }
 
+/*! ************************************
+
+	\brief Destructor
+
+	Releases the decoder and the frame buffers
+
+***************************************/
+
+Burger::FileGIF::~FileGIF()
+{
+	delete_object(m_pDecoder);
+	free_memory(m_pFrame);
+	free_memory(m_pSaved);
+}
+
 /*! ************************************
 
 	\brief Allocate and initialize a FileGIF
@@ -1292,6 +1458,211 @@ uint_t Burger::FileGIF::LoadNextFrame(Image *pOutput,InputMemoryStream *pInput)
 	return uResult;
 }
 
+/*! ************************************
+
+	\brief Start decoding a GIF animation one frame at a time
+
+	Parse the GIF header and reset the frame state. Call
+	AnimationLoadFrame() for each frame until it returns 1.
+
+	\note A descriptive error message is passed to Debug::Warning()
+
+	\param pInput Pointer to a memory stream that has a GIF file image
+	\return Zero for success or non-zero on failure
+	\sa AnimationLoadFrame(Image *,InputMemoryStream *)
+
+***************************************/
+
+uint_t Burger::FileGIF::AnimationLoadStart(InputMemoryStream *pInput)
+{
+	m_uFrameIndex = 0;
+	m_uDisposeMethod = DISPOSE_NONE;
+	m_uLoopCount = 0;
+	const char *pBadNews = ParseHeader(pInput);
+	if (pBadNews) {
+		Debug::Warning(pBadNews);
+		return 10;
+	}
+	return 0;
+}
+
+/*! ************************************
+
+	\brief Decode the next frame of a GIF animation
+
+	Only the next frame is decompressed and drawn onto pCanvas, so the memory
+	needed doesn't depend on the number of frames. The canvas is a 32 bit
+	RGBA image the size of the logical screen that's created on the first
+	frame. Pixels that use the transparent color index are not drawn and the
+	area of the canvas without any frame drawn is transparent black.
+
+	Before the frame is drawn, the previous frame is disposed of as its
+	graphic control extension requested. \ref DISPOSE_BACKGROUND clears the
+	area to transparent black and \ref DISPOSE_PREVIOUS restores the pixels
+	the area had before the previous frame was drawn.
+
+	\note The same canvas must be passed for every frame and it must not be
+	changed between calls.
+
+	\param pCanvas Pointer to the Image that holds the animation
+	\param pInput Pointer to a memory stream after AnimationLoadStart()
+	\return Zero if a frame was decoded, 1 if there are no more frames, or 10 on error
+	\sa AnimationLoadStart(InputMemoryStream *), GetFrameDelay(void) const or GetDisposalMethod(void) const
+
+***************************************/
+
+uint_t Burger::FileGIF::AnimationLoadFrame(Image *pCanvas,InputMemoryStream *pInput)
+{
+	const char *pBadNews = NULL;
+	uint_t uResult = 0;
+
+	// The graphic control extension only applies to the image that follows
+	m_bTransparentColorEnable = FALSE;
+	m_uDisposalMethod = DISPOSE_NONE;
+	m_uFrameDelay = 0;
+
+	do {
+		// A missing terminator is treated as the end of the animation
+		if (!pInput->BytesRemaining()) {
+			uResult = 1;
+			break;
+		}
+		uint_t uToken = pInput->GetByte();
+		if (uToken=='!') {
+			pBadNews = ParseExtension(pInput);
+		} else if (uToken==';') {
+			// Put it back so further calls also stop here
+			pInput->SkipBack(1);
+			uResult = 1;
+			break;
+		} else if (uToken==',') {
+			pBadNews = ParseFrame(pInput);
+			break;
+		} else {
+			pBadNews = "Unknown token found in GIF file.";
+		}
+	} while (!pBadNews);
+
+	const uint_t uLogicalWidth = m_uLogicalWidth;
+	const uint_t uLogicalHeight = m_uLogicalHeight;
+	if (!pBadNews && !uResult) {
+		if (!m_uFrameIndex) {
+			if (pCanvas->Init(uLogicalWidth,uLogicalHeight,Image::PIXELTYPE8888)) {
+				pBadNews = "Out of memory.";
+			} else {
+				pCanvas->ClearBitmap();
+			}
+		} else if (m_uDisposeWidth && m_uDisposeHeight) {
+			// Dispose of the previous frame
+			const uintptr_t uRowBytes = static_cast<uintptr_t>(m_uDisposeWidth)*4U;
+			uint8_t *pWork = pCanvas->GetImage()+(m_uDisposeTop*pCanvas->GetStride())+(m_uDisposeLeft*4U);
+			const uint8_t *pSaved = m_pSaved;
+			uint_t uCount = m_uDisposeHeight;
+			if (m_uDisposeMethod==DISPOSE_BACKGROUND) {
+				do {
+					memory_clear(pWork,uRowBytes);
+					pWork += pCanvas->GetStride();
+				} while (--uCount);
+			} else if (m_uDisposeMethod==DISPOSE_PREVIOUS) {
+				do {
+					memory_copy(pWork,pSaved,uRowBytes);
+					pSaved += uRowBytes;
+					pWork += pCanvas->GetStride();
+				} while (--uCount);
+			}
+		}
+	}
+
+	if (!pBadNews && !uResult) {
+		// Clip the frame to the logical screen
+		uint_t uWidth = 0;
+		uint_t uHeight = 0;
+		if (m_uFrameLeft<uLogicalWidth) {
+			uWidth = minimum(m_uFrameWidth,uLogicalWidth-m_uFrameLeft);
+		}
+		if (m_uFrameTop<uLogicalHeight) {
+			uHeight = minimum(m_uFrameHeight,uLogicalHeight-m_uFrameTop);
+		}
+		if (!uWidth) {
+			uHeight = 0;
+		}
+		const uintptr_t uStride = pCanvas->GetStride();
+		uint8_t *pCanvasData = pCanvas->GetImage()+(m_uFrameTop*uStride)+(m_uFrameLeft*4U);
+		const uintptr_t uRowBytes = static_cast<uintptr_t>(uWidth)*4U;
+
+		// Save what is under the frame if it's to be restored
+		if (uHeight && (m_uDisposalMethod==DISPOSE_PREVIOUS)) {
+			const uintptr_t uNeeded = uRowBytes*uHeight;
+			if (m_uSavedBufferSize<uNeeded) {
+				free_memory(m_pSaved);
+				m_pSaved = static_cast<uint8_t *>(allocate_memory(uNeeded));
+				m_uSavedBufferSize = m_pSaved ? uNeeded : 0;
+			}
+			if (!m_pSaved) {
+				pBadNews = "Out of memory.";
+			} else {
+				const uint8_t *pWork = pCanvasData;
+				uint8_t *pSaved = m_pSaved;
+				uint_t uCount = uHeight;
+				do {
+					memory_copy(pSaved,pWork,uRowBytes);
+					pSaved += uRowBytes;
+					pWork += uStride;
+				} while (--uCount);
+			}
+		}
+
+		if (!pBadNews) {
+			// Draw the frame
+			if (uHeight) {
+				const uint8_t *pFrame = m_pFrame;
+				const RGBAWord8_t *pPalette = m_Palette;
+				uint_t uCount = uHeight;
+				if (m_bTransparentColorEnable) {
+					const uint_t uTransparent = m_bTransparentColor;
+					do {
+						RGBAWord8_t *pWork = reinterpret_cast<RGBAWord8_t *>(pCanvasData);
+						uint_t uX = 0;
+						do {
+							const uint_t uIndex = pFrame[uX];
+							if (uIndex!=uTransparent) {
+								pWork[uX] = pPalette[uIndex];
+							}
+						} while (++uX<uWidth);
+						pFrame += m_uFrameWidth;
+						pCanvasData += uStride;
+					} while (--uCount);
+				} else {
+					do {
+						RGBAWord8_t *pWork = reinterpret_cast<RGBAWord8_t *>(pCanvasData);
+						uint_t uX = 0;
+						do {
+							pWork[uX] = pPalette[pFrame[uX]];
+						} while (++uX<uWidth);
+						pFrame += m_uFrameWidth;
+						pCanvasData += uStride;
+					} while (--uCount);
+				}
+			}
+
+			// Remember how to dispose of this frame
+			m_uDisposeLeft = m_uFrameLeft;
+			m_uDisposeTop = m_uFrameTop;
+			m_uDisposeWidth = uWidth;
+			m_uDisposeHeight = uHeight;
+			m_uDisposeMethod = m_uDisposalMethod;
+			++m_uFrameIndex;
+		}
+	}
+
+	// If there was an error, clean up
+	if (pBadNews) {
+		Debug::Warning(pBadNews);
+		uResult = 10;
+	}
+	return uResult;
+}
+
 /*! ************************************
 
 	\brief Write an Image structure out as a GIF file image
@@ -1617,6 +1988,49 @@ uint_t Burger::FileGIF::AnimationSaveFinish(OutputMemoryStream *pOutput)
 ***************************************/
 
 
+/*! ************************************
+
+	\fn uint_t Burger::FileGIF::GetDisposalMethod(void) const
+	\brief Get the disposal method of the current frame
+
+	After a frame is parsed, this is the disposal method found in its
+	graphic control extension, which tells how the frame is removed before
+	the next frame is drawn.
+
+	\return \ref DISPOSE_NONE, \ref DISPOSE_KEEP, \ref DISPOSE_BACKGROUND or \ref DISPOSE_PREVIOUS
+	\sa AnimationLoadFrame(Image *,InputMemoryStream *)
+
+***************************************/
+
+/*! ************************************
+
+	\fn uint_t Burger::FileGIF::GetFrameIndex(void) const
+	\brief Get the number of frames decoded
+
+	\return Number of frames decoded by AnimationLoadFrame(Image *,InputMemoryStream *)
+
+***************************************/
+
+/*! ************************************
+
+	\fn uint_t Burger::FileGIF::GetLogicalWidth(void) const
+	\brief Get the width of the GIF logical screen
+
+	\return Width in pixels from the GIF header
+	\sa GetLogicalHeight(void) const
+
+***************************************/
+
+/*! ************************************
+
+	\fn uint_t Burger::FileGIF::GetLogicalHeight(void) const
+	\brief Get the height of the GIF logical screen
+
+	\return Height in pixels from the GIF header
+	\sa GetLogicalWidth(void) const
+
+***************************************/
+
 /*! ************************************
 
 	\fn const RGBAWord8_t *Burger::FileGIF::GetPalette(void) const
@@ -62,7 +62,7 @@ class GIFEncoder {
 public:
 	GIFEncoder();
 	static GIFEncoder * BURGER_API new_object(void);
-    static BURGER_INLINE uint_t GetHashKey(uint_t uInput) { return ((uInput >> cLZBits) ^ uInput) & cHashKeyMask; }
+    static BURGER_INLINE uint_t GetHashKey(uint_t uInput) { return static_cast<uint_t>((static_cast<uint32_t>(uInput)*0x9E3779B1U) >> (32U-13U)); }
     static BURGER_INLINE uint_t GetKey(uint_t uInput) { return uInput >> cLZBits; }
     static BURGER_INLINE uint_t PutKey(uint_t uInput) { return uInput << cLZBits; }
     static BURGER_INLINE uint_t GetCode(uint_t uInput) { return uInput & 0xFFFU; }
@@ -79,19 +79,16 @@ public:
 	void Flush(void);
 };
 class GIFDecoder {
-	InputMemoryStream *m_pInput;	///< Pointer to packed data
-	uint_t m_uBitBucket;				///< Current bit bucket
-	uint_t m_uBitCount;				///< Current valid bit count in bucket
-	uint_t m_uChunkCount;				///< Number of bytes in stream
-	uint_t m_uLZWCodeSize;			///< Starting data size
-	const uint8_t *m_LZWTable[4096];	///< Dictionary pointers
-	uint8_t m_LZWArray[256];			///< 0-255 for default data
-	uint_t m_LZWSize[4096];			///< Size of each entry
-	void Init(void);
-	void Reset(void);
-	uint_t GetCode(uint_t uBitsRequested);
+	static const uint_t cLZBits = 12U;				///< Largest number of bits for an LZW token
+	static const uint_t cTableSize = 1U<<cLZBits;	///< Number of entries in the dictionary
+	uint8_t *m_pPacked;				///< Buffer holding the LZW data without the block counts
+	uintptr_t m_uPackedSize;			///< Number of bytes allocated for m_pPacked
+	const uint8_t *m_LZWTable[cTableSize];	///< First output of each dictionary string
+	uint_t m_LZWSize[cTableSize];		///< Size of each entry
+	const char *Decode(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength,uint_t uCodeSize);
 public:
 	GIFDecoder();
+	~GIFDecoder();
 	static GIFDecoder * BURGER_API new_object(void);
 	const char *Unpack(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput);
 };
@@ -109,7 +106,30 @@ class FileGIF {
 	uint8_t m_bAspectRatio;			///< GIF aspect ratio
 	uint8_t m_bBackgroundColorIndex;	///< GIF background color
 	uint8_t m_bGIF89;					///< GIF file read is 89 format, not 87
+	uint8_t m_uDisposalMethod;		///< GIF disposal method for the current frame
+	GIFDecoder *m_pDecoder;			///< LZW decoder kept between frames
+	uint8_t *m_pFrame;				///< Color indexes of the last frame parsed
+	uintptr_t m_uFrameBufferSize;		///< Number of bytes allocated for m_pFrame
+	uint8_t *m_pSaved;				///< Canvas pixels saved for disposal method 3
+	uintptr_t m_uSavedBufferSize;		///< Number of bytes allocated for m_pSaved
+	uint_t m_uFrameLeft;				///< Left edge of the last frame parsed
+	uint_t m_uFrameTop;				///< Top edge of the last frame parsed
+	uint_t m_uFrameWidth;				///< Width of the last frame parsed
+	uint_t m_uFrameHeight;			///< Height of the last frame parsed
+	uint_t m_uDisposeLeft;			///< Left edge of the area to dispose of before the next frame
+	uint_t m_uDisposeTop;				///< Top edge of the area to dispose of before the next frame
+	uint_t m_uDisposeWidth;			///< Width of the area to dispose of before the next frame
+	uint_t m_uDisposeHeight;			///< Height of the area to dispose of before the next frame
+	uint_t m_uDisposeMethod;			///< Disposal method to apply before the next frame
+	uint_t m_uFrameIndex;				///< Number of frames decoded by AnimationLoadFrame()
+	const char *ParseFrame(InputMemoryStream *pInput);
 public:
+	enum {
+		DISPOSE_NONE=0,			///< No disposal specified
+		DISPOSE_KEEP=1,			///< Leave the frame in place
+		DISPOSE_BACKGROUND=2,	///< Clear the frame's area to transparent
+		DISPOSE_PREVIOUS=3		///< Restore the frame's area to what it was before the frame
+	};
 	const char *ParseHeader(InputMemoryStream *pInput);
 	const char *ParseExtension(InputMemoryStream *pInput);
 	const char *ParseImage(Image *pOutput,InputMemoryStream *pInput);
@@ -127,9 +147,12 @@ public:
 	static const uint32_t AUXTYPE = 0x656C676F;		///< 'ogle'
 #endif
 	FileGIF();
+	~FileGIF();
 	static FileGIF * BURGER_API new_object(void);
 	uint_t Load(Image *pOutput,InputMemoryStream *pInput);
 	uint_t LoadNextFrame(Image *pOutput,InputMemoryStream *pInput);
+	uint_t AnimationLoadStart(InputMemoryStream *pInput);
+	uint_t AnimationLoadFrame(Image *pCanvas,InputMemoryStream *pInput);
 	uint_t Save(OutputMemoryStream *pOutput,const Image *pImage);
 	uint_t AnimationSaveStart(OutputMemoryStream *pOutput,const Image *pImage,uint_t uLoopCount=0);
 	uint_t AnimationSaveFrame(OutputMemoryStream *pOutput,const Image *pImage,uint_t uDelay=0);
@@ -145,6 +168,10 @@ public:
 	BURGER_INLINE uint_t GetLoopCount(void) const { return m_uLoopCount; }
 	BURGER_INLINE void SetLoopCount(uint_t uLoopCount) { m_uLoopCount = static_cast<uint16_t>(uLoopCount); }
 	BURGER_INLINE uint_t GetFrameDelay(void) const { return m_uFrameDelay; }
+	BURGER_INLINE uint_t GetDisposalMethod(void) const { return m_uDisposalMethod; }
+	BURGER_INLINE uint_t GetFrameIndex(void) const { return m_uFrameIndex; }
+	BURGER_INLINE uint_t GetLogicalWidth(void) const { return m_uLogicalWidth; }
+	BURGER_INLINE uint_t GetLogicalHeight(void) const { return m_uLogicalHeight; }
 	BURGER_INLINE void SetFrameDelay(uint_t uFrameDelay) { m_uFrameDelay = static_cast<uint16_t>(uFrameDelay); }
 	BURGER_INLINE const RGBAWord8_t *GetPalette(void) const { return m_Palette; }
 	BURGER_INLINE RGBAWord8_t *GetPalette(void) { return m_Palette; }
@@ -19,6 +19,7 @@
 #include "brnumberstring.h"
 #include "brnumberstringhex.h"
 #include "brfloatingpoint.h"
+#include "brasciito.h"
 
 #if defined(BURGER_WATCOM)
 // Disable 'sizeof' operand contains compiler generated information
@@ -143,8 +144,431 @@ Burger::FileINI::Generic::~Generic()
 
 ***************************************/
 
+/*! ************************************
+
+	\class Burger::FileINI::Index
+	\brief Case insensitive hash index of sections or entries
+
+	Sections and entries are kept in linked lists so a file is saved in the
+	same order it was loaded, but searching a list is a linear scan with a
+	string compare for every object. This open addressed table maps the lower
+	case name of each object to the object, so a lookup is one hash and
+	usually a single compare.
+
+	If several objects share a name, only the first one in the list is in the
+	table, which is the same object a linear search would have found.
+
+	\note If the table can't grow to hold a new object, the table is released
+		and all lookups fall back to a linear scan of the list until Clear() is
+		called.
+
+	\sa Burger::FileINI::Section or Burger::FileINI
+
+***************************************/
+
+/** Number of slots allocated for the first object in an Index */
+static const uint32_t kIndexStartingSlots = 16;
+
+/*! ************************************
+
+	\brief Create an empty index
+
+	No memory is allocated until the first object is added.
+
+***************************************/
+
+Burger::FileINI::Index::Index() :
+	m_pSlots(NULL),
+	m_uMask(0),
+	m_uCount(0),
+	m_bIncomplete(FALSE)
+{
+}
+
+/*! ************************************
+
+	\brief Release the hash table
+
+	The indexed objects are not touched.
+
+***************************************/
+
+Burger::FileINI::Index::~Index()
+{
+	free_memory(m_pSlots);
+}
+
+/*! ************************************
+
+	\brief Find an object by name
+
+	The name is hashed without case and matched with StringCaseCompare(const
+	char *,const char *), so the results are the same as the old linear
+	search. If the index is incomplete, the list is searched instead.
+
+	\param pName Pointer to a "C" string of the name to locate
+	\param pRoot Pointer to the root of the list the objects are in
+	\return Pointer to the first object with the name or \ref NULL if not found
+	\sa Find(const StringAtom &,const Generic *) const
+
+***************************************/
+
+Burger::FileINI::Generic * BURGER_API Burger::FileINI::Index::Find(const char *pName,const Generic *pRoot) const
+{
+	return Find(pName,StringAtom::case_hash(pName,string_length(pName)),pRoot);
+}
+
+/*! ************************************
+
+	\brief Find an object by interned name
+
+	The hash is already stored in the atom, so the name isn't hashed again.
+	If the index is incomplete, the list is searched instead.
+
+	\param rName Interned name to locate
+	\param pRoot Pointer to the root of the list the objects are in
+	\return Pointer to the first object with the name or \ref NULL if not found
+	\sa Find(const char *,const Generic *) const
+
+***************************************/
+
+Burger::FileINI::Generic * BURGER_API Burger::FileINI::Index::Find(const StringAtom &rName,const Generic *pRoot) const
+{
+	Generic *pResult = NULL;
+	if (rName.is_valid()) {
+		pResult = Find(rName.c_str(),rName.get_case_hash(),pRoot);
+	}
+	return pResult;
+}
+
+/*! ************************************
+
+	\brief Find an object by name and precomputed hash
+
+	\param pName Pointer to a "C" string of the name to locate
+	\param uHash Value of StringAtom::case_hash(const char *,uintptr_t) for the name
+	\param pRoot Pointer to the root of the list the objects are in
+	\return Pointer to the first object with the name or \ref NULL if not found
+	\sa Find(const char *,const Generic *) const
+
+***************************************/
+
+Burger::FileINI::Generic * BURGER_API Burger::FileINI::Index::Find(const char *pName,uint32_t uHash,const Generic *pRoot) const
+{
+	Generic *pResult = NULL;
+	if (m_bIncomplete) {
+		Generic *pWork = pRoot->GetNext();
+		while (pWork!=pRoot) {
+			if (IsMatch(pWork,pName,uHash)) {
+				pResult = pWork;
+				break;
+			}
+			pWork = pWork->GetNext();
+		}
+	} else if (m_uCount) {
+		uint32_t uIndex = uHash&m_uMask;
+		const Slot_t *pSlot;
+		while ((pSlot = &m_pSlots[uIndex])->m_pGeneric) {
+			if ((pSlot->m_uHash==uHash) && IsMatch(pSlot->m_pGeneric,pName,uHash)) {
+				pResult = pSlot->m_pGeneric;
+				break;
+			}
+			uIndex = (uIndex+1)&m_uMask;
+		}
+	}
+	return pResult;
+}
+
+/*! ************************************
+
+	\brief Add an object appended to the end of its list
+
+	If an object with the same name is already indexed, it is earlier in the
+	list and remains the one that is found.
+
+	If the table is full and can't grow, it's released and the index is
+	marked incomplete, so Find() scans the list instead of missing the object.
+
+	\param pGeneric Pointer to a Section or Entry
+	\sa Insert(Generic *,const Generic *) or Remove(Generic *,const Generic *)
+
+***************************************/
+
+void BURGER_API Burger::FileINI::Index::Add(Generic *pGeneric)
+{
+	if (m_bIncomplete) {
+		return;
+	}
+	// Keep the table at most 3/4 full
+	if (((m_uCount+1U)*4U)>((m_uMask+1U)*3U)) {
+		Grow();
+	}
+	// Always leave one empty slot to end the searches
+	if (m_pSlots && (m_uCount<m_uMask)) {
+		const char *pName = GetName(pGeneric);
+		const uint32_t uHash = GetHash(pGeneric);
+		uint32_t uIndex = uHash&m_uMask;
+		Slot_t *pSlot;
+		while ((pSlot = &m_pSlots[uIndex])->m_pGeneric) {
+			if ((pSlot->m_uHash==uHash) && IsMatch(pSlot->m_pGeneric,pName,uHash)) {
+				return;
+			}
+			uIndex = (uIndex+1)&m_uMask;
+		}
+		pSlot->m_pGeneric = pGeneric;
+		pSlot->m_uHash = uHash;
+		++m_uCount;
+	} else {
+		// Out of memory, search the list from now on
+		Clear();
+		m_bIncomplete = TRUE;
+	}
+}
+
+/*! ************************************
+
+	\brief Add an object anywhere in its list
+
+	If an object with the same name is already indexed, the list is scanned
+	to see which one comes first and that one is kept. Nothing is done if the
+	index is incomplete.
+
+	\param pGeneric Pointer to a Section or Entry already in the list
+	\param pRoot Pointer to the root of the list
+	\sa Add(Generic *) or Remove(Generic *,const Generic *)
+
+***************************************/
+
+void BURGER_API Burger::FileINI::Index::Insert(Generic *pGeneric,const Generic *pRoot)
+{
+	if (m_bIncomplete) {
+		return;
+	}
+	const uint32_t uHash = GetHash(pGeneric);
+	Generic *pFound = Find(GetName(pGeneric),uHash,pRoot);
+	if (!pFound) {
+		Add(pGeneric);
+	} else if (pFound!=pGeneric) {
+		// Which one is first?
+		const Generic *pWork = pRoot->GetNext();
+		while ((pWork!=pRoot) && (pWork!=pFound)) {
+			if (pWork==pGeneric) {
+				// The new object takes over the slot
+				uint32_t uIndex = uHash&m_uMask;
+				while (m_pSlots[uIndex].m_pGeneric!=pFound) {
+					uIndex = (uIndex+1)&m_uMask;
+				}
+				m_pSlots[uIndex].m_pGeneric = pGeneric;
+				break;
+			}
+			pWork = pWork->GetNext();
+		}
+	}
+}
+
+/*! ************************************
+
+	\brief Remove an object from the index
+
+	Call this before the object is unlinked or renamed. If it was indexed,
+	the next object in the list with the same name, if any, is indexed in its
+	place.
+
+	\param pGeneric Pointer to a Section or Entry
+	\param pRoot Pointer to the root of the list the object is in
+	\sa Add(Generic *) or Insert(Generic *,const Generic *)
+
+***************************************/
+
+void BURGER_API Burger::FileINI::Index::Remove(Generic *pGeneric,const Generic *pRoot)
+{
+	if (m_uCount) {
+		const char *pName = GetName(pGeneric);
+		const uint32_t uHash = GetHash(pGeneric);
+		uint32_t uIndex = uHash&m_uMask;
+		const Generic *pSlotGeneric;
+		while ((pSlotGeneric = m_pSlots[uIndex].m_pGeneric)!=NULL) {
+			if (pSlotGeneric==pGeneric) {
+				Erase(uIndex);
+				// Index a duplicate that was hidden by this object
+				const Generic *pWork = pRoot->GetNext();
+				while (pWork!=pRoot) {
+					if ((pWork!=pGeneric) && IsMatch(pWork,pName,uHash)) {
+						Add(const_cast<Generic *>(pWork));
+						break;
+					}
+					pWork = pWork->GetNext();
+				}
+				break;
+			}
+			uIndex = (uIndex+1)&m_uMask;
+		}
+	}
+}
+
+/*! ************************************
+
+	\brief Remove all objects and release the table
+
+	Call this when the list is emptied, an incomplete index starts using the
+	hash table again.
+
+***************************************/
+
+void BURGER_API Burger::FileINI::Index::Clear(void)
+{
+	free_memory(m_pSlots);
+	m_pSlots = NULL;
+	m_uMask = 0;
+	m_uCount = 0;
+	m_bIncomplete = FALSE;
+}
+
+/*! ************************************
+
+	\fn uint32_t Burger::FileINI::Index::GetCount(void) const
+	\brief Return the number of indexed objects
+
+	\return Number of objects with unique names
+
+***************************************/
+
+/*! ************************************
+
+	\fn uint_t Burger::FileINI::Index::IsComplete(void) const
+	\brief Return \ref TRUE if every object is in the hash table
+
+	\return \ref FALSE if the table ran out of memory and lookups scan the list
+
+***************************************/
+
+/*! ************************************
+
+	\brief Return the name of an indexed object
+
+	\param pGeneric Pointer to a Section, Entry or other Generic object
+	\return The key of an Entry, the name of a Section or \ref NULL
+
+***************************************/
+
+const char * BURGER_API Burger::FileINI::Index::GetName(const Generic *pGeneric)
+{
+	switch (pGeneric->GetType()) {
+	case Generic::LINEENTRY_ENTRY:
+		return static_cast<const Entry *>(pGeneric)->GetKey();
+	case Generic::LINEENTRY_SECTION:
+		return static_cast<const Section *>(pGeneric)->GetName();
+	default:
+		break;
+	}
+	return NULL;
+}
+
+/*! ************************************
+
+	\brief Return the case insensitive hash of an object's name
 
+	\param pGeneric Pointer to a Section, Entry or other Generic object
+	\return The stored hash of the name or zero if the object has no name
+
+***************************************/
 
+uint32_t BURGER_API Burger::FileINI::Index::GetHash(const Generic *pGeneric)
+{
+	switch (pGeneric->GetType()) {
+	case Generic::LINEENTRY_ENTRY:
+		return static_cast<const Entry *>(pGeneric)->GetKeyHash();
+	case Generic::LINEENTRY_SECTION:
+		return static_cast<const Section *>(pGeneric)->GetNameHash();
+	default:
+		break;
+	}
+	return 0;
+}
+
+/*! ************************************
+
+	\brief Test if an object has a name
+
+	The stored hashes are compared first, so most mismatches don't compare
+	the strings.
+
+	\param pGeneric Pointer to a Section, Entry or other Generic object
+	\param pName Pointer to a "C" string of the name to match
+	\param uHash Value of StringAtom::case_hash(const char *,uintptr_t) for the name
+	\return \ref TRUE if the object's name matches without case
+
+***************************************/
+
+uint_t BURGER_API Burger::FileINI::Index::IsMatch(const Generic *pGeneric,const char *pName,uint32_t uHash)
+{
+	const char *pGenericName = GetName(pGeneric);
+	return pGenericName && (GetHash(pGeneric)==uHash) &&
+		!StringCaseCompare(pGenericName,pName);
+}
+
+/*! ************************************
+
+	\brief Double the size of the hash table
+
+	On allocation failure, the table is left alone.
+
+***************************************/
+
+void BURGER_API Burger::FileINI::Index::Grow(void)
+{
+	const uint32_t uNewCount = m_pSlots ? (m_uMask+1U)*2U : kIndexStartingSlots;
+	Slot_t *pNew = static_cast<Slot_t *>(allocate_memory_clear(sizeof(Slot_t)*uNewCount));
+	if (pNew) {
+		const uint32_t uNewMask = uNewCount-1U;
+		if (m_pSlots) {
+			uint32_t i = 0;
+			do {
+				if (m_pSlots[i].m_pGeneric) {
+					uint32_t uIndex = m_pSlots[i].m_uHash&uNewMask;
+					while (pNew[uIndex].m_pGeneric) {
+						uIndex = (uIndex+1)&uNewMask;
+					}
+					pNew[uIndex] = m_pSlots[i];
+				}
+			} while (++i<=m_uMask);
+			free_memory(m_pSlots);
+		}
+		m_pSlots = pNew;
+		m_uMask = uNewMask;
+	}
+}
+
+/*! ************************************
+
+	\brief Empty a slot
+
+	The objects that follow the slot are shifted back so every search still
+	reaches them without tombstones.
+
+	\param uIndex Index of the slot to empty
+
+***************************************/
+
+void BURGER_API Burger::FileINI::Index::Erase(uint32_t uIndex)
+{
+	uint32_t uHole = uIndex;
+	for (;;) {
+		uIndex = (uIndex+1)&m_uMask;
+		const Slot_t *pSlot = &m_pSlots[uIndex];
+		if (!pSlot->m_pGeneric) {
+			break;
+		}
+		// Move it only if its home slot is not between the hole and itself
+		const uint32_t uHome = pSlot->m_uHash&m_uMask;
+		if (((uIndex-uHome)&m_uMask)>=((uIndex-uHole)&m_uMask)) {
+			m_pSlots[uHole] = pSlot[0];
+			uHole = uIndex;
+		}
+	}
+	m_pSlots[uHole].m_pGeneric = NULL;
+	--m_uCount;
+}
 
 /*! ************************************
 
@@ -294,7 +718,14 @@ Burger::FileINI::Comment * BURGER_API Burger::FileINI::Comment::new_object(const
 Burger::FileINI::Entry::Entry() :
 	Generic(LINEENTRY_ENTRY),
 	m_Key(),
-	m_Value()
+	m_Value(),
+	m_uKeyHash(StringAtom::case_hash(m_Key.c_str(),0)),
+	m_pParent(NULL),
+	m_dCachedDouble(0.0),
+	m_fCachedFloat(0.0f),
+	m_uCachedInteger(0),
+	m_uCachedBoolean(FALSE),
+	m_uCacheFlags(0)
 {
 }
 
@@ -310,7 +741,14 @@ Burger::FileINI::Entry::Entry() :
 Burger::FileINI::Entry::Entry(const char *pKey,const char *pValue) :
 	Generic(LINEENTRY_ENTRY),
 	m_Key(pKey),
-	m_Value(pValue)
+	m_Value(pValue),
+	m_uKeyHash(StringAtom::case_hash(m_Key.c_str(),m_Key.length())),
+	m_pParent(NULL),
+	m_dCachedDouble(0.0),
+	m_fCachedFloat(0.0f),
+	m_uCachedInteger(0),
+	m_uCachedBoolean(FALSE),
+	m_uCacheFlags(0)
 {
 }
 
@@ -318,12 +756,14 @@ Burger::FileINI::Entry::Entry(const char *pKey,const char *pValue) :
 
 	\brief Call the destructor for an Entry object
 
-	Unlink itself from the linked list and release the contained strings
+	Remove itself from its section's index, unlink itself from the linked list
+	and release the contained strings
 
 ***************************************/
 
 Burger::FileINI::Entry::~Entry()
 {
+	Unindex();
 }
 
 /*! ************************************
@@ -337,28 +777,54 @@ Burger::FileINI::Entry::~Entry()
 
 /*! ************************************
 
-	\fn void Burger::FileINI::Entry::SetKey(const char *pInput)
 	\brief Set a new key string
 
-	Replace the contained key string with a new one
+	Replace the contained key string with a new one and update the index of
+	the section the entry is in.
 
 	\param pInput Pointer to a "C" string
 	\sa SetValue(const char *), GetKey(void) const or SetKey(const String *)
 
 ***************************************/
 
+void BURGER_API Burger::FileINI::Entry::SetKey(const char *pInput)
+{
+	Unindex();
+	m_Key.assign(pInput);
+	Reindex();
+}
+
 /*! ************************************
 
-	\fn void Burger::FileINI::Entry::SetKey(const String *pInput)
 	\brief Set a new key string
 
-	Replace the contained key string with a new one
+	Replace the contained key string with a new one and update the index of
+	the section the entry is in.
 
 	\param pInput Pointer to a String class instance
 	\sa SetValue(const String *), GetKey(void) const or SetKey(const char *)
 
 ***************************************/
 
+void BURGER_API Burger::FileINI::Entry::SetKey(const String *pInput)
+{
+	Unindex();
+	m_Key = pInput[0];
+	Reindex();
+}
+
+/*! ************************************
+
+	\fn uint32_t Burger::FileINI::Entry::GetKeyHash(void) const
+	\brief Return the case insensitive hash of the key
+
+	The hash is updated every time the key changes, it's the same value as
+	StringAtom::case_hash(const char *,uintptr_t) for the key.
+
+	\sa GetKey(void) const or Section::FindEntry(const StringAtom &) const
+
+***************************************/
+
 /*! ************************************
 
 	\fn const char *Burger::FileINI::Entry::GetValue(void) const
@@ -373,7 +839,8 @@ Burger::FileINI::Entry::~Entry()
 	\fn void Burger::FileINI::Entry::SetValue(const char *pInput)
 	\brief Set a new value string
 
-	Replace the contained value string with a new one
+	Replace the contained value string with a new one and discard the
+	cached numeric values
 
 	\param pInput Pointer to a "C" string
 	\sa SetKey(const char *), GetValue(void) const or SetValue(const String *)
@@ -385,7 +852,8 @@ Burger::FileINI::Entry::~Entry()
 	\fn void Burger::FileINI::Entry::SetValue(const String *pInput)
 	\brief Set a new value string
 
-	Replace the contained value string with a new one
+	Replace the contained value string with a new one and discard the
+	cached numeric values
 
 	\param pInput Pointer to a String class instance
 	\sa SetKey(const String *), GetValue(void) const or SetValue(const char *)
@@ -403,6 +871,9 @@ Burger::FileINI::Entry::~Entry()
 
 	If it's none of the above, then return the default value
 
+	The value string is only parsed the first time, the result is cached
+	until the value changes.
+
 	\param bDefault Value to return on error
 	\return \ref TRUE or \ref FALSE or bDefault
 	\sa SetBoolean(uint_t) or AsciiToBoolean(const char *,uint_t)
@@ -411,7 +882,16 @@ Burger::FileINI::Entry::~Entry()
 
 uint_t BURGER_API Burger::FileINI::Entry::GetBoolean(uint_t bDefault) const
 {
-	return m_Value.GetBoolean(bDefault);
+	if (!(m_uCacheFlags&CACHE_BOOLEAN)) {
+		if (AsciiToBoolean(&m_uCachedBoolean,m_Value.c_str())) {
+			m_uCacheFlags |= CACHE_BOOLEAN_VALID;
+		}
+		m_uCacheFlags |= CACHE_BOOLEAN;
+	}
+	if (m_uCacheFlags&CACHE_BOOLEAN_VALID) {
+		bDefault = m_uCachedBoolean;
+	}
+	return bDefault;
 }
 
 /*! ************************************
@@ -430,6 +910,7 @@ uint_t BURGER_API Burger::FileINI::Entry::GetBoolean(uint_t bDefault) const
 void BURGER_API Burger::FileINI::Entry::SetBoolean(uint_t bValue)
 {
 	m_Value.SetTrueFalse(bValue);
+	m_uCacheFlags = 0;
 }
 
 /*! ************************************
@@ -445,6 +926,9 @@ void BURGER_API Burger::FileINI::Entry::SetBoolean(uint_t bValue)
 	Hex strings are acceptable input in the form
 	of $1234 and 0x1234
 
+	The value string is only parsed the first time, the result is cached
+	until the value changes.
+
 	\param uDefault Value to return on error
 	\param uMin Minimum acceptable value
 	\param uMax Maximum acceptable value
@@ -455,7 +939,18 @@ void BURGER_API Burger::FileINI::Entry::SetBoolean(uint_t bValue)
 
 uint_t BURGER_API Burger::FileINI::Entry::GetWord(uint_t uDefault,uint_t uMin,uint_t uMax) const
 {
-	return AsciiToWord(m_Value.c_str(),uDefault,uMin,uMax);
+	if (CacheInteger()) {
+		const uint_t uValue = m_uCachedInteger;
+		// Bounds test
+		if (uValue<uMin) {
+			uDefault = uMin;
+		} else if (uValue>uMax) {
+			uDefault = uMax;
+		} else {
+			uDefault = uValue;
+		}
+	}
+	return uDefault;
 }
 
 /*! ************************************
@@ -473,6 +968,7 @@ uint_t BURGER_API Burger::FileINI::Entry::GetWord(uint_t uDefault,uint_t uMin,ui
 void BURGER_API Burger::FileINI::Entry::SetWord(uint_t uValue)
 {
 	m_Value.SetWord(uValue);
+	m_uCacheFlags = 0;
 }
 
 /*! ************************************
@@ -491,6 +987,7 @@ void BURGER_API Burger::FileINI::Entry::SetWord(uint_t uValue)
 void BURGER_API Burger::FileINI::Entry::SetWordHex(uint_t uValue)
 {
 	m_Value.SetWordHex(uValue);
+	m_uCacheFlags = 0;
 }
 
 /*! ************************************
@@ -507,6 +1004,9 @@ void BURGER_API Burger::FileINI::Entry::SetWordHex(uint_t uValue)
 	of $1234 and 0x1234. 0xFFFFFFFF will be converted
 	to -1.
 
+	The value string is only parsed the first time, the result is cached
+	until the value changes.
+
 	\param iDefault Value to return on error
 	\param iMin Minimum acceptable value
 	\param iMax Maximum acceptable value
@@ -517,7 +1017,18 @@ void BURGER_API Burger::FileINI::Entry::SetWordHex(uint_t uValue)
 
 int_t BURGER_API Burger::FileINI::Entry::GetInt(int_t iDefault,int_t iMin,int_t iMax) const
 {
-	return m_Value.GetInt(iDefault,iMin,iMax);
+	if (CacheInteger()) {
+		// Do a signed bounds check
+		const int_t iValue = static_cast<int_t>(m_uCachedInteger);
+		if (iValue<iMin) {
+			iDefault = iMin;
+		} else if (iValue>iMax) {
+			iDefault = iMax;
+		} else {
+			iDefault = iValue;
+		}
+	}
+	return iDefault;
 }
 
 /*! ************************************
@@ -535,6 +1046,7 @@ int_t BURGER_API Burger::FileINI::Entry::GetInt(int_t iDefault,int_t iMin,int_t
 void BURGER_API Burger::FileINI::Entry::SetInt(int_t iValue)
 {
 	m_Value.SetInt(iValue);
+	m_uCacheFlags = 0;
 }
 
 /*! ************************************
@@ -550,6 +1062,9 @@ void BURGER_API Burger::FileINI::Entry::SetInt(int_t iValue)
 	If NaN or Inf is detected, it will be converted to a zero
 	to prevent floating point issues.
 
+	The value string is only parsed the first time, the result is cached
+	until the value changes.
+
 	\param fDefault Value to return on error
 	\param fMin Minimum acceptable value
 	\param fMax Maximum acceptable value
@@ -560,7 +1075,26 @@ void BURGER_API Burger::FileINI::Entry::SetInt(int_t iValue)
 
 float BURGER_API Burger::FileINI::Entry::GetFloat(float fDefault,float fMin,float fMax) const
 {
-	return m_Value.GetFloat(fDefault,fMin,fMax);
+	if (!(m_uCacheFlags&CACHE_FLOAT)) {
+		if (AsciiToFloat(&m_fCachedFloat,m_Value.c_str())) {
+			m_uCacheFlags |= CACHE_FLOAT_VALID;
+		}
+		m_uCacheFlags |= CACHE_FLOAT;
+	}
+	if (m_uCacheFlags&CACHE_FLOAT_VALID) {
+		const float fValue = m_fCachedFloat;
+		// Is it NaN or Inf?
+		if (!is_finite(fValue)) {
+			fDefault = 0.0f;
+		} else if (fValue<fMin) {
+			fDefault = fMin;
+		} else if (fValue>fMax) {
+			fDefault = fMax;
+		} else {
+			fDefault = fValue;
+		}
+	}
+	return fDefault;
 }
 
 /*! ************************************
@@ -578,6 +1112,7 @@ float BURGER_API Burger::FileINI::Entry::GetFloat(float fDefault,float fMin,floa
 void BURGER_API Burger::FileINI::Entry::SetFloat(float fValue)
 {
 	m_Value.SetFloat(fValue);
+	m_uCacheFlags = 0;
 }
 
 /*! ************************************
@@ -593,6 +1128,9 @@ void BURGER_API Burger::FileINI::Entry::SetFloat(float fValue)
 	If NaN or Inf is detected, it will be converted to a zero
 	to prevent floating point issues.
 
+	The value string is only parsed the first time, the result is cached
+	until the value changes.
+
 	\param dDefault Value to return on error
 	\param dMin Minimum acceptable value
 	\param dMax Maximum acceptable value
@@ -603,7 +1141,26 @@ void BURGER_API Burger::FileINI::Entry::SetFloat(float fValue)
 
 double BURGER_API Burger::FileINI::Entry::GetDouble(double dDefault,double dMin,double dMax) const
 {
-	return m_Value.GetDouble(dDefault,dMin,dMax);
+	if (!(m_uCacheFlags&CACHE_DOUBLE)) {
+		if (AsciiToDouble(&m_dCachedDouble,m_Value.c_str())) {
+			m_uCacheFlags |= CACHE_DOUBLE_VALID;
+		}
+		m_uCacheFlags |= CACHE_DOUBLE;
+	}
+	if (m_uCacheFlags&CACHE_DOUBLE_VALID) {
+		const double dValue = m_dCachedDouble;
+		// Is it NaN or Inf?
+		if (!is_finite(dValue)) {
+			dDefault = 0.0;
+		} else if (dValue<dMin) {
+			dDefault = dMin;
+		} else if (dValue>dMax) {
+			dDefault = dMax;
+		} else {
+			dDefault = dValue;
+		}
+	}
+	return dDefault;
 }
 
 /*! ************************************
@@ -621,6 +1178,7 @@ double BURGER_API Burger::FileINI::Entry::GetDouble(double dDefault,double dMin,
 void BURGER_API Burger::FileINI::Entry::SetDouble(double dValue)
 {
 	m_Value.SetDouble(dValue);
+	m_uCacheFlags = 0;
 }
 
 /*! ************************************
@@ -703,6 +1261,7 @@ void BURGER_API Burger::FileINI::Entry::SetString(const char *pValue)
 		// End now
 		m_Value.clear();
 	}
+	m_uCacheFlags = 0;
 }
 
 /*! ************************************
@@ -732,6 +1291,58 @@ Burger::FileINI::Entry * BURGER_API Burger::FileINI::Entry::new_object(const cha
 	return new (allocate_memory(sizeof(Entry))) Entry(pKey,pValue);
 }
 
+/*! ************************************
+
+	\brief Remove the entry from its section's index
+
+	Called before the key changes or the entry is destroyed.
+
+	\sa Reindex(void)
+
+***************************************/
+
+void BURGER_API Burger::FileINI::Entry::Unindex(void)
+{
+	if (m_pParent) {
+		m_pParent->m_Index.Remove(this,&m_pParent->m_Root);
+	}
+}
+
+/*! ************************************
+
+	\brief Hash the key and add the entry back to its section's index
+
+	\sa Unindex(void)
+
+***************************************/
+
+void BURGER_API Burger::FileINI::Entry::Reindex(void)
+{
+	m_uKeyHash = StringAtom::case_hash(m_Key.c_str(),m_Key.length());
+	if (m_pParent) {
+		m_pParent->m_Index.Insert(this,&m_pParent->m_Root);
+	}
+}
+
+/*! ************************************
+
+	\brief Parse the value as an integer if it wasn't already
+
+	\return \ref TRUE if m_uCachedInteger holds a valid number
+
+***************************************/
+
+uint_t BURGER_API Burger::FileINI::Entry::CacheInteger(void) const
+{
+	if (!(m_uCacheFlags&CACHE_INTEGER)) {
+		if (AsciiToInteger(&m_uCachedInteger,m_Value.c_str())) {
+			m_uCacheFlags |= CACHE_INTEGER_VALID;
+		}
+		m_uCacheFlags |= CACHE_INTEGER;
+	}
+	return m_uCacheFlags&CACHE_INTEGER_VALID;
+}
+
 
 /*! ************************************
 
@@ -774,7 +1385,10 @@ Burger::FileINI::Entry * BURGER_API Burger::FileINI::Entry::new_object(const cha
 Burger::FileINI::Section::Section() : 
 	Generic(LINEENTRY_SECTION),
 	m_Root(LINEENTRY_ROOT),
-	m_SectionName()
+	m_Index(),
+	m_SectionName(),
+	m_uNameHash(StringAtom::case_hash(m_SectionName.c_str(),0)),
+	m_pParent(NULL)
 {
 }
 
@@ -789,7 +1403,10 @@ Burger::FileINI::Section::Section() :
 Burger::FileINI::Section::Section(const char *pSection) : 
 	Generic(LINEENTRY_SECTION),
 	m_Root(LINEENTRY_ROOT),
-	m_SectionName(pSection)
+	m_Index(),
+	m_SectionName(pSection),
+	m_uNameHash(StringAtom::case_hash(m_SectionName.c_str(),m_SectionName.length())),
+	m_pParent(NULL)
 {
 }
 
@@ -797,13 +1414,16 @@ Burger::FileINI::Section::Section(const char *pSection) :
 
 	\brief Call the destructor for a Section object
 
-	Unlink itself from the linked list and release the contained strings
-	and objects
+	Remove itself from the FileINI's index, unlink itself from the linked list
+	and release the contained strings and objects
 
 ***************************************/
 
 Burger::FileINI::Section::~Section()
 {
+	Unindex();
+	// Nothing needs to be found while the entries are disposed of
+	m_Index.Clear();
 	Generic *pGeneric = m_Root.GetNext();
 	if (pGeneric!=&m_Root) {
 		// Dispose of all the objects in the list
@@ -876,28 +1496,54 @@ uint_t BURGER_API Burger::FileINI::Section::Save(OutputMemoryStream *pOutput) co
 
 /*! ************************************
 
-	\fn void Burger::FileINI::Section::SetName(const char *pInput)
 	\brief Set a new name for the section
 
-	Replace the section name string with a new one
+	Replace the section name string with a new one and update the index of
+	the FileINI the section is in.
 
 	\param pInput Pointer to a "C" string
 	\sa GetName(void) const or SetName(const String *)
 
 ***************************************/
 
+void BURGER_API Burger::FileINI::Section::SetName(const char *pInput)
+{
+	Unindex();
+	m_SectionName.assign(pInput);
+	Reindex();
+}
+
 /*! ************************************
 
-	\fn void Burger::FileINI::Section::SetName(const String *pInput)
 	\brief Set a new name for the section
 
-	Replace the section name string with a new one
+	Replace the section name string with a new one and update the index of
+	the FileINI the section is in.
 
 	\param pInput Pointer to a String class instance
 	\sa GetName(void) const or SetName(const char *)
 
 ***************************************/
 
+void BURGER_API Burger::FileINI::Section::SetName(const String *pInput)
+{
+	Unindex();
+	m_SectionName = pInput[0];
+	Reindex();
+}
+
+/*! ************************************
+
+	\fn uint32_t Burger::FileINI::Section::GetNameHash(void) const
+	\brief Return the case insensitive hash of the section name
+
+	The hash is updated every time the name changes, it's the same value as
+	StringAtom::case_hash(const char *,uintptr_t) for the name.
+
+	\sa GetName(void) const or FileINI::FindSection(const StringAtom &,uint_t)
+
+***************************************/
+
 /*! ************************************
 
 	\brief Create a new entry and append it to the end of the section
@@ -914,6 +1560,8 @@ Burger::FileINI::Entry * BURGER_API Burger::FileINI::Section::AddEntry(const cha
 	Entry *pEntry = Entry::new_object(pKey,pValue);
 	if (pEntry) {
 		m_Root.InsertBefore(pEntry);
+		pEntry->m_pParent = this;
+		m_Index.Add(pEntry);
 	}
 	return pEntry;
 }
@@ -922,6 +1570,8 @@ Burger::FileINI::Entry * BURGER_API Burger::FileINI::Section::AddEntry(const cha
 
 	\brief Locate an entry and return it if found
 
+	Keys are matched without case using the section's hash index.
+
 	\param pKey Pointer to a "C" of the key desired
 	\return Pointer to the located entry or \ref NULL if the entry wasn't found
 	\sa FindEntry(const char *,uint_t)
@@ -930,21 +1580,7 @@ Burger::FileINI::Entry * BURGER_API Burger::FileINI::Section::AddEntry(const cha
 
 Burger::FileINI::Entry * BURGER_API Burger::FileINI::Section::FindEntry(const char *pKey) const
 {
-	const Generic *pGeneric = m_Root.GetNext();
-	Entry *pResult = NULL;
-	if (pGeneric!=&m_Root) {
-		// Only match entry objects (Skip comment objects)
-		do {
-			if (pGeneric->GetType()==LINEENTRY_ENTRY) {
-				if (!StringCaseCompare(static_cast<const Entry *>(pGeneric)->GetKey(),pKey)) {
-					pResult = const_cast<Entry *>(static_cast<const Entry *>(pGeneric));
-					break;
-				}
-			}
-			pGeneric = pGeneric->GetNext();
-		} while (pGeneric!=&m_Root);
-	}
-	return pResult;
+	return static_cast<Entry *>(m_Index.Find(pKey,&m_Root));
 }
 
 /*! ************************************
@@ -960,36 +1596,67 @@ Burger::FileINI::Entry * BURGER_API Burger::FileINI::Section::FindEntry(const ch
 
 Burger::FileINI::Entry * BURGER_API Burger::FileINI::Section::FindEntry(const char *pKey,uint_t bAlwaysCreate)
 {
-	const Generic *pGeneric = m_Root.GetNext();
-	Entry *pResult = NULL;
-	const Generic *pLastEntry = &m_Root;
-	if (pGeneric!=pLastEntry) {
-		// Only match entry objects (Skip comment objects)
-		do {
-			if (pGeneric->GetType()==LINEENTRY_ENTRY) {
-				if (!StringCaseCompare(static_cast<const Entry *>(pGeneric)->GetKey(),pKey)) {
-					pResult = const_cast<Entry *>(static_cast<const Entry *>(pGeneric));
-					break;
-				}
-				pLastEntry = pGeneric;
-			}
-			pGeneric = pGeneric->GetNext();
-		} while (pGeneric!=&m_Root);
-	}
+	Entry *pResult = static_cast<Entry *>(m_Index.Find(pKey,&m_Root));
 	// Not found and create flag set?
 	if (!pResult && bAlwaysCreate) {
 		// Create it with no data
 		pResult = Entry::new_object(pKey,"");
 		if (pResult) {
-			// Insert it after the last located entry (But before the last comments)
+			// Insert it after the last entry (But before the last comments)
 			// This will allow any spacing from the entries to the next section to be
 			// maintained
-			const_cast<Generic *>(pLastEntry)->InsertAfter(pResult);
+			Generic *pLastEntry = m_Root.GetPrevious();
+			while ((pLastEntry!=&m_Root) && (pLastEntry->GetType()!=LINEENTRY_ENTRY)) {
+				pLastEntry = pLastEntry->GetPrevious();
+			}
+			pLastEntry->InsertAfter(pResult);
+			pResult->m_pParent = this;
+			m_Index.Add(pResult);
 		}
 	}
 	return pResult;
 }
 
+/*! ************************************
+
+	\brief Locate an entry by interned key and return it if found
+
+	Keys are matched without case using the hash stored in the atom, so the
+	key isn't hashed again. Loaded entries are not interned, only the key
+	being searched for is an atom.
+
+	\param rKey Interned key desired
+	\return Pointer to the located entry or \ref NULL if the entry wasn't found
+	\sa FindEntry(const StringAtom &,uint_t) or FindEntry(const char *) const
+
+***************************************/
+
+Burger::FileINI::Entry * BURGER_API Burger::FileINI::Section::FindEntry(const StringAtom &rKey) const
+{
+	return static_cast<Entry *>(m_Index.Find(rKey,&m_Root));
+}
+
+/*! ************************************
+
+	\brief Locate an entry by interned key and return it or create it if necessary
+
+	\param rKey Interned key desired
+	\param bAlwaysCreate If non-zero, and if the entry wasn't found, create a new entry with this desired key
+	\return Pointer to the located key or \ref NULL if the key wasn't found or not enough memory to create a new entry
+	\sa FindEntry(const StringAtom &) const or FindEntry(const char *,uint_t)
+
+***************************************/
+
+Burger::FileINI::Entry * BURGER_API Burger::FileINI::Section::FindEntry(const StringAtom &rKey,uint_t bAlwaysCreate)
+{
+	Entry *pResult = static_cast<const Section *>(this)->FindEntry(rKey);
+	if (!pResult && bAlwaysCreate && rKey.is_valid()) {
+		// Use the string version to insert it in the right place
+		pResult = FindEntry(rKey.c_str(),TRUE);
+	}
+	return pResult;
+}
+
 /*! ************************************
 
 	\brief Create a new comment and append it to the end of the section
@@ -1431,6 +2098,94 @@ void BURGER_API Burger::FileINI::Section::SetString(const char *pKey,const char
 	}
 }
 
+/*! ************************************
+
+	\enum Burger::FileINI::Section::eValueType
+	\brief Type of variable a ValueRequest_t writes to
+
+	\sa GetValues(const ValueRequest_t *,uintptr_t) const
+
+***************************************/
+
+/*! ************************************
+
+	\struct Burger::FileINI::Section::ValueRequest_t
+	\brief Description of a value for GetValues()
+
+	The variable pointed to by m_pOutput must be set to the default value
+	before calling GetValues(const ValueRequest_t *,uintptr_t) const.
+
+	\sa eValueType
+
+***************************************/
+
+/*! ************************************
+
+	\brief Read a list of values in a single call
+
+	For each request, the entry is found with the hash index and the value
+	is converted to the requested type. Numbers are parsed once per entry
+	and cached, so reading the same section again is only a lookup. If the
+	key doesn't exist or the value can't be parsed, the variable keeps its
+	default. There are no range checks.
+
+	\code
+	uint_t uWidth = 640;
+	float fVolume = 1.0f;
+	const Burger::FileINI::Section::ValueRequest_t Requests[] = {
+		{"Width",Burger::FileINI::Section::VALUE_WORD,&uWidth},
+		{"Volume",Burger::FileINI::Section::VALUE_FLOAT,&fVolume}
+	};
+	pSection->GetValues(Requests,BURGER_ARRAYSIZE(Requests));
+	\endcode
+
+	\param pRequests Pointer to an array of requests
+	\param uCount Number of requests in the array
+	\return Number of keys that were found
+	\sa GetWord(const char *,uint_t,uint_t,uint_t) const or
+		GetString(String *,const char *,const char *) const
+
+***************************************/
+
+uintptr_t BURGER_API Burger::FileINI::Section::GetValues(const ValueRequest_t *pRequests,uintptr_t uCount) const
+{
+	uintptr_t uFound = 0;
+	if (uCount) {
+		do {
+			const Entry *pEntry = FindEntry(pRequests->m_pKey);
+			if (pEntry) {
+				++uFound;
+				void *pOutput = pRequests->m_pOutput;
+				switch (pRequests->m_eType) {
+				case VALUE_BOOLEAN:
+					static_cast<uint_t *>(pOutput)[0] = pEntry->GetBoolean(static_cast<uint_t *>(pOutput)[0]);
+					break;
+				case VALUE_WORD:
+					static_cast<uint_t *>(pOutput)[0] = pEntry->GetWord(static_cast<uint_t *>(pOutput)[0]);
+					break;
+				case VALUE_INT:
+					static_cast<int_t *>(pOutput)[0] = pEntry->GetInt(static_cast<int_t *>(pOutput)[0]);
+					break;
+				case VALUE_FLOAT:
+					static_cast<float *>(pOutput)[0] = pEntry->GetFloat(static_cast<float *>(pOutput)[0],g_fNegMax,g_fMax);
+					break;
+				case VALUE_DOUBLE:
+					static_cast<double *>(pOutput)[0] = pEntry->GetDouble(static_cast<double *>(pOutput)[0],g_dNegMax,g_dMax);
+					break;
+				case VALUE_STRING:
+					// An empty value keeps the default
+					if (pEntry->GetValue()[0]) {
+						pEntry->GetString(static_cast<String *>(pOutput),"");
+					}
+					break;
+				}
+			}
+			++pRequests;
+		} while (--uCount);
+	}
+	return uFound;
+}
+
 /*! ************************************
 
 	\brief Allocate an empty Section object
@@ -1457,6 +2212,39 @@ Burger::FileINI::Section * BURGER_API Burger::FileINI::Section::new_object(const
 	return new (allocate_memory(sizeof(Section))) Section(pSection);
 }
 
+/*! ************************************
+
+	\brief Remove the section from its FileINI's index
+
+	Called before the name changes or the section is destroyed.
+
+	\sa Reindex(void)
+
+***************************************/
+
+void BURGER_API Burger::FileINI::Section::Unindex(void)
+{
+	if (m_pParent) {
+		m_pParent->m_Index.Remove(this,&m_pParent->m_Root);
+	}
+}
+
+/*! ************************************
+
+	\brief Hash the name and add the section back to its FileINI's index
+
+	\sa Unindex(void)
+
+***************************************/
+
+void BURGER_API Burger::FileINI::Section::Reindex(void)
+{
+	m_uNameHash = StringAtom::case_hash(m_SectionName.c_str(),m_SectionName.length());
+	if (m_pParent) {
+		m_pParent->m_Index.Insert(this,&m_pParent->m_Root);
+	}
+}
+
 /*! ************************************
 
 	\class Burger::FileINI
@@ -1500,7 +2288,8 @@ Burger::FileINI::Section * BURGER_API Burger::FileINI::Section::new_object(const
 ***************************************/
 
 Burger::FileINI::FileINI(void) :
-	m_Root(Generic::LINEENTRY_ROOT)
+	m_Root(Generic::LINEENTRY_ROOT),
+	m_Index()
 {
 }
 
@@ -1709,6 +2498,8 @@ uint_t BURGER_API Burger::FileINI::Init(InputMemoryStream *pInput)
 		if (!pSection) {
 			pSection = Section::new_object();
 			m_Root.InsertAfter(pSection);
+			pSection->m_pParent = this;
+			m_Index.Add(pSection);
 		}
 		// Is this a Foo = Bar entry?
 		// Skip C++ and ASM style comments
@@ -1748,6 +2539,8 @@ uint_t BURGER_API Burger::FileINI::Init(InputMemoryStream *pInput)
 
 void BURGER_API Burger::FileINI::Shutdown(void)
 {
+	// Nothing needs to be found while the sections are disposed of
+	m_Index.Clear();
 	Generic *pGeneric = m_Root.GetNext();
 	if (pGeneric!=&m_Root) {
 		// Dispose of all the objects in the list
@@ -1854,6 +2647,8 @@ Burger::FileINI::Section * BURGER_API Burger::FileINI::AddSection(const char *pS
 	if (pSection) {
 		// Insert at the end of the list
 		m_Root.InsertBefore(pSection);
+		pSection->m_pParent = this;
+		m_Index.Add(pSection);
 	}
 	return pSection;
 }
@@ -1862,7 +2657,7 @@ Burger::FileINI::Section * BURGER_API Burger::FileINI::AddSection(const char *pS
 
 	\brief Find a Section
 	
-	Traverse the linked list for a section that has the requested name. Return
+	Look up the section in the hash index by name without case. Return
 	\ref NULL if the record wasn't found and bAlwaysCreate is zero. If
 	bAlwaysCreate is not zero and the record didn't exist, create one with
 	the requested name.
@@ -1876,33 +2671,43 @@ Burger::FileINI::Section * BURGER_API Burger::FileINI::AddSection(const char *pS
 
 Burger::FileINI::Section * BURGER_API Burger::FileINI::FindSection(const char *pSectionName,uint_t bAlwaysCreate)
 {
-	Generic *pGeneric = m_Root.GetNext();
-	Section *pResult = NULL;
-	if (pGeneric!=&m_Root) {
-		// Iterate over all the objects in the list
-		do {
-			if (pGeneric->GetType()==Generic::LINEENTRY_SECTION) {
-				if (!StringCaseCompare(static_cast<const Section *>(pGeneric)->GetName(),pSectionName)) {
-					pResult = static_cast<Section *>(pGeneric);
-					break;
-				}
-			}
-			pGeneric = pGeneric->GetNext();
-		} while (pGeneric!=&m_Root);
-	}
+	Section *pResult = static_cast<Section *>(m_Index.Find(pSectionName,&m_Root));
 	if (!pResult && bAlwaysCreate) {
 		pResult = AddSection(pSectionName);
 	}
 	return pResult;
 }
 
+/*! ************************************
+
+	\brief Find a section by interned name
+
+	Names are matched without case using the hash stored in the atom, so the
+	name isn't hashed again. Loaded sections are not interned, only the name
+	being searched for is an atom.
+
+	\param rSectionName Interned name of the section to locate
+	\param bAlwaysCreate \ref TRUE to create the section if one didn't already exist
+	\return Pointer to a Section with the requested name or \ref NULL if not found
+	\sa FindSection(const char *,uint_t)
+
+***************************************/
+
+Burger::FileINI::Section * BURGER_API Burger::FileINI::FindSection(const StringAtom &rSectionName,uint_t bAlwaysCreate)
+{
+	Section *pResult = static_cast<Section *>(m_Index.Find(rSectionName,&m_Root));
+	if (!pResult && bAlwaysCreate && rSectionName.is_valid()) {
+		pResult = AddSection(rSectionName.c_str());
+	}
+	return pResult;
+}
+
 /*! ************************************
 
 	\brief Delete a named Section
 	
-	Traverse the linked list for a section
-	that has the requested name and delete it and all
-	data attached to it.
+	Find the section that has the requested name
+	and delete it and all data attached to it.
 
 	\param pSectionName Pointer to a "C" string of the new section to locate
 	\sa FindSection(const char *,uint_t) or AddSection(const char *)
@@ -31,6 +31,10 @@
 #include "brstring.h"
 #endif
 
+#ifndef __BRSTRINGATOM_H__
+#include "brstringatom.h"
+#endif
+
 #ifndef __BRFILENAME_H__
 #include "brfilename.h"
 #endif
@@ -78,6 +82,36 @@ public:
 		}
 	};
 
+	class Index {
+		BURGER_DISABLE_COPY(Index);
+		struct Slot_t {
+			Generic *m_pGeneric;	///< Indexed object, \ref NULL if the slot is empty
+			uint32_t m_uHash;		///< Case insensitive hash of the object's name
+		};
+		Slot_t *m_pSlots;		///< Open addressed hash table
+		uint32_t m_uMask;		///< Number of slots minus one
+		uint32_t m_uCount;		///< Number of objects in the table
+		uint_t m_bIncomplete;	///< \ref TRUE if an object couldn't be indexed
+	public:
+		Index();
+		~Index();
+		Generic * BURGER_API Find(const char *pName,const Generic *pRoot) const;
+		Generic * BURGER_API Find(const StringAtom &rName,const Generic *pRoot) const;
+		Generic * BURGER_API Find(const char *pName,uint32_t uHash,const Generic *pRoot) const;
+		void BURGER_API Add(Generic *pGeneric);
+		void BURGER_API Insert(Generic *pGeneric,const Generic *pRoot);
+		void BURGER_API Remove(Generic *pGeneric,const Generic *pRoot);
+		void BURGER_API Clear(void);
+		BURGER_INLINE uint32_t GetCount(void) const { return m_uCount; }
+		BURGER_INLINE uint_t IsComplete(void) const { return !m_bIncomplete; }
+		static const char * BURGER_API GetName(const Generic *pGeneric);
+		static uint32_t BURGER_API GetHash(const Generic *pGeneric);
+		static uint_t BURGER_API IsMatch(const Generic *pGeneric,const char *pName,uint32_t uHash);
+	private:
+		void BURGER_API Grow(void);
+		void BURGER_API Erase(uint32_t uIndex);
+	};
+
 	class Comment : public Generic {
 		String m_Comment;	///< Unmodified text for a comment line
 	public:
@@ -91,19 +125,39 @@ public:
 		static Comment * BURGER_API new_object(const char *pComment);
 	};
 
+	class Section;
 	class Entry : public Generic {
+		friend class Section;
+		enum {
+			CACHE_INTEGER=0x01,			///< m_uCachedInteger was parsed
+			CACHE_INTEGER_VALID=0x02,	///< m_uCachedInteger is a number
+			CACHE_FLOAT=0x04,			///< m_fCachedFloat was parsed
+			CACHE_FLOAT_VALID=0x08,		///< m_fCachedFloat is a number
+			CACHE_DOUBLE=0x10,			///< m_dCachedDouble was parsed
+			CACHE_DOUBLE_VALID=0x20,	///< m_dCachedDouble is a number
+			CACHE_BOOLEAN=0x40,			///< m_uCachedBoolean was parsed
+			CACHE_BOOLEAN_VALID=0x80	///< m_uCachedBoolean is a boolean
+		};
 		String m_Key;			///< Value's key
 		String m_Value;			///< UTF-8 form of the value
+		uint32_t m_uKeyHash;	///< Case insensitive hash of m_Key
+		Section *m_pParent;		///< Section that indexes this entry
+		mutable double m_dCachedDouble;		///< m_Value parsed as a double
+		mutable float m_fCachedFloat;		///< m_Value parsed as a float
+		mutable uint32_t m_uCachedInteger;	///< m_Value parsed as an integer
+		mutable uint_t m_uCachedBoolean;	///< m_Value parsed as a boolean
+		mutable uint_t m_uCacheFlags;		///< Which values above were parsed
 	public:
 		Entry();
 		Entry(const char *pKey,const char *pValue);
 		virtual ~Entry();
 		BURGER_INLINE const char *GetKey(void) const { return m_Key.c_str(); }
-		BURGER_INLINE void SetKey(const char *pInput) { m_Key.assign(pInput); }
-		BURGER_INLINE void SetKey(const String *pInput) { m_Key = pInput[0]; }
+		void BURGER_API SetKey(const char *pInput);
+		void BURGER_API SetKey(const String *pInput);
+		BURGER_INLINE uint32_t GetKeyHash(void) const { return m_uKeyHash; }
 		BURGER_INLINE const char *GetValue(void) const { return m_Value.c_str(); }
-		BURGER_INLINE void SetValue(const char *pInput) { m_Value.assign(pInput); }
-		BURGER_INLINE void SetValue(const String *pInput) { m_Value = pInput[0]; }
+		BURGER_INLINE void SetValue(const char *pInput) { m_Value.assign(pInput); m_uCacheFlags = 0; }
+		BURGER_INLINE void SetValue(const String *pInput) { m_Value = pInput[0]; m_uCacheFlags = 0; }
 		uint_t BURGER_API GetBoolean(uint_t bDefault) const;
 		void BURGER_API SetBoolean(uint_t bValue);
 		uint_t BURGER_API GetWord(uint_t uDefault,uint_t uMin=0,uint_t uMax=UINT32_MAX) const;
@@ -119,22 +173,47 @@ public:
 		void BURGER_API SetString(const char *pValue);
 		static Entry * BURGER_API new_object(void);
 		static Entry * BURGER_API new_object(const char *pKey,const char *pValue);
+	private:
+		void BURGER_API Unindex(void);
+		void BURGER_API Reindex(void);
+		uint_t BURGER_API CacheInteger(void) const;
 	};
 
 	class Section : public Generic {
+		friend class Entry;
+		friend class FileINI;
 		Generic m_Root;			///< Linked list root for all attached entries
+		Index m_Index;			///< Hash index of the entries by key
 		String m_SectionName;	///< Name of the section
+		uint32_t m_uNameHash;	///< Case insensitive hash of m_SectionName
+		FileINI *m_pParent;		///< FileINI that indexes this section
 	public:
+		enum eValueType {
+			VALUE_BOOLEAN,		///< m_pOutput points to a uint_t, \ref TRUE or \ref FALSE
+			VALUE_WORD,			///< m_pOutput points to a uint_t
+			VALUE_INT,			///< m_pOutput points to an int_t
+			VALUE_FLOAT,		///< m_pOutput points to a float
+			VALUE_DOUBLE,		///< m_pOutput points to a double
+			VALUE_STRING		///< m_pOutput points to a String
+		};
+		struct ValueRequest_t {
+			const char *m_pKey;		///< Key of the entry to read
+			eValueType m_eType;		///< Type of the variable m_pOutput points to
+			void *m_pOutput;		///< Variable holding the default, replaced with the value if found
+		};
 		Section();
 		Section(const char *pSection);
 		virtual ~Section();
 		uint_t BURGER_API Save(OutputMemoryStream *pOutput) const;
 		BURGER_INLINE const char *GetName(void) const { return m_SectionName.c_str(); }
-		BURGER_INLINE void SetName(const char *pInput) { m_SectionName.assign(pInput); }
-		BURGER_INLINE void SetName(const String *pInput) { m_SectionName = pInput[0]; }
+		void BURGER_API SetName(const char *pInput);
+		void BURGER_API SetName(const String *pInput);
+		BURGER_INLINE uint32_t GetNameHash(void) const { return m_uNameHash; }
 		Entry * BURGER_API AddEntry(const char *pKey,const char *pValue);
 		Entry * BURGER_API FindEntry(const char *pKey) const;
 		Entry * BURGER_API FindEntry(const char *pKey,uint_t bAlwaysCreate);
+		Entry * BURGER_API FindEntry(const StringAtom &rKey) const;
+		Entry * BURGER_API FindEntry(const StringAtom &rKey,uint_t bAlwaysCreate);
 		Comment * BURGER_API AddComment(const char *pComment);
 		const char * BURGER_API GetValue(const char *pKey) const;
 		void BURGER_API SetValue(const char *pKey,const char *pInput);
@@ -152,13 +231,19 @@ public:
 		void BURGER_API SetDouble(const char *pKey,double dValue);
 		void BURGER_API GetString(String *pOutput,const char *pKey,const char *pDefault) const;
 		void BURGER_API SetString(const char *pKey,const char *pValue);
+		uintptr_t BURGER_API GetValues(const ValueRequest_t *pRequests,uintptr_t uCount) const;
 		static Section * BURGER_API new_object(void);
 		static Section * BURGER_API new_object(const char *pSection);
+	private:
+		void BURGER_API Unindex(void);
+		void BURGER_API Reindex(void);
 	};
 
 	BURGER_DISABLE_COPY(FileINI);
+	friend class Section;
 private:
 	Generic m_Root;				///< Root entry for a list of sections
+	Index m_Index;				///< Hash index of the sections by name
 public:
 	FileINI();
 	~FileINI();
@@ -175,6 +260,7 @@ public:
 	uint_t BURGER_API Save(OutputMemoryStream *pOutput) const;
 	Section * BURGER_API AddSection(const char *pSectionName);
 	Section * BURGER_API FindSection(const char *pSectionName,uint_t bAlwaysCreate=FALSE);
+	Section * BURGER_API FindSection(const StringAtom &rSectionName,uint_t bAlwaysCreate=FALSE);
 	void BURGER_API DeleteSection(const char *pSectionName);
 };
 }
@@ -78,53 +78,116 @@ struct ILBMBody {		// BODY record
 
 /*! ************************************
 
-	\brief Unpack data using ILBM compression
+	\brief Unpack data using ILBM compression from memory
+
+	Decompress IFF ByteRun1 data. Runs are filled and literals are copied a
+	block at a time. The token 0x80 is skipped as the format requires. If
+	the input runs out, the rest of the output is zero filled.
 
 	\param pOutput Buffer to accept the decompressed data
 	\param uOutputLength Length of the buffer for decompressed data
-	\param pInput Data stream to read compressed data from
+	\param pInput Pointer to the compressed data
+	\param uInputLength Number of bytes of compressed data
+	\param pInputUsed Pointer to receive the number of bytes consumed
 	\return \ref NULL if success or a pointer to a string describing the error
+	\sa UnpackILBMData(uint8_t *,uintptr_t,InputMemoryStream *)
 
 ***************************************/
 
-const char * BURGER_API Burger::FileLBM::UnpackILBMData(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput)
+const char * BURGER_API Burger::FileLBM::UnpackILBMData(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength,uintptr_t *pInputUsed)
 {
-	if (uOutputLength) {
-		do {
-			uint_t uTemp = pInput->GetByte();		// Get the run token
-			if (uTemp & 0x80U) {				// Run length?
-				uTemp = 0x101U-uTemp;			// Count the run
-				if (uOutputLength<uTemp) {		// Too large?
-					break;
-				}
-				uOutputLength = uOutputLength-uTemp;	// Remove from count
-				uint8_t uFill = pInput->GetByte();
+	const uint8_t *pWork = pInput;
+	const uint8_t *pEnd = pInput+uInputLength;
+	while (uOutputLength) {
+		if (pWork>=pEnd) {
+			// Missing data reads as zeros
+			memory_clear(pOutput,uOutputLength);
+			uOutputLength = 0;
+			break;
+		}
+		uint_t uTemp = pWork[0];			// Get the run token
+		++pWork;
+		if (uTemp & 0x80U) {				// Run length?
+			if (uTemp==0x80U) {				// No operation
+				continue;
+			}
+			uTemp = 0x101U-uTemp;			// Count the run
+			if (uOutputLength<uTemp) {		// Too large?
+				break;
+			}
+			uOutputLength = uOutputLength-uTemp;	// Remove from count
+			uint8_t uFill = 0;
+			if (pWork<pEnd) {
+				uFill = pWork[0];
+				++pWork;
+			}
+			if (uTemp>=16U) {
+				memory_set(pOutput,uFill,uTemp);	// Perform the fill
+				pOutput+=uTemp;
+			} else {
 				do {
 					pOutput[0] = uFill;		// Perform the fill
 					++pOutput;
 				} while (--uTemp);
+			}
+		} else {
+			++uTemp;						// +1 to the count
+			if (uOutputLength<uTemp) {		// Too large?
+				break;
+			}
+			uOutputLength = uOutputLength-uTemp;	// Remove from count
+			uintptr_t uAvailable = static_cast<uintptr_t>(pEnd-pWork);
+			if (uAvailable<uTemp) {
+				memory_copy(pOutput,pWork,uAvailable);
+				memory_clear(pOutput+uAvailable,uTemp-uAvailable);
+				pWork = pEnd;
+			} else if (uTemp>=16U) {
+				memory_copy(pOutput,pWork,uTemp);
+				pWork+=uTemp;
 			} else {
-				++uTemp;						// +1 to the count
-				if (uOutputLength<uTemp) {		// Too large?
-					break;
-				}
-				uOutputLength = uOutputLength-uTemp;	// Remove from count
-				pInput->Get(pOutput,uTemp);
-				pOutput+=uTemp;
+				uint_t i = 0;
+				do {
+					pOutput[i] = pWork[i];
+				} while (++i<uTemp);
+				pWork+=uTemp;
 			}
-		} while (uOutputLength);	// More?
-		if (uOutputLength) {
-			return "Data overrun in packed ILBM data.";
+			pOutput+=uTemp;
 		}
 	}
-	return NULL;		// Return the current data pointer
+	pInputUsed[0] = static_cast<uintptr_t>(pWork-pInput);
+	if (uOutputLength) {
+		return "Data overrun in packed ILBM data.";
+	}
+	return NULL;
+}
+
+/*! ************************************
+
+	\brief Unpack data using ILBM compression
+
+	\param pOutput Buffer to accept the decompressed data
+	\param uOutputLength Length of the buffer for decompressed data
+	\param pInput Data stream to read compressed data from
+	\return \ref NULL if success or a pointer to a string describing the error
+	\sa UnpackILBMData(uint8_t *,uintptr_t,const uint8_t *,uintptr_t,uintptr_t *)
+
+***************************************/
+
+const char * BURGER_API Burger::FileLBM::UnpackILBMData(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput)
+{
+	uintptr_t uUsed;
+	const char *pBadNews = UnpackILBMData(pOutput,uOutputLength,pInput->GetPtr(),pInput->BytesRemaining(),&uUsed);
+	pInput->SkipForward(uUsed);
+	return pBadNews;
 }
 
 /*! ************************************
 
 	\brief Unpack bit planed data
 	
-	Supports 8 and 24 bit data
+	Supports 1 through 8 and 24 bit data. Each group of 8 bit planes is
+	converted to 8 bit pixels, 8 pixels at a time, by transposing the 8x8
+	matrix of bits held in a 64 bit integer.
 
 	\param pOutput Buffer to accept the decompressed data
 	\param uWidth Width of the image in pixels
@@ -138,54 +201,73 @@ const char * BURGER_API Burger::FileLBM::UnpackILBMData(uint8_t *pOutput,uintptr
 const char * BURGER_API Burger::FileLBM::UnpackILBM(uint8_t *pOutput,uint_t uWidth,uint_t uHeight,uint_t uDepth,InputMemoryStream *pInput)
 {
 	uint_t uBytesPerPixel = (uDepth+7U)>>3U;
-	uint8_t *pTempLineBuffer = static_cast<uint8_t *>(allocate_memory((uWidth+16)*uBytesPerPixel));	// Buffer to deinterleave memory
+	uint_t uPlaneStep = ((uWidth+15U)&(~15U))>>3U;		// Number of bytes per plane (Padded to short)
+	uint8_t *pTempLineBuffer = static_cast<uint8_t *>(allocate_memory(uPlaneStep*uDepth));	// Buffer to deinterleave memory
 	if (!pTempLineBuffer) {			// Error (How!!)
 		return "Out of memory.";
 	}
-	uint_t uPlaneStep = ((uWidth+15U)&(~15U))>>3U;		// Number of bytes per plane (Padded to short)
-	uWidth = uWidth*uBytesPerPixel;
+
+	const uint8_t *pSource = pInput->GetPtr();
+	const uint8_t *pEnd = pSource+pInput->BytesRemaining();
 	const char *pBadNews = NULL;
 	do {
 		// Decompress all of the bit planes (4, 8 or 24)
-		pBadNews = UnpackILBMData(pTempLineBuffer,uPlaneStep*uDepth,pInput);
+		uintptr_t uUsed;
+		pBadNews = UnpackILBMData(pTempLineBuffer,uPlaneStep*uDepth,pSource,static_cast<uintptr_t>(pEnd-pSource),&uUsed);
+		pSource+=uUsed;
 		if (pBadNews) {		// Error?
 			break;			// Exit
 		}
 
-		// Merge the planes
-		memory_clear(pOutput,uWidth);	// Clear out the old line
+		// Merge the planes, 8 planes and 8 pixels at a time
 		uint_t uPlaneIndex = 0;			// Start at the first bit plane
-		uint_t uPlaneMask = 1;			// Init dest mask
 		do {
-			uint_t j = uPlaneIndex>>3U;			// Init dest index
-			uint_t i = uPlaneStep*uPlaneIndex;
-			uint_t uBitMask = 0;
-			uint_t uInput = 0;
+			uint_t uPlanes = uDepth-uPlaneIndex;
+			if (uPlanes>8) {
+				uPlanes = 8;
+			}
+			const uint8_t *pPlanes = pTempLineBuffer+(uPlaneStep*uPlaneIndex);
+			uint8_t *pDest = pOutput+(uPlaneIndex>>3U);
+			uint_t uX = 0;
+			uint_t uColumn = 0;
 			do {
-				if (!uBitMask) {		// Mask needs to be set?
-					uInput = pTempLineBuffer[i];	// Get a source byte
-					++i;
-					uBitMask = 0x80U;	// Reset the mask
-				}
-				if (uBitMask&uInput) {	// Shall I convert it?
-					pOutput[j] |= static_cast<uint8_t>(uPlaneMask);	// Save it
+				// Byte n holds 8 pixels of plane n
+				uint64_t uBits = 0;
+				uint_t i = 0;
+				do {
+					uBits |= static_cast<uint64_t>(pPlanes[(uPlaneStep*i)+uColumn])<<(i*8U);
+				} while (++i<uPlanes);
+
+				// Transpose, so byte n holds the pixel of bit n
+				uint64_t uTemp = (uBits^(uBits>>7U))&0x00AA00AA00AA00AAULL;
+				uBits ^= uTemp^(uTemp<<7U);
+				uTemp = (uBits^(uBits>>14U))&0x0000CCCC0000CCCCULL;
+				uBits ^= uTemp^(uTemp<<14U);
+				uTemp = (uBits^(uBits>>28U))&0x00000000F0F0F0F0ULL;
+				uBits ^= uTemp^(uTemp<<28U);
+
+				// The high bit of each plane byte is the leftmost pixel
+				uint_t uCount = uWidth-uX;
+				if (uCount>8) {
+					uCount = 8;
 				}
-				uBitMask>>=1U;		// Adjust the mask
-				j+=uBytesPerPixel;
-			} while(j<uWidth);	// At the end?
-			uPlaneMask = uPlaneMask<<1;
-			if (uPlaneMask>=256) {	// If 24 bit, then I need to loop the dest mask
-				uPlaneMask = 1;
-			}
-		} while (++uPlaneIndex<uDepth);	// All 8 bit planes done?
-		pOutput=pOutput+uWidth;			// Next line down please
+				i = 0;
+				do {
+					pDest[0] = static_cast<uint8_t>(uBits>>(56U-(i*8U)));
+					pDest+=uBytesPerPixel;
+				} while (++i<uCount);
+				uX+=8;
+				++uColumn;
+			} while (uX<uWidth);
+			uPlaneIndex+=8;
+		} while (uPlaneIndex<uDepth);	// All bit planes done?
+		pOutput=pOutput+(uWidth*uBytesPerPixel);	// Next line down please
 	} while (--uHeight);
-
+	pInput->SkipForward(static_cast<uintptr_t>(pSource-pInput->GetPtr()));
 	free_memory(pTempLineBuffer);		// Release the line buffer
 	return pBadNews;			// Return error code if any
 }
 
-
 /*! ************************************
 
 	\brief Scan an AIFF file in memory and return pointer to a chunk
@@ -288,7 +370,7 @@ Burger::Image * Burger::FileLBM::Load(InputMemoryStream *pInput)
 				pBadNews = "Height can't be zero.";
 			} else if (!uDepth) {
 				pBadNews = "Can't process anything but 8 or 24 bit color images.";
-			} else if (uDepth > 9) {
+			} else if (uDepth > 8) {
 				if (uDepth!=24) {
 					pBadNews = "Can't process anything but 8 or 24 bit color images.";		// Not 8 or 24 bit!
 				} else if (FormType) {
@@ -332,7 +414,7 @@ Burger::Image * Burger::FileLBM::Load(InputMemoryStream *pInput)
 			if (FormType) {
 				pImage = Image::new_object(uWidth,uHeight,Image::PIXELTYPE8BIT);
 				if (pImage) {
-					pBadNews = UnpackILBMData(pImage->GetImage(),(uint32_t)uWidth*uHeight,pInput);
+					pBadNews = UnpackILBMData(pImage->GetImage(),static_cast<uintptr_t>(uWidth)*uHeight,pInput);
 				}
 			} else {
 				if (uDepth==24) {
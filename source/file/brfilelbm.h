@@ -40,6 +40,7 @@ namespace Burger {
 class FileLBM {
 	RGBAWord8_t m_Palette[256];		///< Palette found in the image
 public:
+	static const char * BURGER_API UnpackILBMData(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength,uintptr_t *pInputUsed);
 	static const char * BURGER_API UnpackILBMData(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput);
 	static const char * BURGER_API UnpackILBM(uint8_t *pOutput,uint_t uWidth,uint_t uHeight,uint_t uDepth,InputMemoryStream *pInput);
 	static const char * BURGER_API SeekIffChunk(InputMemoryStream *pInput,uint32_t uID,uintptr_t uStartOffset);
@@ -69,40 +69,93 @@ struct PCXHeader {
 	to fix a bug in the data overrun buffer. Debabelizer can write out bad
 	PCX files when the width is odd.
 
+	The data is read directly from memory instead of a byte at a time from
+	the stream. Runs are at most 63 bytes long, so they are filled with a
+	simple loop. Missing data is zero filled.
+
 	\param pOutput Buffer to accept the decompressed data
 	\param uOutputLength Length of the buffer for decompressed data
-	\param pInput Data stream to read compressed data from
+	\param pInput Pointer to the compressed data
+	\param uInputLength Number of bytes of compressed data
+	\param pInputUsed Pointer to receive the number of bytes consumed
 	\return \ref NULL if success or a pointer to a string describing the error
+	\sa DecompressPCX(uint8_t *,uintptr_t,InputMemoryStream *)
 
 ***************************************/
 
-const char * BURGER_API Burger::FilePCX::DecompressPCX(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput)
+const char * BURGER_API Burger::FilePCX::DecompressPCX(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength,uintptr_t *pInputUsed)
 {
-	if (uOutputLength) {
-		do {
-			uint_t uTemp = pInput->GetByte();		// Fetch byte from input stream
-			if (uTemp<0xC0) {					// Unpacked data?
-				pOutput[0] = static_cast<uint8_t>(uTemp);	// Save byte
-				++pOutput;
-				--uOutputLength;				// Count down the length
-			} else {
-				uTemp = uTemp&0x3F;		// Mask count
-				if (uTemp) {			// Was it not 0xC0?
-					if (uTemp>uOutputLength) {				// Overrun buffer?
-						return "PCX decompresser overrun\n";
-					}
-
-					uint8_t uFill = pInput->GetByte();		// Get fill byte
-					uOutputLength = uOutputLength-uTemp;	// Adjust length
-					do {
-						pOutput[0] = uFill;	// Memory fill
-						++pOutput;
-					} while (--uTemp);		// Count down
+	const char *pBadNews = NULL;
+	const uint8_t *pWork = pInput;
+	const uint8_t *pEnd = pInput+uInputLength;
+	while (uOutputLength) {
+		if (pWork>=pEnd) {
+			// Missing data reads as zeros
+			memory_clear(pOutput,uOutputLength);
+			break;
+		}
+		uint_t uTemp = pWork[0];		// Fetch byte from input stream
+		++pWork;
+		if (uTemp<0xC0) {					// Unpacked data?
+			// Store unpacked bytes until a run token appears
+			const uint8_t *pLiteral = pWork-1;
+			uintptr_t uMaximum = static_cast<uintptr_t>(pEnd-pLiteral);
+			if (uMaximum>uOutputLength) {
+				uMaximum = uOutputLength;
+			}
+			uintptr_t uCount = 0;
+			do {
+				pOutput[uCount] = static_cast<uint8_t>(uTemp);	// Save byte
+				if (++uCount>=uMaximum) {
+					break;
+				}
+				uTemp = pLiteral[uCount];
+			} while (uTemp<0xC0);
+			pOutput+=uCount;
+			pWork = pLiteral+uCount;
+			uOutputLength-=uCount;				// Count down the length
+		} else {
+			uTemp = uTemp&0x3F;		// Mask count
+			if (uTemp) {			// Was it not 0xC0?
+				if (uTemp>uOutputLength) {				// Overrun buffer?
+					pBadNews = "PCX decompresser overrun\n";
+					break;
+				}
+				uint8_t uFill = 0;
+				if (pWork<pEnd) {
+					uFill = pWork[0];		// Get fill byte
+					++pWork;
 				}
+				uOutputLength = uOutputLength-uTemp;	// Adjust length
+				do {
+					pOutput[0] = uFill;	// Memory fill
+					++pOutput;
+				} while (--uTemp);		// Count down
 			}
-		} while (uOutputLength);		// More?
+		}
 	}
-	return NULL;		/* Return input stream pointer */
+	pInputUsed[0] = static_cast<uintptr_t>(pWork-pInput);
+	return pBadNews;
+}
+
+/*! ************************************
+
+	\brief Decompress PCX bitmap data
+
+	\param pOutput Buffer to accept the decompressed data
+	\param uOutputLength Length of the buffer for decompressed data
+	\param pInput Data stream to read compressed data from
+	\return \ref NULL if success or a pointer to a string describing the error
+	\sa DecompressPCX(uint8_t *,uintptr_t,const uint8_t *,uintptr_t,uintptr_t *)
+
+***************************************/
+
+const char * BURGER_API Burger::FilePCX::DecompressPCX(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput)
+{
+	uintptr_t uUsed;
+	const char *pBadNews = DecompressPCX(pOutput,uOutputLength,pInput->GetPtr(),pInput->BytesRemaining(),&uUsed);
+	pInput->SkipForward(uUsed);
+	return pBadNews;
 }
 
 /*! ************************************
@@ -113,6 +166,7 @@ const char * BURGER_API Burger::FilePCX::DecompressPCX(uint8_t *pOutput,uintptr_
 	red pixels, followed by a line of green and then blue.
 
 	This function will merge the three into a strip of RGB triplets
+	using Image::Interleave3Planes()
 
 	\param pOutput Buffer to receive the RGB triplets
 	\param pInput Buffer containing three strips of Red, Green and Blue pixels
@@ -122,14 +176,7 @@ const char * BURGER_API Burger::FilePCX::DecompressPCX(uint8_t *pOutput,uintptr_
 
 void BURGER_API Burger::FilePCX::Merge3Planes(uint8_t *pOutput,const uint8_t *pInput,uintptr_t uWidth)
 {
-	uintptr_t i = uWidth;
-	do {
-		pOutput[0] = pInput[0];
-		pOutput[1] = pInput[uWidth];
-		pOutput[2] = pInput[uWidth*2];
-		pOutput+=3;
-		++pInput;
-	} while (--i);
+	Image::Interleave3Planes(pOutput,pInput,pInput+uWidth,pInput+(uWidth*2),uWidth);
 }
 
 /*! ************************************
@@ -223,19 +270,40 @@ Burger::Image * Burger::FilePCX::Load(InputMemoryStream *pInput)
 
 	if (!pBadNews) {
 
+		// Decompress straight from the stream's memory
+		const uint8_t *pSource = pInput->GetPtr();
+		const uint8_t *pEnd = pSource+pInput->BytesRemaining();
+		uintptr_t uUsed;
+
 		// Handle the 8 bit paletted image
 
 		if (uBitPlanes==1) {
 			pImage = Image::new_object(uWidth,uHeight,Image::PIXELTYPE8BIT);
 			if (pImage) {
-				uint8_t *pDest = pImage->GetImage();
-				do {
-					pBadNews = DecompressPCX(pDest,uBytesPerLine,pInput);
-					if (pBadNews) {
-						break;
+				// Odd widths have a pad byte that doesn't fit in the image
+				uint8_t *pTempBuffer = NULL;
+				if (uBytesPerLine!=uWidth) {
+					pTempBuffer = static_cast<uint8_t *>(allocate_memory(uBytesPerLine));
+					if (!pTempBuffer) {
+						pBadNews = "Out of memory.";
 					}
-					pDest+=pImage->GetStride();
-				} while (--uHeight);
+				}
+				if (!pBadNews) {
+					uint8_t *pDest = pImage->GetImage();
+					do {
+						pBadNews = DecompressPCX(pTempBuffer ? pTempBuffer : pDest,uBytesPerLine,pSource,static_cast<uintptr_t>(pEnd-pSource),&uUsed);
+						pSource+=uUsed;
+						if (pBadNews) {
+							break;
+						}
+						if (pTempBuffer) {
+							memory_copy(pDest,pTempBuffer,uWidth);
+						}
+						pDest+=pImage->GetStride();
+					} while (--uHeight);
+					free_memory(pTempBuffer);
+				}
+				pInput->SkipForward(static_cast<uintptr_t>(pSource-pInput->GetPtr()));
 			
 				// Let's parse out the palette!
 
@@ -274,31 +342,28 @@ Burger::Image * Burger::FilePCX::Load(InputMemoryStream *pInput)
 			if (pImage) {
 				// Allocate the temp buffer here to reduce the chance
 				// of memory fragmentation
-				// Note: Added 32 to the buffer size to prevent buffer overruns
-				uint8_t *pTempBuffer = static_cast<uint8_t *>(allocate_memory(uWidth*3+32));
+				uint8_t *pTempBuffer = static_cast<uint8_t *>(allocate_memory(uBytesPerLine*3));
 				if (!pTempBuffer) {
 					pBadNews = "Out of memory.";
 				} else {
 					uint8_t *pDest = pImage->GetImage();
 					do {
-						pBadNews = DecompressPCX(pTempBuffer,uBytesPerLine,pInput);
-						if (pBadNews) {
-							break;
-						}
-						pBadNews = DecompressPCX(pTempBuffer+uWidth,uBytesPerLine,pInput);
-						if (pBadNews) {
-							break;
-						}
-						pBadNews = DecompressPCX(pTempBuffer+uWidth*2,uBytesPerLine,pInput);
+						// Decompress the red, green and blue planes
+						uint_t uPlane = 0;
+						do {
+							pBadNews = DecompressPCX(pTempBuffer+(uBytesPerLine*uPlane),uBytesPerLine,pSource,static_cast<uintptr_t>(pEnd-pSource),&uUsed);
+							pSource+=uUsed;
+						} while (!pBadNews && (++uPlane<3));
 						if (pBadNews) {
 							break;
 						}
 						// Merge the bit planes
-						Merge3Planes(pDest,pTempBuffer,uWidth);
+						Image::Interleave3Planes(pDest,pTempBuffer,pTempBuffer+uBytesPerLine,pTempBuffer+(uBytesPerLine*2),uWidth);
 						pDest+=pImage->GetStride();
 					} while (--uHeight);
 					// Release the temp buffer
 					free_memory(pTempBuffer);
+					pInput->SkipForward(static_cast<uintptr_t>(pSource-pInput->GetPtr()));
 				}
 			}
 		}
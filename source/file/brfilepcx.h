@@ -43,6 +43,7 @@ class FilePCX {
 	RGBAWord8_t m_Palette[256];		///< Palette found in the image
 	uint8_t m_EGAPalette[48];			///< EGA palette
 public:
+	static const char * BURGER_API DecompressPCX(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength,uintptr_t *pInputUsed);
 	static const char * BURGER_API DecompressPCX(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput);
 	static void BURGER_API Merge3Planes(uint8_t *pOutput,const uint8_t *pInput,uintptr_t uWidth);
 	enum {
@@ -14,9 +14,20 @@
 
 #include "brfilepng.h"
 #include "brdebug.h"
-#include "brdecompressdeflate.h"
 #include "brfixedpoint.h"
 #include "brmemoryfunctions.h"
+#include "bradler32.h"
+#include "brcompressdeflate.h"
+#include "brcrc32.h"
+#include "brthread.h"
+
+#if defined(BURGER_SSE2) && defined(BURGER_INTEL) && !defined(DOXYGEN)
+#define USE_SSE2
+#include <emmintrin.h>
+#elif defined(BURGER_NEON) && defined(BURGER_ARM64) && !defined(DOXYGEN)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
 
 #if defined(BURGER_WATCOM)
 // Disable 'sizeof' operand contains compiler generated information
@@ -31,8 +42,52 @@
 	This class will read and write out PNG files and use Burger::Image
 	class instances as data transporters
 
+	Images can be loaded from memory with Load() or decoded as the file
+	arrives with StartStream() and ProcessStream(). Both progressive and
+	Adam7 interlaced images are supported.
+
+***************************************/
+
+/*! ************************************
+
+	\typedef Burger::FilePNG::RowProc_t
+	\brief Function called for every decoded row
+
+	When streaming, this function is called as soon as each row is
+	unfiltered. For progressive images, uPass is zero and pRow is a complete
+	row of the image. For Adam7 images, uPass is 1 through 7 and pRow only
+	contains the pixels of that pass, which belong at the columns
+	s_Adam7Passes[uPass-1].m_uXStart+(n*s_Adam7Passes[uPass-1].m_uXStep).
+
+	\param pData Pointer passed to StartStream()
+	\param pRow Pointer to the unfiltered pixels
+	\param uY Row in the image the pixels belong to
+	\param uPass Zero for progressive images or the Adam7 pass (1-7)
+
+***************************************/
+
+/*! ************************************
+
+	\struct Burger::FilePNG::Adam7Pass_t
+	\brief Description of an Adam7 interlace pass
+
+	\sa FilePNG::s_Adam7Passes
+
 ***************************************/
 
+/*! ************************************
+
+	\brief Adam7 interlace pattern
+
+	Adam7 images store seven reduced images, each one made from the pixels
+	at (m_uXStart+(x*m_uXStep),m_uYStart+(y*m_uYStep)).
+
+***************************************/
+
+const Burger::FilePNG::Adam7Pass_t Burger::FilePNG::s_Adam7Passes[7] = {
+	{0,0,8,8},{4,0,8,8},{0,4,4,8},{2,0,4,4},{0,2,2,4},{1,0,2,2},{0,1,1,2}
+};
+
 //
 // Header of a PNG file (Big Endian, 8 bytes)
 //
@@ -61,6 +116,577 @@ struct IHDRHeader {		// IHDR record
 
 static const uint8_t g_Signature[8] = { 0x89,0x50,0x4E,0x47,0x0D,0x0A,0x1A,0x0A };
 
+//
+// Read a big endian 32 bit value from an unaligned pointer
+//
+
+static BURGER_INLINE uint32_t PNGGetBig32(const uint8_t *pInput)
+{
+	return (static_cast<uint32_t>(pInput[0])<<24U)|(static_cast<uint32_t>(pInput[1])<<16U)|
+		(static_cast<uint32_t>(pInput[2])<<8U)|static_cast<uint32_t>(pInput[3]);
+}
+
+#if defined(USE_SSE2) || defined(USE_NEON)
+
+//
+// Load and store a 3 or 4 byte pixel as the low bytes of a 32 bit value
+//
+
+static BURGER_INLINE uint32_t PNGLoadPixel(const uint8_t *pInput,uint_t uBytesPerPixel)
+{
+	uint32_t uResult = static_cast<uint32_t>(pInput[0])|(static_cast<uint32_t>(pInput[1])<<8U)|
+		(static_cast<uint32_t>(pInput[2])<<16U);
+	if (uBytesPerPixel==4) {
+		uResult |= static_cast<uint32_t>(pInput[3])<<24U;
+	}
+	return uResult;
+}
+
+static BURGER_INLINE void PNGStorePixel(uint8_t *pOutput,uint32_t uInput,uint_t uBytesPerPixel)
+{
+	pOutput[0] = static_cast<uint8_t>(uInput);
+	pOutput[1] = static_cast<uint8_t>(uInput>>8U);
+	pOutput[2] = static_cast<uint8_t>(uInput>>16U);
+	if (uBytesPerPixel==4) {
+		pOutput[3] = static_cast<uint8_t>(uInput>>24U);
+	}
+}
+#endif
+
+#if defined(USE_SSE2)
+
+//
+// Helpers for the 16 bit Paeth predictor
+//
+
+static BURGER_INLINE __m128i PNGLoadPixelSSE(const uint8_t *pInput,uint_t uBytesPerPixel)
+{
+	return _mm_cvtsi32_si128(static_cast<int>(PNGLoadPixel(pInput,uBytesPerPixel)));
+}
+
+static BURGER_INLINE __m128i PNGAbsolute16(__m128i vInput)
+{
+	return _mm_max_epi16(vInput,_mm_sub_epi16(_mm_setzero_si128(),vInput));
+}
+
+static BURGER_INLINE __m128i PNGSelect(__m128i vMask,__m128i vTrue,__m128i vFalse)
+{
+	return _mm_or_si128(_mm_and_si128(vMask,vTrue),_mm_andnot_si128(vMask,vFalse));
+}
+
+//
+// Paeth predictor of eight 16 bit samples, ties favor left, then above,
+// then above left
+//
+
+static BURGER_INLINE __m128i PNGPaeth16(__m128i vLeft,__m128i vUp,__m128i vUpLeft)
+{
+	__m128i vP = _mm_sub_epi16(vUp,vUpLeft);
+	__m128i vPC = _mm_sub_epi16(vLeft,vUpLeft);
+	__m128i vPA = PNGAbsolute16(vP);
+	__m128i vPB = PNGAbsolute16(vPC);
+	vPC = PNGAbsolute16(_mm_add_epi16(vP,vPC));
+	__m128i vSmallest = _mm_min_epi16(vPC,_mm_min_epi16(vPA,vPB));
+	__m128i vNearest = PNGSelect(_mm_cmpeq_epi16(vSmallest,vPB),vUp,vUpLeft);
+	return PNGSelect(_mm_cmpeq_epi16(vSmallest,vPA),vLeft,vNearest);
+}
+
+#elif defined(USE_NEON)
+
+static BURGER_INLINE uint8x8_t PNGLoadPixelNEON(const uint8_t *pInput,uint_t uBytesPerPixel)
+{
+	return vcreate_u8(PNGLoadPixel(pInput,uBytesPerPixel));
+}
+
+static BURGER_INLINE void PNGStorePixelNEON(uint8_t *pOutput,uint8x8_t vInput,uint_t uBytesPerPixel)
+{
+	PNGStorePixel(pOutput,vget_lane_u32(vreinterpret_u32_u8(vInput),0),uBytesPerPixel);
+}
+
+//
+// Paeth predictor of eight samples, ties favor left, then above, then
+// above left
+//
+
+static BURGER_INLINE uint8x8_t PNGPaethNEON(uint8x8_t vLeft,uint8x8_t vUp,uint8x8_t vUpLeft)
+{
+	uint16x8_t vPA = vabdl_u8(vUp,vUpLeft);
+	uint16x8_t vPB = vabdl_u8(vLeft,vUpLeft);
+	uint16x8_t vPC = vabdq_u16(vaddl_u8(vLeft,vUp),vaddl_u8(vUpLeft,vUpLeft));
+	uint8x8_t vUseLeft = vmovn_u16(vandq_u16(vcleq_u16(vPA,vPB),vcleq_u16(vPA,vPC)));
+	uint8x8_t vUseUp = vmovn_u16(vcleq_u16(vPB,vPC));
+	return vbsl_u8(vUseLeft,vLeft,vbsl_u8(vUseUp,vUp,vUpLeft));
+}
+
+#endif
+
+//
+// Filter type 1, add the pixel to the left
+//
+
+static void BURGER_API PNGUnfilterSub(uint8_t *pOutput,const uint8_t *pInput,uintptr_t uLength,uint_t uBytesPerPixel)
+{
+#if defined(USE_SSE2)
+	if ((uBytesPerPixel==3) || (uBytesPerPixel==4)) {
+		__m128i vLeft = _mm_setzero_si128();
+		do {
+			vLeft = _mm_add_epi8(vLeft,PNGLoadPixelSSE(pInput,uBytesPerPixel));
+			PNGStorePixel(pOutput,static_cast<uint32_t>(_mm_cvtsi128_si32(vLeft)),uBytesPerPixel);
+			pInput += uBytesPerPixel;
+			pOutput += uBytesPerPixel;
+		} while ((uLength-=uBytesPerPixel)!=0);
+		return;
+	}
+#elif defined(USE_NEON)
+	if ((uBytesPerPixel==3) || (uBytesPerPixel==4)) {
+		uint8x8_t vLeft = vdup_n_u8(0);
+		do {
+			vLeft = vadd_u8(vLeft,PNGLoadPixelNEON(pInput,uBytesPerPixel));
+			PNGStorePixelNEON(pOutput,vLeft,uBytesPerPixel);
+			pInput += uBytesPerPixel;
+			pOutput += uBytesPerPixel;
+		} while ((uLength-=uBytesPerPixel)!=0);
+		return;
+	}
+#endif
+	uintptr_t i = 0;
+	do {
+		pOutput[i] = pInput[i];
+	} while (++i<uBytesPerPixel);
+	while (i<uLength) {
+		pOutput[i] = static_cast<uint8_t>(pInput[i]+pOutput[i-uBytesPerPixel]);
+		++i;
+	}
+}
+
+//
+// Filter type 2, add the pixel above
+//
+
+static void BURGER_API PNGUnfilterUp(uint8_t *pOutput,const uint8_t *pInput,const uint8_t *pPrevious,uintptr_t uLength)
+{
+#if defined(USE_SSE2)
+	while (uLength>=16) {
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput),
+			_mm_add_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput)),
+			_mm_loadu_si128(reinterpret_cast<const __m128i *>(pPrevious))));
+		pOutput += 16;
+		pInput += 16;
+		pPrevious += 16;
+		uLength -= 16;
+	}
+#elif defined(USE_NEON)
+	while (uLength>=16) {
+		vst1q_u8(pOutput,vaddq_u8(vld1q_u8(pInput),vld1q_u8(pPrevious)));
+		pOutput += 16;
+		pInput += 16;
+		pPrevious += 16;
+		uLength -= 16;
+	}
+#endif
+	while (uLength) {
+		pOutput[0] = static_cast<uint8_t>(pInput[0]+pPrevious[0]);
+		++pOutput;
+		++pInput;
+		++pPrevious;
+		--uLength;
+	}
+}
+
+//
+// Filter type 3, add the average of the pixels to the left and above
+//
+
+static void BURGER_API PNGUnfilterAverage(uint8_t *pOutput,const uint8_t *pInput,const uint8_t *pPrevious,uintptr_t uLength,uint_t uBytesPerPixel)
+{
+#if defined(USE_SSE2)
+	if ((uBytesPerPixel==3) || (uBytesPerPixel==4)) {
+		// _mm_avg_epu8() rounds up, remove the carry to round down
+		const __m128i vOne = _mm_set1_epi8(1);
+		__m128i vLeft = _mm_setzero_si128();
+		do {
+			__m128i vUp = PNGLoadPixelSSE(pPrevious,uBytesPerPixel);
+			__m128i vAverage = _mm_sub_epi8(_mm_avg_epu8(vLeft,vUp),_mm_and_si128(_mm_xor_si128(vLeft,vUp),vOne));
+			vLeft = _mm_add_epi8(vAverage,PNGLoadPixelSSE(pInput,uBytesPerPixel));
+			PNGStorePixel(pOutput,static_cast<uint32_t>(_mm_cvtsi128_si32(vLeft)),uBytesPerPixel);
+			pInput += uBytesPerPixel;
+			pPrevious += uBytesPerPixel;
+			pOutput += uBytesPerPixel;
+		} while ((uLength-=uBytesPerPixel)!=0);
+		return;
+	}
+#elif defined(USE_NEON)
+	if ((uBytesPerPixel==3) || (uBytesPerPixel==4)) {
+		uint8x8_t vLeft = vdup_n_u8(0);
+		do {
+			vLeft = vadd_u8(vhadd_u8(vLeft,PNGLoadPixelNEON(pPrevious,uBytesPerPixel)),PNGLoadPixelNEON(pInput,uBytesPerPixel));
+			PNGStorePixelNEON(pOutput,vLeft,uBytesPerPixel);
+			pInput += uBytesPerPixel;
+			pPrevious += uBytesPerPixel;
+			pOutput += uBytesPerPixel;
+		} while ((uLength-=uBytesPerPixel)!=0);
+		return;
+	}
+#endif
+	uintptr_t i = 0;
+	do {
+		pOutput[i] = static_cast<uint8_t>(pInput[i]+(pPrevious[i]>>1U));
+	} while (++i<uBytesPerPixel);
+	while (i<uLength) {
+		pOutput[i] = static_cast<uint8_t>(pInput[i]+((pPrevious[i]+pOutput[i-uBytesPerPixel])>>1U));
+		++i;
+	}
+}
+
+//
+// Filter type 4, add the Paeth predictor of the pixels to the left, above
+// and above left
+//
+
+static void BURGER_API PNGUnfilterPaeth(uint8_t *pOutput,const uint8_t *pInput,const uint8_t *pPrevious,uintptr_t uLength,uint_t uBytesPerPixel)
+{
+#if defined(USE_SSE2)
+	if ((uBytesPerPixel==3) || (uBytesPerPixel==4)) {
+		// Work in 16 bits so the differences don't overflow
+		const __m128i vZero = _mm_setzero_si128();
+		const __m128i vMask = _mm_set1_epi16(0xFF);
+		__m128i vLeft = vZero;
+		__m128i vUpLeft = vZero;
+		do {
+			__m128i vUp = _mm_unpacklo_epi8(PNGLoadPixelSSE(pPrevious,uBytesPerPixel),vZero);
+			__m128i vNearest = PNGPaeth16(vLeft,vUp,vUpLeft);
+			vLeft = _mm_and_si128(_mm_add_epi16(vNearest,_mm_unpacklo_epi8(PNGLoadPixelSSE(pInput,uBytesPerPixel),vZero)),vMask);
+			PNGStorePixel(pOutput,static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(vLeft,vLeft))),uBytesPerPixel);
+			vUpLeft = vUp;
+			pInput += uBytesPerPixel;
+			pPrevious += uBytesPerPixel;
+			pOutput += uBytesPerPixel;
+		} while ((uLength-=uBytesPerPixel)!=0);
+		return;
+	}
+#elif defined(USE_NEON)
+	if ((uBytesPerPixel==3) || (uBytesPerPixel==4)) {
+		uint8x8_t vLeft = vdup_n_u8(0);
+		uint8x8_t vUpLeft = vLeft;
+		do {
+			uint8x8_t vUp = PNGLoadPixelNEON(pPrevious,uBytesPerPixel);
+			vLeft = vadd_u8(PNGPaethNEON(vLeft,vUp,vUpLeft),PNGLoadPixelNEON(pInput,uBytesPerPixel));
+			PNGStorePixelNEON(pOutput,vLeft,uBytesPerPixel);
+			vUpLeft = vUp;
+			pInput += uBytesPerPixel;
+			pPrevious += uBytesPerPixel;
+			pOutput += uBytesPerPixel;
+		} while ((uLength-=uBytesPerPixel)!=0);
+		return;
+	}
+#endif
+	uintptr_t i = 0;
+	do {
+		pOutput[i] = static_cast<uint8_t>(pInput[i]+pPrevious[i]);
+	} while (++i<uBytesPerPixel);
+	while (i<uLength) {
+		int32_t a = pOutput[i-uBytesPerPixel];
+		int32_t b = pPrevious[i];
+		int32_t c = pPrevious[i-uBytesPerPixel];
+		int32_t p = b - c;
+		int32_t pc = a - c;
+
+		int32_t pa = Burger::absolute(p);
+		int32_t pb = Burger::absolute(pc);
+		pc = Burger::absolute(p + pc);
+
+		// Find the best predictor, the least of pa, pb, pc favoring the earlier
+		// ones in the case of a tie.
+
+		if (pb < pa) {
+			pa = pb;
+			a = b;
+		}
+		if (pc < pa) {
+			a = c;
+		}
+		pOutput[i] = static_cast<uint8_t>(a+pInput[i]);
+		++i;
+	}
+}
+
+//
+// Copy the pixels of an Adam7 pass row into their columns in the image
+//
+
+static void BURGER_API PNGScatterPass(uint8_t *pOutput,const uint8_t *pInput,uint_t uCount,uint_t uXStep,uint_t uBytesPerPixel)
+{
+	uintptr_t uStep = static_cast<uintptr_t>(uXStep)*uBytesPerPixel;
+	switch (uBytesPerPixel) {
+	case 1:
+		do {
+			pOutput[0] = pInput[0];
+			++pInput;
+			pOutput += uStep;
+		} while (--uCount);
+		break;
+	case 3:
+		do {
+			pOutput[0] = pInput[0];
+			pOutput[1] = pInput[1];
+			pOutput[2] = pInput[2];
+			pInput += 3;
+			pOutput += uStep;
+		} while (--uCount);
+		break;
+	case 4:
+		do {
+			pOutput[0] = pInput[0];
+			pOutput[1] = pInput[1];
+			pOutput[2] = pInput[2];
+			pOutput[3] = pInput[3];
+			pInput += 4;
+			pOutput += uStep;
+		} while (--uCount);
+		break;
+	default:
+		do {
+			Burger::memory_copy(pOutput,pInput,uBytesPerPixel);
+			pInput += uBytesPerPixel;
+			pOutput += uStep;
+		} while (--uCount);
+		break;
+	}
+}
+
+//
+// Scalar predictor of one filter type for byte i of a row, the first pixel
+// has no left neighbor so those samples are passed as zero
+//
+
+static BURGER_INLINE uint_t PNGPredict(uint_t a,uint_t b,uint_t c,uint_t uFilter)
+{
+	switch (uFilter) {
+	case 1:
+		return a;
+	case 2:
+		return b;
+	case 3:
+		return (a+b)>>1U;
+	case 4: {
+		int32_t p = static_cast<int32_t>(b) - static_cast<int32_t>(c);
+		int32_t pc = static_cast<int32_t>(a) - static_cast<int32_t>(c);
+		int32_t pa = Burger::absolute(p);
+		int32_t pb = Burger::absolute(pc);
+		pc = Burger::absolute(p + pc);
+		if (pb < pa) {
+			pa = pb;
+			a = b;
+		}
+		if (pc < pa) {
+			a = c;
+		}
+		return a;
+	}
+	default:
+		return 0;
+	}
+}
+
+//
+// Apply a filter to a row for saving and return the sum of the filtered
+// bytes taken as signed values. The smallest sum is usually the filter
+// that compresses the best.
+//
+
+static uintptr_t BURGER_API PNGFilterRow(uint8_t *pOutput,const uint8_t *pRow,const uint8_t *pPrevious,uintptr_t uLength,uint_t uBytesPerPixel,uint_t uFilter)
+{
+	uintptr_t uCost = 0;
+	uintptr_t i = 0;
+	do {
+		uint_t uValue = static_cast<uint8_t>(pRow[i]-PNGPredict(0,pPrevious[i],0,uFilter));
+		pOutput[i] = static_cast<uint8_t>(uValue);
+		uCost += (uValue<128U) ? uValue : (256U-uValue);
+	} while (++i<uBytesPerPixel);
+
+	// The rest of the row has left neighbors, so 16 bytes can be done at once
+#if defined(USE_SSE2)
+	if (uFilter && ((i+16U)<=uLength)) {
+		const __m128i vZero = _mm_setzero_si128();
+		__m128i vCost = vZero;
+		do {
+			__m128i vRow = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pRow+i));
+			__m128i vLeft = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pRow+i-uBytesPerPixel));
+			__m128i vPredict;
+			if (uFilter==1) {
+				vPredict = vLeft;
+			} else {
+				__m128i vUp = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pPrevious+i));
+				if (uFilter==2) {
+					vPredict = vUp;
+				} else if (uFilter==3) {
+					// _mm_avg_epu8() rounds up, remove the carry to round down
+					vPredict = _mm_sub_epi8(_mm_avg_epu8(vLeft,vUp),_mm_and_si128(_mm_xor_si128(vLeft,vUp),_mm_set1_epi8(1)));
+				} else {
+					__m128i vUpLeft = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pPrevious+i-uBytesPerPixel));
+					vPredict = _mm_packus_epi16(
+						PNGPaeth16(_mm_unpacklo_epi8(vLeft,vZero),_mm_unpacklo_epi8(vUp,vZero),_mm_unpacklo_epi8(vUpLeft,vZero)),
+						PNGPaeth16(_mm_unpackhi_epi8(vLeft,vZero),_mm_unpackhi_epi8(vUp,vZero),_mm_unpackhi_epi8(vUpLeft,vZero)));
+				}
+			}
+			__m128i vOutput = _mm_sub_epi8(vRow,vPredict);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput+i),vOutput);
+			// The smaller of x and -x as unsigned is the magnitude of x as signed
+			vCost = _mm_add_epi64(vCost,_mm_sad_epu8(_mm_min_epu8(vOutput,_mm_sub_epi8(vZero,vOutput)),vZero));
+			i += 16;
+		} while ((i+16U)<=uLength);
+		uCost += static_cast<uint32_t>(_mm_cvtsi128_si32(vCost))+static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(vCost,8)));
+	}
+#elif defined(USE_NEON)
+	if (uFilter && ((i+16U)<=uLength)) {
+		do {
+			uint8x16_t vRow = vld1q_u8(pRow+i);
+			uint8x16_t vLeft = vld1q_u8(pRow+i-uBytesPerPixel);
+			uint8x16_t vPredict;
+			if (uFilter==1) {
+				vPredict = vLeft;
+			} else {
+				uint8x16_t vUp = vld1q_u8(pPrevious+i);
+				if (uFilter==2) {
+					vPredict = vUp;
+				} else if (uFilter==3) {
+					vPredict = vhaddq_u8(vLeft,vUp);
+				} else {
+					uint8x16_t vUpLeft = vld1q_u8(pPrevious+i-uBytesPerPixel);
+					vPredict = vcombine_u8(PNGPaethNEON(vget_low_u8(vLeft),vget_low_u8(vUp),vget_low_u8(vUpLeft)),
+						PNGPaethNEON(vget_high_u8(vLeft),vget_high_u8(vUp),vget_high_u8(vUpLeft)));
+				}
+			}
+			uint8x16_t vOutput = vsubq_u8(vRow,vPredict);
+			vst1q_u8(pOutput+i,vOutput);
+			// The smaller of x and -x as unsigned is the magnitude of x as signed
+			uCost += vaddlvq_u8(vminq_u8(vOutput,vsubq_u8(vdupq_n_u8(0),vOutput)));
+			i += 16;
+		} while ((i+16U)<=uLength);
+	}
+#endif
+	while (i<uLength) {
+		uint_t uValue = static_cast<uint8_t>(pRow[i]-PNGPredict(pRow[i-uBytesPerPixel],pPrevious[i],pPrevious[i-uBytesPerPixel],uFilter));
+		pOutput[i] = static_cast<uint8_t>(uValue);
+		uCost += (uValue<128U) ? uValue : (256U-uValue);
+		++i;
+	}
+	return uCost;
+}
+
+//
+// Rows of the image given to one thread by FilePNG::Save()
+//
+
+static const uint_t kPNGMaxThreads = 16;
+static const uint_t kPNGMinBandRows = 16;
+
+struct PNGSaveJob_t {
+	const uint8_t *m_pRows;		// First row of the band
+	const uint8_t *m_pPrevious;	// Row above the band or NULL for the top of the image
+	uintptr_t m_uStride;			// Bytes between rows of the image
+	uintptr_t m_uRowBytes;			// Bytes of pixels in a row
+	uintptr_t m_uRawLength;			// Bytes passed to the compressor
+	Burger::CompressDeflate *m_pCompressor;	// Compressor for the band
+	uint_t m_uRowCount;				// Rows in the band
+	uint_t m_uBytesPerPixel;		// Bytes per pixel
+	uint_t m_uFilterMask;			// Bit mask of the filters to try
+	uint_t m_bLast;					// TRUE if the band ends the image
+	uint32_t m_uAdler;				// Adler-32 of the data if compressed without a header
+	uint_t m_uError;				// Non-zero if the band failed
+};
+
+//
+// Filter and compress the rows of a band. Each row is tried with every
+// allowed filter and the filter with the lowest cost is kept.
+//
+
+static uintptr_t BURGER_API PNGSaveBand(void *pData)
+{
+	PNGSaveJob_t *pJob = static_cast<PNGSaveJob_t *>(pData);
+	const uintptr_t uRowBytes = pJob->m_uRowBytes;
+	// Best and trial filtered rows with a filter type byte in front and a row of zeros
+	uint8_t *pMemory = static_cast<uint8_t *>(Burger::allocate_memory(((uRowBytes+1U)*2U)+uRowBytes));
+	if (!pMemory) {
+		pJob->m_uError = 10;
+		return 10;
+	}
+	uint8_t *pBest = pMemory;
+	uint8_t *pTrial = pMemory+uRowBytes+1U;
+	const uint8_t *pRow = pJob->m_pRows;
+	const uint8_t *pPrevious = pJob->m_pPrevious;
+	if (!pPrevious) {
+		uint8_t *pZero = pTrial+uRowBytes+1U;
+		Burger::memory_clear(pZero,uRowBytes);
+		pPrevious = pZero;
+	}
+	Burger::CompressDeflate *pCompressor = pJob->m_pCompressor;
+	const uint_t bRaw = pCompressor->GetRawMode();
+	uint32_t uAdler = 1;
+	uint_t uError = 0;
+	uint_t uCount = pJob->m_uRowCount;
+	do {
+		uintptr_t uBestCost = UINTPTR_MAX;
+		uint_t uFilter = 0;
+		do {
+			if (pJob->m_uFilterMask&(1U<<uFilter)) {
+				uintptr_t uCost = PNGFilterRow(pTrial+1,pRow,pPrevious,uRowBytes,pJob->m_uBytesPerPixel,uFilter);
+				if (uCost<uBestCost) {
+					uBestCost = uCost;
+					pTrial[0] = static_cast<uint8_t>(uFilter);
+					uint8_t *pTemp = pBest;
+					pBest = pTrial;
+					pTrial = pTemp;
+				}
+			}
+		} while (++uFilter<5);
+		if (pCompressor->Process(pBest,uRowBytes+1U)) {
+			uError = 10;
+			break;
+		}
+		if (bRaw) {
+			uAdler = Burger::calc_adler32(pBest,uRowBytes+1U,uAdler);
+		}
+		pPrevious = pRow;
+		pRow += pJob->m_uStride;
+	} while (--uCount);
+	Burger::free_memory(pMemory);
+	if (!uError) {
+		// Bands that don't end the image are flushed to a byte boundary
+		// so the next band's output can be appended
+		if ((pJob->m_bLast ? pCompressor->Finalize() : pCompressor->Flush())!=Burger::kErrorNone) {
+			uError = 10;
+		}
+	}
+	pJob->m_uAdler = uAdler;
+	pJob->m_uRawLength = (uRowBytes+1U)*pJob->m_uRowCount;
+	pJob->m_uError = uError;
+	return uError;
+}
+
+//
+// Append a PNG chunk with its length, ID and CRC, return non-zero if the
+// stream ran out of memory
+//
+
+static uint_t BURGER_API PNGAppendChunk(Burger::OutputMemoryStream *pOutput,uint32_t uID,const void *pData,uintptr_t uLength)
+{
+	uint8_t ID[4];
+	ID[0] = static_cast<uint8_t>(uID>>24U);
+	ID[1] = static_cast<uint8_t>(uID>>16U);
+	ID[2] = static_cast<uint8_t>(uID>>8U);
+	ID[3] = static_cast<uint8_t>(uID);
+	uint_t uResult = pOutput->BigEndianAppend(static_cast<uint32_t>(uLength));
+	uResult |= pOutput->Append(ID,4);
+	uint32_t uCRC = Burger::calc_crc32b(ID,4);
+	if (uLength) {
+		uResult |= pOutput->Append(pData,uLength);
+		uCRC = Burger::calc_crc32b(pData,uLength,uCRC);
+	}
+	uResult |= pOutput->BigEndianAppend(uCRC);
+	return uResult;
+}
+
 #endif
 
 /*! ************************************
@@ -102,6 +728,339 @@ const char * Burger::FilePNG::SeekChunk(InputMemoryStream *pInput,uint32_t uID,u
 	return "PNG Chunk was not found";
 }
 
+/*! ************************************
+
+	\brief Validate and store the contents of an IHDR chunk
+
+	Set the image dimensions, pixel type and interlace method from the 13
+	byte IHDR chunk.
+
+	\param pIHDR Pointer to the data of the IHDR chunk
+	\return \ref NULL if success or a pointer to a string describing the error
+
+***************************************/
+
+const char * BURGER_API Burger::FilePNG::SetHeader(const uint8_t *pIHDR)
+{
+	uint_t uWidth = PNGGetBig32(pIHDR);
+	uint_t uHeight = PNGGetBig32(pIHDR+4);
+	uint_t uDepth = pIHDR[8];
+	uint_t uColorType = pIHDR[9];
+	uint_t uInterlaceMethod = pIHDR[12];
+
+	// Sanity check
+	if (!uWidth) {
+		return "Width can't be zero.";
+	}
+	if (!uHeight) {
+		return "Height can't be zero.";
+	}
+	if (pIHDR[10]) {
+		return "Unknown compression.";
+	}
+	if (pIHDR[11]) {
+		return "Unknown filter method.";
+	}
+	if (uInterlaceMethod>1) {
+		return "Unknown interlace method.";
+	}
+	switch (uColorType) {
+	default:
+		return "Unknown color type.";
+	case PNG_INDEXED:
+		if (uDepth!=8) {
+			return "Unsupported indexed color bit depth.";
+		}
+		m_eType = Image::PIXELTYPE8BIT;
+		m_uBytesPerPixel = 1;
+		break;
+	case PNG_RGB:
+		if (uDepth!=8) {
+			return "Unsupported RGB bit depth.";
+		}
+		m_eType = Image::PIXELTYPE888;
+		m_uBytesPerPixel = 3;
+		break;
+	case PNG_RGBA:
+		if (uDepth!=8) {
+			return "Unsupported RGBA bit depth.";
+		}
+		m_eType = Image::PIXELTYPE8888;
+		m_uBytesPerPixel = 4;
+		break;
+	}
+	m_uWidth = uWidth;
+	m_uHeight = uHeight;
+	m_uInterlaceMethod = uInterlaceMethod;
+	return NULL;
+}
+
+/*! ************************************
+
+	\brief Store the contents of a PLTE chunk
+
+	Copy up to 256 RGB triplets into the palette, the alpha of each entry
+	is set to zero and unused entries are set to black.
+
+	\param pInput Pointer to the data of the PLTE chunk
+	\param uLength Size of the PLTE chunk in bytes
+
+***************************************/
+
+void BURGER_API Burger::FilePNG::SetPNGPalette(const uint8_t *pInput,uintptr_t uLength)
+{
+	memory_clear(m_Palette,sizeof(m_Palette));
+	uintptr_t uPaletteSize = uLength/3U;
+	if (uPaletteSize>256) {
+		uPaletteSize = 256;
+	}
+	RGBAWord8_t *pWork = m_Palette;
+	while (uPaletteSize) {
+		pWork->m_uRed = pInput[0];		// Read in the palette
+		pWork->m_uGreen = pInput[1];
+		pWork->m_uBlue = pInput[2];
+		pWork->m_uAlpha = 0;
+		pInput += 3;
+		++pWork;
+		--uPaletteSize;
+	}
+}
+
+/*! ************************************
+
+	\brief Prepare to decode the IDAT chunks
+
+	Initialize the output Image if there is one, allocate the inflater and
+	the row buffers and set up the first pass.
+
+	The row buffers hold the filter byte and filtered pixels of a single
+	row, two unfiltered rows and a row of zeros, so memory use depends only
+	on the width of the image.
+
+	\return \ref NULL if success or a pointer to a string describing the error
+
+***************************************/
+
+const char * BURGER_API Burger::FilePNG::StartRows(void)
+{
+	ReleaseRows();
+	if (m_pOutput) {
+		if (m_pOutput->Init(m_uWidth,m_uHeight,m_eType)) {
+			return "Can't allocate the image.";
+		}
+	}
+
+	// Filter byte and the row, rounded up to a multiple of 16
+	uintptr_t uBufferSize = ((static_cast<uintptr_t>(m_uWidth)*m_uBytesPerPixel)+16U)&(~static_cast<uintptr_t>(15U));
+	uint8_t *pMemory = static_cast<uint8_t *>(allocate_memory(uBufferSize*4U));
+	if (!pMemory) {
+		return "Out of memory.";
+	}
+	DecompressDeflate *pDecompressor = new_object<DecompressDeflate>();
+	if (!pDecompressor) {
+		free_memory(pMemory);
+		return "Out of memory.";
+	}
+	pDecompressor->Reset();
+	m_pDecompressor = pDecompressor;
+	m_pRowMemory = pMemory;
+	m_pFiltered = pMemory;
+	m_pRow = pMemory+uBufferSize;
+	m_pPrevious = pMemory+(uBufferSize*2U);
+	m_pZeroRow = pMemory+(uBufferSize*3U);
+	memory_clear(m_pZeroRow,uBufferSize);
+	m_uPass = 0;
+	StartPass();
+	return NULL;
+}
+
+/*! ************************************
+
+	\brief Set up the dimensions of the current pass
+
+	Progressive images have a single pass the size of the image. Adam7
+	passes that have no pixels are skipped since they have no data in the
+	compressed stream.
+
+***************************************/
+
+void BURGER_API Burger::FilePNG::StartPass(void)
+{
+	if (!m_uInterlaceMethod) {
+		m_uPassWidth = m_uWidth;
+		m_uPassHeight = m_uHeight;
+	} else {
+		uint_t uPass = m_uPass;
+		while (uPass<7) {
+			const Adam7Pass_t *pPass = &s_Adam7Passes[uPass];
+			if ((m_uWidth>pPass->m_uXStart) && (m_uHeight>pPass->m_uYStart)) {
+				m_uPassWidth = (m_uWidth-pPass->m_uXStart+pPass->m_uXStep-1U)/pPass->m_uXStep;
+				m_uPassHeight = (m_uHeight-pPass->m_uYStart+pPass->m_uYStep-1U)/pPass->m_uYStep;
+				break;
+			}
+			++uPass;
+		}
+		m_uPass = uPass;
+	}
+	m_uPassY = 0;
+	m_uRowBytes = static_cast<uintptr_t>(m_uPassWidth)*m_uBytesPerPixel;
+	m_uRowFill = 0;
+}
+
+/*! ************************************
+
+	\brief Decompress IDAT data and unfilter each completed row
+
+	Data from the IDAT chunks can be passed in pieces of any size. Each time
+	a row has been inflated, it is unfiltered and passed to FinishRow().
+	Data after the last row is ignored.
+
+	\param pInput Pointer to IDAT chunk data
+	\param uLength Number of bytes of IDAT chunk data
+	\return \ref NULL if success or a pointer to a string describing the error
+
+***************************************/
+
+const char * BURGER_API Burger::FilePNG::ProcessIDAT(const uint8_t *pInput,uintptr_t uLength)
+{
+	DecompressDeflate *pDecompressor = m_pDecompressor;
+	while (uLength && (m_uPass<7)) {
+		// Inflate the filter type and the row in one call
+		uintptr_t uRowSize = m_uRowBytes+1;
+		eError uError = pDecompressor->Process(m_pFiltered+m_uRowFill,uRowSize-m_uRowFill,pInput,uLength);
+		uintptr_t uUsed = pDecompressor->GetProcessedInputSize();
+		uintptr_t uMade = pDecompressor->GetProcessedOutputSize();
+		if (uError==kErrorDataCorruption) {
+			return "Decompression error.";
+		}
+		pInput += uUsed;
+		uLength -= uUsed;
+		m_uRowFill += uMade;
+		if (m_uRowFill==uRowSize) {
+			if (m_pFiltered[0]>4) {
+				return "Unknown filter type.";
+			}
+			FinishRow();
+		} else if (!uUsed && !uMade) {
+			// The compressed stream ended early
+			return "Image data is truncated.";
+		}
+	}
+	return NULL;
+}
+
+/*! ************************************
+
+	\brief Unfilter a completed row and pass it on
+
+	For progressive images being decoded into an Image, the row is unfiltered
+	directly into the image using the previous image row as the prediction.
+	Otherwise, the row is unfiltered into a row buffer, copied into the
+	columns of the Image for Adam7 passes, and passed to the row callback.
+
+***************************************/
+
+void BURGER_API Burger::FilePNG::FinishRow(void)
+{
+	uint_t uBytesPerPixel = m_uBytesPerPixel;
+	if (!m_uInterlaceMethod && m_pOutput) {
+		uintptr_t uStride = m_pOutput->GetStride();
+		uint8_t *pOutput = m_pOutput->GetImage()+(static_cast<uintptr_t>(m_uPassY)*uStride);
+		UnfilterRow(pOutput,m_pFiltered+1,m_uPassY ? pOutput-uStride : m_pZeroRow,m_uRowBytes,uBytesPerPixel,m_pFiltered[0]);
+		if (m_pRowProc) {
+			m_pRowProc(m_pRowData,pOutput,m_uPassY,0);
+		}
+	} else {
+		uint8_t *pRow = m_pRow;
+		UnfilterRow(pRow,m_pFiltered+1,m_uPassY ? m_pPrevious : m_pZeroRow,m_uRowBytes,uBytesPerPixel,m_pFiltered[0]);
+		// This row is the prediction for the next row
+		m_pRow = m_pPrevious;
+		m_pPrevious = pRow;
+		uint_t uY = m_uPassY;
+		uint_t uPass = 0;
+		if (m_uInterlaceMethod) {
+			const Adam7Pass_t *pPass = &s_Adam7Passes[m_uPass];
+			uY = pPass->m_uYStart+(uY*pPass->m_uYStep);
+			uPass = m_uPass+1;
+			if (m_pOutput) {
+				PNGScatterPass(m_pOutput->GetImage()+(static_cast<uintptr_t>(uY)*m_pOutput->GetStride())+(pPass->m_uXStart*uBytesPerPixel),
+					pRow,m_uPassWidth,pPass->m_uXStep,uBytesPerPixel);
+			}
+		}
+		if (m_pRowProc) {
+			m_pRowProc(m_pRowData,pRow,uY,uPass);
+		}
+	}
+	m_uRowFill = 0;
+	if (++m_uPassY>=m_uPassHeight) {
+		if (!m_uInterlaceMethod) {
+			m_uPass = 7;
+		} else {
+			++m_uPass;
+			StartPass();
+		}
+	}
+}
+
+/*! ************************************
+
+	\brief Release the inflater and the row buffers
+
+***************************************/
+
+void BURGER_API Burger::FilePNG::ReleaseRows(void)
+{
+	delete_object(m_pDecompressor);
+	m_pDecompressor = NULL;
+	free_memory(m_pRowMemory);
+	m_pRowMemory = NULL;
+	m_pFiltered = NULL;
+	m_pRow = NULL;
+	m_pPrevious = NULL;
+	m_pZeroRow = NULL;
+}
+
+/*! ************************************
+
+	\brief Undo the filter of a PNG row
+
+	Apply the inverse of the PNG filter (None, Sub, Up, Average or Paeth) to
+	a row of filtered bytes. Sub, Average and Paeth process one 3 or 4 byte
+	pixel per step with SSE2 or NEON and Up processes 16 bytes per step.
+
+	\param pOutput Pointer to the buffer to receive the unfiltered row
+	\param pInput Pointer to the filtered row (Can't be the same as pOutput)
+	\param pPrevious Pointer to the unfiltered previous row or zeros
+	\param uLength Number of bytes in the row
+	\param uBytesPerPixel Number of bytes per pixel
+	\param uFilter PNG filter type (0-4)
+
+***************************************/
+
+void BURGER_API Burger::FilePNG::UnfilterRow(uint8_t *pOutput,const uint8_t *pInput,const uint8_t *pPrevious,uintptr_t uLength,uint_t uBytesPerPixel,uint_t uFilter)
+{
+	switch (uFilter) {
+	// Add the value from the previous pixel
+	case 1:
+		PNGUnfilterSub(pOutput,pInput,uLength,uBytesPerPixel);
+		break;
+	// Add the value from the previous scan line
+	case 2:
+		PNGUnfilterUp(pOutput,pInput,pPrevious,uLength);
+		break;
+	case 3:
+		PNGUnfilterAverage(pOutput,pInput,pPrevious,uLength,uBytesPerPixel);
+		break;
+	case 4:
+		PNGUnfilterPaeth(pOutput,pInput,pPrevious,uLength,uBytesPerPixel);
+		break;
+	// Use the data as is
+	default:		// None
+		memory_copy(pOutput,pInput,uLength);
+		break;
+	}
+}
+
 /*! ************************************
 
 	\brief Scan a PNG file in memory and return pointer to a chunk
@@ -142,19 +1101,56 @@ Burger::FilePNG::FilePNG() :
 	m_uStartOffset(0),
 	m_uNextOffset(0),
 	m_uChunkSize(0),
-	m_uPNGID(0)
+	m_uPNGID(0),
+	m_pDecompressor(NULL),
+	m_pOutput(NULL),
+	m_pRowProc(NULL),
+	m_pRowData(NULL),
+	m_pRowMemory(NULL),
+	m_pFiltered(NULL),
+	m_pRow(NULL),
+	m_pPrevious(NULL),
+	m_pZeroRow(NULL),
+	m_uRowBytes(0),
+	m_uRowFill(0),
+	m_uWidth(0),
+	m_uHeight(0),
+	m_uBytesPerPixel(0),
+	m_uInterlaceMethod(0),
+	m_uPass(0),
+	m_uPassWidth(0),
+	m_uPassHeight(0),
+	m_uPassY(0),
+	m_eType(Image::PIXELTYPE8888),
+	m_uStreamState(STREAM_SIGNATURE),
+	m_uStreamChunkSize(0),
+	m_uStreamChunkID(0),
+	m_uStreamFill(0)
 {
 	memory_clear(m_Palette,sizeof(m_Palette));
 }
 
+/*! ************************************
+
+	\brief Destructor
+
+	Releases the decompression buffers of an unfinished stream
+
+***************************************/
+
+Burger::FilePNG::~FilePNG()
+{
+	ReleaseRows();
+}
+
 /*! ************************************
 
 	\brief Parses a PNG file
 
 	Read in a PNG file and set the extra variables
 
-	Will parse 8, 16, 24 and 32 bit compressed PNG files only.
-	Other formats are not supported
+	Will parse 8, 24 and 32 bit compressed PNG files only, either
+	progressive or Adam7 interlaced. Other formats are not supported
 
 	\note A descriptive error message is passed to Debug::Warning()
 
@@ -162,21 +1158,13 @@ Burger::FilePNG::FilePNG() :
 	\param pInput Pointer to a memory stream that has a PNG file image
 
 	\return Zero for success or non-zero on failure
+	\sa StartStream(Image *,RowProc_t,void *)
 
 ***************************************/
 
 uint_t BURGER_API Burger::FilePNG::Load(Image *pOutput,InputMemoryStream *pInput)
 {
-    const char *pBadNews = NULL;
-    uint_t uResult = 10;
-	uint_t uWidth = 0;
-	uint_t uHeight = 0;
-	uint_t uDepth = 0;
-	uint_t uColorType = 0;
-	uint_t uCompressionMethod = 0;
-	uint_t uFilterMethod = 0;
-	uint_t uInterlaceMethod = 0;
-	Image::ePixelTypes eType = Image::PIXELTYPE8888;
+	const char *pBadNews = NULL;
 
 	uint8_t ID[8];
 	pInput->Get(ID,8);
@@ -189,58 +1177,10 @@ uint_t BURGER_API Burger::FilePNG::Load(Image *pOutput,InputMemoryStream *pInput
 		// Find the common chunk
 		pBadNews = SeekPNGChunk(pInput,IHDRASCII);
 		if (!pBadNews) {
-			if (m_uChunkSize<13) {
+			if ((m_uChunkSize<13) || (pInput->BytesRemaining()<13)) {
 				pBadNews = "IHDR chunk is too small.";
 			} else {
-				uWidth = pInput->GetBigWord32();
-				uHeight = pInput->GetBigWord32();
-				uDepth = pInput->GetByte();
-				uColorType = pInput->GetByte();
-				uCompressionMethod = pInput->GetByte();
-				uFilterMethod = pInput->GetByte();
-				uInterlaceMethod = pInput->GetByte();
-				// Sanity check
-				if (!uWidth) {
-					pBadNews = "Width can't be zero.";
-				} else if (!uHeight) {
-					pBadNews = "Height can't be zero.";
-				} else if (uCompressionMethod) {
-					pBadNews = "Unknown compression.";
-				} else if (uFilterMethod) {
-					pBadNews = "Unknown filter method.";
-				} else if (uInterlaceMethod) {
-					pBadNews = "Can't process interlaced images.";
-				} else {
-					switch (uColorType) {
-					default:
-						pBadNews = "Unknown color type.";
-						break;
-					case PNG_INDEXED:
-						if (uDepth==8) {
-							eType = Image::PIXELTYPE8BIT;
-							// uDepth = 8;
-						} else {
-							pBadNews = "Unsupported indexed color bit depth.";
-						}
-						break;
-					case PNG_RGB:
-						if (uDepth==8) {
-							eType = Image::PIXELTYPE888;
-							uDepth = 24;
-						} else {
-							pBadNews = "Unsupported RGB bit depth.";
-						}
-						break;
-					case PNG_RGBA:
-						if (uDepth==8) {
-							eType = Image::PIXELTYPE8888;
-							uDepth = 32;
-						} else {
-							pBadNews = "Unsupported RGBA bit depth.";
-						}
-						break;
-					}
-				}
+				pBadNews = SetHeader(pInput->GetPtr());
 			}
 		}
 	}
@@ -248,22 +1188,14 @@ uint_t BURGER_API Burger::FilePNG::Load(Image *pOutput,InputMemoryStream *pInput
 	// Does it need a palette?
 
 	if (!pBadNews) {
-		if (eType == Image::PIXELTYPE8BIT) {		// Get the palette
+		if (m_eType == Image::PIXELTYPE8BIT) {		// Get the palette
 			pBadNews = SeekPNGChunk(pInput,PLTEASCII); // Read in the palette
 			if (!pBadNews) {
-				memory_clear(m_Palette,sizeof(m_Palette));
-				uint32_t uPaletteSize = m_uChunkSize/3U;
-				if (uPaletteSize>256) {
-					uPaletteSize = 256;
+				uintptr_t uLength = pInput->BytesRemaining();
+				if (uLength>m_uChunkSize) {
+					uLength = m_uChunkSize;
 				}
-				RGBAWord8_t *pWork = m_Palette;
-				do {
-					pWork->m_uRed = pInput->GetByte();		// Read in the palette
-					pWork->m_uGreen = pInput->GetByte();
-					pWork->m_uBlue = pInput->GetByte();
-					pWork->m_uAlpha = 0;
-					++pWork;
-				} while (--uPaletteSize);
+				SetPNGPalette(pInput->GetPtr(),uLength);
 			}
 		}
 	}
@@ -275,154 +1207,493 @@ uint_t BURGER_API Burger::FilePNG::Load(Image *pOutput,InputMemoryStream *pInput
 	if (!pBadNews) {
 		pBadNews = SeekPNGChunk(pInput,IDATASCII); // Find the image
 		if (!pBadNews) {
-			uResult = pOutput->Init(uWidth,uHeight,eType);
-			if (!uResult) {
-
-				// It uses Deflate (ZLIB) compression
-
-				DecompressDeflate *pDecompressor = new (allocate_memory(sizeof(DecompressDeflate))) DecompressDeflate;
-				const uint8_t *pPacked = pInput->GetPtr();
-				uintptr_t uPackedSize = m_uChunkSize;
-				eError Error = kErrorNone;
-				uint8_t *pDest = pOutput->GetImage();
-				uDepth = (uDepth+7U)>>3U;
-				uWidth = uWidth*uDepth;
+			m_pOutput = pOutput;
+			m_pRowProc = NULL;
+			pBadNews = StartRows();
+
+			// The loop is needed because there could be
+			// sequential multiple IDAT chunks so the decompression
+			// needs to be able to span these chunks
+
+			while (!pBadNews) {
+				uintptr_t uPackedSize = pInput->BytesRemaining();
+				if (uPackedSize>m_uChunkSize) {
+					uPackedSize = m_uChunkSize;
+				}
+				pBadNews = ProcessIDAT(pInput->GetPtr(),uPackedSize);
+				if (pBadNews || (m_uPass>=7)) {
+					break;
+				}
+				pBadNews = SeekNextPNGChunk(pInput,IDATASCII);
+			}
+			ReleaseRows();
+			m_pOutput = NULL;
+		}
+	}
+	// If there was an error, clean up
+	if (pBadNews) {
+		Debug::Warning(pBadNews);
+		return 10;
+	}
+	return 0;
+}
+
+/*! ************************************
+
+	\brief Write an image as a PNG file
+
+	Write an 8 bit paletted, 24 bit RGB or 32 bit RGBA image as a
+	progressive PNG file. 8 bit images use the palette in this class.
+
+	Each row is filtered with every filter allowed by the preset and the
+	filter whose output has the smallest sum of magnitudes is kept, which
+	is the heuristic suggested by the PNG specification. Paletted images
+	are never filtered.
+
+	\ref SAVE_FASTEST only tries the Sub and Up filters and uses the
+	greedy deflate matcher. \ref SAVE_DEFAULT tries all filters and uses
+	the default deflate level. \ref SAVE_SMALLEST tries all filters and
+	uses the maximum deflate level.
+
+	If uThreadCount is more than one, the image is split into horizontal
+	bands that are filtered and compressed at the same time and joined into
+	a single zlib stream. Each band is flushed to a byte boundary and
+	starts with an empty dictionary, so the file is slightly larger than a
+	single threaded save.
+
+	\param pOutput Pointer to the stream to append the PNG file to
+	\param pImage Pointer to the image to save
+	\param uPreset \ref SAVE_FASTEST, \ref SAVE_DEFAULT or \ref SAVE_SMALLEST
+	\param uThreadCount Number of threads to compress with
+	\return Zero for success or non-zero on failure
+	\sa Load(Image *,InputMemoryStream *)
+
+***************************************/
+
+uint_t BURGER_API Burger::FilePNG::Save(OutputMemoryStream *pOutput,const Image *pImage,uint_t uPreset,uint_t uThreadCount)
+{
+	const char *pBadNews = NULL;
+	uint_t uColorType;
+	uint_t uBytesPerPixel;
+	switch (pImage->GetType()) {
+	case Image::PIXELTYPE8BIT:
+		uColorType = PNG_INDEXED;
+		uBytesPerPixel = 1;
+		break;
+	case Image::PIXELTYPE888:
+		uColorType = PNG_RGB;
+		uBytesPerPixel = 3;
+		break;
+	case Image::PIXELTYPE8888:
+		uColorType = PNG_RGBA;
+		uBytesPerPixel = 4;
+		break;
+	default:
+		pBadNews = "Only 8, 24 and 32 bit images can be saved as PNG.";
+		uColorType = 0;
+		uBytesPerPixel = 0;
+		break;
+	}
+	const uint_t uWidth = pImage->GetWidth();
+	const uint_t uHeight = pImage->GetHeight();
+	if (!pBadNews && (!uWidth || !uHeight)) {
+		pBadNews = "Can't save an empty image as PNG.";
+	}
+	if (pBadNews) {
+		Debug::Warning(pBadNews);
+		return 10;
+	}
+
+	// Settings for the preset
+	uint_t uLevel;
+	uint_t uFilterMask;
+	if (uPreset==SAVE_FASTEST) {
+		uLevel = CompressDeflate::LEVEL_FASTEST;
+		uFilterMask = (1U<<1U)|(1U<<2U);
+	} else if (uPreset==SAVE_SMALLEST) {
+		uLevel = CompressDeflate::LEVEL_BEST;
+		uFilterMask = 0x1FU;
+	} else {
+		uLevel = CompressDeflate::LEVEL_DEFAULT;
+		uFilterMask = 0x1FU;
+	}
+	if (uBytesPerPixel==1) {
+		uFilterMask = 1U;
+	}
+
+	// Split the rows into bands, one per thread
+	if (uThreadCount>kPNGMaxThreads) {
+		uThreadCount = kPNGMaxThreads;
+	}
+	const uint_t uMaxBands = (uHeight+(kPNGMinBandRows-1U))/kPNGMinBandRows;
+	if (uThreadCount>uMaxBands) {
+		uThreadCount = uMaxBands;
+	}
+	if (!uThreadCount) {
+		uThreadCount = 1;
+	}
+
+	PNGSaveJob_t Jobs[kPNGMaxThreads];
+	const uint8_t *pImageData = pImage->GetImage();
+	const uintptr_t uStride = pImage->GetStride();
+	uint_t uRow = 0;
+	uint_t i = 0;
+	do {
+		const uint_t uNextRow = (uHeight*(i+1U))/uThreadCount;
+		PNGSaveJob_t *pJob = &Jobs[i];
+		pJob->m_pRows = pImageData+(uRow*uStride);
+		pJob->m_pPrevious = uRow ? (pJob->m_pRows-uStride) : NULL;
+		pJob->m_uStride = uStride;
+		pJob->m_uRowBytes = static_cast<uintptr_t>(uWidth)*uBytesPerPixel;
+		pJob->m_uRawLength = 0;
+		pJob->m_uRowCount = uNextRow-uRow;
+		pJob->m_uBytesPerPixel = uBytesPerPixel;
+		pJob->m_uFilterMask = uFilterMask;
+		pJob->m_bLast = (uNextRow==uHeight);
+		pJob->m_uAdler = 1;
+		pJob->m_uError = 0;
+		pJob->m_pCompressor = new_object<CompressDeflate>();
+		if (!pJob->m_pCompressor) {
+			pBadNews = "Out of memory for the compressor.";
+		} else {
+			pJob->m_pCompressor->SetLevel(uLevel);
+			// Bands are joined together, so they have no zlib header
+			pJob->m_pCompressor->SetRawMode(uThreadCount>1);
+		}
+		uRow = uNextRow;
+	} while (++i<uThreadCount);
+
+	if (!pBadNews) {
+		if (uThreadCount<2) {
+			PNGSaveBand(&Jobs[0]);
+		} else {
+			// The calling thread does the last band
+			Thread Threads[kPNGMaxThreads];
+			const uint_t uThreads = uThreadCount-1U;
+			i = 0;
+			do {
+				if (Threads[i].start(PNGSaveBand,&Jobs[i],"FilePNG::Save")) {
+					PNGSaveBand(&Jobs[i]);
+				}
+			} while (++i<uThreads);
+			PNGSaveBand(&Jobs[uThreads]);
+			i = 0;
+			do {
+				if (Threads[i].is_initialized()) {
+					Threads[i].wait();
+				}
+			} while (++i<uThreads);
+		}
+		i = 0;
+		do {
+			if (Jobs[i].m_uError) {
+				pBadNews = "Error compressing the PNG image.";
+			}
+		} while (++i<uThreadCount);
+	}
+
+	// Join the bands into a single zlib stream
+	uintptr_t uPackedSize = 0;
+	const uint8_t *pPacked = NULL;
+	void *pFlattened = NULL;
+	OutputMemoryStream Joined;
+	if (!pBadNews) {
+		if (uThreadCount<2) {
+			pPacked = static_cast<const uint8_t *>(Jobs[0].m_pCompressor->GetOutput()->GetFlatData(&uPackedSize));
+		}
+		if (!pPacked) {
+			OutputMemoryStream *pJoined = &Joined;
+			if (uThreadCount<2) {
+				pJoined = Jobs[0].m_pCompressor->GetOutput();
+			} else {
+				// Same header CompressDeflate writes for this level
+				uint_t uHeader = ((8U+(7U<<4U))<<8U);
+				uint_t uLevelFlags = (uLevel-1U)>>1U;
+				if (uLevelFlags>3U) {
+					uLevelFlags = 3U;
+				}
+				uHeader |= (uLevelFlags<<6U);
+				uHeader += 31U-(uHeader%31U);
+				Joined.BigEndianAppend(static_cast<uint16_t>(uHeader));
+				uint32_t uAdler = 1;
+				i = 0;
 				do {
-					uint8_t bType = 0;
-
-					// The loops are needed because there could be
-					// sequential multiple IDAT chunks so the decompression
-					// needs to be able to span these chunks
-
-					do {
-						if (!uPackedSize) {
-							pBadNews = SeekNextPNGChunk(pInput,IDATASCII);
-							if (pBadNews) {
-								break;
-							}
-							pPacked = pInput->GetPtr();
-							uPackedSize = m_uChunkSize;
-						}
-						Error = pDecompressor->Process(&bType,1,pPacked,uPackedSize);
-						uintptr_t uStep = pDecompressor->GetProcessedInputSize();
-						pPacked += uStep;
-						uPackedSize -= uStep;
-					} while (pDecompressor->GetProcessedOutputSize()!=1);
-					if (pBadNews) {
-						break;
-					}
-					uintptr_t uRemaining = uWidth;
-					do {
-						if (!uPackedSize) {
-							pBadNews = SeekNextPNGChunk(pInput,IDATASCII);
-							if (pBadNews) {
-								break;
-							}
-							pPacked = pInput->GetPtr();
-							uPackedSize = m_uChunkSize;
-						}
-						Error = pDecompressor->Process(pDest+(uWidth-uRemaining),uRemaining,pPacked,uPackedSize);
-						uintptr_t uStep = pDecompressor->GetProcessedInputSize();
-						pPacked += uStep;
-						uPackedSize -= uStep;
-						uRemaining -= pDecompressor->GetProcessedOutputSize();
-					} while (uRemaining);
-					if (pBadNews) {
+					uintptr_t uLength;
+					void *pBand = Jobs[i].m_pCompressor->GetOutput()->Flatten(&uLength);
+					if (!pBand) {
+						pBadNews = "Out of memory joining the PNG bands.";
 						break;
 					}
+					Joined.Append(pBand,uLength);
+					free_memory(pBand);
+					uAdler = combine_adler32(uAdler,Jobs[i].m_uAdler,Jobs[i].m_uRawLength);
+				} while (++i<uThreadCount);
+				Joined.BigEndianAppend(uAdler);
+			}
+			if (!pBadNews) {
+				pFlattened = pJoined->Flatten(&uPackedSize);
+				pPacked = static_cast<const uint8_t *>(pFlattened);
+				if (!pPacked) {
+					pBadNews = "Out of memory joining the PNG bands.";
+				}
+			}
+		}
+	}
 
-					switch (bType) {
-					// Add the value from the previous pixel
-					case 1:
-						{
-							uint_t i = uDepth;
-							const uint8_t *pPrevious = pDest-uDepth;
-							do {
-								pDest[i] = static_cast<uint8_t>(pDest[i]+pPrevious[i]);
-							} while (++i<uWidth);
-						}
-						break;
-					// Add the value from the previous scan line
-					case 2:
-						{
-							uint_t i = 0;
-							const uint8_t *pPrevious = pDest-uWidth;
-							do {
-								pDest[i] = static_cast<uint8_t>(pDest[i]+pPrevious[i]);
-							} while (++i<uWidth);
-						}
-						break;
-					case 3:
-						{
-							uint_t i = 0;
-							const uint8_t *pPrevious = pDest-uWidth;
-							do {
-								pDest[i] = static_cast<uint8_t>(pDest[i]+(pPrevious[i]/2));
-							} while (++i<uDepth);
-
-							do {
-								pDest[i] = static_cast<uint8_t>(pDest[i]+((pPrevious[i] + pDest[i-uDepth])/2));
-							} while (++i<uWidth);
-						}
-						break;
-					case 4:
-						{
-							uint_t i = 0;
-							const uint8_t *pPrevious = pDest-uWidth;
-							do {
-								pDest[i] = static_cast<uint8_t>(pDest[i]+pPrevious[i]);
-							} while (++i<uDepth);
-
-							do {
-								int32_t c = pPrevious[i-uDepth];
-								int32_t a = pDest[i-uDepth];
-								int32_t b = pPrevious[i];
-								int32_t p = b - c;
-								int32_t pc = a - c;
-
-								int32_t pa = absolute(p);
-								int32_t pb = absolute(pc);
-								pc = absolute(p + pc);
-
-								// Find the best predictor, the least of pa, pb, pc favoring the earlier
-								// ones in the case of a tie.
-								
-								if (pb < pa) {
-									pa = pb;
-									a = b;
-								}
-								if (pc < pa) {
-									a = c;
-								}
-								// Calculate the current pixel in a, and move the previous row pixel to c
-								// for the next time round the loop
-								c = b;
-								a += pDest[i];
-								pDest[i] = static_cast<uint8_t>(a);
-							} while (++i<uWidth);
-						}
-						break;
-					// Use the data as is
-					default:		// None
-						break;
+	if (!pBadNews) {
+		uint_t uWriteError = pOutput->Append(g_Signature,8);
+
+		uint8_t Header[13];
+		Header[0] = static_cast<uint8_t>(uWidth>>24U);
+		Header[1] = static_cast<uint8_t>(uWidth>>16U);
+		Header[2] = static_cast<uint8_t>(uWidth>>8U);
+		Header[3] = static_cast<uint8_t>(uWidth);
+		Header[4] = static_cast<uint8_t>(uHeight>>24U);
+		Header[5] = static_cast<uint8_t>(uHeight>>16U);
+		Header[6] = static_cast<uint8_t>(uHeight>>8U);
+		Header[7] = static_cast<uint8_t>(uHeight);
+		Header[8] = 8;		// Bits per sample
+		Header[9] = static_cast<uint8_t>(uColorType);
+		Header[10] = 0;		// Deflate
+		Header[11] = 0;		// Adaptive filtering
+		Header[12] = 0;		// Progressive
+		uWriteError |= PNGAppendChunk(pOutput,IHDRASCII,Header,13);
+
+		if (uColorType==PNG_INDEXED) {
+			uint8_t Palette[256*3];
+			uint_t uIndex = 0;
+			do {
+				Palette[uIndex*3] = m_Palette[uIndex].m_uRed;
+				Palette[(uIndex*3)+1] = m_Palette[uIndex].m_uGreen;
+				Palette[(uIndex*3)+2] = m_Palette[uIndex].m_uBlue;
+			} while (++uIndex<256);
+			uWriteError |= PNGAppendChunk(pOutput,PLTEASCII,Palette,sizeof(Palette));
+		}
+
+		// Split the compressed data into IDAT chunks
+		const uint8_t *pWork = pPacked;
+		do {
+			uintptr_t uChunk = uPackedSize;
+			if (uChunk>0x10000U) {
+				uChunk = 0x10000U;
+			}
+			uWriteError |= PNGAppendChunk(pOutput,IDATASCII,pWork,uChunk);
+			pWork += uChunk;
+			uPackedSize -= uChunk;
+		} while (uPackedSize);
+		uWriteError |= PNGAppendChunk(pOutput,IENDASCII,NULL,0);
+		if (uWriteError) {
+			pBadNews = "Out of memory writing the PNG file.";
+		}
+	}
+
+	free_memory(pFlattened);
+	i = 0;
+	do {
+		delete_object(Jobs[i].m_pCompressor);
+	} while (++i<uThreadCount);
+	if (pBadNews) {
+		Debug::Warning(pBadNews);
+		return 10;
+	}
+	return 0;
+}
+
+/*! ************************************
+
+	\brief Begin decoding a PNG file as it arrives
+
+	Prepare to accept the bytes of a PNG file with ProcessStream(). The
+	compressed data is inflated as it arrives and each row is unfiltered
+	as soon as it's complete, so only a few rows of memory are needed on
+	top of the output.
+
+	If pOutput is not \ref NULL, it's initialized when the first IDAT chunk
+	arrives and filled in as rows are decoded. If pOutput is \ref NULL,
+	pixels are only delivered to pRowProc and the memory needed is
+	independent of the image height.
+
+	\param pOutput Pointer to an Image to receive the pixels or \ref NULL
+	\param pRowProc Function to call with each decoded row or \ref NULL
+	\param pData Pointer passed to pRowProc
+	\sa ProcessStream(const void *,uintptr_t) or IsStreamComplete() const
+
+***************************************/
+
+void BURGER_API Burger::FilePNG::StartStream(Image *pOutput,RowProc_t pRowProc,void *pData)
+{
+	ReleaseRows();
+	m_pOutput = pOutput;
+	m_pRowProc = pRowProc;
+	m_pRowData = pData;
+	m_uWidth = 0;
+	m_uHeight = 0;
+	m_uPass = 0;
+	m_uStreamState = STREAM_SIGNATURE;
+	m_uStreamChunkSize = 0;
+	m_uStreamChunkID = 0;
+	m_uStreamFill = 0;
+}
+
+/*! ************************************
+
+	\brief Decode the next piece of a PNG file
+
+	Pass the bytes of a PNG file in order, in pieces of any size. Chunks are
+	parsed as they arrive and IDAT data is decompressed immediately, so
+	decoding overlaps with reading the file. Unknown chunks are skipped.
+	Once the IEND chunk is processed, IsStreamComplete() returns \ref TRUE
+	and any further data is ignored.
+
+	\note A descriptive error message is passed to Debug::Warning()
+
+	\param pInput Pointer to the next bytes of the PNG file
+	\param uLength Number of bytes to process
+	\return Zero for success or non-zero on failure
+	\sa StartStream(Image *,RowProc_t,void *)
+
+***************************************/
+
+uint_t BURGER_API Burger::FilePNG::ProcessStream(const void *pInput,uintptr_t uLength)
+{
+	if (m_uStreamState==STREAM_ERROR) {
+		return 10;
+	}
+	const uint8_t *pWork = static_cast<const uint8_t *>(pInput);
+	const char *pBadNews = NULL;
+	while (uLength && (m_uStreamState!=STREAM_COMPLETE)) {
+		if (m_uStreamState==STREAM_CHUNKDATA) {
+			uintptr_t uCopy = m_uStreamChunkSize;
+			if (uCopy>uLength) {
+				uCopy = uLength;
+			}
+			if (m_uStreamChunkID==IDATASCII) {
+				pBadNews = ProcessIDAT(pWork,uCopy);
+			} else if ((m_uStreamChunkID==IHDRASCII) || (m_uStreamChunkID==PLTEASCII)) {
+				// Gather the chunk, ignoring data that won't fit
+				uintptr_t uKeep = sizeof(m_StreamBuffer)-m_uStreamFill;
+				if (uKeep>uCopy) {
+					uKeep = uCopy;
+				}
+				memory_copy(m_StreamBuffer+m_uStreamFill,pWork,uKeep);
+				m_uStreamFill += static_cast<uint32_t>(uKeep);
+			}
+			pWork += uCopy;
+			uLength -= uCopy;
+			m_uStreamChunkSize -= static_cast<uint32_t>(uCopy);
+		} else {
+			// Gather the signature, a chunk header or a CRC
+			uint32_t uNeed = (m_uStreamState==STREAM_CHUNKCRC) ? 4U : 8U;
+			uintptr_t uCopy = uNeed-m_uStreamFill;
+			if (uCopy>uLength) {
+				uCopy = uLength;
+			}
+			memory_copy(m_StreamBuffer+m_uStreamFill,pWork,uCopy);
+			m_uStreamFill += static_cast<uint32_t>(uCopy);
+			pWork += uCopy;
+			uLength -= uCopy;
+			if (m_uStreamFill<uNeed) {
+				break;
+			}
+			m_uStreamFill = 0;
+			if (m_uStreamState==STREAM_SIGNATURE) {
+				if (MemoryCompare(m_StreamBuffer,g_Signature,8)) {
+					pBadNews = "No PNG header (Not an PNG File).";
+				} else {
+					m_uStreamState = STREAM_CHUNKHEADER;
+				}
+			} else if (m_uStreamState==STREAM_CHUNKCRC) {
+				if (m_uStreamChunkID==IENDASCII) {
+					ReleaseRows();
+					m_uStreamState = STREAM_COMPLETE;
+				} else {
+					m_uStreamState = STREAM_CHUNKHEADER;
+				}
+			} else {
+				m_uStreamChunkSize = PNGGetBig32(m_StreamBuffer);
+				// Force upper case
+				m_uStreamChunkID = PNGGetBig32(m_StreamBuffer+4)&0xDFDFDFDFU;
+				m_uStreamState = STREAM_CHUNKDATA;
+				if (m_uStreamChunkID==IDATASCII) {
+					if (!m_uWidth) {
+						pBadNews = "IDAT chunk found before the IHDR chunk.";
+					} else if (!m_pDecompressor && !m_uPass) {
+						pBadNews = StartRows();
 					}
-					pDest+=uWidth;
-				} while (--uHeight);
-				delete_object(pDecompressor);
-				if (Error!=kErrorNone) {
-					pBadNews = "Decompression error.";
 				}
 			}
 		}
+
+		// Was the chunk data completely processed?
+		if (!pBadNews && (m_uStreamState==STREAM_CHUNKDATA) && !m_uStreamChunkSize) {
+			if (m_uStreamChunkID==IHDRASCII) {
+				if (m_uStreamFill<13) {
+					pBadNews = "IHDR chunk is too small.";
+				} else {
+					pBadNews = SetHeader(m_StreamBuffer);
+				}
+			} else if (m_uStreamChunkID==PLTEASCII) {
+				SetPNGPalette(m_StreamBuffer,m_uStreamFill);
+			} else if (m_uStreamChunkID==IENDASCII) {
+				if (!m_uWidth || (m_uPass<7)) {
+					pBadNews = "Image data is truncated.";
+				}
+			}
+			m_uStreamFill = 0;
+			m_uStreamState = STREAM_CHUNKCRC;
+		}
+		if (pBadNews) {
+			break;
+		}
 	}
+
 	// If there was an error, clean up
 	if (pBadNews) {
 		Debug::Warning(pBadNews);
-		uResult = 10;
+		ReleaseRows();
+		m_uStreamState = STREAM_ERROR;
+		return 10;
 	}
-	return uResult;
+	return 0;
 }
 
+/*! ************************************
+
+	\fn uint_t Burger::FilePNG::IsStreamComplete(void) const
+	\brief Test if the stream has been completely decoded
+
+	\return \ref TRUE if the IEND chunk was processed by ProcessStream()
+	\sa ProcessStream(const void *,uintptr_t)
+
+***************************************/
+
+/*! ************************************
+
+	\fn uint_t Burger::FilePNG::GetWidth(void) const
+	\brief Get the width of the image in pixels
+
+	\return Width from the IHDR chunk, zero if not found yet
+
+***************************************/
+
+/*! ************************************
+
+	\fn uint_t Burger::FilePNG::GetHeight(void) const
+	\brief Get the height of the image in pixels
+
+	\return Height from the IHDR chunk, zero if not found yet
+
+***************************************/
+
+/*! ************************************
+
+	\fn Image::ePixelTypes Burger::FilePNG::GetType(void) const
+	\brief Get the pixel type of the decoded image
+
+	\return Image::ePixelTypes of the decoded pixels
+
+***************************************/
+
 /*! ************************************
 
 	\fn const RGBAWord8_t *Burger::FilePNG::GetPalette(void) const
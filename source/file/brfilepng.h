@@ -35,9 +35,23 @@
 #include "brpalette.h"
 #endif
 
+#ifndef __BRDECOMPRESSDEFLATE_H__
+#include "brdecompressdeflate.h"
+#endif
+
 /* BEGIN */
 namespace Burger {
 class FilePNG {
+public:
+	typedef void (BURGER_API *RowProc_t)(void *pData,const uint8_t *pRow,uint_t uY,uint_t uPass);	///< Function called for each decoded row
+	struct Adam7Pass_t {
+		uint8_t m_uXStart;		///< First pixel column of the pass
+		uint8_t m_uYStart;		///< First pixel row of the pass
+		uint8_t m_uXStep;		///< Pixels between columns of the pass
+		uint8_t m_uYStep;		///< Pixels between rows of the pass
+	};
+	static const Adam7Pass_t s_Adam7Passes[7];	///< Adam7 interlace pattern
+private:
 	RGBAWord8_t m_Palette[256];		///< Palette found in the image
 	uintptr_t m_uStartOffset;			///< PNG file image chunk start offset
 	uintptr_t m_uNextOffset;			///< Offset to the next chunk
@@ -45,7 +59,40 @@ class FilePNG {
 	//uint32_t m_uChunkCRC;			///< CRC of the current chunk
 	uint32_t m_uPNGID;				///< Untouched ID of the current PNG chunk
 protected:
+	DecompressDeflate *m_pDecompressor;	///< Inflater for the IDAT chunks
+	Image *m_pOutput;				///< Image receiving the pixels (Can be \ref NULL when streaming)
+	RowProc_t m_pRowProc;			///< Function called for each decoded row
+	void *m_pRowData;				///< Data pointer passed to m_pRowProc
+	uint8_t *m_pRowMemory;			///< Memory for all the row buffers
+	uint8_t *m_pFiltered;			///< Filter type byte followed by the filtered row
+	uint8_t *m_pRow;				///< Row buffer for the row being unfiltered
+	uint8_t *m_pPrevious;			///< Unfiltered previous row of the pass or all zeros
+	uint8_t *m_pZeroRow;			///< Row of zeros for the first row of a pass
+	uintptr_t m_uRowBytes;			///< Bytes per row in the current pass
+	uintptr_t m_uRowFill;			///< Bytes inflated into m_pFiltered
+	uint_t m_uWidth;				///< Width of the image in pixels
+	uint_t m_uHeight;				///< Height of the image in pixels
+	uint_t m_uBytesPerPixel;		///< Bytes per pixel after decoding
+	uint_t m_uInterlaceMethod;		///< 0 for progressive, 1 for Adam7
+	uint_t m_uPass;					///< Current Adam7 pass (0-6), 7 when all rows are decoded
+	uint_t m_uPassWidth;			///< Width in pixels of the current pass
+	uint_t m_uPassHeight;			///< Height in pixels of the current pass
+	uint_t m_uPassY;				///< Row of the current pass being decoded
+	Image::ePixelTypes m_eType;		///< Pixel type of the decoded image
+	uint_t m_uStreamState;			///< State of ProcessStream()
+	uint32_t m_uStreamChunkSize;	///< Bytes remaining in the chunk being streamed
+	uint32_t m_uStreamChunkID;		///< ID of the chunk being streamed
+	uint32_t m_uStreamFill;			///< Bytes in m_StreamBuffer
+	uint8_t m_StreamBuffer[768];	///< Chunk header, IHDR or PLTE data being streamed
 	const char * BURGER_API SeekChunk(InputMemoryStream *pInput,uint32_t uID,uintptr_t uStartOffset);
+	const char * BURGER_API SetHeader(const uint8_t *pIHDR);
+	void BURGER_API SetPNGPalette(const uint8_t *pInput,uintptr_t uLength);
+	const char * BURGER_API StartRows(void);
+	void BURGER_API StartPass(void);
+	const char * BURGER_API ProcessIDAT(const uint8_t *pInput,uintptr_t uLength);
+	void BURGER_API FinishRow(void);
+	void BURGER_API ReleaseRows(void);
+	static void BURGER_API UnfilterRow(uint8_t *pOutput,const uint8_t *pInput,const uint8_t *pPrevious,uintptr_t uLength,uint_t uBytesPerPixel,uint_t uFilter);
 public:
 	enum {
 		PNG_GREYSCALE=0,		///< Each pixel is a grayscale sample.
@@ -54,6 +101,19 @@ public:
 		PNG_GREYSCALEALPHA=4,	///< Each pixel is a grayscale sample,
 		PNG_RGBA=6				///< Each pixel is an R,G,B,A quad,
 	};
+	enum {
+		SAVE_FASTEST,			///< Sub or Up filters and the fastest compression
+		SAVE_DEFAULT,			///< Best of all filters and default compression
+		SAVE_SMALLEST			///< Best of all filters and maximum compression
+	};
+	enum {
+		STREAM_SIGNATURE,		///< Waiting for the PNG signature
+		STREAM_CHUNKHEADER,		///< Waiting for a chunk length and ID
+		STREAM_CHUNKDATA,		///< Processing the data of a chunk
+		STREAM_CHUNKCRC,		///< Skipping the CRC of a chunk
+		STREAM_COMPLETE,		///< The IEND chunk was found
+		STREAM_ERROR			///< The stream had an error
+	};
 	const char * BURGER_API SeekPNGChunk(InputMemoryStream *pInput,uint32_t uID);
 	const char * BURGER_API SeekNextPNGChunk(InputMemoryStream *pInput,uint32_t uID);
 #if defined(BURGER_BIGENDIAN) || defined(DOXYGEN)
@@ -64,7 +124,15 @@ public:
 	static const uint32_t AUXTYPE = 0x656C676F;		///< 'ogle'
 #endif
 	FilePNG();
+	~FilePNG();
 	uint_t BURGER_API Load(Image *pOutput,InputMemoryStream *pInput);
+	uint_t BURGER_API Save(OutputMemoryStream *pOutput,const Image *pImage,uint_t uPreset=SAVE_DEFAULT,uint_t uThreadCount=1);
+	void BURGER_API StartStream(Image *pOutput,RowProc_t pRowProc=NULL,void *pData=NULL);
+	uint_t BURGER_API ProcessStream(const void *pInput,uintptr_t uLength);
+	BURGER_INLINE uint_t IsStreamComplete(void) const { return m_uStreamState==STREAM_COMPLETE; }
+	BURGER_INLINE uint_t GetWidth(void) const { return m_uWidth; }
+	BURGER_INLINE uint_t GetHeight(void) const { return m_uHeight; }
+	BURGER_INLINE Image::ePixelTypes GetType(void) const { return m_eType; }
 	BURGER_INLINE const RGBAWord8_t *GetPalette(void) const { return m_Palette; }
 	BURGER_INLINE RGBAWord8_t *GetPalette(void) { return m_Palette; }
 	BURGER_INLINE void SetPalette(const RGBWord8_t *pInput,uint_t uStartIndex=0,uint_t uPaletteSize=256) { CopyPalette256(m_Palette,pInput,uStartIndex,uPaletteSize); }
@@ -50,47 +50,263 @@ struct TGAHeader {				// This is the header for a TGA file
 
 #endif
 
-/*! ************************************
+/***************************************
 
-	\brief Decompress 8 bit pixels
+	Fill memory with copies of a 1 to 4 byte pixel. 16 and 32 bit pixels are
+	stored a pixel at a time, which compilers turn into wide stores. 24 bit
+	runs write the first 16 pixels directly and copy the rest from what was
+	already written, doubling each time.
 
-	\param pOutput Buffer to accept the decompressed data
-	\param uOutputLength Length of the buffer for decompressed data
-	\param pInput Data stream to read compressed data from
+***************************************/
+
+static void BURGER_API TGAFillPixels(uint8_t *pOutput,const uint8_t *pPixel,uintptr_t uCount,uint_t uPixelSize)
+{
+	if (uPixelSize==1) {
+		if (uCount>=16U) {
+			Burger::memory_set(pOutput,pPixel[0],uCount);
+		} else {
+			const uint8_t uFill = pPixel[0];
+			do {
+				pOutput[0] = uFill;
+				++pOutput;
+			} while (--uCount);
+		}
+	} else if (uPixelSize==2) {
+		const uint16_t uFill = reinterpret_cast<const uint16_t *>(pPixel)[0];
+		uint16_t *pWork = reinterpret_cast<uint16_t *>(pOutput);
+		do {
+			pWork[0] = uFill;
+			++pWork;
+		} while (--uCount);
+	} else if (uPixelSize==4) {
+		const uint32_t uFill = reinterpret_cast<const uint32_t *>(pPixel)[0];
+		uint32_t *pWork = reinterpret_cast<uint32_t *>(pOutput);
+		do {
+			pWork[0] = uFill;
+			++pWork;
+		} while (--uCount);
+	} else {
+		uintptr_t uDone = (uCount<16U) ? uCount : 16U;
+		uint8_t *pWork = pOutput;
+		uintptr_t i = uDone;
+		do {
+			pWork[0] = pPixel[0];
+			pWork[1] = pPixel[1];
+			pWork[2] = pPixel[2];
+			pWork+=3;
+		} while (--i);
+		const uintptr_t uLength = uCount*3U;
+		uDone = uDone*3U;
+		while (uDone<uLength) {
+			uintptr_t uChunk = uLength-uDone;
+			if (uChunk>uDone) {
+				uChunk = uDone;
+			}
+			Burger::memory_copy(pOutput+uDone,pOutput,uChunk);
+			uDone+=uChunk;
+		}
+	}
+}
+
+/***************************************
+
+	Copy pixels from the file, converting BGR(A) into RGB(A) and little
+	endian 16 bit pixels into native endian
 
 ***************************************/
 
-void BURGER_API Burger::FileTGA::UnpackPixel8(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput)
+static void BURGER_API TGACopyPixels(uint8_t *pOutput,const uint8_t *pInput,uintptr_t uCount,uint_t uPixelSize)
 {
-	do {
-		uintptr_t uCount = pInput->GetByte();	// Get the counter
+	if (uPixelSize==3) {
+		Burger::Image::SwapRedBlue24(pOutput,pInput,uCount);
+	} else if (uPixelSize==4) {
+		Burger::Image::SwapRedBlue32(pOutput,pInput,uCount);
+#if defined(BURGER_BIGENDIAN)
+	} else if (uPixelSize==2) {
+		do {
+			reinterpret_cast<uint16_t *>(pOutput)[0] = static_cast<uint16_t>(pInput[0]+(pInput[1]<<8U));
+			pInput+=2;
+			pOutput+=2;
+		} while (--uCount);
+#endif
+	} else {
+		uintptr_t uLength = uCount*uPixelSize;
+		if (uLength>=16U) {
+			Burger::memory_copy(pOutput,pInput,uLength);
+		} else {
+			do {
+				pOutput[0] = pInput[0];
+				++pInput;
+				++pOutput;
+			} while (--uLength);
+		}
+	}
+}
+
+/***************************************
+
+	Decompress TGA run length encoded pixels of any size from a span of
+	memory and return the number of bytes consumed.
+
+	Runs are filled a block at a time and literals are copied as a block.
+	If the input runs out, the rest of the output is zero filled, which is
+	what reading past the end of an InputMemoryStream returns.
+
+***************************************/
+
+static uintptr_t BURGER_API TGAUnpackPixels(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength,uint_t uPixelSize)
+{
+	const uint8_t *pWork = pInput;
+	const uint8_t *pEnd = pInput+uInputLength;
+	while (uOutputLength) {
+		if (pWork>=pEnd) {
+			// Out of data
+			Burger::memory_clear(pOutput,uOutputLength*uPixelSize);
+			break;
+		}
+		uintptr_t uCount = pWork[0];	// Get the counter
+		++pWork;
 		if (uCount&0x80) {					// Packed?
 			uCount = uCount-0x7F;			// Remove the high bit
 			if (uCount>uOutputLength) {		// Test for buffer overrun
 				uCount = uOutputLength;
 			}
 			uOutputLength = uOutputLength-uCount;
-			uint8_t uTemp = pInput->GetByte();	// Get the repeater
-			do {
-				pOutput[0] = uTemp;				// Fill memory
-				++pOutput;
-			} while (--uCount);
+			uint32_t Pixel[1];
+			if (static_cast<uintptr_t>(pEnd-pWork)>=uPixelSize) {
+				TGACopyPixels(reinterpret_cast<uint8_t *>(Pixel),pWork,1,uPixelSize);
+				pWork+=uPixelSize;
+			} else {
+				Pixel[0] = 0;
+				pWork = pEnd;
+			}
+			TGAFillPixels(pOutput,reinterpret_cast<const uint8_t *>(Pixel),uCount,uPixelSize);
+			pOutput+=uCount*uPixelSize;
 		} else {
 			++uCount;								// +1 to the count
+			uintptr_t uSkip = 0;
 			if (uCount>uOutputLength) {				// Test for buffer overrun
-				// Fetch the data
-				pInput->Get(pOutput,uOutputLength);
 				// Skip past the overrun (This is needed for some badly made TGA files)
-				pInput->SkipForward(uCount-uOutputLength);
-				// Force exit
-				uOutputLength = 0;
+				uSkip = (uCount-uOutputLength)*uPixelSize;
+				uCount = uOutputLength;
+			}
+			uOutputLength = uOutputLength-uCount;
+			uintptr_t uAvailable = static_cast<uintptr_t>(pEnd-pWork)/uPixelSize;
+			if (uAvailable>uCount) {
+				uAvailable = uCount;
+			}
+			if (uAvailable) {
+				TGACopyPixels(pOutput,pWork,uAvailable,uPixelSize);
+			}
+			if (uAvailable!=uCount) {
+				// Truncated, zero the rest
+				Burger::memory_clear(pOutput+(uAvailable*uPixelSize),(uCount-uAvailable)*uPixelSize);
+				pWork = pEnd;
 			} else {
-				pInput->Get(pOutput,uCount);
-				pOutput+=uCount;
-				uOutputLength = uOutputLength-uCount;	// Adjust amount
+				pWork+=uCount*uPixelSize;
+				if (uSkip>static_cast<uintptr_t>(pEnd-pWork)) {
+					uSkip = static_cast<uintptr_t>(pEnd-pWork);
+				}
+				pWork+=uSkip;
 			}
+			pOutput+=uCount*uPixelSize;
 		}
-	} while (uOutputLength);	// Is there still more?
+	}
+	return static_cast<uintptr_t>(pWork-pInput);
+}
+
+/*! ************************************
+
+	\brief Decompress 8 bit pixels from memory
+
+	\param pOutput Buffer to accept the decompressed data
+	\param uOutputLength Length of the buffer for decompressed data
+	\param pInput Pointer to the compressed data
+	\param uInputLength Number of bytes of compressed data
+	\return Number of bytes of compressed data consumed
+	\sa UnpackPixel8(uint8_t *,uintptr_t,InputMemoryStream *)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::FileTGA::UnpackPixel8(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength)
+{
+	return TGAUnpackPixels(pOutput,uOutputLength,pInput,uInputLength,1);
+}
+
+/*! ************************************
+
+	\brief Decompress 16 bit pixels from memory
+
+	Pixels are stored in native endian.
+
+	\param pOutput Buffer to accept the decompressed data
+	\param uOutputLength Length of the buffer in uint16_t for decompressed data
+	\param pInput Pointer to the compressed data
+	\param uInputLength Number of bytes of compressed data
+	\return Number of bytes of compressed data consumed
+	\sa UnpackPixel16(uint8_t *,uintptr_t,InputMemoryStream *)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::FileTGA::UnpackPixel16(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength)
+{
+	return TGAUnpackPixels(pOutput,uOutputLength,pInput,uInputLength,2);
+}
+
+/*! ************************************
+
+	\brief Decompress 24 bit pixels from memory
+
+	BGR pixels in the file are stored as RGB.
+
+	\param pOutput Buffer to accept the decompressed data
+	\param uOutputLength Length of the buffer in 24 bit chunks for decompressed data
+	\param pInput Pointer to the compressed data
+	\param uInputLength Number of bytes of compressed data
+	\return Number of bytes of compressed data consumed
+	\sa UnpackPixel24(uint8_t *,uintptr_t,InputMemoryStream *)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::FileTGA::UnpackPixel24(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength)
+{
+	return TGAUnpackPixels(pOutput,uOutputLength,pInput,uInputLength,3);
+}
+
+/*! ************************************
+
+	\brief Decompress 32 bit pixels from memory
+
+	BGRA pixels in the file are stored as RGBA.
+
+	\param pOutput Buffer to accept the decompressed data
+	\param uOutputLength Length of the buffer in 32 bit chunks for decompressed data
+	\param pInput Pointer to the compressed data
+	\param uInputLength Number of bytes of compressed data
+	\return Number of bytes of compressed data consumed
+	\sa UnpackPixel32(uint8_t *,uintptr_t,InputMemoryStream *)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::FileTGA::UnpackPixel32(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength)
+{
+	return TGAUnpackPixels(pOutput,uOutputLength,pInput,uInputLength,4);
+}
+
+/*! ************************************
+
+	\brief Decompress 8 bit pixels
+
+	\param pOutput Buffer to accept the decompressed data
+	\param uOutputLength Length of the buffer for decompressed data
+	\param pInput Data stream to read compressed data from
+	\sa UnpackPixel8(uint8_t *,uintptr_t,const uint8_t *,uintptr_t)
+
+***************************************/
+
+void BURGER_API Burger::FileTGA::UnpackPixel8(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput)
+{
+	pInput->SkipForward(UnpackPixel8(pOutput,uOutputLength,pInput->GetPtr(),pInput->BytesRemaining()));
 }
 
 /*! ************************************
@@ -100,56 +316,13 @@ void BURGER_API Burger::FileTGA::UnpackPixel8(uint8_t *pOutput,uintptr_t uOutput
 	\param pOutput Buffer to accept the decompressed data
 	\param uOutputLength Length of the buffer in uint16_t for decompressed data
 	\param pInput Data stream to read compressed data from
+	\sa UnpackPixel16(uint8_t *,uintptr_t,const uint8_t *,uintptr_t)
 
 ***************************************/
 
 void BURGER_API Burger::FileTGA::UnpackPixel16(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput)
 {
-	do {
-		uintptr_t uCount = pInput->GetByte();	// Get the counter
-		if (uCount&0x80) {					// Packed?
-			uCount = uCount-0x7F;			// Remove the high bit
-			if (uCount>uOutputLength) {		// Test for buffer overrun
-				uCount = uOutputLength;
-			}
-			uOutputLength = uOutputLength-uCount;
-			uint16_t uTemp = pInput->GetShort();	// Get the repeater
-			do {
-				reinterpret_cast<uint16_t *>(pOutput)[0] = uTemp;				// Fill memory
-				pOutput+=2;
-			} while (--uCount);
-		} else {
-			++uCount;								// +1 to the count
-			if (uCount>uOutputLength) {				// Test for buffer overrun
-#if defined(BURGER_LITTLEENDIAN)
-				// Fetch the data
-				pInput->Get(pOutput,uOutputLength*2);
-#else
-				uintptr_t uTemp = uCount;
-				do {
-					reinterpret_cast<uint16_t *>(pOutput)[0] = pInput->GetShort();
-					pOutput+=2;
-				} while (--uTemp);
-#endif
-				// Skip past the overrun (This is needed for some badly made TGA files)
-				pInput->SkipForward((uCount-uOutputLength)*2);
-				// Force exit
-				uOutputLength = 0;
-			} else {
-				uOutputLength = uOutputLength-uCount;	// Adjust amount
-#if defined(BURGER_LITTLEENDIAN)
-				pInput->Get(pOutput,uCount*2);
-				pOutput+=(uCount*2);
-#else
-				// Swap endian
-				do {
-					reinterpret_cast<uint16_t *>(pOutput)[0] = pInput->GetShort();
-					pOutput+=2;
-				} while (--uCount);
-#endif
-			}
-		}
-	} while (uOutputLength);	// Is there still more?
+	pInput->SkipForward(UnpackPixel16(pOutput,uOutputLength,pInput->GetPtr(),pInput->BytesRemaining()));
 }
 
 /*! ************************************
@@ -159,116 +332,29 @@ void BURGER_API Burger::FileTGA::UnpackPixel16(uint8_t *pOutput,uintptr_t uOutpu
 	\param pOutput Buffer to accept the decompressed data
 	\param uOutputLength Length of the buffer in 24 bit chunks for decompressed data
 	\param pInput Data stream to read compressed data from
+	\sa UnpackPixel24(uint8_t *,uintptr_t,const uint8_t *,uintptr_t)
 
 ***************************************/
 
 void BURGER_API Burger::FileTGA::UnpackPixel24(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput)
 {
-	do {
-		uintptr_t uCount = pInput->GetByte();	// Get the counter
-		if (uCount&0x80) {					// Packed?
-			uCount = uCount-0x7F;			// Remove the high bit
-			if (uCount>uOutputLength) {		// Test for buffer overrun
-				uCount = uOutputLength;
-			}
-			uOutputLength = uOutputLength-uCount;
-			uint8_t uBlue = pInput->GetByte();	// Get the 24 bit repeater
-			uint8_t uGreen = pInput->GetByte();	
-			uint8_t uRed = pInput->GetByte();
-			do {
-				pOutput[0] = uRed;				// Fill memory
-				pOutput[1] = uGreen;
-				pOutput[2] = uBlue;
-				pOutput+=3;
-			} while (--uCount);
-		} else {
-			++uCount;								// +1 to the count
-			if (uCount>uOutputLength) {				// Test for buffer overrun
-				// Fetch the data
-				uintptr_t uTemp = uOutputLength;
-				do {
-					pOutput[2] = pInput->GetByte();	// Blue
-					pOutput[1] = pInput->GetByte();	// Green
-					pOutput[0] = pInput->GetByte();	// Red
-					pOutput+=3;
-				} while (--uTemp);
-				// Skip past the overrun (This is needed for some badly made TGA files)
-				pInput->SkipForward((uCount-uOutputLength)*3);
-				// Force exit
-				uOutputLength = 0;
-			} else {
-				uOutputLength = uOutputLength-uCount;	// Adjust amount
-				do {
-					pOutput[2] = pInput->GetByte();	// Blue
-					pOutput[1] = pInput->GetByte();	// Green
-					pOutput[0] = pInput->GetByte();	// Red
-					pOutput+=3;
-				} while (--uCount);
-			}
-		}
-	} while (uOutputLength);	// Is there still more?
+	pInput->SkipForward(UnpackPixel24(pOutput,uOutputLength,pInput->GetPtr(),pInput->BytesRemaining()));
 }
 
-
 /*! ************************************
 
 	\brief Decompress 32 bit pixels
 
 	\param pOutput Buffer to accept the decompressed data
-	\param uOutputLength Length of the buffer in 24 bit chunks for decompressed data
+	\param uOutputLength Length of the buffer in 32 bit chunks for decompressed data
 	\param pInput Data stream to read compressed data from
+	\sa UnpackPixel32(uint8_t *,uintptr_t,const uint8_t *,uintptr_t)
 
 ***************************************/
 
 void BURGER_API Burger::FileTGA::UnpackPixel32(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput)
 {
-	do {
-		uintptr_t uCount = pInput->GetByte();	// Get the counter
-		if (uCount&0x80) {					// Packed?
-			uCount = uCount-0x7F;			// Remove the high bit
-			if (uCount>uOutputLength) {		// Test for buffer overrun
-				uCount = uOutputLength;
-			}
-			uOutputLength = uOutputLength-uCount;
-			uint8_t uBlue = pInput->GetByte();	// Get the 24 bit repeater
-			uint8_t uGreen = pInput->GetByte();	
-			uint8_t uRed = pInput->GetByte();
-			uint8_t uAlpha = pInput->GetByte();
-			do {
-				pOutput[0] = uRed;				// Fill memory
-				pOutput[1] = uGreen;
-				pOutput[2] = uBlue;
-				pOutput[3] = uAlpha;
-				pOutput+=4;
-			} while (--uCount);
-		} else {
-			++uCount;								// +1 to the count
-			if (uCount>uOutputLength) {				// Test for buffer overrun
-				// Fetch the data
-				uintptr_t uTemp = uOutputLength;
-				do {
-					pOutput[2] = pInput->GetByte();	// Blue
-					pOutput[1] = pInput->GetByte();	// Green
-					pOutput[0] = pInput->GetByte();	// Red
-					pOutput[3] = pInput->GetByte();	// Alpha
-					pOutput+=4;
-				} while (--uTemp);
-				// Skip past the overrun (This is needed for some badly made TGA files)
-				pInput->SkipForward((uCount-uOutputLength)*3);
-				// Force exit
-				uOutputLength = 0;
-			} else {
-				uOutputLength = uOutputLength-uCount;	// Adjust amount
-				do {
-					pOutput[2] = pInput->GetByte();	// Blue
-					pOutput[1] = pInput->GetByte();	// Green
-					pOutput[0] = pInput->GetByte();	// Red
-					pOutput[3] = pInput->GetByte();	// Alpha
-					pOutput+=4;
-				} while (--uCount);
-			}
-		}
-	} while (uOutputLength);	// Is there still more?
+	pInput->SkipForward(UnpackPixel32(pOutput,uOutputLength,pInput->GetPtr(),pInput->BytesRemaining()));
 }
 
 /*! ************************************
@@ -432,7 +518,7 @@ uint_t BURGER_API Burger::FileTGA::Load(Image *pOutput,InputMemoryStream *pInput
 					if (uImageType == TGA_RGBINDEXED) {		// Unpacked indexed data
 						pInput->Get(pOutput->GetImage(),uLength);
 					} else {								// Compressed
-						UnpackPixel8(pOutput->GetImage(),uLength,pInput);	// Decompress it
+						pInput->SkipForward(UnpackPixel8(pOutput->GetImage(),uLength,pInput->GetPtr(),pInput->BytesRemaining()));	// Decompress it
 					}
 				}
 			}
@@ -456,39 +542,39 @@ uint_t BURGER_API Burger::FileTGA::Load(Image *pOutput,InputMemoryStream *pInput
 			if (!uResult) {
 				uintptr_t uLength = uWidth*uHeight;
 				uint8_t *pDest = pOutput->GetImage();
-
-				if (uBitDepth == 15) {				// 16 bit
-					if (uImageType == TGA_RGB) {	// Unpacked?
-						do {
-							reinterpret_cast<uint16_t *>(pDest)[0] = static_cast<uint16_t>(pInput->GetShort()&0x7FFF);	// Save pixel
-							pDest=pDest+2;
-						} while (--uLength);		// All done?
-					} else {
-						UnpackPixel16(pDest,uLength,pInput);
+				const uint8_t *pSource = pInput->GetPtr();
+				uintptr_t uRemaining = pInput->BytesRemaining();
+				uint_t uPixelSize = (uBitDepth+1U)>>3U;
+				if (uImageType == TGA_RGB) {	// Unpacked?
+					uintptr_t uAvailable = uRemaining/uPixelSize;
+					if (uAvailable>uLength) {
+						uAvailable = uLength;
 					}
-				} else if (uBitDepth == 24) {
-					if (uImageType == TGA_RGB) {		// Unpacked
-						do {
-							pDest[2] = pInput->GetByte();	// Blue
-							pDest[1] = pInput->GetByte();	// Green
-							pDest[0] = pInput->GetByte();	// Red
-							pDest = pDest+3;
-						} while (--uLength);
+					if (uBitDepth == 15) {				// 16 bit
+						uintptr_t i = uAvailable;
+						while (i) {
+							reinterpret_cast<uint16_t *>(pDest)[0] = static_cast<uint16_t>((pSource[0]+(pSource[1]<<8U))&0x7FFF);	// Save pixel
+							pSource+=2;
+							pDest+=2;
+							--i;
+						}
 					} else {
-						UnpackPixel24(pDest,uLength,pInput);
+						if (uBitDepth==24) {
+							Image::SwapRedBlue24(pDest,pSource,uAvailable);
+						} else {
+							Image::SwapRedBlue32(pDest,pSource,uAvailable);
+						}
+						pDest+=uAvailable*uPixelSize;
 					}
+					// Zero out pixels missing from a truncated file
+					memory_clear(pDest,(uLength-uAvailable)*uPixelSize);
+					pInput->SkipForward(uAvailable*uPixelSize);
+				} else if (uBitDepth == 15) {
+					pInput->SkipForward(UnpackPixel16(pDest,uLength,pSource,uRemaining));
+				} else if (uBitDepth == 24) {
+					pInput->SkipForward(UnpackPixel24(pDest,uLength,pSource,uRemaining));
 				} else {
-					if (uImageType == TGA_RGB) {		// Unpacked?
-						do {
-							pDest[2] = pInput->GetByte();	// Blue
-							pDest[1] = pInput->GetByte();	// Green
-							pDest[0] = pInput->GetByte();	// Red
-							pDest[3] = pInput->GetByte();	// Alpha
-							pDest = pDest+4;
-						} while (--uLength);				// All done?
-					} else {
-						UnpackPixel32(pDest,uLength,pInput);
-					}
+					pInput->SkipForward(UnpackPixel32(pDest,uLength,pSource,uRemaining));
 				}
 			}
 		}
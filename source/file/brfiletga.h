@@ -40,6 +40,10 @@ namespace Burger {
 class FileTGA {
 	RGBAWord8_t m_Palette[256];		///< Palette found in the image
 public:
+	static uintptr_t BURGER_API UnpackPixel8(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength);
+	static uintptr_t BURGER_API UnpackPixel16(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength);
+	static uintptr_t BURGER_API UnpackPixel24(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength);
+	static uintptr_t BURGER_API UnpackPixel32(uint8_t *pOutput,uintptr_t uOutputLength,const uint8_t *pInput,uintptr_t uInputLength);
 	static void BURGER_API UnpackPixel8(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput);
 	static void BURGER_API UnpackPixel16(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput);
 	static void BURGER_API UnpackPixel24(uint8_t *pOutput,uintptr_t uOutputLength,InputMemoryStream *pInput);
@@ -578,6 +578,70 @@ Burger::FileXML::Element * BURGER_API Burger::FileXML::Root::FindElement(const c
 	return pElement;
 }
 
+/*! ************************************
+
+	\brief Traverse the linked list and find a specific named Element
+
+	Iterate over the XML objects linked list until an object of type 
+	\ref XML_ROOT is found and abort. Names are matched without case by
+	comparing the hash stored in the atom first, so the name isn't hashed and
+	most mismatches don't compare the strings.
+
+	\param rElementName Interned name of the element to look for.
+	\return \ref NULL if the element was not found or a valid pointer to the 
+		first occurrence of the an Element with the requested name.
+	\sa FindElement(const char *) const
+
+***************************************/
+
+const Burger::FileXML::Element * BURGER_API Burger::FileXML::Root::FindElement(const StringAtom &rElementName) const
+{
+	const Element *pElement = NULL;
+	if (rElementName.is_valid()) {
+		const uint32_t uHash = rElementName.get_case_hash();
+		const char *pElementName = rElementName.c_str();
+		const Generic *pGeneric = GetNext();
+		while (pGeneric->GetType()!=XML_ROOT) {
+			if (pGeneric->GetType()==XML_ELEMENT) {
+				const Element *pWork = static_cast<const Element *>(pGeneric);
+				if ((pWork->GetNameHash()==uHash) &&
+					!StringCaseCompare(pWork->GetName(),pElementName)) {
+					pElement = pWork;
+					break;
+				}
+			}
+			pGeneric = pGeneric->GetNext();
+		}
+	}
+	return pElement;
+}
+
+/*! ************************************
+
+	\brief Traverse the linked list and find a specific named Element
+
+	Iterate over the XML objects linked list until an object of type 
+	\ref XML_ROOT is found and abort. Names are matched without case by
+	comparing the hash stored in the atom first, so the name isn't hashed and
+	most mismatches don't compare the strings.
+
+	\param rElementName Interned name of the element to look for.
+	\param bAlwaysCreate \ref TRUE if the object can't be found, create an empty record instead
+	\return \ref NULL if the element was not found or a valid pointer to the 
+		first occurrence of the an Element with the requested name.
+	\sa FindElement(const char *,uint_t)
+
+***************************************/
+
+Burger::FileXML::Element * BURGER_API Burger::FileXML::Root::FindElement(const StringAtom &rElementName,uint_t bAlwaysCreate)
+{
+	Element *pElement = const_cast<Element *>(static_cast<const Root *>(this)->FindElement(rElementName));
+	if (bAlwaysCreate && !pElement && rElementName.is_valid()) {
+		pElement = AddElement(rElementName.c_str());
+	}
+	return pElement;
+}
+
 /*! ************************************
 
 	\brief Allocate memory for a new Element and append it to the end of this list.
@@ -714,6 +778,70 @@ Burger::FileXML::Attribute * BURGER_API Burger::FileXML::Root::FindAttribute(con
 	return pAttribute;
 }
 
+/*! ************************************
+
+	\brief Traverse the linked list and find a specific named Attribute
+
+	Iterate over the XML objects linked list until an object of type 
+	\ref XML_ROOT is found and abort. Names are matched without case by
+	comparing the hash stored in the atom first, so the name isn't hashed and
+	most mismatches don't compare the strings.
+
+	\param rAttributeName Interned name of the attribute to look for.
+	\return \ref NULL if the attribute was not found or a valid pointer to the 
+		occurrence of an Attribute with the requested name.
+	\sa FindAttribute(const char *) const
+
+***************************************/
+
+const Burger::FileXML::Attribute * BURGER_API Burger::FileXML::Root::FindAttribute(const StringAtom &rAttributeName) const
+{
+	const Attribute *pAttribute = NULL;
+	if (rAttributeName.is_valid()) {
+		const uint32_t uHash = rAttributeName.get_case_hash();
+		const char *pAttributeName = rAttributeName.c_str();
+		const Generic *pGeneric = GetNext();
+		while (pGeneric->GetType()!=XML_ROOT) {
+			if (pGeneric->GetType()==XML_ATTRIBUTE) {
+				const Attribute *pWork = static_cast<const Attribute *>(pGeneric);
+				if ((pWork->GetKeyHash()==uHash) &&
+					!StringCaseCompare(pWork->GetKey(),pAttributeName)) {
+					pAttribute = pWork;
+					break;
+				}
+			}
+			pGeneric = pGeneric->GetNext();
+		}
+	}
+	return pAttribute;
+}
+
+/*! ************************************
+
+	\brief Traverse the linked list and find a specific named Attribute
+
+	Iterate over the XML objects linked list until an object of type 
+	\ref XML_ROOT is found and abort. Names are matched without case by
+	comparing the hash stored in the atom first, so the name isn't hashed and
+	most mismatches don't compare the strings.
+
+	\param rAttributeName Interned name of the attribute to look for.
+	\param bAlwaysCreate \ref TRUE if the object can't be found, create an empty record instead
+	\return \ref NULL if the attribute was not found or a valid pointer to the 
+		occurrence of an Attribute with the requested name.
+	\sa FindAttribute(const char *,uint_t)
+
+***************************************/
+
+Burger::FileXML::Attribute * BURGER_API Burger::FileXML::Root::FindAttribute(const StringAtom &rAttributeName,uint_t bAlwaysCreate)
+{
+	Attribute *pAttribute = const_cast<Attribute *>(static_cast<const Root *>(this)->FindAttribute(rAttributeName));
+	if (bAlwaysCreate && !pAttribute && rAttributeName.is_valid()) {
+		pAttribute = AddAttribute(rAttributeName.c_str());
+	}
+	return pAttribute;
+}
+
 /*! ************************************
 
 	\brief Allocate memory for a new Attribute and append it to the end of this list.
@@ -1317,7 +1445,8 @@ Burger::FileXML::CData * BURGER_API Burger::FileXML::CData::new_object(const cha
 Burger::FileXML::Attribute::Attribute() :
 	Generic(XML_ATTRIBUTE),
 	m_Key(),
-	m_Value()
+	m_Value(),
+	m_uKeyHash(StringAtom::case_hash(m_Key.c_str(),0))
 {
 }
 
@@ -1349,6 +1478,7 @@ uint_t Burger::FileXML::Attribute::Parse(InputMemoryStream *pInput)
 	uintptr_t uMark = pInput->GetMark();
 	// Extract the attribute's name
 	if (!ReadXMLName(&m_Key,pInput)) {
+		m_uKeyHash = StringAtom::case_hash(m_Key.c_str(),m_Key.length());
 		pInput->ParseBeyondWhiteSpace();
 		// Locate the required '='
 		uint_t uTemp = pInput->GetByte();
@@ -1365,6 +1495,7 @@ uint_t Burger::FileXML::Attribute::Parse(InputMemoryStream *pInput)
 		pInput->SetMark(uMark);
 		m_Key.clear();
 		m_Value.clear();
+		m_uKeyHash = StringAtom::case_hash(m_Key.c_str(),0);
 	}
 	return uResult;
 }
@@ -1426,6 +1557,18 @@ uint_t Burger::FileXML::Attribute::Save(OutputMemoryStream *pOutput,uint_t /* uD
 
 ***************************************/
 
+/*! ************************************
+
+	\fn uint32_t Burger::FileXML::Attribute::GetKeyHash(void) const
+	\brief Return the case insensitive hash of the attribute's key
+
+	The hash is updated every time the key changes, it's the same value as
+	StringAtom::case_hash(const char *,uintptr_t) for the key.
+
+	\sa GetKey(void) const or Root::FindAttribute(const StringAtom &) const
+
+***************************************/
+
 
 /*! ************************************
 
@@ -2449,7 +2592,8 @@ Burger::FileXML::Element::Element() :
 	Generic(XML_ELEMENT),
 	m_Attributes(),
 	m_Root(),
-	m_Name()
+	m_Name(),
+	m_uNameHash(StringAtom::case_hash(m_Name.c_str(),0))
 {
 }
 
@@ -2464,7 +2608,8 @@ Burger::FileXML::Element::Element(const char *pName) :
 	Generic(XML_ELEMENT),
 	m_Attributes(),
 	m_Root(),
-	m_Name(pName)
+	m_Name(pName),
+	m_uNameHash(StringAtom::case_hash(m_Name.c_str(),m_Name.length()))
 {
 }
 
@@ -2499,6 +2644,7 @@ uint_t Burger::FileXML::Element::Parse(InputMemoryStream *pInput)
 	pInput->ParseBeyondWhiteSpace();
 	// Get the element's name
 	uResult = ReadXMLName(&m_Name,pInput);
+	m_uNameHash = StringAtom::case_hash(m_Name.c_str(),m_Name.length());
 	if (!uResult) {
 		uResult = TRUE;
 		for (;;) {
@@ -2651,6 +2797,29 @@ uint_t Burger::FileXML::Element::Save(OutputMemoryStream *pOutput,uint_t uDepth)
 
 ***************************************/
 
+/*! ************************************
+
+	\fn BURGER_INLINE const Element *Burger::FileXML::Element::FindElement(const StringAtom &rElementName) const
+	\brief Find an XML Element by interned name.
+
+	\param rElementName Interned name of the element to search for.
+	\return Pointer to an XML Element or \ref NULL if not found
+	\sa Root::FindElement(const StringAtom &) const
+
+***************************************/
+
+/*! ************************************
+
+	\fn BURGER_INLINE Element *Burger::FileXML::Element::FindElement(const StringAtom &rElementName,uint_t bAlwaysCreate)
+	\brief Find an XML Element by interned name.
+
+	\param rElementName Interned name of the element to search for.
+	\param bAlwaysCreate \ref TRUE to create the Element if one didn't already exist
+	\return Pointer to an XML Element or \ref NULL if not found
+	\sa Root::FindElement(const StringAtom &,uint_t)
+
+***************************************/
+
 /*! ************************************
 
 	\fn BURGER_INLINE Element *Burger::FileXML::Element::AddElement(const char *pElementName)
@@ -2709,6 +2878,29 @@ uint_t Burger::FileXML::Element::Save(OutputMemoryStream *pOutput,uint_t uDepth)
 
 ***************************************/
 
+/*! ************************************
+
+	\fn BURGER_INLINE const Attribute *Burger::FileXML::Element::FindAttribute(const StringAtom &rAttributeName) const
+	\brief Find an Attribute by interned name.
+
+	\param rAttributeName Interned name of the Attribute to search for.
+	\return Pointer to an XML Attribute or \ref NULL if not found
+	\sa Root::FindAttribute(const StringAtom &) const
+
+***************************************/
+
+/*! ************************************
+
+	\fn BURGER_INLINE Attribute *Burger::FileXML::Element::FindAttribute(const StringAtom &rAttributeName,uint_t bAlwaysCreate)
+	\brief Find an Attribute by interned name.
+
+	\param rAttributeName Interned name of the Attribute to search for.
+	\param bAlwaysCreate \ref TRUE to create the Attribute if one didn't already exist
+	\return Pointer to an XML Attribute or \ref NULL if not found
+	\sa Root::FindAttribute(const StringAtom &,uint_t)
+
+***************************************/
+
 /*! ************************************
 
 	\fn BURGER_INLINE Attribute *Burger::FileXML::Element::AddAttribute(const char *pAttributeName,const char *pValue)
@@ -2771,6 +2963,18 @@ uint_t Burger::FileXML::Element::Save(OutputMemoryStream *pOutput,uint_t uDepth)
 
 ***************************************/
 
+/*! ************************************
+
+	\fn uint32_t Burger::FileXML::Element::GetNameHash(void) const
+	\brief Return the case insensitive hash of the element's name
+
+	The hash is updated every time the name changes, it's the same value as
+	StringAtom::case_hash(const char *,uintptr_t) for the name.
+
+	\sa GetName(void) const or Root::FindElement(const StringAtom &) const
+
+***************************************/
+
 /*! ************************************
 
 	\brief Return a boolean value from the Element's RawText (\ref TRUE or \ref FALSE)
@@ -4713,6 +4917,29 @@ Burger::FileXML::Declaration * BURGER_API Burger::FileXML::AddDeclaration(float
 
 ***************************************/
 
+/*! ************************************
+
+	\fn BURGER_INLINE const Element * Burger::FileXML::FindElement(const StringAtom &rElementName) const
+	\brief Find an XML Element by interned name
+
+	\param rElementName Interned name of the element to search for.
+	\return Pointer to an XML Element or \ref NULL if not found
+	\sa Root::FindElement(const StringAtom &) const
+
+***************************************/
+
+/*! ************************************
+
+	\fn BURGER_INLINE Element * Burger::FileXML::FindElement(const StringAtom &rElementName,uint_t bAlwaysCreate)
+	\brief Find an XML Element by interned name
+
+	\param rElementName Interned name of the element to search for.
+	\param bAlwaysCreate \ref TRUE to create the Element if one didn't already exist
+	\return Pointer to an XML Element or \ref NULL if not found
+	\sa Root::FindElement(const StringAtom &,uint_t)
+
+***************************************/
+
 /*! ************************************
 
 	\fn BURGER_INLINE Element * Burger::FileXML::AddElement(const char *pElementName)
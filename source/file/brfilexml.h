@@ -31,6 +31,10 @@
 #include "brstring.h"
 #endif
 
+#ifndef __BRSTRINGATOM_H__
+#include "brstringatom.h"
+#endif
+
 #ifndef __BRFILENAME_H__
 #include "brfilename.h"
 #endif
@@ -106,11 +110,15 @@ public:
 		void BURGER_API DeleteType(eType uType);
 		const Element * BURGER_API FindElement(const char *pElementName) const;
 		Element * BURGER_API FindElement(const char *pElementName,uint_t bAlwaysCreate=FALSE);
+		const Element * BURGER_API FindElement(const StringAtom &rElementName) const;
+		Element * BURGER_API FindElement(const StringAtom &rElementName,uint_t bAlwaysCreate=FALSE);
 		Element * BURGER_API AddElement(const char *pElementName);
 		void BURGER_API DeleteElement(const char *pElementName);
 		void BURGER_API DeleteElements(const char *pElementName);
 		const Attribute * BURGER_API FindAttribute(const char *pAttributeName) const;
 		Attribute * BURGER_API FindAttribute(const char *pAttributeName,uint_t bAlwaysCreate=FALSE);
+		const Attribute * BURGER_API FindAttribute(const StringAtom &rAttributeName) const;
+		Attribute * BURGER_API FindAttribute(const StringAtom &rAttributeName,uint_t bAlwaysCreate=FALSE);
 		Attribute * BURGER_API AddAttribute(const char *pAttributeName,const char *pValue=NULL);
 		void BURGER_API DeleteAttribute(const char *pAttributeName);
 		const RawText * BURGER_API FindRawText(void) const;
@@ -152,14 +160,16 @@ public:
 	class Attribute : public Generic {
 		String m_Key;				///< Attribute keyword
 		String m_Value;				///< Value attached to the attribute
+		uint32_t m_uKeyHash;		///< Case insensitive hash of m_Key
 	public:
 		Attribute();
 		virtual ~Attribute();
 		virtual uint_t Parse(InputMemoryStream *pInput);
 		virtual uint_t Save(OutputMemoryStream *pOutput,uint_t uDepth) const;
 		BURGER_INLINE const char *GetKey(void) const { return m_Key.c_str(); }
-		BURGER_INLINE void SetKey(const char *pInput) { m_Key.assign(pInput); }
-		BURGER_INLINE void SetKey(const String *pInput) { m_Key = pInput[0]; }
+		BURGER_INLINE void SetKey(const char *pInput) { m_Key.assign(pInput); m_uKeyHash = StringAtom::case_hash(m_Key.c_str(),m_Key.length()); }
+		BURGER_INLINE void SetKey(const String *pInput) { m_Key = pInput[0]; m_uKeyHash = StringAtom::case_hash(m_Key.c_str(),m_Key.length()); }
+		BURGER_INLINE uint32_t GetKeyHash(void) const { return m_uKeyHash; }
 		BURGER_INLINE const char *GetValue(void) const { return m_Value.c_str(); }
 		BURGER_INLINE void SetValue(const char *pInput) { m_Value.assign(pInput); }
 		BURGER_INLINE void SetValue(const String *pInput) { m_Value = pInput[0]; }
@@ -234,6 +244,7 @@ public:
 		Root m_Attributes;	///< Linked list root for all attached attributes
 		Root m_Root;		///< Linked list root for all contained objects
 		String m_Name;		///< Name of the element
+		uint32_t m_uNameHash;	///< Case insensitive hash of m_Name
 	public:
 		Element();
 		Element(const char *pName);
@@ -244,15 +255,20 @@ public:
 		BURGER_INLINE const Root * GetRoot(void) const { return &m_Root; }
 		BURGER_INLINE const Element * FindElement(const char *pElementName) const { return m_Root.FindElement(pElementName); }
 		BURGER_INLINE Element * FindElement(const char *pElementName,uint_t bAlwaysCreate=FALSE) { return m_Root.FindElement(pElementName,bAlwaysCreate); }
+		BURGER_INLINE const Element * FindElement(const StringAtom &rElementName) const { return m_Root.FindElement(rElementName); }
+		BURGER_INLINE Element * FindElement(const StringAtom &rElementName,uint_t bAlwaysCreate=FALSE) { return m_Root.FindElement(rElementName,bAlwaysCreate); }
 		BURGER_INLINE Element * AddElement(const char *pElementName) { return m_Root.AddElement(pElementName); }
 		BURGER_INLINE void DeleteElement(const char *pElementName) { return m_Root.DeleteElement(pElementName); }
 		BURGER_INLINE void DeleteElements(const char *pElementName) { return m_Root.DeleteElements(pElementName); }
 		BURGER_INLINE Attribute * FindAttribute(const char *pAttributeName,uint_t bAlwaysCreate=FALSE) { return m_Attributes.FindAttribute(pAttributeName,bAlwaysCreate); }
+		BURGER_INLINE const Attribute * FindAttribute(const StringAtom &rAttributeName) const { return m_Attributes.FindAttribute(rAttributeName); }
+		BURGER_INLINE Attribute * FindAttribute(const StringAtom &rAttributeName,uint_t bAlwaysCreate=FALSE) { return m_Attributes.FindAttribute(rAttributeName,bAlwaysCreate); }
 		BURGER_INLINE Attribute * AddAttribute(const char *pAttributeName,const char *pValue=NULL) { return m_Attributes.AddAttribute(pAttributeName,pValue); }
 		BURGER_INLINE void DeleteAttribute(const char *pAttributeName) { return m_Attributes.DeleteAttribute(pAttributeName); }
 		BURGER_INLINE const char *GetName(void) const { return m_Name.c_str(); }
-		BURGER_INLINE void SetName(const char *pInput) { m_Name.assign(pInput); }
-		BURGER_INLINE void SetName(const String *pInput) { m_Name = pInput[0]; }
+		BURGER_INLINE void SetName(const char *pInput) { m_Name.assign(pInput); m_uNameHash = StringAtom::case_hash(m_Name.c_str(),m_Name.length()); }
+		BURGER_INLINE void SetName(const String *pInput) { m_Name = pInput[0]; m_uNameHash = StringAtom::case_hash(m_Name.c_str(),m_Name.length()); }
+		BURGER_INLINE uint32_t GetNameHash(void) const { return m_uNameHash; }
 		uint_t BURGER_API GetBoolean(uint_t bDefault) const;
 		void BURGER_API SetBoolean(uint_t bValue);
 		uint_t BURGER_API GetWord(uint_t uDefault,uint_t uMin=0,uint_t uMax=UINT32_MAX) const;
@@ -331,6 +347,8 @@ public:
 	BURGER_INLINE const Root * GetRoot(void) const { return &m_Root; }
 	BURGER_INLINE const Element *FindElement(const char *pElementName) const { return m_Root.FindElement(pElementName); }
 	BURGER_INLINE Element *FindElement(const char *pElementName,uint_t bAlwaysCreate=FALSE) { return m_Root.FindElement(pElementName,bAlwaysCreate); }
+	BURGER_INLINE const Element *FindElement(const StringAtom &rElementName) const { return m_Root.FindElement(rElementName); }
+	BURGER_INLINE Element *FindElement(const StringAtom &rElementName,uint_t bAlwaysCreate=FALSE) { return m_Root.FindElement(rElementName,bAlwaysCreate); }
 	BURGER_INLINE Element *AddElement(const char *pElementName) { return m_Root.AddElement(pElementName); }
 	BURGER_INLINE void DeleteElement(const char *pElementName) { m_Root.DeleteElement(pElementName); }
 	BURGER_INLINE void DeleteElements(const char *pElementName) { m_Root.DeleteElements(pElementName); }
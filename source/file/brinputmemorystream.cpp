@@ -909,6 +909,221 @@ double BURGER_API Burger::InputMemoryStream::GetBigDouble(void) BURGER_NOEXCEPT
 	return dTemp;
 }
 
+/*! ************************************
+
+	\brief Read an array of 16, 32 or 64 bit values from the data stream
+
+	The stream is bounds checked once for the entire array and the data is
+	copied and endian swapped in bulk with swap_endian(). If the stream
+	doesn't have enough data, the entries that couldn't be read are set to
+	zero and the stream is moved to the end, like the single value readers.
+
+	\param pOutput Pointer to the array to receive the values
+	\param uCount Number of values to read
+	\param uShift Size of each value as a power of two, 1, 2 or 3
+	\param bBigEndian \ref TRUE if the data in the stream is big endian
+	\return Number of values read from the stream
+
+***************************************/
+
+uintptr_t BURGER_API Burger::InputMemoryStream::GetArray(void *pOutput,uintptr_t uCount,uint_t uShift,uint_t bBigEndian) BURGER_NOEXCEPT
+{
+	const uint8_t *pWork = m_pWork;
+	uintptr_t uResult = static_cast<uintptr_t>(m_pEndOfBuffer-pWork)>>uShift;
+	if (uResult>=uCount) {
+		uResult = uCount;
+		m_pWork = pWork+(uCount<<uShift);
+	} else {
+		// Zero the values that can't be read and mark the stream as empty
+		memory_clear(static_cast<uint8_t *>(pOutput)+(uResult<<uShift),(uCount-uResult)<<uShift);
+		m_pWork = m_pEndOfBuffer;
+	}
+
+	if (uResult) {
+#if defined(BURGER_BIGENDIAN)
+		bBigEndian = !bBigEndian;
+#endif
+		// Native endian or bytes, just copy
+		if (!bBigEndian) {
+			memory_copy(pOutput,pWork,uResult<<uShift);
+		} else {
+			// The array swappers need aligned input for their scalar tails
+			if (reinterpret_cast<uintptr_t>(pWork)&((1U<<uShift)-1U)) {
+				memory_copy(pOutput,pWork,uResult<<uShift);
+				pWork = static_cast<const uint8_t *>(pOutput);
+			}
+			if (uShift==1) {
+				swap_endian(static_cast<uint16_t *>(pOutput),reinterpret_cast<const uint16_t *>(pWork),uResult);
+			} else if (uShift==2) {
+				swap_endian(static_cast<uint32_t *>(pOutput),reinterpret_cast<const uint32_t *>(pWork),uResult);
+			} else {
+				swap_endian(static_cast<uint64_t *>(pOutput),reinterpret_cast<const uint64_t *>(pWork),uResult);
+			}
+		}
+	}
+	return uResult;
+}
+
+/*! ************************************
+
+	\brief Read an array of 16 bit little endian values from the data stream
+
+	\param pOutput Pointer to the array to receive the values
+	\param uCount Number of values to read
+	\return Number of values read, entries not read are set to zero
+	\sa GetBigShortArray(uint16_t *,uintptr_t) or GetShort(void)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::InputMemoryStream::GetShortArray(uint16_t *pOutput,uintptr_t uCount) BURGER_NOEXCEPT
+{
+	return GetArray(pOutput,uCount,1,FALSE);
+}
+
+/*! ************************************
+
+	\brief Read an array of 16 bit big endian values from the data stream
+
+	\param pOutput Pointer to the array to receive the values
+	\param uCount Number of values to read
+	\return Number of values read, entries not read are set to zero
+	\sa GetShortArray(uint16_t *,uintptr_t) or GetBigShort(void)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::InputMemoryStream::GetBigShortArray(uint16_t *pOutput,uintptr_t uCount) BURGER_NOEXCEPT
+{
+	return GetArray(pOutput,uCount,1,TRUE);
+}
+
+/*! ************************************
+
+	\brief Read an array of 32 bit little endian values from the data stream
+
+	\param pOutput Pointer to the array to receive the values
+	\param uCount Number of values to read
+	\return Number of values read, entries not read are set to zero
+	\sa GetBigWord32Array(uint32_t *,uintptr_t) or GetWord32(void)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::InputMemoryStream::GetWord32Array(uint32_t *pOutput,uintptr_t uCount) BURGER_NOEXCEPT
+{
+	return GetArray(pOutput,uCount,2,FALSE);
+}
+
+/*! ************************************
+
+	\brief Read an array of 32 bit big endian values from the data stream
+
+	\param pOutput Pointer to the array to receive the values
+	\param uCount Number of values to read
+	\return Number of values read, entries not read are set to zero
+	\sa GetWord32Array(uint32_t *,uintptr_t) or GetBigWord32(void)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::InputMemoryStream::GetBigWord32Array(uint32_t *pOutput,uintptr_t uCount) BURGER_NOEXCEPT
+{
+	return GetArray(pOutput,uCount,2,TRUE);
+}
+
+/*! ************************************
+
+	\brief Read an array of 64 bit little endian values from the data stream
+
+	\param pOutput Pointer to the array to receive the values
+	\param uCount Number of values to read
+	\return Number of values read, entries not read are set to zero
+	\sa GetBigWord64Array(uint64_t *,uintptr_t) or GetWord64(void)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::InputMemoryStream::GetWord64Array(uint64_t *pOutput,uintptr_t uCount) BURGER_NOEXCEPT
+{
+	return GetArray(pOutput,uCount,3,FALSE);
+}
+
+/*! ************************************
+
+	\brief Read an array of 64 bit big endian values from the data stream
+
+	\param pOutput Pointer to the array to receive the values
+	\param uCount Number of values to read
+	\return Number of values read, entries not read are set to zero
+	\sa GetWord64Array(uint64_t *,uintptr_t) or GetBigWord64(void)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::InputMemoryStream::GetBigWord64Array(uint64_t *pOutput,uintptr_t uCount) BURGER_NOEXCEPT
+{
+	return GetArray(pOutput,uCount,3,TRUE);
+}
+
+/*! ************************************
+
+	\brief Read an array of 32 bit float little endian values from the data stream
+
+	\param pOutput Pointer to the array to receive the values
+	\param uCount Number of values to read
+	\return Number of values read, entries not read are set to zero
+	\sa GetBigFloatArray(float *,uintptr_t) or GetFloat(void)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::InputMemoryStream::GetFloatArray(float *pOutput,uintptr_t uCount) BURGER_NOEXCEPT
+{
+	return GetArray(pOutput,uCount,2,FALSE);
+}
+
+/*! ************************************
+
+	\brief Read an array of 32 bit float big endian values from the data stream
+
+	\param pOutput Pointer to the array to receive the values
+	\param uCount Number of values to read
+	\return Number of values read, entries not read are set to zero
+	\sa GetFloatArray(float *,uintptr_t) or GetBigFloat(void)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::InputMemoryStream::GetBigFloatArray(float *pOutput,uintptr_t uCount) BURGER_NOEXCEPT
+{
+	return GetArray(pOutput,uCount,2,TRUE);
+}
+
+/*! ************************************
+
+	\brief Read an array of 64 bit float little endian values from the data stream
+
+	\param pOutput Pointer to the array to receive the values
+	\param uCount Number of values to read
+	\return Number of values read, entries not read are set to zero
+	\sa GetBigDoubleArray(double *,uintptr_t) or GetDouble(void)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::InputMemoryStream::GetDoubleArray(double *pOutput,uintptr_t uCount) BURGER_NOEXCEPT
+{
+	return GetArray(pOutput,uCount,3,FALSE);
+}
+
+/*! ************************************
+
+	\brief Read an array of 64 bit float big endian values from the data stream
+
+	\param pOutput Pointer to the array to receive the values
+	\param uCount Number of values to read
+	\return Number of values read, entries not read are set to zero
+	\sa GetDoubleArray(double *,uintptr_t) or GetBigDouble(void)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::InputMemoryStream::GetBigDoubleArray(double *pOutput,uintptr_t uCount) BURGER_NOEXCEPT
+{
+	return GetArray(pOutput,uCount,3,TRUE);
+}
+
 /*! ************************************
 
 	\brief Return an unmodified array of bytes from the input stream
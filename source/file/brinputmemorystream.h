@@ -103,6 +103,16 @@ public:
     float BURGER_API GetBigFloat(void) BURGER_NOEXCEPT;
     double BURGER_API GetDouble(void) BURGER_NOEXCEPT;
     double BURGER_API GetBigDouble(void) BURGER_NOEXCEPT;
+    uintptr_t BURGER_API GetShortArray(uint16_t* pOutput, uintptr_t uCount) BURGER_NOEXCEPT;
+    uintptr_t BURGER_API GetBigShortArray(uint16_t* pOutput, uintptr_t uCount) BURGER_NOEXCEPT;
+    uintptr_t BURGER_API GetWord32Array(uint32_t* pOutput, uintptr_t uCount) BURGER_NOEXCEPT;
+    uintptr_t BURGER_API GetBigWord32Array(uint32_t* pOutput, uintptr_t uCount) BURGER_NOEXCEPT;
+    uintptr_t BURGER_API GetWord64Array(uint64_t* pOutput, uintptr_t uCount) BURGER_NOEXCEPT;
+    uintptr_t BURGER_API GetBigWord64Array(uint64_t* pOutput, uintptr_t uCount) BURGER_NOEXCEPT;
+    uintptr_t BURGER_API GetFloatArray(float* pOutput, uintptr_t uCount) BURGER_NOEXCEPT;
+    uintptr_t BURGER_API GetBigFloatArray(float* pOutput, uintptr_t uCount) BURGER_NOEXCEPT;
+    uintptr_t BURGER_API GetDoubleArray(double* pOutput, uintptr_t uCount) BURGER_NOEXCEPT;
+    uintptr_t BURGER_API GetBigDoubleArray(double* pOutput, uintptr_t uCount) BURGER_NOEXCEPT;
     uintptr_t BURGER_API Get(void* pOutput, uintptr_t uOutputSize) BURGER_NOEXCEPT;
     uint_t BURGER_API Get(RGBWord8_t* pOutput) BURGER_NOEXCEPT;
     uint_t BURGER_API Get(RGBAWord8_t* pOutput) BURGER_NOEXCEPT;
@@ -121,6 +131,9 @@ public:
     uint_t BURGER_API IsStringMatch(const char* pInput) BURGER_NOEXCEPT;
     uint_t BURGER_API IsStringMatchCase(const char* pInput) BURGER_NOEXCEPT;
     uint_t BURGER_API IsDataMatch(const uint8_t* pInput, uintptr_t uLength) BURGER_NOEXCEPT;
+
+protected:
+    uintptr_t BURGER_API GetArray(void* pOutput, uintptr_t uCount, uint_t uShift, uint_t bBigEndian) BURGER_NOEXCEPT;
 };
 }
 /* END */
@@ -18,6 +18,7 @@
 #include "brmemoryfunctions.h"
 #include "brnumberstring.h"
 #include "brpalette.h"
+#include "brstringfunctions.h"
 
 /*! ************************************
 
@@ -36,6 +37,10 @@
 	is always stored in little endian format so files created this way will be
 	cross platform.
 
+	Chunks are kept until Clear() is called, so a stream that is emptied with
+	Reset() and filled again every frame doesn't allocate memory once it has
+	grown to its working size. Reserve() allocates the chunks up front.
+
 	\sa InputMemoryStream or Chunk_t
 
 ***************************************/
@@ -51,6 +56,10 @@
 
 	Once the OutputMemoryStream is disposed of or a call to
 	OutputMemoryStream::Clear() is issued, all chunks are disposed of.
+	OutputMemoryStream::Reset() keeps them for reuse.
+
+	Chunks are not cleared when they are allocated or reused, any gap made by
+	OutputMemoryStream::SetMark() is filled with zeros instead.
 
 	\sa OutputMemoryStream
 
@@ -94,7 +103,8 @@ Burger::OutputMemoryStream::~OutputMemoryStream()
 
 ***************************************/
 Burger::OutputMemoryStream::OutputMemoryStream(
-	const OutputMemoryStream& rInput) BURGER_NOEXCEPT
+	const OutputMemoryStream& rInput) BURGER_NOEXCEPT: m_pRoot(nullptr),
+													   m_pCurrent(nullptr)
 {
 	// Now copy the memory buffers into this class
 	const Chunk_t* pChunk = rInput.m_pRoot;
@@ -273,6 +283,104 @@ void BURGER_API Burger::OutputMemoryStream::Clear(void) BURGER_NOEXCEPT
 	m_uError = kErrorNone; // Clear out the error state
 }
 
+/*! ************************************
+
+	\brief Empty the stream but keep the memory
+
+	The stream is set to zero bytes like Clear(), but all the chunks already
+	allocated are kept and will be reused by the next data appended. Use this
+	when a stream is filled again and again, such as once per frame.
+
+	\sa Clear(void) or Reserve(uintptr_t)
+
+***************************************/
+
+void BURGER_API Burger::OutputMemoryStream::Reset(void) BURGER_NOEXCEPT
+{
+	m_pCurrent = m_pRoot;
+	m_uIndex = m_pRoot ? 0 : kChunkSize;
+	m_uFileSize = 0;
+	m_uError = kErrorNone;
+}
+
+/*! ************************************
+
+	\brief Allocate enough memory to hold a stream of a specific size
+
+	Chunks are added to the end of the stream until the stream can hold
+	uSize bytes without allocating more memory. The size and contents of the
+	stream are not changed.
+
+	If memory can't be allocated, the stream is not marked as corrupt since
+	no data was lost.
+
+	\param uSize Number of bytes the stream should be able to hold
+	\return Zero if no error, \ref kErrorOutOfMemory if memory couldn't be
+		allocated.
+	\sa GetCapacity(void) const or Reset(void)
+
+***************************************/
+
+Burger::eError BURGER_API Burger::OutputMemoryStream::Reserve(
+	uintptr_t uSize) BURGER_NOEXCEPT
+{
+	eError uResult = m_uError;
+	if (!uResult && uSize) {
+		Chunk_t* pChunk = m_pCurrent;
+		if (!pChunk) {
+			// Create the first chunk
+			pChunk = static_cast<Chunk_t*>(allocate_memory(sizeof(Chunk_t)));
+			if (!pChunk) {
+				return kErrorOutOfMemory;
+			}
+			pChunk->m_pNext = nullptr;
+			pChunk->m_uMark = 0;
+			m_pRoot = pChunk;
+			m_pCurrent = pChunk;
+			m_uIndex = 0;
+		}
+
+		// Add to the end of the chain
+		while (pChunk->m_pNext) {
+			pChunk = pChunk->m_pNext;
+		}
+		while ((pChunk->m_uMark + kChunkSize) < uSize) {
+			Chunk_t* pNew =
+				static_cast<Chunk_t*>(allocate_memory(sizeof(Chunk_t)));
+			if (!pNew) {
+				uResult = kErrorOutOfMemory;
+				break;
+			}
+			pNew->m_pNext = nullptr;
+			pNew->m_uMark = pChunk->m_uMark + kChunkSize;
+			pChunk->m_pNext = pNew;
+			pChunk = pNew;
+		}
+	}
+	return uResult;
+}
+
+/*! ************************************
+
+	\brief Return the number of bytes the allocated chunks can hold
+
+	\return Size in bytes of all the chunks, zero if none are allocated
+	\sa Reserve(uintptr_t) or GetSize(void) const
+
+***************************************/
+
+uintptr_t BURGER_API Burger::OutputMemoryStream::GetCapacity(
+	void) const BURGER_NOEXCEPT
+{
+	uintptr_t uCapacity = 0;
+	const Chunk_t* pChunk = m_pRoot;
+	while (pChunk) {
+		uCapacity += kChunkSize;
+		pChunk = pChunk->m_pNext;
+	}
+	return uCapacity;
+}
+
 /*! ************************************
 
 	\fn Burger::OutputMemoryStream::GetSize(void) const
@@ -315,7 +423,8 @@ void BURGER_API Burger::OutputMemoryStream::Clear(void) BURGER_NOEXCEPT
 	\brief Set the current write mark.
 
 	Set the write mark. If it's beyond the existing write buffer, expand the
-	buffer to accommodate and adjust the buffer length.
+	buffer to accommodate and adjust the buffer length. The new space is
+	filled with zeros.
 
 	\return Zero if no error, non-zero if memory couldn't be allocated.
 	\sa GetMark(void) const
@@ -365,64 +474,10 @@ Burger::eError BURGER_API Burger::OutputMemoryStream::SetMark(
 			}
 		} else {
 
-			// The mark is beyond the end of the buffer. In this case, add
-			// chunks until the mark is reached
-
-			Chunk_t* pChunk = m_pCurrent;
-			if (!pChunk) {
-				// Make sure there is at least one chunk
-				Append(static_cast<uint8_t>(0));
-				pChunk = m_pCurrent;
-			}
-
-			// If it's m_pCurrent==NULL at this point, it means that the
-			// Append() above failed and the code should exit immediately.
-
-			if (pChunk) {
-
-				// Traverse to the end of the chain.
-				Chunk_t* pNext = pChunk->m_pNext;
-				if (pNext) {
-					do {
-						// Save the last known good
-						pChunk = pNext;
-						// Next one
-						pNext = pChunk->m_pNext;
-					} while (pNext);
-				}
-
-				// At this point, pChunk is pointing to the last record of the
-				// linked list.
-
-				do {
-					// On this chunk?
-					if ((pChunk->m_uMark + kChunkSize) >= uMark) {
-
-						// Update the mark information
-						// Extend the file mark to this point
-						m_uFileSize = uMark;
-						// Ensure the current record is correct
-						m_pCurrent = pChunk;
-						// Can be kChunkSize, this is okay
-						m_uIndex = uMark - pChunk->m_uMark;
-						break;
-					}
-
-					// Since pChunk is the end of the list,
-					// allocations are performed to extend the list
-
-					// Force an allocation
-					m_uIndex = kChunkSize;
-
-					// Add a chunk by appending a byte
-					Append(static_cast<uint8_t>(0));
-
-					// Continue where we left off
-					pChunk = m_pCurrent;
-
-					// Keep looping if there was no error
-				} while (m_uError == Burger::kErrorNone);
-			}
+			// The mark is beyond the end of the buffer. In this case, move to
+			// the end of the data and pad with zeros until the mark is reached
+			SetMark(m_uFileSize);
+			Write(nullptr, uMark - m_uFileSize);
 		}
 	}
 	return m_uError;
@@ -475,27 +530,7 @@ Burger::eError BURGER_API Burger::OutputMemoryStream::SaveFile(
 		uResult = FileRef.open(pFilename, File::kWriteOnly);
 		// File opened fine?
 		if (!uResult) {
-			// Assume success
-			uintptr_t uRemaining = m_uFileSize;
-			if (uRemaining) {
-				const Chunk_t* pChunk = m_pRoot;
-				do {
-					uintptr_t uChunkSize = kChunkSize;
-					if (uRemaining < uChunkSize) {
-						uChunkSize = uRemaining;
-					}
-					if (FileRef.write(pChunk->m_Buffer, uChunkSize) !=
-						uChunkSize) {
-						// File error! But not a state error
-						// so don't update m_uError
-						uResult = kErrorWriteFailure;
-						break;
-					}
-					pChunk = pChunk->m_pNext;
-					// All done?
-					uRemaining -= uChunkSize;
-				} while (uRemaining);
-			}
+			uResult = Save(&FileRef);
 			// Close the file
 			FileRef.close();
 		}
@@ -528,29 +563,63 @@ Burger::eError BURGER_API Burger::OutputMemoryStream::SaveFile(
 		uResult = FileRef.open(pFilename, File::kWriteOnly);
 		// File opened fine?
 		if (!uResult) {
-			// Assume success
-			uintptr_t uRemaining = m_uFileSize;
-			if (uRemaining) {
-				const Chunk_t* pChunk = m_pRoot;
+			uResult = Save(&FileRef);
+			// Close the file
+			FileRef.close();
+		}
+	}
+	// Return the error code
+	return uResult;
+}
+
+/*! ************************************
+
+	\brief Write the data into an open file
+
+	The chunks are written in place with File::write_gather(), so the data
+	is never copied into a single buffer and large streams are written with
+	very few calls to the operating system.
+
+	\param pOutput Pointer to a File opened for writing
+	\return Error code with zero being no error, non-zero is an error condition
+	\sa SaveFile(const char *) const or SaveFile(Filename *) const
+
+***************************************/
+
+Burger::eError BURGER_API Burger::OutputMemoryStream::Save(
+	File* pOutput) const BURGER_NOEXCEPT
+{
+	// Are we in a good state?
+	eError uResult = m_uError;
+	if (!uResult) {
+		uintptr_t uRemaining = m_uFileSize;
+		if (uRemaining) {
+			File::IOVector_t Vectors[32];
+			const Chunk_t* pChunk = m_pRoot;
+			do {
+				// Gather as many chunks as will fit
+				uintptr_t uCount = 0;
+				uintptr_t uBatchSize = 0;
 				do {
 					uintptr_t uChunkSize = kChunkSize;
 					if (uRemaining < uChunkSize) {
 						uChunkSize = uRemaining;
 					}
-					if (FileRef.write(pChunk->m_Buffer, uChunkSize) !=
-						uChunkSize) {
-						// File error! But not a state error
-						// so don't update m_uError
-						uResult = kErrorWriteFailure;
-						break;
-					}
-					pChunk = pChunk->m_pNext;
-					// All done?
+					Vectors[uCount].m_pData = pChunk->m_Buffer;
+					Vectors[uCount].m_uLength = uChunkSize;
+					++uCount;
+					uBatchSize += uChunkSize;
 					uRemaining -= uChunkSize;
-				} while (uRemaining);
-			}
-			// Close the file
-			FileRef.close();
+					pChunk = pChunk->m_pNext;
+				} while (uRemaining && (uCount < BURGER_ARRAYSIZE(Vectors)));
+
+				if (pOutput->write_gather(Vectors, uCount) != uBatchSize) {
+					// File error! But not a state error
+					// so don't update m_uError
+					uResult = kErrorWriteFailure;
+					break;
+				}
+			} while (uRemaining);
 		}
 	}
 	// Return the error code
@@ -693,6 +762,39 @@ void* BURGER_API Burger::OutputMemoryStream::Flatten(
 	return pResult;
 }
 
+/*! ************************************
+
+	\brief Get the data without copying it
+
+	If all of the data is in the first chunk, return a pointer to it so it can
+	be used in place. The pointer is valid until the stream is modified or
+	destroyed.
+
+	\note If the data spans more than one chunk, \ref nullptr is returned and
+	Flatten(uintptr_t *) const has to be used instead.
+
+	\param pLength Pointer to receive the size of the data, can be
+		\ref nullptr
+	\return Pointer to the data or \ref nullptr if empty, corrupt or not in a
+		single chunk
+
+***************************************/
+
+const void* BURGER_API Burger::OutputMemoryStream::GetFlatData(
+	uintptr_t* pLength) const BURGER_NOEXCEPT
+{
+	const void* pResult = nullptr;
+	uintptr_t uLength = 0;
+	if (!m_uError && m_uFileSize && (m_uFileSize <= kChunkSize)) {
+		pResult = m_pRoot->m_Buffer;
+		uLength = m_uFileSize;
+	}
+	if (pLength) {
+		pLength[0] = uLength;
+	}
+	return pResult;
+}
+
 /*! ************************************
 
 	\brief Add a text character to the data stream
@@ -747,17 +849,17 @@ Burger::eError BURGER_API Burger::OutputMemoryStream::Append(
 {
 	// Start with no error
 	if (pString) {
-		// Output a character at a time to allow \n
-		// to be converted to \r or \n\r depending
-		// on platform
-		char Temp = pString[0];
-		if (Temp) {
-			do {
-				++pString;
-				Append(Temp);
-				Temp = pString[0];
-			} while (Temp);
+		// Copy the text between line feeds in bulk and pass each line feed
+		// to Append(char) to be converted to \r or \n\r depending on
+		// platform
+		const char* pEnd = StringCharacter(pString, '\n');
+		while (pEnd) {
+			Write(pString, static_cast<uintptr_t>(pEnd - pString));
+			Append('\n');
+			pString = pEnd + 1;
+			pEnd = StringCharacter(pString, '\n');
 		}
+		Write(pString, string_length(pString));
 	}
 	// Return 0 or error code
 	return m_uError;
@@ -866,82 +968,28 @@ Burger::eError BURGER_API Burger::OutputMemoryStream::Append(
 	uintptr_t uIndex = m_uIndex;
 	Chunk_t* pChunk = m_pCurrent;
 
-	// Fast case, space for the data already exists
-	if (uIndex < kChunkSize) {
-		// Store the data
-		pChunk->m_Buffer[uIndex] = uInput;
-		++uIndex;
-		// Update the index
-		m_uIndex = uIndex;
-
-		// Did the end of file move?
-		uIndex += pChunk->m_uMark; // Get the mark + the number of bytes used
-		if (m_uFileSize < uIndex) {
-			// Update it
-			m_uFileSize = uIndex;
-		}
-		// All done!
-		return m_uError;
-	}
-
-	// Check if there is already another chunk allocated
-	// This occurs if the write mark was moved backwards
-
-	if (pChunk) {
-		Chunk_t* pNext = pChunk->m_pNext;
-		if (pNext) {
-			pNext->m_Buffer[0] = uInput;
-
-			// Update the working chunk data
-			m_pCurrent = pNext;
-			m_uIndex = 1;
-
-			// Did the end of file move?
-			// Get the mark + the number of bytes used
-			uIndex = pNext->m_uMark + 1;
-			if (m_uFileSize < uIndex) {
-				// Update it
-				m_uFileSize = uIndex;
-			}
-			// All done!
+	// Is there space for the data?
+	if (uIndex >= kChunkSize) {
+		// Go to the next chunk, allocating it if needed
+		pChunk = NextChunk();
+		if (!pChunk) {
+			// Error!!! Data is corrupt from now on!
 			return m_uError;
 		}
+		uIndex = 0;
 	}
 
-	// Looks like another buffer is needed
-	// Make sure it's cleared out in case the mark is skipped ahead
-	Chunk_t* pNewChunk = static_cast<Chunk_t*>(allocate_memory_clear(sizeof(Chunk_t)));
-	if (!pNewChunk) {
-		// Error!!! Data is corrupt from now on!
-		m_uError = kErrorOutOfMemory;
-
-	} else {
-
-		// Initialize the buffer with the next link (NULL)
-		// pNext->m_pNext = NULL;		// Already cleared
-
-		// Insert the byte to save
-		m_uIndex = 1;
-		pNewChunk->m_Buffer[0] = uInput;
-
-		// Is this the first buffer? If so, make it the root.
-		m_pCurrent = pNewChunk;
-		if (!pChunk) {
-			// pNext->m_uMark = 0;			// Already cleared
-			m_pRoot = pNewChunk;
-		} else {
-			// Set the new mark
-			pNewChunk->m_uMark = pChunk->m_uMark + kChunkSize;
-			// Insert this pointer into the linked list for later disposal
-			pChunk->m_pNext = pNewChunk;
-		}
-
-		// Did the end of file move?
-		uIndex = pNewChunk->m_uMark + 1;
-		if (m_uFileSize < uIndex) {
-			// Update it
-			m_uFileSize = uIndex;
-		}
+	// Store the data
+	pChunk->m_Buffer[uIndex] = uInput;
+	++uIndex;
+	// Update the index
+	m_uIndex = uIndex;
+
+	// Did the end of file move?
+	uIndex += pChunk->m_uMark; // Get the mark + the number of bytes used
+	if (m_uFileSize < uIndex) {
+		// Update it
+		m_uFileSize = uIndex;
 	}
 	return m_uError;
 }
@@ -1189,13 +1237,8 @@ Burger::eError BURGER_API Burger::OutputMemoryStream::Append(
 	const void* pData, uintptr_t uSize) BURGER_NOEXCEPT
 {
 	// Start with no error
-	if (pData && uSize) {
-		// Let's add the data
-		do {
-			Append(static_cast<const uint8_t*>(pData)[0]);
-			pData = static_cast<const uint8_t*>(pData) + 1;
-			// Continue?
-		} while (--uSize);
+	if (pData) {
+		Write(pData, uSize);
 	}
 	// Return 0 or error code
 	return m_uError;
@@ -1649,3 +1692,93 @@ Burger::eError BURGER_API Burger::OutputMemoryStream::Overwrite(
 	// Return the error code
 	return uResult;
 }
+
+/*! ************************************
+
+	\brief Move to the start of the next chunk
+
+	If there is already a chunk after the current one, it's reused, otherwise
+	a new chunk is allocated and added to the end of the list.
+
+	\return Pointer to the new current chunk or \ref nullptr if out of memory
+
+***************************************/
+
+Burger::OutputMemoryStream::Chunk_t* BURGER_API
+Burger::OutputMemoryStream::NextChunk(void) BURGER_NOEXCEPT
+{
+	Chunk_t* pChunk = m_pCurrent;
+
+	// Check if there is already another chunk allocated
+	// This occurs if the write mark was moved backwards or the memory was
+	// kept by Reset() or Reserve()
+	Chunk_t* pNext = pChunk ? pChunk->m_pNext : nullptr;
+	if (!pNext) {
+		pNext = static_cast<Chunk_t*>(allocate_memory(sizeof(Chunk_t)));
+		if (!pNext) {
+			m_uError = kErrorOutOfMemory;
+			return nullptr;
+		}
+		pNext->m_pNext = nullptr;
+
+		// Is this the first buffer? If so, make it the root.
+		if (!pChunk) {
+			pNext->m_uMark = 0;
+			m_pRoot = pNext;
+		} else {
+			// Set the new mark
+			pNext->m_uMark = pChunk->m_uMark + kChunkSize;
+			// Insert this pointer into the linked list for later disposal
+			pChunk->m_pNext = pNext;
+		}
+	}
+	m_pCurrent = pNext;
+	m_uIndex = 0;
+	return pNext;
+}
+
+/*! ************************************
+
+	\brief Copy data into the stream a chunk at a time
+
+	\param pInput Pointer to the data, or \ref nullptr to write zeros
+	\param uSize Number of bytes to write
+
+***************************************/
+
+void BURGER_API Burger::OutputMemoryStream::Write(
+	const void* pInput, uintptr_t uSize) BURGER_NOEXCEPT
+{
+	while (uSize) {
+		uintptr_t uIndex = m_uIndex;
+		Chunk_t* pChunk = m_pCurrent;
+		if (uIndex >= kChunkSize) {
+			pChunk = NextChunk();
+			if (!pChunk) {
+				break;
+			}
+			uIndex = 0;
+		}
+
+		// Fill as much of this chunk as possible
+		uintptr_t uChunkSize = kChunkSize - uIndex;
+		if (uChunkSize > uSize) {
+			uChunkSize = uSize;
+		}
+		if (pInput) {
+			memory_copy(&pChunk->m_Buffer[uIndex], pInput, uChunkSize);
+			pInput = static_cast<const uint8_t*>(pInput) + uChunkSize;
+		} else {
+			memory_clear(&pChunk->m_Buffer[uIndex], uChunkSize);
+		}
+		uSize -= uChunkSize;
+		uIndex += uChunkSize;
+		m_uIndex = uIndex;
+
+		// Did the end of file move?
+		uIndex += pChunk->m_uMark;
+		if (m_uFileSize < uIndex) {
+			m_uFileSize = uIndex;
+		}
+	}
+}
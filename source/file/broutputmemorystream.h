@@ -33,6 +33,7 @@
 
 /* BEGIN */
 namespace Burger {
+class File;
 class OutputMemoryStream {
 public:
 	/** Size of each data chunk */
@@ -65,6 +66,9 @@ public:
 #endif
 
 	void BURGER_API Clear(void) BURGER_NOEXCEPT;
+	void BURGER_API Reset(void) BURGER_NOEXCEPT;
+	eError BURGER_API Reserve(uintptr_t uSize) BURGER_NOEXCEPT;
+	uintptr_t BURGER_API GetCapacity(void) const BURGER_NOEXCEPT;
 	BURGER_INLINE uintptr_t GetSize(void) const BURGER_NOEXCEPT
 	{
 		return m_uFileSize;
@@ -81,10 +85,13 @@ public:
 	uintptr_t BURGER_API GetMark(void) const BURGER_NOEXCEPT;
 	eError BURGER_API SaveFile(const char* pFilename) const BURGER_NOEXCEPT;
 	eError BURGER_API SaveFile(Filename* pFilename) const BURGER_NOEXCEPT;
+	eError BURGER_API Save(File* pOutput) const BURGER_NOEXCEPT;
 	eError BURGER_API Save(String* pOutput) const BURGER_NOEXCEPT;
 	eError BURGER_API Flatten(
 		void* pOutput, uintptr_t uLength) const BURGER_NOEXCEPT;
 	void* BURGER_API Flatten(uintptr_t* pLength) const BURGER_NOEXCEPT;
+	const void* BURGER_API GetFlatData(
+		uintptr_t* pLength) const BURGER_NOEXCEPT;
 	eError BURGER_API Append(char iChar) BURGER_NOEXCEPT;
 	eError BURGER_API Append(const char* pString) BURGER_NOEXCEPT;
 	eError BURGER_API AppendCString(const char* pString) BURGER_NOEXCEPT;
@@ -131,6 +138,10 @@ public:
 		const void* pInput, uintptr_t uLength) const BURGER_NOEXCEPT;
 	eError BURGER_API Overwrite(const void* pInput, uintptr_t uLength,
 		uintptr_t uOffset) BURGER_NOEXCEPT;
+
+private:
+	Chunk_t* BURGER_API NextChunk(void) BURGER_NOEXCEPT;
+	void BURGER_API Write(const void* pInput, uintptr_t uSize) BURGER_NOEXCEPT;
 };
 }
 /* END */
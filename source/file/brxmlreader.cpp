@@ -0,0 +1,1320 @@
+/***************************************
+
+	Zero copy XML pull parser
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#include "brxmlreader.h"
+#include "brglobalmemorymanager.h"
+#include "brmemoryfunctions.h"
+#include "brstringfunctions.h"
+#include "brutf8.h"
+
+/***************************************
+
+	\brief Skip over XML whitespace
+
+***************************************/
+
+static const char* SkipXMLSpace(
+	const char* pInput, const char* pEnd) BURGER_NOEXCEPT
+{
+	while ((pInput < pEnd) &&
+		(Burger::g_AsciiTestTable[static_cast<uint8_t>(pInput[0])] &
+			Burger::ASCII_SPACE)) {
+		++pInput;
+	}
+	return pInput;
+}
+
+/***************************************
+
+	\brief Remove whitespace from both ends of a text range
+
+***************************************/
+
+static void TrimXMLText(Burger::XMLReader::Text_t* pOutput, const char* pInput,
+	const char* pEnd) BURGER_NOEXCEPT
+{
+	pInput = SkipXMLSpace(pInput, pEnd);
+	while ((pEnd > pInput) &&
+		(Burger::g_AsciiTestTable[static_cast<uint8_t>(pEnd[-1])] &
+			Burger::ASCII_SPACE)) {
+		--pEnd;
+	}
+	pOutput->m_pText = pInput;
+	pOutput->m_uLength = static_cast<uintptr_t>(pEnd - pInput);
+}
+
+/***************************************
+
+	\brief Find a multiple character token
+
+	Return a pointer to the token or \ref nullptr if not found.
+
+***************************************/
+
+static const char* FindXMLToken(const char* pInput, const char* pEnd,
+	const char* pToken, uintptr_t uTokenLength) BURGER_NOEXCEPT
+{
+	const int iFirst = pToken[0];
+	while (static_cast<uintptr_t>(pEnd - pInput) >= uTokenLength) {
+		// Let the fast character search find the candidates
+		const char* pFound = Burger::MemoryCharacter(pInput,
+			static_cast<uintptr_t>(pEnd - pInput) - (uTokenLength - 1), iFirst);
+		if (!pFound) {
+			break;
+		}
+		if (!Burger::MemoryCompare(pFound + 1, pToken + 1, uTokenLength - 1)) {
+			return pFound;
+		}
+		pInput = pFound + 1;
+	}
+	return nullptr;
+}
+
+/*! ************************************
+
+	\class Burger::XMLReader
+	\brief Zero copy XML pull parser
+
+	Unlike Burger::FileXML, which creates an object for every element,
+	attribute and block of text, this class walks over a buffer of XML text
+	and returns one event at a time. No memory is allocated for nodes, names
+	or text; they are returned as XMLReader::Text_t records that point into
+	the source buffer, which must stay valid while the reader is in use.
+
+	Entities like &amp;amp; are not decoded during parsing. Call
+	decode(char *,const Text_t &) or decode(String *,const Text_t &) only on
+	the text that's needed.
+
+	The only memory allocated is the stack of open element names, used to
+	verify that end tags match. It starts at \ref kStackStartSize entries and
+	doubles as needed.
+
+	\code
+	Burger::XMLReader Reader(pBuffer, uLength);
+	Burger::XMLReader::eEvent uEvent;
+	while ((uEvent = Reader.next()) > Burger::XMLReader::kEventError) {
+		if ((uEvent == Burger::XMLReader::kEventStartElement) &&
+			Burger::XMLReader::is_match(Reader.get_name(), "Config")) {
+			Burger::XMLReader::Attribute_t Attribute;
+			while (Reader.next_attribute(&Attribute)) {
+				// Process the attribute
+			}
+		}
+	}
+	\endcode
+
+	\sa XMLDocument or FileXML
+
+***************************************/
+
+/*! ************************************
+
+	\enum Burger::XMLReader::eEvent
+	\brief Events returned by next()
+
+***************************************/
+
+/*! ************************************
+
+	\struct Burger::XMLReader::Text_t
+	\brief Text inside the source buffer
+
+	Text is not zero terminated and entities are not decoded.
+
+	\sa decode(String *,const Text_t &)
+
+***************************************/
+
+/*! ************************************
+
+	\struct Burger::XMLReader::Attribute_t
+	\brief Attribute key and value
+
+	\sa next_attribute(Attribute_t *)
+
+***************************************/
+
+/*! ************************************
+
+	\brief Create an empty reader
+
+	next() will return \ref kEventEndOfDocument until init() is called.
+
+***************************************/
+
+Burger::XMLReader::XMLReader() BURGER_NOEXCEPT: m_pStack(nullptr),
+												 m_uStackSize(0)
+{
+	init(nullptr, 0);
+}
+
+/*! ************************************
+
+	\brief Create a reader for a buffer of XML text
+
+	\param pInput Pointer to the XML text, it is not copied
+	\param uLength Length of the XML text in bytes
+
+***************************************/
+
+Burger::XMLReader::XMLReader(const char* pInput, uintptr_t uLength)
+	BURGER_NOEXCEPT: m_pStack(nullptr),
+					 m_uStackSize(0)
+{
+	init(pInput, uLength);
+}
+
+/*! ************************************
+
+	\brief Release the element name stack
+
+***************************************/
+
+Burger::XMLReader::~XMLReader()
+{
+	free_memory(m_pStack);
+}
+
+/*! ************************************
+
+	\brief Start reading a buffer of XML text
+
+	Reset the reader to the start of the text. A UTF-8 byte order mark is
+	skipped. Parsing stops at the end of the buffer or at a zero byte.
+
+	\param pInput Pointer to the XML text, it is not copied
+	\param uLength Length of the XML text in bytes
+
+***************************************/
+
+void BURGER_API Burger::XMLReader::init(
+	const char* pInput, uintptr_t uLength) BURGER_NOEXCEPT
+{
+	if (!pInput) {
+		pInput = g_EmptyString;
+		uLength = 0;
+	}
+	m_pStart = pInput;
+	m_pEnd = pInput + uLength;
+
+	// Skip the UTF-8 byte order mark
+	if ((uLength >= 3) && !MemoryCompare(pInput, "\xEF\xBB\xBF", 3)) {
+		pInput += 3;
+	}
+	m_pCurrent = pInput;
+	m_uDepth = 0;
+	m_Name.m_pText = pInput;
+	m_Name.m_uLength = 0;
+	m_Text = m_Name;
+	m_pAttributes = pInput;
+	m_pAttributeCursor = pInput;
+	m_pAttributesEnd = pInput;
+	m_uAttributeCount = 0;
+	m_uEvent = kEventEndOfDocument;
+	m_uError = kErrorNone;
+	m_bEmptyElement = FALSE;
+}
+
+/*! ************************************
+
+	\brief Start reading the XML text in a stream
+
+	The remaining data in the stream is parsed. The stream's position is not
+	changed and the stream must not be released while the reader is in use.
+
+	\param pInput Pointer to a stream with XML text
+
+***************************************/
+
+void BURGER_API Burger::XMLReader::init(
+	InputMemoryStream* pInput) BURGER_NOEXCEPT
+{
+	init(reinterpret_cast<const char*>(pInput->GetPtr()),
+		pInput->BytesRemaining());
+}
+
+/*! ************************************
+
+	\brief Parse the next XML event
+
+	Skip to the next item in the XML text and return what it is. Use the
+	accessor functions to get the name, text or attributes of the item.
+
+	An empty element like &lt;name/&gt; returns \ref kEventStartElement
+	followed by \ref kEventEndElement.
+
+	Once \ref kEventEndOfDocument or \ref kEventError is returned, all
+	further calls will return the same value.
+
+	\return The type of item found
+
+	\sa get_name(void) const, get_text(void) const or
+		next_attribute(Attribute_t *)
+
+***************************************/
+
+Burger::XMLReader::eEvent BURGER_API Burger::XMLReader::next(
+	void) BURGER_NOEXCEPT
+{
+	// The end of an empty element is pending
+	if (m_bEmptyElement) {
+		m_bEmptyElement = FALSE;
+		--m_uDepth;
+		m_uAttributeCount = 0;
+		m_pAttributes = m_pAttributesEnd;
+		m_pAttributeCursor = m_pAttributesEnd;
+		m_uEvent = kEventEndElement;
+		return kEventEndElement;
+	}
+	if (m_uEvent == kEventError) {
+		return kEventError;
+	}
+
+	// Reset the attributes
+	m_uAttributeCount = 0;
+	m_pAttributes = m_pAttributeCursor = m_pAttributesEnd = m_pCurrent;
+
+	const char* pEnd = m_pEnd;
+	for (;;) {
+		const char* pWork = SkipXMLSpace(m_pCurrent, pEnd);
+		m_pCurrent = pWork;
+
+		// End of data?
+		if ((pWork >= pEnd) || !pWork[0]) {
+			if (m_uDepth) {
+				// An element is missing its end tag
+				return set_error(kErrorDataCorruption);
+			}
+			m_uEvent = kEventEndOfDocument;
+			return kEventEndOfDocument;
+		}
+
+		// Text?
+		if (pWork[0] != '<') {
+			// Text outside of an element is not allowed
+			if (!m_uDepth) {
+				return set_error(kErrorDataCorruption);
+			}
+			const char* pTextEnd = MemoryCharacter(
+				pWork, static_cast<uintptr_t>(pEnd - pWork), '<');
+			if (!pTextEnd) {
+				return set_error(kErrorDataCorruption);
+			}
+			TrimXMLText(&m_Text, pWork, pTextEnd);
+			m_pCurrent = pTextEnd;
+			m_uEvent = kEventText;
+			return kEventText;
+		}
+
+		// Accept the '<'
+		++pWork;
+		const uintptr_t uRemaining = static_cast<uintptr_t>(pEnd - pWork);
+		if (!uRemaining) {
+			return set_error(kErrorDataCorruption);
+		}
+		const uint_t uTemp = static_cast<uint8_t>(pWork[0]);
+		if (uTemp == '/') {
+			return parse_end_element(pWork + 1);
+		}
+		if (uTemp == '?') {
+			return parse_declaration(pWork + 1);
+		}
+		if (uTemp != '!') {
+			return parse_start_element(pWork);
+		}
+
+		// Comment?
+		if ((uRemaining >= 3) && !MemoryCompare(pWork, "!--", 3)) {
+			pWork += 3;
+			const char* pFound = FindXMLToken(pWork, pEnd, "-->", 3);
+			if (!pFound) {
+				return set_error(kErrorDataCorruption);
+			}
+			m_Text.m_pText = pWork;
+			m_Text.m_uLength = static_cast<uintptr_t>(pFound - pWork);
+			m_pCurrent = pFound + 3;
+			m_uEvent = kEventComment;
+			return kEventComment;
+		}
+
+		// Character data?
+		if ((uRemaining >= 8) && !MemoryCompare(pWork, "![CDATA[", 8)) {
+			pWork += 8;
+			const char* pFound = FindXMLToken(pWork, pEnd, "]]>", 3);
+			if (!pFound) {
+				return set_error(kErrorDataCorruption);
+			}
+			m_Text.m_pText = pWork;
+			m_Text.m_uLength = static_cast<uintptr_t>(pFound - pWork);
+			m_pCurrent = pFound + 3;
+			m_uEvent = kEventCData;
+			return kEventCData;
+		}
+		return parse_doctype(pWork + 1);
+	}
+}
+
+/*! ************************************
+
+	\brief Iterate over the attributes of the current item
+
+	Return the attributes of the current element or declaration in order.
+	Each call returns the next attribute until there are no more.
+
+	\param pOutput Pointer to a record to receive the attribute
+	\return \ref TRUE if an attribute was returned, \ref FALSE if no more
+
+	\sa find_attribute(Attribute_t *, const char *) const
+
+***************************************/
+
+uint_t BURGER_API Burger::XMLReader::next_attribute(
+	Attribute_t* pOutput) BURGER_NOEXCEPT
+{
+	const char* pWork = SkipXMLSpace(m_pAttributeCursor, m_pAttributesEnd);
+	if (pWork < m_pAttributesEnd) {
+		pWork = parse_attribute(pOutput, pWork, m_pAttributesEnd);
+		if (pWork) {
+			m_pAttributeCursor = pWork;
+			return TRUE;
+		}
+	}
+	m_pAttributeCursor = m_pAttributesEnd;
+	return FALSE;
+}
+
+/*! ************************************
+
+	\brief Find an attribute of the current item by name
+
+	Scan the attributes of the current element or declaration for a key
+	using a case insensitive compare, like FileXML does. This doesn't change
+	the iteration of next_attribute(Attribute_t *).
+
+	\param pOutput Pointer to a record to receive the attribute
+	\param pKey Pointer to a "C" string with the name of the attribute
+	\return \ref TRUE if found, \ref FALSE if not
+
+***************************************/
+
+uint_t BURGER_API Burger::XMLReader::find_attribute(
+	Attribute_t* pOutput, const char* pKey) const BURGER_NOEXCEPT
+{
+	const char* pWork = m_pAttributes;
+	const char* pEnd = m_pAttributesEnd;
+	for (;;) {
+		pWork = SkipXMLSpace(pWork, pEnd);
+		if (pWork >= pEnd) {
+			break;
+		}
+		pWork = parse_attribute(pOutput, pWork, pEnd);
+		if (!pWork) {
+			break;
+		}
+		if (is_match(pOutput->m_Key, pKey)) {
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/*! ************************************
+
+	\brief Return the line number of the parse position
+
+	The lines are counted on every call, so this is meant for error
+	reporting.
+
+	\return Line number starting at 1
+
+***************************************/
+
+uintptr_t BURGER_API Burger::XMLReader::get_line_number(
+	void) const BURGER_NOEXCEPT
+{
+	uintptr_t uLine = 1;
+	const char* pWork = m_pStart;
+	const char* pEnd = m_pCurrent;
+	for (;;) {
+		pWork = MemoryCharacter(
+			pWork, static_cast<uintptr_t>(pEnd - pWork), '\n');
+		if (!pWork) {
+			break;
+		}
+		++pWork;
+		++uLine;
+	}
+	return uLine;
+}
+
+/*! ************************************
+
+	\brief Compare text to a "C" string
+
+	Use a case insensitive compare, the same as FileXML does for element
+	and attribute names.
+
+	\param rInput Text to test
+	\param pName Pointer to a "C" string to compare with
+	\return \ref TRUE if they match
+
+***************************************/
+
+uint_t BURGER_API Burger::XMLReader::is_match(
+	const Text_t& rInput, const char* pName) BURGER_NOEXCEPT
+{
+	const uintptr_t uLength = string_length(pName);
+	return (uLength == rInput.m_uLength) &&
+		!MemoryCaseCompare(rInput.m_pText, pName, uLength);
+}
+
+/*! ************************************
+
+	\brief Test if text needs to be decoded
+
+	If the text has no entities and no carriage returns, it can be used
+	as is.
+
+	\param rInput Text to test
+	\return \ref TRUE if decode() would change the text
+
+***************************************/
+
+uint_t BURGER_API Burger::XMLReader::needs_decoding(
+	const Text_t& rInput) BURGER_NOEXCEPT
+{
+	return MemoryCharacter(rInput.m_pText, rInput.m_uLength, '&') ||
+		MemoryCharacter(rInput.m_pText, rInput.m_uLength, '\r');
+}
+
+/*! ************************************
+
+	\brief Decode XML entities
+
+	Convert &amp;amp;, &amp;lt;, &amp;gt;, &amp;quot;, &amp;apos; and numeric
+	entities to UTF-8 and convert CR/LF and CR line endings to LF. Unknown or
+	invalid entities are copied as is.
+
+	The output is never longer than the input and is written from the start,
+	so if the source buffer is writable, pOutput can point to the text itself
+	to decode it in place. For this reason, the output is not zero
+	terminated.
+
+	\param pOutput Buffer at least rInput.m_uLength bytes in size
+	\param rInput Text to decode
+	\return Length of the decoded text in bytes
+
+	\sa decode(String *, const Text_t &)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::XMLReader::decode(
+	char* pOutput, const Text_t& rInput) BURGER_NOEXCEPT
+{
+	const char* pWork = rInput.m_pText;
+	const char* pEnd = pWork + rInput.m_uLength;
+	char* pDest = pOutput;
+	while (pWork < pEnd) {
+		uint_t uTemp = static_cast<uint8_t>(pWork[0]);
+		++pWork;
+		if (uTemp == '\r') {
+			// CR/LF or CR becomes LF
+			if ((pWork < pEnd) && (pWork[0] == '\n')) {
+				++pWork;
+			}
+			uTemp = '\n';
+		} else if (uTemp == '&') {
+			const char* pSemicolon = MemoryCharacter(pWork,
+				minimum(static_cast<uintptr_t>(pEnd - pWork),
+					static_cast<uintptr_t>(12U)),
+				';');
+			if (pSemicolon) {
+				const uintptr_t uLength =
+					static_cast<uintptr_t>(pSemicolon - pWork);
+				uint32_t uValue = 0;
+				if ((uLength == 3) && !MemoryCompare(pWork, "amp", 3)) {
+					uValue = '&';
+				} else if ((uLength == 2) && !MemoryCompare(pWork, "lt", 2)) {
+					uValue = '<';
+				} else if ((uLength == 2) && !MemoryCompare(pWork, "gt", 2)) {
+					uValue = '>';
+				} else if ((uLength == 4) &&
+					!MemoryCompare(pWork, "quot", 4)) {
+					uValue = '"';
+				} else if ((uLength == 4) &&
+					!MemoryCompare(pWork, "apos", 4)) {
+					uValue = '\'';
+				} else if ((uLength >= 2) && (pWork[0] == '#')) {
+					// Numeric entity, decimal or hex
+					const char* pDigits = pWork + 1;
+					uint32_t uBase = 10;
+					if ((pDigits[0] == 'x') || (pDigits[0] == 'X')) {
+						uBase = 16;
+						++pDigits;
+					}
+					if (pDigits < pSemicolon) {
+						do {
+							const uint_t uDigit = static_cast<uint8_t>(
+								pDigits[0]);
+							uint32_t uNibble;
+							if ((uDigit >= '0') && (uDigit <= '9')) {
+								uNibble = uDigit - '0';
+							} else if ((uBase == 16) &&
+								((uDigit | 0x20U) >= 'a') &&
+								((uDigit | 0x20U) <= 'f')) {
+								uNibble = (uDigit | 0x20U) - ('a' - 10);
+							} else {
+								uValue = 0;
+								break;
+							}
+							uValue = (uValue * uBase) + uNibble;
+							// Out of the Unicode range?
+							if (uValue > 0x10FFFFU) {
+								uValue = 0;
+								break;
+							}
+						} while (++pDigits < pSemicolon);
+					}
+				}
+				// The UTF-8 encoding is always shorter than the entity, so
+				// decoding in place is safe
+				char Buffer[8];
+				uintptr_t uChunk = 0;
+				if (uValue) {
+					uChunk = UTF8::from_UTF32(Buffer, uValue);
+				}
+				if (uChunk) {
+					memory_copy(pDest, Buffer, uChunk);
+					pDest += uChunk;
+					pWork = pSemicolon + 1;
+					continue;
+				}
+			}
+		}
+		pDest[0] = static_cast<char>(uTemp);
+		++pDest;
+	}
+	return static_cast<uintptr_t>(pDest - pOutput);
+}
+
+/*! ************************************
+
+	\brief Decode XML entities into a String
+
+	\param pOutput Pointer to a String to receive the decoded text
+	\param rInput Text to decode
+	\return Zero if no error, non-zero on memory error
+
+	\sa decode(char *, const Text_t &)
+
+***************************************/
+
+Burger::eError BURGER_API Burger::XMLReader::decode(
+	String* pOutput, const Text_t& rInput) BURGER_NOEXCEPT
+{
+	eError uResult = pOutput->resize(rInput.m_uLength);
+	if (!uResult) {
+		uResult = pOutput->resize(decode(pOutput->c_str(), rInput));
+	}
+	return uResult;
+}
+
+/*! ************************************
+
+	\fn Burger::XMLReader::get_event(void) const
+	\brief Return the last event returned by next()
+
+	\return The last value returned by next()
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::XMLReader::get_error(void) const
+	\brief Return the parsing error
+
+	\return Zero if no error, or the reason \ref kEventError was returned
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::XMLReader::get_name(void) const
+	\brief Return the name of the current item
+
+	Valid for elements, declarations and doctypes.
+
+	\return The name inside the source buffer
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::XMLReader::get_text(void) const
+	\brief Return the text of the current item
+
+	Valid for text, CDATA, comments and doctypes. Entities are not decoded.
+
+	\return The text inside the source buffer
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::XMLReader::get_depth(void) const
+	\brief Return the number of open elements
+
+	After \ref kEventStartElement, this includes the new element. After
+	\ref kEventEndElement, the closed element is not included.
+
+	\return Number of open elements
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::XMLReader::get_attribute_count(void) const
+	\brief Return the number of attributes of the current item
+
+	\return Number of attributes returned by next_attribute(Attribute_t *)
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::XMLReader::is_empty_element(void) const
+	\brief Test if the current element was &lt;name/&gt;
+
+	\return \ref TRUE if the element has no contents
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::XMLReader::get_offset(void) const
+	\brief Return the parse position
+
+	\return Offset in bytes from the start of the buffer
+
+***************************************/
+
+/*! ************************************
+
+	\brief Stop parsing with an error
+
+	\param uError Error code to report with get_error(void) const
+	\return \ref kEventError
+
+***************************************/
+
+Burger::XMLReader::eEvent BURGER_API Burger::XMLReader::set_error(
+	eError uError) BURGER_NOEXCEPT
+{
+	m_uError = uError;
+	m_uEvent = kEventError;
+	m_uAttributeCount = 0;
+	m_pAttributes = m_pAttributeCursor = m_pAttributesEnd = m_pCurrent;
+	return kEventError;
+}
+
+/*! ************************************
+
+	\brief Parse an element's start tag
+
+	\param pWork Pointer to the text after the '<'
+	\return \ref kEventStartElement or \ref kEventError
+
+***************************************/
+
+Burger::XMLReader::eEvent BURGER_API Burger::XMLReader::parse_start_element(
+	const char* pWork) BURGER_NOEXCEPT
+{
+	const char* pEnd = m_pEnd;
+	pWork = parse_name(&m_Name, pWork, pEnd);
+	if (!pWork) {
+		return set_error(kErrorDataCorruption);
+	}
+
+	// Check the attributes and find the end of the tag
+	m_pAttributes = pWork;
+	uintptr_t uCount = 0;
+	for (;;) {
+		pWork = SkipXMLSpace(pWork, pEnd);
+		if (pWork >= pEnd) {
+			return set_error(kErrorDataCorruption);
+		}
+		const uint_t uTemp = static_cast<uint8_t>(pWork[0]);
+		if (uTemp == '>') {
+			m_pAttributesEnd = pWork;
+			++pWork;
+			break;
+		}
+		if (uTemp == '/') {
+			if (((pWork + 1) >= pEnd) || (pWork[1] != '>')) {
+				return set_error(kErrorDataCorruption);
+			}
+			m_pAttributesEnd = pWork;
+			pWork += 2;
+			m_bEmptyElement = TRUE;
+			break;
+		}
+		Attribute_t Temp;
+		pWork = parse_attribute(&Temp, pWork, pEnd);
+		if (!pWork) {
+			return set_error(kErrorDataCorruption);
+		}
+		++uCount;
+	}
+
+	// Push the name for the end tag test
+	if (m_uDepth >= m_uStackSize) {
+		const uintptr_t uNewSize =
+			m_uStackSize ? m_uStackSize * 2 : kStackStartSize;
+		Text_t* pStack = static_cast<Text_t*>(
+			reallocate_memory(m_pStack, uNewSize * sizeof(Text_t)));
+		if (!pStack) {
+			m_bEmptyElement = FALSE;
+			return set_error(kErrorOutOfMemory);
+		}
+		m_pStack = pStack;
+		m_uStackSize = uNewSize;
+	}
+	m_pStack[m_uDepth] = m_Name;
+	++m_uDepth;
+
+	m_pAttributeCursor = m_pAttributes;
+	m_uAttributeCount = uCount;
+	m_pCurrent = pWork;
+	m_uEvent = kEventStartElement;
+	return kEventStartElement;
+}
+
+/*! ************************************
+
+	\brief Parse an element's end tag
+
+	\param pWork Pointer to the text after the "</"
+	\return \ref kEventEndElement or \ref kEventError
+
+***************************************/
+
+Burger::XMLReader::eEvent BURGER_API Burger::XMLReader::parse_end_element(
+	const char* pWork) BURGER_NOEXCEPT
+{
+	const char* pEnd = m_pEnd;
+	pWork = parse_name(&m_Name, SkipXMLSpace(pWork, pEnd), pEnd);
+	if (!pWork || !m_uDepth) {
+		return set_error(kErrorDataCorruption);
+	}
+	pWork = SkipXMLSpace(pWork, pEnd);
+	if ((pWork >= pEnd) || (pWork[0] != '>')) {
+		return set_error(kErrorDataCorruption);
+	}
+
+	// Must match the start tag
+	const Text_t* pStart = &m_pStack[m_uDepth - 1];
+	if ((pStart->m_uLength != m_Name.m_uLength) ||
+		MemoryCaseCompare(pStart->m_pText, m_Name.m_pText, m_Name.m_uLength)) {
+		return set_error(kErrorDataCorruption);
+	}
+	--m_uDepth;
+	m_pCurrent = pWork + 1;
+	m_uEvent = kEventEndElement;
+	return kEventEndElement;
+}
+
+/*! ************************************
+
+	\brief Parse a declaration like &lt;?xml version="1.0"?&gt;
+
+	Attributes that can be parsed are returned by
+	next_attribute(Attribute_t *), the rest of the text is ignored.
+
+	\param pWork Pointer to the text after the "<?"
+	\return \ref kEventDeclaration or \ref kEventError
+
+***************************************/
+
+Burger::XMLReader::eEvent BURGER_API Burger::XMLReader::parse_declaration(
+	const char* pWork) BURGER_NOEXCEPT
+{
+	const char* pEnd = m_pEnd;
+	pWork = parse_name(&m_Name, pWork, pEnd);
+	if (!pWork) {
+		return set_error(kErrorDataCorruption);
+	}
+	const char* pFound = FindXMLToken(pWork, pEnd, "?>", 2);
+	if (!pFound) {
+		return set_error(kErrorDataCorruption);
+	}
+	TrimXMLText(&m_Text, pWork, pFound);
+
+	// Count the attributes
+	m_pAttributes = pWork;
+	m_pAttributesEnd = pFound;
+	uintptr_t uCount = 0;
+	Attribute_t Temp;
+	for (;;) {
+		pWork = SkipXMLSpace(pWork, pFound);
+		if (pWork >= pFound) {
+			break;
+		}
+		pWork = parse_attribute(&Temp, pWork, pFound);
+		if (!pWork) {
+			break;
+		}
+		++uCount;
+	}
+	m_pAttributeCursor = m_pAttributes;
+	m_uAttributeCount = uCount;
+	m_pCurrent = pFound + 2;
+	m_uEvent = kEventDeclaration;
+	return kEventDeclaration;
+}
+
+/*! ************************************
+
+	\brief Parse a tag like &lt;!DOCTYPE html&gt;
+
+	The text is everything after the name, and can contain nested brackets.
+
+	\param pWork Pointer to the text after the "<!"
+	\return \ref kEventDocType or \ref kEventError
+
+***************************************/
+
+Burger::XMLReader::eEvent BURGER_API Burger::XMLReader::parse_doctype(
+	const char* pWork) BURGER_NOEXCEPT
+{
+	const char* pEnd = m_pEnd;
+	pWork = parse_name(&m_Name, pWork, pEnd);
+	if (!pWork) {
+		return set_error(kErrorDataCorruption);
+	}
+	const char* pText = pWork;
+	uint_t uBrackets = 0;
+	uint_t uQuote = 0;
+	for (;;) {
+		if (pWork >= pEnd) {
+			return set_error(kErrorDataCorruption);
+		}
+		const uint_t uTemp = static_cast<uint8_t>(pWork[0]);
+		if (uQuote) {
+			if (uTemp == uQuote) {
+				uQuote = 0;
+			}
+		} else if ((uTemp == '"') || (uTemp == '\'')) {
+			uQuote = uTemp;
+		} else if (uTemp == '[') {
+			++uBrackets;
+		} else if (uTemp == ']') {
+			if (uBrackets) {
+				--uBrackets;
+			}
+		} else if ((uTemp == '>') && !uBrackets) {
+			break;
+		}
+		++pWork;
+	}
+	TrimXMLText(&m_Text, pText, pWork);
+	m_pCurrent = pWork + 1;
+	m_uEvent = kEventDocType;
+	return kEventDocType;
+}
+
+/*! ************************************
+
+	\brief Parse an XML name
+
+	The first character must be a letter, an underscore or a high ASCII
+	character, followed by alphanumeric, high ASCII, underscores, '-', '.'
+	and ':', the same rules as FileXML::ReadXMLName().
+
+	\param pOutput Pointer to a record to receive the name
+	\param pInput Pointer to the start of the name
+	\param pEnd End of the text
+	\return Pointer after the name or \ref nullptr if not a name
+
+***************************************/
+
+const char* BURGER_API Burger::XMLReader::parse_name(
+	Text_t* pOutput, const char* pInput, const char* pEnd) BURGER_NOEXCEPT
+{
+	if (pInput >= pEnd) {
+		return nullptr;
+	}
+	uint_t uTemp = static_cast<uint8_t>(pInput[0]);
+	if ((uTemp < 128) &&
+		!(g_AsciiTestTable[uTemp] & (ASCII_UPPER | ASCII_LOWER)) &&
+		(uTemp != '_')) {
+		return nullptr;
+	}
+	const char* pWork = pInput;
+	while (++pWork < pEnd) {
+		uTemp = static_cast<uint8_t>(pWork[0]);
+		if ((uTemp < 128) &&
+			!(g_AsciiTestTable[uTemp] &
+				(ASCII_UPPER | ASCII_LOWER | ASCII_DIGIT)) &&
+			(uTemp != '_') && (uTemp != '-') && (uTemp != '.') &&
+			(uTemp != ':')) {
+			break;
+		}
+	}
+	pOutput->m_pText = pInput;
+	pOutput->m_uLength = static_cast<uintptr_t>(pWork - pInput);
+	return pWork;
+}
+
+/*! ************************************
+
+	\brief Parse an attribute
+
+	Parse key="value". Single quotes are accepted, and like FileXML, so are
+	unquoted values that end at whitespace, '/' or '>'.
+
+	\param pOutput Pointer to a record to receive the attribute
+	\param pInput Pointer to the start of the key
+	\param pEnd End of the text
+	\return Pointer after the value or \ref nullptr on a parsing error
+
+***************************************/
+
+const char* BURGER_API Burger::XMLReader::parse_attribute(
+	Attribute_t* pOutput, const char* pInput, const char* pEnd) BURGER_NOEXCEPT
+{
+	pInput = parse_name(&pOutput->m_Key, pInput, pEnd);
+	if (pInput) {
+		pInput = SkipXMLSpace(pInput, pEnd);
+		if ((pInput >= pEnd) || (pInput[0] != '=')) {
+			return nullptr;
+		}
+		pInput = SkipXMLSpace(pInput + 1, pEnd);
+		if (pInput >= pEnd) {
+			return nullptr;
+		}
+		const int iQuote = pInput[0];
+		if ((iQuote == '"') || (iQuote == '\'')) {
+			++pInput;
+			const char* pFound = MemoryCharacter(
+				pInput, static_cast<uintptr_t>(pEnd - pInput), iQuote);
+			if (!pFound) {
+				return nullptr;
+			}
+			pOutput->m_Value.m_pText = pInput;
+			pOutput->m_Value.m_uLength =
+				static_cast<uintptr_t>(pFound - pInput);
+			return pFound + 1;
+		}
+
+		// Unquoted value
+		const char* pWork = pInput;
+		while (pWork < pEnd) {
+			const uint_t uTemp = static_cast<uint8_t>(pWork[0]);
+			if ((uTemp == '/') || (uTemp == '>') ||
+				(g_AsciiTestTable[uTemp] & ASCII_SPACE)) {
+				break;
+			}
+			++pWork;
+		}
+		if (pWork == pInput) {
+			return nullptr;
+		}
+		pOutput->m_Value.m_pText = pInput;
+		pOutput->m_Value.m_uLength = static_cast<uintptr_t>(pWork - pInput);
+		pInput = pWork;
+	}
+	return pInput;
+}
+
+/*! ************************************
+
+	\class Burger::XMLDocument
+	\brief XML document tree built from an arena
+
+	Build a tree of XMLDocument::Node_t records with an XMLReader. All nodes
+	and attribute arrays are allocated from large blocks of memory that are
+	released all at once, and all names and text point into the source
+	buffer, which must remain valid as long as the tree is used.
+
+	Entities are not decoded, use XMLReader::decode(String *,const
+	XMLReader::Text_t &) on the text that's needed.
+
+	\sa XMLReader or FileXML
+
+***************************************/
+
+/*! ************************************
+
+	\struct Burger::XMLDocument::Node_t
+	\brief Node of an XMLDocument
+
+	m_uType is XMLReader::kEventStartElement for elements, otherwise it's the
+	event that created the node.
+
+***************************************/
+
+/*! ************************************
+
+	\brief Create an empty document
+
+***************************************/
+
+Burger::XMLDocument::XMLDocument() BURGER_NOEXCEPT: m_pBlocks(nullptr),
+													 m_pFree(nullptr),
+													 m_uFreeSize(0),
+													 m_uArenaSize(0)
+{
+	memory_clear(&m_Root, sizeof(m_Root));
+	m_Root.m_uType = XMLReader::kEventEndOfDocument;
+}
+
+/*! ************************************
+
+	\brief Release the arena
+
+***************************************/
+
+Burger::XMLDocument::~XMLDocument()
+{
+	clear();
+}
+
+/*! ************************************
+
+	\brief Build the tree for a buffer of XML text
+
+	Any previous tree is released. The text is not copied.
+
+	\param pInput Pointer to the XML text
+	\param uLength Length of the XML text in bytes
+	\return Zero if no error, or the error from XMLReader or memory allocation
+
+***************************************/
+
+Burger::eError BURGER_API Burger::XMLDocument::parse(
+	const char* pInput, uintptr_t uLength) BURGER_NOEXCEPT
+{
+	clear();
+	XMLReader Reader(pInput, uLength);
+	Node_t* pParent = &m_Root;
+	for (;;) {
+		const XMLReader::eEvent uEvent = Reader.next();
+		if (uEvent == XMLReader::kEventEndOfDocument) {
+			break;
+		}
+		if (uEvent == XMLReader::kEventError) {
+			clear();
+			return Reader.get_error();
+		}
+		if (uEvent == XMLReader::kEventEndElement) {
+			pParent = pParent->m_pParent;
+			continue;
+		}
+
+		Node_t* pNode = static_cast<Node_t*>(allocate(sizeof(Node_t)));
+		const uintptr_t uCount = Reader.get_attribute_count();
+		XMLReader::Attribute_t* pAttributes = nullptr;
+		if (uCount) {
+			pAttributes = static_cast<XMLReader::Attribute_t*>(
+				allocate(uCount * sizeof(XMLReader::Attribute_t)));
+		}
+		if (!pNode || (uCount && !pAttributes)) {
+			clear();
+			return kErrorOutOfMemory;
+		}
+		pNode->m_pParent = pParent;
+		pNode->m_pFirstChild = nullptr;
+		pNode->m_pLastChild = nullptr;
+		pNode->m_pNext = nullptr;
+		pNode->m_pAttributes = pAttributes;
+		pNode->m_uAttributeCount = uCount;
+		pNode->m_Name = Reader.get_name();
+		pNode->m_Text = Reader.get_text();
+		pNode->m_uType = uEvent;
+		uintptr_t i = 0;
+		while ((i < uCount) && Reader.next_attribute(&pAttributes[i])) {
+			++i;
+		}
+
+		// Append to the parent
+		if (pParent->m_pLastChild) {
+			pParent->m_pLastChild->m_pNext = pNode;
+		} else {
+			pParent->m_pFirstChild = pNode;
+		}
+		pParent->m_pLastChild = pNode;
+		if (uEvent == XMLReader::kEventStartElement) {
+			pParent = pNode;
+		}
+	}
+	return kErrorNone;
+}
+
+/*! ************************************
+
+	\brief Release the tree and the arena
+
+***************************************/
+
+void BURGER_API Burger::XMLDocument::clear(void) BURGER_NOEXCEPT
+{
+	Block_t* pBlock = m_pBlocks;
+	while (pBlock) {
+		Block_t* pNext = pBlock->m_pNext;
+		free_memory(pBlock);
+		pBlock = pNext;
+	}
+	m_pBlocks = nullptr;
+	m_pFree = nullptr;
+	m_uFreeSize = 0;
+	m_uArenaSize = 0;
+	memory_clear(&m_Root, sizeof(m_Root));
+	m_Root.m_uType = XMLReader::kEventEndOfDocument;
+}
+
+/*! ************************************
+
+	\brief Find the first child element with a name
+
+	\param pParent Pointer to the parent node, like get_root(void) const
+	\param pName Pointer to a "C" string of the name, case insensitive
+	\return Pointer to the element or \ref nullptr if not found
+
+	\sa next_element(const Node_t *, const char *)
+
+***************************************/
+
+const Burger::XMLDocument::Node_t* BURGER_API
+Burger::XMLDocument::find_element(
+	const Node_t* pParent, const char* pName) BURGER_NOEXCEPT
+{
+	const Node_t* pNode = pParent->m_pFirstChild;
+	while (pNode) {
+		if ((pNode->m_uType == XMLReader::kEventStartElement) &&
+			XMLReader::is_match(pNode->m_Name, pName)) {
+			break;
+		}
+		pNode = pNode->m_pNext;
+	}
+	return pNode;
+}
+
+/*! ************************************
+
+	\brief Find the next sibling element with a name
+
+	\param pNode Pointer to the node to start after
+	\param pName Pointer to a "C" string of the name, case insensitive
+	\return Pointer to the element or \ref nullptr if not found
+
+	\sa find_element(const Node_t *, const char *)
+
+***************************************/
+
+const Burger::XMLDocument::Node_t* BURGER_API
+Burger::XMLDocument::next_element(
+	const Node_t* pNode, const char* pName) BURGER_NOEXCEPT
+{
+	do {
+		pNode = pNode->m_pNext;
+	} while (pNode &&
+		((pNode->m_uType != XMLReader::kEventStartElement) ||
+			!XMLReader::is_match(pNode->m_Name, pName)));
+	return pNode;
+}
+
+/*! ************************************
+
+	\brief Find an attribute of a node
+
+	\param pNode Pointer to the node
+	\param pKey Pointer to a "C" string of the key, case insensitive
+	\return Pointer to the attribute or \ref nullptr if not found
+
+***************************************/
+
+const Burger::XMLReader::Attribute_t* BURGER_API
+Burger::XMLDocument::find_attribute(
+	const Node_t* pNode, const char* pKey) BURGER_NOEXCEPT
+{
+	const XMLReader::Attribute_t* pAttribute = pNode->m_pAttributes;
+	uintptr_t uCount = pNode->m_uAttributeCount;
+	while (uCount) {
+		if (XMLReader::is_match(pAttribute->m_Key, pKey)) {
+			return pAttribute;
+		}
+		++pAttribute;
+		--uCount;
+	}
+	return nullptr;
+}
+
+/*! ************************************
+
+	\fn Burger::XMLDocument::get_root(void) const
+	\brief Return the root node
+
+	The top level nodes are the children of the root node.
+
+	\return Pointer to the root node
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::XMLDocument::get_arena_size(void) const
+	\brief Return the memory used by the tree
+
+	\return Number of bytes allocated for the arena
+
+***************************************/
+
+/*! ************************************
+
+	\brief Allocate memory from the arena
+
+	Memory is pointer aligned and is only released by clear(void).
+
+	\param uSize Number of bytes to allocate
+	\return Pointer to the memory or \ref nullptr if out of memory
+
+***************************************/
+
+void* BURGER_API Burger::XMLDocument::allocate(uintptr_t uSize) BURGER_NOEXCEPT
+{
+	const uintptr_t uAlign = sizeof(void*) - 1;
+	uSize = (uSize + uAlign) & ~uAlign;
+	if (uSize > m_uFreeSize) {
+		// Start a new block, large requests get their own block
+		const uintptr_t uHeader = (sizeof(Block_t) + uAlign) & ~uAlign;
+		uintptr_t uBlockSize = kBlockSize;
+		if ((uSize + uHeader) > uBlockSize) {
+			uBlockSize = uSize + uHeader;
+		}
+		Block_t* pBlock = static_cast<Block_t*>(allocate_memory(uBlockSize));
+		if (!pBlock) {
+			return nullptr;
+		}
+		pBlock->m_pNext = m_pBlocks;
+		pBlock->m_uSize = uBlockSize;
+		m_pBlocks = pBlock;
+		m_pFree = reinterpret_cast<uint8_t*>(pBlock) + uHeader;
+		m_uFreeSize = uBlockSize - uHeader;
+		m_uArenaSize += uBlockSize;
+	}
+	void* pResult = m_pFree;
+	m_pFree += uSize;
+	m_uFreeSize -= uSize;
+	return pResult;
+}
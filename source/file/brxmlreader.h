@@ -0,0 +1,268 @@
+/***************************************
+
+	Zero copy XML pull parser
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#ifndef __BRXMLREADER_H__
+#define __BRXMLREADER_H__
+
+#ifndef __BRTYPES_H__
+#include "brtypes.h"
+#endif
+
+#ifndef __BRERROR_H__
+#include "brerror.h"
+#endif
+
+#ifndef __BRSTRING_H__
+#include "brstring.h"
+#endif
+
+#ifndef __BRINPUTMEMORYSTREAM_H__
+#include "brinputmemorystream.h"
+#endif
+
+/* BEGIN */
+namespace Burger {
+
+class XMLReader {
+	BURGER_DISABLE_COPY(XMLReader);
+
+public:
+	enum eEvent {
+		/** No more data, the document was parsed without error */
+		kEventEndOfDocument,
+		/** The document is malformed, parsing stopped */
+		kEventError,
+		/** <name attributes...> or <name/> */
+		kEventStartElement,
+		/** </name> or the end of <name/> */
+		kEventEndElement,
+		/** Text between elements, trimmed of leading and trailing space */
+		kEventText,
+		/** <![CDATA[text]]> */
+		kEventCData,
+		/** <!--text--> */
+		kEventComment,
+		/** <?name attributes...?> */
+		kEventDeclaration,
+		/** <!name text> like <!DOCTYPE> */
+		kEventDocType
+	};
+
+	/** Pointer and length of text inside the source buffer */
+	struct Text_t {
+		/** Pointer to the first character, not zero terminated */
+		const char* m_pText;
+		/** Length of the text in bytes */
+		uintptr_t m_uLength;
+	};
+
+	/** Attribute key and value, the value is not decoded */
+	struct Attribute_t {
+		/** Name of the attribute */
+		Text_t m_Key;
+		/** Value of the attribute without quotes */
+		Text_t m_Value;
+	};
+
+	/** Number of element names the nesting stack starts with */
+	static const uintptr_t kStackStartSize = 32;
+
+protected:
+	/** Start of the XML text */
+	const char* m_pStart;
+	/** End of the XML text */
+	const char* m_pEnd;
+	/** Parsing position */
+	const char* m_pCurrent;
+	/** Stack of element names for matching end tags */
+	Text_t* m_pStack;
+	/** Number of entries in m_pStack */
+	uintptr_t m_uStackSize;
+	/** Number of currently open elements */
+	uintptr_t m_uDepth;
+	/** Name of the current element, declaration or doctype */
+	Text_t m_Name;
+	/** Text of the current text, comment, CDATA or doctype */
+	Text_t m_Text;
+	/** Start of the attributes of the current element */
+	const char* m_pAttributes;
+	/** Next attribute to return from next_attribute() */
+	const char* m_pAttributeCursor;
+	/** End of the attributes of the current element */
+	const char* m_pAttributesEnd;
+	/** Number of attributes of the current element */
+	uintptr_t m_uAttributeCount;
+	/** Last event returned by next() */
+	eEvent m_uEvent;
+	/** Error code if m_uEvent is kEventError */
+	eError m_uError;
+	/** \ref TRUE if the current element was <name/> */
+	uint_t m_bEmptyElement;
+
+public:
+	XMLReader() BURGER_NOEXCEPT;
+	XMLReader(const char* pInput, uintptr_t uLength) BURGER_NOEXCEPT;
+	~XMLReader();
+
+	void BURGER_API init(const char* pInput, uintptr_t uLength) BURGER_NOEXCEPT;
+	void BURGER_API init(InputMemoryStream* pInput) BURGER_NOEXCEPT;
+	eEvent BURGER_API next(void) BURGER_NOEXCEPT;
+	uint_t BURGER_API next_attribute(Attribute_t* pOutput) BURGER_NOEXCEPT;
+	uint_t BURGER_API find_attribute(
+		Attribute_t* pOutput, const char* pKey) const BURGER_NOEXCEPT;
+	uintptr_t BURGER_API get_line_number(void) const BURGER_NOEXCEPT;
+
+	static uint_t BURGER_API is_match(
+		const Text_t& rInput, const char* pName) BURGER_NOEXCEPT;
+	static uint_t BURGER_API needs_decoding(
+		const Text_t& rInput) BURGER_NOEXCEPT;
+	static uintptr_t BURGER_API decode(
+		char* pOutput, const Text_t& rInput) BURGER_NOEXCEPT;
+	static eError BURGER_API decode(
+		String* pOutput, const Text_t& rInput) BURGER_NOEXCEPT;
+
+	BURGER_INLINE eEvent get_event(void) const BURGER_NOEXCEPT
+	{
+		return m_uEvent;
+	}
+
+	BURGER_INLINE eError get_error(void) const BURGER_NOEXCEPT
+	{
+		return m_uError;
+	}
+
+	BURGER_INLINE const Text_t& get_name(void) const BURGER_NOEXCEPT
+	{
+		return m_Name;
+	}
+
+	BURGER_INLINE const Text_t& get_text(void) const BURGER_NOEXCEPT
+	{
+		return m_Text;
+	}
+
+	BURGER_INLINE uintptr_t get_depth(void) const BURGER_NOEXCEPT
+	{
+		return m_uDepth;
+	}
+
+	BURGER_INLINE uintptr_t get_attribute_count(void) const BURGER_NOEXCEPT
+	{
+		return m_uAttributeCount;
+	}
+
+	BURGER_INLINE uint_t is_empty_element(void) const BURGER_NOEXCEPT
+	{
+		return m_bEmptyElement;
+	}
+
+	BURGER_INLINE uintptr_t get_offset(void) const BURGER_NOEXCEPT
+	{
+		return static_cast<uintptr_t>(m_pCurrent - m_pStart);
+	}
+
+protected:
+	eEvent BURGER_API set_error(eError uError) BURGER_NOEXCEPT;
+	eEvent BURGER_API parse_start_element(const char* pWork) BURGER_NOEXCEPT;
+	eEvent BURGER_API parse_end_element(const char* pWork) BURGER_NOEXCEPT;
+	eEvent BURGER_API parse_declaration(const char* pWork) BURGER_NOEXCEPT;
+	eEvent BURGER_API parse_doctype(const char* pWork) BURGER_NOEXCEPT;
+	static const char* BURGER_API parse_name(
+		Text_t* pOutput, const char* pInput, const char* pEnd) BURGER_NOEXCEPT;
+	static const char* BURGER_API parse_attribute(Attribute_t* pOutput,
+		const char* pInput, const char* pEnd) BURGER_NOEXCEPT;
+};
+
+class XMLDocument {
+	BURGER_DISABLE_COPY(XMLDocument);
+
+public:
+	/** Node in the document tree, all pointers are into the arena */
+	struct Node_t {
+		/** Parent node, \ref nullptr for the root */
+		Node_t* m_pParent;
+		/** First child node */
+		Node_t* m_pFirstChild;
+		/** Last child node, used to append children */
+		Node_t* m_pLastChild;
+		/** Next sibling node */
+		Node_t* m_pNext;
+		/** Array of attributes */
+		XMLReader::Attribute_t* m_pAttributes;
+		/** Number of entries in m_pAttributes */
+		uintptr_t m_uAttributeCount;
+		/** Element, declaration or doctype name */
+		XMLReader::Text_t m_Name;
+		/** Text, comment, CDATA or doctype text */
+		XMLReader::Text_t m_Text;
+		/** XMLReader::eEvent that created this node */
+		XMLReader::eEvent m_uType;
+	};
+
+	/** Size in bytes of each arena block */
+	static const uintptr_t kBlockSize = 0x10000;
+
+protected:
+	/** Header of a block of arena memory */
+	struct Block_t {
+		/** Next block in the chain */
+		Block_t* m_pNext;
+		/** Size of this block in bytes including the header */
+		uintptr_t m_uSize;
+	};
+
+	/** Linked list of arena blocks */
+	Block_t* m_pBlocks;
+	/** Next free byte in the current block */
+	uint8_t* m_pFree;
+	/** Bytes remaining in the current block */
+	uintptr_t m_uFreeSize;
+	/** Total bytes allocated for the arena */
+	uintptr_t m_uArenaSize;
+	/** Parent of all the top level nodes */
+	Node_t m_Root;
+
+public:
+	XMLDocument() BURGER_NOEXCEPT;
+	~XMLDocument();
+
+	eError BURGER_API parse(
+		const char* pInput, uintptr_t uLength) BURGER_NOEXCEPT;
+	void BURGER_API clear(void) BURGER_NOEXCEPT;
+
+	static const Node_t* BURGER_API find_element(
+		const Node_t* pParent, const char* pName) BURGER_NOEXCEPT;
+	static const Node_t* BURGER_API next_element(
+		const Node_t* pNode, const char* pName) BURGER_NOEXCEPT;
+	static const XMLReader::Attribute_t* BURGER_API find_attribute(
+		const Node_t* pNode, const char* pKey) BURGER_NOEXCEPT;
+
+	BURGER_INLINE const Node_t* get_root(void) const BURGER_NOEXCEPT
+	{
+		return &m_Root;
+	}
+
+	BURGER_INLINE uintptr_t get_arena_size(void) const BURGER_NOEXCEPT
+	{
+		return m_uArenaSize;
+	}
+
+protected:
+	void* BURGER_API allocate(uintptr_t uSize) BURGER_NOEXCEPT;
+};
+
+}
+/* END */
+
+#endif
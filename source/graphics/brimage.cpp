@@ -20,6 +20,29 @@
 #include "brfilegif.h"
 #include "brfilebmp.h"
 #include "brfiletga.h"
+#include "brfloatingpoint.h"
+#include "brmemoryfunctions.h"
+#include "brthread.h"
+
+// Select the vector units used for pixel conversion
+#if defined(BURGER_SSE2) && defined(BURGER_INTEL) && \
+	((defined(BURGER_GNUC) && (BURGER_GNUC >= 40900)) || \
+		defined(BURGER_CLANG) || (BURGER_MSVC >= 190000000)) && \
+	!defined(DOXYGEN)
+// SSSE3 is tested for at runtime
+#define USE_SSE2
+#include "bratomic.h"
+#include <tmmintrin.h>
+#if defined(BURGER_MSVC)
+#define SSSE3_FUNCTION
+#else
+#define SSSE3_FUNCTION __attribute__((target("ssse3")))
+#endif
+
+#elif defined(BURGER_NEON) && defined(BURGER_ARM64) && !defined(DOXYGEN)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
 
 /*! ************************************
 
@@ -2066,3 +2089,2416 @@ uint_t Burger::Image::Store8888(const Image *pInput,const RGBAWord8_t *pPalette)
 	}
 	return uResult;
 }
+
+#if !defined(DOXYGEN)
+
+// Number of pixels converted through the RGBA8888 work buffer at a time
+static const uint_t kConvertSpanSize = 256;
+
+// Images smaller than this are never split across threads
+static const uintptr_t kConvertThreadPixels = 0x10000;
+
+// Maximum number of threads used by Image::Convert()
+static const uint_t kConvertMaxThreads = 16;
+
+struct ConvertJob_t;
+typedef void (BURGER_API *ConvertRowProc_t)(uint8_t *pOutput,const uint8_t *pInput,uint_t uCount,const ConvertJob_t *pJob);
+
+// Description of a band of rows to convert
+struct ConvertJob_t {
+	const uint8_t *m_pInput;				// First input row
+	uint8_t *m_pOutput;						// First output row
+	uintptr_t m_uInputStride;				// Bytes per input row
+	uintptr_t m_uOutputStride;				// Bytes per output row
+	const uint32_t *m_pPalette;				// 256 RGBA entries stored as bytes
+	ConvertRowProc_t m_pDirect;				// Direct row converter or NULL
+	uint_t m_uWidth;						// Pixels per row
+	uint_t m_uHeight;						// Rows in this band
+	uint_t m_uPaletteCount;					// Entries in m_pPalette for indexed output
+	uint_t m_bPremultiply;					// TRUE if the alpha is multiplied in
+	Burger::Image::ePixelTypes m_eInputType;	// Input pixel type
+	Burger::Image::ePixelTypes m_eOutputType;	// Output pixel type
+};
+
+/***************************************
+
+	Test the CPU once for SSSE3.
+
+***************************************/
+
+#if defined(USE_SSE2)
+static uint_t g_uConvertFeatures;
+
+static uint_t BURGER_API GetConvertFeatures(void) BURGER_NOEXCEPT
+{
+	uint_t uFeatures = g_uConvertFeatures;
+	if (!uFeatures) {
+		Burger::CPUID_t CPUInfo;
+		Burger::CPUID(&CPUInfo);
+		uFeatures = 1U;
+		if (CPUInfo.has_SSSE3()) {
+			uFeatures |= 2U;
+		}
+		g_uConvertFeatures = uFeatures;
+	}
+	return uFeatures;
+}
+#endif
+
+/***************************************
+
+	Copy a row of pixels of the same type.
+
+***************************************/
+
+static void BURGER_API ConvertCopy(uint8_t *pOutput,const uint8_t *pInput,uint_t uCount,const ConvertJob_t *pJob) BURGER_NOEXCEPT
+{
+	Burger::memory_copy(pOutput,pInput,((uCount*Burger::Image::GetBitsPerPixel(pJob->m_eInputType))+7U)>>3U);
+}
+
+/***************************************
+
+	PIXELTYPE888 to PIXELTYPE8888, alpha is set to 0xFF.
+
+***************************************/
+
+#if defined(USE_SSE2)
+static SSSE3_FUNCTION void BURGER_API Convert888To8888SSSE3(uint8_t *pOutput,const uint8_t *pInput,uint_t uCount) BURGER_NOEXCEPT
+{
+	const __m128i vShuffle = _mm_setr_epi8(0,1,2,-128,3,4,5,-128,6,7,8,-128,9,10,11,-128);
+	const __m128i vAlpha = _mm_set1_epi32(static_cast<int>(0xFF000000U));
+	// Each load reads 16 bytes but uses 12, so stay 2 pixels from the end
+	while (uCount>=22U) {
+		const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput));
+		const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput+12));
+		const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput+24));
+		const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput+36));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput),_mm_or_si128(_mm_shuffle_epi8(v0,vShuffle),vAlpha));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput+16),_mm_or_si128(_mm_shuffle_epi8(v1,vShuffle),vAlpha));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput+32),_mm_or_si128(_mm_shuffle_epi8(v2,vShuffle),vAlpha));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput+48),_mm_or_si128(_mm_shuffle_epi8(v3,vShuffle),vAlpha));
+		pInput+=48;
+		pOutput+=64;
+		uCount-=16U;
+	}
+	while (uCount>=6U) {
+		const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput),_mm_or_si128(_mm_shuffle_epi8(v0,vShuffle),vAlpha));
+		pInput+=12;
+		pOutput+=16;
+		uCount-=4U;
+	}
+	while (uCount) {
+		pOutput[0] = pInput[0];
+		pOutput[1] = pInput[1];
+		pOutput[2] = pInput[2];
+		pOutput[3] = 0xFF;
+		pInput+=3;
+		pOutput+=4;
+		--uCount;
+	}
+}
+#endif
+
+static void BURGER_API Convert888To8888(uint8_t *pOutput,const uint8_t *pInput,uint_t uCount,const ConvertJob_t * /* pJob */) BURGER_NOEXCEPT
+{
+#if defined(USE_SSE2)
+	if (GetConvertFeatures()&2U) {
+		Convert888To8888SSSE3(pOutput,pInput,uCount);
+		return;
+	}
+#elif defined(USE_NEON)
+	if (uCount>=16U) {
+		uint8x16x4_t vPixels;
+		vPixels.val[3] = vdupq_n_u8(0xFF);
+		do {
+			const uint8x16x3_t vInput = vld3q_u8(pInput);
+			vPixels.val[0] = vInput.val[0];
+			vPixels.val[1] = vInput.val[1];
+			vPixels.val[2] = vInput.val[2];
+			vst4q_u8(pOutput,vPixels);
+			pInput+=48;
+			pOutput+=64;
+			uCount-=16U;
+		} while (uCount>=16U);
+	}
+#endif
+	while (uCount) {
+		pOutput[0] = pInput[0];
+		pOutput[1] = pInput[1];
+		pOutput[2] = pInput[2];
+		pOutput[3] = 0xFF;
+		pInput+=3;
+		pOutput+=4;
+		--uCount;
+	}
+}
+
+/***************************************
+
+	PIXELTYPE8888 to PIXELTYPE888, alpha is discarded.
+
+***************************************/
+
+#if defined(USE_SSE2)
+static SSSE3_FUNCTION void BURGER_API Convert8888To888SSSE3(uint8_t *pOutput,const uint8_t *pInput,uint_t uCount) BURGER_NOEXCEPT
+{
+	const __m128i vShuffle = _mm_setr_epi8(0,1,2,4,5,6,8,9,10,12,13,14,-128,-128,-128,-128);
+	// Each store writes 16 bytes but only 12 are valid, so stay 2 pixels
+	// from the end
+	while (uCount>=6U) {
+		const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput),_mm_shuffle_epi8(v0,vShuffle));
+		pInput+=16;
+		pOutput+=12;
+		uCount-=4U;
+	}
+	while (uCount) {
+		pOutput[0] = pInput[0];
+		pOutput[1] = pInput[1];
+		pOutput[2] = pInput[2];
+		pInput+=4;
+		pOutput+=3;
+		--uCount;
+	}
+}
+#endif
+
+static void BURGER_API Convert8888To888(uint8_t *pOutput,const uint8_t *pInput,uint_t uCount,const ConvertJob_t * /* pJob */) BURGER_NOEXCEPT
+{
+#if defined(USE_SSE2)
+	if (GetConvertFeatures()&2U) {
+		Convert8888To888SSSE3(pOutput,pInput,uCount);
+		return;
+	}
+#elif defined(USE_NEON)
+	if (uCount>=16U) {
+		uint8x16x3_t vPixels;
+		do {
+			const uint8x16x4_t vInput = vld4q_u8(pInput);
+			vPixels.val[0] = vInput.val[0];
+			vPixels.val[1] = vInput.val[1];
+			vPixels.val[2] = vInput.val[2];
+			vst3q_u8(pOutput,vPixels);
+			pInput+=64;
+			pOutput+=48;
+			uCount-=16U;
+		} while (uCount>=16U);
+	}
+#endif
+	while (uCount) {
+		pOutput[0] = pInput[0];
+		pOutput[1] = pInput[1];
+		pOutput[2] = pInput[2];
+		pInput+=4;
+		pOutput+=3;
+		--uCount;
+	}
+}
+
+/***************************************
+
+	PIXELTYPE8888 to PIXELTYPE565, alpha is discarded.
+
+***************************************/
+
+static void BURGER_API Convert8888To565(uint8_t *pOutput,const uint8_t *pInput,uint_t uCount,const ConvertJob_t * /* pJob */) BURGER_NOEXCEPT
+{
+#if defined(USE_SSE2)
+	// Pixels are little endian R,G,B,A 32 bit values
+	if (uCount>=8U) {
+		const __m128i vMaskRed = _mm_set1_epi32(0xF8);
+		const __m128i vMaskGreen = _mm_set1_epi32(0xFC00);
+		const __m128i vMaskBlue = _mm_set1_epi32(0xF80000);
+		do {
+			__m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput));
+			__m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput+16));
+			v0 = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(v0,vMaskRed),8),
+				_mm_srli_epi32(_mm_and_si128(v0,vMaskGreen),5)),
+				_mm_srli_epi32(_mm_and_si128(v0,vMaskBlue),19));
+			v1 = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(v1,vMaskRed),8),
+				_mm_srli_epi32(_mm_and_si128(v1,vMaskGreen),5)),
+				_mm_srli_epi32(_mm_and_si128(v1,vMaskBlue),19));
+			// Sign extend so the saturating pack keeps all 16 bits
+			v0 = _mm_srai_epi32(_mm_slli_epi32(v0,16),16);
+			v1 = _mm_srai_epi32(_mm_slli_epi32(v1,16),16);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput),_mm_packs_epi32(v0,v1));
+			pInput+=32;
+			pOutput+=16;
+			uCount-=8U;
+		} while (uCount>=8U);
+	}
+#elif defined(USE_NEON)
+	if (uCount>=16U) {
+		do {
+			const uint8x16x4_t vInput = vld4q_u8(pInput);
+			uint16x8_t vLow = vshll_n_u8(vget_low_u8(vInput.val[0]),8);
+			vLow = vsriq_n_u16(vLow,vshll_n_u8(vget_low_u8(vInput.val[1]),8),5);
+			vLow = vsriq_n_u16(vLow,vshll_n_u8(vget_low_u8(vInput.val[2]),8),11);
+			uint16x8_t vHigh = vshll_n_u8(vget_high_u8(vInput.val[0]),8);
+			vHigh = vsriq_n_u16(vHigh,vshll_n_u8(vget_high_u8(vInput.val[1]),8),5);
+			vHigh = vsriq_n_u16(vHigh,vshll_n_u8(vget_high_u8(vInput.val[2]),8),11);
+			vst1q_u16(reinterpret_cast<uint16_t *>(pOutput),vLow);
+			vst1q_u16(reinterpret_cast<uint16_t *>(pOutput+16),vHigh);
+			pInput+=64;
+			pOutput+=32;
+			uCount-=16U;
+		} while (uCount>=16U);
+	}
+#endif
+	while (uCount) {
+		reinterpret_cast<uint16_t *>(pOutput)[0] = static_cast<uint16_t>(((pInput[0]&0xF8U)<<8U)|((pInput[1]&0xFCU)<<3U)|(pInput[2]>>3U));
+		pInput+=4;
+		pOutput+=2;
+		--uCount;
+	}
+}
+
+/***************************************
+
+	PIXELTYPE8BIT to PIXELTYPE8888 with a palette lookup.
+
+***************************************/
+
+static void BURGER_API Convert8To8888(uint8_t *pOutput,const uint8_t *pInput,uint_t uCount,const ConvertJob_t *pJob) BURGER_NOEXCEPT
+{
+	const uint32_t *pPalette = pJob->m_pPalette;
+	// Unrolled so the table loads can be issued together
+	uint_t uBlocks = uCount>>2U;
+	while (uBlocks) {
+		reinterpret_cast<uint32_t *>(pOutput)[0] = pPalette[pInput[0]];
+		reinterpret_cast<uint32_t *>(pOutput)[1] = pPalette[pInput[1]];
+		reinterpret_cast<uint32_t *>(pOutput)[2] = pPalette[pInput[2]];
+		reinterpret_cast<uint32_t *>(pOutput)[3] = pPalette[pInput[3]];
+		pInput+=4;
+		pOutput+=16;
+		--uBlocks;
+	}
+	uCount&=3U;
+	while (uCount) {
+		reinterpret_cast<uint32_t *>(pOutput)[0] = pPalette[pInput[0]];
+		++pInput;
+		pOutput+=4;
+		--uCount;
+	}
+}
+
+/***************************************
+
+	Expand pixels starting at uX of any uncompressed type into RGBA8888.
+
+***************************************/
+
+static void BURGER_API UnpackSpan(uint8_t *pOutput,const uint8_t *pInput,uint_t uX,uint_t uCount,const ConvertJob_t *pJob) BURGER_NOEXCEPT
+{
+	const uint32_t *pPalette = pJob->m_pPalette;
+	switch (pJob->m_eInputType) {
+	case Burger::Image::PIXELTYPE1BIT:
+	case Burger::Image::PIXELTYPE2BIT:
+	case Burger::Image::PIXELTYPE4BIT:
+		{
+			// Pixels are packed with the leftmost pixel in the high bits
+			const uint_t uBits = pJob->m_eInputType;
+			const uint_t uMask = (1U<<uBits)-1U;
+			uint_t uBit = uX*uBits;
+			do {
+				const uint_t uShift = 8U-uBits-(uBit&7U);
+				reinterpret_cast<uint32_t *>(pOutput)[0] = pPalette[(pInput[uBit>>3U]>>uShift)&uMask];
+				uBit+=uBits;
+				pOutput+=4;
+			} while (--uCount);
+		}
+		break;
+	case Burger::Image::PIXELTYPE8BIT:
+		pInput+=uX;
+		do {
+			reinterpret_cast<uint32_t *>(pOutput)[0] = pPalette[pInput[0]];
+			++pInput;
+			pOutput+=4;
+		} while (--uCount);
+		break;
+	case Burger::Image::PIXELTYPE332:
+		pInput+=uX;
+		do {
+			const uint_t uTemp = pInput[0];
+			pOutput[0] = Burger::Renderer::RGB3ToRGB8Table[uTemp>>5U];
+			pOutput[1] = Burger::Renderer::RGB3ToRGB8Table[(uTemp>>2U)&7U];
+			pOutput[2] = Burger::Renderer::RGB2ToRGB8Table[uTemp&3U];
+			pOutput[3] = 0xFF;
+			++pInput;
+			pOutput+=4;
+		} while (--uCount);
+		break;
+	case Burger::Image::PIXELTYPE4444:
+		pInput+=uX*2U;
+		do {
+			const uint_t uTemp = reinterpret_cast<const uint16_t *>(pInput)[0];
+			pOutput[0] = Burger::Renderer::RGB4ToRGB8Table[(uTemp>>8U)&0xFU];
+			pOutput[1] = Burger::Renderer::RGB4ToRGB8Table[(uTemp>>4U)&0xFU];
+			pOutput[2] = Burger::Renderer::RGB4ToRGB8Table[uTemp&0xFU];
+			pOutput[3] = Burger::Renderer::RGB4ToRGB8Table[uTemp>>12U];
+			pInput+=2;
+			pOutput+=4;
+		} while (--uCount);
+		break;
+	case Burger::Image::PIXELTYPE1555:
+	case Burger::Image::PIXELTYPE555:
+		{
+			pInput+=uX*2U;
+			// 555 is opaque, 1555 uses the high bit
+			const uint_t uAlpha = (pJob->m_eInputType==Burger::Image::PIXELTYPE555) ? 0x8000U : 0U;
+			do {
+				const uint_t uTemp = reinterpret_cast<const uint16_t *>(pInput)[0]|uAlpha;
+				pOutput[0] = Burger::Renderer::RGB5ToRGB8Table[(uTemp>>10U)&0x1FU];
+				pOutput[1] = Burger::Renderer::RGB5ToRGB8Table[(uTemp>>5U)&0x1FU];
+				pOutput[2] = Burger::Renderer::RGB5ToRGB8Table[uTemp&0x1FU];
+				pOutput[3] = static_cast<uint8_t>((uTemp&0x8000U) ? 0xFFU : 0);
+				pInput+=2;
+				pOutput+=4;
+			} while (--uCount);
+		}
+		break;
+	case Burger::Image::PIXELTYPE565:
+		pInput+=uX*2U;
+		do {
+			const uint_t uTemp = reinterpret_cast<const uint16_t *>(pInput)[0];
+			pOutput[0] = Burger::Renderer::RGB5ToRGB8Table[uTemp>>11U];
+			pOutput[1] = Burger::Renderer::RGB6ToRGB8Table[(uTemp>>5U)&0x3FU];
+			pOutput[2] = Burger::Renderer::RGB5ToRGB8Table[uTemp&0x1FU];
+			pOutput[3] = 0xFF;
+			pInput+=2;
+			pOutput+=4;
+		} while (--uCount);
+		break;
+	case Burger::Image::PIXELTYPE888:
+		Convert888To8888(pOutput,pInput+(uX*3U),uCount,pJob);
+		break;
+	case Burger::Image::PIXELTYPE1010102:
+		pInput+=uX*4U;
+		do {
+			// Red is in the low 10 bits, keep the upper 8 of each component
+			const uint32_t uTemp = reinterpret_cast<const uint32_t *>(pInput)[0];
+			pOutput[0] = static_cast<uint8_t>(uTemp>>2U);
+			pOutput[1] = static_cast<uint8_t>(uTemp>>12U);
+			pOutput[2] = static_cast<uint8_t>(uTemp>>22U);
+			pOutput[3] = Burger::Renderer::RGB2ToRGB8Table[uTemp>>30U];
+			pInput+=4;
+			pOutput+=4;
+		} while (--uCount);
+		break;
+	// PIXELTYPE8888
+	default:
+		Burger::memory_copy(pOutput,pInput+(uX*4U),uCount*4U);
+		break;
+	}
+}
+
+/***************************************
+
+	Multiply the red, green and blue of RGBA8888 pixels by their alpha.
+
+***************************************/
+
+static void BURGER_API PremultiplySpan(uint8_t *pInput,uint_t uCount) BURGER_NOEXCEPT
+{
+	do {
+		const uint_t uAlpha = pInput[3];
+		if (uAlpha!=255U) {
+			// Divide by 255 with rounding
+			uint_t uTemp = (pInput[0]*uAlpha)+128U;
+			pInput[0] = static_cast<uint8_t>((uTemp+(uTemp>>8U))>>8U);
+			uTemp = (pInput[1]*uAlpha)+128U;
+			pInput[1] = static_cast<uint8_t>((uTemp+(uTemp>>8U))>>8U);
+			uTemp = (pInput[2]*uAlpha)+128U;
+			pInput[2] = static_cast<uint8_t>((uTemp+(uTemp>>8U))>>8U);
+		}
+		pInput+=4;
+	} while (--uCount);
+}
+
+/***************************************
+
+	Find the palette entry closest to an RGB color.
+
+***************************************/
+
+static uint_t BURGER_API FindNearestIndex(const uint8_t *pColor,const uint32_t *pPalette,uint_t uCount) BURGER_NOEXCEPT
+{
+	uint_t uResult = 0;
+	uint_t uBest = 0xFFFFFFFFU;
+	uint_t i = 0;
+	do {
+		const uint8_t *pEntry = reinterpret_cast<const uint8_t *>(pPalette+i);
+		const int iRed = static_cast<int>(pEntry[0])-static_cast<int>(pColor[0]);
+		const int iGreen = static_cast<int>(pEntry[1])-static_cast<int>(pColor[1]);
+		const int iBlue = static_cast<int>(pEntry[2])-static_cast<int>(pColor[2]);
+		const uint_t uDistance = static_cast<uint_t>((iRed*iRed)+(iGreen*iGreen)+(iBlue*iBlue));
+		if (uDistance<uBest) {
+			uBest = uDistance;
+			uResult = i;
+			if (!uDistance) {
+				break;
+			}
+		}
+	} while (++i<uCount);
+	return uResult;
+}
+
+/***************************************
+
+	Store RGBA8888 pixels into any uncompressed type starting at uX.
+
+***************************************/
+
+static void BURGER_API PackSpan(uint8_t *pOutput,uint_t uX,const uint8_t *pInput,uint_t uCount,const ConvertJob_t *pJob) BURGER_NOEXCEPT
+{
+	switch (pJob->m_eOutputType) {
+	case Burger::Image::PIXELTYPE1BIT:
+	case Burger::Image::PIXELTYPE2BIT:
+	case Burger::Image::PIXELTYPE4BIT:
+	case Burger::Image::PIXELTYPE8BIT:
+		{
+			// Remember the last match since runs of the same color are common
+			const uint_t uBits = pJob->m_eOutputType;
+			const uint_t uMask = (1U<<uBits)-1U;
+			uint32_t uLastColor = ~reinterpret_cast<const uint32_t *>(pInput)[0];
+			uint_t uIndex = 0;
+			uint_t uBit = uX*uBits;
+			do {
+				const uint32_t uColor = reinterpret_cast<const uint32_t *>(pInput)[0];
+				if (uColor!=uLastColor) {
+					uLastColor = uColor;
+					uIndex = FindNearestIndex(pInput,pJob->m_pPalette,pJob->m_uPaletteCount);
+				}
+				// Leftmost pixel goes in the high bits
+				const uint_t uShift = 8U-uBits-(uBit&7U);
+				uint8_t *pByte = pOutput+(uBit>>3U);
+				pByte[0] = static_cast<uint8_t>((pByte[0]&~(uMask<<uShift))|(uIndex<<uShift));
+				uBit+=uBits;
+				pInput+=4;
+			} while (--uCount);
+		}
+		break;
+	case Burger::Image::PIXELTYPE332:
+		pOutput+=uX;
+		do {
+			pOutput[0] = static_cast<uint8_t>((pInput[0]&0xE0U)|((pInput[1]>>3U)&0x1CU)|(pInput[2]>>6U));
+			pInput+=4;
+			++pOutput;
+		} while (--uCount);
+		break;
+	case Burger::Image::PIXELTYPE4444:
+		pOutput+=uX*2U;
+		do {
+			reinterpret_cast<uint16_t *>(pOutput)[0] = static_cast<uint16_t>(((pInput[3]&0xF0U)<<8U)|((pInput[0]&0xF0U)<<4U)|(pInput[1]&0xF0U)|(pInput[2]>>4U));
+			pInput+=4;
+			pOutput+=2;
+		} while (--uCount);
+		break;
+	case Burger::Image::PIXELTYPE1555:
+		pOutput+=uX*2U;
+		do {
+			reinterpret_cast<uint16_t *>(pOutput)[0] = static_cast<uint16_t>(((pInput[3]&0x80U)<<8U)|((pInput[0]&0xF8U)<<7U)|((pInput[1]&0xF8U)<<2U)|(pInput[2]>>3U));
+			pInput+=4;
+			pOutput+=2;
+		} while (--uCount);
+		break;
+	case Burger::Image::PIXELTYPE555:
+		pOutput+=uX*2U;
+		do {
+			reinterpret_cast<uint16_t *>(pOutput)[0] = static_cast<uint16_t>(((pInput[0]&0xF8U)<<7U)|((pInput[1]&0xF8U)<<2U)|(pInput[2]>>3U));
+			pInput+=4;
+			pOutput+=2;
+		} while (--uCount);
+		break;
+	case Burger::Image::PIXELTYPE565:
+		Convert8888To565(pOutput+(uX*2U),pInput,uCount,pJob);
+		break;
+	case Burger::Image::PIXELTYPE888:
+		Convert8888To888(pOutput+(uX*3U),pInput,uCount,pJob);
+		break;
+	case Burger::Image::PIXELTYPE1010102:
+		pOutput+=uX*4U;
+		do {
+			// Replicate the high bits into the new low bits
+			const uint32_t uRed = (static_cast<uint32_t>(pInput[0])<<2U)|(pInput[0]>>6U);
+			const uint32_t uGreen = (static_cast<uint32_t>(pInput[1])<<2U)|(pInput[1]>>6U);
+			const uint32_t uBlue = (static_cast<uint32_t>(pInput[2])<<2U)|(pInput[2]>>6U);
+			reinterpret_cast<uint32_t *>(pOutput)[0] = uRed|(uGreen<<10U)|(uBlue<<20U)|((static_cast<uint32_t>(pInput[3])>>6U)<<30U);
+			pInput+=4;
+			pOutput+=4;
+		} while (--uCount);
+		break;
+	// PIXELTYPE8888
+	default:
+		Burger::memory_copy(pOutput+(uX*4U),pInput,uCount*4U);
+		break;
+	}
+}
+
+/***************************************
+
+	Convert a band of rows, either directly or through a work buffer.
+
+***************************************/
+
+static uintptr_t BURGER_API ConvertBand(void *pThis) BURGER_NOEXCEPT
+{
+	const ConvertJob_t *pJob = static_cast<const ConvertJob_t *>(pThis);
+	uint_t uHeight = pJob->m_uHeight;
+	if (uHeight) {
+		const uint8_t *pInput = pJob->m_pInput;
+		uint8_t *pOutput = pJob->m_pOutput;
+		const ConvertRowProc_t pDirect = pJob->m_pDirect;
+		uint32_t Span[kConvertSpanSize];
+		do {
+			if (pDirect) {
+				pDirect(pOutput,pInput,pJob->m_uWidth,pJob);
+			} else {
+				uint_t uX = 0;
+				do {
+					uint_t uCount = pJob->m_uWidth-uX;
+					if (uCount>kConvertSpanSize) {
+						uCount = kConvertSpanSize;
+					}
+					uint8_t *pSpan = reinterpret_cast<uint8_t *>(Span);
+					UnpackSpan(pSpan,pInput,uX,uCount,pJob);
+					if (pJob->m_bPremultiply) {
+						PremultiplySpan(pSpan,uCount);
+					}
+					PackSpan(pOutput,uX,pSpan,uCount,pJob);
+					uX+=uCount;
+				} while (uX<pJob->m_uWidth);
+			}
+			pInput+=pJob->m_uInputStride;
+			pOutput+=pJob->m_uOutputStride;
+		} while (--uHeight);
+	}
+	return 0;
+}
+
+/***************************************
+
+	Return TRUE if a pixel type is an indexed color type.
+
+***************************************/
+
+static uint_t BURGER_API IsIndexedType(Burger::Image::ePixelTypes eType) BURGER_NOEXCEPT
+{
+	return (eType==Burger::Image::PIXELTYPE1BIT) || (eType==Burger::Image::PIXELTYPE2BIT) ||
+		(eType==Burger::Image::PIXELTYPE4BIT) || (eType==Burger::Image::PIXELTYPE8BIT);
+}
+
+/***************************************
+
+	Return TRUE if a pixel type can hold an alpha other than 0xFF.
+
+***************************************/
+
+static uint_t BURGER_API HasAlphaType(Burger::Image::ePixelTypes eType) BURGER_NOEXCEPT
+{
+	return (eType==Burger::Image::PIXELTYPE4444) || (eType==Burger::Image::PIXELTYPE1555) ||
+		(eType==Burger::Image::PIXELTYPE1010102) || (eType==Burger::Image::PIXELTYPE8888) ||
+		IsIndexedType(eType);
+}
+
+/***************************************
+
+	Run an array of band jobs, one per thread. The calling thread does the
+	last band and if a thread can't be started, its band is done here too.
+
+***************************************/
+
+static void BURGER_API RunBands(Burger::Thread::function_proc_t pProc,void *pJobs,uintptr_t uJobSize,uint_t uCount,const char *pName) BURGER_NOEXCEPT
+{
+	Burger::Thread Threads[kConvertMaxThreads];
+	uint8_t *pJob = static_cast<uint8_t *>(pJobs);
+	const uint_t uThreads = uCount-1U;
+	uint_t i = 0;
+	while (i<uThreads) {
+		if (Threads[i].start(pProc,pJob,pName)) {
+			pProc(pJob);
+		}
+		pJob+=uJobSize;
+		++i;
+	}
+	pProc(pJob);
+	i = 0;
+	while (i<uThreads) {
+		if (Threads[i].is_initialized()) {
+			Threads[i].wait();
+		}
+		++i;
+	}
+}
+
+#endif
+
+/*! ************************************
+
+	\enum Burger::Image::eConvertFlags
+	\brief Flags for Image::Convert()
+
+	\sa Convert(const Image *,const RGBAWord8_t *,uint_t,uint_t)
+
+***************************************/
+
+/*! ************************************
+
+	\brief Convert an image of any uncompressed type into this image
+
+	The image must already be allocated with the output pixel type and the
+	same width and height as the input. Every uncompressed type can be
+	converted to every other uncompressed type.
+
+	Pixels are expanded to RGBA8888 a span at a time and stored in the output
+	type. The common conversions of PIXELTYPE888 to PIXELTYPE8888,
+	PIXELTYPE8888 to PIXELTYPE888, PIXELTYPE8888 to PIXELTYPE565 and
+	PIXELTYPE8BIT to PIXELTYPE8888 are done directly, with SSE2, SSSE3 or NEON
+	when the CPU has them.
+
+	Indexed input uses pPalette to expand the pixels, indexed output is
+	matched to the closest color in pPalette. If there is no palette, indexed
+	pixels are treated as greyscale. 16 bit pixels are native endian and
+	PIXELTYPE1010102 pixels are native endian 32 bit values with red in the
+	lowest 10 bits and alpha in the highest 2 bits.
+
+	If uThreadCount is greater than one and the image is large, the rows are
+	split into bands that are converted by that many threads at once.
+
+	\param pInput Pointer to an image to convert from
+	\param pPalette Palette for indexed input or output, can be \ref NULL
+	\param uFlags \ref CONVERT_PREMULTIPLY to multiply color by alpha
+	\param uThreadCount Number of threads to use, 0 or 1 for none
+	\return Zero if no error, non-zero if the types are compressed or the
+		sizes don't match
+	\sa Store8888(const Image *,const RGBAWord8_t *)
+
+***************************************/
+
+uint_t Burger::Image::Convert(const Image *pInput,const RGBAWord8_t *pPalette,uint_t uFlags,uint_t uThreadCount)
+{
+	const ePixelTypes eInputType = pInput->m_eType;
+	const ePixelTypes eOutputType = m_eType;
+	if (!GetBitsPerPixel(eInputType) || !GetBitsPerPixel(eOutputType) ||
+		((eInputType>=PIXELTYPEDXT1) && (eInputType<=PIXELTYPEDXT5)) ||
+		((eOutputType>=PIXELTYPEDXT1) && (eOutputType<=PIXELTYPEDXT5)) ||
+		(m_uWidth!=pInput->m_uWidth) || (m_uHeight!=pInput->m_uHeight) ||
+		!m_uWidth || !m_uHeight || !m_pImage || !pInput->m_pImage) {
+		return 10;
+	}
+
+	ConvertJob_t Job;
+	Job.m_pInput = pInput->m_pImage;
+	Job.m_pOutput = m_pImage;
+	Job.m_uInputStride = pInput->m_uStride;
+	Job.m_uOutputStride = m_uStride;
+	Job.m_pDirect = NULL;
+	Job.m_uWidth = m_uWidth;
+	Job.m_uHeight = m_uHeight;
+	Job.m_eInputType = eInputType;
+	Job.m_eOutputType = eOutputType;
+	// Only sources with alpha change when premultiplied
+	Job.m_bPremultiply = (uFlags&CONVERT_PREMULTIPLY) && HasAlphaType(eInputType);
+
+	// The palette is stored as RGBA bytes in 32 bit values to copy them
+	// whole, or as a greyscale ramp if there is no palette
+	uint32_t Palette[256];
+	Job.m_pPalette = Palette;
+	Job.m_uPaletteCount = 0;
+	const ePixelTypes eIndexedType = IsIndexedType(eInputType) ? eInputType : eOutputType;
+	if (IsIndexedType(eIndexedType)) {
+		const uint_t uCount = 1U<<eIndexedType;
+		Job.m_uPaletteCount = uCount;
+		const uint_t uStep = 255U/(uCount-1U);
+		uint_t i = 0;
+		do {
+			uint8_t *pEntry = reinterpret_cast<uint8_t *>(Palette+i);
+			if (pPalette) {
+				pEntry[0] = pPalette[i].m_uRed;
+				pEntry[1] = pPalette[i].m_uGreen;
+				pEntry[2] = pPalette[i].m_uBlue;
+				pEntry[3] = pPalette[i].m_uAlpha;
+			} else {
+				const uint8_t uGrey = static_cast<uint8_t>(i*uStep);
+				pEntry[0] = uGrey;
+				pEntry[1] = uGrey;
+				pEntry[2] = uGrey;
+				pEntry[3] = 0xFF;
+			}
+		} while (++i<uCount);
+		// Unused entries of small palettes
+		while (i<256U) {
+			Palette[i] = Palette[0];
+			++i;
+		}
+	}
+
+	// Use a direct converter for the common cases
+	if (eInputType==eOutputType) {
+		// Indexed to indexed copies the indexes unchanged
+		if (!Job.m_bPremultiply || IsIndexedType(eInputType)) {
+			Job.m_pDirect = ConvertCopy;
+		}
+	} else if (eOutputType==PIXELTYPE8888) {
+		if (eInputType==PIXELTYPE888) {
+			Job.m_pDirect = Convert888To8888;
+		} else if (eInputType==PIXELTYPE8BIT) {
+			// Premultiply the palette instead of the pixels
+			if (Job.m_bPremultiply) {
+				PremultiplySpan(reinterpret_cast<uint8_t *>(Palette),256);
+				Job.m_bPremultiply = FALSE;
+			}
+			Job.m_pDirect = Convert8To8888;
+		}
+	} else if ((eInputType==PIXELTYPE8888) && !Job.m_bPremultiply) {
+		if (eOutputType==PIXELTYPE888) {
+			Job.m_pDirect = Convert8888To888;
+		} else if (eOutputType==PIXELTYPE565) {
+			Job.m_pDirect = Convert8888To565;
+		}
+	}
+
+	// Split large images into bands of rows, one per thread
+	if (uThreadCount>kConvertMaxThreads) {
+		uThreadCount = kConvertMaxThreads;
+	}
+	if ((uThreadCount>1U) && (uThreadCount<=m_uHeight) &&
+		((static_cast<uintptr_t>(m_uWidth)*m_uHeight)>=kConvertThreadPixels)) {
+		ConvertJob_t Jobs[kConvertMaxThreads];
+		uint_t uY = 0;
+		uint_t i = 0;
+		do {
+			const uint_t uNextY = static_cast<uint_t>((static_cast<uint64_t>(m_uHeight)*(i+1U))/uThreadCount);
+			Jobs[i] = Job;
+			Jobs[i].m_pInput = Job.m_pInput+(uY*Job.m_uInputStride);
+			Jobs[i].m_pOutput = Job.m_pOutput+(uY*Job.m_uOutputStride);
+			Jobs[i].m_uHeight = uNextY-uY;
+			uY = uNextY;
+		} while (++i<uThreadCount);
+
+		RunBands(ConvertBand,Jobs,sizeof(ConvertJob_t),uThreadCount,"Image::Convert");
+	} else {
+		ConvertBand(&Job);
+	}
+	return 0;
+}
+
+/***************************************
+
+	SSSE3 versions of the byte shuffles used by the file loaders.
+
+***************************************/
+
+#if defined(USE_SSE2)
+static SSSE3_FUNCTION void BURGER_API SwapRedBlue24SSSE3(uint8_t *pOutput,const uint8_t *pInput,uintptr_t uCount) BURGER_NOEXCEPT
+{
+	// Swap 5 pixels and pass through the 16th byte, which is written back
+	// unchanged before the next step loads it
+	const __m128i vShuffle = _mm_setr_epi8(2,1,0,5,4,3,8,7,6,11,10,9,14,13,12,15);
+	while (uCount>=6U) {
+		const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput),_mm_shuffle_epi8(v0,vShuffle));
+		pInput+=15;
+		pOutput+=15;
+		uCount-=5U;
+	}
+	while (uCount) {
+		const uint8_t uRed = pInput[2];
+		pOutput[1] = pInput[1];
+		pOutput[2] = pInput[0];
+		pOutput[0] = uRed;
+		pInput+=3;
+		pOutput+=3;
+		--uCount;
+	}
+}
+
+static SSSE3_FUNCTION void BURGER_API Interleave3PlanesSSSE3(uint8_t *pOutput,const uint8_t *pRed,const uint8_t *pGreen,const uint8_t *pBlue,uintptr_t uCount) BURGER_NOEXCEPT
+{
+	const __m128i vRed0 = _mm_setr_epi8(0,-128,-128,1,-128,-128,2,-128,-128,3,-128,-128,4,-128,-128,5);
+	const __m128i vGreen0 = _mm_setr_epi8(-128,0,-128,-128,1,-128,-128,2,-128,-128,3,-128,-128,4,-128,-128);
+	const __m128i vBlue0 = _mm_setr_epi8(-128,-128,0,-128,-128,1,-128,-128,2,-128,-128,3,-128,-128,4,-128);
+	const __m128i vRed1 = _mm_setr_epi8(-128,-128,6,-128,-128,7,-128,-128,8,-128,-128,9,-128,-128,10,-128);
+	const __m128i vGreen1 = _mm_setr_epi8(5,-128,-128,6,-128,-128,7,-128,-128,8,-128,-128,9,-128,-128,10);
+	const __m128i vBlue1 = _mm_setr_epi8(-128,5,-128,-128,6,-128,-128,7,-128,-128,8,-128,-128,9,-128,-128);
+	const __m128i vRed2 = _mm_setr_epi8(-128,11,-128,-128,12,-128,-128,13,-128,-128,14,-128,-128,15,-128,-128);
+	const __m128i vGreen2 = _mm_setr_epi8(-128,-128,11,-128,-128,12,-128,-128,13,-128,-128,14,-128,-128,15,-128);
+	const __m128i vBlue2 = _mm_setr_epi8(10,-128,-128,11,-128,-128,12,-128,-128,13,-128,-128,14,-128,-128,15);
+	while (uCount>=16U) {
+		const __m128i vR = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pRed));
+		const __m128i vG = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pGreen));
+		const __m128i vB = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pBlue));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput),_mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(vR,vRed0),_mm_shuffle_epi8(vG,vGreen0)),_mm_shuffle_epi8(vB,vBlue0)));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput+16),_mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(vR,vRed1),_mm_shuffle_epi8(vG,vGreen1)),_mm_shuffle_epi8(vB,vBlue1)));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput+32),_mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(vR,vRed2),_mm_shuffle_epi8(vG,vGreen2)),_mm_shuffle_epi8(vB,vBlue2)));
+		pRed+=16;
+		pGreen+=16;
+		pBlue+=16;
+		pOutput+=48;
+		uCount-=16U;
+	}
+	while (uCount) {
+		pOutput[0] = pRed[0];
+		pOutput[1] = pGreen[0];
+		pOutput[2] = pBlue[0];
+		++pRed;
+		++pGreen;
+		++pBlue;
+		pOutput+=3;
+		--uCount;
+	}
+}
+#endif
+
+/*! ************************************
+
+	\brief Swap the red and blue components of 24 bit pixels
+
+	Convert BGR triplets, as found in TGA and BMP files, into RGB triplets or
+	the reverse. pOutput and pInput can be the same buffer, otherwise they
+	must not overlap.
+
+	The swap is done with SSSE3 or NEON when the CPU has them.
+
+	\param pOutput Pointer to the buffer to receive the pixels
+	\param pInput Pointer to the pixels to swap
+	\param uCount Number of pixels to swap
+	\sa SwapRedBlue32(uint8_t *,const uint8_t *,uintptr_t)
+
+***************************************/
+
+void BURGER_API Burger::Image::SwapRedBlue24(uint8_t *pOutput,const uint8_t *pInput,uintptr_t uCount)
+{
+#if defined(USE_SSE2)
+	if (GetConvertFeatures()&2U) {
+		SwapRedBlue24SSSE3(pOutput,pInput,uCount);
+		return;
+	}
+#elif defined(USE_NEON)
+	while (uCount>=16U) {
+		uint8x16x3_t vPixels = vld3q_u8(pInput);
+		const uint8x16_t vRed = vPixels.val[2];
+		vPixels.val[2] = vPixels.val[0];
+		vPixels.val[0] = vRed;
+		vst3q_u8(pOutput,vPixels);
+		pInput+=48;
+		pOutput+=48;
+		uCount-=16U;
+	}
+#endif
+	while (uCount) {
+		const uint8_t uRed = pInput[2];
+		pOutput[1] = pInput[1];
+		pOutput[2] = pInput[0];
+		pOutput[0] = uRed;
+		pInput+=3;
+		pOutput+=3;
+		--uCount;
+	}
+}
+
+/*! ************************************
+
+	\brief Swap the red and blue components of 32 bit pixels
+
+	Convert BGRA pixels, as found in TGA and BMP files, into RGBA pixels or
+	the reverse. Alpha is left in place. pOutput and pInput can be the same
+	buffer, otherwise they must not overlap.
+
+	The swap is done with SSE2 or NEON when the CPU has them.
+
+	\param pOutput Pointer to the buffer to receive the pixels
+	\param pInput Pointer to the pixels to swap
+	\param uCount Number of pixels to swap
+	\sa SwapRedBlue24(uint8_t *,const uint8_t *,uintptr_t)
+
+***************************************/
+
+void BURGER_API Burger::Image::SwapRedBlue32(uint8_t *pOutput,const uint8_t *pInput,uintptr_t uCount)
+{
+#if defined(USE_SSE2)
+	// Bytes 0 and 2 of each little endian 32 bit lane trade places
+	const __m128i vGreenAlpha = _mm_set1_epi32(static_cast<int>(0xFF00FF00U));
+	const __m128i vLow = _mm_set1_epi32(0xFF);
+	while (uCount>=4U) {
+		const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput));
+		const __m128i vRed = _mm_and_si128(_mm_srli_epi32(v0,16),vLow);
+		const __m128i vBlue = _mm_slli_epi32(_mm_and_si128(v0,vLow),16);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput),_mm_or_si128(_mm_and_si128(v0,vGreenAlpha),_mm_or_si128(vRed,vBlue)));
+		pInput+=16;
+		pOutput+=16;
+		uCount-=4U;
+	}
+#elif defined(USE_NEON)
+	while (uCount>=16U) {
+		uint8x16x4_t vPixels = vld4q_u8(pInput);
+		const uint8x16_t vRed = vPixels.val[2];
+		vPixels.val[2] = vPixels.val[0];
+		vPixels.val[0] = vRed;
+		vst4q_u8(pOutput,vPixels);
+		pInput+=64;
+		pOutput+=64;
+		uCount-=16U;
+	}
+#endif
+	while (uCount) {
+		const uint8_t uRed = pInput[2];
+		pOutput[1] = pInput[1];
+		pOutput[2] = pInput[0];
+		pOutput[3] = pInput[3];
+		pOutput[0] = uRed;
+		pInput+=4;
+		pOutput+=4;
+		--uCount;
+	}
+}
+
+/*! ************************************
+
+	\brief Merge red, green and blue planes into RGB triplets
+
+	Given three spans of bytes, one for each color component, interleave them
+	into a span of 24 bit RGB pixels. This is how planar PCX scan lines are
+	converted into PIXELTYPE888 pixels.
+
+	The merge is done with SSSE3 or NEON when the CPU has them.
+
+	\param pOutput Pointer to the buffer to receive uCount*3 bytes
+	\param pRed Pointer to uCount red components
+	\param pGreen Pointer to uCount green components
+	\param pBlue Pointer to uCount blue components
+	\param uCount Number of pixels to merge
+
+***************************************/
+
+void BURGER_API Burger::Image::Interleave3Planes(uint8_t *pOutput,const uint8_t *pRed,const uint8_t *pGreen,const uint8_t *pBlue,uintptr_t uCount)
+{
+#if defined(USE_SSE2)
+	if (GetConvertFeatures()&2U) {
+		Interleave3PlanesSSSE3(pOutput,pRed,pGreen,pBlue,uCount);
+		return;
+	}
+#elif defined(USE_NEON)
+	while (uCount>=16U) {
+		uint8x16x3_t vPixels;
+		vPixels.val[0] = vld1q_u8(pRed);
+		vPixels.val[1] = vld1q_u8(pGreen);
+		vPixels.val[2] = vld1q_u8(pBlue);
+		vst3q_u8(pOutput,vPixels);
+		pRed+=16;
+		pGreen+=16;
+		pBlue+=16;
+		pOutput+=48;
+		uCount-=16U;
+	}
+#endif
+	while (uCount) {
+		pOutput[0] = pRed[0];
+		pOutput[1] = pGreen[0];
+		pOutput[2] = pBlue[0];
+		++pRed;
+		++pGreen;
+		++pBlue;
+		pOutput+=3;
+		--uCount;
+	}
+}
+
+#if !defined(DOXYGEN)
+
+// Number of source rows and weights of the Kaiser filter
+static const uint_t kKaiserTaps = 8;
+
+// Size of the linear to sRGB lookup table
+static const uint_t kLinearToSRGBSize = 4096;
+
+// A mip map level as a raw buffer
+struct MipMapLevel_t {
+	uint8_t *m_pImage;				// First row of the level
+	uintptr_t m_uStride;			// Bytes per row
+	uint_t m_uWidth;				// Width in pixels
+	uint_t m_uHeight;				// Height in pixels
+};
+
+// Description of a band of mip map rows to generate
+struct MipMapJob_t {
+	MipMapLevel_t m_Levels[16];		// All the levels of the image
+	ConvertJob_t m_Convert;			// Pixel type for UnpackSpan() and PackSpan()
+	uint_t m_uFirstLevel;			// Level the rows are generated for
+	uint_t m_uLastLevel;			// Deepest level to cascade into
+	uint_t m_uFirstRow;				// First row of m_uFirstLevel
+	uint_t m_uLastRow;				// Row after the last row of m_uFirstLevel
+	uint_t m_bSRGB;					// TRUE if filtered in linear space
+};
+
+// sRGB to linear and back, built by InitSRGBTables()
+static uint_t g_bSRGBTables;
+static float g_SRGBToLinear[256];
+static uint8_t g_LinearToSRGB[kLinearToSRGBSize];
+
+// Weights of the Kaiser filter, built by InitKaiserWeights()
+static uint_t g_bKaiserWeights;
+static float g_KaiserWeights[kKaiserTaps];
+
+/***************************************
+
+	Build the sRGB conversion tables once.
+
+***************************************/
+
+static void BURGER_API InitSRGBTables(void) BURGER_NOEXCEPT
+{
+	if (!g_bSRGBTables) {
+		uint_t i = 0;
+		do {
+			const double dValue = static_cast<double>(i)/255.0;
+			double dLinear;
+			if (dValue<=0.04045) {
+				dLinear = dValue/12.92;
+			} else {
+				dLinear = Burger::get_power((dValue+0.055)/1.055,2.4);
+			}
+			g_SRGBToLinear[i] = static_cast<float>(dLinear);
+		} while (++i<256U);
+
+		i = 0;
+		do {
+			const double dLinear = static_cast<double>(i)/static_cast<double>(kLinearToSRGBSize-1U);
+			double dValue;
+			if (dLinear<=0.0031308) {
+				dValue = dLinear*12.92;
+			} else {
+				dValue = (1.055*Burger::get_power(dLinear,1.0/2.4))-0.055;
+			}
+			g_LinearToSRGB[i] = static_cast<uint8_t>((dValue*255.0)+0.5);
+		} while (++i<kLinearToSRGBSize);
+		g_bSRGBTables = TRUE;
+	}
+}
+
+/***************************************
+
+	Build the Kaiser windowed sinc weights for halving an image once.
+
+***************************************/
+
+static double BURGER_API BesselI0(double dInput) BURGER_NOEXCEPT
+{
+	// Power series of the modified Bessel function of the first kind
+	double dSum = 1.0;
+	double dTerm = 1.0;
+	const double dHalf = dInput*0.5;
+	uint_t i = 1;
+	do {
+		dTerm *= dHalf/static_cast<double>(i);
+		dSum += dTerm*dTerm;
+	} while (++i<20U);
+	return dSum;
+}
+
+static void BURGER_API InitKaiserWeights(void) BURGER_NOEXCEPT
+{
+	if (!g_bKaiserWeights) {
+		// Window of 4 source pixels on each side with an alpha of 4
+		const double dAlpha = 4.0;
+		const double dWidth = 4.0;
+		double Weights[kKaiserTaps];
+		double dTotal = 0.0;
+		uint_t i = 0;
+		do {
+			// Distance from the center of the two source pixels
+			const double dDistance = static_cast<double>(i)-3.5;
+			const double dX = dDistance*0.5*Burger::g_dPi;
+			const double dSinc = Burger::get_sine(dX)/dX;
+			const double dRatio = dDistance/dWidth;
+			const double dWeight = dSinc*BesselI0(dAlpha*Burger::square_root(1.0-(dRatio*dRatio)))/BesselI0(dAlpha);
+			Weights[i] = dWeight;
+			dTotal += dWeight;
+		} while (++i<kKaiserTaps);
+		i = 0;
+		do {
+			g_KaiserWeights[i] = static_cast<float>(Weights[i]/dTotal);
+		} while (++i<kKaiserTaps);
+		g_bKaiserWeights = TRUE;
+	}
+}
+
+/***************************************
+
+	Convert a linear value from 0.0f to 1.0f into an 8 bit sRGB value.
+
+***************************************/
+
+BURGER_INLINE uint8_t LinearToSRGB(float fInput) BURGER_NOEXCEPT
+{
+	int iIndex = static_cast<int>((fInput*static_cast<float>(kLinearToSRGBSize-1U))+0.5f);
+	if (iIndex<0) {
+		iIndex = 0;
+	} else if (iIndex>=static_cast<int>(kLinearToSRGBSize)) {
+		iIndex = static_cast<int>(kLinearToSRGBSize-1U);
+	}
+	return g_LinearToSRGB[iIndex];
+}
+
+/***************************************
+
+	Convert a value from 0.0f to 1.0f into an 8 bit value with rounding.
+
+***************************************/
+
+BURGER_INLINE uint8_t FloatToByte(float fInput) BURGER_NOEXCEPT
+{
+	int iValue = static_cast<int>((fInput*255.0f)+0.5f);
+	if (iValue<0) {
+		iValue = 0;
+	} else if (iValue>255) {
+		iValue = 255;
+	}
+	return static_cast<uint8_t>(iValue);
+}
+
+/***************************************
+
+	Average 2x2 blocks of pixels with 1 byte per channel.
+
+***************************************/
+
+static void BURGER_API BoxBytes(uint8_t *pOutput,const uint8_t *pRow0,const uint8_t *pRow1,uint_t uWidth,uint_t uChannels) BURGER_NOEXCEPT
+{
+	do {
+		uint_t i = 0;
+		do {
+			pOutput[i] = static_cast<uint8_t>((pRow0[i]+pRow0[i+uChannels]+pRow1[i]+pRow1[i+uChannels]+2U)>>2U);
+		} while (++i<uChannels);
+		pRow0+=uChannels*2U;
+		pRow1+=uChannels*2U;
+		pOutput+=uChannels;
+	} while (--uWidth);
+}
+
+/***************************************
+
+	Average 2x2 blocks of RGBA8888 pixels.
+
+***************************************/
+
+static void BURGER_API Box8888(uint8_t *pOutput,const uint8_t *pRow0,const uint8_t *pRow1,uint_t uWidth) BURGER_NOEXCEPT
+{
+#if defined(USE_SSE2)
+	if (uWidth>=4U) {
+		const __m128i vZero = _mm_setzero_si128();
+		const __m128i vTwo = _mm_set1_epi16(2);
+		do {
+			// 8 source pixels from each row make 4 output pixels
+			__m128i vTop = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pRow0));
+			__m128i vBottom = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pRow1));
+			__m128i vLow = _mm_add_epi16(_mm_unpacklo_epi8(vTop,vZero),_mm_unpacklo_epi8(vBottom,vZero));
+			__m128i vHigh = _mm_add_epi16(_mm_unpackhi_epi8(vTop,vZero),_mm_unpackhi_epi8(vBottom,vZero));
+			// Add the left and right pixels together
+			__m128i vFirst = _mm_add_epi16(_mm_unpacklo_epi64(vLow,vHigh),_mm_unpackhi_epi64(vLow,vHigh));
+
+			vTop = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pRow0+16));
+			vBottom = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pRow1+16));
+			vLow = _mm_add_epi16(_mm_unpacklo_epi8(vTop,vZero),_mm_unpacklo_epi8(vBottom,vZero));
+			vHigh = _mm_add_epi16(_mm_unpackhi_epi8(vTop,vZero),_mm_unpackhi_epi8(vBottom,vZero));
+			__m128i vSecond = _mm_add_epi16(_mm_unpacklo_epi64(vLow,vHigh),_mm_unpackhi_epi64(vLow,vHigh));
+
+			vFirst = _mm_srli_epi16(_mm_add_epi16(vFirst,vTwo),2);
+			vSecond = _mm_srli_epi16(_mm_add_epi16(vSecond,vTwo),2);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(pOutput),_mm_packus_epi16(vFirst,vSecond));
+			pRow0+=32;
+			pRow1+=32;
+			pOutput+=16;
+			uWidth-=4U;
+		} while (uWidth>=4U);
+	}
+#elif defined(USE_NEON)
+	if (uWidth>=2U) {
+		do {
+			// 4 source pixels from each row make 2 output pixels
+			const uint8x16_t vTop = vld1q_u8(pRow0);
+			const uint8x16_t vBottom = vld1q_u8(pRow1);
+			const uint16x8_t vLow = vaddl_u8(vget_low_u8(vTop),vget_low_u8(vBottom));
+			const uint16x8_t vHigh = vaddl_u8(vget_high_u8(vTop),vget_high_u8(vBottom));
+			const uint16x8_t vSum = vcombine_u16(vadd_u16(vget_low_u16(vLow),vget_high_u16(vLow)),
+				vadd_u16(vget_low_u16(vHigh),vget_high_u16(vHigh)));
+			vst1_u8(pOutput,vrshrn_n_u16(vSum,2));
+			pRow0+=16;
+			pRow1+=16;
+			pOutput+=8;
+			uWidth-=2U;
+		} while (uWidth>=2U);
+	}
+#endif
+	if (uWidth) {
+		BoxBytes(pOutput,pRow0,pRow1,uWidth,4);
+	}
+}
+
+/***************************************
+
+	Average 2x2 blocks of sRGB pixels in linear space, alpha is linear.
+
+***************************************/
+
+static void BURGER_API BoxSRGB(uint8_t *pOutput,const uint8_t *pRow0,const uint8_t *pRow1,uint_t uWidth,uint_t uChannels) BURGER_NOEXCEPT
+{
+	do {
+		uint_t i = 0;
+		do {
+			const float fSum = g_SRGBToLinear[pRow0[i]]+g_SRGBToLinear[pRow0[i+uChannels]]+
+				g_SRGBToLinear[pRow1[i]]+g_SRGBToLinear[pRow1[i+uChannels]];
+			pOutput[i] = LinearToSRGB(fSum*0.25f);
+		} while (++i<3U);
+		if (uChannels==4U) {
+			pOutput[3] = static_cast<uint8_t>((pRow0[3]+pRow0[7]+pRow1[3]+pRow1[7]+2U)>>2U);
+		}
+		pRow0+=uChannels*2U;
+		pRow1+=uChannels*2U;
+		pOutput+=uChannels;
+	} while (--uWidth);
+}
+
+/***************************************
+
+	Generate row uY of level uLevel from level uLevel-1 with a box filter.
+
+***************************************/
+
+static void BURGER_API MipMapBoxRow(const MipMapJob_t *pJob,uint_t uLevel,uint_t uY) BURGER_NOEXCEPT
+{
+	const MipMapLevel_t *pSource = &pJob->m_Levels[uLevel-1U];
+	const MipMapLevel_t *pDest = &pJob->m_Levels[uLevel];
+	const uint8_t *pRow0 = pSource->m_pImage+(uY*2U*pSource->m_uStride);
+	const uint8_t *pRow1 = pRow0+pSource->m_uStride;
+	uint8_t *pOutput = pDest->m_pImage+(uY*pDest->m_uStride);
+	const uint_t uWidth = pDest->m_uWidth;
+
+	switch (pJob->m_Convert.m_eInputType) {
+	case Burger::Image::PIXELTYPE8888:
+		if (pJob->m_bSRGB) {
+			BoxSRGB(pOutput,pRow0,pRow1,uWidth,4);
+		} else {
+			Box8888(pOutput,pRow0,pRow1,uWidth);
+		}
+		break;
+	case Burger::Image::PIXELTYPE888:
+		if (pJob->m_bSRGB) {
+			BoxSRGB(pOutput,pRow0,pRow1,uWidth,3);
+		} else {
+			BoxBytes(pOutput,pRow0,pRow1,uWidth,3);
+		}
+		break;
+	// PIXELTYPE565 and PIXELTYPE4444 are filtered as RGBA8888
+	default:
+		{
+			uint32_t Top[kConvertSpanSize];
+			uint32_t Bottom[kConvertSpanSize];
+			uint32_t Result[kConvertSpanSize/2];
+			uint_t uX = 0;
+			do {
+				uint_t uCount = uWidth-uX;
+				if (uCount>(kConvertSpanSize/2U)) {
+					uCount = kConvertSpanSize/2U;
+				}
+				UnpackSpan(reinterpret_cast<uint8_t *>(Top),pRow0,uX*2U,uCount*2U,&pJob->m_Convert);
+				UnpackSpan(reinterpret_cast<uint8_t *>(Bottom),pRow1,uX*2U,uCount*2U,&pJob->m_Convert);
+				if (pJob->m_bSRGB) {
+					BoxSRGB(reinterpret_cast<uint8_t *>(Result),reinterpret_cast<const uint8_t *>(Top),reinterpret_cast<const uint8_t *>(Bottom),uCount,4);
+				} else {
+					Box8888(reinterpret_cast<uint8_t *>(Result),reinterpret_cast<const uint8_t *>(Top),reinterpret_cast<const uint8_t *>(Bottom),uCount);
+				}
+				PackSpan(pOutput,uX,reinterpret_cast<const uint8_t *>(Result),uCount,&pJob->m_Convert);
+				uX+=uCount;
+			} while (uX<uWidth);
+		}
+		break;
+	}
+}
+
+/***************************************
+
+	Generate a band of rows of the first level and as soon as two rows of
+	a level exist, the row of the next level made from them, so the source
+	rows are still in the cache.
+
+***************************************/
+
+static uintptr_t BURGER_API MipMapBoxBand(void *pThis) BURGER_NOEXCEPT
+{
+	const MipMapJob_t *pJob = static_cast<const MipMapJob_t *>(pThis);
+	uint_t uRow = pJob->m_uFirstRow;
+	while (uRow<pJob->m_uLastRow) {
+		uint_t uLevel = pJob->m_uFirstLevel;
+		uint_t uY = uRow;
+		for (;;) {
+			MipMapBoxRow(pJob,uLevel,uY);
+			// Odd rows complete a pair for the next level
+			if ((uLevel>=pJob->m_uLastLevel) || !(uY&1U)) {
+				break;
+			}
+			uY>>=1U;
+			++uLevel;
+			if (uY>=pJob->m_Levels[uLevel].m_uHeight) {
+				break;
+			}
+		}
+		++uRow;
+	}
+	return 0;
+}
+
+/***************************************
+
+	Filter an RGBA float row horizontally by half with the Kaiser weights.
+
+***************************************/
+
+static void BURGER_API KaiserRow(float *pOutput,const float *pInput,uint_t uInputWidth,uint_t uOutputWidth) BURGER_NOEXCEPT
+{
+	const int iLast = static_cast<int>(uInputWidth)-1;
+	uint_t uX = 0;
+	do {
+		const int iStart = static_cast<int>(uX*2U)-3;
+#if defined(USE_SSE2) || defined(USE_NEON)
+		// Each RGBA pixel is one vector
+#if defined(USE_SSE2)
+		__m128 vSum = _mm_setzero_ps();
+#else
+		float32x4_t vSum = vdupq_n_f32(0.0f);
+#endif
+		uint_t i = 0;
+		do {
+			int iX = iStart+static_cast<int>(i);
+			if (iX<0) {
+				iX = 0;
+			} else if (iX>iLast) {
+				iX = iLast;
+			}
+#if defined(USE_SSE2)
+			vSum = _mm_add_ps(vSum,_mm_mul_ps(_mm_loadu_ps(pInput+(iX*4)),_mm_set1_ps(g_KaiserWeights[i])));
+#else
+			vSum = vmlaq_n_f32(vSum,vld1q_f32(pInput+(iX*4)),g_KaiserWeights[i]);
+#endif
+		} while (++i<kKaiserTaps);
+#if defined(USE_SSE2)
+		_mm_storeu_ps(pOutput,vSum);
+#else
+		vst1q_f32(pOutput,vSum);
+#endif
+#else
+		float fRed = 0.0f;
+		float fGreen = 0.0f;
+		float fBlue = 0.0f;
+		float fAlpha = 0.0f;
+		uint_t i = 0;
+		do {
+			int iX = iStart+static_cast<int>(i);
+			if (iX<0) {
+				iX = 0;
+			} else if (iX>iLast) {
+				iX = iLast;
+			}
+			const float *pPixel = pInput+(iX*4);
+			const float fWeight = g_KaiserWeights[i];
+			fRed += pPixel[0]*fWeight;
+			fGreen += pPixel[1]*fWeight;
+			fBlue += pPixel[2]*fWeight;
+			fAlpha += pPixel[3]*fWeight;
+		} while (++i<kKaiserTaps);
+		pOutput[0] = fRed;
+		pOutput[1] = fGreen;
+		pOutput[2] = fBlue;
+		pOutput[3] = fAlpha;
+#endif
+		pOutput+=4;
+	} while (++uX<uOutputWidth);
+}
+
+/***************************************
+
+	Sum the horizontally filtered rows with the Kaiser weights.
+
+***************************************/
+
+static void BURGER_API KaiserColumn(float *pOutput,const float * const *ppRows,uintptr_t uCount) BURGER_NOEXCEPT
+{
+	uintptr_t uIndex = 0;
+#if defined(USE_SSE2)
+	while ((uIndex+4U)<=uCount) {
+		__m128 vSum = _mm_setzero_ps();
+		uint_t i = 0;
+		do {
+			vSum = _mm_add_ps(vSum,_mm_mul_ps(_mm_loadu_ps(ppRows[i]+uIndex),_mm_set1_ps(g_KaiserWeights[i])));
+		} while (++i<kKaiserTaps);
+		_mm_storeu_ps(pOutput+uIndex,vSum);
+		uIndex+=4U;
+	}
+#elif defined(USE_NEON)
+	while ((uIndex+4U)<=uCount) {
+		float32x4_t vSum = vdupq_n_f32(0.0f);
+		uint_t i = 0;
+		do {
+			vSum = vmlaq_n_f32(vSum,vld1q_f32(ppRows[i]+uIndex),g_KaiserWeights[i]);
+		} while (++i<kKaiserTaps);
+		vst1q_f32(pOutput+uIndex,vSum);
+		uIndex+=4U;
+	}
+#endif
+	while (uIndex<uCount) {
+		float fSum = 0.0f;
+		uint_t i = 0;
+		do {
+			fSum += ppRows[i][uIndex]*g_KaiserWeights[i];
+		} while (++i<kKaiserTaps);
+		pOutput[uIndex] = fSum;
+		++uIndex;
+	}
+}
+
+/***************************************
+
+	Generate a band of rows of a level with the Kaiser filter. Each source
+	row is filtered horizontally once and kept in a ring of 8 rows.
+
+***************************************/
+
+static uintptr_t BURGER_API MipMapKaiserBand(void *pThis) BURGER_NOEXCEPT
+{
+	const MipMapJob_t *pJob = static_cast<const MipMapJob_t *>(pThis);
+	const MipMapLevel_t *pSource = &pJob->m_Levels[pJob->m_uFirstLevel-1U];
+	const MipMapLevel_t *pDest = &pJob->m_Levels[pJob->m_uFirstLevel];
+	const uint_t uInputWidth = pSource->m_uWidth;
+	const uint_t uOutputWidth = pDest->m_uWidth;
+	const uintptr_t uOutputFloats = static_cast<uintptr_t>(uOutputWidth)*4U;
+
+	// RGBA bytes and floats of a source row, the ring of filtered rows, the
+	// filtered output row and its RGBA bytes
+	const uintptr_t uSize = (static_cast<uintptr_t>(uInputWidth)*(4U+(4U*sizeof(float))))+
+		(uOutputFloats*((kKaiserTaps+1U)*sizeof(float)))+uOutputFloats;
+	float *pInputFloats = static_cast<float *>(Burger::allocate_memory(uSize));
+	if (pInputFloats) {
+		float *pRing = pInputFloats+(uInputWidth*4U);
+		float *pFiltered = pRing+(uOutputFloats*kKaiserTaps);
+		uint8_t *pInputBytes = reinterpret_cast<uint8_t *>(pFiltered+uOutputFloats);
+		uint8_t *pOutputBytes = pInputBytes+(uInputWidth*4U);
+		int RingRows[kKaiserTaps];
+		uint_t i = 0;
+		do {
+			RingRows[i] = -1;
+		} while (++i<kKaiserTaps);
+
+		const int iLastRow = static_cast<int>(pSource->m_uHeight)-1;
+		uint_t uY = pJob->m_uFirstRow;
+		do {
+			const float *Rows[kKaiserTaps];
+			i = 0;
+			do {
+				int iRow = static_cast<int>(uY*2U)-3+static_cast<int>(i);
+				if (iRow<0) {
+					iRow = 0;
+				} else if (iRow>iLastRow) {
+					iRow = iLastRow;
+				}
+				// Filter the source row if it's not already in the ring
+				const uint_t uSlot = static_cast<uint_t>(iRow)&(kKaiserTaps-1U);
+				float *pSlot = pRing+(uSlot*uOutputFloats);
+				if (RingRows[uSlot]!=iRow) {
+					RingRows[uSlot] = iRow;
+					const uint8_t *pRow = pSource->m_pImage+(static_cast<uintptr_t>(iRow)*pSource->m_uStride);
+					if (pJob->m_Convert.m_eInputType!=Burger::Image::PIXELTYPE8888) {
+						UnpackSpan(pInputBytes,pRow,0,uInputWidth,&pJob->m_Convert);
+						pRow = pInputBytes;
+					}
+					float *pFloat = pInputFloats;
+					uint_t uCount = uInputWidth;
+					do {
+						if (pJob->m_bSRGB) {
+							pFloat[0] = g_SRGBToLinear[pRow[0]];
+							pFloat[1] = g_SRGBToLinear[pRow[1]];
+							pFloat[2] = g_SRGBToLinear[pRow[2]];
+						} else {
+							pFloat[0] = static_cast<float>(pRow[0])*(1.0f/255.0f);
+							pFloat[1] = static_cast<float>(pRow[1])*(1.0f/255.0f);
+							pFloat[2] = static_cast<float>(pRow[2])*(1.0f/255.0f);
+						}
+						pFloat[3] = static_cast<float>(pRow[3])*(1.0f/255.0f);
+						pRow+=4;
+						pFloat+=4;
+					} while (--uCount);
+					KaiserRow(pSlot,pInputFloats,uInputWidth,uOutputWidth);
+				}
+				Rows[i] = pSlot;
+			} while (++i<kKaiserTaps);
+
+			KaiserColumn(pFiltered,Rows,uOutputFloats);
+
+			// Back to bytes and then the pixel type
+			uint8_t *pOutput = pDest->m_pImage+(uY*pDest->m_uStride);
+			uint8_t *pBytes = (pJob->m_Convert.m_eInputType==Burger::Image::PIXELTYPE8888) ? pOutput : pOutputBytes;
+			const float *pFloat = pFiltered;
+			uint_t uCount = uOutputWidth;
+			do {
+				if (pJob->m_bSRGB) {
+					pBytes[0] = LinearToSRGB(pFloat[0]);
+					pBytes[1] = LinearToSRGB(pFloat[1]);
+					pBytes[2] = LinearToSRGB(pFloat[2]);
+				} else {
+					pBytes[0] = FloatToByte(pFloat[0]);
+					pBytes[1] = FloatToByte(pFloat[1]);
+					pBytes[2] = FloatToByte(pFloat[2]);
+				}
+				pBytes[3] = FloatToByte(pFloat[3]);
+				pBytes+=4;
+				pFloat+=4;
+			} while (--uCount);
+			if (pJob->m_Convert.m_eInputType!=Burger::Image::PIXELTYPE8888) {
+				PackSpan(pOutput,0,pOutputBytes,uOutputWidth,&pJob->m_Convert);
+			}
+		} while (++uY<pJob->m_uLastRow);
+		Burger::free_memory(pInputFloats);
+	}
+	return 0;
+}
+
+/***************************************
+
+	Split the rows of a level into bands and run them.
+
+***************************************/
+
+static void BURGER_API MipMapRunBands(MipMapJob_t *pJob,Burger::Thread::function_proc_t pProc,uint_t uRowsPerBlock,uint_t uThreadCount) BURGER_NOEXCEPT
+{
+	// Bands must start on a block of rows
+	const uint_t uHeight = pJob->m_Levels[pJob->m_uFirstLevel].m_uHeight;
+	const uint_t uBlocks = uHeight/uRowsPerBlock;
+	const MipMapLevel_t *pSource = &pJob->m_Levels[pJob->m_uFirstLevel-1U];
+	if ((uThreadCount>1U) && (uBlocks>=uThreadCount) &&
+		((static_cast<uintptr_t>(pSource->m_uWidth)*pSource->m_uHeight)>=kConvertThreadPixels)) {
+		MipMapJob_t Jobs[kConvertMaxThreads];
+		uint_t uRow = 0;
+		uint_t i = 0;
+		do {
+			Jobs[i] = *pJob;
+			Jobs[i].m_uFirstRow = uRow;
+			uRow = ((uBlocks*(i+1U))/uThreadCount)*uRowsPerBlock;
+			Jobs[i].m_uLastRow = uRow;
+		} while (++i<uThreadCount);
+		// The last band gets the rows after the last whole block
+		Jobs[uThreadCount-1U].m_uLastRow = uHeight;
+		RunBands(pProc,Jobs,sizeof(MipMapJob_t),uThreadCount,"Image::GenerateMipMaps");
+	} else {
+		pJob->m_uFirstRow = 0;
+		pJob->m_uLastRow = uHeight;
+		pProc(pJob);
+	}
+}
+
+#endif
+
+/*! ************************************
+
+	\enum Burger::Image::eMipMapFlags
+	\brief Flags for Image::GenerateMipMaps()
+
+	\sa GenerateMipMaps(uint_t,uint_t)
+
+***************************************/
+
+/*! ************************************
+
+	\brief Generate all of the mip maps from the first level
+
+	The image must have been allocated with mip maps and be of the type
+	PIXELTYPE8888, PIXELTYPE888, PIXELTYPE565 or PIXELTYPE4444. Each level is
+	made from the level before it.
+
+	\ref MIPMAP_BOX averages 2x2 blocks of pixels. Each row is cascaded
+	through all of the smaller levels as soon as it's made, so the source
+	data is still in the cache. \ref MIPMAP_KAISER uses a Kaiser windowed
+	sinc filter with 8 taps which keeps more detail at the cost of speed.
+
+	If \ref MIPMAP_SRGB is set, the color is treated as sRGB and is filtered
+	in linear space. Alpha is always filtered as linear.
+
+	If uThreadCount is greater than one and the image is large, bands of
+	rows are generated by that many threads at once.
+
+	\param uFlags \ref MIPMAP_BOX or \ref MIPMAP_KAISER with \ref MIPMAP_SRGB
+	\param uThreadCount Number of threads to use, 0 or 1 for none
+	\return Zero if no error, non-zero if the type isn't supported or there
+		are no mip maps
+	\sa GetMipMapCount(void) const or GetImage(uint_t) const
+
+***************************************/
+
+uint_t Burger::Image::GenerateMipMaps(uint_t uFlags,uint_t uThreadCount)
+{
+	const uint_t uMipMaps = m_uFlags&FLAGS_MIPMAPMASK;
+	if (!m_pImage || (uMipMaps<2U) ||
+		((m_eType!=PIXELTYPE8888) && (m_eType!=PIXELTYPE888) &&
+		(m_eType!=PIXELTYPE565) && (m_eType!=PIXELTYPE4444))) {
+		return 10;
+	}
+
+	MipMapJob_t Job;
+	memory_clear(&Job,sizeof(Job));
+	Job.m_Convert.m_eInputType = m_eType;
+	Job.m_Convert.m_eOutputType = m_eType;
+	Job.m_bSRGB = (uFlags&MIPMAP_SRGB)!=0;
+
+	// Get the levels, stop at the first empty one
+	uint_t uLevels = 0;
+	do {
+		MipMapLevel_t *pLevel = &Job.m_Levels[uLevels];
+		pLevel->m_uWidth = GetWidth(uLevels);
+		pLevel->m_uHeight = GetHeight(uLevels);
+		if (!pLevel->m_uWidth || !pLevel->m_uHeight) {
+			break;
+		}
+		pLevel->m_pImage = m_pImage+(GetImage(uLevels)-m_pImage);
+		pLevel->m_uStride = GetStride(uLevels);
+	} while (++uLevels<uMipMaps);
+
+	// The tables are built before any threads are started
+	if (Job.m_bSRGB) {
+		InitSRGBTables();
+	}
+	if (uThreadCount>kConvertMaxThreads) {
+		uThreadCount = kConvertMaxThreads;
+	}
+
+	if (uLevels>=2U) {
+		if ((uFlags&MIPMAP_FILTERMASK)==MIPMAP_KAISER) {
+			InitKaiserWeights();
+			Job.m_uFirstLevel = 1;
+			do {
+				Job.m_uLastLevel = Job.m_uFirstLevel;
+				MipMapRunBands(&Job,MipMapKaiserBand,1,uThreadCount);
+			} while (++Job.m_uFirstLevel<uLevels);
+		} else {
+			// Cascade as deep as possible while still having a block of rows
+			// for each thread
+			const uint_t uHeight = Job.m_Levels[1].m_uHeight;
+			uint_t uDepth = uLevels-2U;
+			if (uThreadCount>1U) {
+				while (uDepth && ((uHeight>>uDepth)<uThreadCount)) {
+					--uDepth;
+				}
+			}
+			Job.m_uFirstLevel = 1;
+			Job.m_uLastLevel = 1U+uDepth;
+			MipMapRunBands(&Job,MipMapBoxBand,1U<<uDepth,uThreadCount);
+
+			// Any remaining tiny levels are done on this thread
+			if ((Job.m_uLastLevel+1U)<uLevels) {
+				Job.m_uFirstLevel = Job.m_uLastLevel+1U;
+				Job.m_uLastLevel = uLevels-1U;
+				MipMapRunBands(&Job,MipMapBoxBand,1,1);
+			}
+		}
+	}
+	return 0;
+}
+
+#if !defined(DOXYGEN)
+
+// Fixed point weights are 1.14
+static const uint_t kResampleWeightBits = 14;
+
+// Horizontally filtered fixed point values are 10.6 to keep the overshoot
+static const uint_t kResampleFractionBits = 6;
+
+// Weights of one direction of a resample
+struct ResampleWeights_t {
+	void *m_pMemory;				// Memory for the tables
+	uint_t *m_pStart;				// First source pixel for each output pixel
+	int16_t *m_pFixed;				// m_uTaps fixed point weights per output pixel
+	float *m_pFloat;				// m_uTaps float weights per output pixel
+	uint_t m_uTaps;					// Number of weights per output pixel
+};
+
+// Description of a band of rows to resample
+struct ResampleJob_t {
+	const uint8_t *m_pInput;		// First input row
+	uint8_t *m_pOutput;				// First output row
+	uintptr_t m_uInputStride;		// Bytes per input row
+	uintptr_t m_uOutputStride;		// Bytes per output row
+	const ResampleWeights_t *m_pColumns;	// Horizontal weights
+	const ResampleWeights_t *m_pRows;		// Vertical weights
+	uint_t m_uInputWidth;			// Width of the input in pixels
+	uint_t m_uOutputWidth;			// Width of the output in pixels
+	uint_t m_uChannels;				// Values per pixel
+	uint_t m_uFirstRow;				// First output row of the band
+	uint_t m_uLastRow;				// Row after the last output row of the band
+	uint_t m_bFloat;				// TRUE if the pixels are floats
+};
+
+/***************************************
+
+	Return the weight of a resampling filter at a distance.
+
+***************************************/
+
+static float BURGER_API ResampleKernel(float fDistance,Burger::Image::eResampleFilters eFilter) BURGER_NOEXCEPT
+{
+	if (fDistance<0.0f) {
+		fDistance = -fDistance;
+	}
+	float fResult = 0.0f;
+	switch (eFilter) {
+	case Burger::Image::RESAMPLE_BILINEAR:
+		if (fDistance<1.0f) {
+			fResult = 1.0f-fDistance;
+		}
+		break;
+	case Burger::Image::RESAMPLE_BICUBIC:
+		// Catmull-Rom spline
+		if (fDistance<1.0f) {
+			fResult = (((1.5f*fDistance)-2.5f)*fDistance*fDistance)+1.0f;
+		} else if (fDistance<2.0f) {
+			fResult = (((((-0.5f*fDistance)+2.5f)*fDistance)-4.0f)*fDistance)+2.0f;
+		}
+		break;
+	// RESAMPLE_LANCZOS3
+	default:
+		if (fDistance<0.0001f) {
+			fResult = 1.0f;
+		} else if (fDistance<3.0f) {
+			const float fX = fDistance*Burger::g_fPi;
+			fResult = (3.0f*Burger::get_sine(fX)*Burger::get_sine(fX*(1.0f/3.0f)))/(fX*fX);
+		}
+		break;
+	}
+	return fResult;
+}
+
+/***************************************
+
+	Build the weights for resampling uInput pixels into uOutput pixels.
+
+***************************************/
+
+static uint_t BURGER_API InitResampleWeights(ResampleWeights_t *pOutput,uint_t uInput,uint_t uOutput,Burger::Image::eResampleFilters eFilter) BURGER_NOEXCEPT
+{
+	// Stretch the filter when shrinking so every source pixel is used
+	const float fScale = static_cast<float>(uInput)/static_cast<float>(uOutput);
+	const float fFilterScale = (fScale>1.0f) ? fScale : 1.0f;
+	float fSupport;
+	if (eFilter==Burger::Image::RESAMPLE_BILINEAR) {
+		fSupport = 1.0f;
+	} else if (eFilter==Burger::Image::RESAMPLE_BICUBIC) {
+		fSupport = 2.0f;
+	} else {
+		fSupport = 3.0f;
+	}
+	fSupport *= fFilterScale;
+
+	// Use an even number of taps so the vector loops can do them in pairs
+	uint_t uTaps = static_cast<uint_t>(fSupport*2.0f)+1U;
+	uTaps = (uTaps+1U)&~1U;
+	if (uTaps>uInput) {
+		uTaps = uInput;
+	}
+	pOutput->m_uTaps = uTaps;
+
+	const uintptr_t uWeights = static_cast<uintptr_t>(uOutput)*uTaps;
+	uint8_t *pMemory = static_cast<uint8_t *>(Burger::allocate_memory((uWeights*sizeof(float))+
+		(uWeights*sizeof(int16_t))+(uOutput*sizeof(uint_t))));
+	if (!pMemory) {
+		return 10;
+	}
+	pOutput->m_pMemory = pMemory;
+	pOutput->m_pFloat = reinterpret_cast<float *>(pMemory);
+	pOutput->m_pFixed = reinterpret_cast<int16_t *>(pMemory+(uWeights*sizeof(float)));
+	pOutput->m_pStart = reinterpret_cast<uint_t *>(pMemory+(uWeights*(sizeof(float)+sizeof(int16_t))));
+
+	float *pFloat = pOutput->m_pFloat;
+	int16_t *pFixed = pOutput->m_pFixed;
+	uint_t uX = 0;
+	do {
+		// Center of the output pixel in source pixels
+		const float fCenter = ((static_cast<float>(uX)+0.5f)*fScale)-0.5f;
+		int iLeft = static_cast<int>(Burger::get_floor(fCenter-fSupport))+1;
+		int iRight = static_cast<int>(Burger::get_ceiling(fCenter+fSupport))-1;
+
+		// Keep the window inside the source
+		int iStart = iLeft;
+		if ((iStart+static_cast<int>(uTaps))>static_cast<int>(uInput)) {
+			iStart = static_cast<int>(uInput-uTaps);
+		}
+		if (iStart<0) {
+			iStart = 0;
+		}
+		pOutput->m_pStart[uX] = static_cast<uint_t>(iStart);
+
+		uint_t i = 0;
+		do {
+			pFloat[i] = 0.0f;
+		} while (++i<uTaps);
+
+		// Pixels past the edges use the edge pixel
+		float fTotal = 0.0f;
+		int iX = iLeft;
+		do {
+			const float fWeight = ResampleKernel((static_cast<float>(iX)-fCenter)/fFilterScale,eFilter);
+			int iSource = iX;
+			if (iSource<0) {
+				iSource = 0;
+			} else if (iSource>=static_cast<int>(uInput)) {
+				iSource = static_cast<int>(uInput)-1;
+			}
+			int iTap = iSource-iStart;
+			if (iTap>=static_cast<int>(uTaps)) {
+				iTap = static_cast<int>(uTaps)-1;
+			}
+			pFloat[iTap] += fWeight;
+			fTotal += fWeight;
+		} while (++iX<=iRight);
+
+		// Normalize and make the fixed point weights sum to exactly 1.0
+		const float fFixedOne = static_cast<float>(1U<<kResampleWeightBits);
+		int iFixedTotal = 0;
+		uint_t uLargest = 0;
+		i = 0;
+		do {
+			if (fTotal!=0.0f) {
+				pFloat[i] /= fTotal;
+			}
+			const float fFixed = pFloat[i]*fFixedOne;
+			const int iFixed = static_cast<int>((fFixed<0.0f) ? fFixed-0.5f : fFixed+0.5f);
+			pFixed[i] = static_cast<int16_t>(iFixed);
+			iFixedTotal += iFixed;
+			if (pFixed[i]>pFixed[uLargest]) {
+				uLargest = i;
+			}
+		} while (++i<uTaps);
+		pFixed[uLargest] = static_cast<int16_t>(pFixed[uLargest]+(static_cast<int>(1U<<kResampleWeightBits)-iFixedTotal));
+
+		pFloat+=uTaps;
+		pFixed+=uTaps;
+	} while (++uX<uOutput);
+	return 0;
+}
+
+/***************************************
+
+	Filter a row of 8 bit values horizontally into 10.6 fixed point.
+
+***************************************/
+
+static void BURGER_API ResampleRowFixed(int16_t *pOutput,const uint8_t *pInput,const ResampleJob_t *pJob) BURGER_NOEXCEPT
+{
+	const ResampleWeights_t *pColumns = pJob->m_pColumns;
+	const uint_t uTaps = pColumns->m_uTaps;
+	const uint_t uChannels = pJob->m_uChannels;
+	const int16_t *pWeights = pColumns->m_pFixed;
+	uint_t uX = 0;
+#if defined(USE_SSE2)
+	if ((uChannels==4U) && !(uTaps&1U)) {
+		const __m128i vZero = _mm_setzero_si128();
+		const __m128i vRound = _mm_set1_epi32(1<<(kResampleFractionBits-1U));
+		do {
+			const uint8_t *pSource = pInput+(pColumns->m_pStart[uX]*4U);
+			__m128i vSum = _mm_setzero_si128();
+			uint_t i = 0;
+			do {
+				// Two RGBA pixels, interleaved per channel to multiply and
+				// add them with their weights at once
+				__m128i vPixels = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(pSource+(i*4U))),vZero);
+				vPixels = _mm_unpacklo_epi16(vPixels,_mm_srli_si128(vPixels,8));
+				const __m128i vWeights = _mm_set1_epi32(static_cast<int>((static_cast<uint32_t>(static_cast<uint16_t>(pWeights[i+1]))<<16U)|static_cast<uint16_t>(pWeights[i])));
+				vSum = _mm_add_epi32(vSum,_mm_madd_epi16(vPixels,vWeights));
+				i+=2;
+			} while (i<uTaps);
+			vSum = _mm_srai_epi32(_mm_add_epi32(vSum,vRound),kResampleWeightBits-kResampleFractionBits);
+			_mm_storel_epi64(reinterpret_cast<__m128i *>(pOutput),_mm_packs_epi32(vSum,vSum));
+			pWeights+=uTaps;
+			pOutput+=4;
+		} while (++uX<pJob->m_uOutputWidth);
+		return;
+	}
+#elif defined(USE_NEON)
+	if (uChannels==4U) {
+		do {
+			const uint8_t *pSource = pInput+(pColumns->m_pStart[uX]*4U);
+			int32x4_t vSum = vdupq_n_s32(0);
+			uint_t i = 0;
+			do {
+				const int16x4_t vPixel = vreinterpret_s16_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vld1_dup_u32(reinterpret_cast<const uint32_t *>(pSource+(i*4U)))))));
+				vSum = vmlal_n_s16(vSum,vPixel,pWeights[i]);
+			} while (++i<uTaps);
+			vst1_s16(pOutput,vqrshrn_n_s32(vSum,kResampleWeightBits-kResampleFractionBits));
+			pWeights+=uTaps;
+			pOutput+=4;
+		} while (++uX<pJob->m_uOutputWidth);
+		return;
+	}
+#endif
+	do {
+		const uint8_t *pSource = pInput+(pColumns->m_pStart[uX]*uChannels);
+		uint_t uChannel = 0;
+		do {
+			int32_t iSum = 1<<(kResampleWeightBits-kResampleFractionBits-1U);
+			uint_t i = 0;
+			do {
+				iSum += pSource[(i*uChannels)+uChannel]*pWeights[i];
+			} while (++i<uTaps);
+			iSum >>= kResampleWeightBits-kResampleFractionBits;
+			if (iSum>32767) {
+				iSum = 32767;
+			} else if (iSum<-32768) {
+				iSum = -32768;
+			}
+			pOutput[uChannel] = static_cast<int16_t>(iSum);
+		} while (++uChannel<uChannels);
+		pWeights+=uTaps;
+		pOutput+=uChannels;
+	} while (++uX<pJob->m_uOutputWidth);
+}
+
+/***************************************
+
+	Sum 10.6 fixed point rows with weights into 8 bit values.
+
+***************************************/
+
+static void BURGER_API ResampleColumnFixed(uint8_t *pOutput,const int16_t * const *ppRows,const int16_t *pWeights,uint_t uTaps,uintptr_t uCount) BURGER_NOEXCEPT
+{
+	const uint_t uShift = kResampleWeightBits+kResampleFractionBits;
+	uintptr_t uIndex = 0;
+#if defined(USE_SSE2)
+	const __m128i vRound = _mm_set1_epi32(1<<(uShift-1U));
+	while ((uIndex+8U)<=uCount) {
+		__m128i vLow = vRound;
+		__m128i vHigh = vRound;
+		uint_t i = 0;
+		do {
+			// An odd last row is paired with itself with a weight of zero
+			const uint_t uNext = ((i+1U)<uTaps) ? i+1U : i;
+			const int16_t iNextWeight = ((i+1U)<uTaps) ? pWeights[i+1] : static_cast<int16_t>(0);
+			const __m128i vFirst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ppRows[i]+uIndex));
+			const __m128i vSecond = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ppRows[uNext]+uIndex));
+			const __m128i vWeights = _mm_set1_epi32(static_cast<int>((static_cast<uint32_t>(static_cast<uint16_t>(iNextWeight))<<16U)|static_cast<uint16_t>(pWeights[i])));
+			vLow = _mm_add_epi32(vLow,_mm_madd_epi16(_mm_unpacklo_epi16(vFirst,vSecond),vWeights));
+			vHigh = _mm_add_epi32(vHigh,_mm_madd_epi16(_mm_unpackhi_epi16(vFirst,vSecond),vWeights));
+			i+=2;
+		} while (i<uTaps);
+		const __m128i vResult = _mm_packs_epi32(_mm_srai_epi32(vLow,uShift),_mm_srai_epi32(vHigh,uShift));
+		_mm_storel_epi64(reinterpret_cast<__m128i *>(pOutput+uIndex),_mm_packus_epi16(vResult,vResult));
+		uIndex+=8U;
+	}
+#elif defined(USE_NEON)
+	while ((uIndex+8U)<=uCount) {
+		int32x4_t vLow = vdupq_n_s32(0);
+		int32x4_t vHigh = vdupq_n_s32(0);
+		uint_t i = 0;
+		do {
+			const int16x8_t vRow = vld1q_s16(ppRows[i]+uIndex);
+			vLow = vmlal_n_s16(vLow,vget_low_s16(vRow),pWeights[i]);
+			vHigh = vmlal_n_s16(vHigh,vget_high_s16(vRow),pWeights[i]);
+		} while (++i<uTaps);
+		const int16x8_t vResult = vcombine_s16(vqrshrn_n_s32(vLow,kResampleWeightBits),vqrshrn_n_s32(vHigh,kResampleWeightBits));
+		vst1_u8(pOutput+uIndex,vqrshrun_n_s16(vResult,kResampleFractionBits));
+		uIndex+=8U;
+	}
+#endif
+	while (uIndex<uCount) {
+		int32_t iSum = 1<<(uShift-1U);
+		uint_t i = 0;
+		do {
+			iSum += ppRows[i][uIndex]*pWeights[i];
+		} while (++i<uTaps);
+		iSum >>= uShift;
+		if (iSum<0) {
+			iSum = 0;
+		} else if (iSum>255) {
+			iSum = 255;
+		}
+		pOutput[uIndex] = static_cast<uint8_t>(iSum);
+		++uIndex;
+	}
+}
+
+/***************************************
+
+	Filter a row of floats horizontally.
+
+***************************************/
+
+static void BURGER_API ResampleRowFloat(float *pOutput,const float *pInput,const ResampleJob_t *pJob) BURGER_NOEXCEPT
+{
+	const ResampleWeights_t *pColumns = pJob->m_pColumns;
+	const uint_t uTaps = pColumns->m_uTaps;
+	const uint_t uChannels = pJob->m_uChannels;
+	const float *pWeights = pColumns->m_pFloat;
+	uint_t uX = 0;
+	do {
+		const float *pSource = pInput+(pColumns->m_pStart[uX]*uChannels);
+#if defined(USE_SSE2) || defined(USE_NEON)
+		if (uChannels==4U) {
+			// Each pixel is one vector
+#if defined(USE_SSE2)
+			__m128 vSum = _mm_setzero_ps();
+#else
+			float32x4_t vSum = vdupq_n_f32(0.0f);
+#endif
+			uint_t i = 0;
+			do {
+#if defined(USE_SSE2)
+				vSum = _mm_add_ps(vSum,_mm_mul_ps(_mm_loadu_ps(pSource+(i*4U)),_mm_set1_ps(pWeights[i])));
+#else
+				vSum = vmlaq_n_f32(vSum,vld1q_f32(pSource+(i*4U)),pWeights[i]);
+#endif
+			} while (++i<uTaps);
+#if defined(USE_SSE2)
+			_mm_storeu_ps(pOutput,vSum);
+#else
+			vst1q_f32(pOutput,vSum);
+#endif
+		} else
+#endif
+		{
+			uint_t uChannel = 0;
+			do {
+				float fSum = 0.0f;
+				uint_t i = 0;
+				do {
+					fSum += pSource[(i*uChannels)+uChannel]*pWeights[i];
+				} while (++i<uTaps);
+				pOutput[uChannel] = fSum;
+			} while (++uChannel<uChannels);
+		}
+		pWeights+=uTaps;
+		pOutput+=uChannels;
+	} while (++uX<pJob->m_uOutputWidth);
+}
+
+/***************************************
+
+	Sum float rows with weights.
+
+***************************************/
+
+static void BURGER_API ResampleColumnFloat(float *pOutput,const float * const *ppRows,const float *pWeights,uint_t uTaps,uintptr_t uCount) BURGER_NOEXCEPT
+{
+	uintptr_t uIndex = 0;
+#if defined(USE_SSE2)
+	while ((uIndex+4U)<=uCount) {
+		__m128 vSum = _mm_setzero_ps();
+		uint_t i = 0;
+		do {
+			vSum = _mm_add_ps(vSum,_mm_mul_ps(_mm_loadu_ps(ppRows[i]+uIndex),_mm_set1_ps(pWeights[i])));
+		} while (++i<uTaps);
+		_mm_storeu_ps(pOutput+uIndex,vSum);
+		uIndex+=4U;
+	}
+#elif defined(USE_NEON)
+	while ((uIndex+4U)<=uCount) {
+		float32x4_t vSum = vdupq_n_f32(0.0f);
+		uint_t i = 0;
+		do {
+			vSum = vmlaq_n_f32(vSum,vld1q_f32(ppRows[i]+uIndex),pWeights[i]);
+		} while (++i<uTaps);
+		vst1q_f32(pOutput+uIndex,vSum);
+		uIndex+=4U;
+	}
+#endif
+	while (uIndex<uCount) {
+		float fSum = 0.0f;
+		uint_t i = 0;
+		do {
+			fSum += ppRows[i][uIndex]*pWeights[i];
+		} while (++i<uTaps);
+		pOutput[uIndex] = fSum;
+		++uIndex;
+	}
+}
+
+/***************************************
+
+	Resample a band of output rows. Each source row is filtered
+	horizontally once and kept in a ring as long as it's needed.
+
+***************************************/
+
+static uintptr_t BURGER_API ResampleBand(void *pThis) BURGER_NOEXCEPT
+{
+	const ResampleJob_t *pJob = static_cast<const ResampleJob_t *>(pThis);
+	const ResampleWeights_t *pWeights = pJob->m_pRows;
+	const uint_t uTaps = pWeights->m_uTaps;
+	const uintptr_t uValues = static_cast<uintptr_t>(pJob->m_uOutputWidth)*pJob->m_uChannels;
+	const uintptr_t uValueSize = pJob->m_bFloat ? sizeof(float) : sizeof(int16_t);
+
+	// Ring of filtered rows, the row numbers in each slot and the rows used
+	// for an output row
+	uint8_t *pRing = static_cast<uint8_t *>(Burger::allocate_memory((uValues*uValueSize*uTaps)+
+		(uTaps*(sizeof(uint_t)+sizeof(const uint8_t *)))));
+	if (pRing) {
+		const uint8_t **pRows = reinterpret_cast<const uint8_t **>(pRing+(uValues*uValueSize*uTaps));
+		uint_t *pRingRows = reinterpret_cast<uint_t *>(pRows+uTaps);
+		uint_t i = 0;
+		do {
+			pRingRows[i] = UINT32_MAX;
+		} while (++i<uTaps);
+
+		uint_t uY = pJob->m_uFirstRow;
+		do {
+			const uint_t uStart = pWeights->m_pStart[uY];
+			i = 0;
+			do {
+				// Rows in a window are consecutive, so they use different slots
+				const uint_t uRow = uStart+i;
+				const uint_t uSlot = uRow%uTaps;
+				uint8_t *pSlot = pRing+(uSlot*uValues*uValueSize);
+				if (pRingRows[uSlot]!=uRow) {
+					pRingRows[uSlot] = uRow;
+					const uint8_t *pInput = pJob->m_pInput+(uRow*pJob->m_uInputStride);
+					if (pJob->m_bFloat) {
+						ResampleRowFloat(reinterpret_cast<float *>(pSlot),reinterpret_cast<const float *>(pInput),pJob);
+					} else {
+						ResampleRowFixed(reinterpret_cast<int16_t *>(pSlot),pInput,pJob);
+					}
+				}
+				pRows[i] = pSlot;
+			} while (++i<uTaps);
+
+			uint8_t *pOutput = pJob->m_pOutput+(uY*pJob->m_uOutputStride);
+			if (pJob->m_bFloat) {
+				ResampleColumnFloat(reinterpret_cast<float *>(pOutput),reinterpret_cast<const float * const *>(pRows),pWeights->m_pFloat+(uY*uTaps),uTaps,uValues);
+			} else {
+				ResampleColumnFixed(pOutput,reinterpret_cast<const int16_t * const *>(pRows),pWeights->m_pFixed+(uY*uTaps),uTaps,uValues);
+			}
+		} while (++uY<pJob->m_uLastRow);
+		Burger::free_memory(pRing);
+	}
+	return 0;
+}
+
+/***************************************
+
+	Resample a band of output rows with the nearest source pixel.
+
+***************************************/
+
+static uintptr_t BURGER_API ResampleNearestBand(void *pThis) BURGER_NOEXCEPT
+{
+	const ResampleJob_t *pJob = static_cast<const ResampleJob_t *>(pThis);
+	const uint_t *pColumns = pJob->m_pColumns->m_pStart;
+	const uint_t *pRows = pJob->m_pRows->m_pStart;
+	const uint_t uSize = pJob->m_uChannels;
+	uint_t uY = pJob->m_uFirstRow;
+	do {
+		const uint8_t *pInput = pJob->m_pInput+(pRows[uY]*pJob->m_uInputStride);
+		uint8_t *pOutput = pJob->m_pOutput+(uY*pJob->m_uOutputStride);
+		uint_t uX = 0;
+		switch (uSize) {
+		case 1:
+			do {
+				pOutput[uX] = pInput[pColumns[uX]];
+			} while (++uX<pJob->m_uOutputWidth);
+			break;
+		case 4:
+			do {
+				Burger::memory_copy(pOutput+(uX*4U),pInput+(pColumns[uX]*4U),4);
+			} while (++uX<pJob->m_uOutputWidth);
+			break;
+		default:
+			do {
+				Burger::memory_copy(pOutput+(uX*uSize),pInput+(pColumns[uX]*uSize),uSize);
+			} while (++uX<pJob->m_uOutputWidth);
+			break;
+		}
+	} while (++uY<pJob->m_uLastRow);
+	return 0;
+}
+
+/***************************************
+
+	Source pixel for each output pixel for nearest resampling.
+
+***************************************/
+
+static uint_t BURGER_API InitResampleNearest(ResampleWeights_t *pOutput,uint_t uInput,uint_t uOutput) BURGER_NOEXCEPT
+{
+	pOutput->m_uTaps = 1;
+	uint_t *pStart = static_cast<uint_t *>(Burger::allocate_memory(uOutput*sizeof(uint_t)));
+	if (!pStart) {
+		return 10;
+	}
+	pOutput->m_pMemory = pStart;
+	pOutput->m_pStart = pStart;
+	uint_t uX = 0;
+	do {
+		// Pixel under the center of the output pixel
+		pStart[uX] = static_cast<uint_t>((((static_cast<uint64_t>(uX)*2U+1U)*uInput)/(static_cast<uint64_t>(uOutput)*2U)));
+	} while (++uX<uOutput);
+	return 0;
+}
+
+/***************************************
+
+	Build the weights, split the output into bands and run them.
+
+***************************************/
+
+static uint_t BURGER_API ResampleRun(ResampleJob_t *pJob,uint_t uInputHeight,uint_t uOutputHeight,Burger::Image::eResampleFilters eFilter,uint_t uThreadCount) BURGER_NOEXCEPT
+{
+	ResampleWeights_t Columns;
+	ResampleWeights_t Rows;
+	Burger::memory_clear(&Columns,sizeof(Columns));
+	Burger::memory_clear(&Rows,sizeof(Rows));
+	uint_t uResult;
+	Burger::Thread::function_proc_t pProc;
+	if (eFilter==Burger::Image::RESAMPLE_NEAREST) {
+		uResult = InitResampleNearest(&Columns,pJob->m_uInputWidth,pJob->m_uOutputWidth);
+		uResult |= InitResampleNearest(&Rows,uInputHeight,uOutputHeight);
+		pProc = ResampleNearestBand;
+	} else {
+		uResult = InitResampleWeights(&Columns,pJob->m_uInputWidth,pJob->m_uOutputWidth,eFilter);
+		uResult |= InitResampleWeights(&Rows,uInputHeight,uOutputHeight,eFilter);
+		pProc = ResampleBand;
+	}
+
+	// The weights are read only, so they are shared by all the bands
+	if (!uResult) {
+		pJob->m_pColumns = &Columns;
+		pJob->m_pRows = &Rows;
+		if (uThreadCount>kConvertMaxThreads) {
+			uThreadCount = kConvertMaxThreads;
+		}
+		if ((uThreadCount>1U) && (uOutputHeight>=uThreadCount) &&
+			((static_cast<uintptr_t>(pJob->m_uOutputWidth)*uOutputHeight)>=kConvertThreadPixels)) {
+			ResampleJob_t Jobs[kConvertMaxThreads];
+			uint_t uY = 0;
+			uint_t i = 0;
+			do {
+				Jobs[i] = *pJob;
+				Jobs[i].m_uFirstRow = uY;
+				uY = static_cast<uint_t>((static_cast<uint64_t>(uOutputHeight)*(i+1U))/uThreadCount);
+				Jobs[i].m_uLastRow = uY;
+			} while (++i<uThreadCount);
+			RunBands(pProc,Jobs,sizeof(ResampleJob_t),uThreadCount,"Image::Resample");
+		} else {
+			pJob->m_uFirstRow = 0;
+			pJob->m_uLastRow = uOutputHeight;
+			pProc(pJob);
+		}
+	}
+	Burger::free_memory(Columns.m_pMemory);
+	Burger::free_memory(Rows.m_pMemory);
+	return uResult;
+}
+
+#endif
+
+/*! ************************************
+
+	\enum Burger::Image::eResampleFilters
+	\brief Filters for Image::Resample()
+
+	\sa Resample(const Image *,eResampleFilters,uint_t)
+
+***************************************/
+
+/*! ************************************
+
+	\brief Resize an image into this image
+
+	The image must already be allocated with the output size and the same
+	pixel type as the input.
+
+	\ref RESAMPLE_NEAREST copies the closest pixel and works with any pixel
+	type that is a whole number of bytes, including indexed types. The
+	other filters work with PIXELTYPE888 and PIXELTYPE8888 and are
+	separable. The weights for each output column and row are made once,
+	then each source row is filtered horizontally into 10.6 fixed point and
+	the rows are filtered vertically into the output with SSE2 or NEON when
+	available. When shrinking, the filters are stretched so every source
+	pixel contributes.
+
+	If uThreadCount is greater than one and the image is large, bands of
+	output rows are made by that many threads at once.
+
+	\param pInput Pointer to an image to resize
+	\param eFilter Filter to use
+	\param uThreadCount Number of threads to use, 0 or 1 for none
+	\return Zero if no error, non-zero if the types don't match or aren't
+		supported by the filter
+	\sa ResampleFloat(float *,uint_t,uint_t,uintptr_t,const float *,uint_t,uint_t,uintptr_t,uint_t,eResampleFilters,uint_t)
+
+***************************************/
+
+uint_t Burger::Image::Resample(const Image *pInput,eResampleFilters eFilter,uint_t uThreadCount)
+{
+	const uint_t uBits = GetBitsPerPixel(m_eType);
+	if ((m_eType!=pInput->m_eType) || !m_pImage || !pInput->m_pImage ||
+		!m_uWidth || !m_uHeight || !pInput->m_uWidth || !pInput->m_uHeight ||
+		!uBits || (uBits&7U)) {
+		return 10;
+	}
+	if ((eFilter!=RESAMPLE_NEAREST) && (m_eType!=PIXELTYPE888) && (m_eType!=PIXELTYPE8888)) {
+		return 10;
+	}
+
+	ResampleJob_t Job;
+	Job.m_pInput = pInput->m_pImage;
+	Job.m_pOutput = m_pImage;
+	Job.m_uInputStride = pInput->m_uStride;
+	Job.m_uOutputStride = m_uStride;
+	Job.m_uInputWidth = pInput->m_uWidth;
+	Job.m_uOutputWidth = m_uWidth;
+	// Nearest copies whole pixels, the filters work on each byte
+	Job.m_uChannels = uBits>>3U;
+	Job.m_bFloat = FALSE;
+	return ResampleRun(&Job,pInput->m_uHeight,m_uHeight,eFilter,uThreadCount);
+}
+
+/*! ************************************
+
+	\brief Resize an image made of floats
+
+	For high dynamic range images and intermediate results, resize an
+	image where each pixel is uChannels floats. The same filters as
+	Resample(const Image *,eResampleFilters,uint_t) are used, the values
+	are not clamped. Strides are in bytes.
+
+	\param pOutput Pointer to the output image
+	\param uOutputWidth Width of the output in pixels
+	\param uOutputHeight Height of the output in pixels
+	\param uOutputStride Bytes per output row
+	\param pInput Pointer to the input image
+	\param uInputWidth Width of the input in pixels
+	\param uInputHeight Height of the input in pixels
+	\param uInputStride Bytes per input row
+	\param uChannels Number of floats per pixel
+	\param eFilter Filter to use
+	\param uThreadCount Number of threads to use, 0 or 1 for none
+	\return Zero if no error, non-zero if out of memory or a size is zero
+	\sa Resample(const Image *,eResampleFilters,uint_t)
+
+***************************************/
+
+uint_t BURGER_API Burger::Image::ResampleFloat(float *pOutput,uint_t uOutputWidth,uint_t uOutputHeight,uintptr_t uOutputStride,
+	const float *pInput,uint_t uInputWidth,uint_t uInputHeight,uintptr_t uInputStride,uint_t uChannels,eResampleFilters eFilter,uint_t uThreadCount)
+{
+	if (!pOutput || !pInput || !uOutputWidth || !uOutputHeight ||
+		!uInputWidth || !uInputHeight || !uChannels) {
+		return 10;
+	}
+	ResampleJob_t Job;
+	Job.m_pInput = reinterpret_cast<const uint8_t *>(pInput);
+	Job.m_pOutput = reinterpret_cast<uint8_t *>(pOutput);
+	Job.m_uInputStride = uInputStride;
+	Job.m_uOutputStride = uOutputStride;
+	Job.m_uInputWidth = uInputWidth;
+	Job.m_uOutputWidth = uOutputWidth;
+	Job.m_uChannels = uChannels;
+	Job.m_bFloat = TRUE;
+	// Nearest treats each pixel as uChannels*4 bytes
+	if (eFilter==RESAMPLE_NEAREST) {
+		Job.m_uChannels = uChannels*static_cast<uint_t>(sizeof(float));
+	}
+	return ResampleRun(&Job,uInputHeight,uOutputHeight,eFilter,uThreadCount);
+}
@@ -36,6 +36,21 @@ public:
 		FLAGS_IMAGENOTALLOCATED=0x0020,	///< \ref TRUE if the image pointer was not allocated (And won't be released when Image goes out of scope)
 		FLAGS_MIPMAPMASK=0x001F			///< Mask for the number of mip maps present (0 means only one level, max 16)
 	};
+	enum eConvertFlags {
+		CONVERT_PREMULTIPLY=0x0001		///< Multiply red, green and blue by alpha in Convert()
+	};
+	enum eMipMapFlags {
+		MIPMAP_BOX=0x0000,				///< Average 2x2 blocks of pixels in GenerateMipMaps()
+		MIPMAP_KAISER=0x0001,			///< Use a Kaiser windowed sinc filter in GenerateMipMaps()
+		MIPMAP_FILTERMASK=0x000F,		///< Mask for the filter type
+		MIPMAP_SRGB=0x0010				///< Color is sRGB, filter it in linear space
+	};
+	enum eResampleFilters {
+		RESAMPLE_NEAREST,				///< Use the closest pixel in Resample()
+		RESAMPLE_BILINEAR,				///< Linear filter in Resample()
+		RESAMPLE_BICUBIC,				///< Catmull-Rom cubic filter in Resample()
+		RESAMPLE_LANCZOS3				///< Lanczos filter with 3 lobes in Resample()
+	};
 	enum ePixelTypes {
 		PIXELTYPE1BIT=1,			///< 1 bit per pixel monochrome
 		PIXELTYPE2BIT=2,			///< 2 bits per pixel indexed by RGB palette
@@ -117,6 +132,14 @@ public:
 	uint_t VerticleFlip(void);
 	uint_t HorizontalFlip(void);
 	uint_t Store8888(const Image *pInput,const RGBAWord8_t *pPalette);
+	uint_t Convert(const Image *pInput,const RGBAWord8_t *pPalette=NULL,uint_t uFlags=0,uint_t uThreadCount=1);
+	uint_t GenerateMipMaps(uint_t uFlags=MIPMAP_BOX,uint_t uThreadCount=1);
+	uint_t Resample(const Image *pInput,eResampleFilters eFilter=RESAMPLE_BILINEAR,uint_t uThreadCount=1);
+	static void BURGER_API SwapRedBlue24(uint8_t *pOutput,const uint8_t *pInput,uintptr_t uCount);
+	static void BURGER_API SwapRedBlue32(uint8_t *pOutput,const uint8_t *pInput,uintptr_t uCount);
+	static void BURGER_API Interleave3Planes(uint8_t *pOutput,const uint8_t *pRed,const uint8_t *pGreen,const uint8_t *pBlue,uintptr_t uCount);
+	static uint_t BURGER_API ResampleFloat(float *pOutput,uint_t uOutputWidth,uint_t uOutputHeight,uintptr_t uOutputStride,
+		const float *pInput,uint_t uInputWidth,uint_t uInputHeight,uintptr_t uInputStride,uint_t uChannels,eResampleFilters eFilter,uint_t uThreadCount=1);
 };
 }
 /* END */
@@ -16,6 +16,7 @@
 #include "brassert.h"
 #include "brfile.h"
 #include "brglobals.h"
+#include "brlogsink.h"
 #include "brnumberstring.h"
 #include "brnumberstringhex.h"
 #include "brstringfunctions.h"
@@ -28,6 +29,9 @@
 #define HASVSNPRINTF
 #endif
 
+// Buffered log that receives all debug output
+static Burger::LogSink* g_pDebugLogSink;
+
 /*! ************************************
 
 	\namespace Burger::Debug
@@ -99,6 +103,12 @@ uint_t BURGER_ANSIAPI Burger::Debug::Fatal(
 			// Print it
 			PrintString(TempBuffer);
 		}
+
+		// Make sure the message is written before exiting
+		LogSink* pSink = g_pDebugLogSink;
+		if (pSink) {
+			pSink->flush();
+		}
 		Globals::Shutdown(); // Exit to OS
 	}
 
@@ -240,6 +250,12 @@ void BURGER_API Burger::Debug::PrintString(const char* pString) BURGER_NOEXCEPT
 	if (pString && !Globals::GetExitFlag()) {
 		const uintptr_t i = string_length(pString);
 		if (i) {
+			// Send to the buffered log if one was set
+			LogSink* pSink = get_log_sink();
+			if (pSink) {
+				pSink->write(pString, i);
+				return;
+			}
 
 			// MacOS 9/Carbon doesn't have a console,
 			// so send the data to a file
@@ -284,6 +300,41 @@ void BURGER_API Burger::Debug::PrintString(uint64_t uInput) BURGER_NOEXCEPT
 	PrintString(TempBuffer);
 }
 
+/*! ************************************
+
+	\brief Send debug output to a LogSink
+
+	Route the output of Debug::PrintString(), and by extension Debug::Message()
+	and Debug::Warning(), to a LogSink so the calling thread doesn't wait for
+	the debugger or the log file.
+
+	\param pLogSink Pointer to a LogSink or \ref nullptr to restore direct
+		output
+
+	\sa get_log_sink(void)
+
+***************************************/
+
+void BURGER_API Burger::Debug::set_log_sink(LogSink* pLogSink) BURGER_NOEXCEPT
+{
+	g_pDebugLogSink = pLogSink;
+}
+
+/*! ************************************
+
+	\brief Get the LogSink receiving debug output
+
+	\return Pointer to the LogSink or \ref nullptr if output is direct
+
+	\sa set_log_sink(LogSink*)
+
+***************************************/
+
+Burger::LogSink* BURGER_API Burger::Debug::get_log_sink(void) BURGER_NOEXCEPT
+{
+	return g_pDebugLogSink;
+}
+
 /*! ************************************
 
 	\brief Detect if a debugger is attached
@@ -22,6 +22,8 @@
 /* BEGIN */
 namespace Burger {
 
+class LogSink;
+
 namespace Debug {
 extern uint_t BURGER_ANSIAPI Fatal(const char* pMessage, ...) BURGER_NOEXCEPT;
 extern void BURGER_ANSIAPI Warning(const char* pMessage, ...) BURGER_NOEXCEPT;
@@ -37,6 +39,8 @@ BURGER_INLINE void PrintString(uintptr_t uInput) BURGER_NOEXCEPT
 #endif
 
 extern void BURGER_API PrintErrorMessage(uint_t uErrorCode) BURGER_NOEXCEPT;
+extern void BURGER_API set_log_sink(LogSink* pLogSink) BURGER_NOEXCEPT;
+extern LogSink* BURGER_API get_log_sink(void) BURGER_NOEXCEPT;
 }
 
 extern void BURGER_API OkAlertMessage(
@@ -16,6 +16,165 @@
 #include "brfloatingpoint.h"
 #include "brtemplates.h"
 
+// Select the vector unit used for swapping arrays
+#if defined(BURGER_SSE2) && defined(BURGER_INTEL) && \
+	((defined(BURGER_GNUC) && (BURGER_GNUC >= 40900)) || \
+		defined(BURGER_CLANG) || (BURGER_MSVC >= 190000000)) && \
+	!defined(DOXYGEN)
+// SSSE3 is tested for at runtime
+#define USE_SSSE3
+#include "bratomic.h"
+#include <tmmintrin.h>
+#if defined(BURGER_MSVC)
+#define SSSE3_FUNCTION
+#else
+#define SSSE3_FUNCTION __attribute__((target("ssse3")))
+#endif
+
+#elif defined(BURGER_NEON) && defined(BURGER_ARM64) && !defined(DOXYGEN)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(USE_SSSE3) || defined(USE_NEON)
+#define USE_VECTOR
+
+// Element sizes for SwapVectors()
+enum eSwapType { kSwap16, kSwap32, kSwap64 };
+
+#if defined(USE_SSSE3)
+
+// pshufb masks to reverse the bytes of each 16, 32 and 64 bit element
+static const uint8_t g_SwapMasks[3][16] = {
+	{1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14},
+	{3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12},
+	{7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8}};
+
+/***************************************
+
+	Swap 16 bytes at a time with pshufb, 64 bytes per loop. Input and output
+	can be the same buffer. Returns the number of bytes processed.
+
+***************************************/
+
+static SSSE3_FUNCTION uintptr_t BURGER_API SwapVectors(uint8_t* pOutput,
+	const uint8_t* pInput, uintptr_t uLength, eSwapType uType) BURGER_NOEXCEPT
+{
+	const __m128i vMask =
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(g_SwapMasks[uType]));
+	uintptr_t uBlocks = uLength >> 6U;
+	while (uBlocks) {
+		const __m128i v0 =
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput));
+		const __m128i v1 =
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput + 16));
+		const __m128i v2 =
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput + 32));
+		const __m128i v3 =
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput + 48));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput),
+			_mm_shuffle_epi8(v0, vMask));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput + 16),
+			_mm_shuffle_epi8(v1, vMask));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput + 32),
+			_mm_shuffle_epi8(v2, vMask));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput + 48),
+			_mm_shuffle_epi8(v3, vMask));
+		pInput += 64;
+		pOutput += 64;
+		--uBlocks;
+	}
+	uBlocks = (uLength >> 4U) & 3U;
+	while (uBlocks) {
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput),
+			_mm_shuffle_epi8(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput)),
+				vMask));
+		pInput += 16;
+		pOutput += 16;
+		--uBlocks;
+	}
+	return uLength & ~static_cast<uintptr_t>(15U);
+}
+
+/***************************************
+
+	Test once if the CPU supports SSSE3.
+
+***************************************/
+
+static uint_t g_uSSSE3State;
+
+static uint_t BURGER_API HasSSSE3(void) BURGER_NOEXCEPT
+{
+	uint_t uState = g_uSSSE3State;
+	if (!uState) {
+		Burger::CPUID_t CPUInfo;
+		Burger::CPUID(&CPUInfo);
+		uState = CPUInfo.has_SSSE3() ? 2U : 1U;
+		g_uSSSE3State = uState;
+	}
+	return uState == 2U;
+}
+
+#else
+
+/***************************************
+
+	Swap 16 bytes at a time with rev16, rev32 or rev64. Input and output can
+	be the same buffer. Returns the number of bytes processed.
+
+***************************************/
+
+static uintptr_t BURGER_API SwapVectors(uint8_t* pOutput,
+	const uint8_t* pInput, uintptr_t uLength, eSwapType uType) BURGER_NOEXCEPT
+{
+	uintptr_t uBlocks = uLength >> 4U;
+	if (uBlocks) {
+		if (uType == kSwap16) {
+			do {
+				vst1q_u8(pOutput, vrev16q_u8(vld1q_u8(pInput)));
+				pInput += 16;
+				pOutput += 16;
+			} while (--uBlocks);
+		} else if (uType == kSwap32) {
+			do {
+				vst1q_u8(pOutput, vrev32q_u8(vld1q_u8(pInput)));
+				pInput += 16;
+				pOutput += 16;
+			} while (--uBlocks);
+		} else {
+			do {
+				vst1q_u8(pOutput, vrev64q_u8(vld1q_u8(pInput)));
+				pInput += 16;
+				pOutput += 16;
+			} while (--uBlocks);
+		}
+	}
+	return uLength & ~static_cast<uintptr_t>(15U);
+}
+#endif
+
+/***************************************
+
+	Swap as many whole 16 byte blocks as possible with the vector unit.
+	Returns the number of bytes processed, the caller swaps the rest.
+
+***************************************/
+
+static BURGER_INLINE uintptr_t SwapDispatch(void* pOutput,
+	const void* pInput, uintptr_t uLength, eSwapType uType) BURGER_NOEXCEPT
+{
+#if defined(USE_SSSE3)
+	if ((uLength < 16U) || !HasSSSE3()) {
+		return 0;
+	}
+#endif
+	return SwapVectors(static_cast<uint8_t*>(pOutput),
+		static_cast<const uint8_t*>(pInput), uLength, uType);
+}
+#endif
+
 /*! ************************************
 
 	\brief Swap endian of a 16 bit integer
@@ -1667,6 +1826,8 @@ void BURGER_API Burger::_store_unaligned_swap(
 	Given a pointer to an array of 16-bit integers, swap the endian of every
 	entry
 
+	\note On SSSE3 and ARM64 CPUs, 16 bytes are swapped per instruction.
+
 	\param pInput Pointer to the array to endian swap
 	\param uElements Number of elements in the array (Not bytes)
 
@@ -1677,6 +1838,13 @@ void BURGER_API Burger::_store_unaligned_swap(
 void BURGER_API Burger::swap_endian(
 	uint16_t* pInput, uintptr_t uElements) BURGER_NOEXCEPT
 {
+#if defined(USE_VECTOR)
+	// Swap 16 bytes at a time if possible
+	const uintptr_t uDone =
+		SwapDispatch(pInput, pInput, uElements << 1U, kSwap16) >> 1U;
+	pInput += uDone;
+	uElements -= uDone;
+#endif
 	// Any data to process?
 	if (uElements) {
 		do {
@@ -1705,6 +1873,14 @@ void BURGER_API Burger::swap_endian(
 void BURGER_API Burger::swap_endian(uint16_t* pOutput, const uint16_t* pInput,
 	uintptr_t uElements) BURGER_NOEXCEPT
 {
+#if defined(USE_VECTOR)
+	// Swap 16 bytes at a time if possible
+	const uintptr_t uDone =
+		SwapDispatch(pOutput, pInput, uElements << 1U, kSwap16) >> 1U;
+	pInput += uDone;
+	pOutput += uDone;
+	uElements -= uDone;
+#endif
 	// Any data to process?
 	if (uElements) {
 		do {
@@ -1733,6 +1909,13 @@ void BURGER_API Burger::swap_endian(uint16_t* pOutput, const uint16_t* pInput,
 void BURGER_API Burger::swap_endian(
 	uint32_t* pInput, uintptr_t uElements) BURGER_NOEXCEPT
 {
+#if defined(USE_VECTOR)
+	// Swap 16 bytes at a time if possible
+	const uintptr_t uDone =
+		SwapDispatch(pInput, pInput, uElements << 2U, kSwap32) >> 2U;
+	pInput += uDone;
+	uElements -= uDone;
+#endif
 	// Any data to process?
 	if (uElements) {
 		do {
@@ -1761,6 +1944,14 @@ void BURGER_API Burger::swap_endian(
 void BURGER_API Burger::swap_endian(uint32_t* pOutput, const uint32_t* pInput,
 	uintptr_t uElements) BURGER_NOEXCEPT
 {
+#if defined(USE_VECTOR)
+	// Swap 16 bytes at a time if possible
+	const uintptr_t uDone =
+		SwapDispatch(pOutput, pInput, uElements << 2U, kSwap32) >> 2U;
+	pInput += uDone;
+	pOutput += uDone;
+	uElements -= uDone;
+#endif
 	// Any data to process?
 	if (uElements) {
 		do {
@@ -1789,6 +1980,13 @@ void BURGER_API Burger::swap_endian(uint32_t* pOutput, const uint32_t* pInput,
 void BURGER_API Burger::swap_endian(
 	uint64_t* pInput, uintptr_t uElements) BURGER_NOEXCEPT
 {
+#if defined(USE_VECTOR)
+	// Swap 16 bytes at a time if possible
+	const uintptr_t uDone =
+		SwapDispatch(pInput, pInput, uElements << 3U, kSwap64) >> 3U;
+	pInput += uDone;
+	uElements -= uDone;
+#endif
 	// Any data to process?
 	if (uElements) {
 		do {
@@ -1817,6 +2015,14 @@ void BURGER_API Burger::swap_endian(
 void BURGER_API Burger::swap_endian(uint64_t* pOutput, const uint64_t* pInput,
 	uintptr_t uElements) BURGER_NOEXCEPT
 {
+#if defined(USE_VECTOR)
+	// Swap 16 bytes at a time if possible
+	const uintptr_t uDone =
+		SwapDispatch(pOutput, pInput, uElements << 3U, kSwap64) >> 3U;
+	pInput += uDone;
+	pOutput += uDone;
+	uElements -= uDone;
+#endif
 	// Any data to process?
 	if (uElements) {
 		do {
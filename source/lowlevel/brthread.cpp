@@ -25,6 +25,17 @@
 // Root point to linked list of thread local storage records
 static Burger::thread_local_storage_record_t* g_pThreadLocalStorageRecords;
 static Burger::Mutex g_TLSRecordsCriticalSection;
+
+// Used by tls_new_index() and tls_release_index()
+// The low bits of an index are the entry, the high bits count reuses of it
+static const uint32_t kTLSEntryMask = 0xFFFFFU;
+static const uint32_t kTLSReuseStep = kTLSEntryMask + 1U;
+
+// Indexes released for reuse, guarded by a spin lock since LogSink and the
+// like can be created during static construction
+static uint32_t g_TLSFreeIndexes[32];
+static uint32_t g_uTLSFreeCount;
+static volatile uint32_t g_uTLSFreeLock;
 #endif
 
 /*! ************************************
@@ -212,30 +223,90 @@ Burger::eError BURGER_API Burger::set_thread_priority(
 
 	\brief Create a unique index for Thread Local Storage
 
-	Atomically increment a counter and return the value. This value is used as
-	an index to obtain the thread local storage to the thread that possesses the
-	index.
+	Return an index used to obtain the thread local storage to the thread that
+	possesses the index. Indexes given back with tls_release_index(uint32_t)
+	are reused, otherwise a counter is atomically incremented.
 
-	\note Once assigned, a number cannot be released. As such, don't create and
-		destroy threads, just create the thread and put it to sleep until it's
-		needed again.
+	\note A reused index never has the same value as the one that was
+		released, so data left behind by the previous owner in other threads
+		is not returned by tls_get(uint32_t).
 
-	\returns An index starting with 1, and then increments on each call.
+	\returns An index starting with 1, never zero.
 
-	\sa tls_get(uint32_t)
+	\sa tls_release_index(uint32_t) or tls_get(uint32_t)
 
 ***************************************/
 
 uint32_t BURGER_API Burger::tls_new_index(void) BURGER_NOEXCEPT
 {
-	// Note: The value MUST be in the function, so if it's forked, it will
-	// generate a Thread Local Storage version and "reset" the count
+	// Try a previously released index first
+	uint32_t uResult = 0;
+	atomic_lock(&g_uTLSFreeLock);
+	if (g_uTLSFreeCount) {
+		--g_uTLSFreeCount;
+		uResult = g_TLSFreeIndexes[g_uTLSFreeCount];
+	}
+	atomic_unlock(&g_uTLSFreeLock);
+
+	if (!uResult) {
+		// Note: The value MUST be in the function, so if it's forked, it will
+		// generate a Thread Local Storage version and "reset" the count
 
-	// Starts with zero
-	static volatile uint32_t s_TLSIndex;
+		// Starts with zero
+		static volatile uint32_t s_TLSIndex;
 
-	// Return 1,2,3, etc...
-	return atomic_add(&s_TLSIndex, 1U) + 1U;
+		// Return 1,2,3, etc...
+		uResult = atomic_add(&s_TLSIndex, 1U) + 1U;
+	}
+	return uResult;
+}
+
+/*! ************************************
+
+	\brief Release an index for Thread Local Storage
+
+	Give back an index obtained from tls_new_index() so it can be reused.
+	The entry is cleared for the calling thread. Entries set by other threads
+	are left until those threads call tls_release() or the index is reused
+	by tls_set(uint32_t, const void*, TLS_shutdown_proc_t), at which point
+	their shutdown functions are called.
+
+	\note If too many indexes are waiting to be reused, the index is simply
+		discarded.
+
+	\param uIndex Index from tls_new_index(), zero is ignored
+
+	\sa tls_new_index() or tls_release()
+
+***************************************/
+
+void BURGER_API Burger::tls_release_index(uint32_t uIndex) BURGER_NOEXCEPT
+{
+	if (uIndex) {
+
+		// Forget this thread's entry, the caller has disposed of it
+		thread_local_storage_t* pTLS = tls_data_get();
+		const uint32_t uEntry = (uIndex - 1U) & kTLSEntryMask;
+		if (pTLS && (uEntry < pTLS->m_uCount)) {
+			thread_local_storage_entry_t* pWork = &pTLS->m_Entries[uEntry];
+			if (pWork->m_uIndex == uIndex) {
+				pWork->m_pThis = nullptr;
+				pWork->m_pShutdown = nullptr;
+				pWork->m_uIndex = 0;
+			}
+		}
+
+		// Give it a new value so stale entries won't match, unless it wrapped
+		const uint32_t uReused = uIndex + kTLSReuseStep;
+		if (uReused > kTLSEntryMask) {
+			atomic_lock(&g_uTLSFreeLock);
+			if (g_uTLSFreeCount < BURGER_ARRAYSIZE(g_TLSFreeIndexes)) {
+				g_TLSFreeIndexes[g_uTLSFreeCount] = uReused;
+				++g_uTLSFreeCount;
+			}
+			atomic_unlock(&g_uTLSFreeLock);
+		}
+	}
 }
 
 /*! ************************************
@@ -478,16 +549,21 @@ void* BURGER_API Burger::tls_get(uint32_t uIndex) BURGER_NOEXCEPT
 	if (uIndex) {
 
 		// Change 1 index to 0
-		--uIndex;
+		const uint32_t uEntry = (uIndex - 1U) & kTLSEntryMask;
 
 		// Get the data
 		const thread_local_storage_t* pTLS = tls_data_get();
 
 		// Valid pointer and not out of bounds?
-		if (pTLS && (uIndex < pTLS->m_uCount)) {
-
-			// Get the data pointer
-			pResult = pTLS->m_Entries[uIndex].m_pThis;
+		if (pTLS && (uEntry < pTLS->m_uCount)) {
+
+			// Ignore data left by a released index
+			const thread_local_storage_entry_t* pWork =
+				&pTLS->m_Entries[uEntry];
+			if (pWork->m_uIndex == uIndex) {
+				// Get the data pointer
+				pResult = pWork->m_pThis;
+			}
 		}
 	}
 	return pResult;
@@ -524,7 +600,7 @@ Burger::eError BURGER_API Burger::tls_set(uint32_t uIndex, const void* pThis,
 	if (uIndex) {
 
 		// Convert from 1 to 0 indexing
-		--uIndex;
+		const uint32_t uEntry = (uIndex - 1U) & kTLSEntryMask;
 
 		uResult = kErrorNone;
 
@@ -532,14 +608,14 @@ Burger::eError BURGER_API Burger::tls_set(uint32_t uIndex, const void* pThis,
 		thread_local_storage_t* pTLS = tls_data_get();
 
 		// Record found?
-		if (!pTLS || (uIndex >= pTLS->m_uCount)) {
+		if (!pTLS || (uEntry >= pTLS->m_uCount)) {
 
 			// Get the current count, but set to zero if there was no previous
 			// data
 			uint32_t uCurrentCount = pTLS ? pTLS->m_uCount : 0;
 
 			// Resize to this count, with a little padding
-			const uint32_t uNewCount = uIndex + 8U;
+			const uint32_t uNewCount = uEntry + 8U;
 
 			// Reallocate the buffer for the new entries
 			// The -1 is because thread_local_storage_t has a single record
@@ -562,6 +638,7 @@ Burger::eError BURGER_API Burger::tls_set(uint32_t uIndex, const void* pThis,
 				do {
 					pWork->m_pThis = nullptr;
 					pWork->m_pShutdown = nullptr;
+					pWork->m_uIndex = 0;
 					++pWork;
 				} while (--uCurrentCount);
 
@@ -572,9 +649,15 @@ Burger::eError BURGER_API Burger::tls_set(uint32_t uIndex, const void* pThis,
 
 		// Update the data in the record, if no error
 		if (!uResult) {
-			thread_local_storage_entry_t* pWork2 = &pTLS->m_Entries[uIndex];
+			thread_local_storage_entry_t* pWork2 = &pTLS->m_Entries[uEntry];
+
+			// Clean up after the previous owner of a released index
+			if ((pWork2->m_uIndex != uIndex) && pWork2->m_pShutdown) {
+				pWork2->m_pShutdown(pWork2->m_pThis);
+			}
 			pWork2->m_pThis = const_cast<void*>(pThis);
 			pWork2->m_pShutdown = pShutdown;
+			pWork2->m_uIndex = uIndex;
 		}
 	}
 
@@ -47,6 +47,8 @@ struct thread_local_storage_entry_t {
 	TLS_shutdown_proc_t m_pShutdown;
 	/** `this` pointer to pass as parameter for m_pShutdown */
 	void* m_pThis;
+	/** Index from tls_new_index() that set this entry */
+	uint32_t m_uIndex;
 };
 
 struct thread_local_storage_t {
@@ -72,6 +74,7 @@ extern eError BURGER_API set_thread_priority(
 	thread_ID_t uThreadID, eThreadPriority uThreadPriority) BURGER_NOEXCEPT;
 
 extern uint32_t BURGER_API tls_new_index(void) BURGER_NOEXCEPT;
+extern void BURGER_API tls_release_index(uint32_t uIndex) BURGER_NOEXCEPT;
 extern thread_local_storage_t* BURGER_API tls_data_get_fallback(
 	void) BURGER_NOEXCEPT;
 extern eError BURGER_API tls_data_set_fallback(
@@ -0,0 +1,2833 @@
+/***************************************
+
+	Floating point to decimal digit conversion class.
+
+	Copyright (c) 2020-2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#include "brfpdecimal.h"
+#include "brfpinfo.h"
+#include "brfplargeint.h"
+#include "brmemoryfunctions.h"
+#include "brnumberto.h"
+#include "brstructs.h"
+
+#if defined(BURGER_MSVC) && defined(BURGER_AMD64)
+#include <intrin.h>
+#endif
+
+/*! ************************************
+
+	\class Burger::FPDecimal
+	\brief Decimal digits of a floating point number
+
+	Convert a float or a double into the shortest string of decimal digits
+	that converts back into the exact same binary value, using the Ryu
+	algorithm by Ulf Adams. No large integer math is used, the conversion is a
+	pair of 64x128 bit multiplies with a table of powers of 5.
+
+	The digits can then be rounded to a number of significant digits, as done
+	by "%e" and "%g" in printf(), or to a power of 10, as done by "%f". If the
+	rounding can be performed on the shortest digits without changing the
+	result, it's done that way. Otherwise, such as when more digits are
+	requested than a double has, or the shortest digits end in a 5 that is
+	being rounded, the exact binary value is expanded with \ref FPLargeInt and
+	rounded to nearest even.
+
+	\code
+	FPDecimal Decimal;
+	Decimal.shortest(0.3);
+	// Decimal.get_digits() is "3", Decimal.get_exponent() is -1
+
+	Decimal.round_to_digits(20);
+	// Decimal.get_digits() is "29999999999999998889776975",
+	// Decimal.get_exponent() is -1
+	\endcode
+
+	\note Infinity and NaN are treated as zero, they must be handled by the
+		caller.
+
+	\sa FPPrintInfo or FPLargeInt
+
+***************************************/
+
+#if !defined(DOXYGEN)
+
+// Ryu tables, g_Pow5InverseTable[i] = (2^(pow5bits(i)+124) / 5^i) + 1 and
+// g_Pow5Table[i] = 5^i normalized to 125 bits. Each entry is low 64 bits,
+// then the high 64 bits.
+
+static const uint64_t g_Pow5InverseTable[291][2] = {
+	{0x0000000000000001ULL, 0x2000000000000000ULL},
+	{0x999999999999999AULL, 0x1999999999999999ULL},
+	{0x47AE147AE147AE15ULL, 0x147AE147AE147AE1ULL},
+	{0x6C8B4395810624DEULL, 0x10624DD2F1A9FBE7ULL},
+	{0x7A786C226809D496ULL, 0x1A36E2EB1C432CA5ULL},
+	{0x61F9F01B866E43ABULL, 0x14F8B588E368F084ULL},
+	{0xB4C7F34938583622ULL, 0x10C6F7A0B5ED8D36ULL},
+	{0x87A6520EC08D236AULL, 0x1AD7F29ABCAF4857ULL},
+	{0x9FB841A566D74F88ULL, 0x15798EE2308C39DFULL},
+	{0xE62D01511F12A607ULL, 0x112E0BE826D694B2ULL},
+	{0xD6AE6881CB5109A4ULL, 0x1B7CDFD9D7BDBAB7ULL},
+	{0xDEF1ED34A2A73AEAULL, 0x15FD7FE17964955FULL},
+	{0x7F27F0F6E885C8BBULL, 0x119799812DEA1119ULL},
+	{0x650CB4BE40D60DF8ULL, 0x1C25C268497681C2ULL},
+	{0xEA70909833DE7193ULL, 0x16849B86A12B9B01ULL},
+	{0x21F3A6E0297EC143ULL, 0x1203AF9EE756159BULL},
+	{0x6985D7CD0F313537ULL, 0x1CD2B297D889BC2BULL},
+	{0x2137DFD73F5A90F9ULL, 0x170EF54646D49689ULL},
+	{0xE75FE645CC4873FAULL, 0x12725DD1D243ABA0ULL},
+	{0xA5663D3C7A0D865DULL, 0x1D83C94FB6D2AC34ULL},
+	{0x511E976394D79EB1ULL, 0x179CA10C9242235DULL},
+	{0xDA7EDF82DD794BC1ULL, 0x12E3B40A0E9B4F7DULL},
+	{0x2A6498D1625BAC68ULL, 0x1E392010175EE596ULL},
+	{0xEEB6E0A781E2F053ULL, 0x182DB34012B25144ULL},
+	{0x58924D52CE4F26A9ULL, 0x1357C299A88EA76AULL},
+	{0x27507BB7B07EA441ULL, 0x1EF2D0F5DA7DD8AAULL},
+	{0x52A6C95FC0655034ULL, 0x18C240C4AECB13BBULL},
+	{0x0EEBD44C99EAA690ULL, 0x13CE9A36F23C0FC9ULL},
+	{0xB17953ADC3110A80ULL, 0x1FB0F6BE50601941ULL},
+	{0xC12DDC8B02740867ULL, 0x195A5EFEA6B34767ULL},
+	{0x3424B06F3529A052ULL, 0x14484BFEEBC29F86ULL},
+	{0x901D59F290EE19DBULL, 0x1039D66589687F9EULL},
+	{0x4CFBC31DB4B0295FULL, 0x19F623D5A8A73297ULL},
+	{0x3D9635B15D59BAB2ULL, 0x14C4E977BA1F5BACULL},
+	{0x97AB5E277DE16228ULL, 0x109D8792FB4C4956ULL},
+	{0xF2ABC9D8C9689D0DULL, 0x1A95A5B7F87A0EF0ULL},
+	{0x5BBCA17A3ABA173EULL, 0x154484932D2E725AULL},
+	{0xAFCA1AC82EFB45CBULL, 0x11039D428A8B8EAEULL},
+	{0xB2DCF7A6B1920945ULL, 0x1B38FB9DAA78E44AULL},
+	{0xF57D92EBC141A104ULL, 0x15C72FB1552D836EULL},
+	{0xC46475896767B403ULL, 0x116C262777579C58ULL},
+	{0x6D6D88DBD8A5ECD2ULL, 0x1BE03D0BF225C6F4ULL},
+	{0x8ABE071646EB23DBULL, 0x164CFDA3281E38C3ULL},
+	{0x6EFE6C11D255B649ULL, 0x11D7314F534B609CULL},
+	{0xB197134FB6EF8A0EULL, 0x1C8B821885456760ULL},
+	{0x27AC0F72F8BFA1A5ULL, 0x16D601AD376AB91AULL},
+	{0xB95672C260994E1EULL, 0x1244CE242C5560E1ULL},
+	{0xF5571E03CDC21695ULL, 0x1D3AE36D13BBCE35ULL},
+	{0x2AAC18030B01ABABULL, 0x17624F8A762FD82BULL},
+	{0xBBBCE0026F348956ULL, 0x12B50C6EC4F31355ULL},
+	{0x92C7CCD0B1EDA889ULL, 0x1DEE7A4AD4B81EEFULL},
+	{0xDBD30A408E57BA07ULL, 0x17F1FB6F10934BF2ULL},
+	{0x7CA8D50071DFC806ULL, 0x1327FC58DA0F6FF5ULL},
+	{0xFAA7BB33E9660CD6ULL, 0x1EA6608E29B24CBBULL},
+	{0x9552FC298784D711ULL, 0x18851A0B548EA3C9ULL},
+	{0xAAA8C9BAD2D0AC0EULL, 0x139DAE6F76D88307ULL},
+	{0xDDDADC5E1E1AACE3ULL, 0x1F62B0B257C0D1A5ULL},
+	{0x7E48B04B4B488A4FULL, 0x191BC08EAC9A4151ULL},
+	{0xCB6D59D5D5D3A1D9ULL, 0x141633A556E1CDDAULL},
+	{0x3C577B1177DC817BULL, 0x1011C2EAABE7D7E2ULL},
+	{0xC6F25E825960CF2AULL, 0x19B604AAACA62636ULL},
+	{0x6BF518684780A5BBULL, 0x14919D5556EB51C5ULL},
+	{0x232A79ED06008496ULL, 0x10747DDDDF22A7D1ULL},
+	{0xD1DD8FE1A3340756ULL, 0x1A53FC9631D10C81ULL},
+	{0xA7E4731AE8F66C45ULL, 0x150FFD44F4A73D34ULL},
+	{0x531D28E253F8569EULL, 0x10D9976A5D52975DULL},
+	{0xEB61DB03B98D5762ULL, 0x1AF5BF109550F22EULL},
+	{0xBC4E48CFC7A445E8ULL, 0x159165A6DDDA5B58ULL},
+	{0x6371D3D96C836B20ULL, 0x11411E1F17E1E2ADULL},
+	{0x9F1C8628AD9F11CDULL, 0x1B9B6364F3030448ULL},
+	{0xE5B06B53BE18DB0BULL, 0x1615E91D8F359D06ULL},
+	{0xEAF3890FCB4715A2ULL, 0x11AB20E472914A6BULL},
+	{0x44B8DB4C7871BC37ULL, 0x1C45016D841BAA46ULL},
+	{0x03C715D6C6C1635FULL, 0x169D9ABE03495505ULL},
+	{0x3638DE456BCDE919ULL, 0x1217AEFE69077737ULL},
+	{0x56C163A2461641C1ULL, 0x1CF2B1970E725858ULL},
+	{0xDF011C81D1AB67CEULL, 0x17288E1271F51379ULL},
+	{0x7F3416CE4155ECA5ULL, 0x1286D80EC190DC61ULL},
+	{0x6520247D3556476EULL, 0x1DA48CE468E7C702ULL},
+	{0xEA801D30F7783925ULL, 0x17B6D71D20B96C01ULL},
+	{0xBB99B0F3F92CFA84ULL, 0x12F8AC174D612334ULL},
+	{0x5F5C4E532847F739ULL, 0x1E5AACF215683854ULL},
+	{0x7F7D0B75B9D32C2EULL, 0x18488A5B44536043ULL},
+	{0x9930D5F7C7DC2358ULL, 0x136D3B7C36A919CFULL},
+	{0x8EB4898C72F9D226ULL, 0x1F152BF9F10E8FB2ULL},
+	{0x722A07A38F2E41B8ULL, 0x18DDBCC7F40BA628ULL},
+	{0xC1BB394FA5BE9AFAULL, 0x13E497065CD61E86ULL},
+	{0x9C5EC2190930F7F6ULL, 0x1FD424D6FAF030D7ULL},
+	{0x49E56814075A5FF8ULL, 0x197683DF2F268D79ULL},
+	{0x6E51201005E1E660ULL, 0x145ECFE5BF520AC7ULL},
+	{0xF1DA800CD181851AULL, 0x104BD984990E6F05ULL},
+	{0x4FC400148268D4F5ULL, 0x1A12F5A0F4E3E4D6ULL},
+	{0xD96999AA01ED772BULL, 0x14DBF7B3F71CB711ULL},
+	{0xADEE1488018AC5BCULL, 0x10AFF95CC5B09274ULL},
+	{0x497CEDA668DE092CULL, 0x1AB328946F80EA54ULL},
+	{0x3ACA57B853E4D424ULL, 0x155C2076BF9A5510ULL},
+	{0x623B7960431D7683ULL, 0x1116805EFFAEAA73ULL},
+	{0x9D2BF566D1C8BD9EULL, 0x1B5733CB32B110B8ULL},
+	{0x7DBCC452416D647FULL, 0x15DF5CA28EF40D60ULL},
+	{0xCAFD69DB678AB6CCULL, 0x117F7D4ED8C33DE6ULL},
+	{0xAB2F0FC572778ADFULL, 0x1BFF2EE48E052FD7ULL},
+	{0x88F273045B92D580ULL, 0x1665BF1D3E6A8CACULL},
+	{0xD3F528D049424466ULL, 0x11EAFF4A98553D56ULL},
+	{0xB988414D4203A0A3ULL, 0x1CAB3210F3BB9557ULL},
+	{0x6139CDD76802E6E9ULL, 0x16EF5B40C2FC7779ULL},
+	{0xE761717920025254ULL, 0x125915CD68C9F92DULL},
+	{0xA568B58E999D5086ULL, 0x1D5B561574765B7CULL},
+	{0x5120913EE14AA6D2ULL, 0x177C44DDF6C515FDULL},
+	{0xA74D40FF1AA21F0EULL, 0x12C9D0B1923744CAULL},
+	{0x0BAECE64F769CB4AULL, 0x1E0FB44F50586E11ULL},
+	{0x3C8BD850C5EE3C3BULL, 0x180C903F7379F1A7ULL},
+	{0xCA0979DA37F1C9C9ULL, 0x133D4032C2C7F485ULL},
+	{0xA9A8C2F6BFE942DBULL, 0x1EC866B79E0CBA6FULL},
+	{0x2153CF2BCCBA9BE3ULL, 0x18A0522C7E709526ULL},
+	{0x1AA9728970954982ULL, 0x13B374F06526DDB8ULL},
+	{0xF775840F1A88759DULL, 0x1F8587E7083E2F8CULL},
+	{0x5F9136727BA05E17ULL, 0x19379FEC0698260AULL},
+	{0x1940F85B9619E4DFULL, 0x142C7FF0054684D5ULL},
+	{0xE100C6AFAB47EA4CULL, 0x1023998CD1053710ULL},
+	{0xCE67A44C453FDD47ULL, 0x19D28F47B4D524E7ULL},
+	{0xD852E9D69DCCB106ULL, 0x14A8729FC3DDB71FULL},
+	{0x79DBEE454B0A2738ULL, 0x1086C219697E2C19ULL},
+	{0x295FE3A211A9D859ULL, 0x1A71368F0F30468FULL},
+	{0xBAB31C81A7BB137AULL, 0x15275ED8D8F36BA5ULL},
+	{0x6228E39AEC95A92FULL, 0x10EC4BE0AD8F8951ULL},
+	{0x9D0E38F7E0EF7517ULL, 0x1B13AC9AAF4C0EE8ULL},
+	{0xB0D82D931A592A79ULL, 0x15A956E225D67253ULL},
+	{0x8D79BE0F4847552EULL, 0x11544581B7DEC1DCULL},
+	{0x158F967EDA0BBB7CULL, 0x1BBA08CF8C979C94ULL},
+	{0x77A611FF14D62F97ULL, 0x162E6D72D6DFB076ULL},
+	{0xF951A7FF43DE8C79ULL, 0x11BEBDF578B2F391ULL},
+	{0xC21C3FFED2FDAD8EULL, 0x1C6463225AB7EC1CULL},
+	{0x01B0333242648AD8ULL, 0x16B6B5B5155FF017ULL},
+	{0x0159C28E9B83A246ULL, 0x122BC490DDE659ACULL},
+	{0xCEF604175F3903A3ULL, 0x1D12D41AFCA3C2ACULL},
+	{0x725E69AC4C2D9C83ULL, 0x17424348CA1C9BBDULL},
+	{0xF5185489D68AE39CULL, 0x129B69070816E2FDULL},
+	{0xEE8D540FBDAB05C6ULL, 0x1DC574D80CF16B2FULL},
+	{0xBED77672FE226B05ULL, 0x17D12A4670C1228CULL},
+	{0xFF12C528CB4EBC04ULL, 0x130DBB6B8D674ED6ULL},
+	{0xCB513B74787DF9A0ULL, 0x1E7C5F127BD87E24ULL},
+	{0x090DC929F9FE614DULL, 0x18637F41FCAD31B7ULL},
+	{0xA0D7D42194CB810AULL, 0x1382CC34CA2427C5ULL},
+	{0x67BFB9CF5478CE77ULL, 0x1F37AD21436D0C6FULL},
+	{0x1FCC94A5DD2D71F9ULL, 0x18F9574DCF8A7059ULL},
+	{0x7FD6DD517DBDF4C7ULL, 0x13FAAC3E3FA1F37AULL},
+	{0xFFBE2EE8C92FEE0BULL, 0x1FF779FD329CB8C3ULL},
+	{0x6631BF20A0F324D6ULL, 0x1992C7FDC216FA36ULL},
+	{0xB827CC1A1A5C1D78ULL, 0x14756CCB01ABFB5EULL},
+	{0x935309AE7B7CE460ULL, 0x105DF0A267BCC918ULL},
+	{0x1EEB42B0C594A099ULL, 0x1A2FE76A3F9474F4ULL},
+	{0xE58902270476E6E1ULL, 0x14F31F8832DD2A5CULL},
+	{0xB7A0CE859D2BEBE7ULL, 0x10C27FA028B0EEB0ULL},
+	{0x59014A6F61DFDFD8ULL, 0x1AD0CC33744E4AB4ULL},
+	{0xE0CDD525E7E64CADULL, 0x1573D68F903EA229ULL},
+	{0x4D7177518651D6F1ULL, 0x11297872D9CBB4EEULL},
+	{0x7BE8BEE8D6E957E8ULL, 0x1B758D848FAC54B0ULL},
+	{0xFCBA3253DF211320ULL, 0x15F7A46A0C89DD59ULL},
+	{0x63C8284318E74280ULL, 0x1192E9EE706E4AAEULL},
+	{0x060D0D3827D86A66ULL, 0x1C1E43171A4A1117ULL},
+	{0x6B3DA42CECAD21EBULL, 0x167E9C127B6E7412ULL},
+	{0x88FE1CF0BD574E56ULL, 0x11FEE341FC585CDBULL},
+	{0x419694B462254A23ULL, 0x1CCB0536608D615FULL},
+	{0x67ABAA29E81DD4E9ULL, 0x1708D0F84D3DE77FULL},
+	{0xB95621BB2017DD87ULL, 0x126D73F9D764B932ULL},
+	{0xC223692B668C95A5ULL, 0x1D7BECC2F23AC1EAULL},
+	{0xCE82BA891ED6DE1DULL, 0x179657025B6234BBULL},
+	{0xA53562074BDF1818ULL, 0x12DEAC01E2B4F6FCULL},
+	{0x3B889CD87964F359ULL, 0x1E3113363787F194ULL},
+	{0xFC6D4A46C783F5E1ULL, 0x18274291C6065ADCULL},
+	{0x30576E9F06032B1AULL, 0x13529BA7D19EAF17ULL},
+	{0x1A257DCB3CD1DE90ULL, 0x1EEA92A61C311825ULL},
+	{0x481DFE3C30A7E540ULL, 0x18BBA884E35A79B7ULL},
+	{0xD34B31C9C0865100ULL, 0x13C9539D82AEC7C5ULL},
+	{0x5211E942CDA3B4CDULL, 0x1FA885C8D117A609ULL},
+	{0x74DB21023E1C90A4ULL, 0x19539E3A40DFB807ULL},
+	{0xF715B401CB4A0D50ULL, 0x1442E4FB67196005ULL},
+	{0xF8DE299B09080AA7ULL, 0x103583FC527AB337ULL},
+	{0x8E304291A80CDDD7ULL, 0x19EF3993B72AB859ULL},
+	{0x3E8D020E200A4B13ULL, 0x14BF6142F8EEF9E1ULL},
+	{0x653D9B3E80083C0FULL, 0x10991A9BFA58C7E7ULL},
+	{0x6EC8F864000D2CE4ULL, 0x1A8E90F9908E0CA5ULL},
+	{0x8BD3F9E999A423EAULL, 0x153EDA614071A3B7ULL},
+	{0x3CA994BAE1501CBBULL, 0x10FF151A99F482F9ULL},
+	{0xC775BAC49BB3612BULL, 0x1B31BB5DC320D18EULL},
+	{0xD2C4956A16291A89ULL, 0x15C162B168E70E0BULL},
+	{0xDBD0778811BA7BA1ULL, 0x11678227871F3E6FULL},
+	{0x2C80BF401C5D929BULL, 0x1BD8D03F3E9863E6ULL},
+	{0xBD33CC3349E47549ULL, 0x16470CFF6546B651ULL},
+	{0xCA8FD68F6E505DD4ULL, 0x11D270CC51055EA7ULL},
+	{0x4419574BE3B3C953ULL, 0x1C83E7AD4E6EFDD9ULL},
+	{0x0347790982F63AA9ULL, 0x16CFEC8AA52597E1ULL},
+	{0xCF6C60D468C4FBBAULL, 0x123FF06EEA847980ULL},
+	{0xE57A34870E07F92AULL, 0x1D331A4B10D3F59AULL},
+	{0x512E906C0B399422ULL, 0x175C1508DA432AE2ULL},
+	{0xDA8BA6BCD5C7A9B5ULL, 0x12B010D3E1CF5581ULL},
+	{0x90DF712E22D90F87ULL, 0x1DE6815302E5559CULL},
+	{0xDA4C5A8B4F140C6CULL, 0x17EB9AA8CF1DDE16ULL},
+	{0xAEA37BA2A5A9A38AULL, 0x1322E220A5B17E78ULL},
+	{0x7DD25F6AA2A905A9ULL, 0x1E9E369AA2B59727ULL},
+	{0x97DB7F888220D154ULL, 0x187E92154EF7AC1FULL},
+	{0x797C6606CE80A777ULL, 0x139874DDD8C6234CULL},
+	{0x8F2D700AE4010BF1ULL, 0x1F5A549627A36BADULL},
+	{0x0C2459A25000D65AULL, 0x191510781FB5EFBEULL},
+	{0x701D1481D99A4515ULL, 0x1410D9F9B2F7F2FEULL},
+	{0xC017439B147B6A77ULL, 0x100D7B2E28C65BFEULL},
+	{0xCCF205C4ED9243F2ULL, 0x19AF2B7D0E0A2CCAULL},
+	{0x0A5B37D0BE0E9CC2ULL, 0x148C22CA71A1BD6FULL},
+	{0x0848F973CB3EE3CEULL, 0x10701BD527B4978CULL},
+	{0xDA0E5BEC78649FB0ULL, 0x1A4CF9550C5425ACULL},
+	{0x7B3EAFF060507FC0ULL, 0x150A6110D6A9B7BDULL},
+	{0x95CBBFF380406633ULL, 0x10D51A73DEEE2C97ULL},
+	{0xEFAC665266CD7052ULL, 0x1AEE90B964B04758ULL},
+	{0x2623850EB8A459DBULL, 0x158BA6FAB6F36C47ULL},
+	{0x1E82D0D893B6AE49ULL, 0x113C85955F29236CULL},
+	{0xFD9E1AF41F8AB075ULL, 0x1B9408EEFEA838ACULL},
+	{0x97B1AF29B2D559F7ULL, 0x16100725988693BDULL},
+	{0xAC8E25BAF5777B2CULL, 0x11A66C1E139EDC97ULL},
+	{0x7A7D092B2258C513ULL, 0x1C3D79C9B8FE2DBFULL},
+	{0x61FDA0EF4EAD6A76ULL, 0x169794A160CB57CCULL},
+	{0xE7FE1A590BBDEEC5ULL, 0x1212DD4DE7091309ULL},
+	{0xA6635D5B45FCB13AULL, 0x1CEAFBAFD80E84DCULL},
+	{0x851C4AAF6B308DC8ULL, 0x172262F3133ED0B0ULL},
+	{0xD0E36EF2BC26D7D4ULL, 0x1281E8C275CBDA26ULL},
+	{0xB49F17EAC6A48C86ULL, 0x1D9CA79D894629D7ULL},
+	{0x2A18DFEF0550706BULL, 0x17B08617A104EE46ULL},
+	{0x54E0B3259DD9F389ULL, 0x12F39E794D9D8B6BULL},
+	{0x87CDEB6F62F65274ULL, 0x1E5297287C2F4578ULL},
+	{0xD30B22BF825EA85DULL, 0x18421286C9BF6AC6ULL},
+	{0x0F3C1BCC684BB9E4ULL, 0x13680ED23AFF889FULL},
+	{0x18602C7A4079296DULL, 0x1F0CE4839198DA98ULL},
+	{0x46B356C833942124ULL, 0x18D71D360E13E213ULL},
+	{0x388F78A029434DB6ULL, 0x13DF4A91A4DCB4DCULL},
+	{0x5A7F2766A86BAF8AULL, 0x1FCBAA82A1612160ULL},
+	{0x153285EBB9EFBFA2ULL, 0x196FBB9BB44DB44DULL},
+	{0xAA8ED189618C994EULL, 0x145962E2F6A4903DULL},
+	{0xEED8A7A11AD6E10CULL, 0x1047824F2BB6D9CAULL},
+	{0x7E27729B5E249B45ULL, 0x1A0C03B1DF8AF611ULL},
+	{0xFE85F549181D4904ULL, 0x14D6695B193BF80DULL},
+	{0xCB9E5DD4134AA0D0ULL, 0x10AB877C142FF9A4ULL},
+	{0xDF63C9535211014DULL, 0x1AAC0BF9B9E65C3AULL},
+	{0x191CA10F74DA6771ULL, 0x15566FFAFB1EB02FULL},
+	{0xADB080D92A4852C1ULL, 0x1111F32F2F4BC025ULL},
+	{0x15E7348EAA0D5134ULL, 0x1B4FEB7EB212CD09ULL},
+	{0xAB1F5D3EEE710DC4ULL, 0x15D98932280F0A6DULL},
+	{0xBC1917658B8DA49DULL, 0x117AD428200C0857ULL},
+	{0x2CF4F23C127C3A94ULL, 0x1BF7B9D9CCE00D59ULL},
+	{0xF0C3F4FCDB969543ULL, 0x165FC7E170B33DE0ULL},
+	{0x5A365D9716121103ULL, 0x11E6398126F5CB1AULL},
+	{0x9056FC24F01CE804ULL, 0x1CA38F350B22DE90ULL},
+	{0xD9DF301D8CE3ECD0ULL, 0x16E93F5DA2824BA6ULL},
+	{0xE17F59B13D8323DAULL, 0x125432B14ECEA2EBULL},
+	{0x68CBC2B52F38395CULL, 0x1D53844EE47DD179ULL},
+	{0x53D6355DBF602DE3ULL, 0x177603725064A794ULL},
+	{0xA9782AB165E68B1CULL, 0x12C4CF8EA6B6EC76ULL},
+	{0x0F26AAB56FD744FAULL, 0x1E07B27DD78B13F1ULL},
+	{0x3F52222ABFDF6A62ULL, 0x18062864AC6F4327ULL},
+	{0x65DB4E88997F884EULL, 0x1338205089F29C1FULL},
+	{0x6FC54A7428CC0D4AULL, 0x1EC033B40FEA9365ULL},
+	{0x596AA1F68709A43BULL, 0x1899C2F673220F84ULL},
+	{0xADEEE7F86C07B696ULL, 0x13AE3591F5B4D936ULL},
+	{0x497E3FF3E00C5756ULL, 0x1F7D228322BAF524ULL},
+	{0xD464FFF64CD6AC45ULL, 0x1930E868E89590E9ULL},
+	{0x4383FFF83D7889D1ULL, 0x14272053ED4473EEULL},
+	{0xCF9CCCC69793A174ULL, 0x101F4D0FF1038FF1ULL},
+	{0x7F6147A425B90252ULL, 0x19CBAE7FE805B31CULL},
+	{0xCC4DD2E9B7C7350FULL, 0x14A2F1FFECD15C16ULL},
+	{0x3D0B0F215FD290D9ULL, 0x10825B3323DAB012ULL},
+	{0x61AB4B689950E7C1ULL, 0x1A6A2B85062AB350ULL},
+	{0x4E22A2BA1440B967ULL, 0x1521BC6A6B555C40ULL},
+	{0x0B4EE894DD009453ULL, 0x10E7C9EEBC4449CDULL},
+	{0x1217DA87C800ED51ULL, 0x1B0C764AC6D3A948ULL},
+	{0xDB46486CA000BDDAULL, 0x15A391D56BDC876CULL},
+	{0x490506BD4CCD64AFULL, 0x114FA7DDEFE39F8AULL},
+	{0xA8080AC87AE23AB1ULL, 0x1BB2A62FE638FF43ULL},
+	{0x5339A239FBE82EF4ULL, 0x162884F31E93FF69ULL},
+	{0x75C7B4FB2FECF25DULL, 0x11BA03F5B20FFF87ULL},
+	{0x22D92191E647EA2EULL, 0x1C5CD322B67FFF3FULL},
+	{0xB57A8141850654F2ULL, 0x16B0A8E891FFFF65ULL},
+	{0xC4620101373843F5ULL, 0x1226ED86DB3332B7ULL},
+	{0x3A366801F1F39FEEULL, 0x1D0B15A491EB8459ULL},
+	{0xFB5EB99B27F6198BULL, 0x173C115074BC69E0ULL},
+	{0x2F7EFAE2865E7AD6ULL, 0x129674405D6387E7ULL},
+	{0xE597F7D0D6FD9156ULL, 0x1DBD86CD6238D971ULL},
+	{0x8479930D78CADAABULL, 0x17CAD23DE82D7AC1ULL},
+	{0xD06142712D6F1556ULL, 0x1308A831868AC89AULL},
+	{0x4D686A4EAF182222ULL, 0x1E74404F3DAADA91ULL},
+	{0xA453883EF279B4E8ULL, 0x185D003F6488AEDAULL},
+	{0xE9DC6CFF28615D87ULL, 0x137D99CC506D58AEULL},
+	{0xA960AE650D6895A4ULL, 0x1F2F5C7A1A488DE4ULL},
+	{0xBAB3BEB73DED4483ULL, 0x18F2B061AEA07183ULL},
+};
+static const uint64_t g_Pow5Table[326][2] = {
+	{0x0000000000000000ULL, 0x1000000000000000ULL},
+	{0x0000000000000000ULL, 0x1400000000000000ULL},
+	{0x0000000000000000ULL, 0x1900000000000000ULL},
+	{0x0000000000000000ULL, 0x1F40000000000000ULL},
+	{0x0000000000000000ULL, 0x1388000000000000ULL},
+	{0x0000000000000000ULL, 0x186A000000000000ULL},
+	{0x0000000000000000ULL, 0x1E84800000000000ULL},
+	{0x0000000000000000ULL, 0x1312D00000000000ULL},
+	{0x0000000000000000ULL, 0x17D7840000000000ULL},
+	{0x0000000000000000ULL, 0x1DCD650000000000ULL},
+	{0x0000000000000000ULL, 0x12A05F2000000000ULL},
+	{0x0000000000000000ULL, 0x174876E800000000ULL},
+	{0x0000000000000000ULL, 0x1D1A94A200000000ULL},
+	{0x0000000000000000ULL, 0x12309CE540000000ULL},
+	{0x0000000000000000ULL, 0x16BCC41E90000000ULL},
+	{0x0000000000000000ULL, 0x1C6BF52634000000ULL},
+	{0x0000000000000000ULL, 0x11C37937E0800000ULL},
+	{0x0000000000000000ULL, 0x16345785D8A00000ULL},
+	{0x0000000000000000ULL, 0x1BC16D674EC80000ULL},
+	{0x0000000000000000ULL, 0x1158E460913D0000ULL},
+	{0x0000000000000000ULL, 0x15AF1D78B58C4000ULL},
+	{0x0000000000000000ULL, 0x1B1AE4D6E2EF5000ULL},
+	{0x0000000000000000ULL, 0x10F0CF064DD59200ULL},
+	{0x0000000000000000ULL, 0x152D02C7E14AF680ULL},
+	{0x0000000000000000ULL, 0x1A784379D99DB420ULL},
+	{0x0000000000000000ULL, 0x108B2A2C28029094ULL},
+	{0x0000000000000000ULL, 0x14ADF4B7320334B9ULL},
+	{0x4000000000000000ULL, 0x19D971E4FE8401E7ULL},
+	{0x8800000000000000ULL, 0x1027E72F1F128130ULL},
+	{0xAA00000000000000ULL, 0x1431E0FAE6D7217CULL},
+	{0xD480000000000000ULL, 0x193E5939A08CE9DBULL},
+	{0xC9A0000000000000ULL, 0x1F8DEF8808B02452ULL},
+	{0xBE04000000000000ULL, 0x13B8B5B5056E16B3ULL},
+	{0xAD85000000000000ULL, 0x18A6E32246C99C60ULL},
+	{0xD8E6400000000000ULL, 0x1ED09BEAD87C0378ULL},
+	{0x878FE80000000000ULL, 0x13426172C74D822BULL},
+	{0x6973E20000000000ULL, 0x1812F9CF7920E2B6ULL},
+	{0x03D0DA8000000000ULL, 0x1E17B84357691B64ULL},
+	{0x8262889000000000ULL, 0x12CED32A16A1B11EULL},
+	{0x22FB2AB400000000ULL, 0x178287F49C4A1D66ULL},
+	{0xABB9F56100000000ULL, 0x1D6329F1C35CA4BFULL},
+	{0xCB54395CA0000000ULL, 0x125DFA371A19E6F7ULL},
+	{0xBE2947B3C8000000ULL, 0x16F578C4E0A060B5ULL},
+	{0x2DB399A0BA000000ULL, 0x1CB2D6F618C878E3ULL},
+	{0xFC90400474400000ULL, 0x11EFC659CF7D4B8DULL},
+	{0x7BB4500591500000ULL, 0x166BB7F0435C9E71ULL},
+	{0xDAA16406F5A40000ULL, 0x1C06A5EC5433C60DULL},
+	{0xA8A4DE8459868000ULL, 0x118427B3B4A05BC8ULL},
+	{0xD2CE16256FE82000ULL, 0x15E531A0A1C872BAULL},
+	{0x87819BAECBE22800ULL, 0x1B5E7E08CA3A8F69ULL},
+	{0xF4B1014D3F6D5900ULL, 0x111B0EC57E6499A1ULL},
+	{0x71DD41A08F48AF40ULL, 0x1561D276DDFDC00AULL},
+	{0x0E549208B31ADB10ULL, 0x1ABA4714957D300DULL},
+	{0x28F4DB456FF0C8EAULL, 0x10B46C6CDD6E3E08ULL},
+	{0x33321216CBECFB24ULL, 0x14E1878814C9CD8AULL},
+	{0xBFFE969C7EE839EDULL, 0x1A19E96A19FC40ECULL},
+	{0xF7FF1E21CF512434ULL, 0x105031E2503DA893ULL},
+	{0xF5FEE5AA43256D41ULL, 0x14643E5AE44D12B8ULL},
+	{0x337E9F14D3EEC892ULL, 0x197D4DF19D605767ULL},
+	{0x005E46DA08EA7AB6ULL, 0x1FDCA16E04B86D41ULL},
+	{0xA03AEC4845928CB2ULL, 0x13E9E4E4C2F34448ULL},
+	{0xC849A75A56F72FDEULL, 0x18E45E1DF3B0155AULL},
+	{0x7A5C1130ECB4FBD6ULL, 0x1F1D75A5709C1AB1ULL},
+	{0xEC798ABE93F11D65ULL, 0x13726987666190AEULL},
+	{0xA797ED6E38ED64BFULL, 0x184F03E93FF9F4DAULL},
+	{0x517DE8C9C728BDEFULL, 0x1E62C4E38FF87211ULL},
+	{0xD2EEB17E1C7976B5ULL, 0x12FDBB0E39FB474AULL},
+	{0x87AA5DDDA397D462ULL, 0x17BD29D1C87A191DULL},
+	{0xE994F5550C7DC97BULL, 0x1DAC74463A989F64ULL},
+	{0x11FD195527CE9DEDULL, 0x128BC8ABE49F639FULL},
+	{0xD67C5FAA71C24568ULL, 0x172EBAD6DDC73C86ULL},
+	{0x8C1B77950E32D6C2ULL, 0x1CFA698C95390BA8ULL},
+	{0x57912ABD28DFC639ULL, 0x121C81F7DD43A749ULL},
+	{0xAD75756C7317B7C8ULL, 0x16A3A275D494911BULL},
+	{0x98D2D2C78FDDA5BAULL, 0x1C4C8B1349B9B562ULL},
+	{0x9F83C3BCB9EA8794ULL, 0x11AFD6EC0E14115DULL},
+	{0x0764B4ABE8652979ULL, 0x161BCCA7119915B5ULL},
+	{0x493DE1D6E27E73D7ULL, 0x1BA2BFD0D5FF5B22ULL},
+	{0x6DC6AD264D8F0866ULL, 0x1145B7E285BF98F5ULL},
+	{0xC938586FE0F2CA80ULL, 0x159725DB272F7F32ULL},
+	{0x7B866E8BD92F7D20ULL, 0x1AFCEF51F0FB5EFFULL},
+	{0xAD34051767BDAE34ULL, 0x10DE1593369D1B5FULL},
+	{0x9881065D41AD19C1ULL, 0x15159AF804446237ULL},
+	{0x7EA147F492186032ULL, 0x1A5B01B605557AC5ULL},
+	{0x6F24CCF8DB4F3C1FULL, 0x1078E111C3556CBBULL},
+	{0x4AEE003712230B27ULL, 0x14971956342AC7EAULL},
+	{0xDDA98044D6ABCDF0ULL, 0x19BCDFABC13579E4ULL},
+	{0x0A89F02B062B60B6ULL, 0x10160BCB58C16C2FULL},
+	{0xCD2C6C35C7B638E4ULL, 0x141B8EBE2EF1C73AULL},
+	{0x8077874339A3C71DULL, 0x1922726DBAAE3909ULL},
+	{0xE0956914080CB8E4ULL, 0x1F6B0F092959C74BULL},
+	{0x6C5D61AC8507F38EULL, 0x13A2E965B9D81C8FULL},
+	{0x4774BA17A649F072ULL, 0x188BA3BF284E23B3ULL},
+	{0x1951E89D8FDC6C8FULL, 0x1EAE8CAEF261ACA0ULL},
+	{0x0FD3316279E9C3D9ULL, 0x132D17ED577D0BE4ULL},
+	{0x13C7FDBB186434CFULL, 0x17F85DE8AD5C4EDDULL},
+	{0x58B9FD29DE7D4203ULL, 0x1DF67562D8B36294ULL},
+	{0xB7743E3A2B0E4942ULL, 0x12BA095DC7701D9CULL},
+	{0xE5514DC8B5D1DB92ULL, 0x17688BB5394C2503ULL},
+	{0xDEA5A13AE3465277ULL, 0x1D42AEA2879F2E44ULL},
+	{0x0B2784C4CE0BF38AULL, 0x1249AD2594C37CEBULL},
+	{0xCDF165F6018EF06DULL, 0x16DC186EF9F45C25ULL},
+	{0x416DBF7381F2AC88ULL, 0x1C931E8AB871732FULL},
+	{0x88E497A83137ABD5ULL, 0x11DBF316B346E7FDULL},
+	{0xEB1DBD923D8596CAULL, 0x1652EFDC6018A1FCULL},
+	{0x25E52CF6CCE6FC7DULL, 0x1BE7ABD3781ECA7CULL},
+	{0x97AF3C1A40105DCEULL, 0x1170CB642B133E8DULL},
+	{0xFD9B0B20D0147542ULL, 0x15CCFE3D35D80E30ULL},
+	{0x3D01CDE904199292ULL, 0x1B403DCC834E11BDULL},
+	{0x462120B1A28FFB9BULL, 0x1108269FD210CB16ULL},
+	{0xD7A968DE0B33FA82ULL, 0x154A3047C694FDDBULL},
+	{0xCD93C3158E00F923ULL, 0x1A9CBC59B83A3D52ULL},
+	{0xC07C59ED78C09BB6ULL, 0x10A1F5B813246653ULL},
+	{0xB09B7068D6F0C2A3ULL, 0x14CA732617ED7FE8ULL},
+	{0xDCC24C830CACF34CULL, 0x19FD0FEF9DE8DFE2ULL},
+	{0xC9F96FD1E7EC180FULL, 0x103E29F5C2B18BEDULL},
+	{0x3C77CBC661E71E13ULL, 0x144DB473335DEEE9ULL},
+	{0x8B95BEB7FA60E598ULL, 0x1961219000356AA3ULL},
+	{0x6E7B2E65F8F91EFEULL, 0x1FB969F40042C54CULL},
+	{0xC50CFCFFBB9BB35FULL, 0x13D3E2388029BB4FULL},
+	{0xB6503C3FAA82A037ULL, 0x18C8DAC6A0342A23ULL},
+	{0xA3E44B4F95234844ULL, 0x1EFB1178484134ACULL},
+	{0xE66EAF11BD360D2BULL, 0x135CEAEB2D28C0EBULL},
+	{0xE00A5AD62C839075ULL, 0x183425A5F872F126ULL},
+	{0x980CF18BB7A47493ULL, 0x1E412F0F768FAD70ULL},
+	{0x5F0816F752C6C8DCULL, 0x12E8BD69AA19CC66ULL},
+	{0xF6CA1CB527787B13ULL, 0x17A2ECC414A03F7FULL},
+	{0xF47CA3E2715699D7ULL, 0x1D8BA7F519C84F5FULL},
+	{0xF8CDE66D86D62026ULL, 0x127748F9301D319BULL},
+	{0xF7016008E88BA830ULL, 0x17151B377C247E02ULL},
+	{0xB4C1B80B22AE923CULL, 0x1CDA62055B2D9D83ULL},
+	{0x50F91306F5AD1B65ULL, 0x12087D4358FC8272ULL},
+	{0xE53757C8B318623FULL, 0x168A9C942F3BA30EULL},
+	{0x9E852DBADFDE7ACFULL, 0x1C2D43B93B0A8BD2ULL},
+	{0xA3133C94CBEB0CC1ULL, 0x119C4A53C4E69763ULL},
+	{0x8BD80BB9FEE5CFF1ULL, 0x16035CE8B6203D3CULL},
+	{0xAECE0EA87E9F43EEULL, 0x1B843422E3A84C8BULL},
+	{0x4D40C9294F238A75ULL, 0x1132A095CE492FD7ULL},
+	{0x2090FB73A2EC6D12ULL, 0x157F48BB41DB7BCDULL},
+	{0x68B53A508BA78856ULL, 0x1ADF1AEA12525AC0ULL},
+	{0x417144725748B536ULL, 0x10CB70D24B7378B8ULL},
+	{0x51CD958EED1AE283ULL, 0x14FE4D06DE5056E6ULL},
+	{0xE640FAF2A8619B24ULL, 0x1A3DE04895E46C9FULL},
+	{0xEFE89CD7A93D00F7ULL, 0x1066AC2D5DAEC3E3ULL},
+	{0xEBE2C40D938C4134ULL, 0x14805738B51A74DCULL},
+	{0x26DB7510F86F5181ULL, 0x19A06D06E2611214ULL},
+	{0x9849292A9B4592F1ULL, 0x100444244D7CAB4CULL},
+	{0xBE5B73754216F7ADULL, 0x1405552D60DBD61FULL},
+	{0xADF25052929CB598ULL, 0x1906AA78B912CBA7ULL},
+	{0x996EE4673743E2FFULL, 0x1F485516E7577E91ULL},
+	{0xFFE54EC0828A6DDFULL, 0x138D352E5096AF1AULL},
+	{0xBFDEA270A32D0957ULL, 0x18708279E4BC5AE1ULL},
+	{0x2FD64B0CCBF84BADULL, 0x1E8CA3185DEB719AULL},
+	{0x5DE5EEE7FF7B2F4CULL, 0x1317E5EF3AB32700ULL},
+	{0x755F6AA1FF59FB1FULL, 0x17DDDF6B095FF0C0ULL},
+	{0x92B7454A7F3079E7ULL, 0x1DD55745CBB7ECF0ULL},
+	{0x5BB28B4E8F7E4C30ULL, 0x12A5568B9F52F416ULL},
+	{0xF29F2E22335DDF3CULL, 0x174EAC2E8727B11BULL},
+	{0xEF46F9AAC035570BULL, 0x1D22573A28F19D62ULL},
+	{0xD58C5C0AB8215667ULL, 0x123576845997025DULL},
+	{0x4AEF730D6629AC01ULL, 0x16C2D4256FFCC2F5ULL},
+	{0x9DAB4FD0BFB41701ULL, 0x1C73892ECBFBF3B2ULL},
+	{0xA28B11E277D08E60ULL, 0x11C835BD3F7D784FULL},
+	{0x8B2DD65B15C4B1F9ULL, 0x163A432C8F5CD663ULL},
+	{0x6DF94BF1DB35DE77ULL, 0x1BC8D3F7B3340BFCULL},
+	{0xC4BBCF772901AB0AULL, 0x115D847AD000877DULL},
+	{0x35EAC354F34215CDULL, 0x15B4E5998400A95DULL},
+	{0x8365742A30129B40ULL, 0x1B221EFFE500D3B4ULL},
+	{0xD21F689A5E0BA108ULL, 0x10F5535FEF208450ULL},
+	{0x06A742C0F58E894AULL, 0x1532A837EAE8A565ULL},
+	{0x4851137132F22B9DULL, 0x1A7F5245E5A2CEBEULL},
+	{0xED32AC26BFD75B42ULL, 0x108F936BAF85C136ULL},
+	{0xA87F57306FCD3212ULL, 0x14B378469B673184ULL},
+	{0xD29F2CFC8BC07E97ULL, 0x19E056584240FDE5ULL},
+	{0xA3A37C1DD7584F1EULL, 0x102C35F729689EAFULL},
+	{0x8C8C5B254D2E62E6ULL, 0x14374374F3C2C65BULL},
+	{0x6FAF71EEA079FB9FULL, 0x1945145230B377F2ULL},
+	{0x0B9B4E6A48987A87ULL, 0x1F965966BCE055EFULL},
+	{0x674111026D5F4C94ULL, 0x13BDF7E0360C35B5ULL},
+	{0xC111554308B71FBAULL, 0x18AD75D8438F4322ULL},
+	{0x7155AA93CAE4E7A8ULL, 0x1ED8D34E547313EBULL},
+	{0x26D58A9C5ECF10C9ULL, 0x13478410F4C7EC73ULL},
+	{0xF08AED437682D4FBULL, 0x1819651531F9E78FULL},
+	{0xECADA89454238A3AULL, 0x1E1FBE5A7E786173ULL},
+	{0x73EC895CB4963664ULL, 0x12D3D6F88F0B3CE8ULL},
+	{0x90E7ABB3E1BBC3FDULL, 0x1788CCB6B2CE0C22ULL},
+	{0x352196A0DA2AB4FDULL, 0x1D6AFFE45F818F2BULL},
+	{0x0134FE24885AB11EULL, 0x1262DFEEBBB0F97BULL},
+	{0xC1823DADAA715D65ULL, 0x16FB97EA6A9D37D9ULL},
+	{0x31E2CD19150DB4BFULL, 0x1CBA7DE5054485D0ULL},
+	{0x1F2DC02FAD2890F7ULL, 0x11F48EAF234AD3A2ULL},
+	{0xA6F9303B9872B535ULL, 0x1671B25AEC1D888AULL},
+	{0x50B77C4A7E8F6282ULL, 0x1C0E1EF1A724EAADULL},
+	{0x5272ADAE8F199D91ULL, 0x1188D357087712ACULL},
+	{0x670F591A32E004F6ULL, 0x15EB082CCA94D757ULL},
+	{0x40D32F60BF980633ULL, 0x1B65CA37FD3A0D2DULL},
+	{0x4883FD9C77BF03E0ULL, 0x111F9E62FE44483CULL},
+	{0x5AA4FD0395AEC4D8ULL, 0x156785FBBDD55A4BULL},
+	{0x314E3C447B1A760EULL, 0x1AC1677AAD4AB0DEULL},
+	{0xDED0E5AACCF089C9ULL, 0x10B8E0ACAC4EAE8AULL},
+	{0x96851F15802CAC3BULL, 0x14E718D7D7625A2DULL},
+	{0xFC2666DAE037D74AULL, 0x1A20DF0DCD3AF0B8ULL},
+	{0x9D980048CC22E68EULL, 0x10548B68A044D673ULL},
+	{0x84FE005AFF2BA032ULL, 0x1469AE42C8560C10ULL},
+	{0xA63D8071BEF6883EULL, 0x198419D37A6B8F14ULL},
+	{0xCFCCE08E2EB42A4EULL, 0x1FE52048590672D9ULL},
+	{0x21E00C58DD309A70ULL, 0x13EF342D37A407C8ULL},
+	{0x2A580F6F147CC10DULL, 0x18EB0138858D09BAULL},
+	{0xB4EE134AD99BF150ULL, 0x1F25C186A6F04C28ULL},
+	{0x7114CC0EC80176D2ULL, 0x137798F428562F99ULL},
+	{0xCD59FF127A01D486ULL, 0x18557F31326BBB7FULL},
+	{0xC0B07ED7188249A8ULL, 0x1E6ADEFD7F06AA5FULL},
+	{0xD86E4F466F516E09ULL, 0x1302CB5E6F642A7BULL},
+	{0xCE89E3180B25C98BULL, 0x17C37E360B3D351AULL},
+	{0x822C5BDE0DEF3BEEULL, 0x1DB45DC38E0C8261ULL},
+	{0xF15BB96AC8B58575ULL, 0x1290BA9A38C7D17CULL},
+	{0x2DB2A7C57AE2E6D2ULL, 0x1734E940C6F9C5DCULL},
+	{0x391F51B6D99BA086ULL, 0x1D022390F8B83753ULL},
+	{0x03B3931248014454ULL, 0x1221563A9B732294ULL},
+	{0x04A077D6DA019569ULL, 0x16A9ABC9424FEB39ULL},
+	{0x45C895CC9081FAC3ULL, 0x1C5416BB92E3E607ULL},
+	{0x8B9D5D9FDA513CBAULL, 0x11B48E353BCE6FC4ULL},
+	{0xAE84B507D0E58BE8ULL, 0x1621B1C28AC20BB5ULL},
+	{0x1A25E249C51EEEE3ULL, 0x1BAA1E332D728EA3ULL},
+	{0xF057AD6E1B33554DULL, 0x114A52DFFC679925ULL},
+	{0x6C6D98C9A2002AA1ULL, 0x159CE797FB817F6FULL},
+	{0x4788FEFC0A803549ULL, 0x1B04217DFA61DF4BULL},
+	{0x0CB59F5D8690214EULL, 0x10E294EEBC7D2B8FULL},
+	{0xCFE30734E83429A1ULL, 0x151B3A2A6B9C7672ULL},
+	{0x83DBC9022241340AULL, 0x1A6208B50683940FULL},
+	{0xB2695DA15568C086ULL, 0x107D457124123C89ULL},
+	{0x1F03B509AAC2F0A7ULL, 0x149C96CD6D16CBACULL},
+	{0x26C4A24C1573ACD1ULL, 0x19C3BC80C85C7E97ULL},
+	{0x783AE56F8D684C03ULL, 0x101A55D07D39CF1EULL},
+	{0x16499ECB70C25F03ULL, 0x1420EB449C8842E6ULL},
+	{0x9BDC067E4CF2F6C4ULL, 0x19292615C3AA539FULL},
+	{0x82D3081DE02FB476ULL, 0x1F736F9B3494E887ULL},
+	{0xB1C3E512AC1DD0C9ULL, 0x13A825C100DD1154ULL},
+	{0xDE34DE57572544FCULL, 0x18922F31411455A9ULL},
+	{0x55C215ED2CEE963BULL, 0x1EB6BAFD91596B14ULL},
+	{0xB5994DB43C151DE5ULL, 0x133234DE7AD7E2ECULL},
+	{0xE2FFA1214B1A655EULL, 0x17FEC216198DDBA7ULL},
+	{0xDBBF89699DE0FEB6ULL, 0x1DFE729B9FF15291ULL},
+	{0x2957B5E202AC9F31ULL, 0x12BF07A143F6D39BULL},
+	{0xF3ADA35A8357C6FEULL, 0x176EC98994F48881ULL},
+	{0x70990C31242DB8BDULL, 0x1D4A7BEBFA31AAA2ULL},
+	{0x865FA79EB69C9376ULL, 0x124E8D737C5F0AA5ULL},
+	{0xE7F791866443B854ULL, 0x16E230D05B76CD4EULL},
+	{0xA1F575E7FD54A669ULL, 0x1C9ABD04725480A2ULL},
+	{0xA53969B0FE54E801ULL, 0x11E0B622C774D065ULL},
+	{0x0E87C41D3DEA2202ULL, 0x1658E3AB7952047FULL},
+	{0xD229B5248D64AA82ULL, 0x1BEF1C9657A6859EULL},
+	{0x435A1136D85EEA91ULL, 0x117571DDF6C81383ULL},
+	{0x143095848E76A536ULL, 0x15D2CE55747A1864ULL},
+	{0x193CBAE5B2144E83ULL, 0x1B4781EAD1989E7DULL},
+	{0x2FC5F4CF8F4CB112ULL, 0x110CB132C2FF630EULL},
+	{0xBBB77203731FDD56ULL, 0x154FDD7F73BF3BD1ULL},
+	{0x2AA54E844FE7D4ACULL, 0x1AA3D4DF50AF0AC6ULL},
+	{0xDAA75112B1F0E4EBULL, 0x10A6650B926D66BBULL},
+	{0xD15125575E6D1E26ULL, 0x14CFFE4E7708C06AULL},
+	{0x85A56EAD360865B0ULL, 0x1A03FDE214CAF085ULL},
+	{0x7387652C41C53F8EULL, 0x10427EAD4CFED653ULL},
+	{0x50693E7752368F71ULL, 0x14531E58A03E8BE8ULL},
+	{0x64838E1526C4334EULL, 0x1967E5EEC84E2EE2ULL},
+	{0xFDA4719A70754022ULL, 0x1FC1DF6A7A61BA9AULL},
+	{0xDE86C70086494815ULL, 0x13D92BA28C7D14A0ULL},
+	{0x162878C0A7DB9A1AULL, 0x18CF768B2F9C59C9ULL},
+	{0x5BB296F0D1D280A1ULL, 0x1F03542DFB83703BULL},
+	{0x194F9E5683239064ULL, 0x1362149CBD322625ULL},
+	{0x5FA385EC23EC747EULL, 0x183A99C3EC7EAFAEULL},
+	{0xF78C67672CE7919DULL, 0x1E494034E79E5B99ULL},
+	{0x3AB7C0A07C10BB02ULL, 0x12EDC82110C2F940ULL},
+	{0x4965B0C89B14E9C3ULL, 0x17A93A2954F3B790ULL},
+	{0x5BBF1CFAC1DA2433ULL, 0x1D9388B3AA30A574ULL},
+	{0xB957721CB92856A0ULL, 0x127C35704A5E6768ULL},
+	{0xE7AD4EA3E7726C48ULL, 0x171B42CC5CF60142ULL},
+	{0xA198A24CE14F075AULL, 0x1CE2137F74338193ULL},
+	{0x44FF65700CD16498ULL, 0x120D4C2FA8A030FCULL},
+	{0x563F3ECC1005BDBEULL, 0x16909F3B92C83D3BULL},
+	{0x2BCF0E7F14072D2EULL, 0x1C34C70A777A4C8AULL},
+	{0x5B61690F6C847C3DULL, 0x11A0FC668AAC6FD6ULL},
+	{0xF239C35347A59B4CULL, 0x16093B802D578BCBULL},
+	{0xEEC83428198F021FULL, 0x1B8B8A6038AD6EBEULL},
+	{0x553D20990FF96153ULL, 0x1137367C236C6537ULL},
+	{0x2A8C68BF53F7B9A8ULL, 0x1585041B2C477E85ULL},
+	{0x752F82EF28F5A812ULL, 0x1AE64521F7595E26ULL},
+	{0x093DB1D57999890BULL, 0x10CFEB353A97DAD8ULL},
+	{0x0B8D1E4AD7FFEB4EULL, 0x1503E602893DD18EULL},
+	{0x8E7065DD8DFFE622ULL, 0x1A44DF832B8D45F1ULL},
+	{0xF9063FAA78BFEFD5ULL, 0x106B0BB1FB384BB6ULL},
+	{0xB747CF9516EFEBCAULL, 0x1485CE9E7A065EA4ULL},
+	{0xE519C37A5CABE6BDULL, 0x19A742461887F64DULL},
+	{0xAF301A2C79EB7036ULL, 0x1008896BCF54F9F0ULL},
+	{0xDAFC20B798664C43ULL, 0x140AABC6C32A386CULL},
+	{0x11BB28E57E7FDF54ULL, 0x190D56B873F4C688ULL},
+	{0x1629F31EDE1FD72AULL, 0x1F50AC6690F1F82AULL},
+	{0x4DDA37F34AD3E67AULL, 0x13926BC01A973B1AULL},
+	{0xE150C5F01D88E019ULL, 0x187706B0213D09E0ULL},
+	{0x19A4F76C24EB181FULL, 0x1E94C85C298C4C59ULL},
+	{0xB0071AA39712EF13ULL, 0x131CFD3999F7AFB7ULL},
+	{0x9C08E14C7CD7AAD8ULL, 0x17E43C8800759BA5ULL},
+	{0x030B199F9C0D958EULL, 0x1DDD4BAA0093028FULL},
+	{0x61E6F003C1887D79ULL, 0x12AA4F4A405BE199ULL},
+	{0xBA60AC04B1EA9CD7ULL, 0x1754E31CD072D9FFULL},
+	{0xA8F8D705DE65440DULL, 0x1D2A1BE4048F907FULL},
+	{0xC99B8663AAFF4A88ULL, 0x123A516E82D9BA4FULL},
+	{0xBC0267FC95BF1D2AULL, 0x16C8E5CA239028E3ULL},
+	{0xAB0301FBBB2EE474ULL, 0x1C7B1F3CAC74331CULL},
+	{0xEAE1E13D54FD4EC9ULL, 0x11CCF385EBC89FF1ULL},
+	{0x659A598CAA3CA27BULL, 0x1640306766BAC7EEULL},
+	{0xFF00EFEFD4CBCB1AULL, 0x1BD03C81406979E9ULL},
+	{0x3F6095F5E4FF5EF0ULL, 0x116225D0C841EC32ULL},
+	{0xCF38BB735E3F36ACULL, 0x15BAAF44FA52673EULL},
+	{0x8306EA5035CF0457ULL, 0x1B295B1638E7010EULL},
+	{0x11E4527221A162B6ULL, 0x10F9D8EDE39060A9ULL},
+	{0x565D670EAA09BB64ULL, 0x15384F295C7478D3ULL},
+	{0x2BF4C0D2548C2A3DULL, 0x1A8662F3B3919708ULL},
+	{0x1B78F88374D79A66ULL, 0x1093FDD8503AFE65ULL},
+	{0x625736A4520D8100ULL, 0x14B8FD4E6449BDFEULL},
+	{0xFAED044D6690E140ULL, 0x19E73CA1FD5C2D7DULL},
+	{0xBCD422B0601A8CC8ULL, 0x103085E53E599C6EULL},
+	{0x6C092B5C78212FFAULL, 0x143CA75E8DF0038AULL},
+	{0x070B763396297BF8ULL, 0x194BD136316C046DULL},
+	{0x48CE53C07BB3DAF6ULL, 0x1F9EC583BDC70588ULL},
+	{0x2D80F4584D5068DAULL, 0x13C33B72569C6375ULL},
+	{0x78E1316E60A48310ULL, 0x18B40A4EEC437C52ULL},
+};
+
+// Bits of precision in the tables above
+static const int32_t kPow5Bits = 125;
+
+/***************************************
+
+	Return ceil(log2(5^iExponent)), or 1 if zero
+
+***************************************/
+
+static BURGER_INLINE int32_t Pow5Bits(int32_t iExponent) BURGER_NOEXCEPT
+{
+	return ((iExponent * 1217359) >> 19) + 1;
+}
+
+/***************************************
+
+	Return floor(log10(2^iExponent))
+
+***************************************/
+
+static BURGER_INLINE int32_t Log10Pow2(int32_t iExponent) BURGER_NOEXCEPT
+{
+	return (iExponent * 78913) >> 18;
+}
+
+/***************************************
+
+	Return floor(log10(5^iExponent))
+
+***************************************/
+
+static BURGER_INLINE int32_t Log10Pow5(int32_t iExponent) BURGER_NOEXCEPT
+{
+	return (iExponent * 732923) >> 20;
+}
+
+/***************************************
+
+	Multiply two 64 bit values into a 128 bit result
+
+***************************************/
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 uint128_fp_t;
+#endif
+
+static BURGER_INLINE uint64_t Multiply128(
+	uint64_t uInput1, uint64_t uInput2, uint64_t* pHigh) BURGER_NOEXCEPT
+{
+#if defined(__SIZEOF_INT128__)
+	const uint128_fp_t uResult = static_cast<uint128_fp_t>(uInput1) * uInput2;
+	pHigh[0] = static_cast<uint64_t>(uResult >> 64U);
+	return static_cast<uint64_t>(uResult);
+
+#elif defined(BURGER_MSVC) && defined(BURGER_AMD64)
+	return _umul128(uInput1, uInput2, pHigh);
+
+#else
+	// Do it the old fashioned way, 32x32->64 at a time
+	const uint64_t uLow1 = uInput1 & 0xFFFFFFFFU;
+	const uint64_t uHigh1 = uInput1 >> 32U;
+	const uint64_t uLow2 = uInput2 & 0xFFFFFFFFU;
+	const uint64_t uHigh2 = uInput2 >> 32U;
+
+	const uint64_t uLowLow = uLow1 * uLow2;
+	const uint64_t uLowHigh = uLow1 * uHigh2;
+	const uint64_t uHighLow = uHigh1 * uLow2;
+
+	// This can't overflow, it's at most 3*(2^32-1)
+	const uint64_t uMiddle = (uLowLow >> 32U) + (uLowHigh & 0xFFFFFFFFU) +
+		(uHighLow & 0xFFFFFFFFU);
+	pHigh[0] = (uHigh1 * uHigh2) + (uLowHigh >> 32U) + (uHighLow >> 32U) +
+		(uMiddle >> 32U);
+	return (uMiddle << 32U) | (uLowLow & 0xFFFFFFFFU);
+#endif
+}
+
+/***************************************
+
+	Return (uInput * 128 bit table entry) >> iShift, iShift is 65-127
+
+***************************************/
+
+static uint64_t MulShift64(
+	uint64_t uInput, const uint64_t* pTable, int32_t iShift) BURGER_NOEXCEPT
+{
+	uint64_t uHigh0;
+	Multiply128(uInput, pTable[0], &uHigh0);
+	uint64_t uHigh1;
+	const uint64_t uLow1 = Multiply128(uInput, pTable[1], &uHigh1);
+
+	// Add the middle 64 bits together, with carry
+	const uint64_t uMiddle = uHigh0 + uLow1;
+	uHigh1 += (uMiddle < uHigh0);
+
+	// Shift the upper 128 bits into place
+	const uint32_t uShift = static_cast<uint32_t>(iShift - 64);
+	return (uHigh1 << (64U - uShift)) | (uMiddle >> uShift);
+}
+
+/***************************************
+
+	Return TRUE if uInput is divisible by 5^uPower
+
+***************************************/
+
+static uint_t IsMultipleOfPowerOf5(
+	uint64_t uInput, int32_t iPower) BURGER_NOEXCEPT
+{
+	int32_t iCount = 0;
+	while (!(uInput % 5U)) {
+		uInput /= 5U;
+		++iCount;
+	}
+	return iCount >= iPower;
+}
+
+/***************************************
+
+	Ryu, find the shortest decimal that round trips to the binary value.
+
+	uMantissa * 2^iExponent2 is the value, bShiftLower is TRUE if the gap to
+	the next lower value is the same as the gap to the next higher value. The
+	result is the decimal digits as an integer and the power of 10 it's
+	scaled by.
+
+***************************************/
+
+static uint64_t ShortestDigits(uint64_t uMantissa, int32_t iExponent2,
+	uint_t bShiftLower, int32_t* pExponent10) BURGER_NOEXCEPT
+{
+	// Bias the exponent by 2 for the 4x scaled midpoints
+	iExponent2 -= 2;
+
+	// Round to even, so the interval is closed if the mantissa is even
+	const uint_t bAcceptBounds = !(uMantissa & 1U);
+
+	// Scale up by 4 to make room for the halfway points
+	const uint64_t uMiddle = uMantissa << 2U;
+	const uint64_t uLowerBias = 1U + bShiftLower;
+
+	uint64_t uValue;
+	uint64_t uUpper;
+	uint64_t uLower;
+	int32_t iExponent10;
+	uint_t bLowerTrailingZeros = FALSE;
+	uint_t bValueTrailingZeros = FALSE;
+
+	if (iExponent2 >= 0) {
+		const int32_t iQ = Log10Pow2(iExponent2) - (iExponent2 > 3);
+		iExponent10 = iQ;
+		const int32_t iShift =
+			-iExponent2 + iQ + kPow5Bits + Pow5Bits(iQ) - 1;
+		const uint64_t* pTable = g_Pow5InverseTable[iQ];
+		uValue = MulShift64(uMiddle, pTable, iShift);
+		uUpper = MulShift64(uMiddle + 2U, pTable, iShift);
+		uLower = MulShift64(uMiddle - uLowerBias, pTable, iShift);
+
+		// Only 22 powers of 5 fit in 53 bits, so only check low exponents
+		if (iQ <= 21) {
+			if (!(uMiddle % 5U)) {
+				bValueTrailingZeros = IsMultipleOfPowerOf5(uMiddle, iQ);
+			} else if (bAcceptBounds) {
+				bLowerTrailingZeros =
+					IsMultipleOfPowerOf5(uMiddle - uLowerBias, iQ);
+			} else {
+				uUpper -= IsMultipleOfPowerOf5(uMiddle + 2U, iQ);
+			}
+		}
+	} else {
+		const int32_t iQ = Log10Pow5(-iExponent2) - (-iExponent2 > 1);
+		iExponent10 = iQ + iExponent2;
+		const int32_t iIndex = -iExponent2 - iQ;
+		const int32_t iShift = iQ - (Pow5Bits(iIndex) - kPow5Bits);
+		const uint64_t* pTable = g_Pow5Table[iIndex];
+		uValue = MulShift64(uMiddle, pTable, iShift);
+		uUpper = MulShift64(uMiddle + 2U, pTable, iShift);
+		uLower = MulShift64(uMiddle - uLowerBias, pTable, iShift);
+
+		if (iQ <= 1) {
+			// All the bits are trailing zeros
+			bValueTrailingZeros = TRUE;
+			if (bAcceptBounds) {
+				bLowerTrailingZeros = bShiftLower;
+			} else {
+				--uUpper;
+			}
+		} else if (iQ < 63) {
+			bValueTrailingZeros =
+				!(uMiddle & ((static_cast<uint64_t>(1U) << iQ) - 1U));
+		}
+	}
+
+	// Remove digits while the upper and lower bounds still differ
+	int32_t iRemoved = 0;
+	uint64_t uOutput;
+	if (bLowerTrailingZeros || bValueTrailingZeros) {
+
+		// Rare case, track exact halfway values
+		uint_t uLastRemoved = 0;
+		for (;;) {
+			const uint64_t uUpper10 = uUpper / 10U;
+			const uint64_t uLower10 = uLower / 10U;
+			if (uUpper10 <= uLower10) {
+				break;
+			}
+			const uint64_t uValue10 = uValue / 10U;
+			bLowerTrailingZeros &= (uLower == (uLower10 * 10U));
+			bValueTrailingZeros &= !uLastRemoved;
+			uLastRemoved = static_cast<uint_t>(uValue - (uValue10 * 10U));
+			uValue = uValue10;
+			uUpper = uUpper10;
+			uLower = uLower10;
+			++iRemoved;
+		}
+		if (bLowerTrailingZeros) {
+			for (;;) {
+				const uint64_t uLower10 = uLower / 10U;
+				if (uLower != (uLower10 * 10U)) {
+					break;
+				}
+				const uint64_t uValue10 = uValue / 10U;
+				bValueTrailingZeros &= !uLastRemoved;
+				uLastRemoved = static_cast<uint_t>(uValue - (uValue10 * 10U));
+				uValue = uValue10;
+				uUpper /= 10U;
+				uLower = uLower10;
+				++iRemoved;
+			}
+		}
+
+		// Exactly halfway? Round to even
+		if (bValueTrailingZeros && (uLastRemoved == 5U) && !(uValue & 1U)) {
+			uLastRemoved = 4;
+		}
+		uOutput = uValue +
+			(((uValue == uLower) && (!bAcceptBounds || !bLowerTrailingZeros)) ||
+				(uLastRemoved >= 5U));
+	} else {
+
+		// Common case, remove 2 digits at a time at first
+		uint_t bRoundUp = FALSE;
+		const uint64_t uUpper100 = uUpper / 100U;
+		const uint64_t uLower100 = uLower / 100U;
+		if (uUpper100 > uLower100) {
+			const uint64_t uValue100 = uValue / 100U;
+			bRoundUp = (uValue - (uValue100 * 100U)) >= 50U;
+			uValue = uValue100;
+			uUpper = uUpper100;
+			uLower = uLower100;
+			iRemoved += 2;
+		}
+		for (;;) {
+			const uint64_t uUpper10 = uUpper / 10U;
+			const uint64_t uLower10 = uLower / 10U;
+			if (uUpper10 <= uLower10) {
+				break;
+			}
+			const uint64_t uValue10 = uValue / 10U;
+			bRoundUp = (uValue - (uValue10 * 10U)) >= 5U;
+			uValue = uValue10;
+			uUpper = uUpper10;
+			uLower = uLower10;
+			++iRemoved;
+		}
+		uOutput = uValue + ((uValue == uLower) || bRoundUp);
+	}
+	pExponent10[0] = iExponent10 + iRemoved;
+	return uOutput;
+}
+
+#endif
+
+/*! ************************************
+
+	\fn Burger::FPDecimal::FPDecimal()
+	\brief Default constructor
+
+	Initialize to zero.
+
+***************************************/
+
+/*! ************************************
+
+	\brief Reset to zero
+
+	Set the value to positive zero with no digits.
+
+***************************************/
+
+void BURGER_API Burger::FPDecimal::clear(void) BURGER_NOEXCEPT
+{
+	m_dValue = 0.0;
+	m_iExponent = 0;
+	m_uDigitCount = 0;
+	m_uSafeDigits = 0;
+	m_bNegative = FALSE;
+	m_bExact = TRUE;
+	m_bTruncated = FALSE;
+}
+
+/*! ************************************
+
+	\brief Convert a double to the shortest round trip digits
+
+	Find the fewest decimal digits that will be converted back into the exact
+	same double. If there is more than one, the one closest to the real value
+	is used.
+
+	\param dInput Value to convert
+
+	\sa shortest(float)
+
+***************************************/
+
+void BURGER_API Burger::FPDecimal::shortest(double dInput) BURGER_NOEXCEPT
+{
+	uint64_double_t Temp;
+	Temp.d = dInput;
+	const uint64_t uBits = Temp.w;
+	const uint64_t uMantissa = uBits & 0x000FFFFFFFFFFFFFULL;
+	const uint32_t uExponent = static_cast<uint32_t>(uBits >> 52U) & 0x7FFU;
+
+	m_dValue = dInput;
+	m_bNegative = static_cast<uint_t>(uBits >> 63U);
+	m_bExact = FALSE;
+	m_bTruncated = FALSE;
+
+	// Zero, infinity or NaN?
+	if ((!uExponent && !uMantissa) || (uExponent == 0x7FFU)) {
+		m_iExponent = 0;
+		m_uDigitCount = 0;
+		m_bExact = TRUE;
+	} else {
+		// Normalized doubles have 15 digits that are always accurate, subnormals
+		// can have as few as one
+		int32_t iExponent2;
+		uint64_t uValue;
+		if (uExponent) {
+			iExponent2 = static_cast<int32_t>(uExponent) - (1023 + 52);
+			uValue = uMantissa | 0x0010000000000000ULL;
+			m_uSafeDigits = 15;
+		} else {
+			iExponent2 = 1 - (1023 + 52);
+			uValue = uMantissa;
+			m_uSafeDigits = 0;
+		}
+		int32_t iExponent10;
+		const uint64_t uDigits = ShortestDigits(uValue, iExponent2,
+			(uMantissa != 0) || (uExponent <= 1), &iExponent10);
+		set_digits(uDigits, iExponent10);
+	}
+}
+
+/*! ************************************
+
+	\brief Convert a float to the shortest round trip digits
+
+	Find the fewest decimal digits that will be converted back into the exact
+	same float. If there is more than one, the one closest to the real value
+	is used.
+
+	\param fInput Value to convert
+
+	\sa shortest(double)
+
+***************************************/
+
+void BURGER_API Burger::FPDecimal::shortest(float fInput) BURGER_NOEXCEPT
+{
+	uint32_float_t Temp;
+	Temp.f = fInput;
+	const uint32_t uBits = Temp.w;
+	const uint32_t uMantissa = uBits & 0x007FFFFFU;
+	const uint32_t uExponent = (uBits >> 23U) & 0xFFU;
+
+	m_dValue = static_cast<double>(fInput);
+	m_bNegative = uBits >> 31U;
+	m_bExact = FALSE;
+	m_bTruncated = FALSE;
+
+	// Zero, infinity or NaN?
+	if ((!uExponent && !uMantissa) || (uExponent == 0xFFU)) {
+		m_iExponent = 0;
+		m_uDigitCount = 0;
+		m_bExact = TRUE;
+	} else {
+		// Normalized floats have 6 digits that are always accurate
+		int32_t iExponent2;
+		uint32_t uValue;
+		if (uExponent) {
+			iExponent2 = static_cast<int32_t>(uExponent) - (127 + 23);
+			uValue = uMantissa | 0x00800000U;
+			m_uSafeDigits = 6;
+		} else {
+			iExponent2 = 1 - (127 + 23);
+			uValue = uMantissa;
+			m_uSafeDigits = 0;
+		}
+		int32_t iExponent10;
+		const uint64_t uDigits = ShortestDigits(uValue, iExponent2,
+			(uMantissa != 0) || (uExponent <= 1), &iExponent10);
+		set_digits(uDigits, iExponent10);
+	}
+}
+
+/*! ************************************
+
+	\brief Round to a power of 10
+
+	Round to nearest even so that no digits below 10^iPosition remain. This
+	is the rounding that "%f" uses where iPosition is the negative of the
+	precision.
+
+	\note This can only be called once after shortest(double) or
+		shortest(float), since rounding twice could round incorrectly.
+
+	\param iPosition Power of 10 of the lowest digit to keep
+
+	\sa round_to_digits(uint32_t)
+
+***************************************/
+
+void BURGER_API Burger::FPDecimal::round_to_position(
+	int32_t iPosition) BURGER_NOEXCEPT
+{
+	if (m_uDigitCount) {
+		round_digits(iPosition, 0);
+	}
+}
+
+/*! ************************************
+
+	\brief Round to a number of significant digits
+
+	Round to nearest even so that only uDigits digits remain. This is the
+	rounding that "%e" uses with uDigits being the precision plus one.
+
+	\note This can only be called once after shortest(double) or
+		shortest(float), since rounding twice could round incorrectly.
+
+	\param uDigits Number of significant digits to keep, zero is treated as
+		one.
+
+	\sa round_to_position(int32_t)
+
+***************************************/
+
+void BURGER_API Burger::FPDecimal::round_to_digits(
+	uint32_t uDigits) BURGER_NOEXCEPT
+{
+	if (m_uDigitCount) {
+		if (!uDigits) {
+			uDigits = 1;
+		}
+		round_digits(
+			m_iExponent - static_cast<int32_t>(uDigits) + 1, uDigits);
+	}
+}
+
+/*! ************************************
+
+	\fn uint_t Burger::FPDecimal::is_zero(void) const
+	\brief Is the value zero?
+
+	\return \ref TRUE if there are no digits
+
+***************************************/
+
+/*! ************************************
+
+	\fn uint_t Burger::FPDecimal::is_negative(void) const
+	\brief Is the value negative?
+
+	\return \ref TRUE if the sign bit was set, even for zero
+
+***************************************/
+
+/*! ************************************
+
+	\fn int32_t Burger::FPDecimal::get_exponent(void) const
+	\brief Get the power of 10 of the first digit
+
+	\return Power of 10 of the first digit, 0 if the value is zero
+
+***************************************/
+
+/*! ************************************
+
+	\fn uint32_t Burger::FPDecimal::get_digit_count(void) const
+	\brief Get the number of digits
+
+	\return Number of significant digits, 0 if the value is zero
+
+***************************************/
+
+/*! ************************************
+
+	\fn const char* Burger::FPDecimal::get_digits(void) const
+	\brief Get the digits
+
+	\return Pointer to the ASCII digits, they are not zero terminated
+
+***************************************/
+
+/*! ************************************
+
+	\fn int32_t Burger::FPDecimal::get_last_position(void) const
+	\brief Get the power of 10 of the last digit
+
+	\return Power of 10 of the last non-zero digit
+
+***************************************/
+
+/*! ************************************
+
+	\fn char Burger::FPDecimal::get_digit(int32_t iPosition) const
+	\brief Get the digit at a power of 10
+
+	\param iPosition Power of 10 of the digit
+	\return ASCII digit, '0' if outside of the significant digits
+
+***************************************/
+
+/*! ************************************
+
+	\brief Store an integer as the digits
+
+	Convert an integer of up to 17 digits into ASCII and remove the trailing
+	zeros.
+
+	\param uDigits Integer of the digits
+	\param iExponent Power of 10 of the last digit
+
+***************************************/
+
+void BURGER_API Burger::FPDecimal::set_digits(
+	uint64_t uDigits, int32_t iExponent) BURGER_NOEXCEPT
+{
+	// Remove trailing zeros
+	uint64_t uDigits10 = uDigits / 10U;
+	while (uDigits == (uDigits10 * 10U)) {
+		uDigits = uDigits10;
+		uDigits10 = uDigits / 10U;
+		++iExponent;
+	}
+
+	// Write the digits right to left
+	const uint32_t uCount = NumberStringLength(uDigits);
+	m_uDigitCount = uCount;
+	m_iExponent = iExponent + static_cast<int32_t>(uCount) - 1;
+	char* pWork = m_Digits + uCount;
+	do {
+		uDigits10 = uDigits / 10U;
+		*--pWork = static_cast<char>('0' + (uDigits - (uDigits10 * 10U)));
+		uDigits = uDigits10;
+	} while (pWork != m_Digits);
+}
+
+/*! ************************************
+
+	\brief Round the digits
+
+	Check if the shortest digits can be rounded directly and do so, otherwise
+	round the exact value.
+
+	\param iPosition Power of 10 of the lowest digit to keep
+	\param uDigits Number of significant digits requested, or zero if
+		iPosition is the requested position
+
+***************************************/
+
+void BURGER_API Burger::FPDecimal::round_digits(
+	int32_t iPosition, uint32_t uDigits) BURGER_NOEXCEPT
+{
+	const int32_t iCount = static_cast<int32_t>(m_uDigitCount);
+	const int32_t iKeep = m_iExponent - iPosition + 1;
+
+	if (iKeep >= iCount) {
+		// Nothing to remove, the shortest digits padded with zeros are only
+		// correct if the spacing at this precision is wider than the binary
+		// spacing between values.
+		if (!m_bExact && (iKeep > static_cast<int32_t>(m_uSafeDigits))) {
+			exact_round(iPosition, uDigits);
+		}
+		return;
+	}
+
+	uint_t bRoundUp = FALSE;
+	if (iKeep >= 0) {
+		const char cDigit = m_Digits[iKeep];
+		if (cDigit > '5') {
+			bRoundUp = TRUE;
+		} else if (cDigit == '5') {
+			if ((iKeep + 1) < iCount) {
+				// There are non-zero digits after the 5
+				bRoundUp = TRUE;
+			} else if (!m_bExact) {
+				// A trailing 5 isn't a tie in the real value, it may be
+				// slightly above or below the digits
+				exact_round(iPosition, uDigits);
+				return;
+			} else if (iKeep) {
+				// True tie, round to even
+				bRoundUp = m_Digits[iKeep - 1] & 1U;
+			}
+		}
+	}
+	truncate(iKeep, bRoundUp);
+}
+
+/*! ************************************
+
+	\brief Remove digits and round up
+
+	Keep iKeep digits and if requested, increment the last one.
+
+	\param iKeep Number of digits to keep, can be zero or negative
+	\param bRoundUp \ref TRUE to round up the digits that are kept
+
+***************************************/
+
+void BURGER_API Burger::FPDecimal::truncate(
+	int32_t iKeep, uint_t bRoundUp) BURGER_NOEXCEPT
+{
+	if (iKeep <= 0) {
+		// All digits are removed, it's either 0 or 1 in the lowest position
+		if (bRoundUp) {
+			m_iExponent = m_iExponent - iKeep + 1;
+			m_Digits[0] = '1';
+			m_uDigitCount = 1;
+		} else {
+			m_iExponent = 0;
+			m_uDigitCount = 0;
+		}
+		return;
+	}
+
+	uint32_t uCount = static_cast<uint32_t>(iKeep);
+	if (bRoundUp) {
+		// Any 9's become trailing zeros
+		while (uCount && (m_Digits[uCount - 1] == '9')) {
+			--uCount;
+		}
+		if (!uCount) {
+			// All 9s rolled over
+			m_Digits[0] = '1';
+			uCount = 1;
+			++m_iExponent;
+		} else {
+			++m_Digits[uCount - 1];
+		}
+	} else {
+		while (uCount && (m_Digits[uCount - 1] == '0')) {
+			--uCount;
+		}
+		if (!uCount) {
+			m_iExponent = 0;
+		}
+	}
+	m_uDigitCount = uCount;
+}
+
+/*! ************************************
+
+	\brief Round the exact value
+
+	Expand the exact binary value into decimal digits with \ref FPLargeInt and
+	round to nearest even. This is only needed if more digits are requested
+	than the binary value can hold or if the shortest digits are too close to
+	a tie to be rounded directly.
+
+	\param iPosition Power of 10 of the lowest digit to keep
+	\param uDigits Number of significant digits requested, or zero if
+		iPosition is the requested position
+
+***************************************/
+
+void BURGER_API Burger::FPDecimal::exact_round(
+	int32_t iPosition, uint32_t uDigits) BURGER_NOEXCEPT
+{
+	m_bExact = TRUE;
+
+	// Split the value into integer and fraction
+	const FPInfo TheFPInfo(m_dValue);
+	const uint32_t uBitsNeeded =
+		(1U << (TheFPInfo.get_exponent_bit_count() - 1)) +
+		TheFPInfo.get_mantissa_bit_count();
+	FPLargeInt IntegerPart(uBitsNeeded);
+	FPLargeInt FractionalPart(uBitsNeeded);
+	separate_integer_fraction(&IntegerPart, &FractionalPart, &TheFPInfo);
+
+	// The integer digits come out right to left, store them at the end of the
+	// buffer and then move them to the start
+	uint32_t uCount = 0;
+	int32_t iExponent = 0;
+	if (IntegerPart.is_not_zero()) {
+		char* pWork = m_Digits + kMaxDigits;
+		do {
+			*--pWork = static_cast<char>(
+				'0' + IntegerPart.divide_return_remainder(10U));
+		} while (IntegerPart.is_not_zero());
+		uCount = static_cast<uint32_t>((m_Digits + kMaxDigits) - pWork);
+		iExponent = static_cast<int32_t>(uCount) - 1;
+		memory_move(m_Digits, pWork, uCount);
+	}
+
+	// The fraction digits come out left to right, leading zeros are skipped
+	// and the digit below the last one kept is needed for rounding
+	int32_t iDigitPosition = -1;
+	while (FractionalPart.is_not_zero() && (uCount < kMaxDigits)) {
+		if (uDigits) {
+			if (uCount > uDigits) {
+				break;
+			}
+		} else if (iDigitPosition < (iPosition - 1)) {
+			break;
+		}
+		const uint32_t uDigit = FractionalPart.multiply_return_overflow(10U);
+		if (uCount || uDigit) {
+			if (!uCount) {
+				iExponent = iDigitPosition;
+			}
+			m_Digits[uCount] = static_cast<char>('0' + uDigit);
+			++uCount;
+		}
+		--iDigitPosition;
+	}
+
+	// Are there non-zero digits that weren't generated?
+	uint_t bSticky = FractionalPart.is_not_zero();
+
+	m_iExponent = iExponent;
+	m_uDigitCount = uCount;
+	if (uDigits) {
+		iPosition = iExponent - static_cast<int32_t>(uDigits) + 1;
+	}
+
+	// Round to nearest even
+	const int32_t iKeep = iExponent - iPosition + 1;
+	if (iKeep >= static_cast<int32_t>(uCount)) {
+		truncate(static_cast<int32_t>(uCount), FALSE);
+	} else {
+		uint_t bRoundUp = FALSE;
+		if (iKeep >= 0) {
+			const char cDigit = m_Digits[iKeep];
+			if (cDigit > '5') {
+				bRoundUp = TRUE;
+			} else if (cDigit == '5') {
+				uint32_t uIndex = static_cast<uint32_t>(iKeep) + 1;
+				while (!bSticky && (uIndex < uCount)) {
+					bSticky = (m_Digits[uIndex] != '0');
+					++uIndex;
+				}
+				if (bSticky) {
+					bRoundUp = TRUE;
+				} else if (iKeep) {
+					bRoundUp = m_Digits[iKeep - 1] & 1U;
+				}
+			}
+		}
+		truncate(iKeep, bRoundUp);
+	}
+}
+
+#if !defined(DOXYGEN)
+
+// Eisel-Lemire table, 5^q for q = -342 to 308, normalized and truncated to
+// 128 bits. Negative powers are rounded up. Each entry is low 64 bits, then
+// the high 64 bits.
+
+static const uint64_t g_Pow5Table128[651][2] = {
+	{0x113FAA2906A13B3FULL, 0xEEF453D6923BD65AULL},
+	{0x4AC7CA59A424C507ULL, 0x9558B4661B6565F8ULL},
+	{0x5D79BCF00D2DF649ULL, 0xBAAEE17FA23EBF76ULL},
+	{0xF4D82C2C107973DCULL, 0xE95A99DF8ACE6F53ULL},
+	{0x79071B9B8A4BE869ULL, 0x91D8A02BB6C10594ULL},
+	{0x9748E2826CDEE284ULL, 0xB64EC836A47146F9ULL},
+	{0xFD1B1B2308169B25ULL, 0xE3E27A444D8D98B7ULL},
+	{0xFE30F0F5E50E20F7ULL, 0x8E6D8C6AB0787F72ULL},
+	{0xBDBD2D335E51A935ULL, 0xB208EF855C969F4FULL},
+	{0xAD2C788035E61382ULL, 0xDE8B2B66B3BC4723ULL},
+	{0x4C3BCB5021AFCC31ULL, 0x8B16FB203055AC76ULL},
+	{0xDF4ABE242A1BBF3DULL, 0xADDCB9E83C6B1793ULL},
+	{0xD71D6DAD34A2AF0DULL, 0xD953E8624B85DD78ULL},
+	{0x8672648C40E5AD68ULL, 0x87D4713D6F33AA6BULL},
+	{0x680EFDAF511F18C2ULL, 0xA9C98D8CCB009506ULL},
+	{0x0212BD1B2566DEF2ULL, 0xD43BF0EFFDC0BA48ULL},
+	{0x014BB630F7604B57ULL, 0x84A57695FE98746DULL},
+	{0x419EA3BD35385E2DULL, 0xA5CED43B7E3E9188ULL},
+	{0x52064CAC828675B9ULL, 0xCF42894A5DCE35EAULL},
+	{0x7343EFEBD1940993ULL, 0x818995CE7AA0E1B2ULL},
+	{0x1014EBE6C5F90BF8ULL, 0xA1EBFB4219491A1FULL},
+	{0xD41A26E077774EF6ULL, 0xCA66FA129F9B60A6ULL},
+	{0x8920B098955522B4ULL, 0xFD00B897478238D0ULL},
+	{0x55B46E5F5D5535B0ULL, 0x9E20735E8CB16382ULL},
+	{0xEB2189F734AA831DULL, 0xC5A890362FDDBC62ULL},
+	{0xA5E9EC7501D523E4ULL, 0xF712B443BBD52B7BULL},
+	{0x47B233C92125366EULL, 0x9A6BB0AA55653B2DULL},
+	{0x999EC0BB696E840AULL, 0xC1069CD4EABE89F8ULL},
+	{0xC00670EA43CA250DULL, 0xF148440A256E2C76ULL},
+	{0x380406926A5E5728ULL, 0x96CD2A865764DBCAULL},
+	{0xC605083704F5ECF2ULL, 0xBC807527ED3E12BCULL},
+	{0xF7864A44C633682EULL, 0xEBA09271E88D976BULL},
+	{0x7AB3EE6AFBE0211DULL, 0x93445B8731587EA3ULL},
+	{0x5960EA05BAD82964ULL, 0xB8157268FDAE9E4CULL},
+	{0x6FB92487298E33BDULL, 0xE61ACF033D1A45DFULL},
+	{0xA5D3B6D479F8E056ULL, 0x8FD0C16206306BABULL},
+	{0x8F48A4899877186CULL, 0xB3C4F1BA87BC8696ULL},
+	{0x331ACDABFE94DE87ULL, 0xE0B62E2929ABA83CULL},
+	{0x9FF0C08B7F1D0B14ULL, 0x8C71DCD9BA0B4925ULL},
+	{0x07ECF0AE5EE44DD9ULL, 0xAF8E5410288E1B6FULL},
+	{0xC9E82CD9F69D6150ULL, 0xDB71E91432B1A24AULL},
+	{0xBE311C083A225CD2ULL, 0x892731AC9FAF056EULL},
+	{0x6DBD630A48AAF406ULL, 0xAB70FE17C79AC6CAULL},
+	{0x092CBBCCDAD5B108ULL, 0xD64D3D9DB981787DULL},
+	{0x25BBF56008C58EA5ULL, 0x85F0468293F0EB4EULL},
+	{0xAF2AF2B80AF6F24EULL, 0xA76C582338ED2621ULL},
+	{0x1AF5AF660DB4AEE1ULL, 0xD1476E2C07286FAAULL},
+	{0x50D98D9FC890ED4DULL, 0x82CCA4DB847945CAULL},
+	{0xE50FF107BAB528A0ULL, 0xA37FCE126597973CULL},
+	{0x1E53ED49A96272C8ULL, 0xCC5FC196FEFD7D0CULL},
+	{0x25E8E89C13BB0F7AULL, 0xFF77B1FCBEBCDC4FULL},
+	{0x77B191618C54E9ACULL, 0x9FAACF3DF73609B1ULL},
+	{0xD59DF5B9EF6A2417ULL, 0xC795830D75038C1DULL},
+	{0x4B0573286B44AD1DULL, 0xF97AE3D0D2446F25ULL},
+	{0x4EE367F9430AEC32ULL, 0x9BECCE62836AC577ULL},
+	{0x229C41F793CDA73FULL, 0xC2E801FB244576D5ULL},
+	{0x6B43527578C1110FULL, 0xF3A20279ED56D48AULL},
+	{0x830A13896B78AAA9ULL, 0x9845418C345644D6ULL},
+	{0x23CC986BC656D553ULL, 0xBE5691EF416BD60CULL},
+	{0x2CBFBE86B7EC8AA8ULL, 0xEDEC366B11C6CB8FULL},
+	{0x7BF7D71432F3D6A9ULL, 0x94B3A202EB1C3F39ULL},
+	{0xDAF5CCD93FB0CC53ULL, 0xB9E08A83A5E34F07ULL},
+	{0xD1B3400F8F9CFF68ULL, 0xE858AD248F5C22C9ULL},
+	{0x23100809B9C21FA1ULL, 0x91376C36D99995BEULL},
+	{0xABD40A0C2832A78AULL, 0xB58547448FFFFB2DULL},
+	{0x16C90C8F323F516CULL, 0xE2E69915B3FFF9F9ULL},
+	{0xAE3DA7D97F6792E3ULL, 0x8DD01FAD907FFC3BULL},
+	{0x99CD11CFDF41779CULL, 0xB1442798F49FFB4AULL},
+	{0x40405643D711D583ULL, 0xDD95317F31C7FA1DULL},
+	{0x482835EA666B2572ULL, 0x8A7D3EEF7F1CFC52ULL},
+	{0xDA3243650005EECFULL, 0xAD1C8EAB5EE43B66ULL},
+	{0x90BED43E40076A82ULL, 0xD863B256369D4A40ULL},
+	{0x5A7744A6E804A291ULL, 0x873E4F75E2224E68ULL},
+	{0x711515D0A205CB36ULL, 0xA90DE3535AAAE202ULL},
+	{0x0D5A5B44CA873E03ULL, 0xD3515C2831559A83ULL},
+	{0xE858790AFE9486C2ULL, 0x8412D9991ED58091ULL},
+	{0x626E974DBE39A872ULL, 0xA5178FFF668AE0B6ULL},
+	{0xFB0A3D212DC8128FULL, 0xCE5D73FF402D98E3ULL},
+	{0x7CE66634BC9D0B99ULL, 0x80FA687F881C7F8EULL},
+	{0x1C1FFFC1EBC44E80ULL, 0xA139029F6A239F72ULL},
+	{0xA327FFB266B56220ULL, 0xC987434744AC874EULL},
+	{0x4BF1FF9F0062BAA8ULL, 0xFBE9141915D7A922ULL},
+	{0x6F773FC3603DB4A9ULL, 0x9D71AC8FADA6C9B5ULL},
+	{0xCB550FB4384D21D3ULL, 0xC4CE17B399107C22ULL},
+	{0x7E2A53A146606A48ULL, 0xF6019DA07F549B2BULL},
+	{0x2EDA7444CBFC426DULL, 0x99C102844F94E0FBULL},
+	{0xFA911155FEFB5308ULL, 0xC0314325637A1939ULL},
+	{0x793555AB7EBA27CAULL, 0xF03D93EEBC589F88ULL},
+	{0x4BC1558B2F3458DEULL, 0x96267C7535B763B5ULL},
+	{0x9EB1AAEDFB016F16ULL, 0xBBB01B9283253CA2ULL},
+	{0x465E15A979C1CADCULL, 0xEA9C227723EE8BCBULL},
+	{0x0BFACD89EC191EC9ULL, 0x92A1958A7675175FULL},
+	{0xCEF980EC671F667BULL, 0xB749FAED14125D36ULL},
+	{0x82B7E12780E7401AULL, 0xE51C79A85916F484ULL},
+	{0xD1B2ECB8B0908810ULL, 0x8F31CC0937AE58D2ULL},
+	{0x861FA7E6DCB4AA15ULL, 0xB2FE3F0B8599EF07ULL},
+	{0x67A791E093E1D49AULL, 0xDFBDCECE67006AC9ULL},
+	{0xE0C8BB2C5C6D24E0ULL, 0x8BD6A141006042BDULL},
+	{0x58FAE9F773886E18ULL, 0xAECC49914078536DULL},
+	{0xAF39A475506A899EULL, 0xDA7F5BF590966848ULL},
+	{0x6D8406C952429603ULL, 0x888F99797A5E012DULL},
+	{0xC8E5087BA6D33B83ULL, 0xAAB37FD7D8F58178ULL},
+	{0xFB1E4A9A90880A64ULL, 0xD5605FCDCF32E1D6ULL},
+	{0x5CF2EEA09A55067FULL, 0x855C3BE0A17FCD26ULL},
+	{0xF42FAA48C0EA481EULL, 0xA6B34AD8C9DFC06FULL},
+	{0xF13B94DAF124DA26ULL, 0xD0601D8EFC57B08BULL},
+	{0x76C53D08D6B70858ULL, 0x823C12795DB6CE57ULL},
+	{0x54768C4B0C64CA6EULL, 0xA2CB1717B52481EDULL},
+	{0xA9942F5DCF7DFD09ULL, 0xCB7DDCDDA26DA268ULL},
+	{0xD3F93B35435D7C4CULL, 0xFE5D54150B090B02ULL},
+	{0xC47BC5014A1A6DAFULL, 0x9EFA548D26E5A6E1ULL},
+	{0x359AB6419CA1091BULL, 0xC6B8E9B0709F109AULL},
+	{0xC30163D203C94B62ULL, 0xF867241C8CC6D4C0ULL},
+	{0x79E0DE63425DCF1DULL, 0x9B407691D7FC44F8ULL},
+	{0x985915FC12F542E4ULL, 0xC21094364DFB5636ULL},
+	{0x3E6F5B7B17B2939DULL, 0xF294B943E17A2BC4ULL},
+	{0xA705992CEECF9C42ULL, 0x979CF3CA6CEC5B5AULL},
+	{0x50C6FF782A838353ULL, 0xBD8430BD08277231ULL},
+	{0xA4F8BF5635246428ULL, 0xECE53CEC4A314EBDULL},
+	{0x871B7795E136BE99ULL, 0x940F4613AE5ED136ULL},
+	{0x28E2557B59846E3FULL, 0xB913179899F68584ULL},
+	{0x331AEADA2FE589CFULL, 0xE757DD7EC07426E5ULL},
+	{0x3FF0D2C85DEF7621ULL, 0x9096EA6F3848984FULL},
+	{0x0FED077A756B53A9ULL, 0xB4BCA50B065ABE63ULL},
+	{0xD3E8495912C62894ULL, 0xE1EBCE4DC7F16DFBULL},
+	{0x64712DD7ABBBD95CULL, 0x8D3360F09CF6E4BDULL},
+	{0xBD8D794D96AACFB3ULL, 0xB080392CC4349DECULL},
+	{0xECF0D7A0FC5583A0ULL, 0xDCA04777F541C567ULL},
+	{0xF41686C49DB57244ULL, 0x89E42CAAF9491B60ULL},
+	{0x311C2875C522CED5ULL, 0xAC5D37D5B79B6239ULL},
+	{0x7D633293366B828BULL, 0xD77485CB25823AC7ULL},
+	{0xAE5DFF9C02033197ULL, 0x86A8D39EF77164BCULL},
+	{0xD9F57F830283FDFCULL, 0xA8530886B54DBDEBULL},
+	{0xD072DF63C324FD7BULL, 0xD267CAA862A12D66ULL},
+	{0x4247CB9E59F71E6DULL, 0x8380DEA93DA4BC60ULL},
+	{0x52D9BE85F074E608ULL, 0xA46116538D0DEB78ULL},
+	{0x67902E276C921F8BULL, 0xCD795BE870516656ULL},
+	{0x00BA1CD8A3DB53B6ULL, 0x806BD9714632DFF6ULL},
+	{0x80E8A40ECCD228A4ULL, 0xA086CFCD97BF97F3ULL},
+	{0x6122CD128006B2CDULL, 0xC8A883C0FDAF7DF0ULL},
+	{0x796B805720085F81ULL, 0xFAD2A4B13D1B5D6CULL},
+	{0xCBE3303674053BB0ULL, 0x9CC3A6EEC6311A63ULL},
+	{0xBEDBFC4411068A9CULL, 0xC3F490AA77BD60FCULL},
+	{0xEE92FB5515482D44ULL, 0xF4F1B4D515ACB93BULL},
+	{0x751BDD152D4D1C4AULL, 0x991711052D8BF3C5ULL},
+	{0xD262D45A78A0635DULL, 0xBF5CD54678EEF0B6ULL},
+	{0x86FB897116C87C34ULL, 0xEF340A98172AACE4ULL},
+	{0xD45D35E6AE3D4DA0ULL, 0x9580869F0E7AAC0EULL},
+	{0x8974836059CCA109ULL, 0xBAE0A846D2195712ULL},
+	{0x2BD1A438703FC94BULL, 0xE998D258869FACD7ULL},
+	{0x7B6306A34627DDCFULL, 0x91FF83775423CC06ULL},
+	{0x1A3BC84C17B1D542ULL, 0xB67F6455292CBF08ULL},
+	{0x20CABA5F1D9E4A93ULL, 0xE41F3D6A7377EECAULL},
+	{0x547EB47B7282EE9CULL, 0x8E938662882AF53EULL},
+	{0xE99E619A4F23AA43ULL, 0xB23867FB2A35B28DULL},
+	{0x6405FA00E2EC94D4ULL, 0xDEC681F9F4C31F31ULL},
+	{0xDE83BC408DD3DD04ULL, 0x8B3C113C38F9F37EULL},
+	{0x9624AB50B148D445ULL, 0xAE0B158B4738705EULL},
+	{0x3BADD624DD9B0957ULL, 0xD98DDAEE19068C76ULL},
+	{0xE54CA5D70A80E5D6ULL, 0x87F8A8D4CFA417C9ULL},
+	{0x5E9FCF4CCD211F4CULL, 0xA9F6D30A038D1DBCULL},
+	{0x7647C3200069671FULL, 0xD47487CC8470652BULL},
+	{0x29ECD9F40041E073ULL, 0x84C8D4DFD2C63F3BULL},
+	{0xF468107100525890ULL, 0xA5FB0A17C777CF09ULL},
+	{0x7182148D4066EEB4ULL, 0xCF79CC9DB955C2CCULL},
+	{0xC6F14CD848405530ULL, 0x81AC1FE293D599BFULL},
+	{0xB8ADA00E5A506A7CULL, 0xA21727DB38CB002FULL},
+	{0xA6D90811F0E4851CULL, 0xCA9CF1D206FDC03BULL},
+	{0x908F4A166D1DA663ULL, 0xFD442E4688BD304AULL},
+	{0x9A598E4E043287FEULL, 0x9E4A9CEC15763E2EULL},
+	{0x40EFF1E1853F29FDULL, 0xC5DD44271AD3CDBAULL},
+	{0xD12BEE59E68EF47CULL, 0xF7549530E188C128ULL},
+	{0x82BB74F8301958CEULL, 0x9A94DD3E8CF578B9ULL},
+	{0xE36A52363C1FAF01ULL, 0xC13A148E3032D6E7ULL},
+	{0xDC44E6C3CB279AC1ULL, 0xF18899B1BC3F8CA1ULL},
+	{0x29AB103A5EF8C0B9ULL, 0x96F5600F15A7B7E5ULL},
+	{0x7415D448F6B6F0E7ULL, 0xBCB2B812DB11A5DEULL},
+	{0x111B495B3464AD21ULL, 0xEBDF661791D60F56ULL},
+	{0xCAB10DD900BEEC34ULL, 0x936B9FCEBB25C995ULL},
+	{0x3D5D514F40EEA742ULL, 0xB84687C269EF3BFBULL},
+	{0x0CB4A5A3112A5112ULL, 0xE65829B3046B0AFAULL},
+	{0x47F0E785EABA72ABULL, 0x8FF71A0FE2C2E6DCULL},
+	{0x59ED216765690F56ULL, 0xB3F4E093DB73A093ULL},
+	{0x306869C13EC3532CULL, 0xE0F218B8D25088B8ULL},
+	{0x1E414218C73A13FBULL, 0x8C974F7383725573ULL},
+	{0xE5D1929EF90898FAULL, 0xAFBD2350644EEACFULL},
+	{0xDF45F746B74ABF39ULL, 0xDBAC6C247D62A583ULL},
+	{0x6B8BBA8C328EB783ULL, 0x894BC396CE5DA772ULL},
+	{0x066EA92F3F326564ULL, 0xAB9EB47C81F5114FULL},
+	{0xC80A537B0EFEFEBDULL, 0xD686619BA27255A2ULL},
+	{0xBD06742CE95F5F36ULL, 0x8613FD0145877585ULL},
+	{0x2C48113823B73704ULL, 0xA798FC4196E952E7ULL},
+	{0xF75A15862CA504C5ULL, 0xD17F3B51FCA3A7A0ULL},
+	{0x9A984D73DBE722FBULL, 0x82EF85133DE648C4ULL},
+	{0xC13E60D0D2E0EBBAULL, 0xA3AB66580D5FDAF5ULL},
+	{0x318DF905079926A8ULL, 0xCC963FEE10B7D1B3ULL},
+	{0xFDF17746497F7052ULL, 0xFFBBCFE994E5C61FULL},
+	{0xFEB6EA8BEDEFA633ULL, 0x9FD561F1FD0F9BD3ULL},
+	{0xFE64A52EE96B8FC0ULL, 0xC7CABA6E7C5382C8ULL},
+	{0x3DFDCE7AA3C673B0ULL, 0xF9BD690A1B68637BULL},
+	{0x06BEA10CA65C084EULL, 0x9C1661A651213E2DULL},
+	{0x486E494FCFF30A62ULL, 0xC31BFA0FE5698DB8ULL},
+	{0x5A89DBA3C3EFCCFAULL, 0xF3E2F893DEC3F126ULL},
+	{0xF89629465A75E01CULL, 0x986DDB5C6B3A76B7ULL},
+	{0xF6BBB397F1135823ULL, 0xBE89523386091465ULL},
+	{0x746AA07DED582E2CULL, 0xEE2BA6C0678B597FULL},
+	{0xA8C2A44EB4571CDCULL, 0x94DB483840B717EFULL},
+	{0x92F34D62616CE413ULL, 0xBA121A4650E4DDEBULL},
+	{0x77B020BAF9C81D17ULL, 0xE896A0D7E51E1566ULL},
+	{0x0ACE1474DC1D122EULL, 0x915E2486EF32CD60ULL},
+	{0x0D819992132456BAULL, 0xB5B5ADA8AAFF80B8ULL},
+	{0x10E1FFF697ED6C69ULL, 0xE3231912D5BF60E6ULL},
+	{0xCA8D3FFA1EF463C1ULL, 0x8DF5EFABC5979C8FULL},
+	{0xBD308FF8A6B17CB2ULL, 0xB1736B96B6FD83B3ULL},
+	{0xAC7CB3F6D05DDBDEULL, 0xDDD0467C64BCE4A0ULL},
+	{0x6BCDF07A423AA96BULL, 0x8AA22C0DBEF60EE4ULL},
+	{0x86C16C98D2C953C6ULL, 0xAD4AB7112EB3929DULL},
+	{0xE871C7BF077BA8B7ULL, 0xD89D64D57A607744ULL},
+	{0x11471CD764AD4972ULL, 0x87625F056C7C4A8BULL},
+	{0xD598E40D3DD89BCFULL, 0xA93AF6C6C79B5D2DULL},
+	{0x4AFF1D108D4EC2C3ULL, 0xD389B47879823479ULL},
+	{0xCEDF722A585139BAULL, 0x843610CB4BF160CBULL},
+	{0xC2974EB4EE658828ULL, 0xA54394FE1EEDB8FEULL},
+	{0x733D226229FEEA32ULL, 0xCE947A3DA6A9273EULL},
+	{0x0806357D5A3F525FULL, 0x811CCC668829B887ULL},
+	{0xCA07C2DCB0CF26F7ULL, 0xA163FF802A3426A8ULL},
+	{0xFC89B393DD02F0B5ULL, 0xC9BCFF6034C13052ULL},
+	{0xBBAC2078D443ACE2ULL, 0xFC2C3F3841F17C67ULL},
+	{0xD54B944B84AA4C0DULL, 0x9D9BA7832936EDC0ULL},
+	{0x0A9E795E65D4DF11ULL, 0xC5029163F384A931ULL},
+	{0x4D4617B5FF4A16D5ULL, 0xF64335BCF065D37DULL},
+	{0x504BCED1BF8E4E45ULL, 0x99EA0196163FA42EULL},
+	{0xE45EC2862F71E1D6ULL, 0xC06481FB9BCF8D39ULL},
+	{0x5D767327BB4E5A4CULL, 0xF07DA27A82C37088ULL},
+	{0x3A6A07F8D510F86FULL, 0x964E858C91BA2655ULL},
+	{0x890489F70A55368BULL, 0xBBE226EFB628AFEAULL},
+	{0x2B45AC74CCEA842EULL, 0xEADAB0ABA3B2DBE5ULL},
+	{0x3B0B8BC90012929DULL, 0x92C8AE6B464FC96FULL},
+	{0x09CE6EBB40173744ULL, 0xB77ADA0617E3BBCBULL},
+	{0xCC420A6A101D0515ULL, 0xE55990879DDCAABDULL},
+	{0x9FA946824A12232DULL, 0x8F57FA54C2A9EAB6ULL},
+	{0x47939822DC96ABF9ULL, 0xB32DF8E9F3546564ULL},
+	{0x59787E2B93BC56F7ULL, 0xDFF9772470297EBDULL},
+	{0x57EB4EDB3C55B65AULL, 0x8BFBEA76C619EF36ULL},
+	{0xEDE622920B6B23F1ULL, 0xAEFAE51477A06B03ULL},
+	{0xE95FAB368E45ECEDULL, 0xDAB99E59958885C4ULL},
+	{0x11DBCB0218EBB414ULL, 0x88B402F7FD75539BULL},
+	{0xD652BDC29F26A119ULL, 0xAAE103B5FCD2A881ULL},
+	{0x4BE76D3346F0495FULL, 0xD59944A37C0752A2ULL},
+	{0x6F70A4400C562DDBULL, 0x857FCAE62D8493A5ULL},
+	{0xCB4CCD500F6BB952ULL, 0xA6DFBD9FB8E5B88EULL},
+	{0x7E2000A41346A7A7ULL, 0xD097AD07A71F26B2ULL},
+	{0x8ED400668C0C28C8ULL, 0x825ECC24C873782FULL},
+	{0x728900802F0F32FAULL, 0xA2F67F2DFA90563BULL},
+	{0x4F2B40A03AD2FFB9ULL, 0xCBB41EF979346BCAULL},
+	{0xE2F610C84987BFA8ULL, 0xFEA126B7D78186BCULL},
+	{0x0DD9CA7D2DF4D7C9ULL, 0x9F24B832E6B0F436ULL},
+	{0x91503D1C79720DBBULL, 0xC6EDE63FA05D3143ULL},
+	{0x75A44C6397CE912AULL, 0xF8A95FCF88747D94ULL},
+	{0xC986AFBE3EE11ABAULL, 0x9B69DBE1B548CE7CULL},
+	{0xFBE85BADCE996168ULL, 0xC24452DA229B021BULL},
+	{0xFAE27299423FB9C3ULL, 0xF2D56790AB41C2A2ULL},
+	{0xDCCD879FC967D41AULL, 0x97C560BA6B0919A5ULL},
+	{0x5400E987BBC1C920ULL, 0xBDB6B8E905CB600FULL},
+	{0x290123E9AAB23B68ULL, 0xED246723473E3813ULL},
+	{0xF9A0B6720AAF6521ULL, 0x9436C0760C86E30BULL},
+	{0xF808E40E8D5B3E69ULL, 0xB94470938FA89BCEULL},
+	{0xB60B1D1230B20E04ULL, 0xE7958CB87392C2C2ULL},
+	{0xB1C6F22B5E6F48C2ULL, 0x90BD77F3483BB9B9ULL},
+	{0x1E38AEB6360B1AF3ULL, 0xB4ECD5F01A4AA828ULL},
+	{0x25C6DA63C38DE1B0ULL, 0xE2280B6C20DD5232ULL},
+	{0x579C487E5A38AD0EULL, 0x8D590723948A535FULL},
+	{0x2D835A9DF0C6D851ULL, 0xB0AF48EC79ACE837ULL},
+	{0xF8E431456CF88E65ULL, 0xDCDB1B2798182244ULL},
+	{0x1B8E9ECB641B58FFULL, 0x8A08F0F8BF0F156BULL},
+	{0xE272467E3D222F3FULL, 0xAC8B2D36EED2DAC5ULL},
+	{0x5B0ED81DCC6ABB0FULL, 0xD7ADF884AA879177ULL},
+	{0x98E947129FC2B4E9ULL, 0x86CCBB52EA94BAEAULL},
+	{0x3F2398D747B36224ULL, 0xA87FEA27A539E9A5ULL},
+	{0x8EEC7F0D19A03AADULL, 0xD29FE4B18E88640EULL},
+	{0x1953CF68300424ACULL, 0x83A3EEEEF9153E89ULL},
+	{0x5FA8C3423C052DD7ULL, 0xA48CEAAAB75A8E2BULL},
+	{0x3792F412CB06794DULL, 0xCDB02555653131B6ULL},
+	{0xE2BBD88BBEE40BD0ULL, 0x808E17555F3EBF11ULL},
+	{0x5B6ACEAEAE9D0EC4ULL, 0xA0B19D2AB70E6ED6ULL},
+	{0xF245825A5A445275ULL, 0xC8DE047564D20A8BULL},
+	{0xEED6E2F0F0D56712ULL, 0xFB158592BE068D2EULL},
+	{0x55464DD69685606BULL, 0x9CED737BB6C4183DULL},
+	{0xAA97E14C3C26B886ULL, 0xC428D05AA4751E4CULL},
+	{0xD53DD99F4B3066A8ULL, 0xF53304714D9265DFULL},
+	{0xE546A8038EFE4029ULL, 0x993FE2C6D07B7FABULL},
+	{0xDE98520472BDD033ULL, 0xBF8FDB78849A5F96ULL},
+	{0x963E66858F6D4440ULL, 0xEF73D256A5C0F77CULL},
+	{0xDDE7001379A44AA8ULL, 0x95A8637627989AADULL},
+	{0x5560C018580D5D52ULL, 0xBB127C53B17EC159ULL},
+	{0xAAB8F01E6E10B4A6ULL, 0xE9D71B689DDE71AFULL},
+	{0xCAB3961304CA70E8ULL, 0x9226712162AB070DULL},
+	{0x3D607B97C5FD0D22ULL, 0xB6B00D69BB55C8D1ULL},
+	{0x8CB89A7DB77C506AULL, 0xE45C10C42A2B3B05ULL},
+	{0x77F3608E92ADB242ULL, 0x8EB98A7A9A5B04E3ULL},
+	{0x55F038B237591ED3ULL, 0xB267ED1940F1C61CULL},
+	{0x6B6C46DEC52F6688ULL, 0xDF01E85F912E37A3ULL},
+	{0x2323AC4B3B3DA015ULL, 0x8B61313BBABCE2C6ULL},
+	{0xABEC975E0A0D081AULL, 0xAE397D8AA96C1B77ULL},
+	{0x96E7BD358C904A21ULL, 0xD9C7DCED53C72255ULL},
+	{0x7E50D64177DA2E54ULL, 0x881CEA14545C7575ULL},
+	{0xDDE50BD1D5D0B9E9ULL, 0xAA242499697392D2ULL},
+	{0x955E4EC64B44E864ULL, 0xD4AD2DBFC3D07787ULL},
+	{0xBD5AF13BEF0B113EULL, 0x84EC3C97DA624AB4ULL},
+	{0xECB1AD8AEACDD58EULL, 0xA6274BBDD0FADD61ULL},
+	{0x67DE18EDA5814AF2ULL, 0xCFB11EAD453994BAULL},
+	{0x80EACF948770CED7ULL, 0x81CEB32C4B43FCF4ULL},
+	{0xA1258379A94D028DULL, 0xA2425FF75E14FC31ULL},
+	{0x096EE45813A04330ULL, 0xCAD2F7F5359A3B3EULL},
+	{0x8BCA9D6E188853FCULL, 0xFD87B5F28300CA0DULL},
+	{0x775EA264CF55347EULL, 0x9E74D1B791E07E48ULL},
+	{0x95364AFE032A819EULL, 0xC612062576589DDAULL},
+	{0x3A83DDBD83F52205ULL, 0xF79687AED3EEC551ULL},
+	{0xC4926A9672793543ULL, 0x9ABE14CD44753B52ULL},
+	{0x75B7053C0F178294ULL, 0xC16D9A0095928A27ULL},
+	{0x5324C68B12DD6339ULL, 0xF1C90080BAF72CB1ULL},
+	{0xD3F6FC16EBCA5E04ULL, 0x971DA05074DA7BEEULL},
+	{0x88F4BB1CA6BCF585ULL, 0xBCE5086492111AEAULL},
+	{0x2B31E9E3D06C32E6ULL, 0xEC1E4A7DB69561A5ULL},
+	{0x3AFF322E62439FD0ULL, 0x9392EE8E921D5D07ULL},
+	{0x09BEFEB9FAD487C3ULL, 0xB877AA3236A4B449ULL},
+	{0x4C2EBE687989A9B4ULL, 0xE69594BEC44DE15BULL},
+	{0x0F9D37014BF60A11ULL, 0x901D7CF73AB0ACD9ULL},
+	{0x538484C19EF38C95ULL, 0xB424DC35095CD80FULL},
+	{0x2865A5F206B06FBAULL, 0xE12E13424BB40E13ULL},
+	{0xF93F87B7442E45D4ULL, 0x8CBCCC096F5088CBULL},
+	{0xF78F69A51539D749ULL, 0xAFEBFF0BCB24AAFEULL},
+	{0xB573440E5A884D1CULL, 0xDBE6FECEBDEDD5BEULL},
+	{0x31680A88F8953031ULL, 0x89705F4136B4A597ULL},
+	{0xFDC20D2B36BA7C3EULL, 0xABCC77118461CEFCULL},
+	{0x3D32907604691B4DULL, 0xD6BF94D5E57A42BCULL},
+	{0xA63F9A49C2C1B110ULL, 0x8637BD05AF6C69B5ULL},
+	{0x0FCF80DC33721D54ULL, 0xA7C5AC471B478423ULL},
+	{0xD3C36113404EA4A9ULL, 0xD1B71758E219652BULL},
+	{0x645A1CAC083126EAULL, 0x83126E978D4FDF3BULL},
+	{0x3D70A3D70A3D70A4ULL, 0xA3D70A3D70A3D70AULL},
+	{0xCCCCCCCCCCCCCCCDULL, 0xCCCCCCCCCCCCCCCCULL},
+	{0x0000000000000000ULL, 0x8000000000000000ULL},
+	{0x0000000000000000ULL, 0xA000000000000000ULL},
+	{0x0000000000000000ULL, 0xC800000000000000ULL},
+	{0x0000000000000000ULL, 0xFA00000000000000ULL},
+	{0x0000000000000000ULL, 0x9C40000000000000ULL},
+	{0x0000000000000000ULL, 0xC350000000000000ULL},
+	{0x0000000000000000ULL, 0xF424000000000000ULL},
+	{0x0000000000000000ULL, 0x9896800000000000ULL},
+	{0x0000000000000000ULL, 0xBEBC200000000000ULL},
+	{0x0000000000000000ULL, 0xEE6B280000000000ULL},
+	{0x0000000000000000ULL, 0x9502F90000000000ULL},
+	{0x0000000000000000ULL, 0xBA43B74000000000ULL},
+	{0x0000000000000000ULL, 0xE8D4A51000000000ULL},
+	{0x0000000000000000ULL, 0x9184E72A00000000ULL},
+	{0x0000000000000000ULL, 0xB5E620F480000000ULL},
+	{0x0000000000000000ULL, 0xE35FA931A0000000ULL},
+	{0x0000000000000000ULL, 0x8E1BC9BF04000000ULL},
+	{0x0000000000000000ULL, 0xB1A2BC2EC5000000ULL},
+	{0x0000000000000000ULL, 0xDE0B6B3A76400000ULL},
+	{0x0000000000000000ULL, 0x8AC7230489E80000ULL},
+	{0x0000000000000000ULL, 0xAD78EBC5AC620000ULL},
+	{0x0000000000000000ULL, 0xD8D726B7177A8000ULL},
+	{0x0000000000000000ULL, 0x878678326EAC9000ULL},
+	{0x0000000000000000ULL, 0xA968163F0A57B400ULL},
+	{0x0000000000000000ULL, 0xD3C21BCECCEDA100ULL},
+	{0x0000000000000000ULL, 0x84595161401484A0ULL},
+	{0x0000000000000000ULL, 0xA56FA5B99019A5C8ULL},
+	{0x0000000000000000ULL, 0xCECB8F27F4200F3AULL},
+	{0x4000000000000000ULL, 0x813F3978F8940984ULL},
+	{0x5000000000000000ULL, 0xA18F07D736B90BE5ULL},
+	{0xA400000000000000ULL, 0xC9F2C9CD04674EDEULL},
+	{0x4D00000000000000ULL, 0xFC6F7C4045812296ULL},
+	{0xF020000000000000ULL, 0x9DC5ADA82B70B59DULL},
+	{0x6C28000000000000ULL, 0xC5371912364CE305ULL},
+	{0xC732000000000000ULL, 0xF684DF56C3E01BC6ULL},
+	{0x3C7F400000000000ULL, 0x9A130B963A6C115CULL},
+	{0x4B9F100000000000ULL, 0xC097CE7BC90715B3ULL},
+	{0x1E86D40000000000ULL, 0xF0BDC21ABB48DB20ULL},
+	{0x1314448000000000ULL, 0x96769950B50D88F4ULL},
+	{0x17D955A000000000ULL, 0xBC143FA4E250EB31ULL},
+	{0x5DCFAB0800000000ULL, 0xEB194F8E1AE525FDULL},
+	{0x5AA1CAE500000000ULL, 0x92EFD1B8D0CF37BEULL},
+	{0xF14A3D9E40000000ULL, 0xB7ABC627050305ADULL},
+	{0x6D9CCD05D0000000ULL, 0xE596B7B0C643C719ULL},
+	{0xE4820023A2000000ULL, 0x8F7E32CE7BEA5C6FULL},
+	{0xDDA2802C8A800000ULL, 0xB35DBF821AE4F38BULL},
+	{0xD50B2037AD200000ULL, 0xE0352F62A19E306EULL},
+	{0x4526F422CC340000ULL, 0x8C213D9DA502DE45ULL},
+	{0x9670B12B7F410000ULL, 0xAF298D050E4395D6ULL},
+	{0x3C0CDD765F114000ULL, 0xDAF3F04651D47B4CULL},
+	{0xA5880A69FB6AC800ULL, 0x88D8762BF324CD0FULL},
+	{0x8EEA0D047A457A00ULL, 0xAB0E93B6EFEE0053ULL},
+	{0x72A4904598D6D880ULL, 0xD5D238A4ABE98068ULL},
+	{0x47A6DA2B7F864750ULL, 0x85A36366EB71F041ULL},
+	{0x999090B65F67D924ULL, 0xA70C3C40A64E6C51ULL},
+	{0xFFF4B4E3F741CF6DULL, 0xD0CF4B50CFE20765ULL},
+	{0xBFF8F10E7A8921A4ULL, 0x82818F1281ED449FULL},
+	{0xAFF72D52192B6A0DULL, 0xA321F2D7226895C7ULL},
+	{0x9BF4F8A69F764490ULL, 0xCBEA6F8CEB02BB39ULL},
+	{0x02F236D04753D5B4ULL, 0xFEE50B7025C36A08ULL},
+	{0x01D762422C946590ULL, 0x9F4F2726179A2245ULL},
+	{0x424D3AD2B7B97EF5ULL, 0xC722F0EF9D80AAD6ULL},
+	{0xD2E0898765A7DEB2ULL, 0xF8EBAD2B84E0D58BULL},
+	{0x63CC55F49F88EB2FULL, 0x9B934C3B330C8577ULL},
+	{0x3CBF6B71C76B25FBULL, 0xC2781F49FFCFA6D5ULL},
+	{0x8BEF464E3945EF7AULL, 0xF316271C7FC3908AULL},
+	{0x97758BF0E3CBB5ACULL, 0x97EDD871CFDA3A56ULL},
+	{0x3D52EEED1CBEA317ULL, 0xBDE94E8E43D0C8ECULL},
+	{0x4CA7AAA863EE4BDDULL, 0xED63A231D4C4FB27ULL},
+	{0x8FE8CAA93E74EF6AULL, 0x945E455F24FB1CF8ULL},
+	{0xB3E2FD538E122B44ULL, 0xB975D6B6EE39E436ULL},
+	{0x60DBBCA87196B616ULL, 0xE7D34C64A9C85D44ULL},
+	{0xBC8955E946FE31CDULL, 0x90E40FBEEA1D3A4AULL},
+	{0x6BABAB6398BDBE41ULL, 0xB51D13AEA4A488DDULL},
+	{0xC696963C7EED2DD1ULL, 0xE264589A4DCDAB14ULL},
+	{0xFC1E1DE5CF543CA2ULL, 0x8D7EB76070A08AECULL},
+	{0x3B25A55F43294BCBULL, 0xB0DE65388CC8ADA8ULL},
+	{0x49EF0EB713F39EBEULL, 0xDD15FE86AFFAD912ULL},
+	{0x6E3569326C784337ULL, 0x8A2DBF142DFCC7ABULL},
+	{0x49C2C37F07965404ULL, 0xACB92ED9397BF996ULL},
+	{0xDC33745EC97BE906ULL, 0xD7E77A8F87DAF7FBULL},
+	{0x69A028BB3DED71A3ULL, 0x86F0AC99B4E8DAFDULL},
+	{0xC40832EA0D68CE0CULL, 0xA8ACD7C0222311BCULL},
+	{0xF50A3FA490C30190ULL, 0xD2D80DB02AABD62BULL},
+	{0x792667C6DA79E0FAULL, 0x83C7088E1AAB65DBULL},
+	{0x577001B891185938ULL, 0xA4B8CAB1A1563F52ULL},
+	{0xED4C0226B55E6F86ULL, 0xCDE6FD5E09ABCF26ULL},
+	{0x544F8158315B05B4ULL, 0x80B05E5AC60B6178ULL},
+	{0x696361AE3DB1C721ULL, 0xA0DC75F1778E39D6ULL},
+	{0x03BC3A19CD1E38E9ULL, 0xC913936DD571C84CULL},
+	{0x04AB48A04065C723ULL, 0xFB5878494ACE3A5FULL},
+	{0x62EB0D64283F9C76ULL, 0x9D174B2DCEC0E47BULL},
+	{0x3BA5D0BD324F8394ULL, 0xC45D1DF942711D9AULL},
+	{0xCA8F44EC7EE36479ULL, 0xF5746577930D6500ULL},
+	{0x7E998B13CF4E1ECBULL, 0x9968BF6ABBE85F20ULL},
+	{0x9E3FEDD8C321A67EULL, 0xBFC2EF456AE276E8ULL},
+	{0xC5CFE94EF3EA101EULL, 0xEFB3AB16C59B14A2ULL},
+	{0xBBA1F1D158724A12ULL, 0x95D04AEE3B80ECE5ULL},
+	{0x2A8A6E45AE8EDC97ULL, 0xBB445DA9CA61281FULL},
+	{0xF52D09D71A3293BDULL, 0xEA1575143CF97226ULL},
+	{0x593C2626705F9C56ULL, 0x924D692CA61BE758ULL},
+	{0x6F8B2FB00C77836CULL, 0xB6E0C377CFA2E12EULL},
+	{0x0B6DFB9C0F956447ULL, 0xE498F455C38B997AULL},
+	{0x4724BD4189BD5EACULL, 0x8EDF98B59A373FECULL},
+	{0x58EDEC91EC2CB657ULL, 0xB2977EE300C50FE7ULL},
+	{0x2F2967B66737E3EDULL, 0xDF3D5E9BC0F653E1ULL},
+	{0xBD79E0D20082EE74ULL, 0x8B865B215899F46CULL},
+	{0xECD8590680A3AA11ULL, 0xAE67F1E9AEC07187ULL},
+	{0xE80E6F4820CC9495ULL, 0xDA01EE641A708DE9ULL},
+	{0x3109058D147FDCDDULL, 0x884134FE908658B2ULL},
+	{0xBD4B46F0599FD415ULL, 0xAA51823E34A7EEDEULL},
+	{0x6C9E18AC7007C91AULL, 0xD4E5E2CDC1D1EA96ULL},
+	{0x03E2CF6BC604DDB0ULL, 0x850FADC09923329EULL},
+	{0x84DB8346B786151CULL, 0xA6539930BF6BFF45ULL},
+	{0xE612641865679A63ULL, 0xCFE87F7CEF46FF16ULL},
+	{0x4FCB7E8F3F60C07EULL, 0x81F14FAE158C5F6EULL},
+	{0xE3BE5E330F38F09DULL, 0xA26DA3999AEF7749ULL},
+	{0x5CADF5BFD3072CC5ULL, 0xCB090C8001AB551CULL},
+	{0x73D9732FC7C8F7F6ULL, 0xFDCB4FA002162A63ULL},
+	{0x2867E7FDDCDD9AFAULL, 0x9E9F11C4014DDA7EULL},
+	{0xB281E1FD541501B8ULL, 0xC646D63501A1511DULL},
+	{0x1F225A7CA91A4226ULL, 0xF7D88BC24209A565ULL},
+	{0x3375788DE9B06958ULL, 0x9AE757596946075FULL},
+	{0x0052D6B1641C83AEULL, 0xC1A12D2FC3978937ULL},
+	{0xC0678C5DBD23A49AULL, 0xF209787BB47D6B84ULL},
+	{0xF840B7BA963646E0ULL, 0x9745EB4D50CE6332ULL},
+	{0xB650E5A93BC3D898ULL, 0xBD176620A501FBFFULL},
+	{0xA3E51F138AB4CEBEULL, 0xEC5D3FA8CE427AFFULL},
+	{0xC66F336C36B10137ULL, 0x93BA47C980E98CDFULL},
+	{0xB80B0047445D4184ULL, 0xB8A8D9BBE123F017ULL},
+	{0xA60DC059157491E5ULL, 0xE6D3102AD96CEC1DULL},
+	{0x87C89837AD68DB2FULL, 0x9043EA1AC7E41392ULL},
+	{0x29BABE4598C311FBULL, 0xB454E4A179DD1877ULL},
+	{0xF4296DD6FEF3D67AULL, 0xE16A1DC9D8545E94ULL},
+	{0x1899E4A65F58660CULL, 0x8CE2529E2734BB1DULL},
+	{0x5EC05DCFF72E7F8FULL, 0xB01AE745B101E9E4ULL},
+	{0x76707543F4FA1F73ULL, 0xDC21A1171D42645DULL},
+	{0x6A06494A791C53A8ULL, 0x899504AE72497EBAULL},
+	{0x0487DB9D17636892ULL, 0xABFA45DA0EDBDE69ULL},
+	{0x45A9D2845D3C42B6ULL, 0xD6F8D7509292D603ULL},
+	{0x0B8A2392BA45A9B2ULL, 0x865B86925B9BC5C2ULL},
+	{0x8E6CAC7768D7141EULL, 0xA7F26836F282B732ULL},
+	{0x3207D795430CD926ULL, 0xD1EF0244AF2364FFULL},
+	{0x7F44E6BD49E807B8ULL, 0x8335616AED761F1FULL},
+	{0x5F16206C9C6209A6ULL, 0xA402B9C5A8D3A6E7ULL},
+	{0x36DBA887C37A8C0FULL, 0xCD036837130890A1ULL},
+	{0xC2494954DA2C9789ULL, 0x802221226BE55A64ULL},
+	{0xF2DB9BAA10B7BD6CULL, 0xA02AA96B06DEB0FDULL},
+	{0x6F92829494E5ACC7ULL, 0xC83553C5C8965D3DULL},
+	{0xCB772339BA1F17F9ULL, 0xFA42A8B73ABBF48CULL},
+	{0xFF2A760414536EFBULL, 0x9C69A97284B578D7ULL},
+	{0xFEF5138519684ABAULL, 0xC38413CF25E2D70DULL},
+	{0x7EB258665FC25D69ULL, 0xF46518C2EF5B8CD1ULL},
+	{0xEF2F773FFBD97A61ULL, 0x98BF2F79D5993802ULL},
+	{0xAAFB550FFACFD8FAULL, 0xBEEEFB584AFF8603ULL},
+	{0x95BA2A53F983CF38ULL, 0xEEAABA2E5DBF6784ULL},
+	{0xDD945A747BF26183ULL, 0x952AB45CFA97A0B2ULL},
+	{0x94F971119AEEF9E4ULL, 0xBA756174393D88DFULL},
+	{0x7A37CD5601AAB85DULL, 0xE912B9D1478CEB17ULL},
+	{0xAC62E055C10AB33AULL, 0x91ABB422CCB812EEULL},
+	{0x577B986B314D6009ULL, 0xB616A12B7FE617AAULL},
+	{0xED5A7E85FDA0B80BULL, 0xE39C49765FDF9D94ULL},
+	{0x14588F13BE847307ULL, 0x8E41ADE9FBEBC27DULL},
+	{0x596EB2D8AE258FC8ULL, 0xB1D219647AE6B31CULL},
+	{0x6FCA5F8ED9AEF3BBULL, 0xDE469FBD99A05FE3ULL},
+	{0x25DE7BB9480D5854ULL, 0x8AEC23D680043BEEULL},
+	{0xAF561AA79A10AE6AULL, 0xADA72CCC20054AE9ULL},
+	{0x1B2BA1518094DA04ULL, 0xD910F7FF28069DA4ULL},
+	{0x90FB44D2F05D0842ULL, 0x87AA9AFF79042286ULL},
+	{0x353A1607AC744A53ULL, 0xA99541BF57452B28ULL},
+	{0x42889B8997915CE8ULL, 0xD3FA922F2D1675F2ULL},
+	{0x69956135FEBADA11ULL, 0x847C9B5D7C2E09B7ULL},
+	{0x43FAB9837E699095ULL, 0xA59BC234DB398C25ULL},
+	{0x94F967E45E03F4BBULL, 0xCF02B2C21207EF2EULL},
+	{0x1D1BE0EEBAC278F5ULL, 0x8161AFB94B44F57DULL},
+	{0x6462D92A69731732ULL, 0xA1BA1BA79E1632DCULL},
+	{0x7D7B8F7503CFDCFEULL, 0xCA28A291859BBF93ULL},
+	{0x5CDA735244C3D43EULL, 0xFCB2CB35E702AF78ULL},
+	{0x3A0888136AFA64A7ULL, 0x9DEFBF01B061ADABULL},
+	{0x088AAA1845B8FDD0ULL, 0xC56BAEC21C7A1916ULL},
+	{0x8AAD549E57273D45ULL, 0xF6C69A72A3989F5BULL},
+	{0x36AC54E2F678864BULL, 0x9A3C2087A63F6399ULL},
+	{0x84576A1BB416A7DDULL, 0xC0CB28A98FCF3C7FULL},
+	{0x656D44A2A11C51D5ULL, 0xF0FDF2D3F3C30B9FULL},
+	{0x9F644AE5A4B1B325ULL, 0x969EB7C47859E743ULL},
+	{0x873D5D9F0DDE1FEEULL, 0xBC4665B596706114ULL},
+	{0xA90CB506D155A7EAULL, 0xEB57FF22FC0C7959ULL},
+	{0x09A7F12442D588F2ULL, 0x9316FF75DD87CBD8ULL},
+	{0x0C11ED6D538AEB2FULL, 0xB7DCBF5354E9BECEULL},
+	{0x8F1668C8A86DA5FAULL, 0xE5D3EF282A242E81ULL},
+	{0xF96E017D694487BCULL, 0x8FA475791A569D10ULL},
+	{0x37C981DCC395A9ACULL, 0xB38D92D760EC4455ULL},
+	{0x85BBE253F47B1417ULL, 0xE070F78D3927556AULL},
+	{0x93956D7478CCEC8EULL, 0x8C469AB843B89562ULL},
+	{0x387AC8D1970027B2ULL, 0xAF58416654A6BABBULL},
+	{0x06997B05FCC0319EULL, 0xDB2E51BFE9D0696AULL},
+	{0x441FECE3BDF81F03ULL, 0x88FCF317F22241E2ULL},
+	{0xD527E81CAD7626C3ULL, 0xAB3C2FDDEEAAD25AULL},
+	{0x8A71E223D8D3B074ULL, 0xD60B3BD56A5586F1ULL},
+	{0xF6872D5667844E49ULL, 0x85C7056562757456ULL},
+	{0xB428F8AC016561DBULL, 0xA738C6BEBB12D16CULL},
+	{0xE13336D701BEBA52ULL, 0xD106F86E69D785C7ULL},
+	{0xECC0024661173473ULL, 0x82A45B450226B39CULL},
+	{0x27F002D7F95D0190ULL, 0xA34D721642B06084ULL},
+	{0x31EC038DF7B441F4ULL, 0xCC20CE9BD35C78A5ULL},
+	{0x7E67047175A15271ULL, 0xFF290242C83396CEULL},
+	{0x0F0062C6E984D386ULL, 0x9F79A169BD203E41ULL},
+	{0x52C07B78A3E60868ULL, 0xC75809C42C684DD1ULL},
+	{0xA7709A56CCDF8A82ULL, 0xF92E0C3537826145ULL},
+	{0x88A66076400BB691ULL, 0x9BBCC7A142B17CCBULL},
+	{0x6ACFF893D00EA435ULL, 0xC2ABF989935DDBFEULL},
+	{0x0583F6B8C4124D43ULL, 0xF356F7EBF83552FEULL},
+	{0xC3727A337A8B704AULL, 0x98165AF37B2153DEULL},
+	{0x744F18C0592E4C5CULL, 0xBE1BF1B059E9A8D6ULL},
+	{0x1162DEF06F79DF73ULL, 0xEDA2EE1C7064130CULL},
+	{0x8ADDCB5645AC2BA8ULL, 0x9485D4D1C63E8BE7ULL},
+	{0x6D953E2BD7173692ULL, 0xB9A74A0637CE2EE1ULL},
+	{0xC8FA8DB6CCDD0437ULL, 0xE8111C87C5C1BA99ULL},
+	{0x1D9C9892400A22A2ULL, 0x910AB1D4DB9914A0ULL},
+	{0x2503BEB6D00CAB4BULL, 0xB54D5E4A127F59C8ULL},
+	{0x2E44AE64840FD61DULL, 0xE2A0B5DC971F303AULL},
+	{0x5CEAECFED289E5D2ULL, 0x8DA471A9DE737E24ULL},
+	{0x7425A83E872C5F47ULL, 0xB10D8E1456105DADULL},
+	{0xD12F124E28F77719ULL, 0xDD50F1996B947518ULL},
+	{0x82BD6B70D99AAA6FULL, 0x8A5296FFE33CC92FULL},
+	{0x636CC64D1001550BULL, 0xACE73CBFDC0BFB7BULL},
+	{0x3C47F7E05401AA4EULL, 0xD8210BEFD30EFA5AULL},
+	{0x65ACFAEC34810A71ULL, 0x8714A775E3E95C78ULL},
+	{0x7F1839A741A14D0DULL, 0xA8D9D1535CE3B396ULL},
+	{0x1EDE48111209A050ULL, 0xD31045A8341CA07CULL},
+	{0x934AED0AAB460432ULL, 0x83EA2B892091E44DULL},
+	{0xF81DA84D5617853FULL, 0xA4E4B66B68B65D60ULL},
+	{0x36251260AB9D668EULL, 0xCE1DE40642E3F4B9ULL},
+	{0xC1D72B7C6B426019ULL, 0x80D2AE83E9CE78F3ULL},
+	{0xB24CF65B8612F81FULL, 0xA1075A24E4421730ULL},
+	{0xDEE033F26797B627ULL, 0xC94930AE1D529CFCULL},
+	{0x169840EF017DA3B1ULL, 0xFB9B7CD9A4A7443CULL},
+	{0x8E1F289560EE864EULL, 0x9D412E0806E88AA5ULL},
+	{0xF1A6F2BAB92A27E2ULL, 0xC491798A08A2AD4EULL},
+	{0xAE10AF696774B1DBULL, 0xF5B5D7EC8ACB58A2ULL},
+	{0xACCA6DA1E0A8EF29ULL, 0x9991A6F3D6BF1765ULL},
+	{0x17FD090A58D32AF3ULL, 0xBFF610B0CC6EDD3FULL},
+	{0xDDFC4B4CEF07F5B0ULL, 0xEFF394DCFF8A948EULL},
+	{0x4ABDAF101564F98EULL, 0x95F83D0A1FB69CD9ULL},
+	{0x9D6D1AD41ABE37F1ULL, 0xBB764C4CA7A4440FULL},
+	{0x84C86189216DC5EDULL, 0xEA53DF5FD18D5513ULL},
+	{0x32FD3CF5B4E49BB4ULL, 0x92746B9BE2F8552CULL},
+	{0x3FBC8C33221DC2A1ULL, 0xB7118682DBB66A77ULL},
+	{0x0FABAF3FEAA5334AULL, 0xE4D5E82392A40515ULL},
+	{0x29CB4D87F2A7400EULL, 0x8F05B1163BA6832DULL},
+	{0x743E20E9EF511012ULL, 0xB2C71D5BCA9023F8ULL},
+	{0x914DA9246B255416ULL, 0xDF78E4B2BD342CF6ULL},
+	{0x1AD089B6C2F7548EULL, 0x8BAB8EEFB6409C1AULL},
+	{0xA184AC2473B529B1ULL, 0xAE9672ABA3D0C320ULL},
+	{0xC9E5D72D90A2741EULL, 0xDA3C0F568CC4F3E8ULL},
+	{0x7E2FA67C7A658892ULL, 0x8865899617FB1871ULL},
+	{0xDDBB901B98FEEAB7ULL, 0xAA7EEBFB9DF9DE8DULL},
+	{0x552A74227F3EA565ULL, 0xD51EA6FA85785631ULL},
+	{0xD53A88958F87275FULL, 0x8533285C936B35DEULL},
+	{0x8A892ABAF368F137ULL, 0xA67FF273B8460356ULL},
+	{0x2D2B7569B0432D85ULL, 0xD01FEF10A657842CULL},
+	{0x9C3B29620E29FC73ULL, 0x8213F56A67F6B29BULL},
+	{0x8349F3BA91B47B8FULL, 0xA298F2C501F45F42ULL},
+	{0x241C70A936219A73ULL, 0xCB3F2F7642717713ULL},
+	{0xED238CD383AA0110ULL, 0xFE0EFB53D30DD4D7ULL},
+	{0xF4363804324A40AAULL, 0x9EC95D1463E8A506ULL},
+	{0xB143C6053EDCD0D5ULL, 0xC67BB4597CE2CE48ULL},
+	{0xDD94B7868E94050AULL, 0xF81AA16FDC1B81DAULL},
+	{0xCA7CF2B4191C8326ULL, 0x9B10A4E5E9913128ULL},
+	{0xFD1C2F611F63A3F0ULL, 0xC1D4CE1F63F57D72ULL},
+	{0xBC633B39673C8CECULL, 0xF24A01A73CF2DCCFULL},
+	{0xD5BE0503E085D813ULL, 0x976E41088617CA01ULL},
+	{0x4B2D8644D8A74E18ULL, 0xBD49D14AA79DBC82ULL},
+	{0xDDF8E7D60ED1219EULL, 0xEC9C459D51852BA2ULL},
+	{0xCABB90E5C942B503ULL, 0x93E1AB8252F33B45ULL},
+	{0x3D6A751F3B936243ULL, 0xB8DA1662E7B00A17ULL},
+	{0x0CC512670A783AD4ULL, 0xE7109BFBA19C0C9DULL},
+	{0x27FB2B80668B24C5ULL, 0x906A617D450187E2ULL},
+	{0xB1F9F660802DEDF6ULL, 0xB484F9DC9641E9DAULL},
+	{0x5E7873F8A0396973ULL, 0xE1A63853BBD26451ULL},
+	{0xDB0B487B6423E1E8ULL, 0x8D07E33455637EB2ULL},
+	{0x91CE1A9A3D2CDA62ULL, 0xB049DC016ABC5E5FULL},
+	{0x7641A140CC7810FBULL, 0xDC5C5301C56B75F7ULL},
+	{0xA9E904C87FCB0A9DULL, 0x89B9B3E11B6329BAULL},
+	{0x546345FA9FBDCD44ULL, 0xAC2820D9623BF429ULL},
+	{0xA97C177947AD4095ULL, 0xD732290FBACAF133ULL},
+	{0x49ED8EABCCCC485DULL, 0x867F59A9D4BED6C0ULL},
+	{0x5C68F256BFFF5A74ULL, 0xA81F301449EE8C70ULL},
+	{0x73832EEC6FFF3111ULL, 0xD226FC195C6A2F8CULL},
+	{0xC831FD53C5FF7EABULL, 0x83585D8FD9C25DB7ULL},
+	{0xBA3E7CA8B77F5E55ULL, 0xA42E74F3D032F525ULL},
+	{0x28CE1BD2E55F35EBULL, 0xCD3A1230C43FB26FULL},
+	{0x7980D163CF5B81B3ULL, 0x80444B5E7AA7CF85ULL},
+	{0xD7E105BCC332621FULL, 0xA0555E361951C366ULL},
+	{0x8DD9472BF3FEFAA7ULL, 0xC86AB5C39FA63440ULL},
+	{0xB14F98F6F0FEB951ULL, 0xFA856334878FC150ULL},
+	{0x6ED1BF9A569F33D3ULL, 0x9C935E00D4B9D8D2ULL},
+	{0x0A862F80EC4700C8ULL, 0xC3B8358109E84F07ULL},
+	{0xCD27BB612758C0FAULL, 0xF4A642E14C6262C8ULL},
+	{0x8038D51CB897789CULL, 0x98E7E9CCCFBD7DBDULL},
+	{0xE0470A63E6BD56C3ULL, 0xBF21E44003ACDD2CULL},
+	{0x1858CCFCE06CAC74ULL, 0xEEEA5D5004981478ULL},
+	{0x0F37801E0C43EBC8ULL, 0x95527A5202DF0CCBULL},
+	{0xD30560258F54E6BAULL, 0xBAA718E68396CFFDULL},
+	{0x47C6B82EF32A2069ULL, 0xE950DF20247C83FDULL},
+	{0x4CDC331D57FA5441ULL, 0x91D28B7416CDD27EULL},
+	{0xE0133FE4ADF8E952ULL, 0xB6472E511C81471DULL},
+	{0x58180FDDD97723A6ULL, 0xE3D8F9E563A198E5ULL},
+	{0x570F09EAA7EA7648ULL, 0x8E679C2F5E44FF8FULL},
+};
+
+// Exactly representable powers of 10 for the fast paths
+static const double g_Power10Double[23] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6,
+	1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+	1e20, 1e21, 1e22};
+static const float g_Power10Float[11] = {
+	1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+// Description of a binary floating point format
+struct FloatFormat_t {
+	uint32_t m_uMantissaBits;     // Explicit mantissa bits
+	int32_t m_iMinimumExponent;   // Negative of the exponent bias
+	int32_t m_iInfinityExponent;  // Biased exponent of infinity
+	int32_t m_iSmallestPower10;   // Smaller powers of 10 are always zero
+	int32_t m_iLargestPower10;    // Larger powers of 10 are always infinity
+	int32_t m_iMinRoundEven;      // Powers of 10 where a product can be an
+	int32_t m_iMaxRoundEven;      // exact tie between two values
+};
+
+static const FloatFormat_t g_DoubleFormat = {
+	52, -1023, 0x7FF, -342, 308, -4, 23};
+static const FloatFormat_t g_FloatFormat = {23, -127, 0xFF, -64, 38, -17, 10};
+
+// Number of decimal digits the fallback can hold, enough for any halfway
+// point between two doubles
+static const uint32_t kShifterDigits = 800;
+
+// Largest shift that can't overflow a 64 bit accumulator
+static const uint32_t kMaxShift = 60;
+
+// Big decimal number for the slow path, value is 0.Digits * 10^DecimalPoint
+struct DecimalShifter_t {
+	uint32_t m_uCount;       // Number of digits
+	int32_t m_iDecimalPoint; // Position of the decimal point
+	uint_t m_bTruncated;     // TRUE if non-zero digits were discarded
+	uint8_t m_Digits[kShifterDigits]; // Digits 0-9, not ASCII
+};
+
+#endif
+
+/***************************************
+
+	Return the number of leading zero bits in a non-zero 64 bit integer
+
+***************************************/
+
+static BURGER_INLINE uint32_t CountLeadingZeros(
+	uint64_t uInput) BURGER_NOEXCEPT
+{
+#if defined(BURGER_GNUC) || defined(BURGER_CLANG)
+	return static_cast<uint32_t>(__builtin_clzll(uInput));
+#else
+	uint32_t uResult = 0;
+	if (!(uInput & 0xFFFFFFFF00000000ULL)) {
+		uResult = 32;
+		uInput <<= 32U;
+	}
+	if (!(uInput & 0xFFFF000000000000ULL)) {
+		uResult += 16;
+		uInput <<= 16U;
+	}
+	if (!(uInput & 0xFF00000000000000ULL)) {
+		uResult += 8;
+		uInput <<= 8U;
+	}
+	if (!(uInput & 0xF000000000000000ULL)) {
+		uResult += 4;
+		uInput <<= 4U;
+	}
+	if (!(uInput & 0xC000000000000000ULL)) {
+		uResult += 2;
+		uInput <<= 2U;
+	}
+	if (!(uInput & 0x8000000000000000ULL)) {
+		++uResult;
+	}
+	return uResult;
+#endif
+}
+
+/***************************************
+
+	Eisel-Lemire algorithm, convert uMantissa * 10^iPower10 into the bits of
+	a positive floating point number with round to nearest even.
+
+	A single 64x128 bit multiply by a truncated power of 5 is enough to get
+	the correctly rounded result for any mantissa of 19 digits or less, as
+	proven by Noble Mushtak and Daniel Lemire in "Fast Number Parsing Without
+	Fallback".
+
+***************************************/
+
+static uint64_t EiselLemire(uint64_t uMantissa, int32_t iPower10,
+	const FloatFormat_t* pFormat) BURGER_NOEXCEPT
+{
+	const uint32_t uMantissaBits = pFormat->m_uMantissaBits;
+	if (!uMantissa || (iPower10 < pFormat->m_iSmallestPower10)) {
+		return 0;
+	}
+	if (iPower10 > pFormat->m_iLargestPower10) {
+		return static_cast<uint64_t>(pFormat->m_iInfinityExponent)
+			<< uMantissaBits;
+	}
+
+	// Normalize so the highest bit is set
+	const uint32_t uLeadingZeros = CountLeadingZeros(uMantissa);
+	uMantissa <<= uLeadingZeros;
+
+	// Only the upper 64 bits of the power of 5 are needed, unless the bits
+	// below the mantissa are all ones and a carry from the low half could
+	// change them
+	const uint64_t* pPower = g_Pow5Table128[iPower10 + 342];
+	uint64_t uHigh;
+	uint64_t uLow = Multiply128(uMantissa, pPower[1], &uHigh);
+	const uint64_t uPrecisionMask = UINT64_MAX >> (uMantissaBits + 3U);
+	if ((uHigh & uPrecisionMask) == uPrecisionMask) {
+		uint64_t uHigh2;
+		Multiply128(uMantissa, pPower[0], &uHigh2);
+		uLow += uHigh2;
+		uHigh += (uLow < uHigh2);
+	}
+
+	// Keep the mantissa plus 2 extra bits for rounding
+	const uint32_t uUpperBit = static_cast<uint32_t>(uHigh >> 63U);
+	const uint32_t uShift = uUpperBit + 64U - uMantissaBits - 3U;
+	uint64_t uResult = uHigh >> uShift;
+
+	// floor(log2(10^iPower10)) + 63, biased
+	int32_t iPower2 = (((152170 + 65536) * iPower10) >> 16) + 63 +
+		static_cast<int32_t>(uUpperBit) - static_cast<int32_t>(uLeadingZeros) -
+		pFormat->m_iMinimumExponent;
+
+	// Subnormal?
+	if (iPower2 <= 0) {
+		if ((1 - iPower2) >= 64) {
+			return 0;
+		}
+		uResult >>= static_cast<uint32_t>(1 - iPower2);
+		uResult += (uResult & 1U);
+		uResult >>= 1U;
+
+		// Rounding up may have created the smallest normal number, in which
+		// case the implied bit becomes the exponent
+		return uResult;
+	}
+
+	// If the product is exact and lands exactly between two values, the
+	// rounding bit is set and must round to even
+	if ((uLow <= 1U) && (iPower10 >= pFormat->m_iMinRoundEven) &&
+		(iPower10 <= pFormat->m_iMaxRoundEven) && ((uResult & 3U) == 1U) &&
+		((uResult << uShift) == uHigh)) {
+		uResult &= ~static_cast<uint64_t>(1U);
+	}
+	uResult += (uResult & 1U);
+	uResult >>= 1U;
+
+	// Did the rounding overflow into the next power of 2?
+	if (uResult >= (2ULL << uMantissaBits)) {
+		uResult = 1ULL << uMantissaBits;
+		++iPower2;
+	}
+	if (iPower2 >= pFormat->m_iInfinityExponent) {
+		return static_cast<uint64_t>(pFormat->m_iInfinityExponent)
+			<< uMantissaBits;
+	}
+	return (uResult & ((1ULL << uMantissaBits) - 1U)) |
+		(static_cast<uint64_t>(iPower2) << uMantissaBits);
+}
+
+/***************************************
+
+	Remove trailing zeros from a big decimal
+
+***************************************/
+
+static void TrimShifter(DecimalShifter_t* pShifter) BURGER_NOEXCEPT
+{
+	uint32_t uCount = pShifter->m_uCount;
+	while (uCount && !pShifter->m_Digits[uCount - 1]) {
+		--uCount;
+	}
+	pShifter->m_uCount = uCount;
+	if (!uCount) {
+		pShifter->m_iDecimalPoint = 0;
+	}
+}
+
+/***************************************
+
+	Multiply a big decimal by 2^uShift, uShift is 1 to kMaxShift
+
+***************************************/
+
+static void ShiftLeft(
+	DecimalShifter_t* pShifter, uint32_t uShift) BURGER_NOEXCEPT
+{
+	// ceil(uShift * log10(2)) is the most digits that can be created
+	const uint32_t uNewDigits = ((uShift * 1233U) >> 12U) + 1U;
+	uint32_t uRead = pShifter->m_uCount;
+	uint32_t uWrite = uRead + uNewDigits;
+	const uint32_t uEnd =
+		(uWrite < kShifterDigits) ? uWrite : kShifterDigits;
+
+	// Multiply from the last digit to the first
+	uint64_t uAccumulator = 0;
+	do {
+		if (uRead) {
+			--uRead;
+			uAccumulator +=
+				static_cast<uint64_t>(pShifter->m_Digits[uRead]) << uShift;
+		}
+		const uint64_t uQuotient = uAccumulator / 10U;
+		const uint32_t uDigit =
+			static_cast<uint32_t>(uAccumulator - (uQuotient * 10U));
+		--uWrite;
+		if (uWrite < kShifterDigits) {
+			pShifter->m_Digits[uWrite] = static_cast<uint8_t>(uDigit);
+		} else if (uDigit) {
+			pShifter->m_bTruncated = TRUE;
+		}
+		uAccumulator = uQuotient;
+	} while (uRead || uAccumulator);
+
+	// uWrite is the first digit, remove any unused leading space
+	pShifter->m_uCount = uEnd - uWrite;
+	pShifter->m_iDecimalPoint += static_cast<int32_t>(uNewDigits - uWrite);
+	if (uWrite) {
+		Burger::memory_move(pShifter->m_Digits, pShifter->m_Digits + uWrite,
+			pShifter->m_uCount);
+	}
+	TrimShifter(pShifter);
+}
+
+/***************************************
+
+	Divide a big decimal by 2^uShift, uShift is 1 to kMaxShift
+
+***************************************/
+
+static void ShiftRight(
+	DecimalShifter_t* pShifter, uint32_t uShift) BURGER_NOEXCEPT
+{
+	const uint32_t uCount = pShifter->m_uCount;
+	uint32_t uRead = 0;
+	uint64_t uAccumulator = 0;
+
+	// Pull in digits until there's a digit to output
+	while (!(uAccumulator >> uShift)) {
+		if (uRead >= uCount) {
+			if (!uAccumulator) {
+				pShifter->m_uCount = 0;
+				pShifter->m_iDecimalPoint = 0;
+				return;
+			}
+			do {
+				uAccumulator *= 10U;
+				++uRead;
+			} while (!(uAccumulator >> uShift));
+			break;
+		}
+		uAccumulator = (uAccumulator * 10U) + pShifter->m_Digits[uRead];
+		++uRead;
+	}
+	pShifter->m_iDecimalPoint -= static_cast<int32_t>(uRead) - 1;
+
+	const uint64_t uMask = (1ULL << uShift) - 1U;
+	uint32_t uWrite = 0;
+	while (uRead < uCount) {
+		const uint32_t uNext = pShifter->m_Digits[uRead];
+		++uRead;
+		pShifter->m_Digits[uWrite] =
+			static_cast<uint8_t>(uAccumulator >> uShift);
+		++uWrite;
+		uAccumulator = ((uAccumulator & uMask) * 10U) + uNext;
+	}
+
+	// Output the remainder
+	while (uAccumulator) {
+		const uint32_t uDigit = static_cast<uint32_t>(uAccumulator >> uShift);
+		uAccumulator = (uAccumulator & uMask) * 10U;
+		if (uWrite < kShifterDigits) {
+			pShifter->m_Digits[uWrite] = static_cast<uint8_t>(uDigit);
+			++uWrite;
+		} else if (uDigit) {
+			pShifter->m_bTruncated = TRUE;
+		}
+	}
+	pShifter->m_uCount = uWrite;
+	TrimShifter(pShifter);
+}
+
+/***************************************
+
+	Multiply a big decimal by 2^iShift, a negative shift divides
+
+***************************************/
+
+static void Shift(DecimalShifter_t* pShifter, int32_t iShift) BURGER_NOEXCEPT
+{
+	if (pShifter->m_uCount) {
+		if (iShift > 0) {
+			while (iShift > static_cast<int32_t>(kMaxShift)) {
+				ShiftLeft(pShifter, kMaxShift);
+				iShift -= static_cast<int32_t>(kMaxShift);
+			}
+			ShiftLeft(pShifter, static_cast<uint32_t>(iShift));
+		} else if (iShift < 0) {
+			while (iShift < -static_cast<int32_t>(kMaxShift)) {
+				ShiftRight(pShifter, kMaxShift);
+				iShift += static_cast<int32_t>(kMaxShift);
+			}
+			ShiftRight(pShifter, static_cast<uint32_t>(-iShift));
+		}
+	}
+}
+
+/***************************************
+
+	Return the integer part of a big decimal, rounded to nearest even
+
+***************************************/
+
+static uint64_t RoundedInteger(
+	const DecimalShifter_t* pShifter) BURGER_NOEXCEPT
+{
+	const int32_t iPoint = pShifter->m_iDecimalPoint;
+	const int32_t iCount = static_cast<int32_t>(pShifter->m_uCount);
+	uint64_t uResult = 0;
+	int32_t i = 0;
+	while ((i < iPoint) && (i < iCount)) {
+		uResult = (uResult * 10U) + pShifter->m_Digits[i];
+		++i;
+	}
+	while (i < iPoint) {
+		uResult *= 10U;
+		++i;
+	}
+
+	// Round up?
+	if ((iPoint >= 0) && (iPoint < iCount)) {
+		const uint32_t uDigit = pShifter->m_Digits[iPoint];
+		if (uDigit > 5U) {
+			++uResult;
+		} else if (uDigit == 5U) {
+			// An exact tie rounds to even
+			if (((iPoint + 1) < iCount) || pShifter->m_bTruncated ||
+				(uResult & 1U)) {
+				++uResult;
+			}
+		}
+	}
+	return uResult;
+}
+
+/***************************************
+
+	Convert a big decimal into the bits of a positive floating point number
+	by scaling it by powers of 2 until it's a normalized mantissa.
+
+	Based on the decimal conversion by Ken Thompson in the Go programming
+	language.
+
+***************************************/
+
+static uint64_t ShifterToBits(DecimalShifter_t* pShifter,
+	const FloatFormat_t* pFormat) BURGER_NOEXCEPT
+{
+	// Shift amounts that keep at least one digit before the point
+	static const uint8_t g_PowerShifts[9] = {1, 3, 6, 9, 13, 16, 19, 23, 26};
+
+	const uint32_t uMantissaBits = pFormat->m_uMantissaBits;
+	const int32_t iBias = pFormat->m_iMinimumExponent;
+	const uint64_t uInfinity =
+		static_cast<uint64_t>(pFormat->m_iInfinityExponent) << uMantissaBits;
+
+	if (!pShifter->m_uCount || (pShifter->m_iDecimalPoint < -330)) {
+		return 0;
+	}
+	if (pShifter->m_iDecimalPoint > 310) {
+		return uInfinity;
+	}
+
+	// Scale into the range of [0.5,1)
+	int32_t iExponent = 0;
+	while (pShifter->m_iDecimalPoint > 0) {
+		const int32_t iPoint = pShifter->m_iDecimalPoint;
+		const int32_t iShift = (iPoint >= 9) ? 27 : g_PowerShifts[iPoint];
+		Shift(pShifter, -iShift);
+		iExponent += iShift;
+	}
+	while ((pShifter->m_iDecimalPoint < 0) ||
+		(!pShifter->m_iDecimalPoint && (pShifter->m_Digits[0] < 5U))) {
+		const int32_t iPoint = -pShifter->m_iDecimalPoint;
+		const int32_t iShift = (iPoint >= 9) ? 27 : g_PowerShifts[iPoint];
+		Shift(pShifter, iShift);
+		iExponent -= iShift;
+	}
+
+	// Floating point is in the range of [1,2)
+	--iExponent;
+
+	// Subnormal numbers lose bits
+	if (iExponent < (iBias + 1)) {
+		const int32_t iShift = iBias + 1 - iExponent;
+		Shift(pShifter, -iShift);
+		iExponent += iShift;
+	}
+	if ((iExponent - iBias) >= pFormat->m_iInfinityExponent) {
+		return uInfinity;
+	}
+
+	// Extract the mantissa with the implied bit
+	Shift(pShifter, static_cast<int32_t>(uMantissaBits + 1U));
+	uint64_t uMantissa = RoundedInteger(pShifter);
+
+	// Rounding may have carried into another bit
+	if (uMantissa == (2ULL << uMantissaBits)) {
+		uMantissa >>= 1U;
+		++iExponent;
+		if ((iExponent - iBias) >= pFormat->m_iInfinityExponent) {
+			return uInfinity;
+		}
+	}
+
+	// Subnormal?
+	if (!(uMantissa & (1ULL << uMantissaBits))) {
+		iExponent = iBias;
+	}
+	return (uMantissa & ((1ULL << uMantissaBits) - 1U)) |
+		(static_cast<uint64_t>(iExponent - iBias) << uMantissaBits);
+}
+
+/***************************************
+
+	Convert ASCII digits into the bits of a positive floating point number.
+
+	The first 19 digits are tried with Eisel-Lemire. If there are more digits,
+	the result is only accepted if rounding the 19 digits up gives the same
+	answer, otherwise all of the digits are used by the slow path.
+
+***************************************/
+
+static uint64_t DigitsToBits(const char* pDigits, uint32_t uCount,
+	int32_t iExponent, uint_t bTruncated,
+	const FloatFormat_t* pFormat) BURGER_NOEXCEPT
+{
+	if (!uCount) {
+		return 0;
+	}
+
+	uint32_t uIntegerCount = uCount;
+	if (uIntegerCount > Burger::FPDecimal::kMaxIntegerDigits) {
+		uIntegerCount = Burger::FPDecimal::kMaxIntegerDigits;
+	}
+	uint64_t uMantissa = 0;
+	uint32_t i = 0;
+	do {
+		uMantissa = (uMantissa * 10U) +
+			static_cast<uint32_t>(static_cast<uint8_t>(pDigits[i]) - '0');
+	} while (++i < uIntegerCount);
+
+	// Power of 10 of the last digit used
+	const int32_t iPower10 =
+		iExponent - static_cast<int32_t>(uIntegerCount) + 1;
+	const uint64_t uBits = EiselLemire(uMantissa, iPower10, pFormat);
+	if (((uCount == uIntegerCount) && !bTruncated) ||
+		(uBits == EiselLemire(uMantissa + 1U, iPower10, pFormat))) {
+		return uBits;
+	}
+
+	// Too close to call, use every digit
+	DecimalShifter_t Shifter;
+	Shifter.m_uCount = uCount;
+	Shifter.m_iDecimalPoint = iExponent + 1;
+	Shifter.m_bTruncated = bTruncated;
+	i = 0;
+	do {
+		Shifter.m_Digits[i] =
+			static_cast<uint8_t>(static_cast<uint8_t>(pDigits[i]) - '0');
+	} while (++i < uCount);
+	return ShifterToBits(&Shifter, pFormat);
+}
+
+/*! ************************************
+
+	\brief Parse ASCII digits into the decimal number
+
+	Parse a number of the form 123.456e-7 and store all of the significant
+	digits. There is no sign or white space, they are handled by the caller.
+	If more than \ref kMaxDigits digits are found, the extra digits are only
+	tracked to see if they are non-zero.
+
+	The result is an exact copy of the number in the string, which can then be
+	converted with to_double() or to_float().
+
+	\param pInput Pointer to the ASCII digits
+
+	\return Pointer to the first character after the number, or pInput if no
+		digits were found.
+
+	\sa to_double(void) const or to_float(void) const
+
+***************************************/
+
+const char* BURGER_API Burger::FPDecimal::parse(
+	const char* pInput) BURGER_NOEXCEPT
+{
+	clear();
+
+	const char* pWork = pInput;
+	uint32_t uCount = 0;
+	uint_t bDigitFound = FALSE;
+	uint_t bPeriodFound = FALSE;
+
+	// Power of 10 of the first significant digit
+	int32_t iExponent = -1;
+	for (;;) {
+		const uint_t uTemp = reinterpret_cast<const uint8_t*>(pWork)[0];
+		if (uTemp == '.') {
+			if (bPeriodFound) {
+				break;
+			}
+			bPeriodFound = TRUE;
+		} else {
+			const uint_t uDigit = uTemp - '0';
+			if (uDigit >= 10U) {
+				break;
+			}
+			bDigitFound = TRUE;
+			if (uCount || uDigit) {
+				if (uCount < kMaxDigits) {
+					m_Digits[uCount] = static_cast<char>(uTemp);
+				} else if (uDigit) {
+					m_bTruncated = TRUE;
+				}
+				++uCount;
+				if (!bPeriodFound) {
+					++iExponent;
+				}
+			} else if (bPeriodFound) {
+				// Leading zeros after the period
+				--iExponent;
+			}
+		}
+		++pWork;
+	}
+
+	if (!bDigitFound) {
+		return pInput;
+	}
+
+	// Is there an exponent? It's only accepted if it has digits
+	if (!((reinterpret_cast<const uint8_t*>(pWork)[0] ^ 'E') & (~0x20U))) {
+		const char* pExponent = pWork + 1;
+		uint_t bNegative = FALSE;
+		if (pExponent[0] == '+') {
+			++pExponent;
+		} else if (pExponent[0] == '-') {
+			bNegative = TRUE;
+			++pExponent;
+		}
+		uint_t uDigit = reinterpret_cast<const uint8_t*>(pExponent)[0] - '0';
+		if (uDigit < 10U) {
+			int32_t iValue = 0;
+			do {
+				// Prevent overflow, anything this large is zero or infinity
+				if (iValue < 100000) {
+					iValue = (iValue * 10) + static_cast<int32_t>(uDigit);
+				}
+				++pExponent;
+				uDigit = reinterpret_cast<const uint8_t*>(pExponent)[0] - '0';
+			} while (uDigit < 10U);
+			iExponent += bNegative ? -iValue : iValue;
+			pWork = pExponent;
+		}
+	}
+
+	// Remove the trailing zeros
+	if (uCount > kMaxDigits) {
+		uCount = kMaxDigits;
+	}
+	while (uCount && (m_Digits[uCount - 1] == '0')) {
+		--uCount;
+	}
+	m_uDigitCount = uCount;
+	m_iExponent = uCount ? iExponent : 0;
+	return pWork;
+}
+
+/*! ************************************
+
+	\brief Convert the decimal number into a double
+
+	Return the double that is closest to the decimal number, ties are rounded
+	to even. The Eisel-Lemire algorithm is used on the first 19 digits, and
+	only if the remaining digits could change the result is a slower big
+	decimal conversion used.
+
+	Values too large to fit in a double are returned as infinity.
+
+	\return The decimal number as a double.
+
+	\sa to_float(void) const, scale_to_double(uint64_t, int32_t) or
+		parse(const char*)
+
+***************************************/
+
+double BURGER_API Burger::FPDecimal::to_double(void) const BURGER_NOEXCEPT
+{
+	uint64_double_t Result;
+	Result.w = DigitsToBits(m_Digits, m_uDigitCount, m_iExponent,
+		m_bTruncated, &g_DoubleFormat);
+	if (m_bNegative) {
+		Result.w |= 0x8000000000000000ULL;
+	}
+	return Result.d;
+}
+
+/*! ************************************
+
+	\brief Convert the decimal number into a float
+
+	Return the float that is closest to the decimal number, ties are rounded
+	to even.
+
+	Values too large to fit in a float are returned as infinity.
+
+	\return The decimal number as a float.
+
+	\sa to_double(void) const, scale_to_float(uint64_t, int32_t) or
+		parse(const char*)
+
+***************************************/
+
+float BURGER_API Burger::FPDecimal::to_float(void) const BURGER_NOEXCEPT
+{
+	uint32_float_t Result;
+	Result.w = static_cast<uint32_t>(DigitsToBits(m_Digits, m_uDigitCount,
+		m_iExponent, m_bTruncated, &g_FloatFormat));
+	if (m_bNegative) {
+		Result.w |= 0x80000000U;
+	}
+	return Result.f;
+}
+
+/*! ************************************
+
+	\brief Convert an integer and a power of 10 into a double
+
+	Return the double closest to uMantissa * 10^iExponent10, ties are rounded
+	to even. If the integer and the power of 10 are both exactly
+	representable, a single multiply or divide is used. Otherwise the
+	Eisel-Lemire algorithm creates the double with a 64x128 bit multiply.
+
+	The result is correctly rounded for any 64 bit integer and exponent, this
+	is the fast path for parsing decimal numbers with 19 digits or less.
+
+	\param uMantissa Decimal digits as an integer
+	\param iExponent10 Power of 10 to apply to uMantissa
+
+	\return Positive double, infinity if too large.
+
+	\sa scale_to_float(uint64_t, int32_t) or to_double(void) const
+
+***************************************/
+
+double BURGER_API Burger::FPDecimal::scale_to_double(
+	uint64_t uMantissa, int32_t iExponent10) BURGER_NOEXCEPT
+{
+	// Extended precision floating point units can round twice
+#if !defined(BURGER_X86) && !defined(BURGER_68K)
+	if ((uMantissa <= 0x20000000000000ULL) && (iExponent10 >= -22) &&
+		(iExponent10 <= 22)) {
+		const double dValue =
+			static_cast<double>(static_cast<int64_t>(uMantissa));
+		if (iExponent10 < 0) {
+			return dValue / g_Power10Double[-iExponent10];
+		}
+		return dValue * g_Power10Double[iExponent10];
+	}
+#endif
+	uint64_double_t Result;
+	Result.w = EiselLemire(uMantissa, iExponent10, &g_DoubleFormat);
+	return Result.d;
+}
+
+/*! ************************************
+
+	\brief Convert an integer and a power of 10 into a float
+
+	Return the float closest to uMantissa * 10^iExponent10, ties are rounded
+	to even.
+
+	\param uMantissa Decimal digits as an integer
+	\param iExponent10 Power of 10 to apply to uMantissa
+
+	\return Positive float, infinity if too large.
+
+	\sa scale_to_double(uint64_t, int32_t) or to_float(void) const
+
+***************************************/
+
+float BURGER_API Burger::FPDecimal::scale_to_float(
+	uint64_t uMantissa, int32_t iExponent10) BURGER_NOEXCEPT
+{
+#if !defined(BURGER_X86) && !defined(BURGER_68K)
+	if ((uMantissa <= 0x1000000U) && (iExponent10 >= -10) &&
+		(iExponent10 <= 10)) {
+		const float fValue =
+			static_cast<float>(static_cast<int32_t>(uMantissa));
+		if (iExponent10 < 0) {
+			return fValue / g_Power10Float[-iExponent10];
+		}
+		return fValue * g_Power10Float[iExponent10];
+	}
+#endif
+	uint32_float_t Result;
+	Result.w = static_cast<uint32_t>(
+		EiselLemire(uMantissa, iExponent10, &g_FloatFormat));
+	return Result.f;
+}
@@ -0,0 +1,135 @@
+/***************************************
+
+	Floating point to decimal digit conversion class.
+
+	Copyright (c) 2020-2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#ifndef __BRFPDECIMAL_H__
+#define __BRFPDECIMAL_H__
+
+#ifndef __BRTYPES_H__
+#include "brtypes.h"
+#endif
+
+/* BEGIN */
+namespace Burger {
+
+class FPDecimal {
+public:
+	/** Largest number of significant digits of any exact double, plus one */
+	static BURGER_CONSTEXPR const uint32_t kMaxDigits = 772;
+
+	/** Most digits in a shortest round trip string */
+	static BURGER_CONSTEXPR const uint32_t kMaxShortestDigits = 17;
+
+	/** Most decimal digits that always fit in a 64 bit integer */
+	static BURGER_CONSTEXPR const uint32_t kMaxIntegerDigits = 19;
+
+protected:
+	/** Value being converted, kept for exact rounding */
+	double m_dValue;
+
+	/** Power of 10 of the first digit in m_Digits */
+	int32_t m_iExponent;
+
+	/** Number of digits in m_Digits, zero if the value is zero */
+	uint32_t m_uDigitCount;
+
+	/** Precision where rounding the shortest digits is still exact */
+	uint32_t m_uSafeDigits;
+
+	/** \ref TRUE if the value is negative */
+	uint_t m_bNegative;
+
+	/** \ref TRUE if the digits were rounded from the exact value */
+	uint_t m_bExact;
+
+	/** \ref TRUE if parse() discarded non-zero digits */
+	uint_t m_bTruncated;
+
+	/** ASCII digits, most significant first, without trailing zeros */
+	char m_Digits[kMaxDigits];
+
+public:
+	FPDecimal(void) BURGER_NOEXCEPT
+	{
+		clear();
+	}
+
+	void BURGER_API clear(void) BURGER_NOEXCEPT;
+	void BURGER_API shortest(double dInput) BURGER_NOEXCEPT;
+	void BURGER_API shortest(float fInput) BURGER_NOEXCEPT;
+	void BURGER_API round_to_position(int32_t iPosition) BURGER_NOEXCEPT;
+	void BURGER_API round_to_digits(uint32_t uDigits) BURGER_NOEXCEPT;
+	const char* BURGER_API parse(const char* pInput) BURGER_NOEXCEPT;
+	double BURGER_API to_double(void) const BURGER_NOEXCEPT;
+	float BURGER_API to_float(void) const BURGER_NOEXCEPT;
+
+	static double BURGER_API scale_to_double(
+		uint64_t uMantissa, int32_t iExponent10) BURGER_NOEXCEPT;
+	static float BURGER_API scale_to_float(
+		uint64_t uMantissa, int32_t iExponent10) BURGER_NOEXCEPT;
+
+	BURGER_INLINE uint_t is_zero(void) const BURGER_NOEXCEPT
+	{
+		return !m_uDigitCount;
+	}
+
+	BURGER_INLINE uint_t is_negative(void) const BURGER_NOEXCEPT
+	{
+		return m_bNegative;
+	}
+
+	BURGER_INLINE void set_negative(uint_t bNegative) BURGER_NOEXCEPT
+	{
+		m_bNegative = bNegative;
+	}
+
+	BURGER_INLINE int32_t get_exponent(void) const BURGER_NOEXCEPT
+	{
+		return m_iExponent;
+	}
+
+	BURGER_INLINE uint32_t get_digit_count(void) const BURGER_NOEXCEPT
+	{
+		return m_uDigitCount;
+	}
+
+	BURGER_INLINE const char* get_digits(void) const BURGER_NOEXCEPT
+	{
+		return m_Digits;
+	}
+
+	BURGER_INLINE int32_t get_last_position(void) const BURGER_NOEXCEPT
+	{
+		return m_iExponent - static_cast<int32_t>(m_uDigitCount) + 1;
+	}
+
+	BURGER_INLINE char get_digit(int32_t iPosition) const BURGER_NOEXCEPT
+	{
+		const uint32_t uIndex = static_cast<uint32_t>(m_iExponent - iPosition);
+		return (uIndex < m_uDigitCount) ? m_Digits[uIndex] : '0';
+	}
+
+protected:
+	void BURGER_API set_digits(
+		uint64_t uDigits, int32_t iExponent) BURGER_NOEXCEPT;
+	void BURGER_API round_digits(
+		int32_t iPosition, uint32_t uDigits) BURGER_NOEXCEPT;
+	void BURGER_API truncate(int32_t iKeep, uint_t bRoundUp) BURGER_NOEXCEPT;
+	void BURGER_API exact_round(
+		int32_t iPosition, uint32_t uDigits) BURGER_NOEXCEPT;
+};
+
+}
+/* END */
+
+#endif
@@ -203,34 +203,25 @@ void BURGER_API Burger::FPPrintInfo::clear(void) BURGER_NOEXCEPT
 
 /*! ************************************
 
-	\brief Analyze a floating point number
+	\brief Check for a special floating point number
 
-	Analyze the floating point number. Determine if it is a 'special' form
-	and where the digits start and end on each side of the decimal point.
+	Check if the floating point number is infinity or NaN and if so, set up
+	the class to print it as such. No digits are analyzed, so this is much
+	faster than analyze_float(const FPInfo*, uint32_t) when the digits are
+	obtained some other way.
 
 	\param pFPInfo Pointer to the floating point number to analyze
-	\param uPrecisionDigits Number of digits of precision to print
 
-***************************************/
+	\return \ref TRUE if the number is infinity or NaN, \ref FALSE if not and
+		the class is unchanged.
 
-void BURGER_API Burger::FPPrintInfo::analyze_float(
-	const FPInfo* pFPInfo, uint32_t uPrecisionDigits) BURGER_NOEXCEPT
-{
-	// Handle the easy cases.
+	\sa analyze_float(const FPInfo*, uint32_t)
 
-	// Zero?
-	if (pFPInfo->is_zero()) {
-		m_bHasIntegerPart = TRUE;
-		m_bHasFractionalPart = FALSE;
-		m_uSpecialFormDigits = 0;
-		m_uFirstNonZeroIntDigitPos = 1;
-		m_uLastNonZeroIntDigitPos = 1;
-		m_uFirstNonZeroFracDigitPos = 0;
-		m_uLastNonZeroFracDigitPos = 0;
-		m_uPrintResult = kResultZero;
-		return;
-	}
+***************************************/
 
+uint_t BURGER_API Burger::FPPrintInfo::analyze_special(
+	const FPInfo* pFPInfo) BURGER_NOEXCEPT
+{
 	// Infinity and beyond?
 	if (pFPInfo->is_infinite()) {
 
@@ -254,7 +245,7 @@ void BURGER_API Burger::FPPrintInfo::analyze_float(
 		m_uFirstNonZeroFracDigitPos = 0;
 		m_uLastNonZeroFracDigitPos = 0;
 		m_uPrintResult = uResult;
-		return;
+		return TRUE;
 	}
 
 	// Not even a number?
@@ -279,6 +270,43 @@ void BURGER_API Burger::FPPrintInfo::analyze_float(
 		m_uFirstNonZeroFracDigitPos = 0;
 		m_uLastNonZeroFracDigitPos = 0;
 		m_uPrintResult = uResult;
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/*! ************************************
+
+	\brief Analyze a floating point number
+
+	Analyze the floating point number. Determine if it is a 'special' form
+	and where the digits start and end on each side of the decimal point.
+
+	\param pFPInfo Pointer to the floating point number to analyze
+	\param uPrecisionDigits Number of digits of precision to print
+
+***************************************/
+
+void BURGER_API Burger::FPPrintInfo::analyze_float(
+	const FPInfo* pFPInfo, uint32_t uPrecisionDigits) BURGER_NOEXCEPT
+{
+	// Handle the easy cases.
+
+	// Zero?
+	if (pFPInfo->is_zero()) {
+		m_bHasIntegerPart = TRUE;
+		m_bHasFractionalPart = FALSE;
+		m_uSpecialFormDigits = 0;
+		m_uFirstNonZeroIntDigitPos = 1;
+		m_uLastNonZeroIntDigitPos = 1;
+		m_uFirstNonZeroFracDigitPos = 0;
+		m_uLastNonZeroFracDigitPos = 0;
+		m_uPrintResult = kResultZero;
+		return;
+	}
+
+	// Infinity or NaN?
+	if (analyze_special(pFPInfo)) {
 		return;
 	}
 
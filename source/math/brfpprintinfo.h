@@ -205,6 +205,7 @@ public:
 			(m_uPrintResult <= kResultIndefiniteNaN);
 	}
 
+	uint_t BURGER_API analyze_special(const FPInfo* pFPInfo) BURGER_NOEXCEPT;
 	void BURGER_API analyze_float(
 		const FPInfo* pFPInfo, uint32_t uPrecisionDigits) BURGER_NOEXCEPT;
 };
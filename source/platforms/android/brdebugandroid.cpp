@@ -17,6 +17,7 @@
 #include "brdebug.h"
 
 #if defined(BURGER_ANDROID)
+#include "brlogsink.h"
 #include "brmutex.h"
 #include "brmemoryfunctions.h"
 #include "brstringfunctions.h"
@@ -36,6 +37,12 @@ void BURGER_API Burger::Debug::PrintString(const char* pString) BURGER_NOEXCEPT
 	if (pString) {
 		uintptr_t i = string_length(pString);
 		if (i) {
+			// Send to the buffered log if one was set
+			LogSink* pSink = get_log_sink();
+			if (pSink) {
+				pSink->write(pString, i);
+				return;
+			}
 			g_LockString.lock();
 			// Output the string to logcat
 			__android_log_write(ANDROID_LOG_INFO, "burgerlib", pString);
@@ -158,8 +158,8 @@ Burger::eError BURGER_API Burger::ConditionVariable::wait(
 			// Get the remainder in NANOSECONDS
 			uMilliseconds = (uMilliseconds - (uSeconds * 1000)) * 1000000;
 
-			// Add to the current time
-			uMilliseconds += CurrentTime.tv_usec;
+			// Add to the current time (Convert MICROseconds to NANOseconds)
+			uMilliseconds += static_cast<uint_t>(CurrentTime.tv_usec) * 1000U;
 			uSeconds += static_cast<uint_t>(CurrentTime.tv_sec);
 			// Handle wrap around
 			if (uMilliseconds >= 1000000000) {
@@ -20,6 +20,7 @@
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #if !defined(DOXYGEN)
@@ -215,6 +216,60 @@ uintptr_t BURGER_API Burger::File::write(
 	return uResult;
 }
 
+/***************************************
+
+	\brief Write several buffers into an open file
+
+	The buffers are passed to writev() in batches, so a stream made of many
+	chunks is written with very few calls into the kernel.
+
+	\param pInput Pointer to an array of buffers to write
+	\param uCount Number of entries in the array
+
+	\return Number of bytes written (Can be less than what was requested due to
+		EOF or write errors)
+
+	\sa write(const void*, uintptr_t)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::File::write_gather(
+	const IOVector_t* pInput, uintptr_t uCount) BURGER_NOEXCEPT
+{
+	uintptr_t uResult = 0;
+	int fp = static_cast<int>(reinterpret_cast<uintptr_t>(m_pFile));
+	if (fp && uCount) {
+		// Well under IOV_MAX on every platform
+		struct iovec Vectors[64];
+		do {
+			uintptr_t uBatch = uCount;
+			if (uBatch > BURGER_ARRAYSIZE(Vectors)) {
+				uBatch = BURGER_ARRAYSIZE(Vectors);
+			}
+			uintptr_t uWanted = 0;
+			uintptr_t i = 0;
+			do {
+				Vectors[i].iov_base = const_cast<void*>(pInput[i].m_pData);
+				Vectors[i].iov_len = pInput[i].m_uLength;
+				uWanted += pInput[i].m_uLength;
+			} while (++i < uBatch);
+
+			ssize_t iWrite = ::writev(fp, Vectors, static_cast<int>(uBatch));
+			if (iWrite == static_cast<ssize_t>(-1)) {
+				break;
+			}
+			uResult += static_cast<uintptr_t>(iWrite);
+			// Stop on a short write, like write() does
+			if (static_cast<uintptr_t>(iWrite) != uWanted) {
+				break;
+			}
+			pInput += uBatch;
+			uCount -= uBatch;
+		} while (uCount);
+	}
+	return uResult;
+}
+
 /***************************************
 
 	\brief Get the current file mark
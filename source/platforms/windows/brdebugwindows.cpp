@@ -19,6 +19,7 @@
 #if defined(BURGER_WINDOWS)
 #include "brmutex.h"
 #include "brfile.h"
+#include "brlogsink.h"
 #include "brnumberstringhex.h"
 #include "broscursor.h"
 #include "brstring.h"
@@ -51,6 +52,12 @@ void BURGER_API Burger::Debug::PrintString(const char* pString) BURGER_NOEXCEPT
 	if (pString) {
 		const uintptr_t i = string_length(pString);
 		if (i) {
+			// Send to the buffered log if one was set
+			LogSink* pSink = get_log_sink();
+			if (pSink) {
+				pSink->write(pString, i);
+				return;
+			}
 			if (!is_debugger_present()) {
 				// Send the string to the log file
 				g_LockString.lock();
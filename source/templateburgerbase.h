@@ -140,6 +140,7 @@
 #include "brfpinfo.h"
 #include "brfplargeint.h"
 #include "brfpprintinfo.h"
+#include "brfpdecimal.h"
 #include "brmutex.h"
 #include "brrecursivemutex.h"
 #include "brsemaphore.h"
@@ -191,6 +192,7 @@
 #include "brutf16.h"
 #include "brutf32.h"
 #include "brprintf.h"
+#include "brlogsink.h"
 #include "brqueue.h"
 #include "brsmartpointer.h"
 #include "brpair.h"
@@ -199,12 +201,14 @@
 #include "brpackfloat.h"
 #include "brunpackbytes.h"
 #include "brstring.h"
+#include "brstringatom.h"
 #include "brstring16.h"
 #include "brstring32.h"
 #include "brunixtypes.h"
 #include "brglobals.h"
 #include "brosstringfunctions.h"
 #include "brhashmap.h"
+#include "brconcurrenthashmap.h"
 #include "brvector2d.h"
 #include "brvector3d.h"
 #include "brvector4d.h"
@@ -288,6 +292,7 @@
 #include "brfilepng.h"
 #include "brfiletga.h"
 #include "brfilexml.h"
+#include "brxmlreader.h"
 #include "brshape8bit.h"
 #include "brfont.h"
 #include "brfont4bit.h"
@@ -13,10 +13,74 @@
 ***************************************/
 
 #include "brasciito.h"
+#include "brendian.h"
 #include "brfloatingpoint.h"
+#include "brfpdecimal.h"
 #include "brmemoryfunctions.h"
 #include "brstringfunctions.h"
 
+// AddressSanitizer reports the reads past the terminating zero
+#if defined(__SANITIZE_ADDRESS__)
+#define USE_BYTE_SCAN
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define USE_BYTE_SCAN
+#endif
+#endif
+
+/***************************************
+
+	Load 8 characters and return TRUE if they are all ASCII digits. "C"
+	strings are read in blocks, so never read past the end of the memory page
+	to avoid faulting past the terminator.
+
+***************************************/
+
+static BURGER_INLINE uint_t LoadEightDigits(
+	const char* pInput, uint64_t* pOutput) BURGER_NOEXCEPT
+{
+#if defined(USE_BYTE_SCAN)
+	// Sanitized builds parse the digits one at a time
+	BURGER_UNUSED(pInput);
+	BURGER_UNUSED(pOutput);
+	return FALSE;
+#else
+	if ((reinterpret_cast<uintptr_t>(pInput) & 0xFFFU) > (0x1000U - 8U)) {
+		return FALSE;
+	}
+	const uint64_t uValue = Burger::LittleEndian::load_unaligned(
+		reinterpret_cast<const uint64_t*>(pInput));
+
+	// Any byte that isn't '0' through '9' will set its high bit
+	if (((uValue + 0x4646464646464646ULL) | (uValue - 0x3030303030303030ULL)) &
+		0x8080808080808080ULL) {
+		return FALSE;
+	}
+	pOutput[0] = uValue;
+	return TRUE;
+#endif
+}
+
+/***************************************
+
+	Convert 8 ASCII digits loaded by LoadEightDigits() into an integer. Pairs
+	of digits are merged, then pairs of pairs, then the two halves, so only
+	three multiplies are needed.
+
+***************************************/
+
+static BURGER_INLINE uint32_t ConvertEightDigits(
+	uint64_t uInput) BURGER_NOEXCEPT
+{
+	uInput -= 0x3030303030303030ULL;
+	uInput = (uInput * 10U) + (uInput >> 8U);
+	uInput = (((uInput & 0x000000FF000000FFULL) * 0x000F424000000064ULL) +
+				 (((uInput >> 16U) & 0x000000FF000000FFULL) *
+					 0x0000271000000001ULL)) >>
+		32U;
+	return static_cast<uint32_t>(uInput);
+}
+
 /*! ************************************
 
 	\brief Convert an ASCII string into an integer.
@@ -355,6 +419,15 @@ uint64_t BURGER_API Burger::AsciiToInteger64(
 			// Here's the base 10 code. Common case
 			uint64_t uValue10 = g_AsciiToWord8Table[uLetter];
 			if (uValue10 < 10) { // First char valid?
+
+				// Convert 8 digits at a time while an overflow is impossible
+				uint64_t uEight;
+				while ((uValue10 < 184467440737ULL) &&
+					LoadEightDigits(pInput, &uEight)) {
+					uValue10 =
+						(uValue10 * 100000000U) + ConvertEightDigits(uEight);
+					pInput += 8;
+				}
 				uint_t uAscii10 = reinterpret_cast<const uint8_t*>(pInput)[0];
 				uLetter = g_AsciiToWord8Table[uAscii10];
 				if (uLetter < 10) { // Second char valid?
@@ -581,19 +654,152 @@ uint64_t BURGER_API Burger::AsciiToWord64(const char* pInput, uint64_t uDefault,
 
 /***************************************
 
-	Power of 10 table with the powers doubling with each entry
+	Digits of a decimal number, found by ScanDecimal()
+
+***************************************/
+
+struct DecimalScan_t {
+	/** First 19 significant digits */
+	uint64_t m_uMantissa;
+	/** Power of 10 to apply to m_uMantissa */
+	int32_t m_iExponent;
+	/** TRUE if there were more than 19 significant digits */
+	uint_t m_bTruncated;
+};
+
+/***************************************
+
+	Parse a run of ASCII digits into a 64 bit integer. Eight digits are
+	converted at a time with SWAR (SIMD within a register) math. The value
+	wraps around on overflow.
+
+***************************************/
+
+static const char* BURGER_API ParseDigits(
+	const char* pInput, uint64_t* pValue) BURGER_NOEXCEPT
+{
+	uint64_t uValue = pValue[0];
+	uint64_t uEight;
+	while (LoadEightDigits(pInput, &uEight)) {
+		uValue = (uValue * 100000000U) + ConvertEightDigits(uEight);
+		pInput += 8;
+	}
+	uint_t uDigit = reinterpret_cast<const uint8_t*>(pInput)[0] - '0';
+	while (uDigit < 10U) {
+		uValue = (uValue * 10U) + uDigit;
+		++pInput;
+		uDigit = reinterpret_cast<const uint8_t*>(pInput)[0] - '0';
+	}
+	pValue[0] = uValue;
+	return pInput;
+}
+
+/***************************************
 
-	I use it to perform a binary multiply to cut down on the number of muls I
-	need to do before I'm done scaling the number
+	Scan a number of the form 123.456e-7 without a sign. The first 19
+	significant digits are returned as an integer with a power of 10.
 
-	The "e" is the number of zeros following the 1 1e1 = 10, 1e2 = 100, 1e4 =
-	10000 etc...
+	Return nullptr if there were no digits, or a pointer to the first
+	character after the number.
 
 ***************************************/
 
-// 6 entries, since 38 is the max
-static const float PowerOf10FltTable[6] = {
-	1e1f, 1e2f, 1e4f, 1e8f, 1e16f, 1e32f};
+static const char* BURGER_API ScanDecimal(
+	DecimalScan_t* pOutput, const char* pInput) BURGER_NOEXCEPT
+{
+	// Integer part
+	uint64_t uMantissa = 0;
+	const char* pWork = ParseDigits(pInput, &uMantissa);
+	const char* pIntegerEnd = pWork;
+	uintptr_t uDigitCount = static_cast<uintptr_t>(pIntegerEnd - pInput);
+
+	// Fraction
+	const char* pFraction = pWork;
+	if (pWork[0] == '.') {
+		++pWork;
+		pFraction = pWork;
+		pWork = ParseDigits(pWork, &uMantissa);
+		uDigitCount += static_cast<uintptr_t>(pWork - pFraction);
+	}
+	const char* pFractionEnd = pWork;
+
+	// -.e1 is NOT considered a floating point number
+	if (!uDigitCount) {
+		return nullptr;
+	}
+
+	// The exponent is only accepted if it has digits
+	int32_t iExponent = 0;
+	if (!((reinterpret_cast<const uint8_t*>(pWork)[0] ^ 'E') & (~0x20U))) {
+		const char* pExponent = pWork + 1;
+		uint_t bNegExponent = FALSE;
+		if (pExponent[0] == '+') {
+			++pExponent;
+		} else if (pExponent[0] == '-') {
+			bNegExponent = TRUE;
+			++pExponent;
+		}
+		uint_t uDigit = reinterpret_cast<const uint8_t*>(pExponent)[0] - '0';
+		if (uDigit < 10U) {
+			do {
+				// Prevent overflow, anything this large is zero or infinity
+				if (iExponent < 100000) {
+					iExponent = (iExponent * 10) + static_cast<int32_t>(uDigit);
+				}
+				++pExponent;
+				uDigit = reinterpret_cast<const uint8_t*>(pExponent)[0] - '0';
+			} while (uDigit < 10U);
+			if (bNegExponent) {
+				iExponent = -iExponent;
+			}
+			pWork = pExponent;
+		}
+	}
+
+	uint_t bTruncated = FALSE;
+	int32_t iFractionDigits = static_cast<int32_t>(pFractionEnd - pFraction);
+	if (uDigitCount > 19U) {
+		// Leading zeros are not significant
+		const char* pStart = pInput;
+		while ((pStart[0] == '0') || (pStart[0] == '.')) {
+			if (pStart[0] == '0') {
+				--uDigitCount;
+			}
+			++pStart;
+		}
+
+		// Too many digits to fit in 64 bits? Only use the first 19.
+		if (uDigitCount > 19U) {
+			bTruncated = TRUE;
+			uMantissa = 0;
+			while ((uMantissa < 1000000000000000000ULL) &&
+				(pStart < pIntegerEnd)) {
+				uMantissa = (uMantissa * 10U) +
+					static_cast<uint_t>(
+						reinterpret_cast<const uint8_t*>(pStart)[0] - '0');
+				++pStart;
+			}
+			if (uMantissa >= 1000000000000000000ULL) {
+				// Integer digits that were skipped
+				iFractionDigits = -static_cast<int32_t>(pIntegerEnd - pStart);
+			} else {
+				pStart = pFraction;
+				while ((uMantissa < 1000000000000000000ULL) &&
+					(pStart < pFractionEnd)) {
+					uMantissa = (uMantissa * 10U) +
+						static_cast<uint_t>(
+							reinterpret_cast<const uint8_t*>(pStart)[0] - '0');
+					++pStart;
+				}
+				iFractionDigits = static_cast<int32_t>(pStart - pFraction);
+			}
+		}
+	}
+	pOutput->m_uMantissa = uMantissa;
+	pOutput->m_iExponent = iExponent - iFractionDigits;
+	pOutput->m_bTruncated = bTruncated;
+	return pWork;
+}
 
 /*! ************************************
 
@@ -602,6 +808,15 @@ static const float PowerOf10FltTable[6] = {
 	Take a floating point number of the format (+/-)303.030e(+/-)1 and turn it
 	into a float that is the equivalent.
 
+	The result is the float closest to the decimal number, with ties rounded
+	to even. The first 19 digits are converted 8 at a time into an integer and
+	scaled with FPDecimal::scale_to_float(uint64_t, int32_t). Only if there
+	are more digits and they could change the result is the slower
+	FPDecimal::to_float(void) const used.
+
+	Numbers too large are clamped to the largest finite value, numbers too
+	small become zero or a denormal.
+
 	If a number is parsed, the character at the end of the string after
 	whitespace is removed is the one pointed by pDest.
 
@@ -692,240 +907,39 @@ float BURGER_API Burger::AsciiToFloat(
 		}
 	}
 
-	// Now, lets parse xxx.xxx
-	// I'm going to make it easy on myself.
-	// I'll copy the digits, sans the period and all leading and trailing zeros.
-	// I will parse a maximum of 9 digits
-
-	uint_t uDigitCount = 0;     // Number of digits in my buffer
-	uint_t uFractionDigits = 0; // Nothing parsed after the period
-	// Set to true if a number of any kind (Like all zeros) was found
-	uint_t bNumberFound = FALSE;
-
-	// Buffer for digits converted to 0-9 (DO NOT CHANGE THE SIZE!)
-	uint8_t DigitBuffer[9];
-
-	for (;;) {
-		if (uTemp == '.') {        // Is this a period?
-			if (uFractionDigits) { // Already got one?
-				break;             // Can't do double periods!
-			}
-			uFractionDigits =
-				1; // Start the counter by setting this to non-zero
-		} else {
-			// Precompute
-			const uint_t uVal = uTemp - '0';
-			if (uVal >=
-				10) { // Only take numbers (Also breaks on null terminator)
-				break;
-			}
-			bNumberFound = TRUE;   // I got something
-			if (uFractionDigits) { // After the period?
-				// Add to total (Note, all digits AFTER the period count
-				++uFractionDigits;
-			}
-			if (uDigitCount || uVal) { // Suppress leading zeros
-				if (uDigitCount < sizeof(DigitBuffer)) { // Buffer overrun? Bad.
-					DigitBuffer[uDigitCount] = static_cast<uint8_t>(uVal);
-				}
-				++uDigitCount;
-			}
-		}
-		uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-		++pInput;
-	}
-
-	// Did I parse ANY number?
-	// -.e1 is NOT considered a floating point number
-	// Accept NOTHING and return 0.0f as my failure condition
-
-	if (!bNumberFound) {
+	// Now, lets parse xxx.xxx, pInput is one character past uTemp
+	--pInput;
+	DecimalScan_t Scan;
+	const char* pEnd = ScanDecimal(&Scan, pInput);
+	if (!pEnd) {
 		return 0.0f; // Forget it. Error.
 	}
 
-	// At this point, I've parsed up to 9 digits
-	// I need to get the exponent
-
-	int iExponent = 0;                // Assume no extra shifting of the digits
-	if (!((uTemp ^ 'E') & (~0x20))) { // E or e Exponent token?
-		const char* pInput2 = pInput; // Save the mark
-
-		uTemp = reinterpret_cast<const uint8_t*>(pInput2)[0];
-		++pInput2;
-		uint_t NegExponent = FALSE; // Assume a positive exponent
-		if (uTemp == '+') {
-			uTemp = reinterpret_cast<const uint8_t*>(pInput2)[0];
-			++pInput2;
-		} else if (uTemp == '-') {
-			NegExponent = TRUE;
-			uTemp = reinterpret_cast<const uint8_t*>(pInput2)[0];
-			++pInput2;
-		}
-		uTemp -= '0';
-		if (uTemp < 10) {
-			do {
-				if (iExponent < 100) { // Prevent overflow
-					iExponent = (iExponent * 10) + static_cast<int>(uTemp);
-				}
-				uTemp = reinterpret_cast<const uint8_t*>(pInput2)[0];
-				++pInput2;
-				uTemp -= '0';
-			} while (uTemp < 10);
-
-			// Since I got an e102 or e-1, I'll accept this input
-			pInput = pInput2;
-			// This is the only place where exponent could be non-zero
-			if (NegExponent) {
-				iExponent = -iExponent;
-			}
-		}
-	}
-
 	// Mark the requested ASCII marker
-
 	if (pDest) {
-		// Back step 1 char, but this is where I stopped parsing.
-		pDest[0] = pInput - 1;
-	}
-
-	// Since I've got an exponent and up to 9 digits of mantissa,
-	// let's make a floating point number.
-
-	if (uFractionDigits) { // Did I find a period?
-		// Adjust the exponent for how many digits there were to the right of
-		// the period (The +1 was the flag that I got something)
-		iExponent -= uFractionDigits - 1;
-	}
-
-	// I counted the number of digits, but the buffer may not hold them all. Add
-	// the truncated count to the exponent
-
-	if (uDigitCount > sizeof(DigitBuffer)) { // Clipped?
-		// Add the clipped count
-		iExponent += uDigitCount - static_cast<uint_t>(sizeof(DigitBuffer));
-
-		// Force my counter for parsing to the right amount
-		uDigitCount = static_cast<uint_t>(sizeof(DigitBuffer));
-	}
-
-	// Dispose of trailing zeros (It helps with precision)
-
-	if (uDigitCount) {
-		do {
-			if (DigitBuffer[uDigitCount - 1]) { // Last digit, non-zero?
-				break;                          // Don't touch it
-			}
-			++iExponent; // Adjust the exponent
-		} while (--uDigitCount); // Count down
-		if (!uDigitCount) { // Did I remove all of the digits?
-			return 0.0f;    // 0 exponent anything, is still zero
-		}
+		pDest[0] = pEnd;
 	}
 
-	// Since we've got something to be converted into a number, let's parse it.
-
-	const uint8_t* pBuffer = DigitBuffer;
-
-	int32_t iLow9 = 0; // Low 9 digits
-	uint_t i2 = uDigitCount;
-	if (i2) {
-		do {
-			iLow9 = (iLow9 * 10) + static_cast<int32_t>(pBuffer[0]);
-			++pBuffer;
-		} while (--i2);
+	// If the digits past the 19th could change the result, convert all of
+	// them
+	float fResult =
+		FPDecimal::scale_to_float(Scan.m_uMantissa, Scan.m_iExponent);
+	if (Scan.m_bTruncated &&
+		(fResult !=
+			FPDecimal::scale_to_float(
+				Scan.m_uMantissa + 1U, Scan.m_iExponent))) {
+		FPDecimal Decimal;
+		Decimal.parse(pInput);
+		fResult = Decimal.to_float();
 	}
 
-	// Merge the convert the 32 bit int into a float
-
-	float fResult = static_cast<float>(iLow9);
-
-	// Apply the exponent, if any.
-
-	if (iExponent) { // Do I bother?
-		if (iExponent < 0) {
-
-			// I'm going to shrink the number via division
-
-			// I'm performing the division operation instead of the reciprocal
-			// multiplies because I want to retain as much precision as I can.
-
-			uint_t uCount1 = static_cast<uint_t>(-iExponent); // Get abs value
-
-			// This is for really stupid numbers
-
-			if (uCount1 >= 38) {
-				fResult /= 1e38f;
-				uCount1 -= 38;
-			}
-			if (uCount1) {
-				const float* pPower1 = PowerOf10FltTable;
-				float fScalar1 = 1.0f;
-				do {
-					if (uCount1 & 1) { // Using a double table, I'll get the
-									   // right power of 10
-						fScalar1 *= pPower1[0];
-					}
-					++pPower1;
-					uCount1 >>= 1;
-				} while (uCount1); // Keep going until I'm done
-				fResult /= fScalar1; // Shrink the number
-			}
-		} else {
-
-			// Same as above, but I'm growing the number this time
-
-			uint_t uCount2 = static_cast<uint_t>(iExponent);
-
-			// This is for really stupid numbers
-
-			if (uCount2 >= 38) {
-				fResult *= 1e38f;
-				uCount2 -= 38;
-			}
-			if (uCount2) {
-				const float* pPower2 = PowerOf10FltTable;
-				float fScalar2 = 1.0f;
-				do {
-					if (uCount2 & 1) {
-						fScalar2 *= pPower2[0];
-					}
-					++pPower2;
-					uCount2 >>= 1;
-				} while (uCount2);
-				fResult *= fScalar2;
-			}
-		}
-	}
-
-	// Okay, I've got the number. Detect overflow
-	iExponent += uDigitCount;
-
 	// Was the exponent nuts?
-	if (iExponent > (38 + 1)) {
-		fResult = Burger::g_fMax; // Grab a constant
-		// Was the exponent nuts in the other direction?
-	} else if (iExponent < ((-38) + 1)) {
-		fResult = Burger::g_fMin; // Grab a constant
+	if (fResult > g_fMax) {
+		fResult = g_fMax; // Grab a constant
 	}
 	return fResult * fNegative; // Return the answer
 }
 
-/***************************************
-
-	Power of 10 table with the powers doubling with each entry
-
-	I use it to perform a binary multiply to cut down on the number of
-	multiplies I need to do before I'm done scaling the number
-
-	The "e" is the number of zeros following the 1
-	1e1 = 10, 1e2 = 100, 1e4 = 10000 etc...
-
-***************************************/
-
-// 9 entries, since 308 is the max
-static const double PowerOf10DblTable[9] = {
-	1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256};
-
 /*! ************************************
 
 	\brief Convert an ASCII string into a floating point number.
@@ -933,6 +947,15 @@ static const double PowerOf10DblTable[9] = {
 	Take a floating point number of the format (+/-)303.030e(+/-)1 and turn it
 	into a double that is the equivalent.
 
+	The result is the double closest to the decimal number, with ties rounded
+	to even. The first 19 digits are converted 8 at a time into an integer and
+	scaled with FPDecimal::scale_to_double(uint64_t, int32_t). Only if there
+	are more digits and they could change the result is the slower
+	FPDecimal::to_double(void) const used.
+
+	Numbers too large are clamped to the largest finite value, numbers too
+	small become zero or a denormal.
+
 	If a number is parsed, the character at the end of the string after
 	whitespace is removed is the one pointed by pDest.
 
@@ -1027,236 +1050,35 @@ double BURGER_API Burger::AsciiToDouble(
 		}
 	}
 
-	// Now, lets parse xxx.xxx
-	// I'm going to make it easy on myself.
-	// I'll copy the digits, sans the period and all leading and trailing zeros.
-	// I will parse a maximum of 18 digits
-
-	uint_t uDigitCount = 0;     // Number of digits in my buffer
-	uint_t uFractionDigits = 0; // Nothing parsed after the period
-	// Set to true if a number of any kind (Like all zeros) was found
-	uint_t bNumberFound = FALSE;
-
-	// Buffer for digits converted to 0-9 (DO NOT CHANGE THE SIZE!)
-	uint8_t DigitBuffer[18];
-
-	for (;;) {
-		if (uTemp == '.') {        // Is this a period?
-			if (uFractionDigits) { // Already got one?
-				break;             // Can't do double periods!
-			}
-			uFractionDigits =
-				1; // Start the counter by setting this to non-zero
-		} else {
-			const uint_t uVal = uTemp - '0'; // Precompute
-			if (uVal >=
-				10) { // Only take numbers (Also breaks on null terminator)
-				break;
-			}
-			bNumberFound = TRUE;   // I got something
-			if (uFractionDigits) { // After the period?
-				++uFractionDigits; // Add to total (Note, all digits AFTER the
-								   // period count
-			}
-			if (uDigitCount || uVal) { // Suppress leading zeros
-				if (uDigitCount < sizeof(DigitBuffer)) { // Buffer overrun? Bad.
-					DigitBuffer[uDigitCount] = static_cast<uint8_t>(uVal);
-				}
-				++uDigitCount;
-			}
-		}
-		uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-		++pInput;
-	}
-
-	// Did I parse ANY number?
-	// -.e1 is NOT considered a floating point number
-	// Accept NOTHING and return 0.0 as my failure condition
-
-	if (!bNumberFound) {
+	// Now, lets parse xxx.xxx, pInput is one character past uTemp
+	--pInput;
+	DecimalScan_t Scan;
+	const char* pEnd = ScanDecimal(&Scan, pInput);
+	if (!pEnd) {
 		return 0.0; // Forget it. Error.
 	}
 
-	// At this point, I've parsed up to 18 digits
-	// I need to get the exponent
-
-	int iExponent = 0;                // Assume no extra shifting of the digits
-	if (!((uTemp ^ 'E') & (~0x20))) { // E or e Exponent token?
-		const char* pInput2 = pInput; // Save the mark
-
-		uTemp = reinterpret_cast<const uint8_t*>(pInput2)[0];
-		++pInput2;
-		uint_t bNegExponent = FALSE; // Assume a positive exponent
-		if (uTemp == '+') {
-			uTemp = reinterpret_cast<const uint8_t*>(pInput2)[0];
-			++pInput2;
-		} else if (uTemp == '-') {
-			bNegExponent = TRUE;
-			uTemp = reinterpret_cast<const uint8_t*>(pInput2)[0];
-			++pInput2;
-		}
-		uTemp -= '0';
-		if (uTemp < 10) {
-			do {
-				if (iExponent < 1000) { // Prevent overflow
-					iExponent = (iExponent * 10) + static_cast<int>(uTemp);
-				}
-				uTemp = reinterpret_cast<const uint8_t*>(pInput2)[0];
-				++pInput2;
-				uTemp -= '0';
-			} while (uTemp < 10);
-
-			pInput =
-				pInput2; // Since I got an e102 or e-1, I'll accept this input
-			// This is the only place where exponent could be non-zero
-			if (bNegExponent) {
-				iExponent = -iExponent;
-			}
-		}
-	}
-
 	// Mark the requested ASCII marker
-
 	if (pDest) {
-		// Back step 1 char, but this is where I stopped parsing.
-		pDest[0] = pInput - 1;
-	}
-
-	// Since I've got an exponent and up to 18 digits of mantissa,
-	// let's make a floating point number.
-
-	if (uFractionDigits) { // Did I find a period?
-		// Adjust the exponent for how many digits there were to the right of
-		// the period (The +1 was the flag that I got something)
-		iExponent -= uFractionDigits - 1;
-	}
-
-	// I counted the number of digits, but the buffer may not hold them all. Add
-	// the truncated count to the exponent
-
-	if (uDigitCount > sizeof(DigitBuffer)) { // Clipped?
-		// Add the clipped count
-		iExponent += uDigitCount - static_cast<uint_t>(sizeof(DigitBuffer));
-
-		// Force my counter for parsing to the right amount
-		uDigitCount = static_cast<uint_t>(sizeof(DigitBuffer));
-	}
-
-	// Dispose of trailing zeros (It helps with precision)
-
-	if (uDigitCount) {
-		do {
-			if (DigitBuffer[uDigitCount - 1]) { // Last digit, non-zero?
-				break;                          // Don't touch it
-			}
-			++iExponent; // Adjust the exponent
-		} while (--uDigitCount); // Count down
-		if (!uDigitCount) { // Did I remove all of the digits?
-			return 0.0;     // 0 exponent anything, is still zero
-		}
+		pDest[0] = pEnd;
 	}
 
-	// Since we've got something to be converted into a number, let's parse it.
-	// PROBLEM: A 32 bit long can only store 9 digits safely, so I take the 18
-	// digits I have and split them into two longs of 9 digits each. Then I'll
-	// merge the two using the double unit.
-
-	const uint8_t* pBuffer = DigitBuffer;
-	int32_t iHigh9 = 0;    // High 9 digits
-	if (uDigitCount > 9) { // 1-18
-		// Parse up to 9 digits
-		uint_t i1 = uDigitCount - 9; // 1-9
-		do {
-			iHigh9 = (iHigh9 * 10) + static_cast<int32_t>(pBuffer[0]);
-			++pBuffer;
-		} while (--i1);
-	}
-
-	int32_t iLow9 = 0; // Low 9 digits
-	uint_t i2 = uDigitCount;
-	if (i2 > 9) {
-		i2 = 9; // Clamp
-	}
-	if (i2) {
-		do {
-			iLow9 = (iLow9 * 10) + static_cast<int32_t>(pBuffer[0]);
-			++pBuffer;
-		} while (--i2);
-	}
-
-	// Merge the two 32 bit integers into a 64 bit float
-
+	// If the digits past the 19th could change the result, convert all of
+	// them
 	double dResult =
-		(static_cast<double>(iHigh9) * 1e9) + static_cast<double>(iLow9);
-
-	// Apply the exponent, if any.
-
-	if (iExponent) { // Do I bother?
-		if (iExponent < 0) {
-
-			// I'm going to shrink the number via division
-
-			// I'm performing the division operation instead of the reciprocal
-			// multiplies because I want to retain as much precision as I can.
-
-			// Get abs value
-			uint_t uCount1 = static_cast<uint_t>(-iExponent);
-
-			// This is for really stupid numbers
-
-			if (uCount1 >= 308) {
-				dResult /= 1e308;
-				uCount1 -= 308;
-			}
-			if (uCount1) {
-				const double* pPower1 = PowerOf10DblTable;
-				double dScalar1 = 1.0;
-				do {
-					// Using a double table, I'll get the right power of 10
-					if (uCount1 & 1) {
-						dScalar1 *= pPower1[0];
-					}
-					++pPower1;
-					uCount1 >>= 1;
-				} while (uCount1); // Keep going until I'm done
-				dResult /= dScalar1; // Shrink the number
-			}
-		} else {
-
-			// Same as above, but I'm growing the number this time
-
-			uint_t uCount2 = static_cast<uint_t>(iExponent);
-
-			// This is for really stupid numbers
-
-			if (uCount2 >= 308) {
-				dResult *= 1e308;
-				uCount2 -= 308;
-			}
-			if (uCount2) {
-				const double* pPower2 = PowerOf10DblTable;
-				double dScalar2 = 1.0;
-				do {
-					if (uCount2 & 1) {
-						dScalar2 *= pPower2[0];
-					}
-					++pPower2;
-					uCount2 >>= 1;
-				} while (uCount2);
-				dResult *= dScalar2;
-			}
-		}
+		FPDecimal::scale_to_double(Scan.m_uMantissa, Scan.m_iExponent);
+	if (Scan.m_bTruncated &&
+		(dResult !=
+			FPDecimal::scale_to_double(
+				Scan.m_uMantissa + 1U, Scan.m_iExponent))) {
+		FPDecimal Decimal;
+		Decimal.parse(pInput);
+		dResult = Decimal.to_double();
 	}
 
-	// Okay, I've got the number. Detect overflow
-
-	iExponent += uDigitCount;
-	if (iExponent > (308 + 1)) { // Was the exponent nuts?
-		dResult = g_dMax;        // Grab a constant
-
-		// Was the exponent nuts in the other direction?
-	} else if (iExponent < ((-308) + 1)) {
-		dResult = g_dMin; // Grab a constant
+	// Was the exponent nuts?
+	if (dResult > g_dMax) {
+		dResult = g_dMax; // Grab a constant
 	}
 	return dResult * dNegative; // Return the answer
 }
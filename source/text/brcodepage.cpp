@@ -13,6 +13,20 @@
 ***************************************/
 
 #include "brcodepage.h"
+#include "brmemoryfunctions.h"
+#include "brstringfunctions.h"
+
+// Select the vector unit used for scanning for high ASCII
+#if defined(BURGER_SSE2) && defined(BURGER_INTEL) && \
+	(defined(BURGER_MSVC) || defined(BURGER_GNUC) || defined(BURGER_CLANG) || \
+		defined(BURGER_INTEL_COMPILER)) && \
+	!defined(DOXYGEN)
+#define USE_SSE2
+#include <emmintrin.h>
+#elif defined(BURGER_NEON) && defined(BURGER_ARM64) && !defined(DOXYGEN)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
 
 /*! ************************************
 
@@ -37,6 +51,159 @@
 
 ***************************************/
 
+/*! ************************************
+
+	\brief Find the length of a run of low ASCII characters.
+
+	Scan a buffer for the first byte that has the high bit set and return the
+	number of bytes before it. All of the 8 bit code pages and UTF8 share the
+	values 0x00 through 0x7F, so this run can be copied without translation.
+
+	On CPUs with SSE2 or NEON, the buffer is scanned 32 bytes at a time.
+
+	\param pInput Pointer to the buffer to scan. \ref nullptr is okay if
+		uInputSize is zero.
+	\param uInputSize Number of bytes in the buffer.
+
+	\return Number of bytes from 0x00 to 0x7F at the start of the buffer.
+
+	\sa count_high_ASCII(const char*, uintptr_t)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::ASCII_span(
+	const char* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT
+{
+	const uint8_t* pWork = reinterpret_cast<const uint8_t*>(pInput);
+
+#if defined(USE_SSE2) || defined(USE_NEON)
+	// Test 32 bytes at a time
+	while (uInputSize >= 32U) {
+#if defined(USE_SSE2)
+		const __m128i vInput1 =
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWork));
+		const __m128i vInput2 =
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWork + 16));
+		if (_mm_movemask_epi8(_mm_or_si128(vInput1, vInput2))) {
+			break;
+		}
+#else
+		if (vmaxvq_u8(vorrq_u8(vld1q_u8(pWork), vld1q_u8(pWork + 16))) >=
+			0x80U) {
+			break;
+		}
+#endif
+		pWork += 32;
+		uInputSize -= 32U;
+	}
+#if defined(USE_SSE2)
+	// Find the exact byte in the final 16 byte blocks
+	while (uInputSize >= 16U) {
+		const uint32_t uMask = static_cast<uint32_t>(_mm_movemask_epi8(
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWork))));
+		if (uMask) {
+#if defined(BURGER_MSVC)
+			unsigned long uIndex;
+			_BitScanForward(&uIndex, uMask);
+			return static_cast<uintptr_t>(
+					   pWork - reinterpret_cast<const uint8_t*>(pInput)) +
+				uIndex;
+#else
+			return static_cast<uintptr_t>(
+					   pWork - reinterpret_cast<const uint8_t*>(pInput)) +
+				static_cast<uint_t>(__builtin_ctz(uMask));
+#endif
+		}
+		pWork += 16;
+		uInputSize -= 16U;
+	}
+#endif
+#endif
+
+	// Finish up one byte at a time
+	if (uInputSize) {
+		do {
+			if (pWork[0] >= 0x80U) {
+				break;
+			}
+			++pWork;
+		} while (--uInputSize);
+	}
+	return static_cast<uintptr_t>(
+		pWork - reinterpret_cast<const uint8_t*>(pInput));
+}
+
+/*! ************************************
+
+	\brief Count the number of high ASCII characters in a buffer.
+
+	Count the bytes that are 0x80 or higher. This is the number of
+	characters that need a table lookup to convert an 8 bit code page to
+	another encoding.
+
+	On CPUs with SSE2 or NEON, the high bits of 16 bytes are counted at a
+	time with a vector population count.
+
+	\param pInput Pointer to the buffer to scan. \ref nullptr is okay if
+		uInputSize is zero.
+	\param uInputSize Number of bytes in the buffer.
+
+	\return Number of bytes from 0x80 to 0xFF in the buffer.
+
+	\sa ASCII_span(const char*, uintptr_t)
+
+***************************************/
+
+uintptr_t BURGER_API Burger::count_high_ASCII(
+	const char* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT
+{
+	const uint8_t* pWork = reinterpret_cast<const uint8_t*>(pInput);
+	uintptr_t uResult = 0;
+
+#if defined(USE_SSE2) || defined(USE_NEON)
+	while (uInputSize >= 16U) {
+		// Each byte counter can hold 255 blocks before overflowing
+		uintptr_t uBlocks = uInputSize >> 4U;
+		if (uBlocks > 255U) {
+			uBlocks = 255U;
+		}
+		uInputSize -= uBlocks << 4U;
+#if defined(USE_SSE2)
+		const __m128i vZero = _mm_setzero_si128();
+		__m128i vCount = vZero;
+		do {
+			// Subtract -1 for every byte that's negative
+			vCount = _mm_sub_epi8(vCount,
+				_mm_cmplt_epi8(
+					_mm_loadu_si128(reinterpret_cast<const __m128i*>(pWork)),
+					vZero));
+			pWork += 16;
+		} while (--uBlocks);
+		// Sum the 16 counters
+		vCount = _mm_sad_epu8(vCount, vZero);
+		uResult += static_cast<uintptr_t>(_mm_cvtsi128_si32(vCount)) +
+			static_cast<uintptr_t>(
+				_mm_cvtsi128_si32(_mm_unpackhi_epi64(vCount, vCount)));
+#else
+		uint8x16_t vCount = vdupq_n_u8(0);
+		do {
+			vCount = vaddq_u8(vCount, vshrq_n_u8(vld1q_u8(pWork), 7));
+			pWork += 16;
+		} while (--uBlocks);
+		uResult += vaddlvq_u8(vCount);
+#endif
+	}
+#endif
+
+	if (uInputSize) {
+		do {
+			uResult += pWork[0] >> 7U;
+			++pWork;
+		} while (--uInputSize);
+	}
+	return uResult;
+}
+
 /*! ************************************
 
 	\brief Translate a single UTF8 stream character into a mapped 8 bit char.
@@ -164,102 +331,10 @@ uintptr_t BURGER_API Burger::translate_from_UTF8(char* pOutput,
 	uintptr_t uOutputSize, const char* pInput,
 	const uint8_t pTranslateTable[128][4]) BURGER_NOEXCEPT
 {
-	// Keep pOutput intact to determine the length of the final string
-	uint8_t* pWork = reinterpret_cast<uint8_t*>(pOutput);
-
-	// If nonzero, then append a 0 to the string.
-	const uintptr_t bAddZero = uOutputSize;
-
-	// Valid?
-	if (uOutputSize) {
-		// Remove space for terminating zero
-		--uOutputSize;
-	}
-
-	// This is the end of the valid buffer
-	const uint8_t* pEnd = pWork + uOutputSize;
-
-	// Let's convert the string
-	uint_t uFirst = reinterpret_cast<const uint8_t*>(pInput)[0];
-
-	// Accept it
-	++pInput;
-
-	// Can I start the loop?
-	if (uFirst) {
-		do {
-
-			// Get a char
-			// ASCII?
-			if (uFirst < 0x80U) {
-
-				// Can I write?
-				if (pWork < pEnd) {
-					pWork[0] = static_cast<uint8_t>(uFirst);
-				}
-				// Increment the output
-				++pWork;
-
-				// Valid multibyte opcode?
-			} else if (uFirst >= 0xC2U) {
-
-				// Make a copy of the pointer
-				const uint8_t(*pTranslateTable2)[4] = pTranslateTable;
-
-				// Great, it's not low ASCII. Do it the hard way.
-
-				// Number of attempts
-				uint_t uCounter = 128U;
-				const uint_t uSecond =
-					reinterpret_cast<const uint8_t*>(pInput)[0];
-				do {
-					if ((uFirst == pTranslateTable2[0][0]) &&
-						(uSecond == pTranslateTable2[0][1])) {
-						const uint_t uTemp = pTranslateTable2[0][2];
-
-						// 2 byte code?
-						if (!uTemp) {
-							++pInput;
-							break;
-						}
-						// 3 byte code?
-						if ((reinterpret_cast<const uint8_t*>(pInput)[1] ==
-								uTemp)) {
-							pInput += 2;
-							break;
-						}
-					}
-
-					// Next 4 byte entry
-					++pTranslateTable2;
-				} while (--uCounter);
-
-				// Did I get a valid code?
-				if (uCounter) {
-
-					// Write it out
-					if (pWork < pEnd) {
-						pWork[0] = static_cast<uint8_t>(256U - uCounter);
-					}
-					++pWork;
-				}
-			}
-			uFirst = reinterpret_cast<const uint8_t*>(pInput)[0];
-
-			// Accept it
-			++pInput;
-		} while (uFirst);
-	}
-
-	// Can I add a trailing zero?
-	if (bAddZero) {
-
-		// Write it, but don't add it to the strlen()
-		pWork[0] = 0;
-	}
-
-	// Return the equivalent of strlen()
-	return static_cast<uintptr_t>(reinterpret_cast<char*>(pWork) - pOutput);
+	// The length is found with a vector scan, so it's faster to let the byte
+	// array version do the work.
+	return translate_from_UTF8(pOutput, uOutputSize, pInput,
+		string_length(pInput), pTranslateTable);
 }
 
 /*! ************************************
@@ -315,31 +390,39 @@ uintptr_t BURGER_API Burger::translate_from_UTF8(char* pOutput,
 	}
 
 	// Can't write, ever
-	const uint8_t* pEnd = pWork + uOutputSize;
+	uint8_t* pEnd = pWork + uOutputSize;
 
 	// Let's convert the string
 
 	// Sanity check
 	if (uInputSize) {
 		do {
+			// Copy runs of low ASCII as is
+			const uintptr_t uRun = ASCII_span(pInput, uInputSize);
+			if (uRun) {
+				// Copy as much as will fit
+				if (pWork < pEnd) {
+					uintptr_t uCopy = static_cast<uintptr_t>(pEnd - pWork);
+					if (uCopy > uRun) {
+						uCopy = uRun;
+					}
+					memory_copy(pWork, pInput, uCopy);
+				}
+				pWork += uRun;
+				pInput += uRun;
+				uInputSize -= uRun;
+				if (!uInputSize) {
+					break;
+				}
+			}
+
+			// This is a high ASCII character
 			const uint_t uFirst = reinterpret_cast<const uint8_t*>(pInput)[0];
 			// Accept it
 			++pInput;
 
-			// Get a char
-
-			// ASCII?
-			if (uFirst < 0x80U) {
-
-				// Can I write?
-				if (pWork < pEnd) {
-					pWork[0] = static_cast<uint8_t>(uFirst);
-				}
-				// Increment the output
-				// Must have at least 2 bytes pending
-				++pWork;
-
-			} else if ((uFirst >= 0xC2U) && (uInputSize >= 2U)) {
+			// Must have at least 2 bytes pending
+			if ((uFirst >= 0xC2U) && (uInputSize >= 2U)) {
 
 				// Make a copy of the pointer
 				const uint8_t(*pTranslateTable2)[4] = pTranslateTable;
@@ -389,9 +472,12 @@ uintptr_t BURGER_API Burger::translate_from_UTF8(char* pOutput,
 
 	// Can I add a trailing zero?
 	if (bAddZero) {
-
+		// Don't write past the end of the buffer if truncated
+		if (pWork < pEnd) {
+			pEnd = pWork;
+		}
 		// Write it, but don't add it to the strlen()
-		pWork[0] = 0U;
+		pEnd[0] = 0U;
 	}
 
 	// Return the equivalent of strlen()
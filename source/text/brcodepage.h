@@ -26,6 +26,10 @@ struct CodePage {
 	static const uint32_t kInvalid = UINT32_MAX;
 };
 
+extern uintptr_t BURGER_API ASCII_span(
+	const char* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT;
+extern uintptr_t BURGER_API count_high_ASCII(
+	const char* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT;
 extern uint32_t BURGER_API translate_from_UTF8(
 	const char* pInput, const uint8_t pTranslateTable[128][4]) BURGER_NOEXCEPT;
 extern uintptr_t BURGER_API translate_from_UTF8(char* pOutput,
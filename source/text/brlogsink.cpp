@@ -0,0 +1,943 @@
+/***************************************
+
+	Buffered asynchronous log output
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#include "brlogsink.h"
+#include "bratomic.h"
+#include "brglobalmemorymanager.h"
+#include "brmemoryfunctions.h"
+#include "brpoweroftwo.h"
+#include "brstring.h"
+#include "brstringfunctions.h"
+
+#include <signal.h>
+#include <stdlib.h>
+
+// Platforms that can write to a file descriptor from a signal handler
+#if (defined(BURGER_WINDOWS) || defined(BURGER_DARWIN) || \
+	defined(BURGER_LINUX) || defined(BURGER_ANDROID)) && \
+	!defined(__MSL__)
+
+#if defined(BURGER_WINDOWS)
+#include <io.h>
+#else
+#include <unistd.h>
+#define USE_SIGACTION
+#endif
+
+#define USE_FILE_DESCRIPTOR
+#endif
+
+// Sink to flush if the application crashes
+static Burger::LogSink* g_pCrashSink;
+
+// Set to TRUE once the crash handlers were installed
+static uint_t g_bCrashHandlerInstalled;
+
+// Signals that flush the log
+static const int g_CrashSignals[4] = {SIGABRT, SIGSEGV, SIGILL, SIGFPE};
+
+#if defined(USE_SIGACTION)
+// Actions the application had installed before the crash handlers
+static struct sigaction g_PreviousActions[4];
+#else
+typedef void(BURGER_ANSIAPI* SignalProc_t)(int iSignal);
+
+// Handlers the application had installed before the crash handlers
+static SignalProc_t g_PreviousHandlers[4];
+#endif
+
+#if defined(USE_FILE_DESCRIPTOR)
+// Write to a file descriptor, safe to call from a signal handler
+static void WriteFileDescriptor(int iFile, const char* pText, uint32_t uLength)
+{
+	while (uLength) {
+		const int iWritten = static_cast<int>(write(iFile, pText, uLength));
+		if (iWritten <= 0) {
+			break;
+		}
+		pText += iWritten;
+		uLength -= static_cast<uint32_t>(iWritten);
+	}
+}
+#endif
+
+/*! ************************************
+
+	\class Burger::LogSink
+	\brief Buffered log output written by a background thread
+
+	Printing with Fprintf() or Debug::Message() writes to the file on the
+	calling thread, so a thread that logs a lot waits on the C library's
+	stream lock and on the disk. LogSink moves that work to a background
+	thread.
+
+	Each thread that writes to the sink is given its own ring buffer, found
+	with thread local storage, so writing a message is a memory copy with no
+	locks. The background thread wakes up every few milliseconds, or when a
+	buffer is half full, and sends all the buffered text to the file in a
+	batch.
+
+	When a thread's buffer is full, the \ref eOverflowPolicy decides if the
+	message is thrown away or the thread waits for the background thread to
+	make room.
+
+	Messages from a single thread are always written in order and are never
+	split, but messages from different threads are grouped by thread in each
+	batch.
+
+	\code
+	static Burger::LogSink g_Log;
+
+	g_Log.start(stdout);
+	g_Log.install_crash_handler();
+	Burger::Debug::set_log_sink(&g_Log);
+
+	Burger::Fprintf(&g_Log, "Frame %u took %d us\n", uFrame, iMicroseconds);
+	\endcode
+
+	\note Threads that write to the sink must have finished before
+		shutdown() is called or their last messages may not be written.
+
+	\sa Fprintf(LogSink*, const char*, uintptr_t, const ArgumentType**) or
+		Debug::set_log_sink(LogSink*)
+
+***************************************/
+
+/*! ************************************
+
+	\brief Default constructor
+
+	Initialize the sink. Nothing is written until start() is called.
+
+	\sa start(FILE*, eOverflowPolicy, uintptr_t, uint32_t)
+
+***************************************/
+
+Burger::LogSink::LogSink() BURGER_NOEXCEPT
+	: m_fp(nullptr),
+	  m_iFileDescriptor(-1),
+	  m_pBuffers(nullptr),
+	  m_uBufferSize(kDefaultBufferSize),
+	  m_uTLSIndex(tls_new_index()),
+	  m_uFlushInterval(kDefaultFlushInterval),
+	  m_uDroppedCount(0),
+	  m_uPolicy(kOverflowDrop),
+	  m_bRunning(FALSE),
+	  m_bQuit(FALSE),
+	  m_bWriterActive(FALSE)
+{
+}
+
+/*! ************************************
+
+	\brief Destructor
+
+	Stop the writer thread, write out everything that was buffered, release
+	the thread buffers and give back the thread local storage index.
+
+	\sa shutdown(void)
+
+***************************************/
+
+Burger::LogSink::~LogSink()
+{
+	shutdown();
+	if (g_pCrashSink == this) {
+		g_pCrashSink = nullptr;
+	}
+
+	// The calling thread won't release its buffer, do it now
+	Buffer_t* pBuffer = static_cast<Buffer_t*>(tls_get(m_uTLSIndex));
+	if (pBuffer) {
+		tls_set(m_uTLSIndex, nullptr);
+		release_buffer(pBuffer);
+	}
+	release_buffers();
+
+	// Other threads release their buffers when they exit
+	tls_release_index(m_uTLSIndex);
+}
+
+/*! ************************************
+
+	\brief Start the writer thread
+
+	Set the file to receive the output and start the background thread that
+	writes to it.
+
+	\param fp FILE stream to write to, such as stdout or a log file
+	\param uPolicy \ref eOverflowPolicy when a thread's buffer is full
+	\param uBufferSize Size in bytes of each thread's buffer, rounded up to a
+		power of 2
+	\param uFlushInterval Milliseconds between writes to the file
+
+	\return \ref kErrorNone if successful
+
+	\sa shutdown(void)
+
+***************************************/
+
+Burger::eError BURGER_API Burger::LogSink::start(FILE* fp,
+	eOverflowPolicy uPolicy, uintptr_t uBufferSize,
+	uint32_t uFlushInterval) BURGER_NOEXCEPT
+{
+	if (!fp) {
+		return kErrorInvalidParameter;
+	}
+	if (m_bRunning) {
+		return kErrorAlreadyInitialized;
+	}
+
+	// Keep the buffers a sane size
+	if (uBufferSize < 256U) {
+		uBufferSize = 256U;
+	} else if (uBufferSize > 0x10000000U) {
+		uBufferSize = 0x10000000U;
+	}
+
+	// Threads that already have a buffer from a previous run keep it
+	m_uBufferSize = power_of_two(uBufferSize);
+
+	m_fp = fp;
+#if defined(USE_FILE_DESCRIPTOR)
+	m_iFileDescriptor = fileno(fp);
+#endif
+	m_uPolicy = uPolicy;
+	m_uFlushInterval = uFlushInterval ? uFlushInterval : 1U;
+	m_bQuit = FALSE;
+
+	atomic_set(&m_bWriterActive, TRUE);
+	const eError uResult = m_Thread.start(writer_thread, this, "LogSink");
+	if (uResult == kErrorNone) {
+		atomic_set(&m_bRunning, TRUE);
+	} else {
+		atomic_set(&m_bWriterActive, FALSE);
+	}
+	return uResult;
+}
+
+/*! ************************************
+
+	\brief Stop the writer thread
+
+	Stop the background thread and write all buffered text. Text written
+	afterwards is sent directly to the file until start() is called again.
+
+	\sa start(FILE*, eOverflowPolicy, uintptr_t, uint32_t)
+
+***************************************/
+
+void BURGER_API Burger::LogSink::shutdown(void) BURGER_NOEXCEPT
+{
+	if (m_bRunning) {
+		atomic_set(&m_bRunning, FALSE);
+
+		m_Lock.lock();
+		m_bQuit = TRUE;
+		m_Wake.signal();
+		m_Lock.unlock();
+		m_Thread.wait();
+
+		// Catch anything written while the thread was exiting
+		flush();
+	}
+}
+
+/*! ************************************
+
+	\brief Write text to the log
+
+	Copy the text into the calling thread's buffer. The background thread
+	will write it to the file later.
+
+	If the sink isn't running, the text is written to the file immediately.
+	If the text is larger than a thread's buffer, the buffers are flushed and
+	the text is written to the file immediately.
+
+	\param pText Pointer to the text to write
+	\param uLength Number of bytes to write
+
+	\return \ref kErrorNone if successful, \ref kErrorBufferTooSmall if the
+		message was dropped
+
+	\sa write(const char*)
+
+***************************************/
+
+Burger::eError BURGER_API Burger::LogSink::write(
+	const char* pText, uintptr_t uLength) BURGER_NOEXCEPT
+{
+	if (!uLength) {
+		return kErrorNone;
+	}
+	if (!m_bRunning) {
+		return write_direct(pText, uLength);
+	}
+
+	// Get this thread's buffer or make one
+	Buffer_t* pBuffer = static_cast<Buffer_t*>(tls_get(m_uTLSIndex));
+	if (!pBuffer) {
+		pBuffer = add_buffer();
+		if (!pBuffer) {
+			return write_direct(pText, uLength);
+		}
+	}
+
+	// Will it ever fit?
+	const uint32_t uSize = pBuffer->m_uMask + 1U;
+	if (uLength > uSize) {
+		// Preserve the order of this thread's messages
+		flush();
+		return write_direct(pText, uLength);
+	}
+
+	const uint32_t uWrite = pBuffer->m_uWrite;
+	uint32_t uUsed = uWrite - atomic_get(&pBuffer->m_uRead);
+	if ((uSize - uUsed) < uLength) {
+		if (m_uPolicy == kOverflowDrop) {
+			atomic_add(&m_uDroppedCount, 1);
+			return kErrorBufferTooSmall;
+		}
+
+		// Wake the writer thread and wait for it to make room
+		m_Lock.lock();
+		for (;;) {
+			uUsed = uWrite - atomic_get(&pBuffer->m_uRead);
+			if (((uSize - uUsed) >= uLength) || !m_bRunning) {
+				break;
+			}
+			m_Wake.signal();
+			m_Drained.wait(&m_Lock, m_uFlushInterval);
+		}
+		m_Lock.unlock();
+
+		// Was the sink stopped while waiting?
+		if ((uSize - uUsed) < uLength) {
+			return write_direct(pText, uLength);
+		}
+	}
+
+	// Copy the text, it may wrap around the end of the buffer
+	const uint32_t uOffset = uWrite & pBuffer->m_uMask;
+	const uint32_t uChunk = uSize - uOffset;
+	if (uChunk >= uLength) {
+		memory_copy(pBuffer->m_pData + uOffset, pText, uLength);
+	} else {
+		memory_copy(pBuffer->m_pData + uOffset, pText, uChunk);
+		memory_copy(pBuffer->m_pData, pText + uChunk, uLength - uChunk);
+	}
+
+	// Publish the text to the writer thread
+	atomic_set(&pBuffer->m_uWrite, uWrite + static_cast<uint32_t>(uLength));
+
+	// Don't wait for the timer if the buffer just passed half full
+	const uint32_t uHalf = uSize >> 1U;
+	if ((uUsed < uHalf) && ((uUsed + uLength) >= uHalf)) {
+		// Signal under the lock, or the wakeup can be lost if the writer
+		// thread is between draining and waiting
+		m_Lock.lock();
+		m_Wake.signal();
+		m_Lock.unlock();
+	}
+	return kErrorNone;
+}
+
+/*! ************************************
+
+	\brief Write a "C" string to the log
+
+	\param pText Pointer to a "C" string
+
+	\return \ref kErrorNone if successful, \ref kErrorBufferTooSmall if the
+		message was dropped
+
+	\sa write(const char*, uintptr_t)
+
+***************************************/
+
+Burger::eError BURGER_API Burger::LogSink::write(
+	const char* pText) BURGER_NOEXCEPT
+{
+	if (!pText) {
+		return kErrorInvalidParameter;
+	}
+	return write(pText, string_length(pText));
+}
+
+/*! ************************************
+
+	\brief Print with a compiled format string to the log
+
+	Format the text on the stack and copy it into the calling thread's
+	buffer. Only text larger than \ref kStackBufferSize bytes allocates
+	memory.
+
+	\param pFormat Pointer to a compiled format string
+	\param uArgCount Number of arguments in the argument array
+	\param ppArgs Argument array, can be \ref nullptr if uArgCount is zero
+
+	\return Number of bytes printed or an \ref eError code on failure
+
+	\sa Fprintf(LogSink*, const char*, uintptr_t, const ArgumentType**)
+
+***************************************/
+
+intptr_t BURGER_API Burger::LogSink::print(const CompiledFormat* pFormat,
+	uintptr_t uArgCount, const ArgumentType** ppArgs) BURGER_NOEXCEPT
+{
+	// Errors are returned as eError codes and leave the buffer empty
+	char Buffer[kStackBufferSize];
+	intptr_t iResult =
+		pFormat->format(Buffer, sizeof(Buffer), uArgCount, ppArgs);
+
+	if (iResult == kErrorBufferTooSmall) {
+		String Overflow;
+		iResult = pFormat->format(&Overflow, uArgCount, ppArgs);
+		if (iResult == static_cast<intptr_t>(Overflow.length())) {
+			const eError uError = write(Overflow.c_str(), Overflow.length());
+			if (uError != kErrorNone) {
+				iResult = uError;
+			}
+		}
+	} else if (iResult == static_cast<intptr_t>(string_length(Buffer))) {
+		const eError uError =
+			write(Buffer, static_cast<uintptr_t>(iResult));
+		if (uError != kErrorNone) {
+			iResult = uError;
+		}
+	}
+	return iResult;
+}
+
+/*! ************************************
+
+	\brief Write all buffered text to the file
+
+	Write the text from every thread's buffer to the file and flush the file.
+	This is done on the calling thread, so when this function returns,
+	everything written before the call is in the file.
+
+	\sa crash_flush(void)
+
+***************************************/
+
+void BURGER_API Burger::LogSink::flush(void) BURGER_NOEXCEPT
+{
+	if (m_fp) {
+		MutexLock Lock(&m_Lock);
+		drain();
+		m_Drained.broadcast();
+	}
+}
+
+/*! ************************************
+
+	\brief Write all buffered text while the application is crashing
+
+	Called from an unhandled exception filter. If the sink's lock is held by
+	another thread while the writer thread is still running, nothing is
+	written, since the writer thread is either draining the buffers or will
+	drain them once the lock is released. If the writer thread has finished,
+	the lock holder may never release it, so the buffers are written anyway.
+
+	\note This is not safe to call from a signal handler, use signal_flush()
+		instead.
+
+	\sa signal_flush(void), install_crash_handler(void) or flush(void)
+
+***************************************/
+
+void BURGER_API Burger::LogSink::crash_flush(void) BURGER_NOEXCEPT
+{
+	if (m_fp) {
+		if (m_Lock.try_lock()) {
+			drain();
+			m_Lock.unlock();
+		} else if (!atomic_get(&m_bWriterActive)) {
+			drain();
+		}
+	}
+}
+
+/*! ************************************
+
+	\brief Write all buffered text from a signal handler
+
+	Send the unread text of every thread's buffer to the file with write(),
+	bypassing the lock and the FILE stream, since neither is safe to use in a
+	signal handler. Text still in the FILE stream's own buffer is not
+	written, and text the writer thread is sending at the same time may be
+	duplicated.
+
+	On platforms without file descriptors, this calls crash_flush().
+
+	\sa crash_flush(void) or install_crash_handler(void)
+
+***************************************/
+
+void BURGER_API Burger::LogSink::signal_flush(void) BURGER_NOEXCEPT
+{
+#if defined(USE_FILE_DESCRIPTOR)
+	const int iFile = m_iFileDescriptor;
+	if (iFile != -1) {
+		Buffer_t* pBuffer = m_pBuffers;
+		while (pBuffer) {
+			const uint32_t uWrite = atomic_get(&pBuffer->m_uWrite);
+			const uint32_t uRead = pBuffer->m_uRead;
+			if (uWrite != uRead) {
+				// Send the text, it may wrap around the end of the buffer
+				const uint32_t uLength = uWrite - uRead;
+				const uint32_t uOffset = uRead & pBuffer->m_uMask;
+				uint32_t uChunk = pBuffer->m_uMask + 1U - uOffset;
+				if (uChunk > uLength) {
+					uChunk = uLength;
+				}
+				WriteFileDescriptor(iFile, pBuffer->m_pData + uOffset, uChunk);
+				if (uChunk != uLength) {
+					WriteFileDescriptor(
+						iFile, pBuffer->m_pData, uLength - uChunk);
+				}
+				atomic_set(&pBuffer->m_uRead, uWrite);
+			}
+			pBuffer = pBuffer->m_pNext;
+		}
+	}
+#else
+	crash_flush();
+#endif
+}
+
+// Called by atexit() to stop the writer thread and flush the log
+static void BURGER_ANSIAPI CrashExit(void)
+{
+	Burger::LogSink* pSink = g_pCrashSink;
+	if (pSink) {
+		pSink->shutdown();
+	}
+}
+
+// Called on a fatal signal to flush the log
+#if defined(USE_SIGACTION)
+static void CrashSignal(int iSignal, siginfo_t* pInfo, void* pContext)
+#else
+static void BURGER_ANSIAPI CrashSignal(int iSignal)
+#endif
+{
+	// Only flush once, the flush itself could crash
+	Burger::LogSink* pSink = g_pCrashSink;
+	g_pCrashSink = nullptr;
+	if (pSink) {
+		pSink->signal_flush();
+	}
+
+	uint_t i = 0;
+	while ((i < (BURGER_ARRAYSIZE(g_CrashSignals) - 1)) &&
+		(g_CrashSignals[i] != iSignal)) {
+		++i;
+	}
+
+	// Restore the application's handler and pass the signal to it
+#if defined(USE_SIGACTION)
+	const struct sigaction* pPrevious = &g_PreviousActions[i];
+	sigaction(iSignal, pPrevious, nullptr);
+	if (pPrevious->sa_flags & SA_SIGINFO) {
+		pPrevious->sa_sigaction(iSignal, pInfo, pContext);
+	} else if (pPrevious->sa_handler == SIG_DFL) {
+		// Let the default handler report the crash
+		raise(iSignal);
+	} else if (pPrevious->sa_handler != SIG_IGN) {
+		pPrevious->sa_handler(iSignal);
+	}
+#else
+	const SignalProc_t pPrevious = g_PreviousHandlers[i];
+	signal(iSignal, pPrevious);
+	if (pPrevious == SIG_DFL) {
+		// Let the default handler report the crash
+		raise(iSignal);
+	} else if (pPrevious != SIG_IGN) {
+		pPrevious(iSignal);
+	}
+#endif
+}
+
+/*! ************************************
+
+	\brief Flush the log if the application exits or crashes
+
+	Install an atexit() handler that calls shutdown() on this sink and signal
+	handlers for SIGABRT, SIGSEGV, SIGILL and SIGFPE that call signal_flush().
+	After the flush, the handler the application had installed for the
+	signal is restored and called, or if there wasn't one, the signal is
+	raised again with the default handler so the crash is reported as it
+	normally would be.
+
+	Only one sink can be flushed on a crash, the last one to call this
+	function.
+
+	\return \ref kErrorNone if successful
+
+	\sa signal_flush(void) or crash_flush(void)
+
+***************************************/
+
+Burger::eError BURGER_API Burger::LogSink::install_crash_handler(
+	void) BURGER_NOEXCEPT
+{
+	g_pCrashSink = this;
+	if (!g_bCrashHandlerInstalled) {
+		g_bCrashHandlerInstalled = TRUE;
+		if (atexit(CrashExit)) {
+			return kErrorGeneric;
+		}
+
+#if defined(USE_SIGACTION)
+		struct sigaction Action;
+		memory_clear(&Action, sizeof(Action));
+		Action.sa_sigaction = CrashSignal;
+		Action.sa_flags = SA_SIGINFO;
+		sigemptyset(&Action.sa_mask);
+		for (uint_t i = 0; i < BURGER_ARRAYSIZE(g_CrashSignals); ++i) {
+			if (sigaction(g_CrashSignals[i], &Action, &g_PreviousActions[i])) {
+				g_PreviousActions[i].sa_handler = SIG_DFL;
+				g_PreviousActions[i].sa_flags = 0;
+			}
+		}
+#else
+		for (uint_t i = 0; i < BURGER_ARRAYSIZE(g_CrashSignals); ++i) {
+			SignalProc_t pPrevious = signal(g_CrashSignals[i], CrashSignal);
+			if (pPrevious == SIG_ERR) {
+				pPrevious = SIG_DFL;
+			}
+			g_PreviousHandlers[i] = pPrevious;
+		}
+#endif
+	}
+	return kErrorNone;
+}
+
+/*! ************************************
+
+	\brief Create a buffer for the calling thread
+
+	Allocate a ring buffer, add it to the list of buffers and attach it to the
+	calling thread with thread local storage.
+
+	\return Pointer to the new buffer or \ref nullptr on failure
+
+***************************************/
+
+Burger::LogSink::Buffer_t* BURGER_API Burger::LogSink::add_buffer(
+	void) BURGER_NOEXCEPT
+{
+	// The ring buffer follows the header
+	Buffer_t* pBuffer = static_cast<Buffer_t*>(
+		allocate_memory(sizeof(Buffer_t) + m_uBufferSize));
+	if (pBuffer) {
+		pBuffer->m_pData = reinterpret_cast<char*>(pBuffer + 1);
+		pBuffer->m_uMask = static_cast<uint32_t>(m_uBufferSize - 1U);
+		pBuffer->m_uWrite = 0;
+		pBuffer->m_uRead = 0;
+		pBuffer->m_uRefCount = 2;
+		pBuffer->m_uOrphaned = FALSE;
+
+		if (tls_set(m_uTLSIndex, pBuffer, thread_exit) != kErrorNone) {
+			free_memory(pBuffer);
+			return nullptr;
+		}
+
+		MutexLock Lock(&m_Lock);
+		pBuffer->m_pNext = m_pBuffers;
+		m_pBuffers = pBuffer;
+	}
+	return pBuffer;
+}
+
+/*! ************************************
+
+	\brief Write text straight to the file
+
+	\param pText Pointer to the text to write
+	\param uLength Number of bytes to write
+
+	\return \ref kErrorNone if successful
+
+***************************************/
+
+Burger::eError BURGER_API Burger::LogSink::write_direct(
+	const char* pText, uintptr_t uLength) BURGER_NOEXCEPT
+{
+	if (!m_fp) {
+		return kErrorNotInitialized;
+	}
+	MutexLock Lock(&m_Lock);
+	if (fwrite(pText, 1, uLength, m_fp) != uLength) {
+		return kErrorWriteFailure;
+	}
+	return kErrorNone;
+}
+
+/*! ************************************
+
+	\brief Write the contents of all buffers to the file
+
+	Buffers of threads that have exited are released once they are empty.
+
+	\note The sink's lock must be held by the caller.
+
+	\return \ref TRUE if any text was written
+
+***************************************/
+
+uint_t BURGER_API Burger::LogSink::drain(void) BURGER_NOEXCEPT
+{
+	uint_t bWrote = FALSE;
+	Buffer_t** ppPrevious = &m_pBuffers;
+	Buffer_t* pBuffer = m_pBuffers;
+	while (pBuffer) {
+		// Test for exit before getting the write mark, so it's the final one
+		const uint32_t uOrphaned = atomic_get(&pBuffer->m_uOrphaned);
+		const uint32_t uWrite = atomic_get(&pBuffer->m_uWrite);
+		const uint32_t uRead = pBuffer->m_uRead;
+
+		if (uWrite != uRead) {
+			// Send the text, it may wrap around the end of the buffer
+			const uint32_t uLength = uWrite - uRead;
+			const uint32_t uOffset = uRead & pBuffer->m_uMask;
+			uint32_t uChunk = pBuffer->m_uMask + 1U - uOffset;
+			if (uChunk > uLength) {
+				uChunk = uLength;
+			}
+			fwrite(pBuffer->m_pData + uOffset, 1, uChunk, m_fp);
+			if (uChunk != uLength) {
+				fwrite(pBuffer->m_pData, 1, uLength - uChunk, m_fp);
+			}
+
+			// Give the space back to the owner
+			atomic_set(&pBuffer->m_uRead, uWrite);
+			bWrote = TRUE;
+		}
+
+		Buffer_t* pNext = pBuffer->m_pNext;
+		if (uOrphaned) {
+			// Owner is gone, dispose of the buffer
+			ppPrevious[0] = pNext;
+			release_buffer(pBuffer);
+		} else {
+			ppPrevious = &pBuffer->m_pNext;
+		}
+		pBuffer = pNext;
+	}
+	if (bWrote) {
+		fflush(m_fp);
+	}
+	return bWrote;
+}
+
+/*! ************************************
+
+	\brief Release the sink's hold on all buffers
+
+	Buffers still attached to a running thread are disposed of when the thread
+	exits.
+
+***************************************/
+
+void BURGER_API Burger::LogSink::release_buffers(void) BURGER_NOEXCEPT
+{
+	MutexLock Lock(&m_Lock);
+	Buffer_t* pBuffer = m_pBuffers;
+	m_pBuffers = nullptr;
+	while (pBuffer) {
+		Buffer_t* pNext = pBuffer->m_pNext;
+		release_buffer(pBuffer);
+		pBuffer = pNext;
+	}
+}
+
+/*! ************************************
+
+	\brief Release a reference to a buffer
+
+	Buffers are shared by the owner thread and the sink, the last one to
+	release it disposes of the memory.
+
+	\param pBuffer Pointer to the buffer to release
+
+***************************************/
+
+void BURGER_API Burger::LogSink::release_buffer(
+	Buffer_t* pBuffer) BURGER_NOEXCEPT
+{
+	if (atomic_add(&pBuffer->m_uRefCount, static_cast<uint32_t>(-1)) == 1U) {
+		free_memory(pBuffer);
+	}
+}
+
+/*! ************************************
+
+	\brief Called by tls_release() when a thread exits
+
+	Mark the thread's buffer so the sink will release it once its text has
+	been written.
+
+	\param pThis Pointer to the thread's Buffer_t
+
+***************************************/
+
+void BURGER_API Burger::LogSink::thread_exit(void* pThis) BURGER_NOEXCEPT
+{
+	Buffer_t* pBuffer = static_cast<Buffer_t*>(pThis);
+	if (pBuffer) {
+		atomic_set(&pBuffer->m_uOrphaned, TRUE);
+		release_buffer(pBuffer);
+	}
+}
+
+/*! ************************************
+
+	\brief Background thread that writes the buffers
+
+	Wake up every flush interval or when signaled and write all the buffered
+	text to the file.
+
+	\param pThis Pointer to the LogSink
+
+	\return Zero
+
+***************************************/
+
+uintptr_t BURGER_API Burger::LogSink::writer_thread(void* pThis) BURGER_NOEXCEPT
+{
+	LogSink* pSink = static_cast<LogSink*>(pThis);
+	MutexLock Lock(&pSink->m_Lock);
+
+	// Drain before waiting, a thread may have filled its buffer already
+	for (;;) {
+		pSink->drain();
+		pSink->m_Drained.broadcast();
+		if (pSink->m_bQuit) {
+			break;
+		}
+		pSink->m_Wake.wait(&pSink->m_Lock, pSink->m_uFlushInterval);
+	}
+
+	// The buffers are no longer touched by this thread
+	atomic_set(&pSink->m_bWriterActive, FALSE);
+	return 0;
+}
+
+/*! ************************************
+
+	\fn uint_t Burger::LogSink::is_running(void) const
+	\brief Test if the writer thread is running
+
+	\return \ref TRUE if start() was called and shutdown() has not
+
+***************************************/
+
+/*! ************************************
+
+	\fn uint32_t Burger::LogSink::get_dropped_count(void) const
+	\brief Number of messages discarded
+
+	With the \ref kOverflowDrop policy, messages are discarded if the thread's
+	buffer is full. This is the running count of discarded messages.
+
+	\return Number of messages that were not written
+
+***************************************/
+
+/*! ************************************
+
+	\fn eOverflowPolicy Burger::LogSink::get_policy(void) const
+	\brief Get the policy for full buffers
+
+	\return The \ref eOverflowPolicy set by start()
+
+***************************************/
+
+/*! ************************************
+
+	\brief fprintf() to a LogSink
+
+	Format the text on the stack and copy it into the calling thread's
+	buffer in the sink. Only text larger than \ref LogSink::kStackBufferSize
+	bytes allocates memory.
+
+	\param pSink Pointer to a LogSink
+	\param pFormat Pointer to a "C" format string
+	\param uArgCount Number of arguments in the argument array
+	\param ppArgs Argument array, can be \ref nullptr if uArgCount is zero
+
+	\return Number of bytes printed or an \ref eError code on failure
+
+	\sa Fprintf(FILE*, const char*, uintptr_t, const ArgumentType**) or
+		LogSink::print(const CompiledFormat*, uintptr_t, const ArgumentType**)
+
+***************************************/
+
+struct LogSinkFormat_t {
+	/** Buffer on the stack */
+	char* m_pBuffer;
+	/** Buffer used if the text doesn't fit on the stack */
+	Burger::String* m_pOverflow;
+	/** Buffer the text was placed in */
+	char* m_pOutput;
+};
+
+static uint_t BURGER_API LogSinkAllocate(uint_t bNoErrors,
+	uintptr_t uRequestedSize, void** ppOutputBuffer, void* pContext)
+{
+	if (!bNoErrors) {
+		return FALSE;
+	}
+	LogSinkFormat_t* pFormat = static_cast<LogSinkFormat_t*>(pContext);
+	char* pOutput = pFormat->m_pBuffer;
+	if (uRequestedSize > Burger::LogSink::kStackBufferSize) {
+		if (pFormat->m_pOverflow->resize(uRequestedSize) !=
+			Burger::kErrorNone) {
+			return FALSE;
+		}
+		pOutput = pFormat->m_pOverflow->data();
+	}
+	pFormat->m_pOutput = pOutput;
+	ppOutputBuffer[0] = pOutput;
+	return TRUE;
+}
+
+intptr_t BURGER_API Burger::Fprintf(LogSink* pSink, const char* pFormat,
+	uintptr_t uArgCount, const ArgumentType** ppArgs) BURGER_NOEXCEPT
+{
+	if (!pSink) {
+		return 0;
+	}
+
+	char Buffer[LogSink::kStackBufferSize];
+	String Overflow;
+	LogSinkFormat_t Context;
+	Context.m_pBuffer = Buffer;
+	Context.m_pOverflow = &Overflow;
+	Context.m_pOutput = nullptr;
+
+	intptr_t iResult = SprintfUserAlloc(
+		LogSinkAllocate, &Context, FALSE, pFormat, uArgCount, ppArgs);
+	if (Context.m_pOutput && (iResult > 0)) {
+		const eError uError =
+			pSink->write(Context.m_pOutput, static_cast<uintptr_t>(iResult));
+		if (uError != kErrorNone) {
+			iResult = uError;
+		}
+	}
+	return iResult;
+}
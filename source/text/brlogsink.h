@@ -0,0 +1,215 @@
+/***************************************
+
+	Buffered asynchronous log output
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#ifndef __BRLOGSINK_H__
+#define __BRLOGSINK_H__
+
+#ifndef __BRTYPES_H__
+#include "brtypes.h"
+#endif
+
+#ifndef __BRERROR_H__
+#include "brerror.h"
+#endif
+
+#ifndef __BRMUTEX_H__
+#include "brmutex.h"
+#endif
+
+#ifndef __BRCONDITIONVARIABLE_H__
+#include "brconditionvariable.h"
+#endif
+
+#ifndef __BRTHREAD_H__
+#include "brthread.h"
+#endif
+
+#ifndef __BRPRINTF_H__
+#include "brprintf.h"
+#endif
+
+/* BEGIN */
+namespace Burger {
+
+class LogSink {
+	BURGER_DISABLE_COPY(LogSink);
+
+public:
+	enum eOverflowPolicy {
+		/** Discard messages that don't fit in the thread's buffer */
+		kOverflowDrop,
+		/** Wait for the writer thread to make room */
+		kOverflowBlock
+	};
+
+	/** Default size in bytes of each thread's buffer */
+	static const uintptr_t kDefaultBufferSize = 0x10000;
+
+	/** Default time in milliseconds between writes to the file */
+	static const uint32_t kDefaultFlushInterval = 50;
+
+	/** Size of the stack buffer used for formatting */
+	static const uintptr_t kStackBufferSize = 512;
+
+protected:
+	/** Ring buffer owned by a single producer thread */
+	struct Buffer_t {
+		/** Next buffer in the sink's list */
+		Buffer_t* m_pNext;
+		/** Pointer to the ring buffer memory */
+		char* m_pData;
+		/** Size of the ring buffer minus one, size is a power of 2 */
+		uint32_t m_uMask;
+		/** Running count of bytes written, only changed by the owner */
+		volatile uint32_t m_uWrite;
+		/** Running count of bytes sent to the file, only changed by the sink */
+		volatile uint32_t m_uRead;
+		/** One reference for the owner thread and one for the sink */
+		volatile uint32_t m_uRefCount;
+		/** Non zero when the owner thread has exited */
+		volatile uint32_t m_uOrphaned;
+	};
+
+	/** Lock for the buffer list and the file */
+	Mutex m_Lock;
+
+	/** Signaled to wake up the writer thread */
+	ConditionVariable m_Wake;
+
+	/** Signaled when the writer thread has emptied the buffers */
+	ConditionVariable m_Drained;
+
+	/** Background writer thread */
+	Thread m_Thread;
+
+	/** File to receive the output */
+	FILE* m_fp;
+
+	/** File descriptor of m_fp for writing from a signal handler */
+	int m_iFileDescriptor;
+
+	/** Linked list of all the thread buffers */
+	Buffer_t* m_pBuffers;
+
+	/** Size in bytes of each new thread buffer */
+	uintptr_t m_uBufferSize;
+
+	/** Thread local storage index for the thread buffers */
+	uint32_t m_uTLSIndex;
+
+	/** Milliseconds between writes to the file */
+	uint32_t m_uFlushInterval;
+
+	/** Number of messages discarded due to full buffers */
+	volatile uint32_t m_uDroppedCount;
+
+	/** \ref eOverflowPolicy for full buffers */
+	eOverflowPolicy m_uPolicy;
+
+	/** \ref TRUE if the writer thread is running */
+	volatile uint32_t m_bRunning;
+
+	/** \ref TRUE if the writer thread was asked to exit */
+	volatile uint32_t m_bQuit;
+
+	/** \ref TRUE until the writer thread has finished draining */
+	volatile uint32_t m_bWriterActive;
+
+public:
+	LogSink() BURGER_NOEXCEPT;
+	~LogSink();
+
+	eError BURGER_API start(FILE* fp, eOverflowPolicy uPolicy = kOverflowDrop,
+		uintptr_t uBufferSize = kDefaultBufferSize,
+		uint32_t uFlushInterval = kDefaultFlushInterval) BURGER_NOEXCEPT;
+	void BURGER_API shutdown(void) BURGER_NOEXCEPT;
+	eError BURGER_API write(
+		const char* pText, uintptr_t uLength) BURGER_NOEXCEPT;
+	eError BURGER_API write(const char* pText) BURGER_NOEXCEPT;
+	intptr_t BURGER_API print(const CompiledFormat* pFormat,
+		uintptr_t uArgCount, const ArgumentType** ppArgs) BURGER_NOEXCEPT;
+	void BURGER_API flush(void) BURGER_NOEXCEPT;
+	void BURGER_API crash_flush(void) BURGER_NOEXCEPT;
+	void BURGER_API signal_flush(void) BURGER_NOEXCEPT;
+	eError BURGER_API install_crash_handler(void) BURGER_NOEXCEPT;
+
+	BURGER_INLINE uint_t is_running(void) const BURGER_NOEXCEPT
+	{
+		return m_bRunning;
+	}
+
+	BURGER_INLINE uint32_t get_dropped_count(void) const BURGER_NOEXCEPT
+	{
+		return m_uDroppedCount;
+	}
+
+	BURGER_INLINE eOverflowPolicy get_policy(void) const BURGER_NOEXCEPT
+	{
+		return m_uPolicy;
+	}
+
+	BURGER_INLINE intptr_t print(
+		const CompiledFormat* pFormat) BURGER_NOEXCEPT
+	{
+		return print(pFormat, 0, nullptr);
+	}
+
+#if !defined(DOXYGEN)
+#define BURGER_TEMPMACRO(N) \
+	BURGER_INLINE intptr_t print( \
+		const CompiledFormat* pFormat, BURGER_SP_ARG##N) \
+	{ \
+		const ArgumentType* ArgTable[N] = {BURGER_SP_INITARG##N}; \
+		return print(pFormat, N, ArgTable); \
+	}
+	BURGER_EXPAND_FORMATTING_FUNCTION(BURGER_TEMPMACRO);
+#undef BURGER_TEMPMACRO
+#endif
+
+protected:
+	Buffer_t* BURGER_API add_buffer(void) BURGER_NOEXCEPT;
+	eError BURGER_API write_direct(
+		const char* pText, uintptr_t uLength) BURGER_NOEXCEPT;
+	uint_t BURGER_API drain(void) BURGER_NOEXCEPT;
+	void BURGER_API release_buffers(void) BURGER_NOEXCEPT;
+	static void BURGER_API release_buffer(Buffer_t* pBuffer) BURGER_NOEXCEPT;
+	static void BURGER_API thread_exit(void* pThis) BURGER_NOEXCEPT;
+	static uintptr_t BURGER_API writer_thread(void* pThis) BURGER_NOEXCEPT;
+};
+
+extern intptr_t BURGER_API Fprintf(LogSink* pSink, const char* pFormat,
+	uintptr_t uArgCount, const ArgumentType** ppArgs) BURGER_NOEXCEPT;
+
+#if !defined(DOXYGEN)
+BURGER_INLINE intptr_t Fprintf(
+	LogSink* pSink, const char* pFormat) BURGER_NOEXCEPT
+{
+	return Fprintf(pSink, pFormat, 0, nullptr);
+}
+
+#define BURGER_TEMPMACRO(N) \
+	BURGER_INLINE intptr_t Fprintf( \
+		LogSink* pSink, const char* pFormat, BURGER_SP_ARG##N) \
+	{ \
+		const ArgumentType* ArgTable[N] = {BURGER_SP_INITARG##N}; \
+		return Fprintf(pSink, pFormat, N, ArgTable); \
+	}
+BURGER_EXPAND_FORMATTING_FUNCTION(BURGER_TEMPMACRO);
+#undef BURGER_TEMPMACRO
+#endif
+
+}
+/* END */
+
+#endif
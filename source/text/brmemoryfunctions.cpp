@@ -14,6 +14,689 @@
 
 #include "brmemoryfunctions.h"
 
+// Select the vector unit used for bulk memory operations
+#if defined(BURGER_SSE2) && defined(BURGER_INTEL) && \
+	(defined(BURGER_MSVC) || defined(BURGER_GNUC) || defined(BURGER_CLANG) || \
+		defined(BURGER_INTEL_COMPILER)) && \
+	!defined(DOXYGEN)
+#define USE_SSE2
+#include <emmintrin.h>
+
+// AVX2 is tested for at runtime
+#if defined(BURGER_AMD64) && \
+	((defined(BURGER_GNUC) && (BURGER_GNUC >= 40900)) || \
+		defined(BURGER_CLANG) || (BURGER_MSVC >= 190000000))
+#define USE_AVX2
+#include "bratomic.h"
+#include <immintrin.h>
+#if defined(BURGER_MSVC)
+#define AVX2_FUNCTION
+#else
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+#endif
+
+#elif defined(BURGER_NEON) && defined(BURGER_ARM64) && !defined(DOXYGEN)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(USE_SSE2) || defined(USE_NEON)
+#include <string.h>
+
+// Copies and fills this size or larger bypass the data cache on stores
+static const uintptr_t kNonTemporalSize = 0x400000U;
+
+#if defined(USE_SSE2)
+typedef __m128i Vector128_t;
+
+static BURGER_INLINE Vector128_t VectorLoad(
+	const uint8_t* pInput) BURGER_NOEXCEPT
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput));
+}
+
+static BURGER_INLINE void VectorStore(
+	uint8_t* pOutput, Vector128_t vInput) BURGER_NOEXCEPT
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput), vInput);
+}
+
+static BURGER_INLINE void VectorStoreAligned(
+	uint8_t* pOutput, Vector128_t vInput) BURGER_NOEXCEPT
+{
+	_mm_store_si128(reinterpret_cast<__m128i*>(pOutput), vInput);
+}
+
+static BURGER_INLINE void VectorStream(
+	uint8_t* pOutput, Vector128_t vInput) BURGER_NOEXCEPT
+{
+	_mm_stream_si128(reinterpret_cast<__m128i*>(pOutput), vInput);
+}
+
+static BURGER_INLINE void VectorFence(void) BURGER_NOEXCEPT
+{
+	_mm_sfence();
+}
+
+static BURGER_INLINE Vector128_t VectorSplat(uint8_t uInput) BURGER_NOEXCEPT
+{
+	return _mm_set1_epi8(static_cast<char>(uInput));
+}
+
+static BURGER_INLINE Vector128_t VectorXor(
+	Vector128_t vInput1, Vector128_t vInput2) BURGER_NOEXCEPT
+{
+	return _mm_xor_si128(vInput1, vInput2);
+}
+
+static BURGER_INLINE Vector128_t VectorOr(
+	Vector128_t vInput1, Vector128_t vInput2) BURGER_NOEXCEPT
+{
+	return _mm_or_si128(vInput1, vInput2);
+}
+
+// One bit per byte in a compare mask
+typedef uint32_t VectorMask_t;
+static const uint_t kMaskShift = 0;
+static const VectorMask_t kMaskAll = 0xFFFFU;
+
+static BURGER_INLINE Vector128_t VectorCompareEqual(
+	Vector128_t vInput1, Vector128_t vInput2) BURGER_NOEXCEPT
+{
+	return _mm_cmpeq_epi8(vInput1, vInput2);
+}
+
+static BURGER_INLINE Vector128_t VectorCompareEqual16(
+	Vector128_t vInput1, Vector128_t vInput2) BURGER_NOEXCEPT
+{
+	return _mm_cmpeq_epi16(vInput1, vInput2);
+}
+
+static BURGER_INLINE VectorMask_t VectorGetMask(
+	Vector128_t vInput) BURGER_NOEXCEPT
+{
+	return static_cast<uint32_t>(_mm_movemask_epi8(vInput));
+}
+
+static BURGER_INLINE Vector128_t VectorSplat16(uint16_t uInput) BURGER_NOEXCEPT
+{
+	return _mm_set1_epi16(static_cast<short>(uInput));
+}
+
+// Add 0x20 to 'A' through 'Z'. Bias by 0x3F so 'A'-'Z' are the lowest
+// signed values, since SSE2 has no unsigned byte compare.
+static BURGER_INLINE Vector128_t VectorToLower(
+	Vector128_t vInput) BURGER_NOEXCEPT
+{
+	const Vector128_t vBias = _mm_add_epi8(vInput, _mm_set1_epi8(0x3F));
+	const Vector128_t vUpper =
+		_mm_cmplt_epi8(vBias, _mm_set1_epi8(static_cast<char>(-102)));
+	return _mm_add_epi8(vInput, _mm_and_si128(vUpper, _mm_set1_epi8(0x20)));
+}
+
+static BURGER_INLINE uint_t FirstSetBit(VectorMask_t uInput) BURGER_NOEXCEPT
+{
+#if defined(BURGER_MSVC)
+	unsigned long uResult;
+	_BitScanForward(&uResult, uInput);
+	return static_cast<uint_t>(uResult);
+#else
+	return static_cast<uint_t>(__builtin_ctz(uInput));
+#endif
+}
+
+static BURGER_INLINE uint_t LastSetBit(VectorMask_t uInput) BURGER_NOEXCEPT
+{
+#if defined(BURGER_MSVC)
+	unsigned long uResult;
+	_BitScanReverse(&uResult, uInput);
+	return static_cast<uint_t>(uResult);
+#else
+	return static_cast<uint_t>(31 - __builtin_clz(uInput));
+#endif
+}
+
+#else
+typedef uint8x16_t Vector128_t;
+
+static BURGER_INLINE Vector128_t VectorLoad(
+	const uint8_t* pInput) BURGER_NOEXCEPT
+{
+	return vld1q_u8(pInput);
+}
+
+static BURGER_INLINE void VectorStore(
+	uint8_t* pOutput, Vector128_t vInput) BURGER_NOEXCEPT
+{
+	vst1q_u8(pOutput, vInput);
+}
+
+static BURGER_INLINE void VectorStoreAligned(
+	uint8_t* pOutput, Vector128_t vInput) BURGER_NOEXCEPT
+{
+	vst1q_u8(pOutput, vInput);
+}
+
+// There is no streaming store intrinsic for NEON
+static BURGER_INLINE void VectorStream(
+	uint8_t* pOutput, Vector128_t vInput) BURGER_NOEXCEPT
+{
+	vst1q_u8(pOutput, vInput);
+}
+
+static BURGER_INLINE void VectorFence(void) BURGER_NOEXCEPT {}
+
+static BURGER_INLINE Vector128_t VectorSplat(uint8_t uInput) BURGER_NOEXCEPT
+{
+	return vdupq_n_u8(uInput);
+}
+
+static BURGER_INLINE Vector128_t VectorXor(
+	Vector128_t vInput1, Vector128_t vInput2) BURGER_NOEXCEPT
+{
+	return veorq_u8(vInput1, vInput2);
+}
+
+static BURGER_INLINE Vector128_t VectorOr(
+	Vector128_t vInput1, Vector128_t vInput2) BURGER_NOEXCEPT
+{
+	return vorrq_u8(vInput1, vInput2);
+}
+
+// Four bits per byte in a compare mask
+typedef uint64_t VectorMask_t;
+static const uint_t kMaskShift = 2;
+static const VectorMask_t kMaskAll = 0xFFFFFFFFFFFFFFFFULL;
+
+static BURGER_INLINE Vector128_t VectorCompareEqual(
+	Vector128_t vInput1, Vector128_t vInput2) BURGER_NOEXCEPT
+{
+	return vceqq_u8(vInput1, vInput2);
+}
+
+static BURGER_INLINE Vector128_t VectorCompareEqual16(
+	Vector128_t vInput1, Vector128_t vInput2) BURGER_NOEXCEPT
+{
+	return vreinterpretq_u8_u16(vceqq_u16(
+		vreinterpretq_u16_u8(vInput1), vreinterpretq_u16_u8(vInput2)));
+}
+
+// Narrow each byte to a nibble, there is no movemask on NEON
+static BURGER_INLINE VectorMask_t VectorGetMask(
+	Vector128_t vInput) BURGER_NOEXCEPT
+{
+	return vget_lane_u64(
+		vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vInput), 4)), 0);
+}
+
+static BURGER_INLINE Vector128_t VectorSplat16(uint16_t uInput) BURGER_NOEXCEPT
+{
+	return vreinterpretq_u8_u16(vdupq_n_u16(uInput));
+}
+
+static BURGER_INLINE Vector128_t VectorToLower(
+	Vector128_t vInput) BURGER_NOEXCEPT
+{
+	const Vector128_t vUpper =
+		vcltq_u8(vsubq_u8(vInput, vdupq_n_u8('A')), vdupq_n_u8(26));
+	return vaddq_u8(vInput, vandq_u8(vUpper, vdupq_n_u8(0x20)));
+}
+
+static BURGER_INLINE uint_t FirstSetBit(VectorMask_t uInput) BURGER_NOEXCEPT
+{
+#if defined(BURGER_MSVC)
+	unsigned long uResult;
+	_BitScanForward64(&uResult, uInput);
+	return static_cast<uint_t>(uResult);
+#else
+	return static_cast<uint_t>(__builtin_ctzll(uInput));
+#endif
+}
+
+static BURGER_INLINE uint_t LastSetBit(VectorMask_t uInput) BURGER_NOEXCEPT
+{
+#if defined(BURGER_MSVC)
+	unsigned long uResult;
+	_BitScanReverse64(&uResult, uInput);
+	return static_cast<uint_t>(uResult);
+#else
+	return static_cast<uint_t>(63 - __builtin_clzll(uInput));
+#endif
+}
+#endif
+
+/***************************************
+
+	Copy 0 to 32 bytes. All data is loaded before it's stored so overlapping
+	buffers in either direction are safe.
+
+***************************************/
+
+static BURGER_INLINE void CopyTiny(
+	uint8_t* pOutput, const uint8_t* pInput, uintptr_t uCount) BURGER_NOEXCEPT
+{
+	if (uCount >= 16U) {
+		// Overlapping head and tail
+		const Vector128_t vHead = VectorLoad(pInput);
+		const Vector128_t vTail = VectorLoad(pInput + uCount - 16U);
+		VectorStore(pOutput, vHead);
+		VectorStore(pOutput + uCount - 16U, vTail);
+	} else if (uCount >= 8U) {
+		// memcpy() of a fixed size compiles to a single unaligned move
+		uint64_t uHead;
+		uint64_t uTail;
+		memcpy(&uHead, pInput, 8U);
+		memcpy(&uTail, pInput + uCount - 8U, 8U);
+		memcpy(pOutput, &uHead, 8U);
+		memcpy(pOutput + uCount - 8U, &uTail, 8U);
+	} else if (uCount >= 4U) {
+		uint32_t uHead;
+		uint32_t uTail;
+		memcpy(&uHead, pInput, 4U);
+		memcpy(&uTail, pInput + uCount - 4U, 4U);
+		memcpy(pOutput, &uHead, 4U);
+		memcpy(pOutput + uCount - 4U, &uTail, 4U);
+	} else if (uCount >= 2U) {
+		uint16_t uHead;
+		uint16_t uTail;
+		memcpy(&uHead, pInput, 2U);
+		memcpy(&uTail, pInput + uCount - 2U, 2U);
+		memcpy(pOutput, &uHead, 2U);
+		memcpy(pOutput + uCount - 2U, &uTail, 2U);
+	} else if (uCount) {
+		pOutput[0] = pInput[0];
+	}
+}
+
+/***************************************
+
+	Copy more than 32 bytes from low to high addresses.
+
+	The first and last 16 bytes are loaded up front and stored last with
+	unaligned writes, which lets the main loop run on an aligned destination
+	without any byte fixups. It also makes the copy safe for overlapping
+	buffers where the destination is below the source.
+
+***************************************/
+
+static void BURGER_API CopyForward(uint8_t* pOutput, const uint8_t* pInput,
+	uintptr_t uCount, uint_t bStream) BURGER_NOEXCEPT
+{
+	const Vector128_t vHead = VectorLoad(pInput);
+	const Vector128_t vTail = VectorLoad(pInput + uCount - 16U);
+	uint8_t* pEnd = pOutput + uCount;
+
+	// Align the destination, the skipped bytes are in vHead
+	const uintptr_t uAlign =
+		(0U - reinterpret_cast<uintptr_t>(pOutput)) & 15U;
+	uint8_t* pWork = pOutput + uAlign;
+	pInput += uAlign;
+	uCount -= uAlign;
+
+	uintptr_t uBlocks = uCount >> 6U;
+	if (uBlocks) {
+		if (bStream) {
+			do {
+				const Vector128_t v0 = VectorLoad(pInput);
+				const Vector128_t v1 = VectorLoad(pInput + 16);
+				const Vector128_t v2 = VectorLoad(pInput + 32);
+				const Vector128_t v3 = VectorLoad(pInput + 48);
+				VectorStream(pWork, v0);
+				VectorStream(pWork + 16, v1);
+				VectorStream(pWork + 32, v2);
+				VectorStream(pWork + 48, v3);
+				pInput += 64;
+				pWork += 64;
+			} while (--uBlocks);
+		} else {
+			do {
+				const Vector128_t v0 = VectorLoad(pInput);
+				const Vector128_t v1 = VectorLoad(pInput + 16);
+				const Vector128_t v2 = VectorLoad(pInput + 32);
+				const Vector128_t v3 = VectorLoad(pInput + 48);
+				VectorStoreAligned(pWork, v0);
+				VectorStoreAligned(pWork + 16, v1);
+				VectorStoreAligned(pWork + 32, v2);
+				VectorStoreAligned(pWork + 48, v3);
+				pInput += 64;
+				pWork += 64;
+			} while (--uBlocks);
+		}
+	}
+
+	// Remaining 16 byte chunks, the partial chunk at the end is in vTail
+	uBlocks = (uCount >> 4U) & 3U;
+	while (uBlocks) {
+		VectorStoreAligned(pWork, VectorLoad(pInput));
+		pInput += 16;
+		pWork += 16;
+		--uBlocks;
+	}
+	if (bStream) {
+		VectorFence();
+	}
+	VectorStore(pOutput, vHead);
+	VectorStore(pEnd - 16, vTail);
+}
+
+/***************************************
+
+	Copy more than 32 bytes from high to low addresses for overlapping
+	buffers where the destination is above the source.
+
+***************************************/
+
+static void BURGER_API CopyBackward(
+	uint8_t* pOutput, const uint8_t* pInput, uintptr_t uCount) BURGER_NOEXCEPT
+{
+	const Vector128_t vHead = VectorLoad(pInput);
+	const Vector128_t vTail = VectorLoad(pInput + uCount - 16U);
+	uint8_t* pTail = pOutput + uCount - 16U;
+
+	// Align the end of the destination, the skipped bytes are in vTail
+	uint8_t* pWork = pOutput + uCount;
+	const uint8_t* pSource = pInput + uCount;
+	const uintptr_t uAlign = reinterpret_cast<uintptr_t>(pWork) & 15U;
+	pWork -= uAlign;
+	pSource -= uAlign;
+	uCount -= uAlign;
+
+	uintptr_t uBlocks = uCount >> 6U;
+	if (uBlocks) {
+		do {
+			pSource -= 64;
+			pWork -= 64;
+			const Vector128_t v0 = VectorLoad(pSource);
+			const Vector128_t v1 = VectorLoad(pSource + 16);
+			const Vector128_t v2 = VectorLoad(pSource + 32);
+			const Vector128_t v3 = VectorLoad(pSource + 48);
+			VectorStoreAligned(pWork + 48, v3);
+			VectorStoreAligned(pWork + 32, v2);
+			VectorStoreAligned(pWork + 16, v1);
+			VectorStoreAligned(pWork, v0);
+		} while (--uBlocks);
+	}
+
+	// Remaining 16 byte chunks, the partial chunk at the start is in vHead
+	uBlocks = (uCount >> 4U) & 3U;
+	while (uBlocks) {
+		pSource -= 16;
+		pWork -= 16;
+		VectorStoreAligned(pWork, VectorLoad(pSource));
+		--uBlocks;
+	}
+	VectorStore(pOutput, vHead);
+	VectorStore(pTail, vTail);
+}
+
+#if defined(USE_AVX2)
+
+/***************************************
+
+	AVX2 version of CopyForward() for large copies, same algorithm using 32
+	byte registers.
+
+***************************************/
+
+static AVX2_FUNCTION void BURGER_API CopyForwardAVX2(uint8_t* pOutput,
+	const uint8_t* pInput, uintptr_t uCount, uint_t bStream) BURGER_NOEXCEPT
+{
+	const __m256i vHead =
+		_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pInput));
+	const __m256i vTail = _mm256_loadu_si256(
+		reinterpret_cast<const __m256i*>(pInput + uCount - 32U));
+	uint8_t* pEnd = pOutput + uCount;
+
+	const uintptr_t uAlign =
+		(0U - reinterpret_cast<uintptr_t>(pOutput)) & 31U;
+	uint8_t* pWork = pOutput + uAlign;
+	pInput += uAlign;
+	uCount -= uAlign;
+
+	uintptr_t uBlocks = uCount >> 7U;
+	if (bStream) {
+		do {
+			const __m256i v0 =
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pInput));
+			const __m256i v1 = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>(pInput + 32));
+			const __m256i v2 = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>(pInput + 64));
+			const __m256i v3 = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>(pInput + 96));
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(pWork), v0);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(pWork + 32), v1);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(pWork + 64), v2);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(pWork + 96), v3);
+			pInput += 128;
+			pWork += 128;
+		} while (--uBlocks);
+	} else {
+		do {
+			const __m256i v0 =
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pInput));
+			const __m256i v1 = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>(pInput + 32));
+			const __m256i v2 = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>(pInput + 64));
+			const __m256i v3 = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>(pInput + 96));
+			_mm256_store_si256(reinterpret_cast<__m256i*>(pWork), v0);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(pWork + 32), v1);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(pWork + 64), v2);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(pWork + 96), v3);
+			pInput += 128;
+			pWork += 128;
+		} while (--uBlocks);
+	}
+
+	uBlocks = (uCount >> 5U) & 3U;
+	while (uBlocks) {
+		_mm256_store_si256(reinterpret_cast<__m256i*>(pWork),
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pInput)));
+		pInput += 32;
+		pWork += 32;
+		--uBlocks;
+	}
+	if (bStream) {
+		_mm_sfence();
+	}
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(pOutput), vHead);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(pEnd - 32), vTail);
+	_mm256_zeroupper();
+}
+
+/***************************************
+
+	Test once if the CPU and operating system support AVX2.
+
+***************************************/
+
+static uint_t g_uAVX2State;
+
+static uint_t BURGER_API HasAVX2(void) BURGER_NOEXCEPT
+{
+	uint_t uState = g_uAVX2State;
+	if (!uState) {
+		Burger::CPUID_t CPUInfo;
+		Burger::CPUID(&CPUInfo);
+		// The OS must save the YMM registers on a context switch
+		uState = (CPUInfo.has_AVX2() && ((CPUInfo.m_uXGETBV & 6U) == 6U)) ?
+			2U :
+			1U;
+		g_uAVX2State = uState;
+	}
+	return uState == 2U;
+}
+#endif
+
+/***************************************
+
+	Copy from low to high addresses with the best vector unit available.
+
+***************************************/
+
+static BURGER_INLINE void CopyForwardDispatch(uint8_t* pOutput,
+	const uint8_t* pInput, uintptr_t uCount, uint_t bStream) BURGER_NOEXCEPT
+{
+#if defined(USE_AVX2)
+	if ((uCount >= 256U) && HasAVX2()) {
+		CopyForwardAVX2(pOutput, pInput, uCount, bStream);
+		return;
+	}
+#endif
+	CopyForward(pOutput, pInput, uCount, bStream);
+}
+
+/***************************************
+
+	Fill memory with a byte value using overlapping head and tail stores.
+
+***************************************/
+
+static void BURGER_API FillMemory(uint8_t* pOutput, uint8_t uFill,
+	uintptr_t uCount) BURGER_NOEXCEPT
+{
+	if (uCount < 16U) {
+		if (uCount >= 8U) {
+			const uint64_t uPattern =
+				static_cast<uint64_t>(uFill) * 0x0101010101010101ULL;
+			reinterpret_cast<uint64_t*>(pOutput)[0] = uPattern;
+			reinterpret_cast<uint64_t*>(pOutput + uCount - 8U)[0] = uPattern;
+		} else if (uCount) {
+			do {
+				pOutput[0] = uFill;
+				++pOutput;
+			} while (--uCount);
+		}
+		return;
+	}
+
+	const Vector128_t vFill = VectorSplat(uFill);
+	VectorStore(pOutput, vFill);
+	VectorStore(pOutput + uCount - 16U, vFill);
+	if (uCount <= 32U) {
+		return;
+	}
+
+	// Aligned stores from the first boundary after the head to the tail
+	uint8_t* pWork = reinterpret_cast<uint8_t*>(
+		(reinterpret_cast<uintptr_t>(pOutput) + 16U) &
+		(~static_cast<uintptr_t>(15U)));
+	uint8_t* pEnd = pOutput + uCount - 16U;
+	uintptr_t uBlocks = static_cast<uintptr_t>(pEnd - pWork) >> 6U;
+	if (uBlocks) {
+		if (uCount >= kNonTemporalSize) {
+			do {
+				VectorStream(pWork, vFill);
+				VectorStream(pWork + 16, vFill);
+				VectorStream(pWork + 32, vFill);
+				VectorStream(pWork + 48, vFill);
+				pWork += 64;
+			} while (--uBlocks);
+			VectorFence();
+		} else {
+			do {
+				VectorStoreAligned(pWork, vFill);
+				VectorStoreAligned(pWork + 16, vFill);
+				VectorStoreAligned(pWork + 32, vFill);
+				VectorStoreAligned(pWork + 48, vFill);
+				pWork += 64;
+			} while (--uBlocks);
+		}
+	}
+	while (pWork < pEnd) {
+		VectorStoreAligned(pWork, vFill);
+		pWork += 16;
+	}
+}
+
+/***************************************
+
+	Exclusive or a buffer with a byte value and store it in another buffer,
+	the buffers can be the same.
+
+***************************************/
+
+static void BURGER_API XorMemory(uint8_t* pOutput, const uint8_t* pInput,
+	uint8_t uXor, uintptr_t uCount) BURGER_NOEXCEPT
+{
+	const Vector128_t vXor = VectorSplat(uXor);
+	uintptr_t uBlocks = uCount >> 6U;
+	if (uBlocks) {
+		do {
+			const Vector128_t v0 = VectorLoad(pInput);
+			const Vector128_t v1 = VectorLoad(pInput + 16);
+			const Vector128_t v2 = VectorLoad(pInput + 32);
+			const Vector128_t v3 = VectorLoad(pInput + 48);
+			VectorStore(pOutput, VectorXor(v0, vXor));
+			VectorStore(pOutput + 16, VectorXor(v1, vXor));
+			VectorStore(pOutput + 32, VectorXor(v2, vXor));
+			VectorStore(pOutput + 48, VectorXor(v3, vXor));
+			pInput += 64;
+			pOutput += 64;
+		} while (--uBlocks);
+	}
+	uBlocks = (uCount >> 4U) & 3U;
+	while (uBlocks) {
+		VectorStore(pOutput, VectorXor(VectorLoad(pInput), vXor));
+		pInput += 16;
+		pOutput += 16;
+		--uBlocks;
+	}
+	uCount &= 15U;
+	while (uCount) {
+		pOutput[0] = static_cast<uint8_t>(pInput[0] ^ uXor);
+		++pInput;
+		++pOutput;
+		--uCount;
+	}
+}
+
+/***************************************
+
+	Exclusive or two buffers and store the result in a third, the output can
+	be the same as either input.
+
+***************************************/
+
+static void BURGER_API XorMemory(uint8_t* pOutput, const uint8_t* pInput1,
+	const uint8_t* pInput2, uintptr_t uCount) BURGER_NOEXCEPT
+{
+	uintptr_t uBlocks = uCount >> 5U;
+	if (uBlocks) {
+		do {
+			const Vector128_t v0 =
+				VectorXor(VectorLoad(pInput1), VectorLoad(pInput2));
+			const Vector128_t v1 =
+				VectorXor(VectorLoad(pInput1 + 16), VectorLoad(pInput2 + 16));
+			VectorStore(pOutput, v0);
+			VectorStore(pOutput + 16, v1);
+			pInput1 += 32;
+			pInput2 += 32;
+			pOutput += 32;
+		} while (--uBlocks);
+	}
+	if (uCount & 16U) {
+		VectorStore(
+			pOutput, VectorXor(VectorLoad(pInput1), VectorLoad(pInput2)));
+		pInput1 += 16;
+		pInput2 += 16;
+		pOutput += 16;
+	}
+	uCount &= 15U;
+	while (uCount) {
+		pOutput[0] = static_cast<uint8_t>(pInput1[0] ^ pInput2[0]);
+		++pInput1;
+		++pInput2;
+		++pOutput;
+		--uCount;
+	}
+}
+
+#endif
+
 /*! ************************************
 
 	\brief Copy raw memory from one buffer to another.
@@ -32,11 +715,31 @@
 		pointers must point to separate buffers. If they are overlapping
 		buffers, the results are undefined.
 
+	\note On CPUs with SSE2 or NEON, the copy is performed with 16 byte
+		unaligned loads into an aligned destination. AVX2 is used for large
+		copies if the CPU supports it, and copies of four megabytes or more use
+		non-temporal stores to avoid flushing the data cache.
+
 	\sa memory_move(), memory_set() and memory_clear()
 
 ***************************************/
 
-#if defined(BURGER_PPC)
+#if defined(USE_SSE2) || defined(USE_NEON)
+
+void BURGER_API Burger::memory_copy(
+	void* pOutput, const void* pInput, uintptr_t uCount) BURGER_NOEXCEPT
+{
+	if (uCount <= 32U) {
+		CopyTiny(static_cast<uint8_t*>(pOutput),
+			static_cast<const uint8_t*>(pInput), uCount);
+	} else {
+		CopyForwardDispatch(static_cast<uint8_t*>(pOutput),
+			static_cast<const uint8_t*>(pInput), uCount,
+			uCount >= kNonTemporalSize);
+	}
+}
+
+#elif defined(BURGER_PPC)
 
 /***************************************
 
@@ -294,6 +997,22 @@ void BURGER_API Burger::memory_copy(
 void BURGER_API Burger::memory_move(
 	void* pOutput, const void* pInput, uintptr_t uCount) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	uint8_t* pDest = static_cast<uint8_t*>(pOutput);
+	const uint8_t* pSource = static_cast<const uint8_t*>(pInput);
+	if (uCount <= 32U) {
+		CopyTiny(pDest, pSource, uCount);
+
+		// Overlapping with the destination above the source?
+	} else if ((pDest > pSource) && (pDest < (pSource + uCount))) {
+		CopyBackward(pDest, pSource, uCount);
+	} else {
+		// Only bypass the cache if the buffers don't overlap
+		CopyForwardDispatch(pDest, pSource, uCount,
+			(uCount >= kNonTemporalSize) &&
+				((pDest + uCount) <= pSource || (pDest > pSource)));
+	}
+#else
 	if (pOutput <= pInput) {
 		memory_copy(pOutput, pInput, uCount);
 	} else if (uCount) {
@@ -307,6 +1026,7 @@ void BURGER_API Burger::memory_move(
 			pOutput = static_cast<uint8_t*>(pOutput) - 1;
 		} while (--uCount);
 	}
+#endif
 }
 
 /*! ************************************
@@ -330,12 +1050,16 @@ void BURGER_API Burger::memory_move(
 void BURGER_API Burger::memory_clear(
 	void* pOutput, uintptr_t uCount) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	FillMemory(static_cast<uint8_t*>(pOutput), 0, uCount);
+#else
 	if (uCount) {
 		do {
 			static_cast<uint8_t*>(pOutput)[0] = 0;
 			pOutput = static_cast<uint8_t*>(pOutput) + 1;
 		} while (--uCount);
 	}
+#endif
 }
 
 /*! ************************************
@@ -360,12 +1084,16 @@ void BURGER_API Burger::memory_clear(
 void BURGER_API Burger::memory_set(
 	void* pOutput, uint8_t uFill, uintptr_t uCount) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	FillMemory(static_cast<uint8_t*>(pOutput), uFill, uCount);
+#else
 	if (uCount) {
 		do {
 			static_cast<uint8_t*>(pOutput)[0] = uFill;
 			pOutput = static_cast<uint8_t*>(pOutput) + 1;
 		} while (--uCount);
 	}
+#endif
 }
 
 /*! ************************************
@@ -386,6 +1114,10 @@ void BURGER_API Burger::memory_set(
 void BURGER_API Burger::MemoryNot(
 	void* pOutput, uintptr_t uCount) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	XorMemory(static_cast<uint8_t*>(pOutput),
+		static_cast<const uint8_t*>(pOutput), 0xFFU, uCount);
+#else
 	if (uCount) {
 		do {
 			static_cast<uint8_t*>(pOutput)[0] =
@@ -393,6 +1125,7 @@ void BURGER_API Burger::MemoryNot(
 			pOutput = static_cast<uint8_t*>(pOutput) + 1;
 		} while (--uCount);
 	}
+#endif
 }
 
 /*! ************************************
@@ -414,6 +1147,10 @@ void BURGER_API Burger::MemoryNot(
 void BURGER_API Burger::MemoryNot(
 	void* pOutput, const void* pInput, uintptr_t uCount) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	XorMemory(static_cast<uint8_t*>(pOutput),
+		static_cast<const uint8_t*>(pInput), 0xFFU, uCount);
+#else
 	if (uCount) {
 		do {
 			static_cast<uint8_t*>(pOutput)[0] =
@@ -422,6 +1159,7 @@ void BURGER_API Burger::MemoryNot(
 			pOutput = static_cast<uint8_t*>(pOutput) + 1;
 		} while (--uCount);
 	}
+#endif
 }
 
 /*! ************************************
@@ -443,6 +1181,10 @@ void BURGER_API Burger::MemoryNot(
 void BURGER_API Burger::MemoryXor(
 	void* pOutput, uint8_t uXor, uintptr_t uCount) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	XorMemory(static_cast<uint8_t*>(pOutput),
+		static_cast<const uint8_t*>(pOutput), uXor, uCount);
+#else
 	if (uCount) {
 		do {
 			static_cast<uint8_t*>(pOutput)[0] = static_cast<uint8_t>(
@@ -450,6 +1192,7 @@ void BURGER_API Burger::MemoryXor(
 			pOutput = static_cast<uint8_t*>(pOutput) + 1;
 		} while (--uCount);
 	}
+#endif
 }
 
 /*! ************************************
@@ -473,6 +1216,10 @@ void BURGER_API Burger::MemoryXor(
 void BURGER_API Burger::MemoryXor(void* pOutput, const void* pInput,
 	uint8_t uXor, uintptr_t uCount) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	XorMemory(static_cast<uint8_t*>(pOutput),
+		static_cast<const uint8_t*>(pInput), uXor, uCount);
+#else
 	if (uCount) {
 		do {
 			static_cast<uint8_t*>(pOutput)[0] = static_cast<uint8_t>(
@@ -481,6 +1228,7 @@ void BURGER_API Burger::MemoryXor(void* pOutput, const void* pInput,
 			pOutput = static_cast<uint8_t*>(pOutput) + 1;
 		} while (--uCount);
 	}
+#endif
 }
 
 /*! ************************************
@@ -503,6 +1251,11 @@ void BURGER_API Burger::MemoryXor(void* pOutput, const void* pInput,
 void BURGER_API Burger::MemoryXor(
 	void* pOutput, const void* pInput, uintptr_t uCount) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	XorMemory(static_cast<uint8_t*>(pOutput),
+		static_cast<const uint8_t*>(pOutput),
+		static_cast<const uint8_t*>(pInput), uCount);
+#else
 	if (uCount) {
 		do {
 			static_cast<uint8_t*>(pOutput)[0] =
@@ -512,6 +1265,7 @@ void BURGER_API Burger::MemoryXor(
 			pOutput = static_cast<uint8_t*>(pOutput) + 1;
 		} while (--uCount);
 	}
+#endif
 }
 
 /*! ************************************
@@ -536,6 +1290,11 @@ void BURGER_API Burger::MemoryXor(
 void BURGER_API Burger::MemoryXor(void* pOutput, const void* pInput1,
 	const void* pInput2, uintptr_t uCount) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	XorMemory(static_cast<uint8_t*>(pOutput),
+		static_cast<const uint8_t*>(pInput1),
+		static_cast<const uint8_t*>(pInput2), uCount);
+#else
 	if (uCount) {
 		do {
 			static_cast<uint8_t*>(pOutput)[0] =
@@ -546,6 +1305,7 @@ void BURGER_API Burger::MemoryXor(void* pOutput, const void* pInput1,
 			pOutput = static_cast<uint8_t*>(pOutput) + 1;
 		} while (--uCount);
 	}
+#endif
 }
 
 /*! ************************************
@@ -572,6 +1332,34 @@ void BURGER_API Burger::MemoryXor(void* pOutput, const void* pInput1,
 int BURGER_API Burger::MemoryCompare(
 	const void* pInput1, const void* pInput2, uintptr_t uCount) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	const uint8_t* pWork1 = static_cast<const uint8_t*>(pInput1);
+	const uint8_t* pWork2 = static_cast<const uint8_t*>(pInput2);
+	while (uCount >= 16U) {
+		const VectorMask_t uMask = VectorGetMask(
+			VectorCompareEqual(VectorLoad(pWork1), VectorLoad(pWork2)));
+		if (uMask != kMaskAll) {
+			// Index of the first mismatch
+			const uint_t uIndex = FirstSetBit(~uMask) >> kMaskShift;
+			return static_cast<int>(pWork1[uIndex]) -
+				static_cast<int>(pWork2[uIndex]);
+		}
+		pWork1 += 16;
+		pWork2 += 16;
+		uCount -= 16U;
+	}
+	while (uCount) {
+		const int iTemp =
+			static_cast<int>(pWork1[0]) - static_cast<int>(pWork2[0]);
+		if (iTemp) {
+			return iTemp;
+		}
+		++pWork1;
+		++pWork2;
+		--uCount;
+	}
+	return 0;
+#else
 	int iTemp = 0;
 	if (uCount) {
 		do {
@@ -586,6 +1374,7 @@ int BURGER_API Burger::MemoryCompare(
 		} while (--uCount); // End of string? (And match!!)
 	}
 	return iTemp; // Perfect match!
+#endif
 }
 
 /*! ************************************
@@ -611,6 +1400,44 @@ int BURGER_API Burger::MemoryCompare(
 int BURGER_API Burger::MemoryCaseCompare(
 	const void* pInput1, const void* pInput2, uintptr_t uCount) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	const uint8_t* pWork1 = static_cast<const uint8_t*>(pInput1);
+	const uint8_t* pWork2 = static_cast<const uint8_t*>(pInput2);
+	while (uCount >= 16U) {
+		const VectorMask_t uMask =
+			VectorGetMask(VectorCompareEqual(VectorToLower(VectorLoad(pWork1)),
+				VectorToLower(VectorLoad(pWork2))));
+		if (uMask != kMaskAll) {
+			// Skip to the first mismatch and let the scalar code handle it
+			const uint_t uIndex = FirstSetBit(~uMask) >> kMaskShift;
+			pWork1 += uIndex;
+			pWork2 += uIndex;
+			uCount = 1;
+			break;
+		}
+		pWork1 += 16;
+		pWork2 += 16;
+		uCount -= 16U;
+	}
+	while (uCount) {
+		uint_t uTemp1 = pWork1[0];
+		uint_t uTemp2 = pWork2[0];
+		if ((uTemp1 - 'A') < 26) { // Convert to lower case
+			uTemp1 = uTemp1 + 32;
+		}
+		if ((uTemp2 - 'A') < 26) {
+			uTemp2 = uTemp2 + 32;
+		}
+		const int iTemp = static_cast<int>(uTemp1 - uTemp2);
+		if (iTemp) {
+			return iTemp;
+		}
+		++pWork1;
+		++pWork2;
+		--uCount;
+	}
+	return 0;
+#else
 	int iTemp = 0;
 	if (uCount) {
 		do {
@@ -631,6 +1458,7 @@ int BURGER_API Burger::MemoryCaseCompare(
 		} while (--uCount); // End of string? (And match!!)
 	}
 	return iTemp; // Perfect match!
+#endif
 }
 
 /*! ************************************
@@ -654,6 +1482,46 @@ int BURGER_API Burger::MemoryCaseCompare(
 char* BURGER_API Burger::MemoryCharacter(
 	const char* pInput, uintptr_t uInputSize, int iChar) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	// Only byte values can match
+	if (!pInput || (static_cast<uint_t>(iChar) > 255U)) {
+		return nullptr;
+	}
+	const uint8_t* pWork = reinterpret_cast<const uint8_t*>(pInput);
+	const Vector128_t vChar = VectorSplat(static_cast<uint8_t>(iChar));
+
+	// Test 64 bytes at a time for any match
+	while (uInputSize >= 64U) {
+		const Vector128_t vMatch = VectorOr(
+			VectorOr(VectorCompareEqual(VectorLoad(pWork), vChar),
+				VectorCompareEqual(VectorLoad(pWork + 16), vChar)),
+			VectorOr(VectorCompareEqual(VectorLoad(pWork + 32), vChar),
+				VectorCompareEqual(VectorLoad(pWork + 48), vChar)));
+		if (VectorGetMask(vMatch)) {
+			break;
+		}
+		pWork += 64;
+		uInputSize -= 64U;
+	}
+	while (uInputSize >= 16U) {
+		const VectorMask_t uMask =
+			VectorGetMask(VectorCompareEqual(VectorLoad(pWork), vChar));
+		if (uMask) {
+			return reinterpret_cast<char*>(const_cast<uint8_t*>(
+				pWork + (FirstSetBit(uMask) >> kMaskShift)));
+		}
+		pWork += 16;
+		uInputSize -= 16U;
+	}
+	while (uInputSize) {
+		if (pWork[0] == static_cast<uint_t>(iChar)) {
+			return reinterpret_cast<char*>(const_cast<uint8_t*>(pWork));
+		}
+		++pWork;
+		--uInputSize;
+	}
+	return nullptr;
+#else
 	// Valid pointer?
 	if (pInput && uInputSize) {
 		// Valid?
@@ -671,6 +1539,7 @@ char* BURGER_API Burger::MemoryCharacter(
 	}
 	// Not found
 	return nullptr;
+#endif
 }
 
 /*! ************************************
@@ -695,6 +1564,31 @@ char* BURGER_API Burger::MemoryCharacter(
 uint16_t* BURGER_API Burger::MemoryCharacter(
 	const uint16_t* pInput, uintptr_t uInputSize, uint_t uChar) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	uInputSize >>= 1U;
+	if (!pInput || (uChar > 0xFFFFU)) {
+		return nullptr;
+	}
+	const Vector128_t vChar = VectorSplat16(static_cast<uint16_t>(uChar));
+	while (uInputSize >= 8U) {
+		const VectorMask_t uMask = VectorGetMask(VectorCompareEqual16(
+			VectorLoad(reinterpret_cast<const uint8_t*>(pInput)), vChar));
+		if (uMask) {
+			return const_cast<uint16_t*>(
+				pInput + (FirstSetBit(uMask) >> (kMaskShift + 1U)));
+		}
+		pInput += 8;
+		uInputSize -= 8U;
+	}
+	while (uInputSize) {
+		if (pInput[0] == uChar) {
+			return const_cast<uint16_t*>(pInput);
+		}
+		++pInput;
+		--uInputSize;
+	}
+	return nullptr;
+#else
 	// Valid pointer?
 	uInputSize >>= 1U;
 	if (pInput && uInputSize) {
@@ -713,6 +1607,7 @@ uint16_t* BURGER_API Burger::MemoryCharacter(
 	}
 	// Not found
 	return nullptr;
+#endif
 }
 
 /*! ************************************
@@ -739,6 +1634,33 @@ uint16_t* BURGER_API Burger::MemoryCharacter(
 char* BURGER_API Burger::MemoryCharacterReverse(
 	const char* pInput, uintptr_t uInputSize, int iChar) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	if (!pInput || (static_cast<uint_t>(iChar) > 255U)) {
+		return nullptr;
+	}
+	// Scan from the end of the buffer
+	const uint8_t* pWork =
+		reinterpret_cast<const uint8_t*>(pInput) + uInputSize;
+	const Vector128_t vChar = VectorSplat(static_cast<uint8_t>(iChar));
+	while (uInputSize >= 16U) {
+		pWork -= 16;
+		const VectorMask_t uMask =
+			VectorGetMask(VectorCompareEqual(VectorLoad(pWork), vChar));
+		if (uMask) {
+			return reinterpret_cast<char*>(const_cast<uint8_t*>(
+				pWork + (LastSetBit(uMask) >> kMaskShift)));
+		}
+		uInputSize -= 16U;
+	}
+	while (uInputSize) {
+		--pWork;
+		if (pWork[0] == static_cast<uint_t>(iChar)) {
+			return reinterpret_cast<char*>(const_cast<uint8_t*>(pWork));
+		}
+		--uInputSize;
+	}
+	return nullptr;
+#else
 	// Assume it's not found
 	char* pFound = nullptr;
 	// Valid pointer?
@@ -757,6 +1679,7 @@ char* BURGER_API Burger::MemoryCharacterReverse(
 	}
 	// Return the result
 	return pFound;
+#endif
 }
 
 /*! ************************************
@@ -784,9 +1707,35 @@ char* BURGER_API Burger::MemoryCharacterReverse(
 uint16_t* BURGER_API Burger::MemoryCharacterReverse(
 	const uint16_t* pInput, uintptr_t uInputSize, uint_t uChar) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	uInputSize >>= 1U; // Convert to uint16_t sizes
+	if (!pInput || (uChar > 0xFFFFU)) {
+		return nullptr;
+	}
+	const uint16_t* pWork = pInput + uInputSize;
+	const Vector128_t vChar = VectorSplat16(static_cast<uint16_t>(uChar));
+	while (uInputSize >= 8U) {
+		pWork -= 8;
+		const VectorMask_t uMask = VectorGetMask(VectorCompareEqual16(
+			VectorLoad(reinterpret_cast<const uint8_t*>(pWork)), vChar));
+		if (uMask) {
+			return const_cast<uint16_t*>(
+				pWork + (LastSetBit(uMask) >> (kMaskShift + 1U)));
+		}
+		uInputSize -= 8U;
+	}
+	while (uInputSize) {
+		--pWork;
+		if (pWork[0] == uChar) {
+			return const_cast<uint16_t*>(pWork);
+		}
+		--uInputSize;
+	}
+	return nullptr;
+#else
 	// Assume it's not found
 	uint16_t* pFound = nullptr;
-	uInputSize <<= 1; // Convert to uint16_t sizes
+	uInputSize >>= 1U; // Convert to uint16_t sizes
 	// Valid pointer?
 	if (pInput && uInputSize) {
 		do {
@@ -803,4 +1752,5 @@ uint16_t* BURGER_API Burger::MemoryCharacterReverse(
 	}
 	// Return the result
 	return pFound;
+#endif
 }
@@ -14,6 +14,9 @@
 
 #include "brnumberto.h"
 #include "brfixedpoint.h"
+#include "brfloatingpoint.h"
+#include "brfpdecimal.h"
+#include "brmemoryfunctions.h"
 #include "brstringfunctions.h"
 #include "brstructs.h"
 #include <stdio.h>
@@ -502,6 +505,65 @@ char* BURGER_API Burger::to_hex_ascii(
 
 ***************************************/
 
+/***************************************
+
+	Write an unsigned 32 bit integer as ASCII backwards from the end of a
+	buffer, two digits at a time using g_DigitPairs. No leading zeros are
+	written, but zero is written as "0". Return the pointer to the first
+	character.
+
+***************************************/
+
+static BURGER_INLINE char* WriteDigitsBackwards32(
+	char* pEnd, uint32_t uInput) BURGER_NOEXCEPT
+{
+	while (uInput >= 100U) {
+		const uint32_t uPair = (uInput % 100U) * 2U;
+		uInput /= 100U;
+		pEnd -= 2;
+		pEnd[0] = Burger::g_DigitPairs[uPair];
+		pEnd[1] = Burger::g_DigitPairs[uPair + 1];
+	}
+	if (uInput >= 10U) {
+		pEnd -= 2;
+		pEnd[0] = Burger::g_DigitPairs[uInput * 2U];
+		pEnd[1] = Burger::g_DigitPairs[uInput * 2U + 1];
+	} else {
+		--pEnd;
+		pEnd[0] = static_cast<char>(uInput + '0');
+	}
+	return pEnd;
+}
+
+/***************************************
+
+	Write an unsigned 64 bit integer as ASCII backwards from the end of a
+	buffer. Blocks of 8 digits are peeled off with a single 64 bit divide so
+	the digits themselves are generated with 32 bit math.
+
+***************************************/
+
+static BURGER_INLINE char* WriteDigitsBackwards64(
+	char* pEnd, uint64_t uInput) BURGER_NOEXCEPT
+{
+	while (uInput > 0xFFFFFFFFULL) {
+		const uint64_t uUpper = uInput / 100000000U;
+		uint32_t uLower = static_cast<uint32_t>(uInput - uUpper * 100000000U);
+		uInput = uUpper;
+
+		// All 8 digits are printed, including zeros
+		uint_t uCount = 4;
+		do {
+			const uint32_t uPair = (uLower % 100U) * 2U;
+			uLower /= 100U;
+			pEnd -= 2;
+			pEnd[0] = Burger::g_DigitPairs[uPair];
+			pEnd[1] = Burger::g_DigitPairs[uPair + 1];
+		} while (--uCount);
+	}
+	return WriteDigitsBackwards32(pEnd, static_cast<uint32_t>(uInput));
+}
+
 /*! ************************************
 
 	\brief Convert an unsigned 32 bit integer into ASCII.
@@ -542,52 +604,37 @@ char* BURGER_API Burger::NumberToAscii(
 	char* pOutput, uint32_t uInput, uint_t uDigits) BURGER_NOEXCEPT
 {
 	// How many digits to process?
-	uint_t uIndex = uDigits & 0xFFU;
+	uint_t uLength = uDigits & 0xFFU;
 
 	// Out of bounds? Or default? (Allow 1-10 only)
-	if ((uIndex - 1U) >= 9U) {
+	if ((uLength - 1U) >= 9U) {
 		// 10 max digits to process
-		uIndex = 10;
+		uLength = 10;
 	} else {
 		// If smaller than the max, hack off the excess with a modulo
-		uInput = uInput % g_TensTable32[uIndex];
+		uInput = uInput % g_TensTable32[uLength];
 	}
 
-	// Let's iterate (Index = 1-10)
-	if (--uIndex) { // Only iterate on >=10
-		do {
-			// Get div value in local
-			const uint32_t uBigNum = g_TensTable32[uIndex];
-			uint_t uLetter = '0';        // Init ASCII value
-			if (uInput >= uBigNum) {     // Bigger than the min?
-				uDigits |= kEnableLeadingZeros; // Force future printing
-				do {
-					uInput -= uBigNum; // Remove value
-					++uLetter;         // Inc ASCII value (Max 9 iterations)
-				} while (uInput >= uBigNum); // Keep going?
-			}
-
-			// Should I print leading zeros?
-
-			if (uDigits & kEnableLeadingZeros) {                // Already printing?
-				pOutput[0] = static_cast<char>(uLetter); // Output the digit
-				++pOutput;
-			}
-			// Any more left?
-		} while (--uIndex);
+	// Without leading zeros, only print the digits needed
+	if (!(uDigits & kEnableLeadingZeros)) {
+		uLength = NumberStringLength(uInput);
 	}
 
-	// Handle the last digit (No divide needed) and it's ALWAYS output.
-	pOutput[0] = static_cast<char>(uInput + '0');
-	++pOutput;
+	// Print the digits from right to left, then pad with zeros
+	char* pEnd = pOutput + uLength;
+	char* pFirst = WriteDigitsBackwards32(pEnd, uInput);
+	while (pFirst > pOutput) {
+		--pFirst;
+		pFirst[0] = '0';
+	}
 
 	// Do I need to write a null?
 	if (!(uDigits & kDisableEndingNull)) {
 		// Terminate the string
-		pOutput[0] = 0;
+		pEnd[0] = 0;
 	}
 	// Return the end pointer
-	return pOutput;
+	return pEnd;
 }
 
 /*! ************************************
@@ -681,52 +728,37 @@ char* BURGER_API Burger::NumberToAscii(
 	char* pOutput, uint64_t uInput, uint_t uDigits) BURGER_NOEXCEPT
 {
 	// How many digits to process?
-	uint_t uIndex = uDigits & 0xFFU;
+	uint_t uLength = uDigits & 0xFFU;
 
 	// Out of bounds? Or default? (Allow 1-20 only)
-	if ((uIndex - 1U) >= 19U) {
-		// 10 max digits to process
-		uIndex = 20;
+	if ((uLength - 1U) >= 19U) {
+		// 20 max digits to process
+		uLength = 20;
 	} else {
 		// If smaller than the max, hack off the excess with a modulo
-		uInput = uInput % g_TensTable64[uIndex];
+		uInput = uInput % g_TensTable64[uLength];
 	}
 
-	// Let's iterate (Index = 1-20)
-	if (--uIndex) { // Only iterate on >=20
-		do {
-			const uint64_t uBigNum =
-				g_TensTable64[uIndex];   // Get div value in local
-			uint_t uLetter = '0';        // Init ASCII value
-			if (uInput >= uBigNum) {     // Bigger than the min?
-				uDigits |= kEnableLeadingZeros; // Force future printing
-				do {
-					uInput -= uBigNum; // Remove value
-					++uLetter;         // Inc ASCII value (Max 9 iterations)
-				} while (uInput >= uBigNum); // Keep going?
-			}
-
-			// Should I print leading zeros?
-
-			if (uDigits & kEnableLeadingZeros) {                // Already printing?
-				pOutput[0] = static_cast<char>(uLetter); // Output the digit
-				++pOutput;
-			}
-			// Any more left ?
-		} while (--uIndex);
+	// Without leading zeros, only print the digits needed
+	if (!(uDigits & kEnableLeadingZeros)) {
+		uLength = NumberStringLength(uInput);
 	}
 
-	// Handle the last digit (No divide needed) and it's ALWAYS output.
-	pOutput[0] = static_cast<char>(uInput + '0');
-	++pOutput;
+	// Print the digits from right to left, then pad with zeros
+	char* pEnd = pOutput + uLength;
+	char* pFirst = WriteDigitsBackwards64(pEnd, uInput);
+	while (pFirst > pOutput) {
+		--pFirst;
+		pFirst[0] = '0';
+	}
 
 	// Do I need to write a null?
 	if (!(uDigits & kDisableEndingNull)) {
 		// Terminate the string
-		pOutput[0] = 0;
+		pEnd[0] = 0;
 	}
 	// Return the end pointer
-	return pOutput;
+	return pEnd;
 }
 
 /*! ************************************
@@ -869,6 +901,183 @@ char* BURGER_API Burger::NumberToAscii(
 	return pOutput + iLength;
 }
 
+/*! ************************************
+
+	\brief Convert decimal digits into ASCII.
+
+	Helper for to_decimal_ascii(char *,double,uint_t) and
+	to_decimal_ascii(char *,float,uint_t). Infinity and NaN are printed as
+	"inf", "-inf" and "nan".
+
+	\param pOutput Pointer to a buffer to hold the converted number.
+	\param pDecimal Pointer to the shortest digits of the number.
+	\param uDigits Number of digits after the decimal point or zero for the
+		shortest round trip string. Burger::kDisableEndingNull can be or'd to
+		this value.
+	\param uSpecial 1 for infinity, 2 for NaN, zero for a finite number
+
+	\return Pointer to the char immediately after the last char output.
+
+***************************************/
+
+static char* BURGER_API DecimalToAscii(char* pOutput,
+	Burger::FPDecimal* pDecimal, uint_t uDigits,
+	uint_t uSpecial) BURGER_NOEXCEPT
+{
+	if (uSpecial == 2) {
+		Burger::memory_copy(pOutput, "nan", 3);
+		pOutput += 3;
+	} else {
+		if (pDecimal->is_negative()) {
+			*pOutput++ = '-';
+		}
+		int32_t iExponent = pDecimal->get_exponent();
+		const int32_t iPrecision = static_cast<int32_t>(uDigits & 0xFFU);
+		if (uSpecial) {
+			Burger::memory_copy(pOutput, "inf", 3);
+			pOutput += 3;
+
+			// Fixed number of fraction digits, like "%.*f"
+		} else if (iPrecision && (iExponent < 21)) {
+			pDecimal->round_to_position(-iPrecision);
+			iExponent = pDecimal->get_exponent();
+			int32_t iPosition = (iExponent > 0) ? iExponent : 0;
+			do {
+				*pOutput++ = pDecimal->get_digit(iPosition);
+			} while (--iPosition >= 0);
+			*pOutput++ = '.';
+			do {
+				*pOutput++ = pDecimal->get_digit(iPosition);
+			} while (--iPosition >= -iPrecision);
+
+			// Shortest round trip digits, without an exponent if the digits
+			// are reasonably close to the decimal point
+		} else if (pDecimal->is_zero() ||
+			((iExponent >= -7) && (iExponent < 21))) {
+			const int32_t iLast = pDecimal->get_last_position();
+			int32_t iPosition = (iExponent > 0) ? iExponent : 0;
+			do {
+				*pOutput++ = pDecimal->get_digit(iPosition);
+			} while (--iPosition >= 0);
+			if (iLast < 0) {
+				*pOutput++ = '.';
+				do {
+					*pOutput++ = pDecimal->get_digit(iPosition);
+				} while (--iPosition >= iLast);
+			}
+
+			// Shortest round trip digits in scientific notation
+		} else {
+			const char* pDigits = pDecimal->get_digits();
+			const uint32_t uCount = pDecimal->get_digit_count();
+			*pOutput++ = pDigits[0];
+			if (uCount > 1) {
+				*pOutput++ = '.';
+				Burger::memory_copy(pOutput, pDigits + 1, uCount - 1);
+				pOutput += uCount - 1;
+			}
+			*pOutput++ = 'e';
+			if (iExponent < 0) {
+				*pOutput++ = '-';
+				iExponent = -iExponent;
+			} else {
+				*pOutput++ = '+';
+			}
+			pOutput = Burger::NumberToAscii(pOutput,
+				static_cast<uint32_t>(iExponent), Burger::kDisableEndingNull);
+		}
+	}
+	if (!(uDigits & Burger::kDisableEndingNull)) {
+		pOutput[0] = 0;
+	}
+	return pOutput;
+}
+
+/*! ************************************
+
+	\brief Convert a 32 bit float into decimal ASCII.
+
+	Convert a 32 bit float into a decimal ASCII string. If uDigits is zero, the
+	shortest string that will convert back into the exact same float is
+	generated. Otherwise, the number is rounded to nearest even with uDigits
+	digits after the decimal point, like "%.*f" in printf(). Numbers of 1e21 or
+	greater in magnitude ignore uDigits and print the shortest string.
+
+	The shortest string is in scientific notation if the exponent is 21 or
+	more or less than -7.
+
+	Examples:<br>
+	fInput = 123.4567f, uDigits = 0 -> "123.4567"<br>
+	fInput = 0.1f, uDigits = 0 -> "0.1"<br>
+	fInput = 1e30f, uDigits = 0 -> "1e+30"<br>
+	fInput = 1.25f, uDigits = 1 -> "1.2"<br>
+	fInput = -1234.567f, uDigits = 2 -> "-1234.57"
+
+	\param pOutput Pointer to a buffer to hold the converted number. It has
+		to be a minimum of 32 bytes in size, plus uDigits.
+	\param fInput 32 bit float to convert to ASCII.
+	\param uDigits Number of digits after the decimal point or zero for the
+		shortest round trip string. Burger::kDisableEndingNull can be or'd to
+		this value to affect output.
+
+	\return Pointer to the char immediately after the last char output.
+	\sa Burger::to_decimal_ascii(char *,double,uint_t) or
+		Burger::NumberToAscii(char *,float,uint_t)
+
+***************************************/
+
+char* BURGER_API Burger::to_decimal_ascii(
+	char* pOutput, float fInput, uint_t uDigits) BURGER_NOEXCEPT
+{
+	FPDecimal TheDecimal;
+	TheDecimal.shortest(fInput);
+	return DecimalToAscii(pOutput, &TheDecimal, uDigits,
+		is_NaN(fInput) ? 2U : is_infinite(fInput));
+}
+
+/*! ************************************
+
+	\brief Convert a 64 bit float into decimal ASCII.
+
+	Convert a 64 bit float into a decimal ASCII string. If uDigits is zero, the
+	shortest string that will convert back into the exact same double is
+	generated. Otherwise, the number is rounded to nearest even with uDigits
+	digits after the decimal point, like "%.*f" in printf(). Numbers of 1e21 or
+	greater in magnitude ignore uDigits and print the shortest string.
+
+	The shortest string is in scientific notation if the exponent is 21 or
+	more or less than -7.
+
+	Examples:<br>
+	dInput = 123.4567, uDigits = 0 -> "123.4567"<br>
+	dInput = 0.1, uDigits = 0 -> "0.1"<br>
+	dInput = 1e100, uDigits = 0 -> "1e+100"<br>
+	dInput = 2.675, uDigits = 2 -> "2.67"<br>
+	dInput = -1234.567, uDigits = 2 -> "-1234.57"
+
+	\param pOutput Pointer to a buffer to hold the converted number. It has
+		to be a minimum of 32 bytes in size, plus uDigits.
+	\param dInput 64 bit float to convert to ASCII.
+	\param uDigits Number of digits after the decimal point or zero for the
+		shortest round trip string. Burger::kDisableEndingNull can be or'd to
+		this value to affect output.
+
+	\return Pointer to the char immediately after the last char output.
+
+	\sa Burger::to_decimal_ascii(char *,float,uint_t) or
+		Burger::NumberToAscii(char *,double,uint_t)
+
+***************************************/
+
+char* BURGER_API Burger::to_decimal_ascii(
+	char* pOutput, double dInput, uint_t uDigits) BURGER_NOEXCEPT
+{
+	FPDecimal TheDecimal;
+	TheDecimal.shortest(dInput);
+	return DecimalToAscii(pOutput, &TheDecimal, uDigits,
+		is_NaN(dInput) ? 2U : is_infinite(dInput));
+}
+
 /*! ************************************
 
 	\brief Calculate the length of a string that represents this integer.
@@ -890,6 +1099,19 @@ char* BURGER_API Burger::NumberToAscii(
 
 uint_t BURGER_API Burger::NumberStringLength(uint32_t uInput) BURGER_NOEXCEPT
 {
+#if defined(BURGER_GNUC) || defined(BURGER_CLANG)
+	// Zero is treated as one, it doesn't change the result since all other
+	// powers of 10 are even.
+	uInput |= 1U;
+
+	// Convert the bit count into an estimate of the digit count using
+	// log10(2) ~= 1233/4096, which is never high and at most one digit low.
+	const uint_t uBits = 32U - static_cast<uint_t>(__builtin_clz(uInput));
+	const uint_t uEstimate = (uBits * 1233U) >> 12U;
+
+	// Adjust up by one if the input reaches the next power of 10
+	return uEstimate + 1U - (uInput < g_TensTable32[uEstimate]);
+#else
 	// Perform a binary search for performance
 
 	uint_t uResult;
@@ -923,6 +1145,7 @@ uint_t BURGER_API Burger::NumberStringLength(uint32_t uInput) BURGER_NOEXCEPT
 		uResult = 10; // 1000000000-4294967295
 	}
 	return uResult;
+#endif
 }
 
 /*! ************************************
@@ -972,6 +1195,13 @@ uint_t BURGER_API Burger::NumberStringLength(int32_t iInput) BURGER_NOEXCEPT
 
 uint_t BURGER_API Burger::NumberStringLength(uint64_t uInput) BURGER_NOEXCEPT
 {
+#if defined(BURGER_GNUC) || defined(BURGER_CLANG)
+	// Same as the 32 bit version, log10(2) ~= 1233/4096
+	uInput |= 1U;
+	const uint_t uBits = 64U - static_cast<uint_t>(__builtin_clzll(uInput));
+	const uint_t uEstimate = (uBits * 1233U) >> 12U;
+	return uEstimate + 1U - (uInput < g_TensTable64[uEstimate]);
+#else
 	// Assume no extra digits
 	uint_t uExtraDigits = 0;
 
@@ -990,6 +1220,7 @@ uint_t BURGER_API Burger::NumberStringLength(uint64_t uInput) BURGER_NOEXCEPT
 	}
 	// Get the rest of the digit count
 	return uExtraDigits + NumberStringLength(static_cast<uint32_t>(uInput));
+#endif
 }
 
 /*! ************************************
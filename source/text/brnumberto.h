@@ -101,6 +101,10 @@ extern char* BURGER_API NumberToAscii(
 	char* pOutput, float fInput, uint_t uDigits = 0) BURGER_NOEXCEPT;
 extern char* BURGER_API NumberToAscii(
 	char* pOutput, double dInput, uint_t uDigits = 0) BURGER_NOEXCEPT;
+extern char* BURGER_API to_decimal_ascii(
+	char* pOutput, float fInput, uint_t uDigits = 0) BURGER_NOEXCEPT;
+extern char* BURGER_API to_decimal_ascii(
+	char* pOutput, double dInput, uint_t uDigits = 0) BURGER_NOEXCEPT;
 
 #if !defined(DOXYGEN)
 template<typename T, uintptr_t size, bool is_integral>
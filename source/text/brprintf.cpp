@@ -58,8 +58,11 @@
 #include "brassert.h"
 #include "brfixedpoint.h"
 #include "brfloatingpoint.h"
+#include "brfphalf.h"
 #include "brfpinfo.h"
+#include "brglobalmemorymanager.h"
 #include "brmemoryfunctions.h"
+#include "brmutex.h"
 #include "brnumberto.h"
 #include "brstring.h"
 #include "brutf32.h"
@@ -792,17 +795,6 @@ void BURGER_API Burger::SafePrint::ParamInfo_t::GetFormattedOutputLength(
 			break;
 		}
 
-		// if no precision is specified, we are supposed to use 6 digits of
-		// precision
-		uint_t uFloatPrecision = 6;
-		if (IsFlagSet(CONVFLAG_PRECISION_MARKER)) {
-			if (IsFlagSet(CONVFLAG_PRECISION_SPECIFIED)) {
-				uFloatPrecision = GetPrecision();
-			} else {
-				uFloatPrecision = 0; // "." only = means zero precision
-			}
-		}
-
 		uint_t uSignLength = 0;
 		// printing a sign character?
 		if (TheFPInfo.is_negative() || IsFlagSet(CONVFLAG_DISPLAY_SIGN) ||
@@ -810,11 +802,9 @@ void BURGER_API Burger::SafePrint::ParamInfo_t::GetFormattedOutputLength(
 			uSignLength = 1;
 		}
 
-		// now run a digit check on it...
-		const FPPrintInfo TheFPPrintInfo(&TheFPInfo, uFloatPrecision);
-
 		// is it a "special" output such as NAN or infinity?
-		if (TheFPPrintInfo.is_special()) {
+		FPPrintInfo TheFPPrintInfo;
+		if (TheFPPrintInfo.analyze_special(&TheFPInfo)) {
 			// save the result
 			SetFloatSpecialResult(TheFPPrintInfo.get_result(),
 				TheFPPrintInfo.get_special_form_digits(), 0,
@@ -823,121 +813,94 @@ void BURGER_API Burger::SafePrint::ParamInfo_t::GetFormattedOutputLength(
 
 		} else {
 
-			// Create the formatting defaults
-			uint_t uExponentSpecialDigits = 0;
-			uint_t uIntSpecialDigits = 0;
-			uint_t uDecimalPoint = 0;
-			uint_t uFracDigits = 0;
-			uint_t uCommaCount = 0;
-			uint_t uExponentDigits = 0;
-			uint_t uPadDigits = 0;
-			uint_t uExponentPadDigits = 0;
-
-			// =========================================================
-			// get the width for f conversion if f or g specified
-			if (uConversionSpecifier == CONVSPEC_DECIMAL_FLOAT /* || (uConversionSpecifier == CONVSPECFLAG_SHORTER_FLOAT) */ ) {
-				// Get the number of integer digits
-				uIntSpecialDigits =
-					TheFPPrintInfo.get_last_non_zero_int_digit_position();
-
-				// zero point something?  then include the zero the left of the
-				// decimal
-				if (!uIntSpecialDigits) {
-					uIntSpecialDigits = 1;
-				}
-
-				// how many digits to the right of the decimal point?
-				uFracDigits = uFloatPrecision;
-
-				// do we have a decimal point?
-				if (uFloatPrecision || IsFlagSet(CONVFLAG_ALTERNATIVE_FORM)) {
-					uDecimalPoint = 1;
-				}
-
-				// Ok, we got the number of digits in the int part... now what
-				// about commas?
-				if (IsFlagSet(CONVFLAG_COMMA_SEPARATE) &&
-					(uIntSpecialDigits > 3)) {
-					uCommaCount = (uIntSpecialDigits - 1) / 3;
+			// Convert to decimal digits, rounded to the precision
+			FPDecimal TheDecimal;
+			ConvertReal(&TheDecimal, pArg);
+			const int32_t iExponent = TheDecimal.get_exponent();
+
+			uint_t bScientific =
+				(uConversionSpecifier == CONVSPEC_SCI_NOTE_FLOAT);
+			uint_t uFracDigits = GetFloatPrecision();
+
+			// %g picks %e or %f from the exponent after rounding
+			if (uConversionSpecifier == CONVSPEC_SHORTER_FLOAT) {
+				const int32_t iPrecision =
+					uFracDigits ? static_cast<int32_t>(uFracDigits) : 1;
+				if ((iExponent < -4) || (iExponent >= iPrecision)) {
+					bScientific = TRUE;
+					uFracDigits = static_cast<uint_t>(iPrecision - 1);
+				} else {
+					uFracDigits =
+						static_cast<uint_t>(iPrecision - 1 - iExponent);
 				}
 
-				// If padding zeros and width specified, they will pad out the
-				// width (we know there is no comma or left justify flag)
-				if (bHasWidth && IsFlagSet(CONVFLAG_LEFT_PAD_ZEROS)) {
-					const uint_t uTotalRealDigits = uSignLength +
-						uIntSpecialDigits + uDecimalPoint + uFracDigits;
-					if (uTotalRealDigits < uWidth) {
-						uPadDigits = uWidth - uTotalRealDigits;
+				// Trailing zeros are removed unless '#' was used
+				if (!IsFlagSet(CONVFLAG_ALTERNATIVE_FORM)) {
+					int32_t iLastFraction = -TheDecimal.get_last_position();
+					if (bScientific) {
+						iLastFraction += iExponent;
+					}
+					if (TheDecimal.is_zero() || (iLastFraction < 0)) {
+						iLastFraction = 0;
+					}
+					if (uFracDigits > static_cast<uint_t>(iLastFraction)) {
+						uFracDigits = static_cast<uint_t>(iLastFraction);
 					}
 				}
 			}
 
-			// =========================================================
-			// get the width for e conversion if e or g specified
-			if (uConversionSpecifier == CONVSPEC_SCI_NOTE_FLOAT /* || (uConversionSpecifier == CONVSPECFLAG_SHORTER_FLOAT) */ ) {
-				// scientific notation, always 1 digit to the left of the
-				// decimal
-				uExponentSpecialDigits = 1;
-
-				// do we have a decimal point?
-				if (uFloatPrecision || IsFlagSet(CONVFLAG_ALTERNATIVE_FORM)) {
-					uDecimalPoint = 1;
-				}
-
-				// how many digits to the right of the decimal point?
-				uFracDigits = uFloatPrecision;
-
-				const int32_t iExponent = static_cast<int32_t>(
-					TheFPPrintInfo.has_integer() ?
-                        TheFPPrintInfo.get_last_non_zero_int_digit_position() - 1 :
-                        0 - TheFPPrintInfo.get_first_non_zero_frac_digit_position());
-
-				// How many digits for the exponent?
-				uint_t uExpDigits =
-					NumberStringLength(static_cast<uint32_t>(absolute(iExponent)));
-
-				// we support a configurable minimum number of exponent digits
+			uint_t uIntDigits = 1;
+			uint_t uCommaCount = 0;
+			uint_t uExponentDigits = 0;
+			if (bScientific) {
+				// How many digits for the exponent? We support a
+				// configurable minimum number of exponent digits
+				uint_t uExpDigits = NumberStringLength(
+					static_cast<uint32_t>(absolute(iExponent)));
 				if (uExpDigits < kMIN_FLOAT_EXPONENT_DIGITS) {
 					uExpDigits = kMIN_FLOAT_EXPONENT_DIGITS;
 				}
-
-				uExponentDigits =
-					2 + uExpDigits; // add the 'e' and the sign character
-
-				// If padding zeros and width specified, they will pad out the
-				// width (we know there is no comma or left justify flag)
-				if (bHasWidth && IsFlagSet(CONVFLAG_LEFT_PAD_ZEROS)) {
-					uint_t uTotalRealDigits = uSignLength +
-						uExponentSpecialDigits + uDecimalPoint + uFracDigits +
-						uExponentDigits;
-					if (uTotalRealDigits < uWidth) {
-						uExponentPadDigits = uWidth - uTotalRealDigits;
-					}
+				// add the 'e' and the sign character
+				uExponentDigits = 2 + uExpDigits;
+			} else {
+				// zero point something? Then there's a zero to the left of
+				// the decimal point
+				if (iExponent > 0) {
+					uIntDigits = static_cast<uint_t>(iExponent) + 1;
+				}
+				// Ok, we got the number of digits in the int part... now
+				// what about commas?
+				if (IsFlagSet(CONVFLAG_COMMA_SEPARATE) && (uIntDigits > 3)) {
+					uCommaCount = (uIntDigits - 1) / 3;
 				}
 			}
 
-			if (uConversionSpecifier == CONVSPEC_DECIMAL_FLOAT) {
-				// tally up all the parts
-				uCharsCounted = uSignLength + uIntSpecialDigits + uCommaCount +
-					uDecimalPoint + uFracDigits + uPadDigits;
-
-				// cache off the info from the analysis
-				SetFloatInfo(uIntSpecialDigits, uFracDigits, uSignLength,
-					uDecimalPoint, uPadDigits, 0);
-				SetFloatAnalysisInfo(TheFPPrintInfo.get_result(), 0, 0,
-					TheFPPrintInfo.get_first_non_zero_int_digit_position());
-
-			} else if (uConversionSpecifier == CONVSPEC_SCI_NOTE_FLOAT) {
-				// tally up all the parts
-				uCharsCounted = uSignLength + uExponentSpecialDigits +
-					uDecimalPoint + uFracDigits + uExponentPadDigits;
-
-				// cache off the info
-				SetFloatInfo(uExponentSpecialDigits, uFracDigits, uSignLength,
-					uDecimalPoint, uExponentPadDigits, uExponentDigits);
+			// do we have a decimal point?
+			const uint_t uDecimalPoint =
+				(uFracDigits || IsFlagSet(CONVFLAG_ALTERNATIVE_FORM)) ? 1U :
+																		0U;
+
+			// If padding zeros and width specified, they will pad out the
+			// width (we know there is no comma or left justify flag)
+			uint_t uPadDigits = 0;
+			const uint_t uTotalRealDigits = uSignLength + uIntDigits +
+				uCommaCount + uDecimalPoint + uFracDigits + uExponentDigits;
+			if (bHasWidth && IsFlagSet(CONVFLAG_LEFT_PAD_ZEROS) &&
+				(uTotalRealDigits < uWidth)) {
+				uPadDigits = uWidth - uTotalRealDigits;
 			}
-		}
 
+			// tally up all the parts
+			uCharsCounted = uTotalRealDigits + uPadDigits;
+
+			// cache off the info
+			SetFloatInfo(uIntDigits, uFracDigits, uSignLength, uDecimalPoint,
+				uPadDigits, uExponentDigits);
+			SetFloatAnalysisInfo(TheDecimal.is_zero() ?
+					FPPrintInfo::kResultZero :
+					FPPrintInfo::kResultNormalFloat,
+				0, 0, 0);
+		}
 		// Octal conversion takes unsigned ints and in relaxed mode signed ints
 		// and bools
 	} else if (uConversionSpecifier == CONVSPEC_OCTAL) {
@@ -1293,6 +1256,71 @@ void BURGER_API Burger::SafePrint::ParamInfo_t::CheckConversionForWarnings(
 	}
 }
 
+/*! ************************************
+
+	\brief Bind an argument to a conversion
+
+	Resolve the default "%@" conversion from the argument type, verify the
+	argument can be displayed with the conversion and determine the exact
+	length of the formatted output.
+
+	\param uOptions \ref eParseOptions flags for type checking
+	\param pArg Pointer to the argument to bind
+	\return \ref kErrorNone or an error code if the argument can't be displayed
+
+***************************************/
+
+Burger::eError BURGER_API Burger::SafePrint::ParamInfo_t::BindArgument(
+	eParseOptions uOptions, const ArgumentType* pArg) BURGER_NOEXCEPT
+{
+	// do we determine the type?
+	if (GetConversion() == CONVSPEC_NOT_SUPPLIED) {
+		const eOpcode uOpCode = GetDefaultArgumentType(pArg);
+		if (uOpCode == OP_NOT_A_SYMBOL) {
+			// Should never get this unless someone forgot to provide one in
+			// code
+			return kErrorInvalidParameter;
+		}
+		const OutputTypeAndFlags_t* pOutputType =
+			&g_PrintfOutputType[uOpCode - OP_OUTPUT_BEGIN];
+		SetConversion(pOutputType->m_uOutputDisplayType);
+		SetFlag(pOutputType->m_uOutputFlagsModifier);
+	}
+
+	// validate the output type is compatible with the argument.
+
+	// get the type of parameter we are going format
+	const eArgumentType uParameterType = pArg->GetType();
+
+	// get the output display type in bitfield form
+	const uint32_t uDisplayTypeFlag = GetConversionAsFlag();
+
+	// we have 2 different levels of format compatibility
+	const uint_t bStrictOk = (uOptions & PARSEOPTION_STRICT_OUTPUT_TYPES_OK) ?
+		(g_ValidOutputDisplayTypesStrict[uParameterType] & uDisplayTypeFlag) !=
+			0 :
+		false;
+	const uint_t bRelaxedOk = (uOptions & PARSEOPTION_RELAXED_OUTPUT_TYPES_OK) ?
+		(g_ValidOutputDisplayTypesRelaxed[uParameterType] & uDisplayTypeFlag) !=
+			0 :
+		false;
+
+	if (!bStrictOk && !bRelaxedOk) {
+		return kErrorInvalidArgument;
+	}
+
+	// Now check the flags for this conversion
+	CheckConversionFlags();
+
+	// Check the conversion for any iffy things we want to issue warnings for
+	CheckConversionForWarnings(pArg);
+
+	// Might as well determine the output length of the formatted argument
+	// here....
+	GetFormattedOutputLength(pArg);
+	return kErrorNone;
+}
+
 /*! ************************************
 
 	\brief Store the precision or width value
@@ -1394,7 +1422,25 @@ uintptr_t BURGER_API Burger::SafePrint::ParamInfo_t::FormatInteger(
 		bEmitDigits = FALSE;
 	}
 
-	// Loop to emit decimal digits, from right to left
+	// Without commas, print the digits two at a time with NumberToAscii()
+	if (bEmitDigits && !bCommaFlag) {
+		uint_t uLength;
+		if (bIs64Bit) {
+			uLength = NumberStringLength(uNumber64);
+			NumberToAscii(
+				pOutText - uLength + 1, uNumber64, kDisableEndingNull);
+		} else {
+			uLength = NumberStringLength(uNumber32);
+			NumberToAscii(
+				pOutText - uLength + 1, uNumber32, kDisableEndingNull);
+		}
+		pOutText -= uLength;
+		uCharsWritten = uLength;
+		uTotalDigitsWritten = uLength;
+		bEmitDigits = FALSE;
+	}
+
+	// Loop to emit decimal digits with commas, from right to left
 	while (bEmitDigits) {
 		uint_t uCurDigit;
 		if (bIs64Bit) {
@@ -1975,13 +2021,8 @@ uintptr_t BURGER_API Burger::SafePrint::ParamInfo_t::FormatReal(
 	// sanity checks
 	BURGER_ASSERT(pArg->IsReal());
 
-	// we can assume all inputs have been validated
-	const uint_t bCommaFlag = IsFlagSet(CONVFLAG_COMMA_SEPARATE);
-	const uint_t bBlankSign = IsFlagSet(CONVFLAG_BLANK_SIGN);
-
 	// handle field width & left justify flags
 	char* pOutText = pOutBuffer + PadFieldWidth(pOutBuffer);
-	uintptr_t uCharsWritten = 0;
 
 	// all these will be initialized with cached off values
 	uint_t uIntDigits, uFracDigits, uSign, uDecimal, uPadDigits,
@@ -1995,23 +2036,6 @@ uintptr_t BURGER_API Burger::SafePrint::ParamInfo_t::FormatReal(
 	GetFloatAnalysisInfo(
 		&uPrintResult, &uPadIntZeros, &uPadFracZeros, &uFirstNonZeroIntPos);
 
-	// Break the real number up into mantissa, exponent, etc
-	FPInfo TheFPInfo;
-	switch (pArg->GetType()) {
-	case kArgumentTypeFloat16:
-		TheFPInfo = pArg->m_Data.m_fHalf;
-		break;
-	case kArgumentTypeFloat32:
-		TheFPInfo = pArg->m_Data.m_fFloat;
-		break;
-	case kArgumentTypeFloat64:
-		TheFPInfo = pArg->m_Data.m_dDouble;
-		break;
-	default:
-		BURGER_ASSERT(FALSE);
-		return 0;
-	}
-
 	// We check for the special cases (infinity, NANs) first
 	if ((uPrintResult >= FPPrintInfo::kResultFirstSpecial) &&
 		(uPrintResult <= FPPrintInfo::kResultLastSpecial)) {
@@ -2019,214 +2043,125 @@ uintptr_t BURGER_API Burger::SafePrint::ParamInfo_t::FormatReal(
 		return GetOutputLength();
 	}
 
-	// printing a sign character?
-	if (TheFPInfo.is_negative() || IsFlagSet(CONVFLAG_DISPLAY_SIGN) ||
-		bBlankSign) {
-		uSign = 1;
+	// Get the same rounded digits that were used to determine the length
+	FPDecimal TheDecimal;
+	ConvertReal(&TheDecimal, pArg);
+	const int32_t iExponent = TheDecimal.get_exponent();
+
+	// write out any sign character
+	char* pTextPtr = pOutText;
+	if (uSign) {
+		*pTextPtr++ = static_cast<char>((TheDecimal.is_negative()) ?
+                               kNUMERIC_NEGATIVE_SIGN :
+				(IsFlagSet(CONVFLAG_BLANK_SIGN)) ? kNUMERIC_BLANK_SIGN :
+                               kNUMERIC_POSITIVE_SIGN);
 	}
 
-	// how many commas are we inserting?
-	uint_t uCommaCount =
-		(bCommaFlag && (uIntDigits > 3U)) ? (uIntDigits - 1U) / 3U : 0;
-
-	// Is this a series of all '9's rounded up to '1' (plus zeros?)
-	// Alternatively, is this a true zero value?
-	if ((uPrintResult == FPPrintInfo::kResultFloatRoundedUpADigit) ||
-		(uPrintResult == FPPrintInfo::kResultZero)) {
-		char* pTextPtr = pOutText;
-		if (uSign) {
-			*pTextPtr++ = static_cast<char>((TheFPInfo.is_negative()) ?
-                                   kNUMERIC_NEGATIVE_SIGN :
-					(bBlankSign) ? kNUMERIC_BLANK_SIGN :
-                                   kNUMERIC_POSITIVE_SIGN);
-			++uCharsWritten;
-		}
+	// any leading zeros to pad the field?
+	while (uPadDigits) {
+		*pTextPtr++ = '0';
+		--uPadDigits;
+	}
 
-		// any leading zeros to pad the field?
-		while (uPadDigits) {
-			*pTextPtr++ = '0';
-			++uCharsWritten;
-			--uPadDigits;
+	if (uExponentDigits) {
+		// Scientific notation, one digit, the fraction and the exponent
+		*pTextPtr++ = TheDecimal.get_digit(iExponent);
+		if (uDecimal) {
+			*pTextPtr++ = kNUMERIC_DECIMAL_POINT;
 		}
-
-		// to do.. add numeric separator support
-		BURGER_ASSERT(uIntDigits);
-		uint_t uZerosToWrite = uIntDigits;
-
-		if (uPrintResult == FPPrintInfo::kResultFloatRoundedUpADigit) {
-			*pTextPtr++ = '1';
-			--uZerosToWrite;
-			++uCharsWritten;
+		int32_t iPosition = iExponent;
+		while (uFracDigits) {
+			*pTextPtr++ = TheDecimal.get_digit(--iPosition);
+			--uFracDigits;
 		}
+		*pTextPtr++ = IsFlagSet(CONVFLAG_UPPERCASE) ? 'E' : 'e';
+		*pTextPtr++ = static_cast<char>(
+			(iExponent < 0) ? kNUMERIC_NEGATIVE_SIGN : kNUMERIC_POSITIVE_SIGN);
+
+		// Write the exponent right to left with leading zeros
+		uint32_t uExponent = static_cast<uint32_t>(absolute(iExponent));
+		pTextPtr += uExponentDigits - 2;
+		char* pExponent = pTextPtr;
+		do {
+			*--pExponent = static_cast<char>('0' + (uExponent % 10U));
+			uExponent /= 10U;
+		} while (--uExponentDigits != 2);
 
-		while (uZerosToWrite) {
-			*pTextPtr++ = '0';
-			--uZerosToWrite;
-			++uCharsWritten;
-		}
+	} else {
+		// Output the integer portion a digit at a time, left to right
+		const uint_t bCommaFlag = IsFlagSet(CONVFLAG_COMMA_SEPARATE);
+		int32_t iPosition = static_cast<int32_t>(uIntDigits) - 1;
+		do {
+			*pTextPtr++ = TheDecimal.get_digit(iPosition);
+			// need to put a group separator in after the digit?
+			if (bCommaFlag && iPosition && !(iPosition % 3)) {
+				*pTextPtr++ = kNUMERIC_GROUP_SEPARATOR;
+			}
+		} while (--iPosition >= 0);
 
 		if (uDecimal) {
 			*pTextPtr++ = kNUMERIC_DECIMAL_POINT;
-			++uCharsWritten;
 		}
-
 		while (uFracDigits) {
-			*pTextPtr++ = '0';
+			*pTextPtr++ = TheDecimal.get_digit(iPosition);
+			--iPosition;
 			--uFracDigits;
-			++uCharsWritten;
-		}
-
-		BURGER_ASSERT(uCharsWritten == GetFormattedLength());
-		return GetOutputLength();
-	}
-
-	// setup a high precision object big enough to hold the number
-	const uint32_t bitsNeeded = (1U << (TheFPInfo.get_exponent_bit_count() - 1)) +
-		TheFPInfo.get_mantissa_bit_count();
-	FPLargeInt intPart(bitsNeeded);
-	FPLargeInt fracPart(bitsNeeded);
-
-	separate_integer_fraction(&intPart, &fracPart, &TheFPInfo);
-
-	// we'll be writing this out right to left
-	// either padDigits or commas will be zero
-	char* pIntDigit =
-		pOutText + uSign + uPadDigits + uIntDigits + uCommaCount - 1;
-	char* pLastDigit = pIntDigit;
-
-	// write out any sign character
-	if (uSign) {
-		*pOutText = static_cast<char>((TheFPInfo.is_negative()) ?
-                               kNUMERIC_NEGATIVE_SIGN :
-				(bBlankSign) ? kNUMERIC_BLANK_SIGN :
-                               kNUMERIC_POSITIVE_SIGN);
-		++uCharsWritten;
-	}
-
-	// do we have any leading zeros to write out?
-	if (uPadDigits) {
-		for (uint_t n = 0; n < uPadDigits; n++) {
-			pOutText[n + uSign] = '0';
-			++uCharsWritten;
 		}
 	}
 
-	// Output the integer portion a digit at a time, right to left
-	uint_t uZeroFirstDigits = uPadIntZeros; // needed for RTL cut-off emulation
-	uint_t uIntDigitsReturned = 0;
-	uint_t uDigitsInGroup = 0;
-	uint_t uFracDigitsReturned = 0;
-
-	do {
-		// sanity check
-		BURGER_ASSERT(pIntDigit >= pOutText);
-
-		char theDigit = static_cast<char>(intPart.divide_return_remainder(10));
-		++uIntDigitsReturned;
-
-		if (uZeroFirstDigits) {
-			theDigit = 0;
-			--uZeroFirstDigits;
-		}
-
-		// need to put a group separator in before (after) the digit?
-		if (bCommaFlag && (uDigitsInGroup == 3)) {
-			*pIntDigit-- = kNUMERIC_GROUP_SEPARATOR;
-			++uCharsWritten;
-			uDigitsInGroup = 0;
-		}
-
-		// do we need to grab the pointer to this digit for later rounding up?
-		if (uIntDigitsReturned == uFirstNonZeroIntPos) {
-			pLastDigit = pIntDigit;
-		}
-
-		*pIntDigit = static_cast<char>('0' + theDigit);
-		--pIntDigit;
-
-		++uDigitsInGroup;
-		++uCharsWritten;
-	} while (intPart.is_not_zero());
+	BURGER_ASSERT(
+		static_cast<uintptr_t>(pTextPtr - pOutText) == GetFormattedLength());
+	return GetOutputLength();
+}
 
-	BURGER_ASSERT(uIntDigits == uIntDigitsReturned);
+/*! ************************************
 
-	// do we output a decimal point?   if we have fractional digits, we must
-	if (uDecimal) {
-		// compute the position of the decimal point, and write it out
-		char* pDecimalPt =
-			pOutText + uSign + uPadDigits + uIntDigits + uCommaCount;
-		*pDecimalPt = kNUMERIC_DECIMAL_POINT;
-		++uCharsWritten;
+	\brief Convert a real number argument into rounded decimal digits
 
-		// see how many fractional digits to actually calculate
-		const uint_t uRealFracDigits = uFracDigits - uPadFracZeros;
-		char* pFracDigit = ++pDecimalPt;
+	Convert the floating point argument into the shortest decimal digits that
+	represent it and round them to the precision of the conversion. "%f"
+	rounds to a number of digits after the decimal point, "%e" to the
+	precision plus one significant digits and "%g" to the precision in
+	significant digits.
 
-		// if we have fractional digits, then output them left to right
-		if (uRealFracDigits) {
-			while (uFracDigitsReturned < uRealFracDigits) {
-				char theDigit =
-					static_cast<char>(fracPart.multiply_return_overflow(10));
-				++uFracDigitsReturned;
+	\param pOutput Pointer to the \ref FPDecimal to receive the digits
+	\param pArg Pointer to the argument value
 
-				// note last written digit position if we have to round up
-				pLastDigit = pFracDigit;
+	\sa FormatReal(char *, const ArgumentType *) const
 
-				*pFracDigit++ = static_cast<char>('0' + theDigit);
-				++uCharsWritten;
-			}
-		}
+***************************************/
 
-		// for RTL cutoff emulation, we pad zeros on the end after the cut-off
-		while (uPadFracZeros) {
-			*pFracDigit++ = '0';
-			++uCharsWritten;
-			--uPadFracZeros;
-		}
+void BURGER_API Burger::SafePrint::ParamInfo_t::ConvertReal(
+	FPDecimal* pOutput, const ArgumentType* pArg) const BURGER_NOEXCEPT
+{
+	switch (pArg->GetType()) {
+	case kArgumentTypeFloat16:
+		pOutput->shortest(convert_to_float(pArg->m_Data.m_fHalf));
+		break;
+	case kArgumentTypeFloat32:
+		pOutput->shortest(pArg->m_Data.m_fFloat);
+		break;
+	case kArgumentTypeFloat64:
+		pOutput->shortest(pArg->m_Data.m_dDouble);
+		break;
+	default:
+		// This is an error condition
+		pOutput->clear();
+		break;
 	}
 
-	// do we need to round the result up?  if so we have a pointer to
-	// the rightmost significant digit.  We will increment that digit,
-	// if there is a carry, move left, ignoring separators & decimals
-	// until nothing carries.  We don't worry about it adding a digit to
-	// the beginning of the number, as the 'all 9s' case has been
-	// accounted for separately.
-	if (uPrintResult == FPPrintInfo::kResultFloatRoundedUpAtEnd) {
-		while (pLastDigit) { // suppress warning by checking pointer...
-			uint8_t theDigit = static_cast<uint8_t>(*pLastDigit - '0');
-
-			BURGER_ASSERT(theDigit <= 9U);
-
-			// '0' through '8' means increment digit and we are done
-			if (theDigit != 9) {
-				// failsafe in case we find something that's not a number
-				// (shouldn't happen)
-				if (theDigit < 9U) {
-					*pLastDigit = static_cast<char>('0' + theDigit + 1);
-				}
-				break;
-			} else {
-				// the digit is a '9', which means we increment, get '10', write
-				// the '0' and carry over the 1 to the next digit to the left
-				*pLastDigit = '0';
-				--pLastDigit; // back up a digit
-
-				// skip over the decimal point or any group separators
-				if ((*pLastDigit ==
-						static_cast<char>(kNUMERIC_DECIMAL_POINT)) ||
-					(*pLastDigit ==
-						static_cast<char>(kNUMERIC_GROUP_SEPARATOR))) {
-					pLastDigit--;
-				}
-			}
-
-			// sanity check
-			BURGER_ASSERT(pLastDigit >= pOutText);
-		}
+	const uint_t uPrecision = GetFloatPrecision();
+	switch (GetConversion()) {
+	case CONVSPEC_DECIMAL_FLOAT:
+		pOutput->round_to_position(-static_cast<int32_t>(uPrecision));
+		break;
+	case CONVSPEC_SCI_NOTE_FLOAT:
+		pOutput->round_to_digits(uPrecision + 1);
+		break;
+	default:
+		pOutput->round_to_digits(uPrecision);
+		break;
 	}
-
-	BURGER_ASSERT(uCharsWritten == GetFormattedLength());
-	return GetOutputLength();
 }
 
 /*! ************************************
@@ -3078,8 +3013,9 @@ uint_t BURGER_API Burger::SafePrint::ProcessResults_t::FormatPreProcess(
 					}
 				}
 
-				// Finally... did we get a conversion specifier?
-				if ((uOpCode >= OP_OUTPUT_BEGIN) &&
+				// Finally... did we get a conversion specifier? ('@' is the
+				// default conversion, just before the rest)
+				if ((uOpCode >= OP_OUTPUT_DEFAULT) &&
 					(uOpCode <= OP_OUTPUT_END)) {
 					// are we checking the arguments? (or just the format
 					// string)
@@ -3104,92 +3040,30 @@ uint_t BURGER_API Burger::SafePrint::ProcessResults_t::FormatPreProcess(
 						bCurNumValueValid = false;
 					}
 
-					// are we checking the arguments? (or just the format
-					// string)
-					if (uOptions & PARSEOPTION_CHECK_ARG_TYPES) {
-						// do we determine the type?
-						if (uOpCode == OP_OUTPUT_DEFAULT) {
-							uOpCode = GetDefaultArgumentType(
-								ppArgs[uCurrentArgumentNext]);
-							if (uOpCode == OP_NOT_A_SYMBOL) {
-								// Should never get this unless someone forgot
-								// to provide one in code
-								uErrorCode = kErrorInvalidParameter;
-								goto parse_error;
-							}
-						}
-
-						// Get the display type, and any modifier flags
+					// Get the display type, and any modifier flags. The default
+					// type is resolved when the argument is bound.
+					if (uOpCode == OP_OUTPUT_DEFAULT) {
+						pParamInfos[uCurrentCommandIndex].SetConversion(
+							CONVSPEC_NOT_SUPPLIED);
+					} else {
 						pParamInfos[uCurrentCommandIndex].SetConversion(
 							g_PrintfOutputType[uOpCode - OP_OUTPUT_BEGIN]
 								.m_uOutputDisplayType);
 						pParamInfos[uCurrentCommandIndex].SetFlag(
 							g_PrintfOutputType[uOpCode - OP_OUTPUT_BEGIN]
 								.m_uOutputFlagsModifier);
+					}
 
-						// validate the output type is compatible with the
-						// argument.
-
-						// get the type of parameter we are going format
-						// (ArgType::xxx)
-						const eArgumentType uParameterType =
-							ppArgs[uCurrentArgumentNext]->GetType();
-
-						// get the output display type in bitfield form
-						const uint32_t uDisplayTypeFlag =
-							pParamInfos[uCurrentCommandIndex]
-								.GetConversionAsFlag();
-
-						// we have 2 different levels of format compatibility
-						const uint_t bStrictOk =
-							(uOptions & PARSEOPTION_STRICT_OUTPUT_TYPES_OK) ?
-                            (g_ValidOutputDisplayTypesStrict[uParameterType] &
-								uDisplayTypeFlag) != 0 :
-                            false;
-						const uint_t bRelaxedOk =
-							(uOptions & PARSEOPTION_RELAXED_OUTPUT_TYPES_OK) ?
-                            (g_ValidOutputDisplayTypesRelaxed[uParameterType] &
-								uDisplayTypeFlag) != 0 :
-                            false;
-
-						if (!bStrictOk && !bRelaxedOk) {
-							uErrorCode = kErrorInvalidArgument;
+					// are we checking the arguments? (or just the format
+					// string)
+					if (uOptions & PARSEOPTION_CHECK_ARG_TYPES) {
+						uErrorCode =
+							pParamInfos[uCurrentCommandIndex].BindArgument(
+								uOptions, ppArgs[uCurrentArgumentNext]);
+						if (uErrorCode != kErrorNone) {
 							goto parse_error;
 						}
-
-						// Now check the flags for this conversion
-						pParamInfos[uCurrentCommandIndex]
-							.CheckConversionFlags();
-
-						// Check the conversion for any iffy things we want to
-						// issue warnings for
-						pParamInfos[uCurrentCommandIndex]
-							.CheckConversionForWarnings(
-								ppArgs[uCurrentArgumentNext]);
-
-						// Might as well determine the output length of the
-						// formatted argument here....
-						pParamInfos[uCurrentCommandIndex]
-							.GetFormattedOutputLength(
-								ppArgs[uCurrentArgumentNext]);
 					} else {
-						// make the output command the best we can
-						const eConversionSpecifier uConversionSpec =
-							(uOpCode == OP_OUTPUT_DEFAULT) ?
-                            CONVSPEC_NOT_SUPPLIED :
-                            g_PrintfOutputType[uOpCode - OP_OUTPUT_BEGIN]
-								.m_uOutputDisplayType;
-						const eConversionFlags uConversionFlags =
-							(uOpCode == OP_OUTPUT_DEFAULT) ?
-                            CONVFLAG_NO_OPTIONS :
-                            g_PrintfOutputType[uOpCode - OP_OUTPUT_BEGIN]
-								.m_uOutputFlagsModifier;
-
-						pParamInfos[uCurrentCommandIndex].SetConversion(
-							uConversionSpec);
-						pParamInfos[uCurrentCommandIndex].SetFlag(
-							uConversionFlags);
-
 						// todo:  Get default widths for known output types?
 
 						// Get an estimated output size by checking width and
@@ -3211,9 +3085,12 @@ uint_t BURGER_API Burger::SafePrint::ProcessResults_t::FormatPreProcess(
 						pParamInfos[uCurrentCommandIndex].SetOutputLength(
 							theLength);
 
-						// Now check the flags for this conversion
-						pParamInfos[uCurrentCommandIndex]
-							.CheckConversionFlags();
+						// Now check the flags for this conversion, the
+						// default type is checked once it's known
+						if (uOpCode != OP_OUTPUT_DEFAULT) {
+							pParamInfos[uCurrentCommandIndex]
+								.CheckConversionFlags();
+						}
 					}
 
 					// Finished parsing the arg specifier, we're done with this
@@ -3253,6 +3130,71 @@ parse_error:
 	return false;
 }
 
+/*! ************************************
+
+	\brief Bind arguments to a list of output commands
+
+	Given a list of output commands created by FormatPreProcess() without
+	argument checking, check every argument against its conversion and
+	determine the exact length of the formatted output.
+
+	Returns results in \ref ProcessResults_t the same way FormatPreProcess()
+	does.
+
+	\param uArgCount Number of available arguments
+	\param ppArgs Pointer to the array of pointers to arguments
+	\param uParamInfoCount Number of parameter commands to process
+	\param pParamInfos Pointer to an array of parameter commands
+
+	\return \ref TRUE if successful, \ref FALSE if there was an error
+
+***************************************/
+
+uint_t BURGER_API Burger::SafePrint::ProcessResults_t::BindArguments(
+	uintptr_t uArgCount, const ArgumentType** ppArgs, uintptr_t uParamInfoCount,
+	ParamInfo_t* pParamInfos) BURGER_NOEXCEPT
+{
+	// Initialize return values
+	m_uPhaseResults = kErrorNone;
+	m_uFormattedOutputLength = 0;
+	m_uNumOutputCommands = uParamInfoCount;
+	m_uErrorFormatSequencePos = UINTPTR_MAX;
+	m_uErrorCharPos = UINTPTR_MAX;
+
+	uintptr_t uTotalLength = 0;
+	uintptr_t uIndex = 0;
+	while (uIndex < uParamInfoCount) {
+		if (pParamInfos->GetCommand() == COMMAND_FORMAT_ARGUMENT) {
+			const uint_t uArgIndex = pParamInfos->GetArgIndex();
+
+			// Not enough arguments?
+			if (uArgIndex >= uArgCount) {
+				m_uPhaseResults = kErrorDataStarvation;
+			} else {
+				// Make sure the ArgumentType object looks ok
+				const ArgumentType* pArg = ppArgs[uArgIndex];
+				if (IsPointerInvalid(pArg) ||
+					(pArg->GetType() == kArgumentTypeInvalid) ||
+					(pArg->GetType() >= kArgumentTypeCount)) {
+					m_uPhaseResults = kErrorInvalidParameter;
+				} else {
+					m_uPhaseResults =
+						pParamInfos->BindArgument(PARSEOPTION_DEFAULT, pArg);
+				}
+			}
+			if (m_uPhaseResults != kErrorNone) {
+				m_uErrorFormatSequencePos = uIndex;
+				return FALSE;
+			}
+		}
+		uTotalLength += pParamInfos->GetOutputLength();
+		++pParamInfos;
+		++uIndex;
+	}
+	m_uFormattedOutputLength = uTotalLength;
+	return TRUE;
+}
+
 /*! ************************************
 
 	\brief Mapping table for UTF-8 characters to SafePrint opcodes
@@ -4370,3 +4312,431 @@ intptr_t BURGER_API Burger::DebugSnprintf(char* pOutput, uintptr_t uOutputSize,
 
 	return 0;
 }
+
+/*! ************************************
+
+	\class Burger::CompiledFormat
+	\brief Format string parsed once for repeated printing
+
+	Sprintf(), Snprintf() and Printf() parse the format string on every call.
+	When the same format string is used over and over, such as for logging,
+	this class parses the string once into a list of output commands. Each call
+	to format() or print() only has to check the arguments and generate the
+	text.
+
+	Create an instance for a format string, usually in static memory so the
+	string is parsed when the program starts, or call get_cached() with a
+	string literal to look up a shared instance keyed by the string's address.
+
+	\code
+	static const Burger::CompiledFormat g_LogLine("%s: %d items\n");
+
+	void LogItems(const char* pName, int iCount)
+	{
+		g_LogLine.print(stdout, pName, iCount);
+	}
+	\endcode
+
+	\note The format string is not copied, it must remain valid for the life
+		of the CompiledFormat.
+
+	\sa Snprintf(char *,uintptr_t,const char *,uintptr_t,
+		const ArgumentType **)
+
+***************************************/
+
+/*! ************************************
+
+	\brief Default constructor
+
+	Create an empty CompiledFormat, call compile() before using it.
+
+	\sa compile(const char*)
+
+***************************************/
+
+Burger::CompiledFormat::CompiledFormat(void) BURGER_NOEXCEPT
+	: m_pFormat(nullptr),
+	  m_pNext(nullptr),
+	  m_uCommandCount(0),
+	  m_uArgumentCount(0),
+	  m_uError(kErrorNotInitialized)
+{
+}
+
+/*! ************************************
+
+	\brief Construct and compile a format string
+
+	\param pFormat Pointer to a "C" format string that remains valid for the
+		life of this class
+
+	\sa compile(const char*)
+
+***************************************/
+
+Burger::CompiledFormat::CompiledFormat(const char* pFormat) BURGER_NOEXCEPT
+	: m_pFormat(nullptr),
+	  m_pNext(nullptr),
+	  m_uCommandCount(0),
+	  m_uArgumentCount(0),
+	  m_uError(kErrorNotInitialized)
+{
+	compile(pFormat);
+}
+
+/*! ************************************
+
+	\brief Parse a format string into output commands
+
+	The format string is checked for syntax errors and converted into a list of
+	text copies and argument conversions. Argument types are checked later,
+	every time the format is printed.
+
+	\param pFormat Pointer to a "C" format string that remains valid for the
+		life of this class
+
+	\return \ref kErrorNone on success or the parsing error
+
+	\sa format(char*,uintptr_t,uintptr_t,const ArgumentType**) const
+
+***************************************/
+
+Burger::eError BURGER_API Burger::CompiledFormat::compile(
+	const char* pFormat) BURGER_NOEXCEPT
+{
+	m_pFormat = pFormat;
+	m_uCommandCount = 0;
+	m_uArgumentCount = 0;
+
+	eError uResult = kErrorInvalidParameter;
+	if (!IsStringEmpty(pFormat)) {
+
+		// Parse without arguments, allow "%n$" to reference any argument
+		SafePrint::ProcessResults_t TheProcessResults;
+		memory_clear(m_Commands, sizeof(m_Commands));
+		if (TheProcessResults.FormatPreProcess(
+				static_cast<SafePrint::eParseOptions>(
+					SafePrint::PARSEOPTION_STRICT_OUTPUT_TYPES_OK |
+					SafePrint::PARSEOPTION_RELAXED_OUTPUT_TYPES_OK),
+				pFormat, string_length(pFormat),
+				SafePrint::kMAX_OUTPUT_COMMANDS, nullptr,
+				BURGER_ARRAYSIZE(m_Commands), m_Commands)) {
+
+			const uintptr_t uCount = TheProcessResults.m_uNumOutputCommands;
+			m_uCommandCount = uCount;
+
+			// Note the number of arguments needed
+			for (uintptr_t i = 0; i < uCount; ++i) {
+				if ((m_Commands[i].GetCommand() ==
+						SafePrint::COMMAND_FORMAT_ARGUMENT) &&
+					(m_Commands[i].GetArgIndex() >= m_uArgumentCount)) {
+					m_uArgumentCount = m_Commands[i].GetArgIndex() + 1U;
+				}
+			}
+			uResult = kErrorNone;
+		} else {
+			uResult = TheProcessResults.m_uPhaseResults;
+			if (uResult == kErrorNone) {
+				uResult = kErrorInvalidParameter;
+			}
+		}
+	}
+	m_uError = uResult;
+	return uResult;
+}
+
+/*! ************************************
+
+	\brief Bind arguments to a copy of the output commands
+
+	\param pResults Pointer to the parsing results
+	\param pCommands Pointer to a buffer of \ref SafePrint::kMAX_OUTPUT_COMMANDS
+		entries to receive the bound commands
+	\param uArgCount Number of arguments in the argument array
+	\param ppArgs Argument array, can be \ref nullptr if uArgCount is zero
+
+	\return \ref TRUE if successful, \ref FALSE on error
+
+***************************************/
+
+uint_t BURGER_API Burger::CompiledFormat::bind(
+	SafePrint::ProcessResults_t* pResults, SafePrint::ParamInfo_t* pCommands,
+	uintptr_t uArgCount, const ArgumentType** ppArgs) const BURGER_NOEXCEPT
+{
+	if (m_uError != kErrorNone) {
+		pResults->m_uPhaseResults = m_uError;
+		return FALSE;
+	}
+	if (uArgCount && IsPointerInvalid(ppArgs)) {
+		pResults->m_uPhaseResults = kErrorInvalidParameter;
+		return FALSE;
+	}
+
+	// Only the commands in use are copied
+	memory_copy(pCommands, m_Commands,
+		m_uCommandCount * sizeof(SafePrint::ParamInfo_t));
+	if (!pResults->BindArguments(uArgCount, ppArgs, m_uCommandCount,
+			pCommands)) {
+		return FALSE;
+	}
+
+	// Sanity check
+	if (pResults->m_uFormattedOutputLength >=
+		SafePrint::kMAX_TOTAL_OUTPUT_SIZE) {
+		pResults->m_uPhaseResults = kErrorBufferTooLarge;
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/*! ************************************
+
+	\brief snprintf() with a compiled format
+
+	Print into a buffer. The output is always zero terminated. If the buffer
+	is too small, nothing is printed and \ref kErrorBufferTooSmall is returned.
+
+	\param pOutput Pointer to the output buffer
+	\param uOutputSize Size of the output buffer in bytes
+	\param uArgCount Number of arguments in the argument array
+	\param ppArgs Argument array, can be \ref nullptr if uArgCount is zero
+
+	\return Number of bytes printed, not counting the terminating zero, or an
+		\ref eError code on failure
+
+	\sa format(String*,uintptr_t,const ArgumentType**) const
+
+***************************************/
+
+intptr_t BURGER_API Burger::CompiledFormat::format(char* pOutput,
+	uintptr_t uOutputSize, uintptr_t uArgCount,
+	const ArgumentType** ppArgs) const BURGER_NOEXCEPT
+{
+	// Any invalid parameters passed in?
+	if (IsPointerInvalid(pOutput) || !uOutputSize) {
+		return 0;
+	}
+
+	SafePrint::ProcessResults_t TheProcessResults;
+	SafePrint::ParamInfo_t Commands[SafePrint::kMAX_OUTPUT_COMMANDS];
+	if (bind(&TheProcessResults, Commands, uArgCount, ppArgs)) {
+
+		// need space for terminating null
+		if (TheProcessResults.m_uFormattedOutputLength < uOutputSize) {
+			const uintptr_t uProcessedCount =
+				TheProcessResults.GenerateFormatOutputToBuffer(pOutput,
+					uOutputSize, uArgCount, ppArgs, m_uCommandCount, Commands);
+
+			// Were we error free?
+			if (TheProcessResults.m_uPhaseResults == kErrorNone) {
+				pOutput[uProcessedCount] = 0;
+				return static_cast<intptr_t>(uProcessedCount);
+			}
+		} else {
+			TheProcessResults.m_uPhaseResults = kErrorBufferTooSmall;
+		}
+	}
+	pOutput[0] = 0;
+	return TheProcessResults.ErrorHandler(m_pFormat, uArgCount, ppArgs);
+}
+
+/*! ************************************
+
+	\brief Print into a String with a compiled format
+
+	The String is sized to the exact length of the output and the text is
+	generated directly into it. If the String is a local variable and the
+	output fits in its internal buffer, no memory is allocated.
+
+	\param pOutput Pointer to the String to receive the output
+	\param uArgCount Number of arguments in the argument array
+	\param ppArgs Argument array, can be \ref nullptr if uArgCount is zero
+
+	\return Number of bytes printed or an \ref eError code on failure
+
+	\sa format(char*,uintptr_t,uintptr_t,const ArgumentType**) const
+
+***************************************/
+
+intptr_t BURGER_API Burger::CompiledFormat::format(String* pOutput,
+	uintptr_t uArgCount, const ArgumentType** ppArgs) const BURGER_NOEXCEPT
+{
+	SafePrint::ProcessResults_t TheProcessResults;
+	SafePrint::ParamInfo_t Commands[SafePrint::kMAX_OUTPUT_COMMANDS];
+	if (bind(&TheProcessResults, Commands, uArgCount, ppArgs)) {
+		const uintptr_t uLength = TheProcessResults.m_uFormattedOutputLength;
+		if (pOutput->resize(uLength) != kErrorNone) {
+			TheProcessResults.m_uPhaseResults = kErrorOutOfMemory;
+		} else {
+			if (uLength) {
+				// The String has room for the terminating zero
+				TheProcessResults.GenerateFormatOutputToBuffer(pOutput->data(),
+					uLength + 1, uArgCount, ppArgs, m_uCommandCount, Commands);
+			}
+			if (TheProcessResults.m_uPhaseResults == kErrorNone) {
+				return static_cast<intptr_t>(uLength);
+			}
+		}
+	}
+	pOutput->clear();
+	return TheProcessResults.ErrorHandler(m_pFormat, uArgCount, ppArgs);
+}
+
+/*! ************************************
+
+	\brief fprintf() with a compiled format
+
+	The text is generated into a buffer on the stack and sent to the file with
+	a single call to fwrite(). Only if the output is larger than \ref
+	kStackBufferSize bytes is memory allocated.
+
+	\param fp Pointer to a FILE stream
+	\param uArgCount Number of arguments in the argument array
+	\param ppArgs Argument array, can be \ref nullptr if uArgCount is zero
+
+	\return Number of bytes printed or an \ref eError code on failure
+
+	\sa format(String*,uintptr_t,const ArgumentType**) const
+
+***************************************/
+
+intptr_t BURGER_API Burger::CompiledFormat::print(FILE* fp,
+	uintptr_t uArgCount, const ArgumentType** ppArgs) const BURGER_NOEXCEPT
+{
+	if (IsPointerInvalid(fp)) {
+		return 0;
+	}
+
+	SafePrint::ProcessResults_t TheProcessResults;
+	SafePrint::ParamInfo_t Commands[SafePrint::kMAX_OUTPUT_COMMANDS];
+	if (bind(&TheProcessResults, Commands, uArgCount, ppArgs)) {
+		const uintptr_t uLength = TheProcessResults.m_uFormattedOutputLength;
+
+		// Use the stack unless the output is too large
+		char Buffer[kStackBufferSize];
+		char* pWork = Buffer;
+		String Overflow;
+		if (uLength >= sizeof(Buffer)) {
+			if (Overflow.resize(uLength) != kErrorNone) {
+				TheProcessResults.m_uPhaseResults = kErrorOutOfMemory;
+				return TheProcessResults.ErrorHandler(
+					m_pFormat, uArgCount, ppArgs);
+			}
+			pWork = Overflow.data();
+		}
+
+		if (uLength) {
+			TheProcessResults.GenerateFormatOutputToBuffer(pWork, uLength + 1,
+				uArgCount, ppArgs, m_uCommandCount, Commands);
+		}
+		if ((TheProcessResults.m_uPhaseResults == kErrorNone) &&
+			TheProcessResults.WriteBufferToFile(fp, pWork, uLength, 0)) {
+			return static_cast<intptr_t>(uLength);
+		}
+	}
+	return TheProcessResults.ErrorHandler(m_pFormat, uArgCount, ppArgs);
+}
+
+/*! ************************************
+
+	\brief Find or create a shared CompiledFormat
+
+	Format strings are looked up by address, not contents, so this is intended
+	for string literals and other strings that are never modified or released.
+	The first call with a string compiles it, later calls return the same
+	object. This function is thread safe.
+
+	\param pFormat Pointer to a "C" format string that remains valid until
+		release_cache() is called
+
+	\return Pointer to the CompiledFormat or \ref nullptr if out of memory
+
+	\sa release_cache(void)
+
+***************************************/
+
+static Burger::MutexStatic g_CompiledFormatLock;
+static Burger::CompiledFormat* g_CompiledFormatCache[256];
+
+const Burger::CompiledFormat* BURGER_API Burger::CompiledFormat::get_cached(
+	const char* pFormat) BURGER_NOEXCEPT
+{
+	// Fibonacci hash of the address, the top 8 bits select the chain
+	const uint32_t uHash = static_cast<uint32_t>(
+		reinterpret_cast<uintptr_t>(pFormat) * 0x9E3779B1U);
+	CompiledFormat** ppChain = &g_CompiledFormatCache[uHash >> 24U];
+
+	MutexLock Lock(&g_CompiledFormatLock);
+	CompiledFormat* pWork = ppChain[0];
+	while (pWork) {
+		if (pWork->m_pFormat == pFormat) {
+			return pWork;
+		}
+		pWork = pWork->m_pNext;
+	}
+
+	// Not found, make a new one and keep it even if the string has errors
+	pWork = new_object<CompiledFormat>();
+	if (pWork) {
+		pWork->compile(pFormat);
+		pWork->m_pNext = ppChain[0];
+		ppChain[0] = pWork;
+	}
+	return pWork;
+}
+
+/*! ************************************
+
+	\brief Release all the shared CompiledFormat objects
+
+	Dispose of every CompiledFormat created by get_cached().
+
+	\note No other thread can be using a pointer returned by get_cached() when
+		this is called.
+
+	\sa get_cached(const char*)
+
+***************************************/
+
+void BURGER_API Burger::CompiledFormat::release_cache(void) BURGER_NOEXCEPT
+{
+	MutexLock Lock(&g_CompiledFormatLock);
+	uintptr_t i = 0;
+	do {
+		CompiledFormat* pWork = g_CompiledFormatCache[i];
+		g_CompiledFormatCache[i] = nullptr;
+		while (pWork) {
+			CompiledFormat* pNext = pWork->m_pNext;
+			delete_object(pWork);
+			pWork = pNext;
+		}
+	} while (++i < BURGER_ARRAYSIZE(g_CompiledFormatCache));
+}
+
+/*! ************************************
+
+	\fn const char* Burger::CompiledFormat::get_format(void) const
+	\brief Get the format string
+
+	\return Pointer to the format string passed to compile()
+
+***************************************/
+
+/*! ************************************
+
+	\fn eError Burger::CompiledFormat::get_error(void) const
+	\brief Get the result of compile()
+
+	\return \ref kErrorNone if the format string is valid
+
+***************************************/
+
+/*! ************************************
+
+	\fn uintptr_t Burger::CompiledFormat::get_argument_count(void) const
+	\brief Get the number of arguments needed
+
+	\return Number of arguments the format string refers to
+
+***************************************/
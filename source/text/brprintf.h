@@ -49,6 +49,10 @@
 #include "brfpprintinfo.h"
 #endif
 
+#ifndef __BRFPDECIMAL_H__
+#include "brfpdecimal.h"
+#endif
+
 #ifndef __BRARGUMENTTYPE_H__
 #include "brargumenttype.h"
 #endif
@@ -737,6 +741,16 @@ public:
 			FPPrintInfo::eResult uFPInfoResult, uint_t uIntSpecialDigits,
 			uint_t uPadIntZeros, uint_t uIsNegative) BURGER_NOEXCEPT;
 
+		BURGER_INLINE uint_t GetFloatPrecision(void) const BURGER_NOEXCEPT
+		{
+			if (!IsFlagSet(CONVFLAG_PRECISION_MARKER)) {
+				return 6;
+			}
+			return IsFlagSet(CONVFLAG_PRECISION_SPECIFIED) ? GetPrecision() : 0;
+		}
+		void BURGER_API ConvertReal(
+			FPDecimal* pOutput, const ArgumentType* pArg) const BURGER_NOEXCEPT;
+
 		BURGER_INLINE uint_t GetFloatSpecialChars(void) const BURGER_NOEXCEPT
 		{
 			return m_FloatInfo.m_uIntSpecialDigits;
@@ -778,6 +792,8 @@ public:
 			FPPrintInfo::eResult uSpecialResult) const BURGER_NOEXCEPT;
 		uintptr_t BURGER_API FormatReal(char* pOutBuffer,
 			const ArgumentType* pArg) const BURGER_NOEXCEPT;
+		eError BURGER_API BindArgument(eParseOptions uOptions,
+			const ArgumentType* pArg) BURGER_NOEXCEPT;
 	};
 	struct ProcessResults_t {
 		/** Number of output commands created */
@@ -810,6 +826,9 @@ public:
 			const char* pFormat, uintptr_t uFormatLength, uintptr_t uArgCount,
 			const ArgumentType** ppArgs, uintptr_t uParamInfoCount,
 			ParamInfo_t* pParamInfos) BURGER_NOEXCEPT;
+		uint_t BURGER_API BindArguments(uintptr_t uArgCount,
+			const ArgumentType** ppArgs, uintptr_t uParamInfoCount,
+			ParamInfo_t* pParamInfos) BURGER_NOEXCEPT;
 	};
 	typedef uint_t(BURGER_API* SprintfCallbackProc)(uint_t bNoErrors,
 		uintptr_t uRequestedSize, void** ppOutputBuffer, void* pContext);
@@ -835,6 +854,101 @@ public:
 		eConversionCommand uCommand) BURGER_NOEXCEPT;
 };
 
+class CompiledFormat {
+	BURGER_DISABLE_COPY(CompiledFormat);
+
+public:
+	/** Size of the stack buffer used by print() before using the heap */
+	static const uintptr_t kStackBufferSize = 512;
+
+protected:
+	/** Format string, it must remain valid for the life of this class */
+	const char* m_pFormat;
+	/** Next entry in the get_cached() hash chain */
+	CompiledFormat* m_pNext;
+	/** Number of entries in m_Commands */
+	uintptr_t m_uCommandCount;
+	/** Number of arguments the format string uses */
+	uintptr_t m_uArgumentCount;
+	/** Result of compile() */
+	eError m_uError;
+	/** Output commands, with the arguments not yet bound */
+	SafePrint::ParamInfo_t m_Commands[SafePrint::kMAX_OUTPUT_COMMANDS];
+
+	uint_t BURGER_API bind(SafePrint::ProcessResults_t* pResults,
+		SafePrint::ParamInfo_t* pCommands, uintptr_t uArgCount,
+		const ArgumentType** ppArgs) const BURGER_NOEXCEPT;
+
+public:
+	CompiledFormat(void) BURGER_NOEXCEPT;
+	CompiledFormat(const char* pFormat) BURGER_NOEXCEPT;
+
+	eError BURGER_API compile(const char* pFormat) BURGER_NOEXCEPT;
+	intptr_t BURGER_API format(char* pOutput, uintptr_t uOutputSize,
+		uintptr_t uArgCount, const ArgumentType** ppArgs) const BURGER_NOEXCEPT;
+	intptr_t BURGER_API format(String* pOutput, uintptr_t uArgCount,
+		const ArgumentType** ppArgs) const BURGER_NOEXCEPT;
+	intptr_t BURGER_API print(FILE* fp, uintptr_t uArgCount,
+		const ArgumentType** ppArgs) const BURGER_NOEXCEPT;
+
+	static const CompiledFormat* BURGER_API get_cached(
+		const char* pFormat) BURGER_NOEXCEPT;
+	static void BURGER_API release_cache(void) BURGER_NOEXCEPT;
+
+	BURGER_INLINE const char* get_format(void) const BURGER_NOEXCEPT
+	{
+		return m_pFormat;
+	}
+
+	BURGER_INLINE eError get_error(void) const BURGER_NOEXCEPT
+	{
+		return m_uError;
+	}
+
+	BURGER_INLINE uintptr_t get_argument_count(void) const BURGER_NOEXCEPT
+	{
+		return m_uArgumentCount;
+	}
+
+	BURGER_INLINE intptr_t format(
+		char* pOutput, uintptr_t uOutputSize) const BURGER_NOEXCEPT
+	{
+		return format(pOutput, uOutputSize, 0, nullptr);
+	}
+
+	BURGER_INLINE intptr_t format(String* pOutput) const BURGER_NOEXCEPT
+	{
+		return format(pOutput, 0, nullptr);
+	}
+
+	BURGER_INLINE intptr_t print(FILE* fp) const BURGER_NOEXCEPT
+	{
+		return print(fp, 0, nullptr);
+	}
+
+#if !defined(DOXYGEN)
+#define BURGER_TEMPMACRO(N) \
+	BURGER_INLINE intptr_t format( \
+		char* pOutput, uintptr_t uOutputSize, BURGER_SP_ARG##N) const \
+	{ \
+		const ArgumentType* ArgTable[N] = {BURGER_SP_INITARG##N}; \
+		return format(pOutput, uOutputSize, N, ArgTable); \
+	} \
+	BURGER_INLINE intptr_t format(String* pOutput, BURGER_SP_ARG##N) const \
+	{ \
+		const ArgumentType* ArgTable[N] = {BURGER_SP_INITARG##N}; \
+		return format(pOutput, N, ArgTable); \
+	} \
+	BURGER_INLINE intptr_t print(FILE* fp, BURGER_SP_ARG##N) const \
+	{ \
+		const ArgumentType* ArgTable[N] = {BURGER_SP_INITARG##N}; \
+		return print(fp, N, ArgTable); \
+	}
+	BURGER_EXPAND_FORMATTING_FUNCTION(BURGER_TEMPMACRO);
+#undef BURGER_TEMPMACRO
+#endif
+};
+
 extern intptr_t BURGER_API GetFormattedLength(const char* pFormat,
 	uintptr_t uArgCount, const ArgumentType** ppArgs) BURGER_NOEXCEPT;
 extern intptr_t BURGER_API SprintfUserAlloc(
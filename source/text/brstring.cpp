@@ -27,12 +27,19 @@
 	\brief UTF 8 bit string class
 
 	This commonly used string class was designed for performance in mind. Each
-	instance takes 64 bytes to contain data for the string and a pointer
+	instance takes 96 bytes to contain data for the string and a pointer
 	to allocated memory if the internal string buffer is too large. Since
-	most strings rarely exceed 56 bytes in length, this class will be able to
-	allocate and free strings with no calls to a memory manager. Only
-	when the string exceeds the internal buffer will Burger::allocate_memory()
-	and Burger::free_memory() be used.
+	most strings rarely exceed \ref kBufferSize - 1 bytes in length, this class
+	will be able to allocate and free strings with no calls to a memory
+	manager. Only when the string exceeds the internal buffer will
+	Burger::allocate_memory() and Burger::free_memory() be used.
+
+	When appending causes the buffer to grow, the new buffer is 50% larger
+	than the needed size, so a loop of appends performs a logarithmic number
+	of allocations. Use reserve(uintptr_t) if the final size is known, and
+	shrink_to_fit() to release the excess once the string is complete.
+	Strings that own an allocated buffer hand it over when moved, so
+	returning a String by value doesn't copy the string.
 
 	Functions exist to convert UTF16 and UTF32 data into UTF8 format,
 	which this string class uses internally for data storage.
@@ -215,33 +222,7 @@ Burger::String::String(String&& rInput) BURGER_NOEXCEPT
 
 Burger::String& Burger::String::operator=(String&& rInput) BURGER_NOEXCEPT
 {
-	if (this != &rInput) {
-
-		// If the internal buffer is too small, it must be a pointer
-		if (m_uBufferSize < rInput.m_uLength) {
-
-			// Capturing the other pointer. Release our pointer
-			if (m_pData != m_Raw) {
-				free_memory(m_pData);
-			}
-
-			// Copy the contents
-			m_pData = rInput.m_pData;
-			m_uLength = rInput.m_uLength;
-			m_uBufferSize = rInput.m_uBufferSize;
-
-			// Neuter the other class
-			rInput.m_pData = rInput.m_Raw;
-			rInput.m_uLength = 0;
-			rInput.m_uBufferSize = kBufferSize - 1;
-			rInput.m_Raw[0] = 0;
-
-		} else {
-			// If the buffer is big enough, just copy and be done with it.
-			memory_copy(m_pData, rInput.m_pData, rInput.m_uLength + 1);
-			m_uLength = rInput.m_uLength;
-		}
-	}
+	assign(static_cast<String&&>(rInput));
 	return *this;
 }
 #endif
@@ -870,7 +851,8 @@ Burger::eError BURGER_API Burger::String::assign(
 	\brief Move a String into this string.
 
 	Move the contents of the string into this string. The rvalue will be empty
-	after this call completes.
+	after this call completes. If the rvalue has an allocated buffer, the
+	buffer is taken and no data is copied.
 
 	\param rInput Reference to the String to copy.
 
@@ -879,6 +861,11 @@ Burger::eError BURGER_API Burger::String::assign(
 #if defined(BURGER_RVALUE_REFERENCES) || defined(DOXYGEN)
 void BURGER_API Burger::String::assign(String&& rInput) BURGER_NOEXCEPT
 {
+	// Moving onto itself does nothing
+	if (this == &rInput) {
+		return;
+	}
+
 	// If this string has a buffer, dispose of it.
 	if (m_pData != m_Raw) {
 		free_memory(m_pData);
@@ -1372,27 +1359,28 @@ Burger::eError BURGER_API Burger::String::reserve(
 	// Should it grow?
 	if (uNewBufferSize > m_uBufferSize) {
 
-		// Create a new buffer
-		char* pDest = static_cast<char*>(allocate_memory(uNewBufferSize + 1));
+		// Allocated buffers are resized, which may not need a copy
+		char* pDest;
+		if (m_pData != m_Raw) {
+			pDest = static_cast<char*>(
+				reallocate_memory(m_pData, uNewBufferSize + 1));
+		} else {
+			pDest = static_cast<char*>(allocate_memory(uNewBufferSize + 1));
+			if (pDest) {
+				memory_copy(pDest, m_Raw, m_uLength + 1);
+			}
+		}
 
 		// Oh oh...
 		if (!pDest) {
 			// Out of memory error!
-			// Do nothing.
+			// Do nothing, the old buffer is still valid
 			uResult = kErrorOutOfMemory;
 
 		} else {
-
-			// Copy data to the new buffer and keep it
-			m_uBufferSize = uNewBufferSize;
-			const char* pWork = m_pData;
+			// Keep the new buffer
 			m_pData = pDest;
-			memory_copy(pDest, pWork, m_uLength + 1);
-
-			// Discard previous memory if it was allocated
-			if (pWork != m_Raw) {
-				free_memory(pWork);
-			}
+			m_uBufferSize = uNewBufferSize;
 		}
 	}
 
@@ -1400,6 +1388,77 @@ Burger::eError BURGER_API Burger::String::reserve(
 	return uResult;
 }
 
+/*! ************************************
+
+	\brief Grow the buffer for a longer string
+
+	If the buffer can't hold a string of uNewLength bytes, grow it to 50%
+	larger than requested so a series of appends only allocates a logarithmic
+	number of times. If that allocation fails, try again with the exact size.
+
+	\param uNewLength Length in bytes of the string that needs to fit
+
+	\return Zero if no error, error code if the buffer couldn't be grown
+
+	\sa reserve(uintptr_t)
+
+***************************************/
+
+Burger::eError BURGER_API Burger::String::grow(
+	uintptr_t uNewLength) BURGER_NOEXCEPT
+{
+	eError uResult = kErrorNone;
+	if (uNewLength > m_uBufferSize) {
+		// Increase the buffer a bit
+		uResult = reserve(uNewLength + (uNewLength >> 1));
+		if (uResult) {
+			// No padding?
+			uResult = reserve(uNewLength);
+		}
+	}
+	return uResult;
+}
+
+/*! ************************************
+
+	\brief Release unused buffer memory
+
+	If the string has an allocated buffer larger than needed, shrink it to
+	fit the string. If the string fits in the internal buffer, the allocated
+	buffer is released.
+
+	\return Zero if no error, error code if the buffer couldn't be resized
+
+	\sa reserve(uintptr_t) or capacity(void) const
+
+***************************************/
+
+Burger::eError BURGER_API Burger::String::shrink_to_fit(void) BURGER_NOEXCEPT
+{
+	eError uResult = kErrorNone;
+	char* pWork = m_pData;
+	if (pWork != m_Raw) {
+		const uintptr_t uLength = m_uLength;
+		if (uLength < kBufferSize) {
+			// Move back into the internal buffer
+			memory_copy(m_Raw, pWork, uLength + 1);
+			m_pData = m_Raw;
+			m_uBufferSize = kBufferSize - 1;
+			free_memory(pWork);
+
+		} else if (uLength != m_uBufferSize) {
+			pWork = static_cast<char*>(reallocate_memory(pWork, uLength + 1));
+			if (!pWork) {
+				uResult = kErrorOutOfMemory;
+			} else {
+				m_pData = pWork;
+				m_uBufferSize = uLength;
+			}
+		}
+	}
+	return uResult;
+}
+
 /*! ************************************
 
 	\brief Locate a String in a String.
@@ -2097,11 +2156,14 @@ Burger::eError BURGER_API Burger::String::insert(
 		return append(pInput, uLength);
 	}
 
+	// The input could be part of this string
+	uintptr_t uOffset = reinterpret_cast<uintptr_t>(pInput) -
+		reinterpret_cast<uintptr_t>(m_pData);
+
 	// Adjust the buffer size
 	const uintptr_t uTotalLength = uOriginalLength + uLength;
-	const eError uResult = reserve(uTotalLength);
+	const eError uResult = grow(uTotalLength);
 	if (!uResult) {
-
 		m_uLength = uTotalLength;
 		// Move tail end of the string to make room new data
 		uintptr_t uInsertOffset = uStart + uLength;
@@ -2109,7 +2171,23 @@ Burger::eError BURGER_API Burger::String::insert(
 			(uOriginalLength - uStart) + 1);
 
 		// Insert the new data
-		memory_copy(m_pData + uStart, pInput, uLength);
+		if (uOffset > uOriginalLength) {
+			memory_copy(m_pData + uStart, pInput, uLength);
+		} else {
+			// The input is part of this string. Bytes before the insertion
+			// point didn't move, the rest were moved with the tail.
+			uintptr_t uHead = 0;
+			if (uOffset < uStart) {
+				uHead = uStart - uOffset;
+				if (uHead > uLength) {
+					uHead = uLength;
+				}
+				memory_copy(m_pData + uStart, m_pData + uOffset, uHead);
+				uOffset = uStart;
+			}
+			memory_copy(m_pData + uStart + uHead,
+				m_pData + uOffset + uLength, uLength - uHead);
+		}
 	}
 	return uResult;
 }
@@ -2136,11 +2214,7 @@ Burger::eError Burger::String::push_back(char iInput) BURGER_NOEXCEPT
 	if (uInputLen1 >= m_uBufferSize) {
 
 		// Increase the buffer a bit
-		uResult = reserve(uInputLen1 + (uInputLen1 >> 1));
-		if (uResult) {
-			// No padding?
-			uResult = reserve(uInputLen1 + 1);
-		}
+		uResult = grow(uInputLen1 + 1);
 
 		// No error? Append it
 		if (!uResult) {
@@ -2218,15 +2292,18 @@ Burger::eError BURGER_API Burger::String::append(
 	uintptr_t uTotalLength = uInputLength1 + uInputSize;
 	if (m_uBufferSize < uTotalLength) {
 
+		// The input could be part of this string, like append(*this)
+		const uintptr_t uOffset = reinterpret_cast<uintptr_t>(pInput) -
+			reinterpret_cast<uintptr_t>(m_pData);
+
 		// Increase the buffer a bit
-		uResult = reserve(uTotalLength + (uTotalLength >> 1));
-		if (uResult) {
-			// No padding?
-			uResult = reserve(uTotalLength + 1);
-		}
+		uResult = grow(uTotalLength);
 
 		// No error? Append it
 		if (!uResult) {
+			if (uOffset <= uInputLength1) {
+				pInput = m_pData + uOffset;
+			}
 			// Append it
 			memory_copy(m_pData + uInputLength1, pInput, uInputSize);
 			m_pData[uTotalLength] = 0;
@@ -2317,6 +2394,64 @@ Burger::eError BURGER_API Burger::String::append(
 	return append(rInput.m_pData, rInput.m_uLength);
 }
 
+/*! ************************************
+
+	\brief Append several "C" strings to the current string.
+
+	The final length is calculated first, so the buffer is grown at most once
+	no matter how many strings are appended. \ref nullptr entries are skipped.
+
+	\note The input strings must not point into this string's buffer, since
+		the buffer could move.
+
+	\code
+	const char* Parts[4] = {pPath, "/", pName, ".txt"};
+	FileName.append_many(Parts, 4);
+	\endcode
+
+	\param ppInputs Pointer to an array of "C" string pointers
+	\param uCount Number of entries in the array
+
+	\return Zero if no error, non-zero on memory error.
+
+	\sa append(const char*, uintptr_t)
+
+***************************************/
+
+Burger::eError BURGER_API Burger::String::append_many(
+	const char* const* ppInputs, uintptr_t uCount) BURGER_NOEXCEPT
+{
+	eError uResult = kErrorNone;
+	if (uCount) {
+		// Get the final size
+		uintptr_t uTotalLength = m_uLength;
+		uintptr_t i = 0;
+		do {
+			if (ppInputs[i]) {
+				uTotalLength += string_length(ppInputs[i]);
+			}
+		} while (++i < uCount);
+
+		// Grow once for all of the strings
+		uResult = grow(uTotalLength);
+		if (!uResult) {
+			char* pWork = m_pData + m_uLength;
+			i = 0;
+			do {
+				const char* pInput = ppInputs[i];
+				if (pInput) {
+					const uintptr_t uLength = string_length(pInput);
+					memory_copy(pWork, pInput, uLength);
+					pWork += uLength;
+				}
+			} while (++i < uCount);
+			pWork[0] = 0;
+			m_uLength = uTotalLength;
+		}
+	}
+	return uResult;
+}
+
 /*! ************************************
 
 	\brief Resize a string and either truncate or append with a fill
@@ -98,6 +98,7 @@ protected:
 	void BURGER_API assign_small(const char* pInput) BURGER_NOEXCEPT;
 	void BURGER_API assign_small(
 		const char* pInput, uintptr_t uLength) BURGER_NOEXCEPT;
+	eError BURGER_API grow(uintptr_t uNewLength) BURGER_NOEXCEPT;
 
 public:
 	String(void) BURGER_NOEXCEPT: m_pData(m_Raw),
@@ -218,6 +219,7 @@ public:
 
 	eError BURGER_API resize(uintptr_t uSize) BURGER_NOEXCEPT;
 	eError BURGER_API reserve(uintptr_t uNewBufferSize) BURGER_NOEXCEPT;
+	eError BURGER_API shrink_to_fit(void) BURGER_NOEXCEPT;
 
 	uintptr_t BURGER_API find(
 		const String& rInput, uintptr_t uPosition = 0) const BURGER_NOEXCEPT;
@@ -317,6 +319,8 @@ public:
 	eError BURGER_API append(const String& rInput) BURGER_NOEXCEPT;
 	eError BURGER_API append(
 		const char* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT;
+	eError BURGER_API append_many(
+		const char* const* ppInputs, uintptr_t uCount) BURGER_NOEXCEPT;
 	String& BURGER_API Left(
 		uintptr_t uNewLength, char iInput = ' ') BURGER_NOEXCEPT;
 	String& BURGER_API Right(
@@ -38,22 +38,33 @@ class String16 {
 public:
 	/** Ensures the structure is 128 bytes in size on all platforms */
 	static const uintptr_t BUFFERSIZE = static_cast<uintptr_t>(
-		(128 - (sizeof(uint16_t*) + sizeof(uintptr_t))) / sizeof(uint16_t));
+		(128 - (sizeof(uint16_t*) + sizeof(uintptr_t) * 2)) /
+		sizeof(uint16_t));
 
 private:
 	/** Pointer to the string */
 	uint16_t* m_pData;
 	/** Length of the string */
 	uintptr_t m_uLength;
+	/** Size of the buffer in characters, minimum BUFFERSIZE - 1 */
+	uintptr_t m_uBufferSize;
 	/** Temp preallocated buffer for most strings Structure size is 128 bytes */
 	uint16_t m_Raw[BUFFERSIZE];
 
+	eError BURGER_API grow(uintptr_t uNewLength) BURGER_NOEXCEPT;
+
 public:
-	String16(void) BURGER_NOEXCEPT: m_pData(m_Raw), m_uLength(0)
+	String16(void) BURGER_NOEXCEPT: m_pData(m_Raw),
+									m_uLength(0),
+									m_uBufferSize(BUFFERSIZE - 1)
 	{
 		m_Raw[0] = 0;
 	}
 	String16(const String16& rInput);
+#if defined(BURGER_RVALUE_REFERENCES) || defined(DOXYGEN)
+	String16(String16&& rInput) BURGER_NOEXCEPT;
+	String16& operator=(String16&& rInput) BURGER_NOEXCEPT;
+#endif
 	String16(
 		const String16& rInput, uintptr_t uStart, uintptr_t uEnd = UINTPTR_MAX);
 	String16(const char* pInput) BURGER_NOEXCEPT;
@@ -103,6 +114,10 @@ public:
 	{
 		return !m_uLength;
 	}
+	BURGER_INLINE uintptr_t capacity(void) const BURGER_NOEXCEPT
+	{
+		return m_uBufferSize;
+	}
 	BURGER_INLINE uintptr_t GetLength(void) const BURGER_NOEXCEPT
 	{
 		return m_uLength;
@@ -122,11 +137,23 @@ public:
 	{
 		return SetBufferSize(uSize);
 	}
+	eError BURGER_API reserve(uintptr_t uNewBufferSize) BURGER_NOEXCEPT;
+	eError BURGER_API shrink_to_fit(void) BURGER_NOEXCEPT;
+	eError BURGER_API push_back(uint16_t uInput) BURGER_NOEXCEPT;
+	eError BURGER_API append(const uint16_t* pInput) BURGER_NOEXCEPT;
+	eError BURGER_API append(
+		const uint16_t* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT;
+	eError BURGER_API append(const String16& rInput) BURGER_NOEXCEPT;
+	eError BURGER_API append_many(
+		const uint16_t* const* ppInputs, uintptr_t uCount) BURGER_NOEXCEPT;
 
 	String16& operator=(const String16& rInput);
 	String16& operator=(const uint16_t* pInput);
 	String16& operator=(const char* pInput);
 	String16& operator=(char cInput);
+	String16& operator+=(uint16_t uInput) BURGER_NOEXCEPT;
+	String16& operator+=(const uint16_t* pInput) BURGER_NOEXCEPT;
+	String16& operator+=(const String16& rInput) BURGER_NOEXCEPT;
 	BURGER_INLINE String16 operator()(
 		uintptr_t uStart, uintptr_t uEnd) const BURGER_NOEXCEPT
 	{
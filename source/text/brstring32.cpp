@@ -34,6 +34,10 @@
 	Functions exist to convert UTF8 and UTF16 data into UTF32 format,
 	which this string class uses internally for data storage.
 
+	Appending grows the buffer to 50% more than needed, so a loop of appends
+	only allocates a logarithmic number of times, and moving a String32 hands
+	over its allocated buffer instead of copying it.
+
 	\sa Burger::String
 
 ***************************************/
@@ -69,11 +73,89 @@ Burger::String32::String32(const Burger::String32& rInput)
 	}
 	m_uLength = uInputLength; // Save the new length
 	m_pData = pWork;          // Set the pointer
+	m_uBufferSize = (pWork == m_Raw) ? BUFFERSIZE - 1 : uInputLength;
 	memory_copy(pWork, pInput,
 		(uInputLength + 1) *
 			sizeof(uint32_t)); // Copy the string and the ending NULL
 }
 
+/*! ************************************
+
+	\brief Move constructor
+
+	If the input has an allocated buffer, take it, otherwise copy the
+	internal buffer. The input is left empty.
+
+	Only available on C++11 or higher.
+
+	\param rInput Reference to a Burger::String32
+
+***************************************/
+
+#if defined(BURGER_RVALUE_REFERENCES) || defined(DOXYGEN)
+Burger::String32::String32(String32&& rInput) BURGER_NOEXCEPT
+{
+	m_uLength = rInput.m_uLength;
+	m_uBufferSize = rInput.m_uBufferSize;
+	if (rInput.m_pData != rInput.m_Raw) {
+		m_pData = rInput.m_pData;
+
+		// Zap the origin
+		rInput.m_pData = rInput.m_Raw;
+		rInput.m_uLength = 0;
+		rInput.m_uBufferSize = BUFFERSIZE - 1;
+		rInput.m_Raw[0] = 0;
+	} else {
+		m_pData = m_Raw;
+		memory_copy(
+			m_Raw, rInput.m_Raw, (rInput.m_uLength + 1) * sizeof(uint32_t));
+		rInput.m_uLength = 0;
+		rInput.m_Raw[0] = 0;
+	}
+}
+
+/*! ************************************
+
+	\brief Move assignment operator
+
+	If the input has an allocated buffer, take it, otherwise copy the
+	internal buffer. The input is left empty.
+
+	Only available on C++11 or higher.
+
+	\param rInput Reference to a Burger::String32
+	\return A reference to the this pointer
+
+***************************************/
+
+Burger::String32& Burger::String32::operator=(String32&& rInput) BURGER_NOEXCEPT
+{
+	if (this != &rInput) {
+		if (rInput.m_pData != rInput.m_Raw) {
+			// Take the buffer
+			if (m_pData != m_Raw) {
+				free_memory(m_pData);
+			}
+			m_pData = rInput.m_pData;
+			m_uLength = rInput.m_uLength;
+			m_uBufferSize = rInput.m_uBufferSize;
+
+			// Zap the origin
+			rInput.m_pData = rInput.m_Raw;
+			rInput.m_uBufferSize = BUFFERSIZE - 1;
+		} else {
+			// It fits in any buffer this string has
+			m_uLength = rInput.m_uLength;
+			memory_copy(m_pData, rInput.m_Raw,
+				(rInput.m_uLength + 1) * sizeof(uint32_t));
+		}
+		rInput.m_uLength = 0;
+		rInput.m_Raw[0] = 0;
+	}
+	return *this;
+}
+#endif
+
 /*! ************************************
 
 	\brief Initialize a Burger::String32 by using a subsection of a different
@@ -119,6 +201,7 @@ Burger::String32::String32(
 	pWork[uInputLength] = 0;
 	m_uLength = uInputLength; // Save the new length
 	m_pData = pWork;          // Set the pointer
+	m_uBufferSize = (pWork == m_Raw) ? BUFFERSIZE - 1 : uInputLength;
 	memory_copy(
 		pWork, pInput, uInputLength * sizeof(uint32_t)); // Copy the string
 }
@@ -155,6 +238,7 @@ Burger::String32::String32(const char* pInput) BURGER_NOEXCEPT
 	}
 	m_uLength = uInputLength; // Save the new length
 	m_pData = pWork;          // Set the pointer
+	m_uBufferSize = (pWork == m_Raw) ? BUFFERSIZE - 1 : uInputLength;
 	UTF32::translate_from_UTF8(
 		pWork, uInputLength + 1, pInput); // Copy the string
 }
@@ -195,6 +279,8 @@ Burger::String32::String32(const char* pInput, uintptr_t uPadding)
 	}
 	m_uLength = uInputLength; // Save the new length
 	m_pData = pWork;          // Set the pointer
+	m_uBufferSize =
+		(pWork == m_Raw) ? BUFFERSIZE - 1 : uInputLength + uPadding;
 	UTF32::translate_from_UTF8(
 		pWork, uInputLength + 1, pInput); // Copy the string
 }
@@ -229,6 +315,7 @@ Burger::String32::String32(const uint32_t* pInput)
 	}
 	m_uLength = uInputLength; // Save the new length
 	m_pData = pWork;          // Set the pointer
+	m_uBufferSize = (pWork == m_Raw) ? BUFFERSIZE - 1 : uInputLength;
 	memory_copy(pWork, pInput,
 		(uInputLength + 1) * sizeof(uint32_t)); // Copy the string
 }
@@ -313,6 +400,18 @@ Burger::String32::String32(const uint32_t* pInput)
 
 ***************************************/
 
+/*! ************************************
+
+	\fn Burger::String32::capacity(void) const
+	\brief Return the size of the string buffer
+
+	\return The number of characters that can be stored, not counting the
+		terminating zero
+
+	\sa reserve(uintptr_t)
+
+***************************************/
+
 /*! ************************************
 
 	\fn Burger::String32::GetPtr()
@@ -352,30 +451,32 @@ Burger::eError BURGER_API Burger::String32::assign(
 {
 	// Assume no error
 	eError uResult = kErrorNone;
-
 	if (!pInput) {
 		pInput = g_EmptyString32;
 	}
-	uint32_t* pDest = m_Raw;
 	uintptr_t uInputLength = string_length(pInput); // Length of the new string
-	if (uInputLength >= BUFFERSIZE) {               // Buffer big enough?
-		pDest = static_cast<uint32_t*>(
+
+	// Reuse the current buffer if it's big enough
+	if (uInputLength <= m_uBufferSize) {
+		m_uLength = uInputLength;
+		memory_move(m_pData, pInput, (uInputLength + 1) * sizeof(uint32_t));
+	} else {
+		uint32_t* pDest = static_cast<uint32_t*>(
 			allocate_memory((uInputLength + 1) * sizeof(uint32_t)));
 		if (!pDest) { // Oh oh...
-			pDest = m_Raw;
-			uInputLength = 0;            // Don't copy anything
-			pInput = g_EmptyString32;    // Will copy the null character
+			clear();
 			uResult = kErrorOutOfMemory; // Error!
+		} else {
+			memory_copy(
+				pDest, pInput, (uInputLength + 1) * sizeof(uint32_t));
+			if (m_pData != m_Raw) { // Discard previous memory
+				free_memory(m_pData);
+			}
+			m_pData = pDest;          // Set the pointer
+			m_uLength = uInputLength; // Save the new length
+			m_uBufferSize = uInputLength;
 		}
 	}
-	const uint32_t* pOld = m_pData;
-	m_uLength = uInputLength; // Save the new length
-	m_pData = pDest;          // Set the pointer
-	memory_move(pDest, pInput,
-		(uInputLength + 1) * sizeof(uint32_t)); // Copy the string
-	if (pOld != m_Raw) {                        // Discard previous memory
-		free_memory(pOld);
-	}
 	// Return error
 	return uResult;
 }
@@ -396,33 +497,30 @@ Burger::eError BURGER_API Burger::String32::assign(
 {
 	// Assume no error
 	eError uResult = kErrorNone;
-
 	if (!pInput) {
 		pInput = g_EmptyString;
 	}
-	uint32_t* pDest = m_Raw;
 	// Length of the new string
 	uintptr_t uInputLength = UTF32::translate_from_UTF8(nullptr, 0, pInput);
-	// Buffer big enough?
-	if (uInputLength >= BUFFERSIZE) {
-		pDest = static_cast<uint32_t*>(
+
+	// Reuse the current buffer if it's big enough
+	if (uInputLength > m_uBufferSize) {
+		uint32_t* pDest = static_cast<uint32_t*>(
 			allocate_memory((uInputLength + 1) * sizeof(uint32_t)));
 		if (!pDest) { // Oh oh...
-			pDest = m_Raw;
-			uInputLength = 0;            // Don't copy anything
-			pInput = g_EmptyString;      // Will copy the null character
-			uResult = kErrorOutOfMemory; // Error!
+			clear();
+			return kErrorOutOfMemory; // Error!
+		}
+		// Discard previous memory
+		if (m_pData != m_Raw) {
+			free_memory(m_pData);
 		}
+		m_pData = pDest; // Set the pointer
+		m_uBufferSize = uInputLength;
 	}
-	const uint32_t* pOld = m_pData;
 	m_uLength = uInputLength; // Save the new length
-	m_pData = pDest;          // Set the pointer
 	// Copy the string
-	UTF32::translate_from_UTF8(pDest, uInputLength + 1, pInput);
-	// Discard previous memory
-	if (pOld != m_Raw) {
-		free_memory(pOld);
-	}
+	UTF32::translate_from_UTF8(m_pData, uInputLength + 1, pInput);
 	// Return error
 	return uResult;
 }
@@ -454,33 +552,276 @@ Burger::eError BURGER_API Burger::String32::SetBufferSize(
 		if (!uSize) {
 			clear();
 		} else {
-			// Hold the old buffer
-			uint32_t* pWork = m_pData;
-			// Get the new buffer
-			uint32_t* pDest = m_Raw;
-			// Allocate a new buffer if needed
-			if (uSize >= BUFFERSIZE) { // Buffer big enough?
-				pDest = static_cast<uint32_t*>(allocate_memory((uSize + 1) * 4));
-				if (!pDest) { // Oh oh...
-					pDest = m_Raw;
-					uSize = 0; // Don't copy anything
-					uResult = kErrorOutOfMemory;
+			// Make room, keeping the old string
+			uResult = reserve(uSize);
+			if (uResult) {
+				clear();
+			} else {
+				// Zero fill any new characters and the terminating zero
+				const uintptr_t uLength = m_uLength;
+				if (uSize > uLength) {
+					memory_clear(m_pData + uLength,
+						(uSize - uLength) * sizeof(uint32_t));
 				}
+				m_uLength = uSize;    // Save the new length
+				m_pData[uSize] = 0; // Ensure the terminating zero is present
+			}
+		}
+	}
+	return uResult;
+}
+
+/*! ************************************
+
+	\brief Ensure a minimum buffer size
+
+	If the buffer can't hold a string of uNewBufferSize characters, grow it
+	while retaining the existing string. The buffer is always padded for the
+	terminating zero.
+
+	\param uNewBufferSize Number of characters the buffer must hold
+
+	\return Zero if no error, error code if the buffer couldn't be resized
+
+	\sa shrink_to_fit(void) or capacity(void) const
+
+***************************************/
+
+Burger::eError BURGER_API Burger::String32::reserve(
+	uintptr_t uNewBufferSize) BURGER_NOEXCEPT
+{
+	eError uResult = kErrorNone;
+	if (uNewBufferSize > m_uBufferSize) {
+		const uintptr_t uBytes = (uNewBufferSize + 1) * sizeof(uint32_t);
+		uint32_t* pDest;
+		if (m_pData != m_Raw) {
+			pDest = static_cast<uint32_t*>(reallocate_memory(m_pData, uBytes));
+		} else {
+			pDest = static_cast<uint32_t*>(allocate_memory(uBytes));
+			if (pDest) {
+				memory_copy(
+					pDest, m_Raw, (m_uLength + 1) * sizeof(uint32_t));
 			}
-			// Get the size of the string
-			uintptr_t uDestSize = m_uLength;
-			if (uDestSize >= uSize) {
-				// Truncate the string
-				uDestSize = uSize;
+		}
+		if (!pDest) {
+			// The old buffer is still valid
+			uResult = kErrorOutOfMemory;
+		} else {
+			m_pData = pDest;
+			m_uBufferSize = uNewBufferSize;
+		}
+	}
+	return uResult;
+}
+
+/*! ************************************
+
+	\brief Grow the buffer for a longer string
+
+	If the buffer can't hold a string of uNewLength characters, grow it to 50%
+	larger than requested. If that allocation fails, try again with the exact
+	size.
+
+	\param uNewLength Length in characters of the string that needs to fit
+
+	\return Zero if no error, error code if the buffer couldn't be grown
+
+***************************************/
+
+Burger::eError BURGER_API Burger::String32::grow(
+	uintptr_t uNewLength) BURGER_NOEXCEPT
+{
+	eError uResult = kErrorNone;
+	if (uNewLength > m_uBufferSize) {
+		uResult = reserve(uNewLength + (uNewLength >> 1));
+		if (uResult) {
+			uResult = reserve(uNewLength);
+		}
+	}
+	return uResult;
+}
+
+/*! ************************************
+
+	\brief Release unused buffer memory
+
+	If the string has an allocated buffer larger than needed, shrink it to
+	fit the string. If the string fits in the internal buffer, the allocated
+	buffer is released.
+
+	\return Zero if no error, error code if the buffer couldn't be resized
+
+	\sa reserve(uintptr_t)
+
+***************************************/
+
+Burger::eError BURGER_API Burger::String32::shrink_to_fit(void) BURGER_NOEXCEPT
+{
+	eError uResult = kErrorNone;
+	uint32_t* pWork = m_pData;
+	if (pWork != m_Raw) {
+		const uintptr_t uLength = m_uLength;
+		if (uLength < BUFFERSIZE) {
+			// Move back into the internal buffer
+			memory_copy(m_Raw, pWork, (uLength + 1) * sizeof(uint32_t));
+			m_pData = m_Raw;
+			m_uBufferSize = BUFFERSIZE - 1;
+			free_memory(pWork);
+		} else if (uLength != m_uBufferSize) {
+			pWork = static_cast<uint32_t*>(
+				reallocate_memory(pWork, (uLength + 1) * sizeof(uint32_t)));
+			if (!pWork) {
+				uResult = kErrorOutOfMemory;
+			} else {
+				m_pData = pWork;
+				m_uBufferSize = uLength;
 			}
-			memory_copy(pDest, pWork, uDestSize * 4);
-			pDest[uDestSize] = 0; // Ensure the buffer is zero terminated
-			if (pWork != m_Raw) { // Discard previous memory
-				free_memory(pWork);
+		}
+	}
+	return uResult;
+}
+
+/*! ************************************
+
+	\brief Append a single character to the current string.
+
+	\param uInput Character to append
+
+	\return Zero if no error, non-zero on memory error.
+
+***************************************/
+
+Burger::eError BURGER_API Burger::String32::push_back(
+	uint32_t uInput) BURGER_NOEXCEPT
+{
+	const uintptr_t uLength = m_uLength;
+	const eError uResult = grow(uLength + 1);
+	if (!uResult) {
+		uint32_t* pWork = m_pData;
+		pWork[uLength] = uInput;
+		pWork[uLength + 1] = 0;
+		m_uLength = uLength + 1;
+	}
+	return uResult;
+}
+
+/*! ************************************
+
+	\brief Append a UTF32 "C" string to the current string.
+
+	\param pInput Pointer to a UTF32 "C" string, \ref nullptr does nothing
+
+	\return Zero if no error, non-zero on memory error.
+
+***************************************/
+
+Burger::eError BURGER_API Burger::String32::append(
+	const uint32_t* pInput) BURGER_NOEXCEPT
+{
+	if (!pInput) {
+		return kErrorNone;
+	}
+	return append(pInput, string_length(pInput));
+}
+
+/*! ************************************
+
+	\brief Append a UTF32 string buffer to the current string.
+
+	Increase the buffer if needed and append the input string to the existing
+	string. The input can be part of this string.
+
+	\param pInput Pointer to a UTF32 string
+	\param uInputSize Number of characters to append
+
+	\return Zero if no error, non-zero on memory error.
+
+***************************************/
+
+Burger::eError BURGER_API Burger::String32::append(
+	const uint32_t* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT
+{
+	const uintptr_t uLength = m_uLength;
+	const uintptr_t uTotalLength = uLength + uInputSize;
+
+	// The input could be part of this string, like append(*this)
+	const uintptr_t uOffset = reinterpret_cast<uintptr_t>(pInput) -
+		reinterpret_cast<uintptr_t>(m_pData);
+	const eError uResult = grow(uTotalLength);
+	if (!uResult) {
+		if (uOffset <= (uLength * sizeof(uint32_t))) {
+			pInput = reinterpret_cast<const uint32_t*>(
+				reinterpret_cast<const uint8_t*>(m_pData) + uOffset);
+		}
+		memory_copy(m_pData + uLength, pInput, uInputSize * sizeof(uint32_t));
+		m_pData[uTotalLength] = 0;
+		m_uLength = uTotalLength;
+	}
+	return uResult;
+}
+
+/*! ************************************
+
+	\brief Append a Burger::String32 to the current string.
+
+	\param rInput Reference to the string to append
+
+	\return Zero if no error, non-zero on memory error.
+
+***************************************/
+
+Burger::eError BURGER_API Burger::String32::append(
+	const String32& rInput) BURGER_NOEXCEPT
+{
+	return append(rInput.m_pData, rInput.m_uLength);
+}
+
+/*! ************************************
+
+	\brief Append several UTF32 "C" strings to the current string.
+
+	The final length is calculated first, so the buffer is grown at most once
+	no matter how many strings are appended. \ref nullptr entries are skipped.
+
+	\note The input strings must not point into this string's buffer, since
+		the buffer could move.
+
+	\param ppInputs Pointer to an array of UTF32 "C" string pointers
+	\param uCount Number of entries in the array
+
+	\return Zero if no error, non-zero on memory error.
+
+***************************************/
+
+Burger::eError BURGER_API Burger::String32::append_many(
+	const uint32_t* const* ppInputs, uintptr_t uCount) BURGER_NOEXCEPT
+{
+	eError uResult = kErrorNone;
+	if (uCount) {
+		// Get the final size
+		uintptr_t uTotalLength = m_uLength;
+		uintptr_t i = 0;
+		do {
+			if (ppInputs[i]) {
+				uTotalLength += string_length(ppInputs[i]);
 			}
-			m_pData = pDest;   // Set the pointer
-			m_uLength = uSize; // Save the new length
-			pDest[uSize] = 0;  // Ensure the terminating zero is present
+		} while (++i < uCount);
+
+		// Grow once for all of the strings
+		uResult = grow(uTotalLength);
+		if (!uResult) {
+			uint32_t* pWork = m_pData + m_uLength;
+			i = 0;
+			do {
+				const uint32_t* pInput = ppInputs[i];
+				if (pInput) {
+					const uintptr_t uLength = string_length(pInput);
+					memory_copy(pWork, pInput, uLength * sizeof(uint32_t));
+					pWork += uLength;
+				}
+			} while (++i < uCount);
+			pWork[0] = 0;
+			m_uLength = uTotalLength;
 		}
 	}
 	return uResult;
@@ -500,27 +841,7 @@ Burger::eError BURGER_API Burger::String32::SetBufferSize(
 Burger::String32& Burger::String32::operator=(const Burger::String32& rInput)
 {
 	if (this != &rInput) { // Am I copying myself?
-		uint32_t* pWork = m_pData;
-		if (pWork != m_Raw) { // Discard previous memory
-			free_memory(pWork);
-			pWork = m_Raw;
-		}
-
-		uintptr_t uInputLength = rInput.m_uLength; // Length of the new string
-		const uint32_t* pInput = rInput.m_pData;   // Copy the new length
-		if (uInputLength >= BUFFERSIZE) {          // Buffer big enough?
-			pWork = static_cast<uint32_t*>(
-				allocate_memory((uInputLength + 1) * sizeof(uint32_t)));
-			if (!pWork) { // Oh oh...
-				pWork = m_Raw;
-				uInputLength = 0;         // Don't copy anything
-				pInput = g_EmptyString32; // Will copy the null character
-			}
-		}
-		m_uLength = uInputLength; // Save the new length
-		m_pData = pWork;          // Set the pointer
-		memory_copy(pWork, pInput,
-			(uInputLength + 1) * sizeof(uint32_t)); // Copy the string
+		assign(rInput.m_pData);
 	}
 	return *this;
 }
@@ -584,8 +905,7 @@ Burger::String32& Burger::String32::operator=(char cInput)
 		free_memory(pWork);
 		pWork = m_Raw;
 	}
-
-	pWork[0] = cInput; // Store the char in the string
+	pWork[0] = static_cast<uint8_t>(cInput); // Store the char in the string
 	pWork[1] = 0;
 	uintptr_t uInputLength = 1;
 	if (!cInput) {        // Valid string?
@@ -593,6 +913,54 @@ Burger::String32& Burger::String32::operator=(char cInput)
 	}
 	m_uLength = uInputLength; // Save the new length
 	m_pData = pWork;          // Set the pointer
+	m_uBufferSize = BUFFERSIZE - 1;
+	return *this;
+}
+
+/*! ************************************
+
+	\brief Append a single character
+
+	\param uInput Character to append
+	\return A reference to the this pointer
+
+***************************************/
+
+Burger::String32& Burger::String32::operator+=(uint32_t uInput) BURGER_NOEXCEPT
+{
+	push_back(uInput);
+	return *this;
+}
+
+/*! ************************************
+
+	\brief Append a UTF32 "C" string
+
+	\param pInput Pointer to a UTF32 "C" string, \ref nullptr does nothing
+	\return A reference to the this pointer
+
+***************************************/
+
+Burger::String32& Burger::String32::operator+=(
+	const uint32_t* pInput) BURGER_NOEXCEPT
+{
+	append(pInput);
+	return *this;
+}
+
+/*! ************************************
+
+	\brief Append a Burger::String32
+
+	\param rInput Reference to the string to append
+	\return A reference to the this pointer
+
+***************************************/
+
+Burger::String32& Burger::String32::operator+=(
+	const String32& rInput) BURGER_NOEXCEPT
+{
+	append(rInput);
 	return *this;
 }
 
@@ -711,6 +1079,7 @@ void Burger::String32::clear(void) BURGER_NOEXCEPT
 	uint32_t* pWork = m_pData; // Old data pointer
 	m_pData = m_Raw;           // New pointer
 	m_uLength = 0;             // No length
+	m_uBufferSize = BUFFERSIZE - 1;
 	m_Raw[0] = 0;              // Kill the string
 	if (pWork != m_Raw) {      // Dispose of the data
 		free_memory(pWork);           // Kill the old memory
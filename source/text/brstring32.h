@@ -38,22 +38,33 @@ class String32 {
 public:
 	/** Ensures the structure is 128 bytes in size on all platforms */
 	static const uintptr_t BUFFERSIZE = static_cast<uintptr_t>(
-		(128 - (sizeof(uint32_t*) + sizeof(uintptr_t))) / sizeof(uint32_t));
+		(128 - (sizeof(uint32_t*) + sizeof(uintptr_t) * 2)) /
+		sizeof(uint32_t));
 
 private:
 	/** Pointer to the string */
 	uint32_t* m_pData;
 	/** Length of the string */
 	uintptr_t m_uLength;
+	/** Size of the buffer in characters, minimum BUFFERSIZE - 1 */
+	uintptr_t m_uBufferSize;
 	/** Temp preallocated buffer for most strings Structure size is 128 bytes */
 	uint32_t m_Raw[BUFFERSIZE];
 
+	eError BURGER_API grow(uintptr_t uNewLength) BURGER_NOEXCEPT;
+
 public:
-	String32(void) BURGER_NOEXCEPT: m_pData(m_Raw), m_uLength(0)
+	String32(void) BURGER_NOEXCEPT: m_pData(m_Raw),
+									m_uLength(0),
+									m_uBufferSize(BUFFERSIZE - 1)
 	{
 		m_Raw[0] = 0;
 	}
 	String32(const String32& rInput);
+#if defined(BURGER_RVALUE_REFERENCES) || defined(DOXYGEN)
+	String32(String32&& rInput) BURGER_NOEXCEPT;
+	String32& operator=(String32&& rInput) BURGER_NOEXCEPT;
+#endif
 	String32(
 		const String32& rInput, uintptr_t uStart, uintptr_t uEnd = UINTPTR_MAX);
 	String32(const char* pInput) BURGER_NOEXCEPT;
@@ -103,6 +114,10 @@ public:
 	{
 		return !m_uLength;
 	}
+	BURGER_INLINE uintptr_t capacity(void) const BURGER_NOEXCEPT
+	{
+		return m_uBufferSize;
+	}
 	BURGER_INLINE uintptr_t GetLength(void) const BURGER_NOEXCEPT
 	{
 		return m_uLength;
@@ -122,11 +137,23 @@ public:
 	{
 		return SetBufferSize(uSize);
 	}
+	eError BURGER_API reserve(uintptr_t uNewBufferSize) BURGER_NOEXCEPT;
+	eError BURGER_API shrink_to_fit(void) BURGER_NOEXCEPT;
+	eError BURGER_API push_back(uint32_t uInput) BURGER_NOEXCEPT;
+	eError BURGER_API append(const uint32_t* pInput) BURGER_NOEXCEPT;
+	eError BURGER_API append(
+		const uint32_t* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT;
+	eError BURGER_API append(const String32& rInput) BURGER_NOEXCEPT;
+	eError BURGER_API append_many(
+		const uint32_t* const* ppInputs, uintptr_t uCount) BURGER_NOEXCEPT;
 
 	String32& operator=(const String32& rInput);
 	String32& operator=(const uint32_t* pInput);
 	String32& operator=(const char* pInput);
 	String32& operator=(char cInput);
+	String32& operator+=(uint32_t uInput) BURGER_NOEXCEPT;
+	String32& operator+=(const uint32_t* pInput) BURGER_NOEXCEPT;
+	String32& operator+=(const String32& rInput) BURGER_NOEXCEPT;
 	BURGER_INLINE String32 operator()(
 		uintptr_t uStart, uintptr_t uEnd) const BURGER_NOEXCEPT
 	{
@@ -0,0 +1,563 @@
+/***************************************
+
+	Interned string atoms
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#include "brstringatom.h"
+#include "brdjb2hash.h"
+#include "brglobalmemorymanager.h"
+#include "brmemoryfunctions.h"
+#include "brmutex.h"
+#include "brstringfunctions.h"
+
+// Starting number of hash buckets in each shard, must be a power of 2
+static const uint32_t kAtomStartingBuckets = 64;
+
+// Strings this size or smaller are case folded on the stack
+static const uintptr_t kAtomFoldBufferSize = 128;
+
+// Hash table for one shard of the atom table
+struct AtomShard_t {
+	// Array of (m_uMask + 1) bucket chains
+	Burger::StringAtom::Record_t** m_ppBuckets;
+	// Number of buckets minus one
+	uint32_t m_uMask;
+	// Number of records in this shard
+	uint32_t m_uCount;
+};
+
+// Hash tables for each shard
+static AtomShard_t g_AtomShards[Burger::StringAtom::kShardCount];
+
+// Locks for each shard
+static Burger::MutexStatic g_AtomLocks[Burger::StringAtom::kShardCount];
+
+/***************************************
+
+	\brief Select the shard for a hash
+
+	Mix the hash with a Fibonacci multiply and use the upper bits, so the
+	shard is independent of the bucket index that uses the lower bits.
+
+***************************************/
+
+static BURGER_INLINE uint32_t GetAtomShard(uint32_t uHash) BURGER_NOEXCEPT
+{
+	return (uHash * 0x9E3779B1U) >> 28U;
+}
+
+/***************************************
+
+	\brief Find a record in a shard
+
+	The shard's lock must be held.
+
+***************************************/
+
+static const Burger::StringAtom::Record_t* FindAtomRecord(
+	const AtomShard_t* pShard, const char* pInput, uintptr_t uLength,
+	uint32_t uHash) BURGER_NOEXCEPT
+{
+	const Burger::StringAtom::Record_t* pRecord = nullptr;
+	if (pShard->m_ppBuckets) {
+		pRecord = pShard->m_ppBuckets[uHash & pShard->m_uMask];
+		while (pRecord) {
+			if ((pRecord->m_uHash == uHash) &&
+				(pRecord->m_uLength == uLength) &&
+				!Burger::MemoryCompare(pRecord->m_Name, pInput, uLength)) {
+				break;
+			}
+			pRecord = pRecord->m_pNext;
+		}
+	}
+	return pRecord;
+}
+
+/***************************************
+
+	\brief Resize a shard's hash table
+
+	The shard's lock must be held. On allocation failure, the table is left
+	alone, the chains just get longer.
+
+***************************************/
+
+static void GrowAtomShard(AtomShard_t* pShard) BURGER_NOEXCEPT
+{
+	const uint32_t uNewCount =
+		pShard->m_ppBuckets ? (pShard->m_uMask + 1) * 2 : kAtomStartingBuckets;
+	Burger::StringAtom::Record_t** ppNew =
+		static_cast<Burger::StringAtom::Record_t**>(
+			Burger::allocate_memory_clear(sizeof(ppNew[0]) * uNewCount));
+	if (ppNew) {
+		const uint32_t uNewMask = uNewCount - 1;
+		Burger::StringAtom::Record_t** ppOld = pShard->m_ppBuckets;
+		if (ppOld) {
+			uint32_t i = 0;
+			do {
+				Burger::StringAtom::Record_t* pRecord = ppOld[i];
+				while (pRecord) {
+					Burger::StringAtom::Record_t* pNext = pRecord->m_pNext;
+					const uint32_t uIndex = pRecord->m_uHash & uNewMask;
+					pRecord->m_pNext = ppNew[uIndex];
+					ppNew[uIndex] = pRecord;
+					pRecord = pNext;
+				}
+			} while (++i <= pShard->m_uMask);
+			Burger::free_memory(ppOld);
+		}
+		pShard->m_ppBuckets = ppNew;
+		pShard->m_uMask = uNewMask;
+	}
+}
+
+/*! ************************************
+
+	\class Burger::StringAtom
+	\brief Interned string with pointer equality
+
+	Names that are looked up over and over, like XML element names or INI
+	keys, are usually stored as separate copies and compared a character at
+	a time. A StringAtom stores every unique string once in a global hash
+	table, so two atoms are equal if and only if they point to the same
+	record. The hash of the string is computed once and stored in the record.
+
+	Every record also points to the record of its lower case twin (Itself if
+	it has no upper case letters), so case insensitive equality is also a
+	pointer compare, see is_case_equal(const StringAtom&) const.
+
+	The table is split into \ref kShardCount shards, each with its own lock,
+	so threads can create and look up atoms at the same time. Once an atom is
+	created, reading its contents needs no locks.
+
+	Atoms are never released, they are meant for names and keywords, not
+	general text.
+
+	\code
+	Burger::StringAtom Width("Width");
+	if (Width == Burger::StringAtom("Width")) {
+		// Always true
+	}
+	if (Width.is_case_equal(Burger::StringAtom("WIDTH"))) {
+		// Also true
+	}
+	\endcode
+
+	\sa FileXML::Root::FindElement(const StringAtom&) const or
+		FileINI::FindSection(const StringAtom&, uint_t)
+
+***************************************/
+
+/*! ************************************
+
+	\struct Burger::StringAtom::Record_t
+	\brief Interned string record
+
+	Records are allocated with enough room for the string and never move, so
+	pointers to them can be compared for equality.
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::StringAtom::StringAtom(const Record_t*)
+	\brief Create an atom from a record
+
+	\param pRecord Pointer to the record or \ref nullptr
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::StringAtom::StringAtom()
+	\brief Create an invalid atom
+
+	\sa is_valid(void) const
+
+***************************************/
+
+/*! ************************************
+
+	\brief Intern a "C" string
+
+	Find the string in the atom table, adding it if it's not present.
+
+	\param pInput Pointer to a "C" string, can be \ref nullptr
+	\sa StringAtom(const char*, uintptr_t) or find(const char*)
+
+***************************************/
+
+Burger::StringAtom::StringAtom(const char* pInput) BURGER_NOEXCEPT
+	: m_pRecord(
+		  pInput ? lookup(pInput, string_length(pInput), TRUE) : nullptr)
+{
+}
+
+/*! ************************************
+
+	\brief Intern a string of a specific length
+
+	Find the string in the atom table, adding it if it's not present. The
+	string doesn't need to be zero terminated.
+
+	\param pInput Pointer to the string, can be \ref nullptr
+	\param uLength Length of the string in bytes
+	\sa StringAtom(const char*) or find(const char*, uintptr_t)
+
+***************************************/
+
+Burger::StringAtom::StringAtom(
+	const char* pInput, uintptr_t uLength) BURGER_NOEXCEPT
+	: m_pRecord(pInput ? lookup(pInput, uLength, TRUE) : nullptr)
+{
+}
+
+/*! ************************************
+
+	\brief Find or create a record in the atom table
+
+	If the record needs to be created and the string has upper case letters,
+	the lower case twin is interned first. No lock is held while that
+	happens, so only one shard is ever locked at a time.
+
+	\param pInput Pointer to the string
+	\param uLength Length of the string in bytes
+	\param bCreate \ref TRUE to add the string if it's not found
+	\return Pointer to the record or \ref nullptr if not found or out of
+		memory
+
+***************************************/
+
+const Burger::StringAtom::Record_t* BURGER_API Burger::StringAtom::lookup(
+	const char* pInput, uintptr_t uLength, uint_t bCreate) BURGER_NOEXCEPT
+{
+	// The length is stored in 32 bits
+	if (uLength >= 0x7FFFFFFFU) {
+		return nullptr;
+	}
+
+	const uint32_t uHash = hash(pInput, uLength);
+	const uint32_t uShard = GetAtomShard(uHash);
+	AtomShard_t* pShard = &g_AtomShards[uShard];
+
+	// Most calls find an existing atom
+	{
+		MutexLock Lock(&g_AtomLocks[uShard]);
+		const Record_t* pRecord =
+			FindAtomRecord(pShard, pInput, uLength, uHash);
+		if (pRecord || !bCreate) {
+			return pRecord;
+		}
+	}
+
+	// Does it have upper case letters?
+	uintptr_t uIndex = 0;
+	while (uIndex < uLength) {
+		const uint_t uLetter = reinterpret_cast<const uint8_t*>(pInput)[uIndex];
+		if ((uLetter - 'A') < 26U) {
+			break;
+		}
+		++uIndex;
+	}
+
+	// Intern the lower case twin first
+	const Record_t* pFolded = nullptr;
+	if (uIndex < uLength) {
+		char FoldBuffer[kAtomFoldBufferSize];
+		char* pFoldBuffer = FoldBuffer;
+		if (uLength > kAtomFoldBufferSize) {
+			pFoldBuffer = static_cast<char*>(allocate_memory(uLength));
+			if (!pFoldBuffer) {
+				return nullptr;
+			}
+		}
+		uIndex = 0;
+		do {
+			uint_t uLetter = reinterpret_cast<const uint8_t*>(pInput)[uIndex];
+			if ((uLetter - 'A') < 26U) {
+				uLetter += 32;
+			}
+			pFoldBuffer[uIndex] = static_cast<char>(uLetter);
+		} while (++uIndex < uLength);
+		pFolded = lookup(pFoldBuffer, uLength, TRUE);
+		if (pFoldBuffer != FoldBuffer) {
+			free_memory(pFoldBuffer);
+		}
+		if (!pFolded) {
+			return nullptr;
+		}
+	}
+
+	MutexLock Lock(&g_AtomLocks[uShard]);
+
+	// Another thread may have added it while unlocked
+	const Record_t* pRecord = FindAtomRecord(pShard, pInput, uLength, uHash);
+	if (!pRecord) {
+		if (pShard->m_uCount >= pShard->m_uMask) {
+			GrowAtomShard(pShard);
+		}
+		if (pShard->m_ppBuckets) {
+			Record_t* pNew = static_cast<Record_t*>(
+				allocate_memory(sizeof(Record_t) + uLength));
+			if (pNew) {
+				pNew->m_pFolded = pFolded ? pFolded : pNew;
+				pNew->m_uHash = uHash;
+				pNew->m_uLength = static_cast<uint32_t>(uLength);
+				memory_copy(pNew->m_Name, pInput, uLength);
+				pNew->m_Name[uLength] = 0;
+
+				Record_t** ppBucket =
+					&pShard->m_ppBuckets[uHash & pShard->m_uMask];
+				pNew->m_pNext = ppBucket[0];
+				ppBucket[0] = pNew;
+				++pShard->m_uCount;
+				pRecord = pNew;
+			}
+		}
+	}
+	return pRecord;
+}
+
+/*! ************************************
+
+	\brief Find an existing atom
+
+	Look up a "C" string without adding it to the table.
+
+	\param pInput Pointer to a "C" string, can be \ref nullptr
+	\return The atom, invalid if the string was never interned
+	\sa find(const char*, uintptr_t) or StringAtom(const char*)
+
+***************************************/
+
+Burger::StringAtom BURGER_API Burger::StringAtom::find(
+	const char* pInput) BURGER_NOEXCEPT
+{
+	return StringAtom(
+		pInput ? lookup(pInput, string_length(pInput), FALSE) : nullptr);
+}
+
+/*! ************************************
+
+	\brief Find an existing atom of a specific length
+
+	Look up a string without adding it to the table.
+
+	\param pInput Pointer to the string, can be \ref nullptr
+	\param uLength Length of the string in bytes
+	\return The atom, invalid if the string was never interned
+	\sa find(const char*) or StringAtom(const char*, uintptr_t)
+
+***************************************/
+
+Burger::StringAtom BURGER_API Burger::StringAtom::find(
+	const char* pInput, uintptr_t uLength) BURGER_NOEXCEPT
+{
+	return StringAtom(pInput ? lookup(pInput, uLength, FALSE) : nullptr);
+}
+
+/*! ************************************
+
+	\brief Hash function used by the atom table
+
+	\param pInput Pointer to the string
+	\param uLength Length of the string in bytes
+	\return 32 bit hash of the string
+	\sa get_hash(void) const
+
+***************************************/
+
+uint32_t BURGER_API Burger::StringAtom::hash(
+	const char* pInput, uintptr_t uLength) BURGER_NOEXCEPT
+{
+	return static_cast<uint32_t>(DJB2_hash_xor(pInput, uLength));
+}
+
+/*! ************************************
+
+	\brief Case insensitive hash function used by the atom table
+
+	Hash a string as if it were in lower case. The atom table is not
+	touched, so containers can store this hash for their names and only
+	compare it to atoms when searching.
+
+	\param pInput Pointer to the string
+	\param uLength Length of the string in bytes
+	\return Same value get_case_hash(void) const returns for the string's atom
+	\sa hash(const char*, uintptr_t)
+
+***************************************/
+
+uint32_t BURGER_API Burger::StringAtom::case_hash(
+	const char* pInput, uintptr_t uLength) BURGER_NOEXCEPT
+{
+	return static_cast<uint32_t>(DJB2_hash_xor_case(pInput, uLength));
+}
+
+/*! ************************************
+
+	\brief Number of atoms in the table
+
+	\return Number of unique strings interned, including the lower case twins
+
+***************************************/
+
+uintptr_t BURGER_API Burger::StringAtom::get_count(void) BURGER_NOEXCEPT
+{
+	uintptr_t uCount = 0;
+	uint32_t i = 0;
+	do {
+		MutexLock Lock(&g_AtomLocks[i]);
+		uCount += g_AtomShards[i].m_uCount;
+	} while (++i < kShardCount);
+	return uCount;
+}
+
+/*! ************************************
+
+	\brief Release every atom
+
+	Free all the memory used by the atom table, for use when the application
+	is shutting down.
+
+	\note Every StringAtom still in use becomes a dangling pointer, so this
+		must only be called when there are none left.
+
+***************************************/
+
+void BURGER_API Burger::StringAtom::release_all(void) BURGER_NOEXCEPT
+{
+	uint32_t i = 0;
+	do {
+		MutexLock Lock(&g_AtomLocks[i]);
+		AtomShard_t* pShard = &g_AtomShards[i];
+		Record_t** ppBuckets = pShard->m_ppBuckets;
+		if (ppBuckets) {
+			uint32_t j = 0;
+			do {
+				Record_t* pRecord = ppBuckets[j];
+				while (pRecord) {
+					Record_t* pNext = pRecord->m_pNext;
+					free_memory(pRecord);
+					pRecord = pNext;
+				}
+			} while (++j <= pShard->m_uMask);
+			free_memory(ppBuckets);
+			pShard->m_ppBuckets = nullptr;
+			pShard->m_uMask = 0;
+			pShard->m_uCount = 0;
+		}
+	} while (++i < kShardCount);
+}
+
+/*! ************************************
+
+	\fn Burger::StringAtom::is_valid(void) const
+	\brief Test if the atom points to a string
+
+	\return \ref TRUE if the atom is valid, \ref FALSE if it was default
+		constructed, not found or memory ran out
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::StringAtom::c_str(void) const
+	\brief Get the string
+
+	\return Pointer to the zero terminated string, an empty string if the atom
+		is invalid
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::StringAtom::length(void) const
+	\brief Get the length of the string
+
+	\return Length in bytes, zero if the atom is invalid
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::StringAtom::get_hash(void) const
+	\brief Get the precomputed hash of the string
+
+	\return Value of hash(const char*, uintptr_t) for the string, zero if the
+		atom is invalid
+	\sa get_case_hash(void) const
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::StringAtom::get_folded(void) const
+	\brief Get the lower case version of this atom
+
+	\return Atom with all upper case ASCII letters converted to lower case
+	\sa is_case_equal(const StringAtom&) const
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::StringAtom::get_case_hash(void) const
+	\brief Get the precomputed hash of the lower case string
+
+	\return Hash that is the same for strings that only differ in case
+	\sa get_hash(void) const or case_hash(const char*, uintptr_t)
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::StringAtom::is_case_equal(const StringAtom&) const
+	\brief Case insensitive equality
+
+	Compare the lower case twins of both atoms, which matches the results of
+	StringCaseCompare(const char*, const char*).
+
+	\param rInput Atom to compare against
+	\return \ref TRUE if the strings are equal ignoring case, \ref FALSE if
+		not or if either atom is invalid
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::StringAtom::clear(void)
+	\brief Make the atom invalid
+
+	\sa is_valid(void) const
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::StringAtom::operator==(const StringAtom&) const
+	\brief Case sensitive equality
+
+	\param rInput Atom to compare against
+	\return \ref TRUE if both atoms are the same string
+
+***************************************/
+
+/*! ************************************
+
+	\fn Burger::StringAtom::operator!=(const StringAtom&) const
+	\brief Case sensitive inequality
+
+	\param rInput Atom to compare against
+	\return \ref TRUE if the atoms are different strings
+
+***************************************/
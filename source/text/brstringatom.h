@@ -0,0 +1,129 @@
+/***************************************
+
+	Interned string atoms
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#ifndef __BRSTRINGATOM_H__
+#define __BRSTRINGATOM_H__
+
+#ifndef __BRTYPES_H__
+#include "brtypes.h"
+#endif
+
+/* BEGIN */
+namespace Burger {
+
+class StringAtom {
+public:
+	/** Number of independently locked sections of the atom table */
+	static const uint32_t kShardCount = 16;
+
+	/** Interned string, never moved or changed once created */
+	struct Record_t {
+		/** Next record in the same hash bucket */
+		Record_t* m_pNext;
+		/** Record of the lower case version of this string */
+		const Record_t* m_pFolded;
+		/** Hash of the string */
+		uint32_t m_uHash;
+		/** Length of the string in bytes */
+		uint32_t m_uLength;
+		/** Zero terminated string, allocated with the record */
+		char m_Name[1];
+	};
+
+protected:
+	/** Pointer to the interned string, \ref nullptr if invalid */
+	const Record_t* m_pRecord;
+
+	BURGER_INLINE explicit StringAtom(const Record_t* pRecord) BURGER_NOEXCEPT
+		: m_pRecord(pRecord)
+	{
+	}
+
+	static const Record_t* BURGER_API lookup(const char* pInput,
+		uintptr_t uLength, uint_t bCreate) BURGER_NOEXCEPT;
+
+public:
+	BURGER_INLINE StringAtom() BURGER_NOEXCEPT: m_pRecord(nullptr) {}
+	explicit StringAtom(const char* pInput) BURGER_NOEXCEPT;
+	StringAtom(const char* pInput, uintptr_t uLength) BURGER_NOEXCEPT;
+
+	static StringAtom BURGER_API find(const char* pInput) BURGER_NOEXCEPT;
+	static StringAtom BURGER_API find(
+		const char* pInput, uintptr_t uLength) BURGER_NOEXCEPT;
+	static uint32_t BURGER_API hash(
+		const char* pInput, uintptr_t uLength) BURGER_NOEXCEPT;
+	static uint32_t BURGER_API case_hash(
+		const char* pInput, uintptr_t uLength) BURGER_NOEXCEPT;
+	static uintptr_t BURGER_API get_count(void) BURGER_NOEXCEPT;
+	static void BURGER_API release_all(void) BURGER_NOEXCEPT;
+
+	BURGER_INLINE uint_t is_valid(void) const BURGER_NOEXCEPT
+	{
+		return m_pRecord != nullptr;
+	}
+
+	BURGER_INLINE const char* c_str(void) const BURGER_NOEXCEPT
+	{
+		return m_pRecord ? m_pRecord->m_Name : "";
+	}
+
+	BURGER_INLINE uintptr_t length(void) const BURGER_NOEXCEPT
+	{
+		return m_pRecord ? m_pRecord->m_uLength : 0;
+	}
+
+	BURGER_INLINE uint32_t get_hash(void) const BURGER_NOEXCEPT
+	{
+		return m_pRecord ? m_pRecord->m_uHash : 0;
+	}
+
+	BURGER_INLINE StringAtom get_folded(void) const BURGER_NOEXCEPT
+	{
+		return StringAtom(m_pRecord ? m_pRecord->m_pFolded : nullptr);
+	}
+
+	BURGER_INLINE uint32_t get_case_hash(void) const BURGER_NOEXCEPT
+	{
+		return m_pRecord ? m_pRecord->m_pFolded->m_uHash : 0;
+	}
+
+	BURGER_INLINE uint_t is_case_equal(
+		const StringAtom& rInput) const BURGER_NOEXCEPT
+	{
+		return (m_pRecord && rInput.m_pRecord) &&
+			(m_pRecord->m_pFolded == rInput.m_pRecord->m_pFolded);
+	}
+
+	BURGER_INLINE void clear(void) BURGER_NOEXCEPT
+	{
+		m_pRecord = nullptr;
+	}
+
+	BURGER_INLINE uint_t operator==(
+		const StringAtom& rInput) const BURGER_NOEXCEPT
+	{
+		return m_pRecord == rInput.m_pRecord;
+	}
+
+	BURGER_INLINE uint_t operator!=(
+		const StringAtom& rInput) const BURGER_NOEXCEPT
+	{
+		return m_pRecord != rInput.m_pRecord;
+	}
+};
+
+}
+/* END */
+
+#endif
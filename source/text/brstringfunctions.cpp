@@ -37,6 +37,338 @@
 #endif
 #endif
 
+//
+// The string scanners read whole aligned blocks, which never cross a page
+// boundary, so reading past the terminating zero can't cause a fault.
+// AddressSanitizer still reports these reads, so sanitized builds scan the
+// strings one character at a time.
+//
+
+#if defined(__SANITIZE_ADDRESS__)
+#define USE_BYTE_SCAN
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define USE_BYTE_SCAN
+#endif
+#endif
+
+// Select the vector unit used for string scanning
+#if defined(BURGER_SSE2) && defined(BURGER_INTEL) && \
+	(defined(BURGER_MSVC) || defined(BURGER_GNUC) || defined(BURGER_CLANG) || \
+		defined(BURGER_INTEL_COMPILER)) && \
+	!defined(USE_BYTE_SCAN) && !defined(DOXYGEN)
+#define USE_SSE2
+#include <emmintrin.h>
+#elif defined(BURGER_NEON) && defined(BURGER_ARM64) && \
+	!defined(USE_BYTE_SCAN) && !defined(DOXYGEN)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(USE_SSE2)
+typedef __m128i Vector128_t;
+
+// One bit per byte in a compare mask
+typedef uint32_t VectorMask_t;
+static const uint_t kMaskShift = 0;
+static const VectorMask_t kMaskLane = 1U;
+
+static BURGER_INLINE Vector128_t VectorLoadAligned(
+	const void* pInput) BURGER_NOEXCEPT
+{
+	return _mm_load_si128(static_cast<const __m128i*>(pInput));
+}
+
+static BURGER_INLINE Vector128_t VectorSplat(uint8_t uInput) BURGER_NOEXCEPT
+{
+	return _mm_set1_epi8(static_cast<char>(uInput));
+}
+
+static BURGER_INLINE Vector128_t VectorZero(void) BURGER_NOEXCEPT
+{
+	return _mm_setzero_si128();
+}
+
+static BURGER_INLINE Vector128_t VectorMin(
+	Vector128_t vInput1, Vector128_t vInput2) BURGER_NOEXCEPT
+{
+	return _mm_min_epu8(vInput1, vInput2);
+}
+
+static BURGER_INLINE Vector128_t VectorCompareEqual(
+	Vector128_t vInput1, Vector128_t vInput2) BURGER_NOEXCEPT
+{
+	return _mm_cmpeq_epi8(vInput1, vInput2);
+}
+
+static BURGER_INLINE Vector128_t VectorCompareEqual16(
+	Vector128_t vInput1, Vector128_t vInput2) BURGER_NOEXCEPT
+{
+	return _mm_cmpeq_epi16(vInput1, vInput2);
+}
+
+static BURGER_INLINE VectorMask_t VectorGetMask(
+	Vector128_t vInput) BURGER_NOEXCEPT
+{
+	return static_cast<uint32_t>(_mm_movemask_epi8(vInput));
+}
+
+// Add 0x20 to 'A' through 'Z'. Bias by 0x3F so 'A'-'Z' are the lowest
+// signed values, since SSE2 has no unsigned byte compare.
+static BURGER_INLINE Vector128_t VectorToLower(
+	Vector128_t vInput) BURGER_NOEXCEPT
+{
+	const Vector128_t vBias = _mm_add_epi8(vInput, _mm_set1_epi8(0x3F));
+	const Vector128_t vUpper =
+		_mm_cmplt_epi8(vBias, _mm_set1_epi8(static_cast<char>(-102)));
+	return _mm_add_epi8(vInput, _mm_and_si128(vUpper, _mm_set1_epi8(0x20)));
+}
+
+static BURGER_INLINE uint_t FirstSetBit(VectorMask_t uInput) BURGER_NOEXCEPT
+{
+#if defined(BURGER_MSVC)
+	unsigned long uResult;
+	_BitScanForward(&uResult, uInput);
+	return static_cast<uint_t>(uResult);
+#else
+	return static_cast<uint_t>(__builtin_ctz(uInput));
+#endif
+}
+
+#elif defined(USE_NEON)
+typedef uint8x16_t Vector128_t;
+
+// Four bits per byte in a compare mask
+typedef uint64_t VectorMask_t;
+static const uint_t kMaskShift = 2;
+static const VectorMask_t kMaskLane = 0xFU;
+
+static BURGER_INLINE Vector128_t VectorLoadAligned(
+	const void* pInput) BURGER_NOEXCEPT
+{
+	return vld1q_u8(static_cast<const uint8_t*>(pInput));
+}
+
+static BURGER_INLINE Vector128_t VectorSplat(uint8_t uInput) BURGER_NOEXCEPT
+{
+	return vdupq_n_u8(uInput);
+}
+
+static BURGER_INLINE Vector128_t VectorZero(void) BURGER_NOEXCEPT
+{
+	return vdupq_n_u8(0);
+}
+
+static BURGER_INLINE Vector128_t VectorMin(
+	Vector128_t vInput1, Vector128_t vInput2) BURGER_NOEXCEPT
+{
+	return vminq_u8(vInput1, vInput2);
+}
+
+static BURGER_INLINE Vector128_t VectorCompareEqual(
+	Vector128_t vInput1, Vector128_t vInput2) BURGER_NOEXCEPT
+{
+	return vceqq_u8(vInput1, vInput2);
+}
+
+static BURGER_INLINE Vector128_t VectorCompareEqual16(
+	Vector128_t vInput1, Vector128_t vInput2) BURGER_NOEXCEPT
+{
+	return vreinterpretq_u8_u16(vceqq_u16(
+		vreinterpretq_u16_u8(vInput1), vreinterpretq_u16_u8(vInput2)));
+}
+
+// Narrow each byte to a nibble, there is no movemask on NEON
+static BURGER_INLINE VectorMask_t VectorGetMask(
+	Vector128_t vInput) BURGER_NOEXCEPT
+{
+	return vget_lane_u64(
+		vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vInput), 4)), 0);
+}
+
+static BURGER_INLINE Vector128_t VectorToLower(
+	Vector128_t vInput) BURGER_NOEXCEPT
+{
+	const Vector128_t vUpper =
+		vcltq_u8(vsubq_u8(vInput, vdupq_n_u8('A')), vdupq_n_u8(26));
+	return vaddq_u8(vInput, vandq_u8(vUpper, vdupq_n_u8(0x20)));
+}
+
+static BURGER_INLINE uint_t FirstSetBit(VectorMask_t uInput) BURGER_NOEXCEPT
+{
+#if defined(BURGER_MSVC)
+	unsigned long uResult;
+	_BitScanForward64(&uResult, uInput);
+	return static_cast<uint_t>(uResult);
+#else
+	return static_cast<uint_t>(__builtin_ctzll(uInput));
+#endif
+}
+#endif
+
+#if defined(USE_SSE2) || defined(USE_NEON)
+
+/***************************************
+
+	Get the compare mask bits that are at or after the start of a string in
+	its first aligned block
+
+***************************************/
+
+static BURGER_INLINE VectorMask_t StartMask(const void* pInput) BURGER_NOEXCEPT
+{
+	return (~static_cast<VectorMask_t>(0))
+		<< ((reinterpret_cast<uintptr_t>(pInput) & 15U) << kMaskShift);
+}
+
+static BURGER_INLINE const uint8_t* AlignBlock(
+	const void* pInput) BURGER_NOEXCEPT
+{
+	return reinterpret_cast<const uint8_t*>(
+		reinterpret_cast<uintptr_t>(pInput) & (~static_cast<uintptr_t>(15U)));
+}
+
+/***************************************
+
+	Remove all candidates at or after the terminating zero, if any
+
+***************************************/
+
+static BURGER_INLINE VectorMask_t MaskBeforeZero(
+	VectorMask_t uCandidates, VectorMask_t uZeros) BURGER_NOEXCEPT
+{
+	if (uZeros) {
+		uCandidates &= (uZeros & (0U - uZeros)) - 1U;
+	}
+	return uCandidates;
+}
+
+/***************************************
+
+	Search for a substring by scanning 16 bytes at a time for positions where
+	the first two characters of the substring match, and then testing each
+	candidate. The second character of the last byte in a block is in the next
+	block, so that position is always a candidate.
+
+	The candidate test is performed by a callback so the same scanner can be
+	used for case sensitive and insensitive searches of "C" or sized strings.
+
+***************************************/
+
+typedef uint_t(BURGER_API* MatchProc)(const uint8_t* pCandidate,
+	const uint8_t* pTest, uintptr_t uTestLength);
+
+static char* BURGER_API SearchString(const uint8_t* pInput,
+	const uint8_t* pTest, uintptr_t uTestLength, uint_t bCase,
+	MatchProc pMatch) BURGER_NOEXCEPT
+{
+	uint_t uFirst = pTest[0];
+	// Single character searches can't test the second character
+	uint_t uSecond = 0;
+	if (uTestLength ? (uTestLength >= 2U) : (pTest[1] != 0)) {
+		uSecond = pTest[1];
+	}
+	if (bCase) {
+		if ((uFirst - 'A') < 26U) {
+			uFirst += 32U;
+		}
+		if ((uSecond - 'A') < 26U) {
+			uSecond += 32U;
+		}
+	}
+	const Vector128_t vFirst = VectorSplat(static_cast<uint8_t>(uFirst));
+	const Vector128_t vSecond = VectorSplat(static_cast<uint8_t>(uSecond));
+	const Vector128_t vZero = VectorZero();
+	const VectorMask_t uLastLane = kMaskLane << (15U << kMaskShift);
+
+	const uint8_t* pWork = AlignBlock(pInput);
+	VectorMask_t uValid = StartMask(pInput);
+	for (;;) {
+		Vector128_t vInput = VectorLoadAligned(pWork);
+		const VectorMask_t uZeros =
+			VectorGetMask(VectorCompareEqual(vInput, vZero)) & uValid;
+		if (bCase) {
+			vInput = VectorToLower(vInput);
+		}
+		VectorMask_t uCandidates =
+			VectorGetMask(VectorCompareEqual(vInput, vFirst)) & uValid;
+		if (uSecond) {
+			uCandidates &=
+				(VectorGetMask(VectorCompareEqual(vInput, vSecond)) >>
+					(1U << kMaskShift)) |
+				uLastLane;
+		}
+		uCandidates = MaskBeforeZero(uCandidates, uZeros);
+
+		// Test every possible match in this block
+		while (uCandidates) {
+			const uint_t uIndex = FirstSetBit(uCandidates) >> kMaskShift;
+			if (pMatch(pWork + uIndex, pTest, uTestLength)) {
+				return reinterpret_cast<char*>(
+					const_cast<uint8_t*>(pWork + uIndex));
+			}
+			uCandidates &= ~(kMaskLane << (uIndex << kMaskShift));
+		}
+		if (uZeros) {
+			break;
+		}
+		pWork += 16;
+		uValid = ~static_cast<VectorMask_t>(0);
+	}
+	return nullptr;
+}
+
+// Test the rest of a "C" string, the first character already matched
+static uint_t BURGER_API MatchString(const uint8_t* pCandidate,
+	const uint8_t* pTest, uintptr_t /* uTestLength */) BURGER_NOEXCEPT
+{
+	uintptr_t i = 1;
+	uint_t uTemp;
+	while ((uTemp = pTest[i]) != 0) {
+		if (uTemp != pCandidate[i]) {
+			return FALSE;
+		}
+		++i;
+	}
+	return TRUE;
+}
+
+static uint_t BURGER_API MatchStringLength(const uint8_t* pCandidate,
+	const uint8_t* pTest, uintptr_t uTestLength) BURGER_NOEXCEPT
+{
+	uintptr_t i = 1;
+	while (i < uTestLength) {
+		if (pTest[i] != pCandidate[i]) {
+			return FALSE;
+		}
+		++i;
+	}
+	return TRUE;
+}
+
+static uint_t BURGER_API MatchCaseString(const uint8_t* pCandidate,
+	const uint8_t* pTest, uintptr_t /* uTestLength */) BURGER_NOEXCEPT
+{
+	uintptr_t i = 1;
+	uint_t uTemp2;
+	while ((uTemp2 = pTest[i]) != 0) {
+		uint_t uTemp = pCandidate[i];
+		if ((uTemp - 'A') < 26U) { // Convert to lower case
+			uTemp += 32U;
+		}
+		if ((uTemp2 - 'A') < 26U) {
+			uTemp2 += 32U;
+		}
+		if (uTemp != uTemp2) {
+			return FALSE;
+		}
+		++i;
+	}
+	return TRUE;
+}
+
+#endif
+
 /*! ************************************
 
 	\enum Burger::eNumericConversionFlags
@@ -766,6 +1098,39 @@ BURGER_ALIGN(const uint8_t, Burger::g_reverse_bits[256], 16) = {
 	0x3F, 0xBF, 0x7F, 0xFF // 0xF0
 };
 
+/*! ************************************
+
+	\brief Table of two digit ASCII pairs for integer to ASCII conversion.
+
+	The 100 pairs "00" through "99" stored back to back. Index the table with
+	twice a value from 0 to 99 to fetch both digits of that value, allowing
+	integer printing to divide by 100 instead of 10 for each step.
+
+***************************************/
+
+BURGER_ALIGN(const char, Burger::g_DigitPairs[200], 16) = {
+	'0', '0', '0', '1', '0', '2', '0', '3', '0', '4', // 00
+	'0', '5', '0', '6', '0', '7', '0', '8', '0', '9',
+	'1', '0', '1', '1', '1', '2', '1', '3', '1', '4', // 10
+	'1', '5', '1', '6', '1', '7', '1', '8', '1', '9',
+	'2', '0', '2', '1', '2', '2', '2', '3', '2', '4', // 20
+	'2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
+	'3', '0', '3', '1', '3', '2', '3', '3', '3', '4', // 30
+	'3', '5', '3', '6', '3', '7', '3', '8', '3', '9',
+	'4', '0', '4', '1', '4', '2', '4', '3', '4', '4', // 40
+	'4', '5', '4', '6', '4', '7', '4', '8', '4', '9',
+	'5', '0', '5', '1', '5', '2', '5', '3', '5', '4', // 50
+	'5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
+	'6', '0', '6', '1', '6', '2', '6', '3', '6', '4', // 60
+	'6', '5', '6', '6', '6', '7', '6', '8', '6', '9',
+	'7', '0', '7', '1', '7', '2', '7', '3', '7', '4', // 70
+	'7', '5', '7', '6', '7', '7', '7', '8', '7', '9',
+	'8', '0', '8', '1', '8', '2', '8', '3', '8', '4', // 80
+	'8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+	'9', '0', '9', '1', '9', '2', '9', '3', '9', '4', // 90
+	'9', '5', '9', '6', '9', '7', '9', '8', '9', '9'
+};
+
 /*! ************************************
 
 	\brief Table used for testing powers of ten for 32 bit integer to ASCII
@@ -2559,6 +2924,11 @@ void BURGER_API Burger::SetFileExtension(
 	Determine the length of a "C" string in memory. A "C" string is a random
 	string of bytes that terminates with a zero.
 
+	On CPUs with SSE2 or NEON, the string is scanned with aligned 16 byte
+	loads, and 64 bytes at a time once the pointer is 64 byte aligned. Aligned
+	loads never cross a page boundary, so reading past the end of the string
+	is safe.
+
 	This function works by first forcing 32-bit alignment and then grabbing four
 	bytes at a time, and uses a pseudo vector operation to test all four of them
 	at once.
@@ -2670,6 +3040,75 @@ DoAlign:			// Pre-align
 }
 // clang-format on
 
+#elif defined(USE_SSE2) || defined(USE_NEON)
+
+uintptr_t BURGER_API Burger::string_length(const char* pInput) BURGER_NOEXCEPT
+{
+	if (!pInput) {
+		return 0;
+	}
+	// Scan aligned blocks, ignoring the bytes before the string
+	const uint8_t* pWork = AlignBlock(pInput);
+	const Vector128_t vZero = VectorZero();
+	VectorMask_t uMask =
+		VectorGetMask(VectorCompareEqual(VectorLoadAligned(pWork), vZero)) &
+		StartMask(pInput);
+	if (!uMask) {
+		// Test single blocks until 64 byte aligned
+		for (;;) {
+			pWork += 16;
+			if (!(reinterpret_cast<uintptr_t>(pWork) & 63U)) {
+				break;
+			}
+			uMask = VectorGetMask(
+				VectorCompareEqual(VectorLoadAligned(pWork), vZero));
+			if (uMask) {
+				break;
+			}
+		}
+		if (!uMask) {
+			// Test 64 bytes at a time, a zero in any block is also the
+			// smallest value in the block
+			for (;;) {
+				const Vector128_t vMin =
+					VectorMin(VectorMin(VectorLoadAligned(pWork),
+								  VectorLoadAligned(pWork + 16)),
+						VectorMin(VectorLoadAligned(pWork + 32),
+							VectorLoadAligned(pWork + 48)));
+				if (VectorGetMask(VectorCompareEqual(vMin, vZero))) {
+					break;
+				}
+				pWork += 64;
+			}
+			// Find the block with the zero
+			while (!(uMask = VectorGetMask(VectorCompareEqual(
+						 VectorLoadAligned(pWork), vZero)))) {
+				pWork += 16;
+			}
+		}
+	}
+	return static_cast<uintptr_t>(
+		(pWork + (FirstSetBit(uMask) >> kMaskShift)) -
+		reinterpret_cast<const uint8_t*>(pInput));
+}
+
+#elif defined(USE_BYTE_SCAN)
+
+//
+// Sanitized builds can't read past the terminating zero
+//
+
+uintptr_t BURGER_API Burger::string_length(const char* pInput) BURGER_NOEXCEPT
+{
+	uintptr_t uResult = 0;
+	if (pInput) {
+		while (pInput[uResult]) {
+			++uResult;
+		}
+	}
+	return uResult;
+}
+
 #else
 
 //
@@ -2780,6 +3219,32 @@ Skip1:;
 uintptr_t BURGER_API Burger::string_length(
 	const uint16_t* pInput) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	if (!pInput) {
+		return 0;
+	}
+	// Odd addresses can't use the aligned scanner
+	if (reinterpret_cast<uintptr_t>(pInput) & 1U) {
+		uintptr_t uResult = 0;
+		while (pInput[uResult]) {
+			++uResult;
+		}
+		return uResult;
+	}
+	const uint8_t* pWork = AlignBlock(pInput);
+	const Vector128_t vZero = VectorZero();
+	VectorMask_t uMask =
+		VectorGetMask(VectorCompareEqual16(VectorLoadAligned(pWork), vZero)) &
+		StartMask(pInput);
+	while (!uMask) {
+		pWork += 16;
+		uMask = VectorGetMask(
+			VectorCompareEqual16(VectorLoadAligned(pWork), vZero));
+	}
+	return static_cast<uintptr_t>((pWork + (FirstSetBit(uMask) >> kMaskShift)) -
+			   reinterpret_cast<const uint8_t*>(pInput)) >>
+		1U;
+#else
 	uintptr_t uResult = 0; // Nothing found yet.
 	if (pInput) {
 		uint_t uTemp = pInput[0];
@@ -2793,6 +3258,7 @@ uintptr_t BURGER_API Burger::string_length(
 		}
 	}
 	return uResult; // Exit with the count
+#endif
 }
 
 /*! ************************************
@@ -3891,6 +4357,32 @@ void BURGER_API Burger::StringLowercase(
 char* BURGER_API Burger::StringCharacter(
 	const char* pInput, int iChar) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	// Zero and values that aren't bytes never match
+	const uint_t uChar = static_cast<uint_t>(iChar);
+	if (!pInput || !uChar || (uChar > 255U)) {
+		return nullptr;
+	}
+	// Find the first match or the terminating zero
+	const uint8_t* pWork = AlignBlock(pInput);
+	const Vector128_t vZero = VectorZero();
+	const Vector128_t vChar = VectorSplat(static_cast<uint8_t>(uChar));
+	Vector128_t vInput = VectorLoadAligned(pWork);
+	VectorMask_t uMask = (VectorGetMask(VectorCompareEqual(vInput, vZero)) |
+							 VectorGetMask(VectorCompareEqual(vInput, vChar))) &
+		StartMask(pInput);
+	while (!uMask) {
+		pWork += 16;
+		vInput = VectorLoadAligned(pWork);
+		uMask = VectorGetMask(VectorCompareEqual(vInput, vZero)) |
+			VectorGetMask(VectorCompareEqual(vInput, vChar));
+	}
+	pWork += FirstSetBit(uMask) >> kMaskShift;
+	if (pWork[0]) {
+		return reinterpret_cast<char*>(const_cast<uint8_t*>(pWork));
+	}
+	return nullptr;
+#else
 	// Valid pointer?
 	if (pInput) {
 		// Get the first character
@@ -3913,6 +4405,7 @@ char* BURGER_API Burger::StringCharacter(
 	}
 	// Not found
 	return nullptr;
+#endif
 }
 
 /*! ************************************
@@ -4422,6 +4915,17 @@ uintptr_t BURGER_API Burger::StringStopAt(
 char* BURGER_API Burger::StringString(
 	const char* pInput, const char* pTest) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	// An empty string matches nothing, an empty test matches everything
+	if (!pInput[0]) {
+		return nullptr;
+	}
+	if (!pTest[0]) {
+		return const_cast<char*>(pInput);
+	}
+	return SearchString(reinterpret_cast<const uint8_t*>(pInput),
+		reinterpret_cast<const uint8_t*>(pTest), 0, FALSE, MatchString);
+#else
 	// Get the first character
 	uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
 
@@ -4459,6 +4963,7 @@ char* BURGER_API Burger::StringString(
 
 	// No string match
 	return nullptr;
+#endif
 }
 
 /*! ************************************
@@ -4485,6 +4990,17 @@ char* BURGER_API Burger::StringString(
 char* BURGER_API Burger::StringString(const char* pInput, const char* pTest,
 	uintptr_t uTestLength) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	if (!pInput[0]) {
+		return nullptr;
+	}
+	if (!uTestLength) {
+		return const_cast<char*>(pInput);
+	}
+	return SearchString(reinterpret_cast<const uint8_t*>(pInput),
+		reinterpret_cast<const uint8_t*>(pTest), uTestLength, FALSE,
+		MatchStringLength);
+#else
 	// Get the first character
 	uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
 
@@ -4521,6 +5037,7 @@ char* BURGER_API Burger::StringString(const char* pInput, const char* pTest,
 
 	// No string match
 	return nullptr;
+#endif
 }
 
 /*! ************************************
@@ -4595,6 +5112,16 @@ uint16_t* BURGER_API Burger::StringString(
 char* BURGER_API Burger::StringCaseString(
 	const char* pInput, const char* pTest) BURGER_NOEXCEPT
 {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	if (!pInput[0]) {
+		return nullptr;
+	}
+	if (!pTest[0]) {
+		return const_cast<char*>(pInput);
+	}
+	return SearchString(reinterpret_cast<const uint8_t*>(pInput),
+		reinterpret_cast<const uint8_t*>(pTest), 0, TRUE, MatchCaseString);
+#else
 	// Get the first character
 	uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
 	if (uTemp) { // Do I even bother?
@@ -4625,6 +5152,7 @@ char* BURGER_API Burger::StringCaseString(
 	}
 	// No string match
 	return nullptr;
+#endif
 }
 
 /*! ************************************
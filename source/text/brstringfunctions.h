@@ -124,6 +124,7 @@ BURGER_ALIGN(extern const char, g_NibbleToAsciiUppercase[16], 16);
 BURGER_ALIGN(extern const char, g_NibbleToAsciiLowercase[16], 16);
 BURGER_ALIGN(extern const uint8_t, g_AsciiToWord8Table[256], 16);
 BURGER_ALIGN(extern const uint8_t, g_reverse_bits[256], 16);
+BURGER_ALIGN(extern const char, g_DigitPairs[200], 16);
 
 extern const uint32_t g_TensTable32[10];
 extern const uint64_t g_TensTable64[20];
@@ -14,6 +14,110 @@
 
 #include "brutf16.h"
 
+// AddressSanitizer reports the reads past the terminating zero
+#if defined(__SANITIZE_ADDRESS__)
+#define USE_BYTE_SCAN
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define USE_BYTE_SCAN
+#endif
+#endif
+
+// Select the vector unit used for bulk conversion
+#if defined(BURGER_SSE2) && defined(BURGER_INTEL) && \
+	(defined(BURGER_MSVC) || defined(BURGER_GNUC) || defined(BURGER_CLANG) || \
+		defined(BURGER_INTEL_COMPILER)) && \
+	!defined(DOXYGEN)
+#define USE_SSE2
+#include <emmintrin.h>
+#elif defined(BURGER_NEON) && defined(BURGER_ARM64) && !defined(DOXYGEN)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(USE_SSE2) || defined(USE_NEON)
+
+/***************************************
+
+	Number of bytes that can be read before the end of the memory page, so
+	"C" strings can be read in blocks without faulting past the terminator.
+
+***************************************/
+
+static BURGER_INLINE uintptr_t BytesInPage(const char* pInput) BURGER_NOEXCEPT
+{
+#if defined(USE_BYTE_SCAN)
+	// Sanitized builds convert "C" strings one character at a time
+	BURGER_UNUSED(pInput);
+	return 0;
+#else
+	return 0x1000U - (reinterpret_cast<uintptr_t>(pInput) & 0xFFFU);
+#endif
+}
+
+/***************************************
+
+	Convert 16 UTF8 bytes at a time to UTF16 as long as all of them are
+	ASCII. Stop at the first block that isn't, or if the output buffer is
+	partially full. Zeros stop the conversion if bStopAtZero is set.
+
+	Returns the number of bytes converted, which is also the number of values
+	output.
+
+***************************************/
+
+static uintptr_t BURGER_API ASCIIToUTF16(uint16_t* pOutput,
+	const uint16_t* pEnd, const char* pInput, uintptr_t uInputSize,
+	uint_t bStopAtZero) BURGER_NOEXCEPT
+{
+	uintptr_t uResult = 0;
+	while (uInputSize >= 16U) {
+#if defined(USE_SSE2)
+		const __m128i vInput =
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput));
+		const __m128i vZero = _mm_setzero_si128();
+		// Any bytes 0x80 or higher?
+		if (_mm_movemask_epi8(vInput)) {
+			break;
+		}
+		if (bStopAtZero && _mm_movemask_epi8(_mm_cmpeq_epi8(vInput, vZero))) {
+			break;
+		}
+#else
+		const uint8x16_t vInput =
+			vld1q_u8(reinterpret_cast<const uint8_t*>(pInput));
+		if (vmaxvq_u8(vInput) >= 0x80U) {
+			break;
+		}
+		if (bStopAtZero && !vminvq_u8(vInput)) {
+			break;
+		}
+#endif
+		// Only store if there's room, but keep counting if the buffer is full
+		if (pOutput < pEnd) {
+			if (static_cast<uintptr_t>(pEnd - pOutput) < 16U) {
+				break;
+			}
+#if defined(USE_SSE2)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput),
+				_mm_unpacklo_epi8(vInput, vZero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput + 8),
+				_mm_unpackhi_epi8(vInput, vZero));
+#else
+			vst1q_u16(pOutput, vmovl_u8(vget_low_u8(vInput)));
+			vst1q_u16(pOutput + 8, vmovl_high_u8(vInput));
+#endif
+		}
+		pOutput += 16;
+		pInput += 16;
+		uInputSize -= 16U;
+		uResult += 16U;
+	}
+	return uResult;
+}
+
+#endif
+
 /*! ************************************
 
 	\class Burger::UTF16
@@ -333,6 +437,13 @@ uintptr_t BURGER_API Burger::UTF16::translate_from_UTF8(uint16_t* pOutput,
 				}
 				// Increment the output
 				++pWorkPtr;
+#if defined(USE_SSE2) || defined(USE_NEON)
+				// Convert runs of ASCII in bulk
+				const uintptr_t uCount = ASCIIToUTF16(
+					pWorkPtr, pEndPtr, pInput, BytesInPage(pInput), TRUE);
+				pWorkPtr += uCount;
+				pInput += uCount;
+#endif
 
 				// UTF8 prefix codes start at 0xC0, 0x80-0xBF are invalid
 
@@ -505,6 +616,14 @@ uintptr_t BURGER_API Burger::UTF16::translate_from_UTF8(uint16_t* pOutput,
 				}
 				// Increment the output
 				++pWorkPtr;
+#if defined(USE_SSE2) || defined(USE_NEON)
+				// Convert runs of ASCII in bulk
+				const uintptr_t uCount = ASCIIToUTF16(
+					pWorkPtr, pEndPtr, pInput, uInputSize - 1, FALSE);
+				pWorkPtr += uCount;
+				pInput += uCount;
+				uInputSize -= uCount;
+#endif
 
 				// UTF8 prefix codes start at 0xC0, 0x80-0xBF are invalid
 
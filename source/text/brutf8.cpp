@@ -16,9 +16,437 @@
 #include "brglobalmemorymanager.h"
 #include "brisolatin1.h"
 #include "brmacromanus.h"
+#include "brmemoryfunctions.h"
+#include "brstringfunctions.h"
 #include "brwin1252.h"
 #include "brwin437.h"
 
+// AddressSanitizer reports the reads past the terminating zero
+#if defined(__SANITIZE_ADDRESS__)
+#define USE_BYTE_SCAN
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define USE_BYTE_SCAN
+#endif
+#endif
+
+// Select the vector unit used for bulk conversion and validation
+#if defined(BURGER_SSE2) && defined(BURGER_INTEL) && \
+	(defined(BURGER_MSVC) || defined(BURGER_GNUC) || defined(BURGER_CLANG) || \
+		defined(BURGER_INTEL_COMPILER)) && \
+	!defined(DOXYGEN)
+#define USE_SSE2
+#include <emmintrin.h>
+
+// SSSE3 is tested for at runtime
+#if (defined(BURGER_GNUC) && (BURGER_GNUC >= 40900)) || \
+	defined(BURGER_CLANG) || (BURGER_MSVC >= 190000000)
+#define USE_SSSE3
+#include "bratomic.h"
+#include <tmmintrin.h>
+#if defined(BURGER_MSVC)
+#define SSSE3_FUNCTION
+#else
+#define SSSE3_FUNCTION __attribute__((target("ssse3")))
+#endif
+#endif
+
+#elif defined(BURGER_NEON) && defined(BURGER_ARM64) && !defined(DOXYGEN)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(USE_SSE2) || defined(USE_NEON)
+
+/***************************************
+
+	Number of elements that can be read before the end of the memory page, so
+	"C" strings can be read in blocks without faulting past the terminator.
+
+***************************************/
+
+static BURGER_INLINE uintptr_t ElementsInPage(
+	const void* pInput, uintptr_t uElementSize) BURGER_NOEXCEPT
+{
+#if defined(USE_BYTE_SCAN)
+	// Sanitized builds convert "C" strings one character at a time
+	BURGER_UNUSED(pInput);
+	BURGER_UNUSED(uElementSize);
+	return 0;
+#else
+	return (0x1000U - (reinterpret_cast<uintptr_t>(pInput) & 0xFFFU)) /
+		uElementSize;
+#endif
+}
+
+/***************************************
+
+	Convert 16 UTF16 values at a time to UTF8 as long as all of them are
+	ASCII. Stop at the first block that isn't, or if the output buffer is
+	partially full. Zeros stop the conversion if bStopAtZero is set.
+
+	Returns the number of values converted, which is also the number of bytes
+	output.
+
+***************************************/
+
+static uintptr_t BURGER_API ASCIIFromUTF16(uint8_t* pOutput,
+	const uint8_t* pEnd, const uint16_t* pInput, uintptr_t uInputSize,
+	uint_t bStopAtZero) BURGER_NOEXCEPT
+{
+	uintptr_t uResult = 0;
+	while (uInputSize >= 16U) {
+#if defined(USE_SSE2)
+		const __m128i vInput1 =
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput));
+		const __m128i vInput2 =
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput + 8));
+		const __m128i vZero = _mm_setzero_si128();
+		// Any values 0x80 or higher?
+		const __m128i vHigh = _mm_and_si128(
+			_mm_or_si128(vInput1, vInput2), _mm_set1_epi16(-0x80));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(vHigh, vZero)) != 0xFFFF) {
+			break;
+		}
+		if (bStopAtZero &&
+			_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi16(vInput1, vZero),
+				_mm_cmpeq_epi16(vInput2, vZero)))) {
+			break;
+		}
+		const __m128i vOutput = _mm_packus_epi16(vInput1, vInput2);
+#else
+		const uint16x8_t vInput1 = vld1q_u16(pInput);
+		const uint16x8_t vInput2 = vld1q_u16(pInput + 8);
+		if (vmaxvq_u16(vorrq_u16(vInput1, vInput2)) >= 0x80U) {
+			break;
+		}
+		if (bStopAtZero && !vminvq_u16(vminq_u16(vInput1, vInput2))) {
+			break;
+		}
+		const uint8x16_t vOutput =
+			vcombine_u8(vmovn_u16(vInput1), vmovn_u16(vInput2));
+#endif
+		// Only store if there's room, but keep counting if the buffer is full
+		if (pOutput < pEnd) {
+			if (static_cast<uintptr_t>(pEnd - pOutput) < 16U) {
+				break;
+			}
+#if defined(USE_SSE2)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput), vOutput);
+#else
+			vst1q_u8(pOutput, vOutput);
+#endif
+		}
+		pOutput += 16;
+		pInput += 16;
+		uInputSize -= 16U;
+		uResult += 16U;
+	}
+	return uResult;
+}
+
+/***************************************
+
+	Convert 16 UTF32 values at a time to UTF8 as long as all of them are
+	ASCII. Same rules as ASCIIFromUTF16().
+
+***************************************/
+
+static uintptr_t BURGER_API ASCIIFromUTF32(uint8_t* pOutput,
+	const uint8_t* pEnd, const uint32_t* pInput, uintptr_t uInputSize,
+	uint_t bStopAtZero) BURGER_NOEXCEPT
+{
+	uintptr_t uResult = 0;
+	while (uInputSize >= 16U) {
+#if defined(USE_SSE2)
+		const __m128i vInput1 =
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput));
+		const __m128i vInput2 =
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput + 4));
+		const __m128i vInput3 =
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput + 8));
+		const __m128i vInput4 =
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput + 12));
+		const __m128i vZero = _mm_setzero_si128();
+		const __m128i vHigh =
+			_mm_and_si128(_mm_or_si128(_mm_or_si128(vInput1, vInput2),
+							  _mm_or_si128(vInput3, vInput4)),
+				_mm_set1_epi32(-0x80));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(vHigh, vZero)) != 0xFFFF) {
+			break;
+		}
+		if (bStopAtZero &&
+			_mm_movemask_epi8(
+				_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(vInput1, vZero),
+								 _mm_cmpeq_epi32(vInput2, vZero)),
+					_mm_or_si128(_mm_cmpeq_epi32(vInput3, vZero),
+						_mm_cmpeq_epi32(vInput4, vZero))))) {
+			break;
+		}
+		// Values are 0-127, so signed saturation is harmless
+		const __m128i vOutput =
+			_mm_packus_epi16(_mm_packs_epi32(vInput1, vInput2),
+				_mm_packs_epi32(vInput3, vInput4));
+#else
+		const uint32x4_t vInput1 = vld1q_u32(pInput);
+		const uint32x4_t vInput2 = vld1q_u32(pInput + 4);
+		const uint32x4_t vInput3 = vld1q_u32(pInput + 8);
+		const uint32x4_t vInput4 = vld1q_u32(pInput + 12);
+		if (vmaxvq_u32(vorrq_u32(vorrq_u32(vInput1, vInput2),
+				vorrq_u32(vInput3, vInput4))) >= 0x80U) {
+			break;
+		}
+		if (bStopAtZero &&
+			!vminvq_u32(vminq_u32(
+				vminq_u32(vInput1, vInput2), vminq_u32(vInput3, vInput4)))) {
+			break;
+		}
+		const uint8x16_t vOutput = vcombine_u8(
+			vmovn_u16(vcombine_u16(vmovn_u32(vInput1), vmovn_u32(vInput2))),
+			vmovn_u16(vcombine_u16(vmovn_u32(vInput3), vmovn_u32(vInput4))));
+#endif
+		if (pOutput < pEnd) {
+			if (static_cast<uintptr_t>(pEnd - pOutput) < 16U) {
+				break;
+			}
+#if defined(USE_SSE2)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput), vOutput);
+#else
+			vst1q_u8(pOutput, vOutput);
+#endif
+		}
+		pOutput += 16;
+		pInput += 16;
+		uInputSize -= 16U;
+		uResult += 16U;
+	}
+	return uResult;
+}
+
+#endif
+
+#if defined(USE_SSSE3) || defined(USE_NEON)
+
+/***************************************
+
+	Validate UTF8 16 bytes at a time with the lookup algorithm from
+	"Validating UTF-8 In Less Than One Instruction Per Byte" by John Keiser
+	and Daniel Lemire.
+
+	Every error in a UTF8 stream can be found by looking at the high and low
+	nibble of a byte and the high nibble of the byte that follows it. Three
+	16 entry tables map each nibble to a set of error bits, and if any error
+	bit survives the AND of all three, the pair is invalid. The only pairs
+	that are valid by this test and can still be invalid are two continuation
+	bytes in a row, so those are checked against whether a 3 or 4 byte prefix
+	came 2 or 3 bytes before.
+
+***************************************/
+
+// Bits for the error classes
+#define TOO_SHORT 0x01U
+#define TOO_LONG 0x02U
+#define OVERLONG_3 0x04U
+#define TOO_LARGE 0x08U
+#define SURROGATE 0x10U
+#define OVERLONG_2 0x20U
+#define TOO_LARGE_1000 0x40U
+#define OVERLONG_4 0x40U
+#define TWO_CONTS 0x80U
+#define CARRY (TOO_SHORT | TOO_LONG | TWO_CONTS)
+
+// High nibble of the first byte
+static const uint8_t g_Byte1High[16] = {TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+	TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+	TWO_CONTS, TOO_SHORT | OVERLONG_2, TOO_SHORT,
+	TOO_SHORT | OVERLONG_3 | SURROGATE,
+	TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4};
+
+// Low nibble of the first byte
+static const uint8_t g_Byte1Low[16] = {
+	CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4, CARRY | OVERLONG_2, CARRY,
+	CARRY, CARRY | TOO_LARGE, CARRY | TOO_LARGE | TOO_LARGE_1000,
+	CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+	CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+	CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+	CARRY | TOO_LARGE | TOO_LARGE_1000,
+	CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+	CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000};
+
+// High nibble of the second byte
+static const uint8_t g_Byte2High[16] = {TOO_SHORT, TOO_SHORT, TOO_SHORT,
+	TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+	TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 |
+		OVERLONG_4,
+	TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+	TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+	TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE, TOO_SHORT,
+	TOO_SHORT, TOO_SHORT, TOO_SHORT};
+
+// A sequence that starts in the last 3 bytes of a block isn't finished
+static const uint8_t g_MaxFinalValue[16] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0U - 1U, 0xE0U - 1U,
+	0xC0U - 1U};
+
+#undef TOO_SHORT
+#undef TOO_LONG
+#undef OVERLONG_3
+#undef TOO_LARGE
+#undef SURROGATE
+#undef OVERLONG_2
+#undef TOO_LARGE_1000
+#undef OVERLONG_4
+#undef TWO_CONTS
+#undef CARRY
+
+#if defined(USE_SSSE3)
+
+static SSSE3_FUNCTION uint_t BURGER_API ValidateUTF8(
+	const uint8_t* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT
+{
+	const __m128i vByte1High =
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(g_Byte1High));
+	const __m128i vByte1Low =
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(g_Byte1Low));
+	const __m128i vByte2High =
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(g_Byte2High));
+	const __m128i vMaxFinal =
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(g_MaxFinalValue));
+	const __m128i vNibble = _mm_set1_epi8(0x0F);
+	const __m128i vZero = _mm_setzero_si128();
+
+	__m128i vPrevious = vZero;
+	__m128i vIncomplete = vZero;
+	__m128i vError = vZero;
+	uint8_t Buffer[16];
+
+	while (uInputSize) {
+		__m128i vInput;
+		if (uInputSize >= 16U) {
+			vInput = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pInput));
+			pInput += 16;
+			uInputSize -= 16U;
+		} else {
+			// Pad the end with zeros, which are ASCII
+			Burger::memory_clear(Buffer, sizeof(Buffer));
+			Burger::memory_copy(Buffer, pInput, uInputSize);
+			vInput = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer));
+			uInputSize = 0;
+		}
+
+		// Pure ASCII only fails if the previous block was unfinished
+		if (!_mm_movemask_epi8(vInput)) {
+			vError = _mm_or_si128(vError, vIncomplete);
+			vIncomplete = vZero;
+		} else {
+			const __m128i vPrev1 = _mm_alignr_epi8(vInput, vPrevious, 15);
+			const __m128i vSpecial = _mm_and_si128(
+				_mm_and_si128(_mm_shuffle_epi8(vByte1High,
+								  _mm_and_si128(
+									  _mm_srli_epi16(vPrev1, 4), vNibble)),
+					_mm_shuffle_epi8(
+						vByte1Low, _mm_and_si128(vPrev1, vNibble))),
+				_mm_shuffle_epi8(vByte2High,
+					_mm_and_si128(_mm_srli_epi16(vInput, 4), vNibble)));
+
+			// Continuation bytes 2 or 3 after a 3 or 4 byte prefix
+			const __m128i vThird = _mm_subs_epu8(
+				_mm_alignr_epi8(vInput, vPrevious, 14), _mm_set1_epi8(0x60));
+			const __m128i vFourth = _mm_subs_epu8(
+				_mm_alignr_epi8(vInput, vPrevious, 13), _mm_set1_epi8(0x70));
+			const __m128i vMust23 =
+				_mm_and_si128(_mm_or_si128(vThird, vFourth),
+					_mm_set1_epi8(static_cast<char>(0x80)));
+			vError = _mm_or_si128(vError, _mm_xor_si128(vMust23, vSpecial));
+			vIncomplete = _mm_subs_epu8(vInput, vMaxFinal);
+		}
+		vPrevious = vInput;
+	}
+	vError = _mm_or_si128(vError, vIncomplete);
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(vError, vZero)) == 0xFFFF;
+}
+
+/***************************************
+
+	Test once if the CPU supports SSSE3.
+
+***************************************/
+
+static uint_t g_uSSSE3State;
+
+static uint_t BURGER_API HasSSSE3(void) BURGER_NOEXCEPT
+{
+	uint_t uState = g_uSSSE3State;
+	if (!uState) {
+		Burger::CPUID_t CPUInfo;
+		Burger::CPUID(&CPUInfo);
+		uState = CPUInfo.has_SSSE3() ? 2U : 1U;
+		g_uSSSE3State = uState;
+	}
+	return uState == 2U;
+}
+
+#else
+
+static uint_t BURGER_API ValidateUTF8(
+	const uint8_t* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT
+{
+	const uint8x16_t vByte1High = vld1q_u8(g_Byte1High);
+	const uint8x16_t vByte1Low = vld1q_u8(g_Byte1Low);
+	const uint8x16_t vByte2High = vld1q_u8(g_Byte2High);
+	const uint8x16_t vMaxFinal = vld1q_u8(g_MaxFinalValue);
+	const uint8x16_t vNibble = vdupq_n_u8(0x0F);
+	const uint8x16_t vZero = vdupq_n_u8(0);
+
+	uint8x16_t vPrevious = vZero;
+	uint8x16_t vIncomplete = vZero;
+	uint8x16_t vError = vZero;
+	uint8_t Buffer[16];
+
+	while (uInputSize) {
+		uint8x16_t vInput;
+		if (uInputSize >= 16U) {
+			vInput = vld1q_u8(pInput);
+			pInput += 16;
+			uInputSize -= 16U;
+		} else {
+			// Pad the end with zeros, which are ASCII
+			Burger::memory_clear(Buffer, sizeof(Buffer));
+			Burger::memory_copy(Buffer, pInput, uInputSize);
+			vInput = vld1q_u8(Buffer);
+			uInputSize = 0;
+		}
+
+		// Pure ASCII only fails if the previous block was unfinished
+		if (vmaxvq_u8(vInput) < 0x80U) {
+			vError = vorrq_u8(vError, vIncomplete);
+			vIncomplete = vZero;
+		} else {
+			const uint8x16_t vPrev1 = vextq_u8(vPrevious, vInput, 15);
+			const uint8x16_t vSpecial =
+				vandq_u8(vandq_u8(vqtbl1q_u8(vByte1High, vshrq_n_u8(vPrev1, 4)),
+							 vqtbl1q_u8(vByte1Low, vandq_u8(vPrev1, vNibble))),
+					vqtbl1q_u8(vByte2High, vshrq_n_u8(vInput, 4)));
+
+			// Continuation bytes 2 or 3 after a 3 or 4 byte prefix
+			const uint8x16_t vThird =
+				vqsubq_u8(vextq_u8(vPrevious, vInput, 14), vdupq_n_u8(0x60));
+			const uint8x16_t vFourth =
+				vqsubq_u8(vextq_u8(vPrevious, vInput, 13), vdupq_n_u8(0x70));
+			const uint8x16_t vMust23 =
+				vandq_u8(vorrq_u8(vThird, vFourth), vdupq_n_u8(0x80));
+			vError = vorrq_u8(vError, veorq_u8(vMust23, vSpecial));
+			vIncomplete = vqsubq_u8(vInput, vMaxFinal);
+		}
+		vPrevious = vInput;
+	}
+	vError = vorrq_u8(vError, vIncomplete);
+	return !vmaxvq_u8(vError);
+}
+
+#endif
+#endif
+
 /***************************************
 
 	Here are the invalid UTF8 patterns that this code is using for error
@@ -268,6 +696,16 @@ uint_t BURGER_API Burger::UTF8::is_valid_single(
 
 uint_t BURGER_API Burger::UTF8::is_valid(const char* pInput) BURGER_NOEXCEPT
 {
+#if defined(USE_SSSE3) || defined(USE_NEON)
+	// The vector validator is faster, even with the extra pass for the length
+#if defined(USE_SSSE3)
+	if (HasSSSE3())
+#endif
+	{
+		return ValidateUTF8(reinterpret_cast<const uint8_t*>(pInput),
+			string_length(pInput));
+	}
+#endif
 	// Check for the simple case of 0x00-0x7F
 	uint_t uFirst;
 	do {
@@ -374,6 +812,15 @@ uint_t BURGER_API Burger::UTF8::is_valid(const char* pInput) BURGER_NOEXCEPT
 uint_t BURGER_API Burger::UTF8::is_valid(
 	const char* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT
 {
+#if defined(USE_SSSE3) || defined(USE_NEON)
+#if defined(USE_SSSE3)
+	if (HasSSSE3())
+#endif
+	{
+		return ValidateUTF8(
+			reinterpret_cast<const uint8_t*>(pInput), uInputSize);
+	}
+#endif
 	// End mark
 	const char* pEndPtr = pInput + uInputSize;
 	uint_t uTemp = 0;
@@ -575,30 +1022,7 @@ uintptr_t BURGER_API Burger::UTF8::GetMacRomanUSSize(
 uintptr_t BURGER_API Burger::UTF8::GetMacRomanUSSize(
 	const char* pInput) BURGER_NOEXCEPT
 {
-	uintptr_t uResult = 0;
-
-	uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-	if (uTemp) {
-		do {
-			// ASCII?
-			if (uTemp >= 0x80U) {
-				// The MacRomanUS table only has 2 or 3 byte tokens
-				const uint8_t* pTable =
-					MacRomanUS::g_ToUTF8[uTemp - 0x80U];
-				uResult += 2U;
-				// Is there a third character?
-				if (pTable[2]) {
-					++uResult;
-				}
-			} else {
-				// 0x00 - 0x7F is literal ASCII
-				++uResult;
-			}
-			++pInput;
-			uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-		} while (uTemp);
-	}
-	return uResult;
+	return GetMacRomanUSSize(pInput, string_length(pInput));
 }
 
 /*! ************************************
@@ -621,28 +1045,7 @@ uintptr_t BURGER_API Burger::UTF8::GetMacRomanUSSize(
 uintptr_t BURGER_API Burger::UTF8::GetMacRomanUSSize(
 	const char* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT
 {
-	uintptr_t uResult = 0;
-	if (uInputSize) {
-		do {
-			uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-			// ASCII?
-			if (uTemp >= 0x80U) {
-				// The MacRomanUS table only has 2 or 3 byte tokens
-				const uint8_t* pTable =
-					MacRomanUS::g_ToUTF8[uTemp - 0x80U];
-				uResult += 2U;
-				// Is there a third character?
-				if (pTable[2]) {
-					++uResult;
-				}
-			} else {
-				// 0x00 - 0x7F is literal ASCII
-				++uResult;
-			}
-			++pInput;
-		} while (--uInputSize);
-	}
-	return uResult;
+	return GetGenericSize(MacRomanUS::g_ToUTF8, pInput, uInputSize);
 }
 
 /*! ************************************
@@ -724,71 +1127,8 @@ uintptr_t BURGER_API Burger::UTF8::FromMacRomanUS(
 uintptr_t BURGER_API Burger::UTF8::FromMacRomanUS(
 	char* pOutput, uintptr_t uOutputSize, const char* pInput) BURGER_NOEXCEPT
 {
-	uint8_t* pWorkPtr = reinterpret_cast<uint8_t*>(pOutput);
-	// If nonzero, then I append a 0 to the string.
-	const uintptr_t uAddZero = uOutputSize;
-	// Valid?
-	if (uOutputSize) {
-		--uOutputSize;
-	}
-	// This is the end of the valid buffer
-	uint8_t* pEndPtr = pWorkPtr + uOutputSize;
-
-	// Let's convert the string
-	uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-	++pInput;    // Accept it
-	if (uTemp) { // Can I start the loop?
-		do {
-
-			// Get a char
-			// ASCII?
-			if (uTemp < 0x80U) {
-				// Can I write?
-				if (pWorkPtr < pEndPtr) {
-					pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-				}
-				// Increment the output
-				++pWorkPtr;
-			} else {
-
-				// The MacRomanUS table only has 2 or 3 byte tokens
-				const uint8_t* pSrc = MacRomanUS::g_ToUTF8[uTemp - 0x80U];
-				if (pWorkPtr < pEndPtr) {
-					// Write the first character
-					pWorkPtr[0] = pSrc[0];
-				}
-				++pWorkPtr;
-				if (pWorkPtr < pEndPtr) {
-					// Write the second character
-					pWorkPtr[0] = pSrc[1];
-				}
-				++pWorkPtr;
-
-				// Write the optional third character
-				uTemp = pSrc[2];
-				if (uTemp) {
-					if (pWorkPtr < pEndPtr) {
-						pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-					}
-					++pWorkPtr;
-				}
-			}
-			uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-			// Accept it
-			++pInput;
-		} while (uTemp);
-	}
-	// Can I add a trailing zero?
-	if (uAddZero) {
-		if (pWorkPtr < pEndPtr) {
-			pEndPtr = pWorkPtr;
-		}
-		// Write it, but don't add it to the strlen()
-		pEndPtr[0] = 0;
-	}
-
-	// Return the equivalent of strlen()
-	return static_cast<uintptr_t>(reinterpret_cast<char*>(pWorkPtr) - pOutput);
+	return FromGeneric(pOutput, uOutputSize, MacRomanUS::g_ToUTF8, pInput,
+		string_length(pInput));
 }
 
 /*! ************************************
@@ -826,70 +1166,8 @@ uintptr_t BURGER_API Burger::UTF8::FromMacRomanUS(char* pOutput,
 	uintptr_t uOutputSize, const char* pInput,
 	uintptr_t uInputSize) BURGER_NOEXCEPT
 {
-	uint8_t* pWorkPtr = reinterpret_cast<uint8_t*>(pOutput);
-	// Can I save a zero?
-	const uintptr_t uAddZero = uOutputSize;
-	// Valid for anything?
-	if (uOutputSize) {
-		// Make room for the zero
-		--uOutputSize;
-	}
-	// Can't write, ever
-	uint8_t* pEndPtr = pWorkPtr + uOutputSize;
-
-	// Let's convert the string
-	if (uInputSize) {
-		do {
-			uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-			// Accept it
-			++pInput;
-
-			// Get a char
-			// ASCII?
-			if (uTemp < 0x80U) {
-				// Can I write?
-				if (pWorkPtr < pEndPtr) {
-					pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-				}
-				// Increment the output
-				++pWorkPtr;
-			} else {
-
-				// The MacRomanUS table only has 2 or 3 byte tokens
-				const uint8_t* pSrc = MacRomanUS::g_ToUTF8[uTemp - 0x80U];
-				if (pWorkPtr < pEndPtr) {
-					// Write the first character
-					pWorkPtr[0] = pSrc[0];
-				}
-				++pWorkPtr;
-				if (pWorkPtr < pEndPtr) {
-					// Write the second character
-					pWorkPtr[0] = pSrc[1];
-				}
-				++pWorkPtr;
-
-				// Write the optional third character
-				uTemp = pSrc[2];
-				if (uTemp) {
-					if (pWorkPtr < pEndPtr) {
-						pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-					}
-					++pWorkPtr;
-				}
-			}
-		} while (--uInputSize);
-	}
-	// Can I add a trailing zero?
-	if (uAddZero) {
-		if (pWorkPtr < pEndPtr) {
-			pEndPtr = pWorkPtr;
-		}
-		// Write it, but don't add it to the strlen()
-		pEndPtr[0] = 0;
-	}
-
-	// Return the equivalent of strlen()
-	return static_cast<uintptr_t>(reinterpret_cast<char*>(pWorkPtr) - pOutput);
+	return FromGeneric(
+		pOutput, uOutputSize, MacRomanUS::g_ToUTF8, pInput, uInputSize);
 }
 
 /*! ************************************
@@ -954,29 +1232,7 @@ uintptr_t BURGER_API Burger::UTF8::GetWin1252Size(uint_t uInput) BURGER_NOEXCEPT
 uintptr_t BURGER_API Burger::UTF8::GetWin1252Size(
 	const char* pInput) BURGER_NOEXCEPT
 {
-	uintptr_t uResult = 0;
-
-	uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-	if (uTemp) {
-		do {
-			// ASCII?
-			if (uTemp >= 0x80U) {
-				// The Win1252 table only has 2 or 3 byte tokens
-				const uint8_t* pTable = Win1252::g_ToUTF8[uTemp - 0x80U];
-				uResult += 2U;
-				// Is there a third character?
-				if (pTable[2]) {
-					++uResult;
-				}
-			} else {
-				// 0x00 - 0x7F is literal ASCII
-				++uResult;
-			}
-			++pInput;
-			uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-		} while (uTemp);
-	}
-	return uResult;
+	return GetWin1252Size(pInput, string_length(pInput));
 }
 
 /*! ************************************
@@ -999,27 +1255,7 @@ uintptr_t BURGER_API Burger::UTF8::GetWin1252Size(
 uintptr_t BURGER_API Burger::UTF8::GetWin1252Size(
 	const char* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT
 {
-	uintptr_t uResult = 0;
-	if (uInputSize) {
-		do {
-			uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-			// ASCII?
-			if (uTemp >= 0x80U) {
-				// The Win1252 table only has 2 or 3 byte tokens
-				const uint8_t* pTable = Win1252::g_ToUTF8[uTemp - 0x80U];
-				uResult += 2U;
-				// Is there a third character?
-				if (pTable[2]) {
-					++uResult;
-				}
-			} else {
-				// 0x00 - 0x7F is literal ASCII
-				++uResult;
-			}
-			++pInput;
-		} while (--uInputSize);
-	}
-	return uResult;
+	return GetGenericSize(Win1252::g_ToUTF8, pInput, uInputSize);
 }
 
 /*! ************************************
@@ -1106,73 +1342,8 @@ uintptr_t BURGER_API Burger::UTF8::FromWin1252(
 uintptr_t BURGER_API Burger::UTF8::FromWin1252(
 	char* pOutput, uintptr_t uOutputSize, const char* pInput) BURGER_NOEXCEPT
 {
-	uint8_t* pWorkPtr = reinterpret_cast<uint8_t*>(pOutput);
-	// If nonzero, then I append a 0 to the string.
-	const uintptr_t uAddZero = uOutputSize;
-
-	// Valid?
-	if (uOutputSize) {
-		--uOutputSize;
-	}
-	// This is the end of the valid buffer
-	uint8_t* pEndPtr = pWorkPtr + uOutputSize;
-
-	// Let's convert the string
-	uint_t Temp = reinterpret_cast<const uint8_t*>(pInput)[0];
-	++pInput; // Accept it
-	// Can I start the loop?
-	if (Temp) {
-		do {
-
-			// Get a char
-			// ASCII?
-			if (Temp < 0x80U) {
-				// Can I write?
-				if (pWorkPtr < pEndPtr) {
-					pWorkPtr[0] = static_cast<uint8_t>(Temp);
-				}
-				// Increment the output
-				++pWorkPtr;
-			} else {
-
-				// The Win1252 table only has 2 or 3 byte tokens
-				const uint8_t* pSrc = Win1252::g_ToUTF8[Temp - 0x80U];
-				if (pWorkPtr < pEndPtr) {
-					// Write the first character
-					pWorkPtr[0] = pSrc[0];
-				}
-				++pWorkPtr;
-				if (pWorkPtr < pEndPtr) {
-					// Write the second character
-					pWorkPtr[0] = pSrc[1];
-				}
-				++pWorkPtr;
-
-				// Write the optional third character
-				Temp = pSrc[2];
-				if (Temp) {
-					if (pWorkPtr < pEndPtr) {
-						pWorkPtr[0] = static_cast<uint8_t>(Temp);
-					}
-					++pWorkPtr;
-				}
-			}
-			Temp = reinterpret_cast<const uint8_t*>(pInput)[0];
-			// Accept it
-			++pInput;
-		} while (Temp);
-	}
-	// Can I add a trailing zero?
-	if (uAddZero) {
-		if (pWorkPtr < pEndPtr) {
-			pEndPtr = pWorkPtr;
-		}
-		// Write it, but don't add it to the strlen()
-		pEndPtr[0] = 0;
-	}
-
-	// Return the equivalent of strlen()
-	return static_cast<uintptr_t>(reinterpret_cast<char*>(pWorkPtr) - pOutput);
+	return FromGeneric(pOutput, uOutputSize, Win1252::g_ToUTF8, pInput,
+		string_length(pInput));
 }
 
 /*! ************************************
@@ -1211,70 +1382,8 @@ uintptr_t BURGER_API Burger::UTF8::FromWin1252(char* pOutput,
 	uintptr_t uOutputSize, const char* pInput,
 	uintptr_t uInputSize) BURGER_NOEXCEPT
 {
-	uint8_t* pWorkPtr = reinterpret_cast<uint8_t*>(pOutput);
-	// Can I save a zero?
-	const uintptr_t uAddZero = uOutputSize;
-	// Valid for anything?
-	if (uOutputSize) {
-		// Make room for the zero
-		--uOutputSize;
-	}
-	// Can't write, ever
-	uint8_t* pEndPtr = pWorkPtr + uOutputSize;
-
-	// Let's convert the string
-	if (uInputSize) {
-		do {
-			uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-			// Accept it
-			++pInput;
-
-			// Get a char
-			// ASCII?
-			if (uTemp < 0x80U) {
-				// Can I write?
-				if (pWorkPtr < pEndPtr) {
-					pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-				}
-				// Increment the output
-				++pWorkPtr;
-			} else {
-
-				// The Win1252 table only has 2 or 3 byte tokens
-				const uint8_t* pSrc = Win1252::g_ToUTF8[uTemp - 0x80U];
-				if (pWorkPtr < pEndPtr) {
-					// Write the first character
-					pWorkPtr[0] = pSrc[0];
-				}
-				++pWorkPtr;
-				if (pWorkPtr < pEndPtr) {
-					// Write the second character
-					pWorkPtr[0] = pSrc[1];
-				}
-				++pWorkPtr;
-
-				// Write the optional third character
-				uTemp = pSrc[2];
-				if (uTemp) {
-					if (pWorkPtr < pEndPtr) {
-						pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-					}
-					++pWorkPtr;
-				}
-			}
-		} while (--uInputSize);
-	}
-	// Can I add a trailing zero?
-	if (uAddZero) {
-		if (pWorkPtr < pEndPtr) {
-			pEndPtr = pWorkPtr;
-		}
-		// Write it, but don't add it to the strlen()
-		pEndPtr[0] = 0;
-	}
-
-	// Return the equivalent of strlen()
-	return static_cast<uintptr_t>(reinterpret_cast<char*>(pWorkPtr) - pOutput);
+	return FromGeneric(
+		pOutput, uOutputSize, Win1252::g_ToUTF8, pInput, uInputSize);
 }
 
 /*! ************************************
@@ -1339,29 +1448,7 @@ uintptr_t BURGER_API Burger::UTF8::GetWin437Size(uint_t uInput) BURGER_NOEXCEPT
 uintptr_t BURGER_API Burger::UTF8::GetWin437Size(
 	const char* pInput) BURGER_NOEXCEPT
 {
-	uintptr_t uResult = 0;
-
-	uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-	if (uTemp) {
-		do {
-			// ASCII?
-			if (uTemp >= 0x80U) {
-				// The Win1252 table only has 2 or 3 byte tokens
-				const uint8_t* pTable = Win437::g_ToUTF8[uTemp - 0x80U];
-				uResult += 2U;
-				// Is there a third character?
-				if (pTable[2]) {
-					++uResult;
-				}
-			} else {
-				// 0x00 - 0x7F is literal ASCII
-				++uResult;
-			}
-			++pInput;
-			uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-		} while (uTemp);
-	}
-	return uResult;
+	return GetWin437Size(pInput, string_length(pInput));
 }
 
 /*! ************************************
@@ -1384,27 +1471,7 @@ uintptr_t BURGER_API Burger::UTF8::GetWin437Size(
 uintptr_t BURGER_API Burger::UTF8::GetWin437Size(
 	const char* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT
 {
-	uintptr_t uResult = 0;
-	if (uInputSize) {
-		do {
-			uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-			// ASCII?
-			if (uTemp >= 0x80U) {
-				// The Win1252 table only has 2 or 3 byte tokens
-				const uint8_t* pTable = Win437::g_ToUTF8[uTemp - 0x80U];
-				uResult += 2U;
-				// Is there a third character?
-				if (pTable[2]) {
-					++uResult;
-				}
-			} else {
-				// 0x00 - 0x7F is literal ASCII
-				++uResult;
-			}
-			++pInput;
-		} while (--uInputSize);
-	}
-	return uResult;
+	return GetGenericSize(Win437::g_ToUTF8, pInput, uInputSize);
 }
 
 /*! ************************************
@@ -1491,73 +1558,8 @@ uintptr_t BURGER_API Burger::UTF8::FromWin437(
 uintptr_t BURGER_API Burger::UTF8::FromWin437(
 	char* pOutput, uintptr_t uOutputSize, const char* pInput) BURGER_NOEXCEPT
 {
-	uint8_t* pWorkPtr = reinterpret_cast<uint8_t*>(pOutput);
-	// If nonzero, then I append a 0 to the string.
-	const uintptr_t uAddZero = uOutputSize;
-
-	// Valid?
-	if (uOutputSize) {
-		--uOutputSize;
-	}
-	// This is the end of the valid buffer
-	uint8_t* pEndPtr = pWorkPtr + uOutputSize;
-
-	// Let's convert the string
-	uint_t Temp = reinterpret_cast<const uint8_t*>(pInput)[0];
-	++pInput; // Accept it
-	// Can I start the loop?
-	if (Temp) {
-		do {
-
-			// Get a char
-			// ASCII?
-			if (Temp < 0x80U) {
-				// Can I write?
-				if (pWorkPtr < pEndPtr) {
-					pWorkPtr[0] = static_cast<uint8_t>(Temp);
-				}
-				// Increment the output
-				++pWorkPtr;
-			} else {
-
-				// The Win437 table only has 2 or 3 byte tokens
-				const uint8_t* pSrc = Win437::g_ToUTF8[Temp - 0x80U];
-				if (pWorkPtr < pEndPtr) {
-					// Write the first character
-					pWorkPtr[0] = pSrc[0];
-				}
-				++pWorkPtr;
-				if (pWorkPtr < pEndPtr) {
-					// Write the second character
-					pWorkPtr[0] = pSrc[1];
-				}
-				++pWorkPtr;
-
-				// Write the optional third character
-				Temp = pSrc[2];
-				if (Temp) {
-					if (pWorkPtr < pEndPtr) {
-						pWorkPtr[0] = static_cast<uint8_t>(Temp);
-					}
-					++pWorkPtr;
-				}
-			}
-			Temp = reinterpret_cast<const uint8_t*>(pInput)[0];
-			// Accept it
-			++pInput;
-		} while (Temp);
-	}
-	// Can I add a trailing zero?
-	if (uAddZero) {
-		if (pWorkPtr < pEndPtr) {
-			pEndPtr = pWorkPtr;
-		}
-		// Write it, but don't add it to the strlen()
-		pEndPtr[0] = 0;
-	}
-
-	// Return the equivalent of strlen()
-	return static_cast<uintptr_t>(reinterpret_cast<char*>(pWorkPtr) - pOutput);
+	return FromGeneric(pOutput, uOutputSize, Win437::g_ToUTF8, pInput,
+		string_length(pInput));
 }
 
 /*! ************************************
@@ -1596,70 +1598,8 @@ uintptr_t BURGER_API Burger::UTF8::FromWin437(char* pOutput,
 	uintptr_t uOutputSize, const char* pInput,
 	uintptr_t uInputSize) BURGER_NOEXCEPT
 {
-	uint8_t* pWorkPtr = reinterpret_cast<uint8_t*>(pOutput);
-	// Can I save a zero?
-	const uintptr_t uAddZero = uOutputSize;
-	// Valid for anything?
-	if (uOutputSize) {
-		// Make room for the zero
-		--uOutputSize;
-	}
-	// Can't write, ever
-	uint8_t* pEndPtr = pWorkPtr + uOutputSize;
-
-	// Let's convert the string
-	if (uInputSize) {
-		do {
-			uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-			// Accept it
-			++pInput;
-
-			// Get a char
-			// ASCII?
-			if (uTemp < 0x80U) {
-				// Can I write?
-				if (pWorkPtr < pEndPtr) {
-					pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-				}
-				// Increment the output
-				++pWorkPtr;
-			} else {
-
-				// The Win437 table only has 2 or 3 byte tokens
-				const uint8_t* pSrc = Win437::g_ToUTF8[uTemp - 0x80U];
-				if (pWorkPtr < pEndPtr) {
-					// Write the first character
-					pWorkPtr[0] = pSrc[0];
-				}
-				++pWorkPtr;
-				if (pWorkPtr < pEndPtr) {
-					// Write the second character
-					pWorkPtr[0] = pSrc[1];
-				}
-				++pWorkPtr;
-
-				// Write the optional third character
-				uTemp = pSrc[2];
-				if (uTemp) {
-					if (pWorkPtr < pEndPtr) {
-						pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-					}
-					++pWorkPtr;
-				}
-			}
-		} while (--uInputSize);
-	}
-	// Can I add a trailing zero?
-	if (uAddZero) {
-		if (pWorkPtr < pEndPtr) {
-			pEndPtr = pWorkPtr;
-		}
-		// Write it, but don't add it to the strlen()
-		pEndPtr[0] = 0;
-	}
-
-	// Return the equivalent of strlen()
-	return static_cast<uintptr_t>(reinterpret_cast<char*>(pWorkPtr) - pOutput);
+	return FromGeneric(
+		pOutput, uOutputSize, Win437::g_ToUTF8, pInput, uInputSize);
 }
 
 /*! ************************************
@@ -1719,23 +1659,7 @@ uintptr_t BURGER_API Burger::UTF8::GetISOLatin1Size(
 uintptr_t BURGER_API Burger::UTF8::GetISOLatin1Size(
 	const char* pInput) BURGER_NOEXCEPT
 {
-	uintptr_t uResult = 0;
-
-	uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-	if (uTemp) {
-		do {
-			// ASCII?
-			if (uTemp >= 0x80U) {
-				uResult += 2U;
-			} else {
-				// 0x00 - 0x7F is literal ASCII
-				++uResult;
-			}
-			++pInput;
-			uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-		} while (uTemp);
-	}
-	return uResult;
+	return GetISOLatin1Size(pInput, string_length(pInput));
 }
 
 /*! ************************************
@@ -1758,21 +1682,8 @@ uintptr_t BURGER_API Burger::UTF8::GetISOLatin1Size(
 uintptr_t BURGER_API Burger::UTF8::GetISOLatin1Size(
 	const char* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT
 {
-	uintptr_t uResult = 0;
-	if (uInputSize) {
-		do {
-			uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-			// ASCII?
-			if (uTemp >= 0x80U) {
-				uResult += 2U;
-			} else {
-				// 0x00 - 0x7F is literal ASCII
-				++uResult;
-			}
-			++pInput;
-		} while (--uInputSize);
-	}
-	return uResult;
+	// Every high ASCII character is a 2 byte UTF8 token
+	return uInputSize + count_high_ASCII(pInput, uInputSize);
 }
 
 /*! ************************************
@@ -1849,64 +1760,8 @@ uintptr_t BURGER_API Burger::UTF8::FromISOLatin1(
 uintptr_t BURGER_API Burger::UTF8::FromISOLatin1(
 	char* pOutput, uintptr_t uOutputSize, const char* pInput) BURGER_NOEXCEPT
 {
-	uint8_t* pWorkPtr = reinterpret_cast<uint8_t*>(pOutput);
-	// If nonzero, then I append a 0 to the string.
-	const uintptr_t uAddZero = uOutputSize;
-	// Valid?
-	if (uOutputSize) {
-		--uOutputSize;
-	}
-	// This is the end of the valid buffer
-	uint8_t* pEndPtr = pWorkPtr + uOutputSize;
-
-	// Let's convert the string
-	uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-	// Accept it
-	++pInput;
-	// Can I start the loop?
-	if (uTemp) {
-		do {
-
-			// Get a char
-			// ASCII?
-			if (uTemp < 0x80U) {
-				// Can I write?
-				if (pWorkPtr < pEndPtr) {
-					pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-				}
-				// Increment the output
-				++pWorkPtr;
-			} else {
-
-				// The ISOLatin1 table only has 2 byte tokens
-				const uint8_t* pSrc = ISOLatin1::g_ToUTF8[uTemp - 0x80U];
-				if (pWorkPtr < pEndPtr) {
-					// Write the first character
-					pWorkPtr[0] = pSrc[0];
-				}
-				++pWorkPtr;
-				if (pWorkPtr < pEndPtr) {
-					// Write the second character
-					pWorkPtr[0] = pSrc[1];
-				}
-				++pWorkPtr;
-			}
-			uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-			// Accept it
-			++pInput;
-		} while (uTemp);
-	}
-	// Can I add a trailing zero?
-	if (uAddZero) {
-		if (pWorkPtr < pEndPtr) {
-			pEndPtr = pWorkPtr;
-		}
-		// Write it, but don't add it to the strlen()
-		pEndPtr[0] = 0;
-	}
-
-	// Return the equivalent of strlen()
-	return static_cast<uintptr_t>(reinterpret_cast<char*>(pWorkPtr) - pOutput);
+	return FromGeneric(pOutput, uOutputSize, ISOLatin1::g_ToUTF8, pInput,
+		string_length(pInput));
 }
 
 /*! ************************************
@@ -1935,70 +1790,17 @@ uintptr_t BURGER_API Burger::UTF8::FromISOLatin1(
 		uInputSize is zero.
 	\param uInputSize Size of the input byte array
 
-	\return Byte count of the potential output. It is valid, even if the output
-		buffer wasn't large enough to contain everything.
-
-***************************************/
-
-uintptr_t BURGER_API Burger::UTF8::FromISOLatin1(char* pOutput,
-	uintptr_t uOutputSize, const char* pInput,
-	uintptr_t uInputSize) BURGER_NOEXCEPT
-{
-	uint8_t* pWorkPtr = reinterpret_cast<uint8_t*>(pOutput);
-	// Can I save a zero?
-	const uintptr_t uAddZero = uOutputSize;
-	// Valid for anything?
-	if (uOutputSize) {
-		// Make room for the zero
-		--uOutputSize;
-	}
-	// Can't write, ever
-	uint8_t* pEndPtr = pWorkPtr + uOutputSize;
-
-	// Let's convert the string
-	if (uInputSize) {
-		do {
-			const uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-			// Accept it
-			++pInput;
-
-			// Get a char
-			// ASCII?
-			if (uTemp < 0x80U) {
-				// Can I write?
-				if (pWorkPtr < pEndPtr) {
-					pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-				}
-				// Increment the output
-				++pWorkPtr;
-			} else {
-
-				// The Win1252 table only has 2 byte tokens
-				const uint8_t* pSrc = ISOLatin1::g_ToUTF8[uTemp - 0x80U];
-				if (pWorkPtr < pEndPtr) {
-					// Write the first character
-					pWorkPtr[0] = pSrc[0];
-				}
-				++pWorkPtr;
-				if (pWorkPtr < pEndPtr) {
-					// Write the second character
-					pWorkPtr[0] = pSrc[1];
-				}
-				++pWorkPtr;
-			}
-		} while (--uInputSize);
-	}
-	// Can I add a trailing zero?
-	if (uAddZero) {
-		if (pWorkPtr < pEndPtr) {
-			pEndPtr = pWorkPtr;
-		}
-		// Write it, but don't add it to the strlen()
-		pEndPtr[0] = 0;
-	}
+	\return Byte count of the potential output. It is valid, even if the output
+		buffer wasn't large enough to contain everything.
 
-	// Return the equivalent of strlen()
-	return static_cast<uintptr_t>(reinterpret_cast<char*>(pWorkPtr) - pOutput);
+***************************************/
+
+uintptr_t BURGER_API Burger::UTF8::FromISOLatin1(char* pOutput,
+	uintptr_t uOutputSize, const char* pInput,
+	uintptr_t uInputSize) BURGER_NOEXCEPT
+{
+	return FromGeneric(
+		pOutput, uOutputSize, ISOLatin1::g_ToUTF8, pInput, uInputSize);
 }
 
 /*! ************************************
@@ -2080,40 +1882,7 @@ uintptr_t BURGER_API Burger::UTF8::GetGenericSize(
 uintptr_t BURGER_API Burger::UTF8::GetGenericSize(
 	const uint8_t pTranslateTable[128][4], const char* pInput) BURGER_NOEXCEPT
 {
-	uintptr_t uResult = 0;
-
-	uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-	if (uTemp) {
-		do {
-			// ASCII?
-			if (uTemp >= 0x80U) {
-				// Scan the table if there is a translation
-				const uint8_t* pTable = pTranslateTable[uTemp - 0x80U];
-
-				// Table marked as invalid entry?
-				if (pTable[0]) {
-					++uResult;
-					if (pTable[1]) {
-						++uResult;
-						// Is there a third character?
-						if (pTable[2]) {
-							++uResult;
-							// Forth character?
-							if (pTable[3]) {
-								++uResult;
-							}
-						}
-					}
-				}
-			} else {
-				// 0x00 - 0x7F is literal ASCII
-				++uResult;
-			}
-			++pInput;
-			uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-		} while (uTemp);
-	}
-	return uResult;
+	return GetGenericSize(pTranslateTable, pInput, string_length(pInput));
 }
 
 /*! ************************************
@@ -2141,34 +1910,38 @@ uintptr_t BURGER_API Burger::UTF8::GetGenericSize(
 	uintptr_t uInputSize) BURGER_NOEXCEPT
 {
 	uintptr_t uResult = 0;
-	if (uInputSize) {
-		do {
-			uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-			// ASCII?
-			if (uTemp >= 0x80U) {
-				// The Win1252 table only has 2 or 3 byte tokens
-				const uint8_t* pTable = pTranslateTable[uTemp - 0x80U];
-				// Table marked as invalid entry?
-				if (pTable[0]) {
+	while (uInputSize) {
+		// Low ASCII is one byte per character
+		const uintptr_t uRun = ASCII_span(pInput, uInputSize);
+		uResult += uRun;
+		pInput += uRun;
+		uInputSize -= uRun;
+
+		// Use the table for the high ASCII characters that follow
+		while (uInputSize) {
+			const uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
+			if (uTemp < 0x80U) {
+				break;
+			}
+			const uint8_t* pTable = pTranslateTable[uTemp - 0x80U];
+			// Table marked as invalid entry?
+			if (pTable[0]) {
+				++uResult;
+				if (pTable[1]) {
 					++uResult;
-					if (pTable[1]) {
+					// Is there a third character?
+					if (pTable[2]) {
 						++uResult;
-						// Is there a third character?
-						if (pTable[2]) {
+						// Forth character?
+						if (pTable[3]) {
 							++uResult;
-							// Forth character?
-							if (pTable[3]) {
-								++uResult;
-							}
 						}
 					}
 				}
-			} else {
-				// 0x00 - 0x7F is literal ASCII
-				++uResult;
 			}
 			++pInput;
-		} while (--uInputSize);
+			--uInputSize;
+		}
 	}
 	return uResult;
 }
@@ -2284,83 +2057,8 @@ uintptr_t BURGER_API Burger::UTF8::FromGeneric(char* pOutput,
 	uintptr_t uOutputSize, const uint8_t pTranslateTable[128][4],
 	const char* pInput) BURGER_NOEXCEPT
 {
-	uint8_t* pWorkPtr = reinterpret_cast<uint8_t*>(pOutput);
-	// If nonzero, then I append a 0 to the string.
-	const uintptr_t uAddZero = uOutputSize;
-	// Valid?
-	if (uOutputSize) {
-		--uOutputSize;
-	}
-	// This is the end of the valid buffer
-	uint8_t* pEndPtr = pWorkPtr + uOutputSize;
-
-	// Let's convert the string
-	uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-	// Accept it
-	++pInput;
-	// Can I start the loop?
-	if (uTemp) {
-		do {
-
-			// Get a char
-			// ASCII?
-			if (uTemp < 0x80U) {
-				// Can I write?
-				if (pWorkPtr < pEndPtr) {
-					pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-				}
-				// Increment the output
-				++pWorkPtr;
-			} else {
-
-				// The Generic table can have 0 to 4 bytes
-				const uint8_t* pSrc = pTranslateTable[uTemp - 0x80U];
-				uTemp = pSrc[0];
-				if (uTemp) {
-					if (pWorkPtr < pEndPtr) {
-						pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-					}
-					++pWorkPtr;
-					uTemp = pSrc[1];
-					if (uTemp) {
-						if (pWorkPtr < pEndPtr) {
-							pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-						}
-						++pWorkPtr;
-						uTemp = pSrc[2];
-						if (uTemp) {
-							if (pWorkPtr < pEndPtr) {
-								pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-							}
-							++pWorkPtr;
-							uTemp = pSrc[3];
-							if (uTemp) {
-								if (pWorkPtr < pEndPtr) {
-									pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-								}
-								++pWorkPtr;
-							}
-						}
-					}
-				}
-			}
-			uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
-			// Accept it
-			++pInput;
-		} while (uTemp);
-	}
-
-	// Can I add a trailing zero?
-	if (uAddZero) {
-		if (pWorkPtr < pEndPtr) {
-			pEndPtr = pWorkPtr;
-		}
-		// Write it, but don't add it to the strlen()
-		pEndPtr[0] = 0;
-	}
-
-	// Return the equivalent of strlen()
-	return static_cast<uintptr_t>(reinterpret_cast<char*>(pWorkPtr) - pOutput);
+	return FromGeneric(pOutput, uOutputSize, pTranslateTable, pInput,
+		string_length(pInput));
 }
 
 /*! ************************************
@@ -2416,59 +2114,67 @@ uintptr_t BURGER_API Burger::UTF8::FromGeneric(char* pOutput,
 	uint8_t* pEndPtr = pWorkPtr + uOutputSize;
 
 	// Let's convert the string
-	if (uInputSize) {
-		do {
+	while (uInputSize) {
+		// Copy runs of low ASCII as is
+		const uintptr_t uRun = ASCII_span(pInput, uInputSize);
+		if (uRun) {
+			// Copy as much as will fit
+			if (pWorkPtr < pEndPtr) {
+				uintptr_t uCopy = static_cast<uintptr_t>(pEndPtr - pWorkPtr);
+				if (uCopy > uRun) {
+					uCopy = uRun;
+				}
+				memory_copy(pWorkPtr, pInput, uCopy);
+			}
+			pWorkPtr += uRun;
+			pInput += uRun;
+			uInputSize -= uRun;
+		}
+
+		// Use the table for the high ASCII characters that follow
+		while (uInputSize) {
 			uint_t uTemp = reinterpret_cast<const uint8_t*>(pInput)[0];
+			if (uTemp < 0x80U) {
+				break;
+			}
 			// Accept it
 			++pInput;
-
-			// Get a char
-			// ASCII?
-			if (uTemp < 0x80U) {
-				// Can I write?
+			--uInputSize;
+			// The generic table has 0 to 4 bytes
+			const uint8_t* pSrc = pTranslateTable[uTemp - 0x80U];
+			uTemp = pSrc[0];
+			if (uTemp) {
 				if (pWorkPtr < pEndPtr) {
+					// Write the first character
 					pWorkPtr[0] = static_cast<uint8_t>(uTemp);
 				}
-				// Increment the output
 				++pWorkPtr;
-			} else {
-
-				// The generic table has 0 to 4 bytes
-				const uint8_t* pSrc = pTranslateTable[uTemp - 0x80U];
-				uTemp = pSrc[0];
+				uTemp = pSrc[1];
 				if (uTemp) {
 					if (pWorkPtr < pEndPtr) {
-						// Write the first character
+						// Write the second character
 						pWorkPtr[0] = static_cast<uint8_t>(uTemp);
 					}
 					++pWorkPtr;
-					uTemp = pSrc[1];
+
+					// Write the optional third character
+					uTemp = pSrc[2];
 					if (uTemp) {
 						if (pWorkPtr < pEndPtr) {
-							// Write the second character
 							pWorkPtr[0] = static_cast<uint8_t>(uTemp);
 						}
 						++pWorkPtr;
-
-						// Write the optional third character
-						uTemp = pSrc[2];
+						uTemp = pSrc[3];
 						if (uTemp) {
 							if (pWorkPtr < pEndPtr) {
 								pWorkPtr[0] = static_cast<uint8_t>(uTemp);
 							}
 							++pWorkPtr;
-							uTemp = pSrc[3];
-							if (uTemp) {
-								if (pWorkPtr < pEndPtr) {
-									pWorkPtr[0] = static_cast<uint8_t>(uTemp);
-								}
-								++pWorkPtr;
-							}
 						}
 					}
 				}
 			}
-		} while (--uInputSize);
+		}
 	}
 	// Can I add a trailing zero?
 	if (uAddZero) {
@@ -2744,6 +2450,13 @@ uintptr_t BURGER_API Burger::UTF8::from_UTF16(char* pOutput,
 				}
 				// Increment the output
 				++pWorkPtr;
+#if defined(USE_SSE2) || defined(USE_NEON)
+				// Convert runs of ASCII in bulk
+				const uintptr_t uCount = ASCIIFromUTF16(pWorkPtr, pEndPtr,
+					pInput, ElementsInPage(pInput, 2), TRUE);
+				pWorkPtr += uCount;
+				pInput += uCount;
+#endif
 				// 0x80-0x7FF (11 bit encoding)?
 			} else if (uTemp < 0x800U) {
 				if (pWorkPtr < pEndPtr) {
@@ -2893,6 +2606,14 @@ uintptr_t BURGER_API Burger::UTF8::from_UTF16(char* pOutput,
 				}
 				// Increment the output
 				++pWorkPtr;
+#if defined(USE_SSE2) || defined(USE_NEON)
+				// Convert runs of ASCII in bulk
+				const uintptr_t uCount = ASCIIFromUTF16(
+					pWorkPtr, pEndPtr, pInput, uInputSize - 1, FALSE);
+				pWorkPtr += uCount;
+				pInput += uCount;
+				uInputSize -= uCount;
+#endif
 				// 0x80-0x7FF (11 bit encoding) ?
 			} else if (uTemp < 0x800U) {
 				if (pWorkPtr < pEndPtr) {
@@ -3276,6 +2997,13 @@ uintptr_t BURGER_API Burger::UTF8::from_UTF32(char* pOutput,
 					pWorkPtr[0] = static_cast<uint8_t>(uTemp);
 				}
 				++pWorkPtr;
+#if defined(USE_SSE2) || defined(USE_NEON)
+				// Convert runs of ASCII in bulk
+				const uintptr_t uCount = ASCIIFromUTF32(pWorkPtr, pEndPtr,
+					pInput, ElementsInPage(pInput, 4), TRUE);
+				pWorkPtr += uCount;
+				pInput += uCount;
+#endif
 
 				// 0x80-0x7FF (11 bit encoding)?
 			} else if (uTemp < 0x800U) {
@@ -3428,6 +3156,14 @@ uintptr_t BURGER_API Burger::UTF8::from_UTF32(char* pOutput,
 					pWorkPtr[0] = static_cast<uint8_t>(uTemp);
 				}
 				++pWorkPtr;
+#if defined(USE_SSE2) || defined(USE_NEON)
+				// Convert runs of ASCII in bulk
+				const uintptr_t uCount = ASCIIFromUTF32(
+					pWorkPtr, pEndPtr, pInput, uInputSize - 1, FALSE);
+				pWorkPtr += uCount;
+				pInput += uCount;
+				uInputSize -= uCount;
+#endif
 
 				// 0x80-0x7FF (11 bit encoding) ?
 			} else if (uTemp < 0x800U) {
@@ -3644,102 +3380,8 @@ uintptr_t BURGER_API Burger::UTF8::ToGeneric(char* pOutput,
 	uintptr_t uOutputSize, const uint8_t pTranslateTable[128][4],
 	const char* pInput) BURGER_NOEXCEPT
 {
-	uint8_t* pWorkPtr = reinterpret_cast<uint8_t*>(pOutput);
-
-	// If nonzero, then I append a 0 to the string.
-	const uintptr_t uAddZero = uOutputSize;
-
-	// Valid?
-	if (uOutputSize) {
-		--uOutputSize;
-	}
-
-	// This is the end of the valid buffer
-	uint8_t* pEndPtr = pWorkPtr + uOutputSize;
-
-	// Let's convert the string
-	uint_t uFirst = reinterpret_cast<const uint8_t*>(pInput)[0];
-	// Accept it
-	++pInput;
-	// Can I start the loop?
-	if (uFirst) {
-		do {
-
-			// Get a char
-			// ASCII?
-			if (uFirst < 0x80U) {
-				// Can I write?
-				if (pWorkPtr < pEndPtr) {
-					pWorkPtr[0] = static_cast<uint8_t>(uFirst);
-				}
-				// Increment the output
-				++pWorkPtr;
-			} else if (uFirst >= 0xC2U) {
-				// Make a copy of the pointer
-				const uint8_t(*pTranslateTable2)[4] = pTranslateTable;
-
-				// Great, it's not low ASCII. Do it the hard way.
-				// Number of attempts
-				uintptr_t uCounter = 128;
-				do {
-					if (uFirst == pTranslateTable2[0][0]) {
-						uint_t uTemp = pTranslateTable2[0][1];
-						if (!uTemp) {
-							// Only one char?
-							break;
-						}
-						if (reinterpret_cast<const uint8_t*>(pInput)[0] ==
-							uTemp) {
-							uTemp = pTranslateTable2[0][2];
-							if (!uTemp) {
-								// I took two chars
-								++pInput;
-								break;
-							}
-							if (reinterpret_cast<const uint8_t*>(pInput)[1] ==
-								uTemp) {
-								uTemp = pTranslateTable2[0][3];
-								if (!uTemp) {
-									// I took three chars
-									pInput += 2;
-									break;
-								}
-								if (reinterpret_cast<const uint8_t*>(
-										pInput)[2] == uTemp) {
-									// I took four chars
-									pInput += 3;
-									break;
-								}
-							}
-						}
-					}
-					++pTranslateTable2; // Next 4 byte entry
-				} while (--uCounter);
-
-				if (uCounter) { // Found it?
-					if (pWorkPtr < pEndPtr) {
-						pWorkPtr[0] = static_cast<uint8_t>(256 - uCounter);
-					}
-					++pWorkPtr;
-				}
-			}
-			uFirst = reinterpret_cast<const uint8_t*>(pInput)[0];
-			// Accept it
-			++pInput;
-		} while (uFirst);
-	}
-
-	// Can I add a trailing zero?
-	if (uAddZero) {
-		if (pWorkPtr < pEndPtr) {
-			pEndPtr = pWorkPtr;
-		}
-		// Write it, but don't add it to the strlen()
-		pEndPtr[0] = 0;
-	}
-
-	// Return the equivalent of strlen()
-	return static_cast<uintptr_t>(reinterpret_cast<char*>(pWorkPtr) - pOutput);
+	return ToGeneric(pOutput, uOutputSize, pTranslateTable, pInput,
+		string_length(pInput));
 }
 
 /*! ************************************
@@ -3796,20 +3438,32 @@ uintptr_t BURGER_API Burger::UTF8::ToGeneric(char* pOutput,
 	// Let's convert the string
 	if (uInputSize) {
 		do {
+			// Copy runs of low ASCII as is
+			const uintptr_t uRun = ASCII_span(pInput, uInputSize);
+			if (uRun) {
+				// Copy as much as will fit
+				if (pWorkPtr < pEndPtr) {
+					uintptr_t uCopy =
+						static_cast<uintptr_t>(pEndPtr - pWorkPtr);
+					if (uCopy > uRun) {
+						uCopy = uRun;
+					}
+					memory_copy(pWorkPtr, pInput, uCopy);
+				}
+				pWorkPtr += uRun;
+				pInput += uRun;
+				uInputSize -= uRun;
+				if (!uInputSize) {
+					break;
+				}
+			}
+
+			// This is a high ASCII character
 			const uint_t uFirst = reinterpret_cast<const uint8_t*>(pInput)[0];
 			// Accept it
 			++pInput;
 
-			// Get a char
-			// ASCII?
-			if (uFirst < 0x80U) {
-				// Can I write?
-				if (pWorkPtr < pEndPtr) {
-					pWorkPtr[0] = static_cast<uint8_t>(uFirst);
-				}
-				// Increment the output
-				++pWorkPtr;
-			} else if (uFirst >= 0xC2U) {
+			if (uFirst >= 0xC2U) {
 
 				// Make a copy of the pointer
 				const uint8_t(*pTranslateTable2)[4] = pTranslateTable;
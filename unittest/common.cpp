@@ -28,15 +28,24 @@
 #include "testbrfixedpoint.h"
 #include "testbrfloatingpoint.h"
 #include "testbrhashes.h"
+#include "testbrdxt.h"
+#include "testbrfilegif.h"
+#include "testbrfileini.h"
+#include "testbrfilerle.h"
+#include "testbrfilepng.h"
+#include "testbrimage.h"
 #include "testbrmatrix3d.h"
 #include "testbrmatrix4d.h"
 #include "testbrnumberto.h"
+#include "testbroutputmemorystream.h"
 #include "testbrpoweroftwo.h"
 #include "testbrprintf.h"
 #include "testbrstaticrtti.h"
+#include "testbrstringatom.h"
 #include "testbrstrings.h"
 #include "testbrtimedate.h"
 #include "testbrtypes.h"
+#include "testbrxmlreader.h"
 #include "testcharset.h"
 #include "testmacros.h"
 #include <stdarg.h>
@@ -361,12 +370,21 @@ int BURGER_ANSIAPI main(int argc, const char** argv)
 		iResult |= TestBrhashes(uVerbose);
 		iResult |= TestCharset(uVerbose);
 		iResult |= TestBrstrings(uVerbose);
+		iResult |= TestBrstringatom(uVerbose);
+		iResult |= TestBrxmlreader(uVerbose);
+		iResult |= TestBrfileini(uVerbose);
+		iResult |= TestBroutputmemorystream(uVerbose);
 		iResult |= TestBrnumberto(uVerbose);
 		iResult |= TestStdoutHelpers(uVerbose);
 		iResult |= TestBrprintf(uVerbose);
 		iResult |= TestDateTime(uVerbose);
 		iResult |= TestBrCodeLibrary(uVerbose);
 		iResult |= TestBrcompression(uVerbose);
+		iResult |= TestBrimage(uVerbose);
+		iResult |= TestBrdxt(uVerbose);
+		iResult |= TestBrfilepng(uVerbose);
+		iResult |= TestBrfilegif(uVerbose);
+		iResult |= TestBrfilerle(uVerbose);
 		iResult |= static_cast<int>(TestBrFileManager(uVerbose));
 
 		if (uVerbose & VERBOSE_DIALOGS) {
@@ -13,6 +13,7 @@
 ***************************************/
 
 #include "testbrcompression.h"
+#include "bradler32.h"
 #include "brcompressdeflate.h"
 #include "brcompresslbmrle.h"
 #include "brcompresslzss.h"
@@ -993,6 +994,93 @@ static uint_t TestDeflateCompress(void) BURGER_NOEXCEPT
 	return uFailure;
 }
 
+//
+// Test the compression levels and joining raw deflate streams
+//
+
+static uint_t TestDeflateLevels(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = FALSE;
+
+	// Text like data with repeats at many distances
+	const uintptr_t uSourceSize = 40000;
+	uint8_t* pSource = static_cast<uint8_t*>(allocate_memory(uSourceSize));
+	uint8_t* pDecompressed =
+		static_cast<uint8_t*>(allocate_memory(uSourceSize));
+	uint32_t uSeed = 12345;
+	uintptr_t i = 0;
+	do {
+		uSeed = uSeed * 1664525U + 1013904223U;
+		pSource[i] = static_cast<uint8_t>(
+			(uSeed >> 28U) ? ('a' + ((i * 7U) % 23U)) : (uSeed >> 16U));
+	} while (++i < uSourceSize);
+
+	CompressDeflate* pTester = new_object<CompressDeflate>();
+	DecompressDeflate* pDecompressor = new_object<DecompressDeflate>();
+	uint_t uLevel = 1;
+	do {
+		pTester->SetLevel(uLevel);
+		pTester->Init();
+		uint_t uTest = pTester->Process(pSource, uSourceSize / 3) != kErrorNone;
+		uTest |= pTester->Process(pSource + (uSourceSize / 3),
+					 uSourceSize - (uSourceSize / 3)) != kErrorNone;
+		uTest |= pTester->Finalize() != kErrorNone;
+		uintptr_t uLength;
+		void* pPacked = pTester->GetOutput()->Flatten(&uLength);
+		pDecompressor->Reset();
+		memory_clear(pDecompressed, uSourceSize);
+		uTest |= pDecompressor->Process(pDecompressed, uSourceSize, pPacked,
+					 uLength) != kErrorNone;
+		uTest |= MemoryCompare(pDecompressed, pSource, uSourceSize) != 0;
+		free_memory(pPacked);
+		uFailure |= uTest;
+		ReportFailure("CompressDeflate::SetLevel(%u) round trip", uTest, uLevel);
+	} while (++uLevel < 10);
+
+	// Compress two halves without headers and join them into one zlib stream
+	CompressDeflate* pSecond = new_object<CompressDeflate>();
+	pTester->SetLevel(CompressDeflate::LEVEL_DEFAULT);
+	pTester->SetRawMode(TRUE);
+	pTester->Init();
+	pSecond->SetLevel(CompressDeflate::LEVEL_DEFAULT);
+	pSecond->SetRawMode(TRUE);
+	const uintptr_t uHalf = uSourceSize / 2;
+	uint_t uTest = pTester->Process(pSource, uHalf) != kErrorNone;
+	uTest |= pTester->Flush() != kErrorNone;
+	uTest |= pSecond->Process(pSource + uHalf, uSourceSize - uHalf) !=
+		kErrorNone;
+	uTest |= pSecond->Finalize() != kErrorNone;
+
+	OutputMemoryStream Joined;
+	Joined.BigEndianAppend(static_cast<uint16_t>(0x789C));
+	uintptr_t uLength;
+	void* pPacked = pTester->GetOutput()->Flatten(&uLength);
+	Joined.Append(pPacked, uLength);
+	free_memory(pPacked);
+	pPacked = pSecond->GetOutput()->Flatten(&uLength);
+	Joined.Append(pPacked, uLength);
+	free_memory(pPacked);
+	Joined.BigEndianAppend(combine_adler32(calc_adler32(pSource, uHalf),
+		calc_adler32(pSource + uHalf, uSourceSize - uHalf),
+		uSourceSize - uHalf));
+	pPacked = Joined.Flatten(&uLength);
+	pDecompressor->Reset();
+	memory_clear(pDecompressed, uSourceSize);
+	uTest |= pDecompressor->Process(
+				 pDecompressed, uSourceSize, pPacked, uLength) != kErrorNone;
+	uTest |= MemoryCompare(pDecompressed, pSource, uSourceSize) != 0;
+	free_memory(pPacked);
+	uFailure |= uTest;
+	ReportFailure("CompressDeflate::Flush() joined raw streams", uTest);
+
+	delete_object(pSecond);
+	delete_object(pDecompressor);
+	delete_object(pTester);
+	free_memory(pDecompressed);
+	free_memory(pSource);
+	return uFailure;
+}
+
 //
 // Test compression code
 //
@@ -1010,6 +1098,7 @@ int BURGER_API TestBrcompression(uint_t uVerbose) BURGER_NOEXCEPT
 		uResult |= TestLZSSCompress();
 		uResult |= TestDeflateDecompress();
 		uResult |= TestDeflateCompress();
+		uResult |= TestDeflateLevels();
 		if (!uResult && (uVerbose & VERBOSE_MSG)) {
 			Message("Passed all Compression tests!");
 		}
@@ -0,0 +1,653 @@
+/***************************************
+
+	Unit tests for DXT compression
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#include "testbrdxt.h"
+#include "brdxt1.h"
+#include "brdxt3.h"
+#include "brdxt5.h"
+#include "brfloatingpoint.h"
+#include "brmemoryfunctions.h"
+#include "brtick.h"
+#include "common.h"
+
+using namespace Burger;
+
+typedef void(BURGER_API* DXTCompressProc_t)(void* pOutput,
+	uintptr_t uOutputStride, uint_t uWidth, uint_t uHeight,
+	const RGBAWord8_t* pInput, uintptr_t uInputStride, uint_t uFlags,
+	uint_t uThreadCount);
+typedef void(BURGER_API* DXTDecompressProc_t)(RGBAWord8_t* pOutput,
+	uintptr_t uOutputStride, uint_t uWidth, uint_t uHeight,
+	const void* pInput, uintptr_t uInputStride, uint_t uFlags,
+	uint_t uThreadCount);
+typedef void(BURGER_API* DXTBlockDecompressProc_t)(
+	RGBAWord8_t* pOutput, uintptr_t uStride, const void* pInput);
+
+static void BURGER_API CompressDXT1(void* pOutput, uintptr_t uOutputStride,
+	uint_t uWidth, uint_t uHeight, const RGBAWord8_t* pInput,
+	uintptr_t uInputStride, uint_t uFlags, uint_t uThreadCount) BURGER_NOEXCEPT
+{
+	CompressImage(static_cast<Dxt1Packet_t*>(pOutput), uOutputStride, uWidth,
+		uHeight, pInput, uInputStride, uFlags, uThreadCount);
+}
+
+static void BURGER_API CompressDXT3(void* pOutput, uintptr_t uOutputStride,
+	uint_t uWidth, uint_t uHeight, const RGBAWord8_t* pInput,
+	uintptr_t uInputStride, uint_t uFlags, uint_t uThreadCount) BURGER_NOEXCEPT
+{
+	CompressImage(static_cast<Dxt3Packet_t*>(pOutput), uOutputStride, uWidth,
+		uHeight, pInput, uInputStride, uFlags, uThreadCount);
+}
+
+static void BURGER_API CompressDXT5(void* pOutput, uintptr_t uOutputStride,
+	uint_t uWidth, uint_t uHeight, const RGBAWord8_t* pInput,
+	uintptr_t uInputStride, uint_t uFlags, uint_t uThreadCount) BURGER_NOEXCEPT
+{
+	CompressImage(static_cast<Dxt5Packet_t*>(pOutput), uOutputStride, uWidth,
+		uHeight, pInput, uInputStride, uFlags, uThreadCount);
+}
+
+static void BURGER_API DecompressDXT1(RGBAWord8_t* pOutput,
+	uintptr_t uOutputStride, uint_t uWidth, uint_t uHeight, const void* pInput,
+	uintptr_t uInputStride, uint_t uFlags, uint_t uThreadCount) BURGER_NOEXCEPT
+{
+	DecompressImage(pOutput, uOutputStride, uWidth, uHeight,
+		static_cast<const Dxt1Packet_t*>(pInput), uInputStride, uFlags,
+		uThreadCount);
+}
+
+static void BURGER_API DecompressBlockDXT1(
+	RGBAWord8_t* pOutput, uintptr_t uStride, const void* pInput) BURGER_NOEXCEPT
+{
+	static_cast<const Dxt1Packet_t*>(pInput)->Decompress(pOutput, uStride);
+}
+
+static void BURGER_API DecompressDXT3(RGBAWord8_t* pOutput,
+	uintptr_t uOutputStride, uint_t uWidth, uint_t uHeight, const void* pInput,
+	uintptr_t uInputStride, uint_t uFlags, uint_t uThreadCount) BURGER_NOEXCEPT
+{
+	DecompressImage(pOutput, uOutputStride, uWidth, uHeight,
+		static_cast<const Dxt3Packet_t*>(pInput), uInputStride, uFlags,
+		uThreadCount);
+}
+
+static void BURGER_API DecompressBlockDXT3(
+	RGBAWord8_t* pOutput, uintptr_t uStride, const void* pInput) BURGER_NOEXCEPT
+{
+	static_cast<const Dxt3Packet_t*>(pInput)->Decompress(pOutput, uStride);
+}
+
+static void BURGER_API DecompressDXT5(RGBAWord8_t* pOutput,
+	uintptr_t uOutputStride, uint_t uWidth, uint_t uHeight, const void* pInput,
+	uintptr_t uInputStride, uint_t uFlags, uint_t uThreadCount) BURGER_NOEXCEPT
+{
+	DecompressImage(pOutput, uOutputStride, uWidth, uHeight,
+		static_cast<const Dxt5Packet_t*>(pInput), uInputStride, uFlags,
+		uThreadCount);
+}
+
+static void BURGER_API DecompressBlockDXT5(
+	RGBAWord8_t* pOutput, uintptr_t uStride, const void* pInput) BURGER_NOEXCEPT
+{
+	static_cast<const Dxt5Packet_t*>(pInput)->Decompress(pOutput, uStride);
+}
+
+// DXT formats with the smallest PSNR allowed for alpha
+struct DXTFormat_t {
+	const char* m_pName;
+	uintptr_t m_uPacketSize;
+	DXTCompressProc_t m_pCompress;
+	DXTDecompressProc_t m_pDecompress;
+	DXTBlockDecompressProc_t m_pBlockStride;
+	double m_dAlphaPSNR;
+};
+
+static const DXTFormat_t g_DXTFormats[] = {
+	{"DXT1", sizeof(Dxt1Packet_t), CompressDXT1, DecompressDXT1,
+		DecompressBlockDXT1, 0.0},
+	{"DXT3", sizeof(Dxt3Packet_t), CompressDXT3, DecompressDXT3,
+		DecompressBlockDXT3, 30.0},
+	{"DXT5", sizeof(Dxt5Packet_t), CompressDXT5, DecompressDXT5,
+		DecompressBlockDXT5, 30.0}};
+
+/***************************************
+
+	Fill an image with gradients and a little noise, like a photograph.
+	The alpha is an opaque gradient unless bTransparent is set.
+
+***************************************/
+
+static void BURGER_API FillGradient(RGBAWord8_t* pImage, uint_t uWidth,
+	uint_t uHeight, uint_t bTransparent) BURGER_NOEXCEPT
+{
+	uint_t uSeed = 0x4321U;
+	uint_t y = 0;
+	do {
+		uint_t x = 0;
+		do {
+			uSeed = (uSeed * 1103515245U) + 12345U;
+			const uint_t uNoise = (uSeed >> 16U) & 7U;
+			RGBAWord8_t* pPixel = &pImage[(y * uWidth) + x];
+			pPixel->m_uRed = static_cast<uint8_t>(((x * 255U) / uWidth) + uNoise);
+			pPixel->m_uGreen =
+				static_cast<uint8_t>(((y * 255U) / uHeight) + uNoise);
+			pPixel->m_uBlue = static_cast<uint8_t>(
+				(((x + y) * 127U) / (uWidth + uHeight)) + 64U + uNoise);
+			if (bTransparent) {
+				pPixel->m_uAlpha = static_cast<uint8_t>((x * 251U) / uWidth);
+			} else {
+				pPixel->m_uAlpha = 255;
+			}
+		} while (++x < uWidth);
+	} while (++y < uHeight);
+}
+
+/***************************************
+
+	Return the PSNR in decibels of the colors or the alpha of two images
+
+***************************************/
+
+static double BURGER_API GetPSNR(const RGBAWord8_t* pFirst,
+	const RGBAWord8_t* pSecond, uintptr_t uCount, uint_t bAlpha) BURGER_NOEXCEPT
+{
+	double dError = 0.0;
+	uintptr_t i = 0;
+	do {
+		if (bAlpha) {
+			const double dAlpha = static_cast<double>(pFirst[i].m_uAlpha) -
+				static_cast<double>(pSecond[i].m_uAlpha);
+			dError += dAlpha * dAlpha;
+		} else {
+			const double dRed = static_cast<double>(pFirst[i].m_uRed) -
+				static_cast<double>(pSecond[i].m_uRed);
+			const double dGreen = static_cast<double>(pFirst[i].m_uGreen) -
+				static_cast<double>(pSecond[i].m_uGreen);
+			const double dBlue = static_cast<double>(pFirst[i].m_uBlue) -
+				static_cast<double>(pSecond[i].m_uBlue);
+			dError += (dRed * dRed) + (dGreen * dGreen) + (dBlue * dBlue);
+		}
+	} while (++i < uCount);
+	if (dError == 0.0) {
+		return 99.0;
+	}
+	dError /= static_cast<double>(uCount) * (bAlpha ? 1.0 : 3.0);
+	return 10.0 * get_logarithm10((255.0 * 255.0) / dError);
+}
+
+/***************************************
+
+	Colors that R5:G6:B5 can store exactly survive a round trip
+
+***************************************/
+
+static uint_t BURGER_API TestDXTSolid(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+	static const uint8_t Colors[][4] = {{0x00, 0x00, 0x00, 0xFF},
+		{0xFF, 0xFF, 0xFF, 0x00}, {0x84, 0x41, 0x10, 0x88},
+		{0x29, 0xE3, 0xF7, 0xEE}};
+	RGBAWord8_t Input[16];
+	RGBAWord8_t Output[16];
+	uint8_t Packet[16];
+	uintptr_t uColor = 0;
+	do {
+		uint_t i = 0;
+		do {
+			Input[i].m_uRed = Colors[uColor][0];
+			Input[i].m_uGreen = Colors[uColor][1];
+			Input[i].m_uBlue = Colors[uColor][2];
+			Input[i].m_uAlpha = Colors[uColor][3];
+		} while (++i < 16);
+		uint_t uFlags = DXTCOMPRESS_RANGEFIT;
+		do {
+			uintptr_t uFormat = 0;
+			do {
+				const DXTFormat_t* pFormat = &g_DXTFormats[uFormat];
+				pFormat->m_pCompress(Packet, 0, 4, 4, Input,
+					sizeof(RGBAWord8_t) * 4, uFlags, 1);
+				pFormat->m_pDecompress(
+					Output, sizeof(RGBAWord8_t) * 4, 4, 4, Packet, 0,
+					DXTDECOMPRESS_LINEAR, 1);
+				uint_t uTest = 0;
+				i = 0;
+				do {
+					uTest |= (Output[i].m_uRed != Input[i].m_uRed) ||
+						(Output[i].m_uGreen != Input[i].m_uGreen) ||
+						(Output[i].m_uBlue != Input[i].m_uBlue);
+				} while (++i < 16);
+				// DXT1 has 1 bit of alpha, DXT3 4 bits, DXT5 is exact for
+				// a single alpha
+				uint_t uAlpha = Input[0].m_uAlpha;
+				if (!uFormat) {
+					uAlpha = (uAlpha < 128U) ? 0U : 255U;
+					// Transparent pixels are black
+					if (!uAlpha) {
+						uTest = Output[0].m_uRed || Output[0].m_uGreen ||
+							Output[0].m_uBlue;
+					}
+				} else if (uFormat == 1) {
+					uAlpha = ((uAlpha + 8U) / 17U) * 17U;
+				}
+				uTest |= Output[0].m_uAlpha != uAlpha;
+				ReportFailure("%s flags %u solid color %u failed", uTest,
+					pFormat->m_pName, uFlags, static_cast<uint_t>(uColor));
+				uFailure |= uTest;
+			} while (++uFormat < BURGER_ARRAYSIZE(g_DXTFormats));
+		} while (++uFlags <= DXTCOMPRESS_CLUSTERFIT);
+	} while (++uColor < BURGER_ARRAYSIZE(Colors));
+	return uFailure;
+}
+
+/***************************************
+
+	DXT1 keeps 1 bit alpha
+
+***************************************/
+
+static uint_t BURGER_API TestDXT1Transparent(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+	RGBAWord8_t Input[16];
+	RGBAWord8_t Output[16];
+	Dxt1Packet_t Packet;
+	uint_t uFlags = DXTCOMPRESS_RANGEFIT;
+	do {
+		uint_t i = 0;
+		do {
+			Input[i].m_uRed = static_cast<uint8_t>(i * 16);
+			Input[i].m_uGreen = static_cast<uint8_t>(255 - (i * 16));
+			Input[i].m_uBlue = 0x80;
+			Input[i].m_uAlpha = static_cast<uint8_t>((i & 5) ? 0xFF : 0x10);
+		} while (++i < 16);
+		Packet.Compress(Input, sizeof(RGBAWord8_t) * 4, uFlags);
+		Packet.Decompress(Output);
+		uint_t uTest = 0;
+		i = 0;
+		do {
+			if (Input[i].m_uAlpha < 128U) {
+				uTest |= Output[i].m_uAlpha != 0;
+			} else {
+				uTest |= Output[i].m_uAlpha != 255;
+				// 3 colors on a straight line
+				int iDelta = static_cast<int>(Output[i].m_uRed) -
+					static_cast<int>(Input[i].m_uRed);
+				uTest |= (iDelta > 64) || (iDelta < -64);
+			}
+		} while (++i < 16);
+		ReportFailure("Dxt1Packet_t::Compress() flags %u transparency failed",
+			uTest, uFlags);
+		uFailure |= uTest;
+	} while (++uFlags <= DXTCOMPRESS_CLUSTERFIT);
+	return uFailure;
+}
+
+/***************************************
+
+	Round trip an image with each format, check the quality, the edges
+	of images that aren't a multiple of 4 and that threads make no
+	difference.
+
+***************************************/
+
+static uint_t BURGER_API TestDXTRoundTrip(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+	// Sizes with the smallest color PSNR allowed, the gradients get steeper
+	// as the images get smaller
+	struct Size_t {
+		uint_t m_uWidth;
+		uint_t m_uHeight;
+		double m_dColorPSNR;
+	};
+	static const Size_t Sizes[] = {{64, 64, 34.0}, {37, 13, 28.0}, {3, 2, 12.0}};
+	RGBAWord8_t* pInput = static_cast<RGBAWord8_t*>(
+		allocate_memory(64 * 64 * sizeof(RGBAWord8_t)));
+	RGBAWord8_t* pOutput = static_cast<RGBAWord8_t*>(
+		allocate_memory(64 * 64 * sizeof(RGBAWord8_t)));
+	uint8_t* pPackets = static_cast<uint8_t*>(allocate_memory(16 * 16 * 16));
+	uint8_t* pThreaded = static_cast<uint8_t*>(allocate_memory(16 * 16 * 16));
+
+	uintptr_t uSize = 0;
+	do {
+		const uint_t uWidth = Sizes[uSize].m_uWidth;
+		const uint_t uHeight = Sizes[uSize].m_uHeight;
+		const uintptr_t uCount = static_cast<uintptr_t>(uWidth) * uHeight;
+		uintptr_t uFormat = 0;
+		do {
+			const DXTFormat_t* pFormat = &g_DXTFormats[uFormat];
+			const uintptr_t uPacketStride =
+				((uWidth + 3U) >> 2U) * pFormat->m_uPacketSize;
+			const uintptr_t uPacketBytes =
+				uPacketStride * ((uHeight + 3U) >> 2U);
+			FillGradient(pInput, uWidth, uHeight, uFormat != 0);
+			double dLastPSNR = 0.0;
+			uint_t uFlags = DXTCOMPRESS_RANGEFIT;
+			do {
+				pFormat->m_pCompress(pPackets, uPacketStride, uWidth, uHeight,
+					pInput, uWidth * sizeof(RGBAWord8_t), uFlags, 1);
+				pFormat->m_pCompress(pThreaded, uPacketStride, uWidth, uHeight,
+					pInput, uWidth * sizeof(RGBAWord8_t), uFlags, 3);
+				uint_t uTest =
+					MemoryCompare(pPackets, pThreaded, uPacketBytes) != 0;
+				ReportFailure("%s %ux%u flags %u threaded output differs",
+					uTest, pFormat->m_pName, uWidth, uHeight, uFlags);
+				uFailure |= uTest;
+
+				memory_set(pOutput, 0x55, uCount * sizeof(RGBAWord8_t));
+				pFormat->m_pDecompress(pOutput, uWidth * sizeof(RGBAWord8_t),
+					uWidth, uHeight, pPackets, uPacketStride, DXTDECOMPRESS_LINEAR,
+					1);
+				const double dColor = GetPSNR(pInput, pOutput, uCount, FALSE);
+				uTest = dColor < Sizes[uSize].m_dColorPSNR;
+				// The cluster fit never does worse unless edge pixels were
+				// repeated to fill out blocks
+				if ((uFlags == DXTCOMPRESS_CLUSTERFIT) &&
+					!((uWidth | uHeight) & 3U)) {
+					uTest |= dColor < dLastPSNR;
+				}
+				dLastPSNR = dColor;
+				ReportFailure("%s %ux%u flags %u color PSNR %g", uTest,
+					pFormat->m_pName, uWidth, uHeight, uFlags, dColor);
+				uFailure |= uTest;
+				if (uFormat) {
+					const double dAlpha =
+						GetPSNR(pInput, pOutput, uCount, TRUE);
+					uTest = dAlpha < pFormat->m_dAlphaPSNR;
+					ReportFailure("%s %ux%u flags %u alpha PSNR %g", uTest,
+						pFormat->m_pName, uWidth, uHeight, uFlags, dAlpha);
+					uFailure |= uTest;
+				}
+			} while (++uFlags <= DXTCOMPRESS_CLUSTERFIT);
+		} while (++uFormat < BURGER_ARRAYSIZE(g_DXTFormats));
+	} while (++uSize < BURGER_ARRAYSIZE(Sizes));
+
+	free_memory(pThreaded);
+	free_memory(pPackets);
+	free_memory(pOutput);
+	free_memory(pInput);
+	return uFailure;
+}
+
+/***************************************
+
+	Fill memory with random bytes so every block mode is used
+
+***************************************/
+
+static void BURGER_API FillRandom(uint8_t* pOutput, uintptr_t uLength) BURGER_NOEXCEPT
+{
+	uint_t uSeed = 0x2468U;
+	do {
+		uSeed = (uSeed * 1103515245U) + 12345U;
+		pOutput[0] = static_cast<uint8_t>(uSeed >> 16U);
+		++pOutput;
+	} while (--uLength);
+}
+
+/***************************************
+
+	The batch decompressors match the single block decompressors as a
+	bit map, as tiles and with threads
+
+***************************************/
+
+static uint_t BURGER_API TestDXTBatch(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+	static const uint_t Sizes[][2] = {{64, 64}, {37, 13}, {6, 3}};
+	uint8_t* pPackets = static_cast<uint8_t*>(allocate_memory(16 * 16 * 16));
+	RGBAWord8_t* pExpected = static_cast<RGBAWord8_t*>(
+		allocate_memory(64 * 64 * sizeof(RGBAWord8_t)));
+	RGBAWord8_t* pOutput = static_cast<RGBAWord8_t*>(
+		allocate_memory(64 * 64 * sizeof(RGBAWord8_t)));
+	FillRandom(pPackets, 16 * 16 * 16);
+
+	uintptr_t uSize = 0;
+	do {
+		const uint_t uWidth = Sizes[uSize][0];
+		const uint_t uHeight = Sizes[uSize][1];
+		const uint_t uBlocksWide = (uWidth + 3U) >> 2U;
+		const uint_t uBlocksHigh = (uHeight + 3U) >> 2U;
+		const uintptr_t uStride = uWidth * sizeof(RGBAWord8_t);
+		uintptr_t uFormat = 0;
+		do {
+			const DXTFormat_t* pFormat = &g_DXTFormats[uFormat];
+			const uintptr_t uPacketStride = uBlocksWide * pFormat->m_uPacketSize;
+
+			// Decompress one block at a time and clip by hand
+			RGBAWord8_t Block[16];
+			uint_t uY = 0;
+			do {
+				uint_t uX = 0;
+				do {
+					pFormat->m_pBlockStride(Block, sizeof(RGBAWord8_t) * 4,
+						pPackets + ((uY >> 2U) * uPacketStride) +
+							((uX >> 2U) * pFormat->m_uPacketSize));
+					uint_t i = 0;
+					do {
+						const uint_t uPixelX = uX + (i & 3U);
+						const uint_t uPixelY = uY + (i >> 2U);
+						if ((uPixelX < uWidth) && (uPixelY < uHeight)) {
+							pExpected[(uPixelY * uWidth) + uPixelX] = Block[i];
+						}
+					} while (++i < 16);
+					uX += 4;
+				} while (uX < uWidth);
+				uY += 4;
+			} while (uY < uHeight);
+
+			uint_t uThreads = 1;
+			do {
+				memory_set(pOutput, 0x55, uStride * uHeight);
+				pFormat->m_pDecompress(pOutput, uStride, uWidth, uHeight,
+					pPackets, uPacketStride, DXTDECOMPRESS_LINEAR, uThreads);
+				uint_t uTest = MemoryCompare(pExpected, pOutput, uStride * uHeight) != 0;
+				ReportFailure("%s %ux%u threads %u batch decompress failed",
+					uTest, pFormat->m_pName, uWidth, uHeight, uThreads);
+				uFailure |= uTest;
+
+				// Tiles are complete 4x4 blocks in order
+				const uintptr_t uTileStride =
+					uBlocksWide * (sizeof(RGBAWord8_t) * 16);
+				pFormat->m_pDecompress(pOutput, uTileStride, uWidth, uHeight,
+					pPackets, uPacketStride, DXTDECOMPRESS_TILED, uThreads);
+				uTest = 0;
+				uint_t uBlock = 0;
+				do {
+					pFormat->m_pBlockStride(Block, sizeof(RGBAWord8_t) * 4,
+						pPackets + ((uBlock / uBlocksWide) * uPacketStride) +
+							((uBlock % uBlocksWide) * pFormat->m_uPacketSize));
+					uTest |= MemoryCompare(
+						Block, pOutput + (uBlock * 16), sizeof(Block)) != 0;
+				} while (++uBlock < (uBlocksWide * uBlocksHigh));
+				ReportFailure("%s %ux%u threads %u tiled decompress failed",
+					uTest, pFormat->m_pName, uWidth, uHeight, uThreads);
+				uFailure |= uTest;
+			} while (++uThreads <= 3);
+		} while (++uFormat < BURGER_ARRAYSIZE(g_DXTFormats));
+	} while (++uSize < BURGER_ARRAYSIZE(Sizes));
+
+	free_memory(pOutput);
+	free_memory(pExpected);
+	free_memory(pPackets);
+	return uFailure;
+}
+
+/***************************************
+
+	Show the speed and quality of compression and the speed of
+	decompression
+
+***************************************/
+
+static void BURGER_API TimeDXT(void) BURGER_NOEXCEPT
+{
+	// The cluster fit is slow, so it uses a smaller image
+	static const uint_t Sizes[] = {1024, 256};
+	const uint_t uMaxSize = 1024;
+	RGBAWord8_t* pInput = static_cast<RGBAWord8_t*>(
+		allocate_memory(uMaxSize * uMaxSize * sizeof(RGBAWord8_t)));
+	RGBAWord8_t* pOutput = static_cast<RGBAWord8_t*>(
+		allocate_memory(uMaxSize * uMaxSize * sizeof(RGBAWord8_t)));
+	uint8_t* pPackets = static_cast<uint8_t*>(allocate_memory(uMaxSize * uMaxSize));
+	const double dScale =
+		1000.0 / static_cast<double>(Tick::get_high_precision_frequency());
+
+	uintptr_t uFormat = 0;
+	do {
+		const DXTFormat_t* pFormat = &g_DXTFormats[uFormat];
+		uint_t uFlags = DXTCOMPRESS_RANGEFIT;
+		do {
+			const uint_t uSize = Sizes[uFlags];
+			const uintptr_t uCount = static_cast<uintptr_t>(uSize) * uSize;
+			const uintptr_t uPacketStride = (uSize >> 2U) * pFormat->m_uPacketSize;
+			FillGradient(pInput, uSize, uSize, uFormat != 0);
+
+			uint64_t uMark = Tick::read_high_precision();
+			pFormat->m_pCompress(pPackets, uPacketStride, uSize, uSize, pInput,
+				uSize * sizeof(RGBAWord8_t), uFlags, 1);
+			const uint64_t uCompress = Tick::read_high_precision() - uMark;
+
+			uMark = Tick::read_high_precision();
+			pFormat->m_pCompress(pPackets, uPacketStride, uSize, uSize, pInput,
+				uSize * sizeof(RGBAWord8_t), uFlags, 4);
+			const uint64_t uThreaded = Tick::read_high_precision() - uMark;
+
+			uMark = Tick::read_high_precision();
+			pFormat->m_pDecompress(pOutput, uSize * sizeof(RGBAWord8_t), uSize,
+				uSize, pPackets, uPacketStride, DXTDECOMPRESS_LINEAR, 1);
+			const uint64_t uDecompress = Tick::read_high_precision() - uMark;
+
+			const double dColor = GetPSNR(pInput, pOutput, uCount, FALSE);
+			const double dAlpha =
+				uFormat ? GetPSNR(pInput, pOutput, uCount, TRUE) : 0.0;
+			Message("%s %s %ux%u compress %.2f ms, 4 threads %.2f ms, "
+					"decompress %.2f ms, PSNR color %.2f dB alpha %.2f dB",
+				pFormat->m_pName, uFlags ? "cluster fit" : "range fit", uSize,
+				uSize, static_cast<double>(uCompress) * dScale,
+				static_cast<double>(uThreaded) * dScale,
+				static_cast<double>(uDecompress) * dScale, dColor, dAlpha);
+		} while (++uFlags <= DXTCOMPRESS_CLUSTERFIT);
+	} while (++uFormat < BURGER_ARRAYSIZE(g_DXTFormats));
+
+	free_memory(pPackets);
+	free_memory(pOutput);
+	free_memory(pInput);
+}
+
+/***************************************
+
+	Show the speed of decompressing one block at a time against the
+	batch decompressors
+
+***************************************/
+
+static void BURGER_API TimeDXTDecompress(void) BURGER_NOEXCEPT
+{
+	const uint_t uSize = 1024;
+	const uint_t uLoops = 4;
+	uint8_t* pPackets = static_cast<uint8_t*>(allocate_memory(uSize * uSize));
+	RGBAWord8_t* pOutput = static_cast<RGBAWord8_t*>(
+		allocate_memory(uSize * uSize * sizeof(RGBAWord8_t)));
+	FillRandom(pPackets, uSize * uSize);
+	const uintptr_t uStride = uSize * sizeof(RGBAWord8_t);
+	const double dScale = 1000.0 /
+		(static_cast<double>(Tick::get_high_precision_frequency()) *
+			static_cast<double>(uLoops));
+
+	uintptr_t uFormat = 0;
+	do {
+		const DXTFormat_t* pFormat = &g_DXTFormats[uFormat];
+		const uintptr_t uPacketStride = (uSize >> 2U) * pFormat->m_uPacketSize;
+
+		uint64_t uMark = Tick::read_high_precision();
+		uint_t uLoop = 0;
+		do {
+			uint_t uY = 0;
+			do {
+				const uint8_t* pInput = pPackets + ((uY >> 2U) * uPacketStride);
+				uint_t uX = 0;
+				do {
+					pFormat->m_pBlockStride(pOutput + (uY * uSize) + uX,
+						uStride, pInput);
+					pInput += pFormat->m_uPacketSize;
+					uX += 4;
+				} while (uX < uSize);
+				uY += 4;
+			} while (uY < uSize);
+		} while (++uLoop < uLoops);
+		const uint64_t uSingle = Tick::read_high_precision() - uMark;
+
+		uMark = Tick::read_high_precision();
+		uLoop = 0;
+		do {
+			pFormat->m_pDecompress(pOutput, uStride, uSize, uSize, pPackets,
+				uPacketStride, DXTDECOMPRESS_LINEAR, 1);
+		} while (++uLoop < uLoops);
+		const uint64_t uBatch = Tick::read_high_precision() - uMark;
+
+		uMark = Tick::read_high_precision();
+		uLoop = 0;
+		do {
+			pFormat->m_pDecompress(pOutput, (uSize >> 2U) * 64, uSize, uSize,
+				pPackets, uPacketStride, DXTDECOMPRESS_TILED, 1);
+		} while (++uLoop < uLoops);
+		const uint64_t uTiled = Tick::read_high_precision() - uMark;
+
+		uMark = Tick::read_high_precision();
+		uLoop = 0;
+		do {
+			pFormat->m_pDecompress(pOutput, uStride, uSize, uSize, pPackets,
+				uPacketStride, DXTDECOMPRESS_LINEAR, 4);
+		} while (++uLoop < uLoops);
+		const uint64_t uThreaded = Tick::read_high_precision() - uMark;
+
+		Message("%s decompress 1024x1024 one block at a time %.2f ms, batch "
+				"%.2f ms, tiled %.2f ms, 4 threads %.2f ms",
+			pFormat->m_pName, static_cast<double>(uSingle) * dScale,
+			static_cast<double>(uBatch) * dScale,
+			static_cast<double>(uTiled) * dScale,
+			static_cast<double>(uThreaded) * dScale);
+	} while (++uFormat < BURGER_ARRAYSIZE(g_DXTFormats));
+
+	free_memory(pOutput);
+	free_memory(pPackets);
+}
+
+//
+// Perform all the tests for DXT compression
+//
+
+int BURGER_API TestBrdxt(uint_t uVerbose) BURGER_NOEXCEPT
+{
+	if (uVerbose & VERBOSE_MSG) {
+		Message("Running DXT tests");
+	}
+
+	uint_t uTotal = TestDXTSolid();
+	uTotal |= TestDXT1Transparent();
+	uTotal |= TestDXTRoundTrip();
+	uTotal |= TestDXTBatch();
+
+	if (!uTotal && (uVerbose & VERBOSE_TIME)) {
+		TimeDXT();
+		TimeDXTDecompress();
+	}
+
+	if (!uTotal && (uVerbose & VERBOSE_MSG)) {
+		Message("Passed all DXT tests!");
+	}
+	return static_cast<int>(uTotal);
+}
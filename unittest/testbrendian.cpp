@@ -14,7 +14,9 @@
 
 #include "testbrendian.h"
 #include "brendian.h"
+#include "brinputmemorystream.h"
 #include "brmemoryfunctions.h"
+#include "brtick.h"
 #include "common.h"
 
 #if defined(BURGER_XBOX360) && defined(NDEBUG)
@@ -4860,6 +4862,177 @@ static uint_t BURGER_API TestBurgerLittleEndianFixupAnyDoublePtr(
 	return uFailureTotal;
 }
 
+//
+// Burger::swap_endian() on arrays
+//
+
+static uint_t BURGER_API TestBurgerSwapEndianArrays(void) BURGER_NOEXCEPT
+{
+	// Odd offsets and counts exercise the vector and scalar paths
+	uint64_t Source[24];
+	uint64_t Dest[25];
+	uint_t i = 0;
+	do {
+		reinterpret_cast<uint8_t*>(Source)[i] = static_cast<uint8_t>(i + 1);
+	} while (++i < sizeof(Source));
+
+	uint_t uFailureTotal = 0;
+	uint_t uShift = 1;
+	do {
+		const uint_t uSize = 1U << uShift;
+		uintptr_t uCount = 0;
+		do {
+			const uintptr_t uBytes = uCount << uShift;
+			uint_t bInPlace = 0;
+			do {
+				Burger::memory_set(Dest, 0xEE, sizeof(Dest));
+				uint8_t* pOutput = reinterpret_cast<uint8_t*>(Dest);
+				const uint8_t* pInput = reinterpret_cast<uint8_t*>(Source);
+				if (bInPlace) {
+					Burger::memory_copy(pOutput, pInput, uBytes);
+					pInput = pOutput;
+				}
+				if (uShift == 1) {
+					Burger::swap_endian(reinterpret_cast<uint16_t*>(pOutput),
+						reinterpret_cast<const uint16_t*>(pInput), uCount);
+				} else if (uShift == 2) {
+					Burger::swap_endian(reinterpret_cast<uint32_t*>(pOutput),
+						reinterpret_cast<const uint32_t*>(pInput), uCount);
+				} else {
+					Burger::swap_endian(reinterpret_cast<uint64_t*>(pOutput),
+						reinterpret_cast<const uint64_t*>(pInput), uCount);
+				}
+
+				// Every element reversed and nothing written past the end
+				const uint8_t* pSource = reinterpret_cast<uint8_t*>(Source);
+				uint_t uFailure = pOutput[uBytes] != 0xEE;
+				uintptr_t j = 0;
+				while (j < uBytes) {
+					const uintptr_t uOffset = j & (uSize - 1);
+					uFailure |= pOutput[j] !=
+						pSource[(j - uOffset) + (uSize - 1) - uOffset];
+					++j;
+				}
+				uFailureTotal |= uFailure;
+				ReportFailure(
+					"Burger::swap_endian(uint%u_t *, %u) in place = %u failed",
+					uFailure, uSize * 8, static_cast<uint_t>(uCount),
+					bInPlace);
+			} while (++bInPlace < 2);
+		} while (++uCount <= (sizeof(Source) >> uShift));
+	} while (++uShift < 4);
+	return uFailureTotal;
+}
+
+//
+// Burger::InputMemoryStream array readers
+//
+
+static uint_t BURGER_API TestInputMemoryStreamArrays(void) BURGER_NOEXCEPT
+{
+	static const uint8_t g_Data[21] = {0x00, 0x12, 0x34, 0x56, 0x78, 0x9A,
+		0xBC, 0xDE, 0xF0, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+		0x3F, 0x80, 0x00, 0x00};
+
+	// Unaligned big endian read after the first byte
+	Burger::InputMemoryStream Input(g_Data, sizeof(g_Data), TRUE);
+	uint32_t Word32[3];
+	Input.GetByte();
+	uint_t uFailure = (Input.GetBigWord32Array(Word32, 3) != 3) ||
+		(Word32[0] != 0x12345678U) || (Word32[1] != 0x9ABCDEF0U) ||
+		(Word32[2] != 0x01020304U);
+
+	uint16_t Word16[3];
+	uFailure |= (Input.GetShortArray(Word16, 2) != 2) ||
+		(Word16[0] != 0x0605U) || (Word16[1] != 0x0807U);
+	float fValue = 0.0f;
+	uFailure |= (Input.GetBigFloatArray(&fValue, 1) != 1) || (fValue != 1.0f);
+
+	// Short read zero fills and empties the stream
+	Input.SetMark(18);
+	uFailure |= (Input.GetBigShortArray(Word16, 3) != 1) ||
+		(Word16[0] != 0x8000U) || Word16[1] || Word16[2] || !Input.IsEmpty();
+
+	// Aligned little endian read
+	Input.SetMark(1);
+	uint64_t Word64 = 0;
+	uFailure |= (Input.GetWord64Array(&Word64, 1) != 1) ||
+		(Word64 != 0xF0DEBC9A78563412ULL) ||
+		(Input.GetMark() != 9);
+	ReportFailure("Burger::InputMemoryStream::Get*Array() failed", uFailure);
+	return uFailure;
+}
+
+//
+// Time swap_endian() and the array readers
+//
+
+static void BURGER_API TimeSwapEndianArrays(void) BURGER_NOEXCEPT
+{
+	const uint_t uLoops = 2000;
+	const uintptr_t uCount = 4096;
+	uint32_t Buffer[4096];
+	uintptr_t i = 0;
+	do {
+		Buffer[i] = static_cast<uint32_t>(i);
+	} while (++i < uCount);
+
+	// One element at a time
+	uint64_t uMark = Burger::Tick::read_high_precision();
+	uint_t uLoop = 0;
+	do {
+		uint32_t* pWork = Buffer;
+		i = uCount;
+		do {
+			Burger::SwapEndian::fixup(pWork);
+			++pWork;
+		} while (--i);
+	} while (++uLoop < uLoops);
+	const uint64_t uScalar = Burger::Tick::read_high_precision() - uMark;
+
+	uMark = Burger::Tick::read_high_precision();
+	uLoop = 0;
+	do {
+		Burger::swap_endian(Buffer, uCount);
+	} while (++uLoop < uLoops);
+	const uint64_t uArray = Burger::Tick::read_high_precision() - uMark;
+
+	// Stream readers, one call per value versus one call per array
+	uint32_t Output[4096];
+	Burger::InputMemoryStream Input(Buffer, sizeof(Buffer), TRUE);
+	uint32_t uSum = 0;
+	uMark = Burger::Tick::read_high_precision();
+	uLoop = 0;
+	do {
+		Input.SetMark(0);
+		i = 0;
+		do {
+			Output[i] = Input.GetBigWord32();
+		} while (++i < uCount);
+		uSum += Output[uLoop & 4095];
+	} while (++uLoop < uLoops);
+	const uint64_t uSingle = Burger::Tick::read_high_precision() - uMark;
+
+	uMark = Burger::Tick::read_high_precision();
+	uLoop = 0;
+	do {
+		Input.SetMark(0);
+		Input.GetBigWord32Array(Output, uCount);
+		uSum += Output[uLoop & 4095];
+	} while (++uLoop < uLoops);
+	const uint64_t uBulk = Burger::Tick::read_high_precision() - uMark;
+
+	const double dScale = 1000000000.0 /
+		(static_cast<double>(Burger::Tick::get_high_precision_frequency()) *
+			static_cast<double>(uLoops));
+	Message("swap_endian() 4096 uint32_t, fixup() loop %.1f ns, array %.1f "
+			"ns, GetBigWord32() loop %.1f ns, GetBigWord32Array() %.1f ns (%u)",
+		static_cast<double>(uScalar) * dScale,
+		static_cast<double>(uArray) * dScale,
+		static_cast<double>(uSingle) * dScale,
+		static_cast<double>(uBulk) * dScale, static_cast<uint_t>(uSum));
+}
+
 //
 // Perform all the tests for the Burgerlib Endian Manager
 //
@@ -5107,6 +5280,14 @@ int BURGER_API TestBrendian(uint_t uVerbose) BURGER_NOEXCEPT
 	uTotal |= TestBurgerLittleEndianFixupAnyFloatPtr();
 	uTotal |= TestBurgerLittleEndianFixupAnyDoublePtr();
 
+	// swap_endian() arrays and the stream array readers
+	uTotal |= TestBurgerSwapEndianArrays();
+	uTotal |= TestInputMemoryStreamArrays();
+
+	if (!uTotal && (uVerbose & VERBOSE_TIME)) {
+		TimeSwapEndianArrays();
+	}
+
 	if (!uTotal && (uVerbose & VERBOSE_MSG)) {
 		Message("Passed all Endian tests!");
 	}
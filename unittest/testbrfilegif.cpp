@@ -0,0 +1,625 @@
+/***************************************
+
+	Unit tests for the GIF file loader
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#include "testbrfilegif.h"
+#include "brfilegif.h"
+#include "brglobalmemorymanager.h"
+#include "brmemoryfunctions.h"
+#include "brtick.h"
+#include "common.h"
+
+using namespace Burger;
+
+//
+// Fill an 8 bit image with runs, gradients and noise so the LZW dictionary
+// gets strings of many lengths
+//
+
+static void BURGER_API FillIndexed(uint8_t* pOutput, uintptr_t uStride,
+	uint_t uWidth, uint_t uHeight, uint_t uColors) BURGER_NOEXCEPT
+{
+	uint32_t uSeed = uWidth * 7919U + uHeight * 104729U + uColors;
+	uint_t uY = 0;
+	do {
+		uint_t uX = 0;
+		do {
+			uSeed = uSeed * 1664525U + 1013904223U;
+			uint_t uValue = ((uX / 5U) + (uY / 3U)) + ((uSeed >> 29U) & 1U);
+			pOutput[uX] = static_cast<uint8_t>(uValue % uColors);
+		} while (++uX < uWidth);
+		pOutput += uStride;
+	} while (++uY < uHeight);
+}
+
+//
+// Make a palette where every entry is a different color
+//
+
+static void BURGER_API FillTestPalette(
+	RGBWord8_t* pOutput, uint_t uSeed) BURGER_NOEXCEPT
+{
+	uint_t i = 0;
+	do {
+		pOutput[i].m_uRed = static_cast<uint8_t>(i);
+		pOutput[i].m_uGreen = static_cast<uint8_t>((i * 7U) + uSeed);
+		pOutput[i].m_uBlue = static_cast<uint8_t>(255U - i);
+	} while (++i < 256);
+}
+
+//
+// Write a GIF89a header with a global palette of 2^uDepth colors
+//
+
+static void BURGER_API AppendHeader(OutputMemoryStream* pOutput, uint_t uWidth,
+	uint_t uHeight, uint_t uDepth, const RGBWord8_t* pPalette) BURGER_NOEXCEPT
+{
+	pOutput->Append("GIF89a");
+	pOutput->Append(static_cast<uint16_t>(uWidth));
+	pOutput->Append(static_cast<uint16_t>(uHeight));
+	pOutput->Append(static_cast<uint8_t>(0xF0U + (uDepth - 1U)));
+	pOutput->Append(static_cast<uint8_t>(0));
+	pOutput->Append(static_cast<uint8_t>(0));
+	uint_t i = 0;
+	do {
+		pOutput->Append(&pPalette[i]);
+	} while (++i < (1U << uDepth));
+}
+
+//
+// Write a graphic control extension
+//
+
+static void BURGER_API AppendControl(OutputMemoryStream* pOutput,
+	uint_t uDisposal, uint_t uDelay, uint_t bTransparent,
+	uint_t uTransparentIndex) BURGER_NOEXCEPT
+{
+	pOutput->Append('!');
+	pOutput->Append(static_cast<uint8_t>(0xF9));
+	pOutput->Append(static_cast<uint8_t>(4));
+	pOutput->Append(static_cast<uint8_t>((uDisposal << 2U) | (bTransparent ? 1U : 0U)));
+	pOutput->Append(static_cast<uint16_t>(uDelay));
+	pOutput->Append(static_cast<uint8_t>(uTransparentIndex));
+	pOutput->Append(static_cast<uint8_t>(0));
+}
+
+//
+// Write an image descriptor, optional local palette and the LZW pixels
+//
+
+static void BURGER_API AppendFrame(OutputMemoryStream* pOutput,
+	const uint8_t* pPixels, uint_t uLeft, uint_t uTop, uint_t uWidth,
+	uint_t uHeight, uint_t uDepth, const RGBWord8_t* pLocalPalette,
+	uint_t bInterlaced) BURGER_NOEXCEPT
+{
+	pOutput->Append(',');
+	pOutput->Append(static_cast<uint16_t>(uLeft));
+	pOutput->Append(static_cast<uint16_t>(uTop));
+	pOutput->Append(static_cast<uint16_t>(uWidth));
+	pOutput->Append(static_cast<uint16_t>(uHeight));
+	uint_t uFlags = bInterlaced ? 0x40U : 0U;
+	if (pLocalPalette) {
+		uFlags |= 0x80U + (uDepth - 1U);
+	}
+	pOutput->Append(static_cast<uint8_t>(uFlags));
+	if (pLocalPalette) {
+		uint_t i = 0;
+		do {
+			pOutput->Append(&pLocalPalette[i]);
+		} while (++i < (1U << uDepth));
+	}
+
+	GIFEncoder* pEncoder = GIFEncoder::new_object();
+	pEncoder->Init(pOutput, uDepth);
+	if (!bInterlaced) {
+		pEncoder->WritePixels(pPixels, uWidth * uHeight);
+	} else {
+		static const uint_t Starts[4] = {0, 4, 2, 1};
+		static const uint_t Steps[4] = {8, 8, 4, 2};
+		uint_t uPass = 0;
+		do {
+			uint_t uY = Starts[uPass];
+			while (uY < uHeight) {
+				pEncoder->WritePixels(pPixels + (uY * uWidth), uWidth);
+				uY += Steps[uPass];
+			}
+		} while (++uPass < 4);
+	}
+	pEncoder->Flush();
+	delete_object(pEncoder);
+}
+
+//
+// Compare an 8 bit image with the source pixels
+//
+
+static uint_t BURGER_API CompareIndexed(const Image* pImage,
+	const uint8_t* pSource, uint_t uWidth, uint_t uHeight) BURGER_NOEXCEPT
+{
+	if ((pImage->GetWidth() != uWidth) || (pImage->GetHeight() != uHeight) ||
+		(pImage->GetType() != Image::PIXELTYPE8BIT)) {
+		return TRUE;
+	}
+	uint_t uY = 0;
+	do {
+		if (MemoryCompare(pImage->GetImage() + (uY * pImage->GetStride()),
+				pSource + (uY * uWidth), uWidth)) {
+			return TRUE;
+		}
+	} while (++uY < uHeight);
+	return FALSE;
+}
+
+//
+// Save images with FileGIF and load them back
+//
+
+static uint_t BURGER_API TestGIFRoundTrip(void) BURGER_NOEXCEPT
+{
+	struct Size_t {
+		uint_t m_uWidth;
+		uint_t m_uHeight;
+	};
+	static const Size_t Sizes[] = {{1, 1}, {7, 3}, {64, 48}, {300, 200}};
+	static const uint_t ColorCounts[] = {2, 16, 256};
+
+	uint_t uFailure = FALSE;
+	uintptr_t uSize = 0;
+	do {
+		const uint_t uWidth = Sizes[uSize].m_uWidth;
+		const uint_t uHeight = Sizes[uSize].m_uHeight;
+		uintptr_t uColors = 0;
+		do {
+			uint8_t* pSource =
+				static_cast<uint8_t*>(allocate_memory(uWidth * uHeight));
+			FillIndexed(
+				pSource, uWidth, uWidth, uHeight, ColorCounts[uColors]);
+			Image Source;
+			Source.Init(uWidth, uHeight, Image::PIXELTYPE8BIT);
+			uint_t uY = 0;
+			do {
+				memory_copy(Source.GetImage() + (uY * Source.GetStride()),
+					pSource + (uY * uWidth), uWidth);
+			} while (++uY < uHeight);
+
+			FileGIF Saver;
+			OutputMemoryStream Output;
+			uint_t uTest = Saver.Save(&Output, &Source);
+			if (!uTest) {
+				uintptr_t uLength;
+				void* pFile = Output.Flatten(&uLength);
+				InputMemoryStream Input(pFile, uLength, TRUE);
+				FileGIF Loader;
+				Image MyImage;
+				uTest = Loader.Load(&MyImage, &Input);
+				if (!uTest) {
+					uTest = CompareIndexed(&MyImage, pSource, uWidth, uHeight);
+				}
+				free_memory(pFile);
+			}
+			uFailure |= uTest;
+			ReportFailure("FileGIF::Save()/Load() %ux%u %u colors", uTest,
+				uWidth, uHeight, ColorCounts[uColors]);
+			free_memory(pSource);
+		} while (++uColors < BURGER_ARRAYSIZE(ColorCounts));
+	} while (++uSize < BURGER_ARRAYSIZE(Sizes));
+	return uFailure;
+}
+
+//
+// Decode every LZW code size, progressive and interlaced
+//
+
+static uint_t BURGER_API TestGIFCodeSizes(void) BURGER_NOEXCEPT
+{
+	const uint_t uWidth = 37;
+	const uint_t uHeight = 29;
+	uint8_t Source[uWidth * uHeight];
+	RGBWord8_t Palette[256];
+	FillTestPalette(Palette, 0);
+
+	uint_t uFailure = FALSE;
+	uint_t uDepth = 2;
+	do {
+		FillIndexed(Source, uWidth, uWidth, uHeight, 1U << uDepth);
+		uint_t bInterlaced = 0;
+		do {
+			OutputMemoryStream Output;
+			AppendHeader(&Output, uWidth, uHeight, uDepth, Palette);
+			AppendFrame(&Output, Source, 0, 0, uWidth, uHeight, uDepth, NULL,
+				bInterlaced);
+			Output.Append(';');
+			uintptr_t uLength;
+			void* pFile = Output.Flatten(&uLength);
+			InputMemoryStream Input(pFile, uLength, TRUE);
+			FileGIF Loader;
+			Image MyImage;
+			uint_t uTest = Loader.Load(&MyImage, &Input);
+			if (!uTest) {
+				uTest = CompareIndexed(&MyImage, Source, uWidth, uHeight);
+			}
+			free_memory(pFile);
+			uFailure |= uTest;
+			ReportFailure("FileGIF::Load() code size %u %s", uTest, uDepth,
+				bInterlaced ? "interlaced" : "progressive");
+		} while (++bInterlaced < 2);
+	} while (++uDepth <= 8);
+	return uFailure;
+}
+
+//
+// A logical screen with no width or height is rejected before any image is
+// created
+//
+
+static uint_t BURGER_API TestGIFEmptyScreen(void) BURGER_NOEXCEPT
+{
+	uint8_t Source[4 * 4];
+	RGBWord8_t Palette[256];
+	FillTestPalette(Palette, 0);
+	FillIndexed(Source, 4, 4, 4, 4);
+
+	uint_t uFailure = FALSE;
+	uint_t i = 0;
+	do {
+		OutputMemoryStream Output;
+		AppendHeader(&Output, (i & 1U) ? 8U : 0U, (i & 2U) ? 8U : 0U, 2,
+			Palette);
+		AppendFrame(&Output, Source, 0, 0, 4, 4, 2, NULL, FALSE);
+		Output.Append(';');
+		uintptr_t uLength;
+		void* pFile = Output.Flatten(&uLength);
+		InputMemoryStream Input(pFile, uLength, TRUE);
+		FileGIF Loader;
+		Image MyImage;
+		uint_t uTest = !Loader.Load(&MyImage, &Input);
+		Input.SetMark(0);
+		uTest |= !Loader.AnimationLoadStart(&Input);
+		free_memory(pFile);
+		uFailure |= uTest;
+		ReportFailure("FileGIF::Load() accepted a %ux%u logical screen", uTest,
+			(i & 1U) ? 8U : 0U, (i & 2U) ? 8U : 0U);
+	} while (++i < 3);
+	return uFailure;
+}
+
+//
+// Some encoders keep using a full dictionary instead of sending a clear
+// code. Encode that way and make sure the decoder follows along.
+//
+
+static uint_t BURGER_API TestGIFDeferredClear(void) BURGER_NOEXCEPT
+{
+	const uint_t uWidth = 160;
+	const uint_t uHeight = 120;
+	const uintptr_t uPixels = uWidth * uHeight;
+	uint8_t* pSource = static_cast<uint8_t*>(allocate_memory(uPixels));
+	uint32_t uSeed = 99;
+	uintptr_t i = 0;
+	do {
+		uSeed = uSeed * 1664525U + 1013904223U;
+		pSource[i] = static_cast<uint8_t>(uSeed >> 28U);
+	} while (++i < uPixels);
+
+	// Dictionary of child codes, zero for none
+	uint16_t* pChildren =
+		static_cast<uint16_t*>(allocate_memory(4096 * 256 * sizeof(uint16_t)));
+	memory_clear(pChildren, 4096 * 256 * sizeof(uint16_t));
+	uint8_t* pPacked = static_cast<uint8_t*>(allocate_memory(uPixels * 2));
+	uintptr_t uPackedLength = 0;
+	uint32_t uBits = 0;
+	uint_t uBitCount = 0;
+	uint_t uCodeSize = 9;
+	uint_t uNextCode = 258;
+
+	// Clear code, pixels and the end code
+	uBits = 256;
+	uBitCount = 9;
+	uint_t uCode = pSource[0];
+	i = 1;
+	for (;;) {
+		const uint_t bDone = (i == uPixels);
+		uint_t uChild = 0;
+		if (!bDone) {
+			uChild = pChildren[(uCode * 256) + pSource[i]];
+			if (uChild) {
+				uCode = uChild;
+				++i;
+				continue;
+			}
+		}
+		uBits |= uCode << uBitCount;
+		uBitCount += uCodeSize;
+		while (uBitCount >= 8) {
+			pPacked[uPackedLength++] = static_cast<uint8_t>(uBits);
+			uBits >>= 8U;
+			uBitCount -= 8;
+		}
+		if (bDone) {
+			break;
+		}
+		if (uNextCode < 4096) {
+			pChildren[(uCode * 256) + pSource[i]] =
+				static_cast<uint16_t>(uNextCode);
+			if ((uNextCode == (1U << uCodeSize)) && (uCodeSize < 12)) {
+				++uCodeSize;
+			}
+			++uNextCode;
+		}
+		uCode = pSource[i];
+		++i;
+	}
+	uBits |= 257U << uBitCount;
+	uBitCount += uCodeSize;
+	while (uBitCount) {
+		pPacked[uPackedLength++] = static_cast<uint8_t>(uBits);
+		uBits >>= 8U;
+		uBitCount = (uBitCount > 8) ? uBitCount - 8 : 0;
+	}
+
+	RGBWord8_t Palette[256];
+	FillTestPalette(Palette, 1);
+	OutputMemoryStream Output;
+	AppendHeader(&Output, uWidth, uHeight, 8, Palette);
+	Output.Append(',');
+	Output.Append(static_cast<uint32_t>(0));
+	Output.Append(static_cast<uint16_t>(uWidth));
+	Output.Append(static_cast<uint16_t>(uHeight));
+	Output.Append(static_cast<uint8_t>(0));
+	Output.Append(static_cast<uint8_t>(8));
+	i = 0;
+	do {
+		uintptr_t uChunk = uPackedLength - i;
+		if (uChunk > 255) {
+			uChunk = 255;
+		}
+		Output.Append(static_cast<uint8_t>(uChunk));
+		Output.Append(pPacked + i, uChunk);
+		i += uChunk;
+	} while (i < uPackedLength);
+	Output.Append(static_cast<uint8_t>(0));
+	Output.Append(';');
+
+	uintptr_t uLength;
+	void* pFile = Output.Flatten(&uLength);
+	InputMemoryStream Input(pFile, uLength, TRUE);
+	FileGIF Loader;
+	Image MyImage;
+	uint_t uTest = (uNextCode != 4096) || Loader.Load(&MyImage, &Input);
+	if (!uTest) {
+		uTest = CompareIndexed(&MyImage, pSource, uWidth, uHeight);
+	}
+	ReportFailure("FileGIF::Load() without a clear code when full", uTest);
+	free_memory(pFile);
+	free_memory(pPacked);
+	free_memory(pChildren);
+	free_memory(pSource);
+	return uTest;
+}
+
+//
+// Draw a frame on an RGBA reference canvas
+//
+
+static void BURGER_API DrawFrame(RGBAWord8_t* pCanvas, uint_t uCanvasWidth,
+	const uint8_t* pPixels, uint_t uLeft, uint_t uTop, uint_t uWidth,
+	uint_t uHeight, const RGBWord8_t* pPalette, uint_t bTransparent,
+	uint_t uTransparentIndex) BURGER_NOEXCEPT
+{
+	uint_t uY = 0;
+	do {
+		uint_t uX = 0;
+		do {
+			const uint_t uIndex = pPixels[(uY * uWidth) + uX];
+			if (!bTransparent || (uIndex != uTransparentIndex)) {
+				RGBAWord8_t* pWork =
+					&pCanvas[((uTop + uY) * uCanvasWidth) + uLeft + uX];
+				pWork->m_uRed = pPalette[uIndex].m_uRed;
+				pWork->m_uGreen = pPalette[uIndex].m_uGreen;
+				pWork->m_uBlue = pPalette[uIndex].m_uBlue;
+				pWork->m_uAlpha = 255;
+			}
+		} while (++uX < uWidth);
+	} while (++uY < uHeight);
+}
+
+//
+// Decode an animation one frame at a time with every disposal method
+//
+
+static uint_t BURGER_API TestGIFAnimation(void) BURGER_NOEXCEPT
+{
+	const uint_t uCanvasWidth = 24;
+	const uint_t uCanvasHeight = 18;
+
+	struct Frame_t {
+		uint_t m_uLeft;
+		uint_t m_uTop;
+		uint_t m_uWidth;
+		uint_t m_uHeight;
+		uint_t m_uDisposal;
+		uint_t m_bTransparent;
+		uint_t m_bLocalPalette;
+		uint_t m_bInterlaced;
+	};
+	static const Frame_t Frames[] = {{0, 0, 20, 18, FileGIF::DISPOSE_KEEP, 0, 0, 0},
+		{2, 3, 9, 7, FileGIF::DISPOSE_PREVIOUS, 1, 1, 0},
+		{12, 1, 10, 13, FileGIF::DISPOSE_BACKGROUND, 1, 0, 1},
+		{5, 5, 8, 8, FileGIF::DISPOSE_PREVIOUS, 0, 1, 1},
+		{0, 10, 24, 8, FileGIF::DISPOSE_NONE, 1, 0, 0}};
+	const uint_t uTransparentIndex = 3;
+
+	RGBWord8_t GlobalPalette[256];
+	RGBWord8_t LocalPalette[256];
+	FillTestPalette(GlobalPalette, 0);
+	FillTestPalette(LocalPalette, 100);
+	uint8_t Pixels[BURGER_ARRAYSIZE(Frames)][uCanvasWidth * uCanvasHeight];
+
+	// Create the animation
+	OutputMemoryStream Output;
+	AppendHeader(&Output, uCanvasWidth, uCanvasHeight, 4, GlobalPalette);
+	uintptr_t uFrame = 0;
+	do {
+		const Frame_t* pFrame = &Frames[uFrame];
+		FillIndexed(Pixels[uFrame], pFrame->m_uWidth, pFrame->m_uWidth,
+			pFrame->m_uHeight, 16);
+		AppendControl(&Output, pFrame->m_uDisposal,
+			static_cast<uint_t>(uFrame * 10), pFrame->m_bTransparent,
+			uTransparentIndex);
+		AppendFrame(&Output, Pixels[uFrame], pFrame->m_uLeft, pFrame->m_uTop,
+			pFrame->m_uWidth, pFrame->m_uHeight, 4,
+			pFrame->m_bLocalPalette ? LocalPalette : NULL,
+			pFrame->m_bInterlaced);
+	} while (++uFrame < BURGER_ARRAYSIZE(Frames));
+	Output.Append(';');
+
+	uintptr_t uLength;
+	void* pFile = Output.Flatten(&uLength);
+	InputMemoryStream Input(pFile, uLength, TRUE);
+	FileGIF Loader;
+	Image Canvas;
+	uint_t uFailure = Loader.AnimationLoadStart(&Input);
+
+	// Reference canvas and the pixels saved for DISPOSE_PREVIOUS
+	RGBAWord8_t Expected[uCanvasWidth * uCanvasHeight];
+	RGBAWord8_t Saved[uCanvasWidth * uCanvasHeight];
+	memory_clear(Expected, sizeof(Expected));
+	const Frame_t* pPrevious = NULL;
+	uFrame = 0;
+	while (!uFailure && (uFrame < BURGER_ARRAYSIZE(Frames))) {
+		const Frame_t* pFrame = &Frames[uFrame];
+		if (pPrevious) {
+			uint_t uY = 0;
+			do {
+				uint_t uX = 0;
+				do {
+					const uintptr_t uIndex =
+						((pPrevious->m_uTop + uY) * uCanvasWidth) +
+						pPrevious->m_uLeft + uX;
+					if (pPrevious->m_uDisposal == FileGIF::DISPOSE_BACKGROUND) {
+						memory_clear(&Expected[uIndex], sizeof(RGBAWord8_t));
+					} else if (pPrevious->m_uDisposal ==
+						FileGIF::DISPOSE_PREVIOUS) {
+						Expected[uIndex] = Saved[uIndex];
+					}
+				} while (++uX < pPrevious->m_uWidth);
+			} while (++uY < pPrevious->m_uHeight);
+		}
+		memory_copy(Saved, Expected, sizeof(Saved));
+		DrawFrame(Expected, uCanvasWidth, Pixels[uFrame], pFrame->m_uLeft,
+			pFrame->m_uTop, pFrame->m_uWidth, pFrame->m_uHeight,
+			pFrame->m_bLocalPalette ? LocalPalette : GlobalPalette,
+			pFrame->m_bTransparent, uTransparentIndex);
+		pPrevious = pFrame;
+
+		uint_t uTest = Loader.AnimationLoadFrame(&Canvas, &Input);
+		if (!uTest) {
+			uTest = (Canvas.GetWidth() != uCanvasWidth) ||
+				(Canvas.GetHeight() != uCanvasHeight) ||
+				(Loader.GetFrameDelay() != (uFrame * 10)) ||
+				(Loader.GetDisposalMethod() != pFrame->m_uDisposal) ||
+				(Loader.GetFrameIndex() != (uFrame + 1));
+			uint_t uY = 0;
+			do {
+				uTest |= MemoryCompare(
+					Canvas.GetImage() + (uY * Canvas.GetStride()),
+					&Expected[uY * uCanvasWidth],
+					uCanvasWidth * sizeof(RGBAWord8_t)) != 0;
+			} while (++uY < uCanvasHeight);
+		}
+		uFailure |= uTest;
+		ReportFailure("FileGIF::AnimationLoadFrame() frame %u", uTest,
+			static_cast<uint_t>(uFrame));
+		++uFrame;
+	}
+	if (!uFailure) {
+		// The terminator ends the animation, every time
+		uint_t uTest = (Loader.AnimationLoadFrame(&Canvas, &Input) != 1) ||
+			(Loader.AnimationLoadFrame(&Canvas, &Input) != 1);
+		uFailure |= uTest;
+		ReportFailure("FileGIF::AnimationLoadFrame() end of animation", uTest);
+	}
+	free_memory(pFile);
+	return uFailure;
+}
+
+//
+// Time encoding and decoding a large image
+//
+
+static void BURGER_API TimeGIF(void) BURGER_NOEXCEPT
+{
+	const uint_t uSize = 1024;
+	const uint_t uLoops = 4;
+	Image Source;
+	Source.Init(uSize, uSize, Image::PIXELTYPE8BIT);
+	FillIndexed(Source.GetImage(), Source.GetStride(), uSize, uSize, 256);
+	const double dScale = 1000.0 /
+		(static_cast<double>(Tick::get_high_precision_frequency()) *
+			static_cast<double>(uLoops));
+
+	FileGIF Saver;
+	uintptr_t uLength = 0;
+	uint8_t* pFile = NULL;
+	uint64_t uMark = Tick::read_high_precision();
+	uint_t uLoop = 0;
+	do {
+		OutputMemoryStream Output;
+		Saver.Save(&Output, &Source);
+		if ((uLoop + 1) == uLoops) {
+			pFile = static_cast<uint8_t*>(Output.Flatten(&uLength));
+		}
+	} while (++uLoop < uLoops);
+	const uint64_t uSave = Tick::read_high_precision() - uMark;
+
+	Image MyImage;
+	FileGIF Loader;
+	uMark = Tick::read_high_precision();
+	uLoop = 0;
+	do {
+		InputMemoryStream Input(pFile, uLength, TRUE);
+		Loader.Load(&MyImage, &Input);
+	} while (++uLoop < uLoops);
+	const uint64_t uLoad = Tick::read_high_precision() - uMark;
+
+	Message("GIF %ux%u save %.2f ms, load %.2f ms, %u bytes", uSize, uSize,
+		static_cast<double>(uSave) * dScale,
+		static_cast<double>(uLoad) * dScale, static_cast<uint_t>(uLength));
+	free_memory(pFile);
+}
+
+//
+// Perform all the tests for the GIF loader and saver
+//
+
+int BURGER_API TestBrfilegif(uint_t uVerbose) BURGER_NOEXCEPT
+{
+	if (uVerbose & VERBOSE_MSG) {
+		Message("Running GIF tests");
+	}
+
+	uint_t uTotal = TestGIFRoundTrip();
+	uTotal |= TestGIFCodeSizes();
+	uTotal |= TestGIFEmptyScreen();
+	uTotal |= TestGIFDeferredClear();
+	uTotal |= TestGIFAnimation();
+
+	if (!uTotal && (uVerbose & VERBOSE_TIME)) {
+		TimeGIF();
+	}
+
+	if (!uTotal && (uVerbose & VERBOSE_MSG)) {
+		Message("Passed all GIF tests!");
+	}
+	return static_cast<int>(uTotal);
+}
@@ -0,0 +1,403 @@
+/***************************************
+
+	Unit tests for FileINI
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#include "testbrfileini.h"
+#include "brasciito.h"
+#include "brfileini.h"
+#include "brglobalmemorymanager.h"
+#include "brinputmemorystream.h"
+#include "brnumberto.h"
+#include "broutputmemorystream.h"
+#include "brstring.h"
+#include "brstringatom.h"
+#include "brstringfunctions.h"
+#include "brtick.h"
+#include "common.h"
+
+/***************************************
+
+	Test the FileINI hash indexes and cached values
+
+***************************************/
+
+static const char g_INIText[] =
+	"# Settings\n"
+	"Version = 3\n"
+	"[Video]\n"
+	"Width = 640\n"
+	"height = 480\n"
+	"Width = 800\n"
+	"Scale = 1.5\n"
+	"Name = \"Main \"\"Window\"\"\"\n"
+	"Fullscreen = yes\n"
+	"; trailing comment\n"
+	"[VIDEO]\n"
+	"Width = 1024\n";
+
+static uint_t BURGER_API TestFileINIIndex(void) BURGER_NOEXCEPT
+{
+	Burger::InputMemoryStream Input(
+		g_INIText, sizeof(g_INIText) - 1, TRUE);
+	Burger::FileINI* pINI = Burger::FileINI::new_object(&Input);
+
+	// Duplicates resolve to the first one, like a linear search
+	Burger::FileINI::Section* pVideo = pINI->FindSection("video");
+	Burger::FileINI::Section* pNameless = pINI->FindSection("");
+	uint_t uFailure = !pVideo || !pNameless ||
+		(pINI->FindSection(Burger::StringAtom("Video")) != pVideo) ||
+		Burger::string_compare(pVideo->GetName(), "Video") ||
+		(pVideo->GetWord("WIDTH", 0) != 640) ||
+		(pVideo->FindEntry("HEIGHT") !=
+			pVideo->FindEntry(Burger::StringAtom("Height"))) ||
+		(pNameless->GetInt("version", 0) != 3) ||
+		pINI->FindSection("Audio") || pVideo->FindEntry("Depth");
+	ReportFailure("FileINI index lookup failed", uFailure);
+
+	// Removing or renaming the first duplicate exposes the next one
+	uint_t uTest = TRUE;
+	if (!uFailure) {
+		pVideo->FindEntry("Width")->SetKey("OldWidth");
+		uTest = (pVideo->GetWord("width", 0) != 800) ||
+			(pVideo->GetWord("oldwidth", 0) != 640);
+		Burger::FileINI::Entry* pEntry = pVideo->FindEntry("Width");
+		Burger::delete_object(pEntry);
+		uTest |= pVideo->FindEntry("WIDTH") != nullptr;
+		pVideo->FindEntry("OldWidth")->SetKey("Width");
+		uTest |= pVideo->GetWord("width", 0) != 640;
+
+		// The first section takes the name back from the second
+		pINI->DeleteSection("video");
+		Burger::FileINI::Section* pSecond = pINI->FindSection("Video");
+		uTest |= !pSecond || (pSecond->GetWord("width", 0) != 1024);
+		if (pSecond) {
+			pSecond->SetName("Screen");
+			uTest |= pINI->FindSection("video") ||
+				(pINI->FindSection(Burger::StringAtom("SCREEN")) != pSecond);
+		}
+	}
+	uFailure |= uTest;
+	ReportFailure("FileINI index update failed", uTest);
+	Burger::delete_object(pINI);
+
+	// Save keeps the original order and new entries go before comments
+	Burger::InputMemoryStream Input2(
+		g_INIText, sizeof(g_INIText) - 1, TRUE);
+	pINI = Burger::FileINI::new_object(&Input2);
+	pVideo = pINI->FindSection("Video");
+	uTest = TRUE;
+	if (pVideo) {
+		pVideo->SetWord("Depth", 32);
+		Burger::OutputMemoryStream Output;
+		Burger::String Text;
+		pINI->Save(&Output);
+		Output.Save(&Text);
+		uTest = Burger::string_compare(Text.c_str(),
+			"# Settings\nVersion = 3\n[Video]\nWidth = 640\nheight = 480\n"
+			"Width = 800\nScale = 1.5\nName = \"Main \"\"Window\"\"\"\n"
+			"Fullscreen = yes\nDepth = 32\n; trailing comment\n[VIDEO]\n"
+			"Width = 1024\n") != 0;
+	}
+	uFailure |= uTest;
+	ReportFailure("FileINI index changed the save order", uTest);
+
+	// Read everything at once
+	uTest = TRUE;
+	if (pVideo) {
+		uint_t uWidth = 0;
+		int_t iHeight = 0;
+		uint_t bFullscreen = FALSE;
+		float fScale = 0.0f;
+		double dScale = 0.0;
+		uint_t uMissing = 99;
+		Burger::String Name("Default");
+		const Burger::FileINI::Section::ValueRequest_t Requests[] = {
+			{"width", Burger::FileINI::Section::VALUE_WORD, &uWidth},
+			{"Height", Burger::FileINI::Section::VALUE_INT, &iHeight},
+			{"FullScreen", Burger::FileINI::Section::VALUE_BOOLEAN,
+				&bFullscreen},
+			{"Scale", Burger::FileINI::Section::VALUE_FLOAT, &fScale},
+			{"Scale", Burger::FileINI::Section::VALUE_DOUBLE, &dScale},
+			{"Missing", Burger::FileINI::Section::VALUE_WORD, &uMissing},
+			{"Name", Burger::FileINI::Section::VALUE_STRING, &Name}};
+		const uintptr_t uFound =
+			pVideo->GetValues(Requests, BURGER_ARRAYSIZE(Requests));
+		uTest = (uFound != 6) || (uWidth != 640) || (iHeight != 480) ||
+			(bFullscreen != TRUE) || (fScale != 1.5f) || (dScale != 1.5) ||
+			(uMissing != 99) ||
+			Burger::string_compare(Name.c_str(), "Main \"Window\"");
+
+		// Cached values are discarded when the value changes
+		uTest |= (pVideo->GetWord("Width", 0, 0, 100) != 100) ||
+			(pVideo->GetInt("Width", 0) != 640);
+		pVideo->FindEntry("Width")->SetValue("-5");
+		uTest |= (pVideo->GetInt("Width", 0) != -5) ||
+			(pVideo->GetWord("Width", 7, 0, 10) != 10);
+		pVideo->SetFloat("Scale", 2.0f);
+		uTest |= (pVideo->GetFloat("Scale", 0.0f, 0.0f, 10.0f) != 2.0f) ||
+			(pVideo->GetDouble("Scale", 0.0, 0.0, 10.0) != 2.0);
+		pVideo->SetValue("Scale", "bad");
+		uTest |= (pVideo->GetFloat("Scale", 3.0f, 0.0f, 10.0f) != 3.0f) ||
+			(pVideo->GetBoolean("Scale", TRUE) != TRUE);
+	}
+	uFailure |= uTest;
+	ReportFailure("FileINI::Section::GetValues() failed", uTest);
+	Burger::delete_object(pINI);
+
+	// Grow the index well past its starting size
+	pINI = Burger::FileINI::new_object();
+	Burger::FileINI::Section* pSection = pINI->AddSection("Many");
+	char Name[32];
+	uint_t i = 0;
+	do {
+		Burger::string_copy(Name, "key");
+		Burger::NumberToAscii(Name + 3, static_cast<uint32_t>(i));
+		pSection->AddEntry(Name, Name + 3);
+	} while (++i < 500);
+	uTest = FALSE;
+	i = 0;
+	do {
+		Burger::string_copy(Name, "KEY");
+		Burger::NumberToAscii(Name + 3, static_cast<uint32_t>(i));
+		// Delete every third one
+		if (!(i % 3)) {
+			Burger::delete_object(pSection->FindEntry(Name));
+		}
+	} while (++i < 500);
+	i = 0;
+	do {
+		Burger::string_copy(Name, "Key");
+		Burger::NumberToAscii(Name + 3, static_cast<uint32_t>(i));
+		const Burger::FileINI::Entry* pEntry = pSection->FindEntry(Name);
+		if (!(i % 3)) {
+			uTest |= pEntry != nullptr;
+		} else {
+			uTest |= !pEntry || (pEntry->GetWord(0) != i);
+		}
+	} while (++i < 500);
+	Burger::delete_object(pINI);
+	uFailure |= uTest;
+	ReportFailure("FileINI index with many entries failed", uTest);
+	return uFailure;
+}
+
+/***************************************
+
+	Memory manager that fails large allocations, so the FileINI hash tables
+	can't grow but the entries and sections can still be created
+
+***************************************/
+
+struct FailLarge_t: public Burger::MemoryManager {
+	Burger::MemoryManager* m_pPrevious;
+	uintptr_t m_uLimit;
+};
+
+static void* BURGER_API FailLargeAllocate(
+	Burger::MemoryManager* pThis, uintptr_t uSize)
+{
+	FailLarge_t* pFail = static_cast<FailLarge_t*>(pThis);
+	if (uSize > pFail->m_uLimit) {
+		return nullptr;
+	}
+	return pFail->m_pPrevious->allocate_memory(uSize);
+}
+
+static void BURGER_API FailLargeFree(
+	Burger::MemoryManager* pThis, const void* pInput)
+{
+	static_cast<FailLarge_t*>(pThis)->m_pPrevious->free_memory(pInput);
+}
+
+static void* BURGER_API FailLargeReallocate(
+	Burger::MemoryManager* pThis, const void* pInput, uintptr_t uSize)
+{
+	FailLarge_t* pFail = static_cast<FailLarge_t*>(pThis);
+	if (uSize > pFail->m_uLimit) {
+		return nullptr;
+	}
+	return pFail->m_pPrevious->reallocate_memory(pInput, uSize);
+}
+
+static void BURGER_API FailLargeShutdown(Burger::MemoryManager* /* pThis */) {}
+
+/***************************************
+
+	Test FileINI lookups after the hash indexes ran out of memory
+
+***************************************/
+
+static uint_t BURGER_API TestFileINIIndexFailure(void) BURGER_NOEXCEPT
+{
+	// Intern the names searched by atom first, the atom table needs to grow
+	char Name[32];
+	uint_t i = 0;
+	do {
+		Burger::string_copy(Name, "Key");
+		Burger::NumberToAscii(Name + 3, static_cast<uint32_t>(i));
+		Burger::StringAtom Key(Name);
+	} while (++i < 200);
+
+	FailLarge_t Fail;
+	Fail.m_pAllocate = FailLargeAllocate;
+	Fail.m_pFree = FailLargeFree;
+	Fail.m_pReallocate = FailLargeReallocate;
+	Fail.m_pShutdown = FailLargeShutdown;
+	Fail.m_uLimit = sizeof(Burger::FileINI::Entry);
+	Fail.m_pPrevious = Burger::GlobalMemoryManager::init(&Fail);
+
+	// The indexes can't grow past a few hundred bytes, so most objects can't
+	// be hashed and must be found by scanning the lists
+	Burger::FileINI* pINI = Burger::FileINI::new_object();
+	Burger::FileINI::Section* pSection = pINI->AddSection("Many");
+	i = 0;
+	do {
+		Burger::string_copy(Name, "key");
+		Burger::NumberToAscii(Name + 3, static_cast<uint32_t>(i));
+		pSection->AddEntry(Name, Name + 3);
+		pINI->AddSection(Name);
+	} while (++i < 200);
+	pSection->AddEntry("key150", "Duplicate");
+
+	// Delete every third entry
+	i = 0;
+	do {
+		Burger::string_copy(Name, "KEY");
+		Burger::NumberToAscii(Name + 3, static_cast<uint32_t>(i));
+		if (!(i % 3)) {
+			Burger::delete_object(pSection->FindEntry(Name));
+		}
+	} while (++i < 200);
+
+	uint_t uFailure = FALSE;
+	i = 0;
+	do {
+		Burger::string_copy(Name, "Key");
+		Burger::NumberToAscii(Name + 3, static_cast<uint32_t>(i));
+		const Burger::FileINI::Entry* pEntry = pSection->FindEntry(Name);
+		if (!(i % 3)) {
+			// The duplicate of 150 was exposed by the delete
+			if (i == 150) {
+				uFailure |= !pEntry ||
+					Burger::string_compare(pEntry->GetValue(), "Duplicate");
+			} else {
+				uFailure |= pEntry != nullptr;
+			}
+		} else {
+			uFailure |= !pEntry || (pEntry->GetWord(0) != i) ||
+				(pSection->FindEntry(Burger::StringAtom(Name)) != pEntry);
+		}
+		const Burger::FileINI::Section* pFound = pINI->FindSection(Name);
+		uFailure |=
+			!pFound || Burger::StringCaseCompare(pFound->GetName(), Name);
+	} while (++i < 200);
+	Burger::delete_object(pINI);
+	Burger::GlobalMemoryManager::init(Fail.m_pPrevious);
+	ReportFailure("FileINI index out of memory lookups failed", uFailure);
+	return uFailure;
+}
+
+/***************************************
+
+	Time FileINI lookups in a large section and bulk reads
+
+***************************************/
+
+static void TimeFileINIIndex(void) BURGER_NOEXCEPT
+{
+	Burger::FileINI* pINI = Burger::FileINI::new_object();
+	Burger::FileINI::Section* pSection = pINI->AddSection("Settings");
+	char Name[32];
+	uint_t i = 0;
+	do {
+		Burger::string_copy(Name, "SettingName");
+		Burger::NumberToAscii(Name + 11, static_cast<uint32_t>(i));
+		pSection->AddEntry(Name, "1.25");
+	} while (++i < 1024);
+
+	const uint_t uLoops = 100000;
+	uintptr_t uFound = 0;
+	uint64_t uMark = Burger::Tick::read_high_precision();
+	i = 0;
+	do {
+		uFound += (pSection->FindEntry("SETTINGNAME1023") != nullptr);
+	} while (++i < uLoops);
+	const uint64_t uLookup = Burger::Tick::read_high_precision() - uMark;
+
+	// Read 8 values one at a time and all at once
+	float Values[8];
+	Burger::FileINI::Section::ValueRequest_t Requests[8];
+	char Keys[8][32];
+	uint_t j = 0;
+	do {
+		Burger::string_copy(Keys[j], "SettingName");
+		Burger::NumberToAscii(Keys[j] + 11, static_cast<uint32_t>(j * 100));
+		Requests[j].m_pKey = Keys[j];
+		Requests[j].m_eType = Burger::FileINI::Section::VALUE_FLOAT;
+		Requests[j].m_pOutput = &Values[j];
+	} while (++j < 8);
+
+	float fTotal = 0.0f;
+	uMark = Burger::Tick::read_high_precision();
+	i = 0;
+	do {
+		j = 0;
+		do {
+			fTotal += static_cast<float>(
+				Burger::AsciiToFloat(pSection->GetValue(Keys[j]), 0.0f));
+		} while (++j < 8);
+	} while (++i < uLoops);
+	const uint64_t uParse = Burger::Tick::read_high_precision() - uMark;
+
+	uMark = Burger::Tick::read_high_precision();
+	i = 0;
+	do {
+		uFound += pSection->GetValues(Requests, 8);
+		fTotal += Values[i & 7];
+	} while (++i < uLoops);
+	const uint64_t uBulk = Burger::Tick::read_high_precision() - uMark;
+
+	const double dScale = 1000000000.0 /
+		(static_cast<double>(Burger::Tick::get_high_precision_frequency()) *
+			static_cast<double>(uLoops));
+	Message("FileINI::Section::FindEntry() 1024 entries %.1f ns, 8 values "
+			"parsed each time %.1f ns, GetValues() %.1f ns (%u, %g)",
+		static_cast<double>(uLookup) * dScale,
+		static_cast<double>(uParse) * dScale,
+		static_cast<double>(uBulk) * dScale, static_cast<uint_t>(uFound),
+		static_cast<double>(fTotal));
+	Burger::delete_object(pINI);
+}
+
+//
+// Perform all the tests for FileINI
+//
+
+int BURGER_API TestBrfileini(uint_t uVerbose) BURGER_NOEXCEPT
+{
+	if (uVerbose & VERBOSE_MSG) {
+		Message("Running FileINI tests");
+	}
+
+	uint_t uTotal = TestFileINIIndex();
+	uTotal |= TestFileINIIndexFailure();
+
+	if (!uTotal && (uVerbose & VERBOSE_TIME)) {
+		TimeFileINIIndex();
+	}
+
+	if (!uTotal && (uVerbose & VERBOSE_MSG)) {
+		Message("Passed all FileINI tests!");
+	}
+	return static_cast<int>(uTotal);
+}
@@ -0,0 +1,622 @@
+/***************************************
+
+	Unit tests for the PNG file loader
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#include "testbrfilepng.h"
+#include "brcompressdeflate.h"
+#include "brcrc32.h"
+#include "brfilepng.h"
+#include "brmemoryfunctions.h"
+#include "brtick.h"
+#include "common.h"
+
+using namespace Burger;
+
+// Use the filter type (row+pass)%5 for every row
+#define PNGFILTER_CYCLE 5
+
+//
+// Fill an image with gradients and noise so every filter type has work to do
+//
+
+static void BURGER_API FillImage(uint8_t* pOutput, uint_t uWidth,
+	uint_t uHeight, uint_t uBytesPerPixel) BURGER_NOEXCEPT
+{
+	uint32_t uSeed = uWidth * 7919U + uHeight * 104729U + uBytesPerPixel;
+	uint_t uY = 0;
+	do {
+		uint_t uX = 0;
+		do {
+			uint_t uByte = 0;
+			do {
+				uSeed = uSeed * 1664525U + 1013904223U;
+				*pOutput++ = static_cast<uint8_t>(
+					(uX * (uByte + 1)) + (uY * 3) + ((uSeed >> 24U) & 15U));
+			} while (++uByte < uBytesPerPixel);
+		} while (++uX < uWidth);
+	} while (++uY < uHeight);
+}
+
+//
+// Reference PNG filter for the encoding side of the tests
+//
+
+static void BURGER_API FilterRow(uint8_t* pOutput, const uint8_t* pRow,
+	const uint8_t* pPrevious, uintptr_t uLength, uint_t uBytesPerPixel,
+	uint_t uFilter) BURGER_NOEXCEPT
+{
+	uintptr_t i = 0;
+	do {
+		int32_t a = (i >= uBytesPerPixel) ? pRow[i - uBytesPerPixel] : 0;
+		int32_t b = pPrevious[i];
+		int32_t c = (i >= uBytesPerPixel) ? pPrevious[i - uBytesPerPixel] : 0;
+		int32_t iPredict = 0;
+		switch (uFilter) {
+		case 1:
+			iPredict = a;
+			break;
+		case 2:
+			iPredict = b;
+			break;
+		case 3:
+			iPredict = (a + b) >> 1;
+			break;
+		case 4: {
+			int32_t p = a + b - c;
+			int32_t pa = (p > a) ? p - a : a - p;
+			int32_t pb = (p > b) ? p - b : b - p;
+			int32_t pc = (p > c) ? p - c : c - p;
+			if ((pa <= pb) && (pa <= pc)) {
+				iPredict = a;
+			} else if (pb <= pc) {
+				iPredict = b;
+			} else {
+				iPredict = c;
+			}
+		} break;
+		default:
+			break;
+		}
+		pOutput[i] = static_cast<uint8_t>(pRow[i] - iPredict);
+	} while (++i < uLength);
+}
+
+//
+// Append a PNG chunk
+//
+
+static void BURGER_API AppendChunk(OutputMemoryStream* pOutput,
+	const char* pID, const void* pData, uintptr_t uLength) BURGER_NOEXCEPT
+{
+	pOutput->BigEndianAppend(static_cast<uint32_t>(uLength));
+	pOutput->Append(pID, 4);
+	uint32_t uCRC = calc_crc32b(pID, 4);
+	if (uLength) {
+		pOutput->Append(pData, uLength);
+		uCRC = calc_crc32b(pData, uLength, uCRC);
+	}
+	pOutput->BigEndianAppend(uCRC);
+}
+
+//
+// Create a PNG file from an image, the image data is split into IDAT chunks
+// of uChunkSize bytes
+//
+
+static uint8_t* BURGER_API BuildPNG(uintptr_t* pLength, const uint8_t* pImage,
+	uint_t uWidth, uint_t uHeight, uint_t uBytesPerPixel, uint_t bInterlaced,
+	uint_t uFilter, uintptr_t uChunkSize) BURGER_NOEXCEPT
+{
+	// Filter every row of every pass
+	const uintptr_t uRowBytes = uWidth * uBytesPerPixel;
+	uint8_t* pRows = static_cast<uint8_t*>(allocate_memory(uRowBytes * 3 + 1));
+	uint8_t* pRow = pRows;
+	uint8_t* pPrevious = pRows + uRowBytes;
+	uint8_t* pFiltered = pRows + (uRowBytes * 2);
+	OutputMemoryStream Raw;
+
+	uint_t uPass = 0;
+	do {
+		uint_t uXStart = 0;
+		uint_t uYStart = 0;
+		uint_t uXStep = 1;
+		uint_t uYStep = 1;
+		if (bInterlaced) {
+			const FilePNG::Adam7Pass_t* pPass = &FilePNG::s_Adam7Passes[uPass];
+			uXStart = pPass->m_uXStart;
+			uYStart = pPass->m_uYStart;
+			uXStep = pPass->m_uXStep;
+			uYStep = pPass->m_uYStep;
+		}
+		if ((uWidth > uXStart) && (uHeight > uYStart)) {
+			const uint_t uPassWidth = (uWidth - uXStart + uXStep - 1) / uXStep;
+			const uintptr_t uPassBytes = uPassWidth * uBytesPerPixel;
+			memory_clear(pPrevious, uRowBytes);
+			uint_t uY = uYStart;
+			do {
+				uint_t uX = 0;
+				do {
+					memory_copy(pRow + (uX * uBytesPerPixel),
+						pImage +
+							(((uY * uWidth) + uXStart + (uX * uXStep)) *
+								uBytesPerPixel),
+						uBytesPerPixel);
+				} while (++uX < uPassWidth);
+				uint_t uType = uFilter;
+				if (uType == PNGFILTER_CYCLE) {
+					uType = (uY + uPass) % 5;
+				}
+				pFiltered[0] = static_cast<uint8_t>(uType);
+				FilterRow(pFiltered + 1, pRow, pPrevious, uPassBytes,
+					uBytesPerPixel, uType);
+				Raw.Append(pFiltered, uPassBytes + 1);
+				uint8_t* pTemp = pRow;
+				pRow = pPrevious;
+				pPrevious = pTemp;
+				uY += uYStep;
+			} while (uY < uHeight);
+		}
+	} while (bInterlaced && (++uPass < 7));
+	free_memory(pRows);
+
+	uintptr_t uRawLength;
+	void* pRaw = Raw.Flatten(&uRawLength);
+	CompressDeflate* pCompressor = new_object<CompressDeflate>();
+	pCompressor->Process(pRaw, uRawLength);
+	pCompressor->Finalize();
+	free_memory(pRaw);
+	uintptr_t uPackedLength;
+	uint8_t* pPacked = static_cast<uint8_t*>(
+		pCompressor->GetOutput()->Flatten(&uPackedLength));
+	delete_object(pCompressor);
+
+	// Assemble the file
+	static const uint8_t Signature[8] = {
+		0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A};
+	static const uint8_t ColorTypes[5] = {0, FilePNG::PNG_INDEXED, 0,
+		FilePNG::PNG_RGB, FilePNG::PNG_RGBA};
+	OutputMemoryStream File;
+	File.Append(Signature, 8);
+	uint8_t IHDR[13];
+	IHDR[0] = static_cast<uint8_t>(uWidth >> 24U);
+	IHDR[1] = static_cast<uint8_t>(uWidth >> 16U);
+	IHDR[2] = static_cast<uint8_t>(uWidth >> 8U);
+	IHDR[3] = static_cast<uint8_t>(uWidth);
+	IHDR[4] = static_cast<uint8_t>(uHeight >> 24U);
+	IHDR[5] = static_cast<uint8_t>(uHeight >> 16U);
+	IHDR[6] = static_cast<uint8_t>(uHeight >> 8U);
+	IHDR[7] = static_cast<uint8_t>(uHeight);
+	IHDR[8] = 8;
+	IHDR[9] = ColorTypes[uBytesPerPixel];
+	IHDR[10] = 0;
+	IHDR[11] = 0;
+	IHDR[12] = static_cast<uint8_t>(bInterlaced);
+	AppendChunk(&File, "IHDR", IHDR, 13);
+	if (uBytesPerPixel == 1) {
+		uint8_t Palette[768];
+		uint_t i = 0;
+		do {
+			Palette[i] = static_cast<uint8_t>(i * 7);
+		} while (++i < 768);
+		AppendChunk(&File, "PLTE", Palette, 768);
+	}
+	AppendChunk(&File, "tEXt", "Comment\0Test", 12);
+	uintptr_t uOffset = 0;
+	do {
+		uintptr_t uChunk = uPackedLength - uOffset;
+		if (uChunk > uChunkSize) {
+			uChunk = uChunkSize;
+		}
+		AppendChunk(&File, "IDAT", pPacked + uOffset, uChunk);
+		uOffset += uChunk;
+	} while (uOffset < uPackedLength);
+	AppendChunk(&File, "IEND", NULL, 0);
+	free_memory(pPacked);
+	return static_cast<uint8_t*>(File.Flatten(pLength));
+}
+
+//
+// Compare a decoded Image with the source pixels
+//
+
+static uint_t BURGER_API CompareImage(const Image* pImage,
+	const uint8_t* pSource, uint_t uWidth, uint_t uHeight,
+	uint_t uBytesPerPixel) BURGER_NOEXCEPT
+{
+	if ((pImage->GetWidth() != uWidth) || (pImage->GetHeight() != uHeight) ||
+		(pImage->GetBytesPerPixel() != uBytesPerPixel)) {
+		return TRUE;
+	}
+	const uintptr_t uRowBytes = uWidth * uBytesPerPixel;
+	uint_t uY = 0;
+	do {
+		if (MemoryCompare(pImage->GetImage() + (uY * pImage->GetStride()),
+				pSource + (uY * uRowBytes), uRowBytes)) {
+			return TRUE;
+		}
+	} while (++uY < uHeight);
+	return FALSE;
+}
+
+//
+// Row callback that rebuilds the image from progressive rows or Adam7 pass
+// rows
+//
+
+struct RowCapture_t {
+	uint8_t* m_pImage;		// Image being rebuilt
+	uint_t m_uWidth;		// Width of the image in pixels
+	uint_t m_uBytesPerPixel; // Bytes per pixel
+	uint_t m_uRowCount;		// Number of rows received
+};
+
+static void BURGER_API CaptureRow(
+	void* pData, const uint8_t* pRow, uint_t uY, uint_t uPass)
+{
+	RowCapture_t* pCapture = static_cast<RowCapture_t*>(pData);
+	const uint_t uBytesPerPixel = pCapture->m_uBytesPerPixel;
+	uint_t uXStart = 0;
+	uint_t uXStep = 1;
+	if (uPass) {
+		uXStart = FilePNG::s_Adam7Passes[uPass - 1].m_uXStart;
+		uXStep = FilePNG::s_Adam7Passes[uPass - 1].m_uXStep;
+	}
+	uint8_t* pOutput = pCapture->m_pImage +
+		(((uY * pCapture->m_uWidth) + uXStart) * uBytesPerPixel);
+	uint_t uX = uXStart;
+	while (uX < pCapture->m_uWidth) {
+		memory_copy(pOutput, pRow, uBytesPerPixel);
+		pRow += uBytesPerPixel;
+		pOutput += uXStep * uBytesPerPixel;
+		uX += uXStep;
+	}
+	++pCapture->m_uRowCount;
+}
+
+//
+// Decode progressive and interlaced images with Load() and with the
+// streaming decoder fed in small pieces
+//
+
+static uint_t BURGER_API TestPNGRoundTrip(void) BURGER_NOEXCEPT
+{
+	struct Size_t {
+		uint_t m_uWidth;
+		uint_t m_uHeight;
+	};
+	static const Size_t Sizes[] = {{1, 1}, {3, 2}, {5, 9}, {33, 17}, {64, 40}};
+	static const uint_t BytesPerPixels[] = {1, 3, 4};
+
+	uint_t uFailure = FALSE;
+	uintptr_t uSize = 0;
+	do {
+		const uint_t uWidth = Sizes[uSize].m_uWidth;
+		const uint_t uHeight = Sizes[uSize].m_uHeight;
+		uintptr_t uFormat = 0;
+		do {
+			const uint_t uBytesPerPixel = BytesPerPixels[uFormat];
+			const uintptr_t uImageSize = uWidth * uHeight * uBytesPerPixel;
+			uint8_t* pSource =
+				static_cast<uint8_t*>(allocate_memory(uImageSize));
+			uint8_t* pCaptured =
+				static_cast<uint8_t*>(allocate_memory(uImageSize));
+			FillImage(pSource, uWidth, uHeight, uBytesPerPixel);
+
+			uint_t bInterlaced = 0;
+			do {
+				uintptr_t uLength;
+				uint8_t* pFile = BuildPNG(&uLength, pSource, uWidth, uHeight,
+					uBytesPerPixel, bInterlaced, PNGFILTER_CYCLE, 100);
+
+				// Load from memory
+				InputMemoryStream Input(pFile, uLength, TRUE);
+				FilePNG Loader;
+				Image MyImage;
+				uint_t uTest = Loader.Load(&MyImage, &Input);
+				if (!uTest) {
+					uTest = CompareImage(
+						&MyImage, pSource, uWidth, uHeight, uBytesPerPixel);
+				}
+				uFailure |= uTest;
+				ReportFailure("FilePNG::Load() %ux%u %u bytes per pixel %s",
+					uTest, uWidth, uHeight, uBytesPerPixel,
+					bInterlaced ? "interlaced" : "progressive");
+
+				// Stream in small pieces into an image
+				Image Streamed;
+				FilePNG Streamer;
+				Streamer.StartStream(&Streamed);
+				uintptr_t uOffset = 0;
+				uTest = FALSE;
+				do {
+					uintptr_t uPiece = uLength - uOffset;
+					if (uPiece > 7) {
+						uPiece = 7;
+					}
+					uTest |= Streamer.ProcessStream(pFile + uOffset, uPiece);
+					uOffset += uPiece;
+				} while (uOffset < uLength);
+				if (!uTest) {
+					uTest = !Streamer.IsStreamComplete() ||
+						CompareImage(&Streamed, pSource, uWidth, uHeight,
+							uBytesPerPixel);
+				}
+				uFailure |= uTest;
+				ReportFailure(
+					"FilePNG::ProcessStream() %ux%u %u bytes per pixel %s",
+					uTest, uWidth, uHeight, uBytesPerPixel,
+					bInterlaced ? "interlaced" : "progressive");
+
+				// Stream only to the row callback
+				RowCapture_t Capture;
+				Capture.m_pImage = pCaptured;
+				Capture.m_uWidth = uWidth;
+				Capture.m_uBytesPerPixel = uBytesPerPixel;
+				Capture.m_uRowCount = 0;
+				memory_clear(pCaptured, uImageSize);
+				Streamer.StartStream(NULL, CaptureRow, &Capture);
+				uTest = Streamer.ProcessStream(pFile, uLength);
+				if (!uTest) {
+					uTest = !Streamer.IsStreamComplete() ||
+						(Streamer.GetWidth() != uWidth) ||
+						(Streamer.GetHeight() != uHeight) ||
+						MemoryCompare(pCaptured, pSource, uImageSize);
+					if (!bInterlaced && (Capture.m_uRowCount != uHeight)) {
+						uTest = TRUE;
+					}
+				}
+				uFailure |= uTest;
+				ReportFailure(
+					"FilePNG::ProcessStream() row callback %ux%u %u bytes per pixel %s",
+					uTest, uWidth, uHeight, uBytesPerPixel,
+					bInterlaced ? "interlaced" : "progressive");
+
+				free_memory(pFile);
+			} while (++bInterlaced < 2);
+			free_memory(pCaptured);
+			free_memory(pSource);
+		} while (++uFormat < BURGER_ARRAYSIZE(BytesPerPixels));
+	} while (++uSize < BURGER_ARRAYSIZE(Sizes));
+	return uFailure;
+}
+
+//
+// A stream that ends early must not report completion
+//
+
+static uint_t BURGER_API TestPNGTruncated(void) BURGER_NOEXCEPT
+{
+	uint8_t Source[16 * 16 * 4];
+	FillImage(Source, 16, 16, 4);
+	uintptr_t uLength;
+	uint8_t* pFile =
+		BuildPNG(&uLength, Source, 16, 16, 4, FALSE, PNGFILTER_CYCLE, 64);
+	FilePNG Streamer;
+	Streamer.StartStream(NULL);
+	uint_t uTest =
+		Streamer.ProcessStream(pFile, uLength - 40) || Streamer.IsStreamComplete();
+	ReportFailure("FilePNG::ProcessStream() truncated file", uTest);
+	free_memory(pFile);
+	return uTest;
+}
+
+//
+// Save images with every preset and thread count and load them back
+//
+
+static uint_t BURGER_API TestPNGSave(void) BURGER_NOEXCEPT
+{
+	struct Size_t {
+		uint_t m_uWidth;
+		uint_t m_uHeight;
+	};
+	static const Size_t Sizes[] = {
+		{1, 1}, {3, 2}, {33, 17}, {64, 40}, {100, 70}};
+	static const uint_t BytesPerPixels[] = {1, 3, 4};
+	static const Image::ePixelTypes Types[] = {
+		Image::PIXELTYPE8BIT, Image::PIXELTYPE888, Image::PIXELTYPE8888};
+	static const uint_t ThreadCounts[] = {1, 3};
+
+	uint_t uFailure = FALSE;
+	uintptr_t uSize = 0;
+	do {
+		const uint_t uWidth = Sizes[uSize].m_uWidth;
+		const uint_t uHeight = Sizes[uSize].m_uHeight;
+		uintptr_t uFormat = 0;
+		do {
+			const uint_t uBytesPerPixel = BytesPerPixels[uFormat];
+			const uintptr_t uRowBytes = uWidth * uBytesPerPixel;
+			uint8_t* pSource = static_cast<uint8_t*>(
+				allocate_memory(uRowBytes * uHeight));
+			FillImage(pSource, uWidth, uHeight, uBytesPerPixel);
+			Image Source;
+			Source.Init(uWidth, uHeight, Types[uFormat]);
+			uint_t uY = 0;
+			do {
+				memory_copy(Source.GetImage() + (uY * Source.GetStride()),
+					pSource + (uY * uRowBytes), uRowBytes);
+			} while (++uY < uHeight);
+
+			uint_t uPreset = FilePNG::SAVE_FASTEST;
+			do {
+				uintptr_t uThreads = 0;
+				do {
+					FilePNG Saver;
+					OutputMemoryStream Output;
+					uint_t uTest = Saver.Save(
+						&Output, &Source, uPreset, ThreadCounts[uThreads]);
+					uintptr_t uLength = 0;
+					uint8_t* pFile = NULL;
+					if (!uTest) {
+						pFile =
+							static_cast<uint8_t*>(Output.Flatten(&uLength));
+						InputMemoryStream Input(pFile, uLength, TRUE);
+						FilePNG Loader;
+						Image MyImage;
+						uTest = Loader.Load(&MyImage, &Input);
+						if (!uTest) {
+							uTest = CompareImage(&MyImage, pSource, uWidth,
+								uHeight, uBytesPerPixel);
+						}
+					}
+					uFailure |= uTest;
+					ReportFailure(
+						"FilePNG::Save() %ux%u %u bytes per pixel preset %u threads %u",
+						uTest, uWidth, uHeight, uBytesPerPixel, uPreset,
+						ThreadCounts[uThreads]);
+
+					// The streaming decoder must also accept the file
+					if (pFile) {
+						Image Streamed;
+						FilePNG Streamer;
+						Streamer.StartStream(&Streamed);
+						uTest = Streamer.ProcessStream(pFile, uLength);
+						if (!uTest) {
+							uTest = !Streamer.IsStreamComplete() ||
+								CompareImage(&Streamed, pSource, uWidth,
+									uHeight, uBytesPerPixel);
+						}
+						uFailure |= uTest;
+						ReportFailure(
+							"FilePNG::Save() streamed %ux%u %u bytes per pixel preset %u threads %u",
+							uTest, uWidth, uHeight, uBytesPerPixel, uPreset,
+							ThreadCounts[uThreads]);
+						free_memory(pFile);
+					}
+				} while (++uThreads < BURGER_ARRAYSIZE(ThreadCounts));
+			} while (++uPreset <= FilePNG::SAVE_SMALLEST);
+			free_memory(pSource);
+		} while (++uFormat < BURGER_ARRAYSIZE(BytesPerPixels));
+	} while (++uSize < BURGER_ARRAYSIZE(Sizes));
+	return uFailure;
+}
+
+//
+// Time decoding a large image with each filter type
+//
+
+static void BURGER_API TimePNG(void) BURGER_NOEXCEPT
+{
+	const uint_t uSize = 1024;
+	const uint_t uLoops = 4;
+	uint8_t* pSource = static_cast<uint8_t*>(allocate_memory(uSize * uSize * 4));
+	FillImage(pSource, uSize, uSize, 4);
+	const double dScale = 1000.0 /
+		(static_cast<double>(Tick::get_high_precision_frequency()) *
+			static_cast<double>(uLoops));
+
+	static const char* FilterNames[PNGFILTER_CYCLE] = {
+		"None", "Sub", "Up", "Average", "Paeth"};
+	uint_t uFilter = 0;
+	do {
+		uintptr_t uLength;
+		uint8_t* pFile = BuildPNG(
+			&uLength, pSource, uSize, uSize, 4, FALSE, uFilter, 0x10000);
+		Image MyImage;
+		FilePNG Loader;
+
+		uint64_t uMark = Tick::read_high_precision();
+		uint_t uLoop = 0;
+		do {
+			InputMemoryStream Input(pFile, uLength, TRUE);
+			Loader.Load(&MyImage, &Input);
+		} while (++uLoop < uLoops);
+		const uint64_t uLoad = Tick::read_high_precision() - uMark;
+
+		uMark = Tick::read_high_precision();
+		uLoop = 0;
+		do {
+			Loader.StartStream(&MyImage);
+			uintptr_t uOffset = 0;
+			do {
+				uintptr_t uPiece = uLength - uOffset;
+				if (uPiece > 0x1000) {
+					uPiece = 0x1000;
+				}
+				Loader.ProcessStream(pFile + uOffset, uPiece);
+				uOffset += uPiece;
+			} while (uOffset < uLength);
+		} while (++uLoop < uLoops);
+		const uint64_t uStream = Tick::read_high_precision() - uMark;
+
+		Message("PNG %ux%u RGBA %s filter load %.2f ms, stream %.2f ms", uSize,
+			uSize, FilterNames[uFilter], static_cast<double>(uLoad) * dScale,
+			static_cast<double>(uStream) * dScale);
+		free_memory(pFile);
+	} while (++uFilter < PNGFILTER_CYCLE);
+	free_memory(pSource);
+}
+
+//
+// Time saving a large image with each preset, single and multi-threaded
+//
+
+static void BURGER_API TimePNGSave(void) BURGER_NOEXCEPT
+{
+	const uint_t uSize = 1024;
+	const uint_t uLoops = 2;
+	Image Source;
+	Source.Init(uSize, uSize, Image::PIXELTYPE8888);
+	FillImage(Source.GetImage(), uSize, uSize, 4);
+	const double dScale = 1000.0 /
+		(static_cast<double>(Tick::get_high_precision_frequency()) *
+			static_cast<double>(uLoops));
+
+	static const char* PresetNames[3] = {"fastest", "default", "smallest"};
+	static const uint_t ThreadCounts[] = {1, 4};
+	uint_t uPreset = FilePNG::SAVE_FASTEST;
+	do {
+		uintptr_t uThreads = 0;
+		do {
+			FilePNG Saver;
+			uintptr_t uLength = 0;
+			const uint64_t uMark = Tick::read_high_precision();
+			uint_t uLoop = 0;
+			do {
+				OutputMemoryStream Output;
+				Saver.Save(&Output, &Source, uPreset, ThreadCounts[uThreads]);
+				uLength = Output.GetSize();
+			} while (++uLoop < uLoops);
+			const uint64_t uTime = Tick::read_high_precision() - uMark;
+			Message("PNG save %ux%u RGBA %s %u thread(s) %.2f ms, %u bytes",
+				uSize, uSize, PresetNames[uPreset], ThreadCounts[uThreads],
+				static_cast<double>(uTime) * dScale,
+				static_cast<uint_t>(uLength));
+		} while (++uThreads < BURGER_ARRAYSIZE(ThreadCounts));
+	} while (++uPreset <= FilePNG::SAVE_SMALLEST);
+}
+
+//
+// Perform all the tests for the PNG loader and saver
+//
+
+int BURGER_API TestBrfilepng(uint_t uVerbose) BURGER_NOEXCEPT
+{
+	if (uVerbose & VERBOSE_MSG) {
+		Message("Running PNG tests");
+	}
+
+	uint_t uTotal = TestPNGRoundTrip();
+	uTotal |= TestPNGTruncated();
+	uTotal |= TestPNGSave();
+
+	if (!uTotal && (uVerbose & VERBOSE_TIME)) {
+		TimePNG();
+		TimePNGSave();
+	}
+
+	if (!uTotal && (uVerbose & VERBOSE_MSG)) {
+		Message("Passed all PNG tests!");
+	}
+	return static_cast<int>(uTotal);
+}
@@ -0,0 +1,663 @@
+/***************************************
+
+	Unit tests for the RLE image file loaders
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#include "testbrfilerle.h"
+#include "brfilebmp.h"
+#include "brfilelbm.h"
+#include "brfilepcx.h"
+#include "brfiletga.h"
+#include "brglobalmemorymanager.h"
+#include "brmemoryfunctions.h"
+#include "brtick.h"
+#include "common.h"
+
+using namespace Burger;
+
+//
+// Fill an image with a mix of solid runs and noise, the way paint programs
+// and screen grabs look to a run length compressor
+//
+
+static void BURGER_API FillRuns(Image* pImage, uint32_t uSeed) BURGER_NOEXCEPT
+{
+	const uint_t uWidth = pImage->GetWidth();
+	const uint_t uHeight = pImage->GetHeight();
+	const uint_t uPixelSize = pImage->GetBytesPerPixel();
+	uint8_t Color[4] = {0, 0, 0, 0};
+	uint_t uRemaining = 0;
+	uint_t bNoise = FALSE;
+	uint_t uY = 0;
+	do {
+		uint8_t* pOutput = pImage->GetImage() + (uY * pImage->GetStride());
+		uint_t uX = 0;
+		do {
+			if (!uRemaining) {
+				uSeed = uSeed * 1664525U + 1013904223U;
+				uRemaining = ((uSeed >> 16U) % 40U) + 1U;
+				bNoise = ((uSeed >> 8U) & 3U) == 0;
+			}
+			if (bNoise || (uRemaining == 1)) {
+				uSeed = uSeed * 1664525U + 1013904223U;
+				Color[0] = static_cast<uint8_t>(uSeed >> 24U);
+				Color[1] = static_cast<uint8_t>(uSeed >> 16U);
+				Color[2] = static_cast<uint8_t>(uSeed >> 8U);
+				Color[3] = static_cast<uint8_t>(uSeed >> 4U);
+			}
+			--uRemaining;
+			uint_t i = 0;
+			do {
+				pOutput[i] = Color[i];
+			} while (++i < uPixelSize);
+			if (pImage->GetType() == Image::PIXELTYPE555) {
+				reinterpret_cast<uint16_t*>(pOutput)[0] &= 0x7FFFU;
+			}
+			pOutput += uPixelSize;
+		} while (++uX < uWidth);
+	} while (++uY < uHeight);
+}
+
+//
+// Make a palette where every entry is a different color
+//
+
+static void BURGER_API FillTestPalette(RGBAWord8_t* pOutput) BURGER_NOEXCEPT
+{
+	uint_t i = 0;
+	do {
+		pOutput[i].m_uRed = static_cast<uint8_t>(i);
+		pOutput[i].m_uGreen = static_cast<uint8_t>(i * 7U);
+		pOutput[i].m_uBlue = static_cast<uint8_t>(255U - i);
+		pOutput[i].m_uAlpha = 0;
+	} while (++i < 256);
+}
+
+//
+// Compare the pixels of two images
+//
+
+static uint_t BURGER_API CompareImages(
+	const Image* pImage, const Image* pSource) BURGER_NOEXCEPT
+{
+	if ((pImage->GetWidth() != pSource->GetWidth()) ||
+		(pImage->GetHeight() != pSource->GetHeight()) ||
+		(pImage->GetType() != pSource->GetType())) {
+		return TRUE;
+	}
+	const uintptr_t uLength =
+		pSource->GetWidth() * static_cast<uintptr_t>(pSource->GetBytesPerPixel());
+	uint_t uY = 0;
+	do {
+		if (MemoryCompare(pImage->GetImage() + (uY * pImage->GetStride()),
+				pSource->GetImage() + (uY * pSource->GetStride()), uLength)) {
+			return TRUE;
+		}
+	} while (++uY < pSource->GetHeight());
+	return FALSE;
+}
+
+//
+// Compare the RGB entries of two palettes
+//
+
+static uint_t BURGER_API ComparePalettes(
+	const RGBAWord8_t* pInput1, const RGBAWord8_t* pInput2) BURGER_NOEXCEPT
+{
+	uint_t i = 0;
+	do {
+		if ((pInput1[i].m_uRed != pInput2[i].m_uRed) ||
+			(pInput1[i].m_uGreen != pInput2[i].m_uGreen) ||
+			(pInput1[i].m_uBlue != pInput2[i].m_uBlue)) {
+			return TRUE;
+		}
+	} while (++i < 256);
+	return FALSE;
+}
+
+//
+// Convert a row to the byte order of a TGA or BMP file
+//
+
+static void BURGER_API ToFileOrder(uint8_t* pOutput, const uint8_t* pInput,
+	uint_t uCount, uint_t uPixelSize) BURGER_NOEXCEPT
+{
+	do {
+		if (uPixelSize == 2) {
+			const uint_t uColor = reinterpret_cast<const uint16_t*>(pInput)[0];
+			pOutput[0] = static_cast<uint8_t>(uColor);
+			pOutput[1] = static_cast<uint8_t>(uColor >> 8U);
+		} else if (uPixelSize == 1) {
+			pOutput[0] = pInput[0];
+		} else {
+			pOutput[0] = pInput[2];
+			pOutput[1] = pInput[1];
+			pOutput[2] = pInput[0];
+			if (uPixelSize == 4) {
+				pOutput[3] = pInput[3];
+			}
+		}
+		pInput += uPixelSize;
+		pOutput += uPixelSize;
+	} while (--uCount);
+}
+
+//
+// Create a TGA file, with or without compression
+//
+
+static void BURGER_API AppendTGA(OutputMemoryStream* pOutput,
+	const Image* pImage, const RGBAWord8_t* pPalette,
+	uint_t bCompress) BURGER_NOEXCEPT
+{
+	const uint_t uWidth = pImage->GetWidth();
+	const uint_t uHeight = pImage->GetHeight();
+	const uint_t uPixelSize = pImage->GetBytesPerPixel();
+	const uint_t bIndexed = (uPixelSize == 1);
+
+	pOutput->Append(static_cast<uint8_t>(0));
+	pOutput->Append(static_cast<uint8_t>(bIndexed ? 1 : 0));
+	uint_t uImageType = bIndexed ? FileTGA::TGA_RGBINDEXED : FileTGA::TGA_RGB;
+	if (bCompress) {
+		uImageType += 8U;
+	}
+	pOutput->Append(static_cast<uint8_t>(uImageType));
+	pOutput->Append(static_cast<uint16_t>(0));
+	pOutput->Append(static_cast<uint16_t>(bIndexed ? 256 : 0));
+	pOutput->Append(static_cast<uint8_t>(bIndexed ? 24 : 0));
+	pOutput->Append(static_cast<uint32_t>(0));
+	pOutput->Append(static_cast<uint16_t>(uWidth));
+	pOutput->Append(static_cast<uint16_t>(uHeight));
+	pOutput->Append(static_cast<uint8_t>(uPixelSize * 8U));
+	pOutput->Append(static_cast<uint8_t>(0));
+	if (bIndexed) {
+		uint_t i = 0;
+		do {
+			pOutput->Append(pPalette[i].m_uBlue);
+			pOutput->Append(pPalette[i].m_uGreen);
+			pOutput->Append(pPalette[i].m_uRed);
+		} while (++i < 256);
+	}
+
+	// TGA files are stored bottom up
+	uint8_t* pRow = static_cast<uint8_t*>(allocate_memory(uWidth * uPixelSize));
+	uint_t uY = uHeight;
+	do {
+		--uY;
+		ToFileOrder(pRow, pImage->GetImage() + (uY * pImage->GetStride()),
+			uWidth, uPixelSize);
+		if (!bCompress) {
+			pOutput->Append(pRow, uWidth * uPixelSize);
+			continue;
+		}
+		uint_t uX = 0;
+		do {
+			// Measure the run at this pixel
+			uint_t uRun = 1;
+			while (((uX + uRun) < uWidth) && (uRun < 128) &&
+				!MemoryCompare(pRow + (uX * uPixelSize),
+					pRow + ((uX + uRun) * uPixelSize), uPixelSize)) {
+				++uRun;
+			}
+			if (uRun >= 2) {
+				pOutput->Append(static_cast<uint8_t>(0x7FU + uRun));
+				pOutput->Append(pRow + (uX * uPixelSize), uPixelSize);
+				uX += uRun;
+				continue;
+			}
+			// Send literals until the next run starts
+			uint_t uCount = 1;
+			while (((uX + uCount) < uWidth) && (uCount < 128)) {
+				const uint_t uNext = uX + uCount;
+				if (((uNext + 1) < uWidth) &&
+					!MemoryCompare(pRow + (uNext * uPixelSize),
+						pRow + ((uNext + 1) * uPixelSize), uPixelSize)) {
+					break;
+				}
+				++uCount;
+			}
+			pOutput->Append(static_cast<uint8_t>(uCount - 1U));
+			pOutput->Append(pRow + (uX * uPixelSize), uCount * uPixelSize);
+			uX += uCount;
+		} while (uX < uWidth);
+	} while (uY);
+	free_memory(pRow);
+}
+
+//
+// Compress a span with PCX run length encoding
+//
+
+static void BURGER_API AppendPCXSpan(OutputMemoryStream* pOutput,
+	const uint8_t* pInput, uintptr_t uLength) BURGER_NOEXCEPT
+{
+	uintptr_t i = 0;
+	do {
+		const uint8_t uValue = pInput[i];
+		uint_t uRun = 1;
+		while (((i + uRun) < uLength) && (uRun < 63) &&
+			(pInput[i + uRun] == uValue)) {
+			++uRun;
+		}
+		if ((uRun >= 2) || (uValue >= 0xC0U)) {
+			pOutput->Append(static_cast<uint8_t>(0xC0U + uRun));
+		}
+		pOutput->Append(uValue);
+		i += uRun;
+	} while (i < uLength);
+}
+
+//
+// Create a PCX file from an 8 or 24 bit image
+//
+
+static void BURGER_API AppendPCX(OutputMemoryStream* pOutput,
+	const Image* pImage, const RGBAWord8_t* pPalette) BURGER_NOEXCEPT
+{
+	const uint_t uWidth = pImage->GetWidth();
+	const uint_t uHeight = pImage->GetHeight();
+	const uint_t uPlanes = pImage->GetBytesPerPixel();
+	const uint_t uBytesPerLine = (uWidth + 1U) & (~1U);
+
+	pOutput->Append(static_cast<uint8_t>(10));
+	pOutput->Append(static_cast<uint8_t>(FilePCX::PCX_VERSION30));
+	pOutput->Append(static_cast<uint8_t>(1));
+	pOutput->Append(static_cast<uint8_t>(8));
+	pOutput->Append(static_cast<uint32_t>(0));
+	pOutput->Append(static_cast<uint16_t>(uWidth - 1));
+	pOutput->Append(static_cast<uint16_t>(uHeight - 1));
+	pOutput->Append(static_cast<uint16_t>(72));
+	pOutput->Append(static_cast<uint16_t>(72));
+	uint8_t Filler[60];
+	memory_clear(Filler, sizeof(Filler));
+	pOutput->Append(Filler, 48);
+	pOutput->Append(static_cast<uint8_t>(0));
+	pOutput->Append(static_cast<uint8_t>(uPlanes));
+	pOutput->Append(static_cast<uint16_t>(uBytesPerLine));
+	pOutput->Append(Filler, 60);
+
+	uint8_t* pPlane = static_cast<uint8_t*>(allocate_memory(uBytesPerLine));
+	pPlane[uBytesPerLine - 1] = 0;
+	uint_t uY = 0;
+	do {
+		const uint8_t* pRow = pImage->GetImage() + (uY * pImage->GetStride());
+		uint_t uPlane = 0;
+		do {
+			uint_t uX = 0;
+			do {
+				pPlane[uX] = pRow[(uX * uPlanes) + uPlane];
+			} while (++uX < uWidth);
+			AppendPCXSpan(pOutput, pPlane, uBytesPerLine);
+		} while (++uPlane < uPlanes);
+	} while (++uY < uHeight);
+	free_memory(pPlane);
+
+	if (uPlanes == 1) {
+		pOutput->Append(static_cast<uint8_t>(12));
+		uint_t i = 0;
+		do {
+			pOutput->Append(pPalette[i].m_uRed);
+			pOutput->Append(pPalette[i].m_uGreen);
+			pOutput->Append(pPalette[i].m_uBlue);
+		} while (++i < 256);
+	}
+}
+
+//
+// Compress a span with IFF ByteRun1
+//
+
+static void BURGER_API AppendByteRun1(OutputMemoryStream* pOutput,
+	const uint8_t* pInput, uintptr_t uLength) BURGER_NOEXCEPT
+{
+	uintptr_t i = 0;
+	do {
+		uint_t uRun = 1;
+		while (((i + uRun) < uLength) && (uRun < 128) &&
+			(pInput[i + uRun] == pInput[i])) {
+			++uRun;
+		}
+		if (uRun >= 2) {
+			pOutput->Append(static_cast<uint8_t>(257U - uRun));
+			pOutput->Append(pInput[i]);
+			i += uRun;
+			continue;
+		}
+		uint_t uCount = 1;
+		while (((i + uCount) < uLength) && (uCount < 128) &&
+			(((i + uCount + 1) >= uLength) ||
+				(pInput[i + uCount] != pInput[i + uCount + 1]))) {
+			++uCount;
+		}
+		pOutput->Append(static_cast<uint8_t>(uCount - 1U));
+		pOutput->Append(pInput + i, uCount);
+		i += uCount;
+	} while (i < uLength);
+}
+
+//
+// Replace a big endian length already written into the stream
+//
+
+static void BURGER_API PatchBigWord32(
+	OutputMemoryStream* pOutput, uintptr_t uMark, uintptr_t uValue) BURGER_NOEXCEPT
+{
+	uint8_t Temp[4];
+	Temp[0] = static_cast<uint8_t>(uValue >> 24U);
+	Temp[1] = static_cast<uint8_t>(uValue >> 16U);
+	Temp[2] = static_cast<uint8_t>(uValue >> 8U);
+	Temp[3] = static_cast<uint8_t>(uValue);
+	pOutput->Overwrite(Temp, 4, uMark);
+}
+
+//
+// Create an ILBM or PBM file from an 8 or 24 bit image
+//
+
+static void BURGER_API AppendLBM(OutputMemoryStream* pOutput,
+	const Image* pImage, const RGBAWord8_t* pPalette,
+	uint_t bPBM) BURGER_NOEXCEPT
+{
+	const uint_t uWidth = pImage->GetWidth();
+	const uint_t uHeight = pImage->GetHeight();
+	const uint_t uPixelSize = pImage->GetBytesPerPixel();
+	const uint_t uDepth = uPixelSize * 8U;
+
+	pOutput->Append("FORM");
+	const uintptr_t uFormMark = pOutput->GetSize();
+	pOutput->BigEndianAppend(static_cast<uint32_t>(0));
+	pOutput->Append(bPBM ? "PBM " : "ILBM");
+
+	pOutput->Append("BMHD");
+	pOutput->BigEndianAppend(static_cast<uint32_t>(20));
+	pOutput->BigEndianAppend(static_cast<uint16_t>(uWidth));
+	pOutput->BigEndianAppend(static_cast<uint16_t>(uHeight));
+	pOutput->BigEndianAppend(static_cast<uint32_t>(0));
+	pOutput->Append(static_cast<uint8_t>(uDepth));
+	pOutput->Append(static_cast<uint8_t>(0));
+	pOutput->Append(static_cast<uint8_t>(1));
+	pOutput->Append(static_cast<uint8_t>(0));
+	pOutput->BigEndianAppend(static_cast<uint16_t>(0));
+	pOutput->Append(static_cast<uint8_t>(1));
+	pOutput->Append(static_cast<uint8_t>(1));
+	pOutput->BigEndianAppend(static_cast<uint16_t>(uWidth));
+	pOutput->BigEndianAppend(static_cast<uint16_t>(uHeight));
+
+	if (uPixelSize == 1) {
+		pOutput->Append("CMAP");
+		pOutput->BigEndianAppend(static_cast<uint32_t>(768));
+		uint_t i = 0;
+		do {
+			pOutput->Append(pPalette[i].m_uRed);
+			pOutput->Append(pPalette[i].m_uGreen);
+			pOutput->Append(pPalette[i].m_uBlue);
+		} while (++i < 256);
+	}
+
+	pOutput->Append("BODY");
+	const uintptr_t uBodyMark = pOutput->GetSize();
+	pOutput->BigEndianAppend(static_cast<uint32_t>(0));
+	const uintptr_t uPlaneStep = ((uWidth + 15U) & (~15U)) >> 3U;
+	uint8_t* pPlane = static_cast<uint8_t*>(allocate_memory(uPlaneStep));
+	uint_t uY = 0;
+	do {
+		const uint8_t* pRow = pImage->GetImage() + (uY * pImage->GetStride());
+		if (bPBM) {
+			AppendByteRun1(pOutput, pRow, uWidth);
+			continue;
+		}
+		uint_t uPlane = 0;
+		do {
+			memory_clear(pPlane, uPlaneStep);
+			uint_t uX = 0;
+			do {
+				if ((pRow[(uX * uPixelSize) + (uPlane >> 3U)] >>
+						(uPlane & 7U)) &
+					1U) {
+					pPlane[uX >> 3U] |= static_cast<uint8_t>(0x80U >> (uX & 7U));
+				}
+			} while (++uX < uWidth);
+			AppendByteRun1(pOutput, pPlane, uPlaneStep);
+		} while (++uPlane < uDepth);
+	} while (++uY < uHeight);
+	free_memory(pPlane);
+
+	const uintptr_t uBodySize = pOutput->GetSize() - (uBodyMark + 4);
+	if (uBodySize & 1U) {
+		pOutput->Append(static_cast<uint8_t>(0));
+	}
+	PatchBigWord32(pOutput, uBodyMark, uBodySize);
+	PatchBigWord32(pOutput, uFormMark, pOutput->GetSize() - (uFormMark + 4));
+}
+
+//
+// File formats tested
+//
+
+enum eRLEFormat { FORMAT_TGA, FORMAT_BMP, FORMAT_PCX, FORMAT_LBM };
+
+static const char* g_FormatNames[] = {"TGA", "BMP", "PCX", "LBM"};
+
+//
+// Create a file in one of the formats, uVariant selects compression for TGA
+// and BMP, PBM for LBM
+//
+
+static void* BURGER_API CreateFile(eRLEFormat eFormat, uintptr_t* pLength,
+	const Image* pImage, const RGBAWord8_t* pPalette,
+	uint_t uVariant) BURGER_NOEXCEPT
+{
+	OutputMemoryStream Output;
+	switch (eFormat) {
+	case FORMAT_TGA:
+		AppendTGA(&Output, pImage, pPalette, uVariant);
+		break;
+	case FORMAT_BMP: {
+		FileBMP Saver;
+		Saver.SetPalette(pPalette);
+		Saver.Save(&Output, pImage, uVariant);
+	} break;
+	case FORMAT_PCX:
+		AppendPCX(&Output, pImage, pPalette);
+		break;
+	default:
+		AppendLBM(&Output, pImage, pPalette, uVariant);
+		break;
+	}
+	return Output.Flatten(pLength);
+}
+
+//
+// Load a file and copy out its palette
+//
+
+static uint_t BURGER_API LoadFile(eRLEFormat eFormat, Image* pOutput,
+	RGBAWord8_t* pPalette, const void* pFile, uintptr_t uLength) BURGER_NOEXCEPT
+{
+	InputMemoryStream Input(pFile, uLength, TRUE);
+	uint_t uResult = 10;
+	Image* pImage = NULL;
+	switch (eFormat) {
+	case FORMAT_TGA: {
+		FileTGA Loader;
+		uResult = Loader.Load(pOutput, &Input);
+		memory_copy(pPalette, Loader.GetPalette(), sizeof(RGBAWord8_t) * 256);
+	} break;
+	case FORMAT_BMP: {
+		FileBMP Loader;
+		uResult = Loader.Load(pOutput, &Input);
+		memory_copy(pPalette, Loader.GetPalette(), sizeof(RGBAWord8_t) * 256);
+	} break;
+	case FORMAT_PCX: {
+		FilePCX Loader;
+		pImage = Loader.Load(&Input);
+		memory_copy(pPalette, Loader.GetPalette(), sizeof(RGBAWord8_t) * 256);
+	} break;
+	default: {
+		FileLBM Loader;
+		pImage = Loader.Load(&Input);
+		memory_copy(pPalette, Loader.GetPalette(), sizeof(RGBAWord8_t) * 256);
+	} break;
+	}
+	if (pImage) {
+		pOutput->Transfer(pImage);
+		delete_object(pImage);
+		uResult = 0;
+	}
+	return uResult;
+}
+
+//
+// Description of each file type tested
+//
+
+struct RLETest_t {
+	eRLEFormat m_eFormat;           // File format
+	Image::ePixelTypes m_eType;     // Pixel type
+	uint_t m_uVariant;              // Compression or PBM
+	const char* m_pName;            // Description
+};
+
+static const RLETest_t g_RLETests[] = {
+	{FORMAT_TGA, Image::PIXELTYPE8BIT, TRUE, "8 bit RLE"},
+	{FORMAT_TGA, Image::PIXELTYPE555, TRUE, "16 bit RLE"},
+	{FORMAT_TGA, Image::PIXELTYPE888, TRUE, "24 bit RLE"},
+	{FORMAT_TGA, Image::PIXELTYPE8888, TRUE, "32 bit RLE"},
+	{FORMAT_TGA, Image::PIXELTYPE8BIT, FALSE, "8 bit"},
+	{FORMAT_TGA, Image::PIXELTYPE555, FALSE, "16 bit"},
+	{FORMAT_TGA, Image::PIXELTYPE888, FALSE, "24 bit"},
+	{FORMAT_TGA, Image::PIXELTYPE8888, FALSE, "32 bit"},
+	{FORMAT_BMP, Image::PIXELTYPE8BIT, TRUE, "8 bit RLE"},
+	{FORMAT_BMP, Image::PIXELTYPE8BIT, FALSE, "8 bit"},
+	{FORMAT_BMP, Image::PIXELTYPE555, FALSE, "16 bit"},
+	{FORMAT_BMP, Image::PIXELTYPE888, FALSE, "24 bit"},
+	{FORMAT_BMP, Image::PIXELTYPE8888, FALSE, "32 bit"},
+	{FORMAT_PCX, Image::PIXELTYPE8BIT, FALSE, "8 bit"},
+	{FORMAT_PCX, Image::PIXELTYPE888, FALSE, "24 bit"},
+	{FORMAT_LBM, Image::PIXELTYPE8BIT, FALSE, "8 bit ILBM"},
+	{FORMAT_LBM, Image::PIXELTYPE888, FALSE, "24 bit ILBM"},
+	{FORMAT_LBM, Image::PIXELTYPE8BIT, TRUE, "8 bit PBM"}};
+
+//
+// Create and load every file type at several sizes
+//
+
+static uint_t BURGER_API TestRLERoundTrip(void) BURGER_NOEXCEPT
+{
+	struct Size_t {
+		uint_t m_uWidth;
+		uint_t m_uHeight;
+	};
+	static const Size_t Sizes[] = {{1, 1}, {2, 3}, {37, 23}, {64, 40}, {333, 65}};
+
+	RGBAWord8_t Palette[256];
+	RGBAWord8_t LoadedPalette[256];
+	FillTestPalette(Palette);
+	uint_t uFailure = FALSE;
+	uintptr_t uTest = 0;
+	do {
+		const RLETest_t* pTest = &g_RLETests[uTest];
+		uintptr_t uSize = 0;
+		do {
+			const uint_t uWidth = Sizes[uSize].m_uWidth;
+			const uint_t uHeight = Sizes[uSize].m_uHeight;
+			// PBM rows are not padded by the loader, only use even widths
+			if ((pTest->m_eFormat == FORMAT_LBM) && pTest->m_uVariant &&
+				(uWidth & 1U)) {
+				continue;
+			}
+			Image Source;
+			Source.Init(uWidth, uHeight, pTest->m_eType);
+			FillRuns(&Source, uWidth * 31U + uHeight + static_cast<uint_t>(uTest));
+			uintptr_t uLength;
+			void* pFile = CreateFile(
+				pTest->m_eFormat, &uLength, &Source, Palette, pTest->m_uVariant);
+			Image MyImage;
+			uint_t uResult = LoadFile(
+				pTest->m_eFormat, &MyImage, LoadedPalette, pFile, uLength);
+			if (!uResult) {
+				uResult = CompareImages(&MyImage, &Source);
+				if (!uResult && (pTest->m_eType == Image::PIXELTYPE8BIT)) {
+					uResult = ComparePalettes(LoadedPalette, Palette);
+				}
+			}
+			free_memory(pFile);
+			uFailure |= uResult;
+			ReportFailure("%s %s %ux%u", uResult,
+				g_FormatNames[pTest->m_eFormat], pTest->m_pName, uWidth,
+				uHeight);
+		} while (++uSize < BURGER_ARRAYSIZE(Sizes));
+	} while (++uTest < BURGER_ARRAYSIZE(g_RLETests));
+	return uFailure;
+}
+
+//
+// Time loading a large image in each format
+//
+
+static void BURGER_API TimeRLELoaders(void) BURGER_NOEXCEPT
+{
+	const uint_t uSize = 1024;
+	const uint_t uLoops = 4;
+	const double dScale = 1000.0 /
+		(static_cast<double>(Tick::get_high_precision_frequency()) *
+			static_cast<double>(uLoops));
+	RGBAWord8_t Palette[256];
+	RGBAWord8_t LoadedPalette[256];
+	FillTestPalette(Palette);
+
+	uintptr_t uTest = 0;
+	do {
+		const RLETest_t* pTest = &g_RLETests[uTest];
+		Image Source;
+		Source.Init(uSize, uSize, pTest->m_eType);
+		FillRuns(&Source, 12345);
+		uintptr_t uLength;
+		void* pFile = CreateFile(
+			pTest->m_eFormat, &uLength, &Source, Palette, pTest->m_uVariant);
+
+		Image MyImage;
+		const uint64_t uMark = Tick::read_high_precision();
+		uint_t uLoop = 0;
+		do {
+			LoadFile(pTest->m_eFormat, &MyImage, LoadedPalette, pFile, uLength);
+		} while (++uLoop < uLoops);
+		const uint64_t uElapsed = Tick::read_high_precision() - uMark;
+		Message("%s %s %ux%u load %.2f ms, %u bytes",
+			g_FormatNames[pTest->m_eFormat], pTest->m_pName, uSize, uSize,
+			static_cast<double>(uElapsed) * dScale,
+			static_cast<uint_t>(uLength));
+		free_memory(pFile);
+	} while (++uTest < BURGER_ARRAYSIZE(g_RLETests));
+}
+
+//
+// Perform all the tests for the TGA, BMP, PCX and LBM loaders
+//
+
+int BURGER_API TestBrfilerle(uint_t uVerbose) BURGER_NOEXCEPT
+{
+	if (uVerbose & VERBOSE_MSG) {
+		Message("Running RLE image file tests");
+	}
+
+	uint_t uTotal = TestRLERoundTrip();
+
+	if (!uTotal && (uVerbose & VERBOSE_TIME)) {
+		TimeRLELoaders();
+	}
+
+	if (!uTotal && (uVerbose & VERBOSE_MSG)) {
+		Message("Passed all RLE image file tests!");
+	}
+	return static_cast<int>(uTotal);
+}
@@ -15,9 +15,12 @@
 #include "testbrhashes.h"
 #include "bradler16.h"
 #include "bradler32.h"
+#include "bratomic.h"
+#include "brconcurrenthashmap.h"
 #include "brcrc16.h"
 #include "brcrc32.h"
 #include "brfixedpoint.h"
+#include "brglobalmemorymanager.h"
 #include "brgost.h"
 #include "brguid.h"
 #include "brmd2.h"
@@ -26,6 +29,8 @@
 #include "brmemoryfunctions.h"
 #include "brnumberstringhex.h"
 #include "brsha1.h"
+#include "brthread.h"
+#include "brtick.h"
 #include "common.h"
 
 //
@@ -244,6 +249,38 @@ static uint_t TestAdler32(void) BURGER_NOEXCEPT
 	return uFailure;
 }
 
+//
+// Test combine_adler32() by splitting each string at every position
+//
+
+static uint_t TestCombineAdler32(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = FALSE;
+	const HashTest_t* pWork = g_HashTestTable;
+	uintptr_t uCount = BURGER_ARRAYSIZE(g_HashTestTable);
+	do {
+		const uintptr_t uLength = Burger::string_length(pWork->m_pString);
+		uintptr_t uSplit = 0;
+		do {
+			const uint32_t uTester = Burger::combine_adler32(
+				Burger::calc_adler32(pWork->m_pString, uSplit),
+				Burger::calc_adler32(
+					pWork->m_pString + uSplit, uLength - uSplit),
+				uLength - uSplit);
+			const uint_t uTest = (uTester != pWork->m_Adler32);
+			uFailure |= uTest;
+			if (uTest) {
+				ReportFailure(
+					"Burger::combine_adler32(\"%s\",%u) = 0x%08X, expected 0x%08X",
+					uTest, pWork->m_pString, static_cast<uint_t>(uSplit),
+					uTester, pWork->m_Adler32);
+			}
+		} while (++uSplit <= uLength);
+		++pWork;
+	} while (--uCount);
+	return uFailure;
+}
+
 //
 // Test calc_crc32b()
 //
@@ -521,6 +558,258 @@ static uint_t TestGUID(void) BURGER_NOEXCEPT
 	return uFailure;
 }
 
+//
+// Test ConcurrentHashMap
+//
+
+static void BURGER_API SumConcurrentHashMap(
+	const uint32_t& rKey, const uint32_t& rValue, void* pContext) BURGER_NOEXCEPT
+{
+	static_cast<uint32_t*>(pContext)[0] += rKey + rValue;
+}
+
+struct ConcurrentHashMapTest_t {
+	Burger::ConcurrentHashMap<uint32_t, uint32_t>* m_pMap;
+	uint32_t m_uSeed;
+	uint32_t m_uCount;
+	uint32_t m_uKeyRange;
+	uint32_t m_uWritePercent;
+	volatile uint32_t m_uInserted;
+};
+
+// Expose the shard array to test its alignment
+class ConcurrentHashMapAlignTest
+	: public Burger::ConcurrentHashMap<uint32_t, uint32_t> {
+public:
+	ConcurrentHashMapAlignTest(uintptr_t uShardCount) BURGER_NOEXCEPT
+		: Burger::ConcurrentHashMap<uint32_t, uint32_t>(
+			  Burger::SDBMHashFunctor, uShardCount)
+	{
+	}
+	uint_t IsAligned(void) const BURGER_NOEXCEPT
+	{
+		uintptr_t i = 0;
+		do {
+			if (reinterpret_cast<uintptr_t>(GetShard(i)) &
+				(kShardAlignment - 1)) {
+				return FALSE;
+			}
+		} while (++i <= m_uShardMask);
+		return TRUE;
+	}
+};
+
+static uintptr_t BURGER_API ConcurrentHashMapThread(
+	void* pInput) BURGER_NOEXCEPT
+{
+	ConcurrentHashMapTest_t* pTest =
+		static_cast<ConcurrentHashMapTest_t*>(pInput);
+	Burger::ConcurrentHashMap<uint32_t, uint32_t>* pMap = pTest->m_pMap;
+	uint32_t uSeed = pTest->m_uSeed;
+	uint32_t uCount = pTest->m_uCount;
+	uint32_t uInserted = 0;
+	do {
+		// Linear congruential generator for keys
+		uSeed = (uSeed * 1664525U) + 1013904223U;
+		const uint32_t uKey = (uSeed >> 8U) % pTest->m_uKeyRange;
+		if (((uSeed >> 1U) % 100U) < pTest->m_uWritePercent) {
+			uInserted += pMap->find_or_insert(uKey, uKey * 3U);
+		} else {
+			uint32_t uValue;
+			pMap->find(uKey, &uValue);
+		}
+	} while (--uCount);
+	Burger::atomic_set(&pTest->m_uInserted, uInserted);
+	return 0;
+}
+
+// Memory manager where every allocation fails
+static void* BURGER_API FailAllocate(
+	Burger::MemoryManager* /* pThis */, uintptr_t /* uSize */)
+{
+	return nullptr;
+}
+
+static void BURGER_API FailFree(
+	Burger::MemoryManager* /* pThis */, const void* /* pInput */)
+{
+}
+
+static void* BURGER_API FailReallocate(Burger::MemoryManager* /* pThis */,
+	const void* /* pInput */, uintptr_t /* uSize */)
+{
+	return nullptr;
+}
+
+static void BURGER_API FailShutdown(Burger::MemoryManager* /* pThis */) {}
+
+// A map whose shards couldn't be allocated must act empty and not crash
+static uint_t TestConcurrentHashMapNoMemory(void) BURGER_NOEXCEPT
+{
+	Burger::MemoryManager Fail;
+	Fail.m_pAllocate = FailAllocate;
+	Fail.m_pFree = FailFree;
+	Fail.m_pReallocate = FailReallocate;
+	Fail.m_pShutdown = FailShutdown;
+	Burger::MemoryManager* pPrevious =
+		Burger::GlobalMemoryManager::init(&Fail);
+	Burger::ConcurrentHashMap<uint32_t, uint32_t> Map;
+	Burger::GlobalMemoryManager::init(pPrevious);
+
+	uint32_t uValue = 7;
+	uint_t uFailure = Map.is_valid() || Map.get_shard_count() ||
+		(Map.set(1, 2) != Burger::kErrorOutOfMemory) ||
+		Map.find_or_insert(1, 2, &uValue) || Map.find(1, &uValue) ||
+		Map.contains(1) || Map.size() || (uValue != 7);
+	Map.erase(1);
+	Map.clear();
+	uint32_t uSum = 0;
+	Map.for_each(SumConcurrentHashMap, &uSum);
+	Burger::HashMap<uint32_t, uint32_t> Snapshot;
+	Map.snapshot(&Snapshot);
+	uFailure |= uSum || Snapshot.GetEntryCount();
+	ReportFailure("ConcurrentHashMap without memory failed", uFailure);
+	return uFailure;
+}
+
+static uint_t TestConcurrentHashMap(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = FALSE;
+
+	Burger::ConcurrentHashMap<uint32_t, uint32_t> Map(
+		Burger::SDBMHashFunctor, 5);
+	uint_t uTest = Map.get_shard_count() != 8;
+	uFailure |= uTest;
+	ReportFailure("ConcurrentHashMap::get_shard_count() = %u, expected 8",
+		uTest, static_cast<uint_t>(Map.get_shard_count()));
+
+	// Every shard must start on its own cache line
+	uintptr_t uShardCount = 1;
+	do {
+		ConcurrentHashMapAlignTest AlignTest(uShardCount);
+		uTest = !AlignTest.IsAligned();
+		uFailure |= uTest;
+		ReportFailure("ConcurrentHashMap with %u shards isn't aligned", uTest,
+			static_cast<uint_t>(uShardCount));
+		uShardCount <<= 1U;
+	} while (uShardCount <= 32U);
+
+	// Fill with known data
+	uint32_t i = 0;
+	do {
+		uTest = !Map.find_or_insert(i, i * 3U);
+		uFailure |= uTest;
+		ReportFailure(
+			"ConcurrentHashMap::find_or_insert(%u) didn't insert", uTest, i);
+	} while (++i < 1000U);
+
+	uint32_t uValue = 0;
+	uTest = Map.find_or_insert(10U, 999U, &uValue) || (uValue != 30U);
+	uFailure |= uTest;
+	ReportFailure("ConcurrentHashMap::find_or_insert(10) = %u, expected 30",
+		uTest, uValue);
+
+	uTest = !Map.find(500U, &uValue) || (uValue != 1500U);
+	uFailure |= uTest;
+	ReportFailure(
+		"ConcurrentHashMap::find(500) = %u, expected 1500", uTest, uValue);
+
+	Map.erase(500U);
+	uTest = Map.contains(500U) || (Map.size() != 999U);
+	uFailure |= uTest;
+	ReportFailure("ConcurrentHashMap::erase(500) failed", uTest);
+
+	// Every key and value is visited once
+	uint32_t uSum = 0;
+	Map.for_each(SumConcurrentHashMap, &uSum);
+	const uint32_t uExpected = (((999U * 1000U) / 2U) * 4U) - 2000U;
+	uTest = uSum != uExpected;
+	uFailure |= uTest;
+	ReportFailure("ConcurrentHashMap::for_each() sum = %u, expected %u", uTest,
+		uSum, uExpected);
+
+	Burger::HashMap<uint32_t, uint32_t> Snapshot;
+	Map.snapshot(&Snapshot);
+	uTest = (Snapshot.GetEntryCount() != 999U) ||
+		!Snapshot.GetData(999U, &uValue) || (uValue != 2997U);
+	uFailure |= uTest;
+	ReportFailure("ConcurrentHashMap::snapshot() failed", uTest);
+
+	// Race threads to insert overlapping keys, only one may win per key
+	Map.clear();
+	ConcurrentHashMapTest_t Tests[4];
+	Burger::Thread Threads[4];
+	i = 0;
+	do {
+		Tests[i].m_pMap = &Map;
+		Tests[i].m_uSeed = i;
+		Tests[i].m_uCount = 20000U;
+		Tests[i].m_uKeyRange = 4096U;
+		Tests[i].m_uWritePercent = 100U;
+		Tests[i].m_uInserted = 0;
+		Threads[i].start(ConcurrentHashMapThread, &Tests[i], "HashMapTest");
+	} while (++i < 4U);
+
+	uint32_t uInserted = 0;
+	i = 0;
+	do {
+		Threads[i].wait();
+		uInserted += Burger::atomic_get(&Tests[i].m_uInserted);
+	} while (++i < 4U);
+
+	uTest = uInserted != Map.size();
+	uFailure |= uTest;
+	ReportFailure("ConcurrentHashMap threads inserted %u, size is %u", uTest,
+		uInserted, static_cast<uint_t>(Map.size()));
+	return uFailure;
+}
+
+//
+// Time ConcurrentHashMap with 1, 2, 4 and 8 threads
+//
+
+static void TimeConcurrentHashMap(
+	uint32_t uWritePercent, const char* pName) BURGER_NOEXCEPT
+{
+	uint32_t uThreadCount = 1;
+	do {
+		Burger::ConcurrentHashMap<uint32_t, uint32_t> Map;
+
+		// Prefill so reads hit
+		uint32_t i = 0;
+		do {
+			Map.set(i, i);
+		} while (++i < 32768U);
+
+		ConcurrentHashMapTest_t Tests[8];
+		Burger::Thread Threads[8];
+		const uint64_t uMark = Burger::Tick::read_high_precision();
+		i = 0;
+		do {
+			Tests[i].m_pMap = &Map;
+			Tests[i].m_uSeed = i * 0x1234567U;
+			Tests[i].m_uCount = 250000U;
+			Tests[i].m_uKeyRange = 65536U;
+			Tests[i].m_uWritePercent = uWritePercent;
+			Tests[i].m_uInserted = 0;
+			Threads[i].start(ConcurrentHashMapThread, &Tests[i], pName);
+		} while (++i < uThreadCount);
+		i = 0;
+		do {
+			Threads[i].wait();
+		} while (++i < uThreadCount);
+		const uint64_t uElapsed = Burger::Tick::read_high_precision() - uMark;
+
+		const double dSeconds = static_cast<double>(uElapsed) /
+			static_cast<double>(Burger::Tick::get_high_precision_frequency());
+		Message("ConcurrentHashMap %s, %u threads, %.2f Mops/sec", pName,
+			uThreadCount,
+			(static_cast<double>(uThreadCount) * 250000.0) /
+				(dSeconds * 1000000.0));
+		uThreadCount <<= 1U;
+	} while (uThreadCount <= 8U);
+}
+
 //
 // Test hash code
 //
@@ -539,6 +828,7 @@ int BURGER_API TestBrhashes(uint_t uVerbose) BURGER_NOEXCEPT
 
 	uint_t uResult = TestAdler16();
 	uResult |= TestAdler32();
+	uResult |= TestCombineAdler32();
 	uResult |= TestCRC32B();
 	uResult |= TestCRC32();
 	uResult |= TestCRC16IBM();
@@ -548,6 +838,13 @@ int BURGER_API TestBrhashes(uint_t uVerbose) BURGER_NOEXCEPT
 	uResult |= TestSHA1();
 	uResult |= TestGOST();
 	uResult |= TestGUID();
+	uResult |= TestConcurrentHashMap();
+	uResult |= TestConcurrentHashMapNoMemory();
+
+	if (!uResult && (uVerbose & VERBOSE_TIME)) {
+		TimeConcurrentHashMap(5, "read heavy");
+		TimeConcurrentHashMap(90, "write heavy");
+	}
 
 	if (!uResult && (uVerbose & VERBOSE_MSG)) {
 		Message("Passed all Hashing tests!");
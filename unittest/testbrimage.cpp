@@ -0,0 +1,926 @@
+/***************************************
+
+	Unit tests for the Image class
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#include "testbrimage.h"
+#include "brimage.h"
+#include "brmemoryfunctions.h"
+#include "brpalette.h"
+#include "brtick.h"
+#include "common.h"
+
+using namespace Burger;
+
+// Pixel types with the largest error allowed for red, green, blue and alpha
+// after a round trip from PIXELTYPE8888
+struct ConvertTolerance_t {
+	Image::ePixelTypes m_eType;
+	const char* m_pName;
+	uint_t m_uTolerance[4];
+	uint_t m_bHasAlpha;
+};
+
+static const ConvertTolerance_t g_ConvertTypes[] = {
+	{Image::PIXELTYPE332, "332", {36, 36, 85, 0}, FALSE},
+	{Image::PIXELTYPE4444, "4444", {17, 17, 17, 17}, TRUE},
+	{Image::PIXELTYPE1555, "1555", {8, 8, 8, 0}, TRUE},
+	{Image::PIXELTYPE555, "555", {8, 8, 8, 0}, FALSE},
+	{Image::PIXELTYPE565, "565", {8, 4, 8, 0}, FALSE},
+	{Image::PIXELTYPE888, "888", {0, 0, 0, 0}, FALSE},
+	{Image::PIXELTYPE1010102, "1010102", {0, 0, 0, 85}, TRUE},
+	{Image::PIXELTYPE8888, "8888", {0, 0, 0, 0}, TRUE}};
+
+/***************************************
+
+	Fill an RGBA8888 image with a pattern that uses all values
+
+***************************************/
+
+static void BURGER_API FillPattern(Image* pImage) BURGER_NOEXCEPT
+{
+	uint8_t* pRow = pImage->GetImage();
+	uint_t uSeed = 0x1234U;
+	uint_t y = 0;
+	do {
+		uint_t x = 0;
+		do {
+			uSeed = (uSeed * 1103515245U) + 12345U;
+			pRow[(x * 4) + 0] = static_cast<uint8_t>(uSeed >> 8U);
+			pRow[(x * 4) + 1] = static_cast<uint8_t>(uSeed >> 16U);
+			pRow[(x * 4) + 2] = static_cast<uint8_t>(uSeed >> 24U);
+			pRow[(x * 4) + 3] = static_cast<uint8_t>(x + y);
+		} while (++x < pImage->GetWidth());
+		pRow += pImage->GetStride();
+	} while (++y < pImage->GetHeight());
+}
+
+/***************************************
+
+	Return non-zero if the rows of two images with the same type differ
+
+***************************************/
+
+static uint_t BURGER_API CompareImages(
+	const Image* pFirst, const Image* pSecond) BURGER_NOEXCEPT
+{
+	const uintptr_t uLength =
+		((static_cast<uintptr_t>(pFirst->GetWidth()) *
+			 pFirst->GetBitsPerPixel()) +
+			7U) >>
+		3U;
+	uint_t y = 0;
+	do {
+		if (MemoryCompare(pFirst->GetImage() + (y * pFirst->GetStride()),
+				pSecond->GetImage() + (y * pSecond->GetStride()), uLength)) {
+			return TRUE;
+		}
+	} while (++y < pFirst->GetHeight());
+	return FALSE;
+}
+
+/***************************************
+
+	Convert 8888 to every type and back and check the error
+
+***************************************/
+
+static uint_t BURGER_API TestConvertRoundTrip(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+	Image Source;
+	Image Middle;
+	Image Result;
+	// Odd width to exercise the vector remainders
+	const uint_t uWidth = 301;
+	const uint_t uHeight = 7;
+	Source.Init(uWidth, uHeight, Image::PIXELTYPE8888);
+	Result.Init(uWidth, uHeight, Image::PIXELTYPE8888);
+	FillPattern(&Source);
+
+	const ConvertTolerance_t* pWork = g_ConvertTypes;
+	uintptr_t uTypes = BURGER_ARRAYSIZE(g_ConvertTypes);
+	do {
+		Middle.Init(uWidth, uHeight, pWork->m_eType);
+		uint_t uTest = Middle.Convert(&Source) != 0;
+		uTest |= Result.Convert(&Middle) != 0;
+		ReportFailure("Image::Convert() 8888 to %s failed", uTest,
+			pWork->m_pName);
+		uFailure |= uTest;
+		if (!uTest) {
+			uint_t y = 0;
+			do {
+				const uint8_t* pSource =
+					Source.GetImage() + (y * Source.GetStride());
+				const uint8_t* pResult =
+					Result.GetImage() + (y * Result.GetStride());
+				uint_t x = 0;
+				do {
+					uint_t uIndex = 0;
+					do {
+						uint_t uExpected = pSource[uIndex];
+						if (uIndex == 3) {
+							// 1555 has 1 bit of alpha, the rest are opaque
+							if (pWork->m_eType == Image::PIXELTYPE1555) {
+								uExpected = (uExpected & 0x80U) ? 255U : 0U;
+							} else if (!pWork->m_bHasAlpha) {
+								uExpected = 255;
+							}
+						}
+						const uint_t uValue = pResult[uIndex];
+						const uint_t uDelta = (uValue > uExpected) ?
+							uValue - uExpected :
+							uExpected - uValue;
+						uTest = uDelta > pWork->m_uTolerance[uIndex];
+						ReportFailure(
+							"Image::Convert() 8888 to %s to 8888 pixel %u,%u "
+							"channel %u = %u, expected %u",
+							uTest, pWork->m_pName, x, y, uIndex, uValue,
+							uExpected);
+						uFailure |= uTest;
+					} while (++uIndex < 4);
+					pSource += 4;
+					pResult += 4;
+				} while (++x < uWidth);
+			} while (++y < uHeight);
+		}
+		++pWork;
+	} while (--uTypes);
+	return uFailure;
+}
+
+/***************************************
+
+	Test the direct converters against a per pixel version
+
+***************************************/
+
+static uint_t BURGER_API TestConvertDirect(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+	Image Source;
+	Image Output;
+	uint_t uWidth = 1;
+	do {
+		// 888 to 8888
+		Source.Init(uWidth, 2, Image::PIXELTYPE888);
+		Output.Init(uWidth, 2, Image::PIXELTYPE8888);
+		uint8_t* pSource = Source.GetImage();
+		uint_t i = 0;
+		do {
+			pSource[i] = static_cast<uint8_t>((i * 7) + uWidth);
+		} while (++i < (uWidth * 3));
+		uint_t uTest = Output.Convert(&Source) != 0;
+		const uint8_t* pOutput = Output.GetImage();
+		i = 0;
+		do {
+			uTest |= (pOutput[(i * 4) + 0] != pSource[(i * 3) + 0]) ||
+				(pOutput[(i * 4) + 1] != pSource[(i * 3) + 1]) ||
+				(pOutput[(i * 4) + 2] != pSource[(i * 3) + 2]) ||
+				(pOutput[(i * 4) + 3] != 0xFF);
+		} while (++i < uWidth);
+		ReportFailure(
+			"Image::Convert() 888 to 8888 width %u failed", uTest, uWidth);
+		uFailure |= uTest;
+
+		// 8888 to 888
+		Source.Init(uWidth, 2, Image::PIXELTYPE8888);
+		Output.Init(uWidth, 2, Image::PIXELTYPE888);
+		FillPattern(&Source);
+		uTest = Output.Convert(&Source) != 0;
+		pSource = Source.GetImage();
+		pOutput = Output.GetImage();
+		i = 0;
+		do {
+			uTest |= (pOutput[(i * 3) + 0] != pSource[(i * 4) + 0]) ||
+				(pOutput[(i * 3) + 1] != pSource[(i * 4) + 1]) ||
+				(pOutput[(i * 3) + 2] != pSource[(i * 4) + 2]);
+		} while (++i < uWidth);
+		ReportFailure(
+			"Image::Convert() 8888 to 888 width %u failed", uTest, uWidth);
+		uFailure |= uTest;
+
+		// 8888 to 565
+		Output.Init(uWidth, 2, Image::PIXELTYPE565);
+		uTest = Output.Convert(&Source) != 0;
+		const uint16_t* p565 =
+			reinterpret_cast<const uint16_t*>(Output.GetImage());
+		i = 0;
+		do {
+			const uint_t uExpected = ((pSource[(i * 4) + 0] & 0xF8U) << 8U) |
+				((pSource[(i * 4) + 1] & 0xFCU) << 3U) |
+				(pSource[(i * 4) + 2] >> 3U);
+			uTest |= p565[i] != uExpected;
+		} while (++i < uWidth);
+		ReportFailure(
+			"Image::Convert() 8888 to 565 width %u failed", uTest, uWidth);
+		uFailure |= uTest;
+	} while (++uWidth < 41);
+	return uFailure;
+}
+
+/***************************************
+
+	Test palette expansion and nearest color matching
+
+***************************************/
+
+static uint_t BURGER_API TestConvertPalette(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+	RGBAWord8_t Palette[256];
+	uint_t i = 0;
+	do {
+		Palette[i].m_uRed = static_cast<uint8_t>(i);
+		Palette[i].m_uGreen = static_cast<uint8_t>(255 - i);
+		Palette[i].m_uBlue = static_cast<uint8_t>(i * 3);
+		Palette[i].m_uAlpha = static_cast<uint8_t>(i ^ 0x55);
+	} while (++i < 256);
+
+	// 8 bit to 8888
+	Image Source;
+	Image Output;
+	Source.Init(37, 3, Image::PIXELTYPE8BIT);
+	Output.Init(37, 3, Image::PIXELTYPE8888);
+	uint_t y = 0;
+	do {
+		uint8_t* pRow = Source.GetImage() + (y * Source.GetStride());
+		i = 0;
+		do {
+			pRow[i] = static_cast<uint8_t>((i * 13) + y);
+		} while (++i < 37);
+	} while (++y < 3);
+	uint_t uTest = Output.Convert(&Source, Palette) != 0;
+	y = 0;
+	do {
+		const uint8_t* pRow = Source.GetImage() + (y * Source.GetStride());
+		const uint8_t* pPixel = Output.GetImage() + (y * Output.GetStride());
+		i = 0;
+		do {
+			const RGBAWord8_t* pColor = &Palette[pRow[i]];
+			uTest |= (pPixel[0] != pColor->m_uRed) ||
+				(pPixel[1] != pColor->m_uGreen) ||
+				(pPixel[2] != pColor->m_uBlue) ||
+				(pPixel[3] != pColor->m_uAlpha);
+			pPixel += 4;
+		} while (++i < 37);
+	} while (++y < 3);
+	ReportFailure("Image::Convert() 8 bit to 8888 failed", uTest);
+	uFailure |= uTest;
+
+	// Back to 8 bit gives the same indexes
+	Image Indexes;
+	Indexes.Init(37, 3, Image::PIXELTYPE8BIT);
+	uTest = Indexes.Convert(&Output, Palette) != 0;
+	uTest |= CompareImages(&Source, &Indexes);
+	ReportFailure("Image::Convert() 8888 to 8 bit failed", uTest);
+	uFailure |= uTest;
+
+	// 4 bit pixels are packed with the first pixel in the high nibble
+	Image Nibbles;
+	Nibbles.Init(5, 1, Image::PIXELTYPE4BIT);
+	Nibbles.GetImage()[0] = 0x12;
+	Nibbles.GetImage()[1] = 0x34;
+	Nibbles.GetImage()[2] = 0x50;
+	Output.Init(5, 1, Image::PIXELTYPE8888);
+	uTest = Output.Convert(&Nibbles, Palette) != 0;
+	i = 0;
+	do {
+		uTest |= Output.GetImage()[i * 4] != (i + 1);
+	} while (++i < 5);
+	ReportFailure("Image::Convert() 4 bit to 8888 failed", uTest);
+	uFailure |= uTest;
+
+	// 8888 to 4 bit and back
+	Image Nibbles2;
+	Nibbles2.Init(5, 1, Image::PIXELTYPE4BIT);
+	uTest = Nibbles2.Convert(&Output, Palette) != 0;
+	// The unused low nibble of the last byte is undefined
+	uTest |= MemoryCompare(Nibbles.GetImage(), Nibbles2.GetImage(), 2) != 0;
+	uTest |= (Nibbles2.GetImage()[2] & 0xF0U) != 0x50U;
+	ReportFailure("Image::Convert() 8888 to 4 bit failed", uTest);
+	uFailure |= uTest;
+
+	// No palette is a greyscale ramp
+	Image Bits;
+	Bits.Init(8, 1, Image::PIXELTYPE1BIT);
+	Bits.GetImage()[0] = 0xA5;
+	Output.Init(8, 1, Image::PIXELTYPE8888);
+	uTest = Output.Convert(&Bits) != 0;
+	i = 0;
+	do {
+		const uint_t uExpected = ((0xA5U >> (7 - i)) & 1U) ? 255U : 0U;
+		uTest |= (Output.GetImage()[i * 4] != uExpected) ||
+			(Output.GetImage()[(i * 4) + 3] != 255);
+	} while (++i < 8);
+	ReportFailure("Image::Convert() 1 bit greyscale failed", uTest);
+	uFailure |= uTest;
+	return uFailure;
+}
+
+/***************************************
+
+	Test alpha premultiplication
+
+***************************************/
+
+static uint_t BURGER_API TestConvertPremultiply(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+	Image Source;
+	Image Output;
+	Source.Init(256, 1, Image::PIXELTYPE8888);
+	uint8_t* pSource = Source.GetImage();
+	uint_t i = 0;
+	do {
+		pSource[(i * 4) + 0] = 255;
+		pSource[(i * 4) + 1] = 128;
+		pSource[(i * 4) + 2] = 0;
+		pSource[(i * 4) + 3] = static_cast<uint8_t>(i);
+	} while (++i < 256);
+
+	Output.Init(256, 1, Image::PIXELTYPE8888);
+	uint_t uTest = Output.Convert(&Source, NULL, Image::CONVERT_PREMULTIPLY);
+	const uint8_t* pOutput = Output.GetImage();
+	i = 0;
+	do {
+		// Rounded (value*alpha)/255
+		uTest |= (pOutput[(i * 4) + 0] != i) ||
+			(pOutput[(i * 4) + 1] != (((128 * i) + 127) / 255)) ||
+			(pOutput[(i * 4) + 2] != 0) || (pOutput[(i * 4) + 3] != i);
+	} while (++i < 256);
+	ReportFailure("Image::Convert() premultiply 8888 failed", uTest);
+	uFailure |= uTest;
+
+	// Premultiplied palette
+	RGBAWord8_t Palette[256];
+	i = 0;
+	do {
+		Palette[i].m_uRed = 255;
+		Palette[i].m_uGreen = 255;
+		Palette[i].m_uBlue = 255;
+		Palette[i].m_uAlpha = static_cast<uint8_t>(i);
+	} while (++i < 256);
+	Image Indexed;
+	Indexed.Init(256, 1, Image::PIXELTYPE8BIT);
+	i = 0;
+	do {
+		Indexed.GetImage()[i] = static_cast<uint8_t>(i);
+	} while (++i < 256);
+	uTest =
+		Output.Convert(&Indexed, Palette, Image::CONVERT_PREMULTIPLY) != 0;
+	i = 0;
+	do {
+		uTest |= (pOutput[(i * 4) + 0] != i) || (pOutput[(i * 4) + 3] != i);
+	} while (++i < 256);
+	ReportFailure("Image::Convert() premultiply 8 bit failed", uTest);
+	uFailure |= uTest;
+
+	// Opaque formats are unchanged
+	Image Opaque;
+	Opaque.Init(256, 1, Image::PIXELTYPE565);
+	uTest = Opaque.Convert(&Source) != 0;
+	Image Opaque2;
+	Opaque2.Init(256, 1, Image::PIXELTYPE565);
+	uTest |= Opaque2.Convert(&Opaque, NULL, Image::CONVERT_PREMULTIPLY) != 0;
+	uTest |= CompareImages(&Opaque, &Opaque2);
+	ReportFailure("Image::Convert() premultiply 565 failed", uTest);
+	uFailure |= uTest;
+	return uFailure;
+}
+
+/***************************************
+
+	Threaded conversion must match single threaded conversion
+
+***************************************/
+
+static uint_t BURGER_API TestConvertThreads(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+	Image Source;
+	Image Single;
+	Image Threaded;
+	Source.Init(509, 263, Image::PIXELTYPE8888);
+	FillPattern(&Source);
+
+	const ConvertTolerance_t* pWork = g_ConvertTypes;
+	uintptr_t uTypes = BURGER_ARRAYSIZE(g_ConvertTypes);
+	do {
+		Single.Init(509, 263, pWork->m_eType);
+		Threaded.Init(509, 263, pWork->m_eType);
+		uint_t uTest = Single.Convert(&Source, NULL, 0, 1) != 0;
+		uTest |= Threaded.Convert(&Source, NULL, 0, 4) != 0;
+		uTest |= CompareImages(&Single, &Threaded);
+		ReportFailure("Image::Convert() 8888 to %s with 4 threads failed",
+			uTest, pWork->m_pName);
+		uFailure |= uTest;
+		++pWork;
+	} while (--uTypes);
+
+	// Mismatched sizes are rejected
+	Single.Init(508, 263, Image::PIXELTYPE8888);
+	uint_t uTest = Single.Convert(&Source) == 0;
+	ReportFailure("Image::Convert() accepted mismatched sizes", uTest);
+	uFailure |= uTest;
+	return uFailure;
+}
+
+/***************************************
+
+	Test mip map generation
+
+***************************************/
+
+static uint_t BURGER_API TestGenerateMipMaps(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+
+	// Box filter against a per pixel version
+	Image MipMaps;
+	MipMaps.Init(64, 32, Image::PIXELTYPE8888, 7);
+	Image Base;
+	Base.Init(64, 32, Image::PIXELTYPE8888, 64 * 4, MipMaps.GetImage(),
+		Image::FLAGS_IMAGENOTALLOCATED);
+	FillPattern(&Base);
+	uint_t uTest = MipMaps.GenerateMipMaps();
+	uint_t uLevel = 1;
+	do {
+		const uint8_t* pSource = MipMaps.GetImage(uLevel - 1);
+		const uintptr_t uSourceStride = MipMaps.GetStride(uLevel - 1);
+		const uint_t uWidth = MipMaps.GetWidth(uLevel);
+		const uint_t uHeight = MipMaps.GetHeight(uLevel);
+		if (!uHeight) {
+			break;
+		}
+		const uint8_t* pDest = MipMaps.GetImage(uLevel);
+		uint_t y = 0;
+		do {
+			const uint8_t* pRow0 = pSource + (y * 2 * uSourceStride);
+			const uint8_t* pRow1 = pRow0 + uSourceStride;
+			const uint8_t* pRow =
+				pDest + (y * MipMaps.GetStride(uLevel));
+			uint_t x = 0;
+			do {
+				uint_t i = 0;
+				do {
+					const uint_t uExpected =
+						(pRow0[i] + pRow0[i + 4] + pRow1[i] + pRow1[i + 4] +
+							2) >>
+						2;
+					uTest |= pRow[i] != uExpected;
+				} while (++i < 4);
+				pRow0 += 8;
+				pRow1 += 8;
+				pRow += 4;
+			} while (++x < uWidth);
+		} while (++y < uHeight);
+	} while (++uLevel < 7);
+	ReportFailure("Image::GenerateMipMaps() box 8888 failed", uTest);
+	uFailure |= uTest;
+
+	// A solid color stays the same in every type and filter
+	static const Image::ePixelTypes Types[] = {Image::PIXELTYPE8888,
+		Image::PIXELTYPE888, Image::PIXELTYPE565, Image::PIXELTYPE4444};
+	static const uint_t Filters[] = {Image::MIPMAP_BOX,
+		Image::MIPMAP_BOX | Image::MIPMAP_SRGB, Image::MIPMAP_KAISER,
+		Image::MIPMAP_KAISER | Image::MIPMAP_SRGB};
+	uintptr_t uType = 0;
+	do {
+		Image Solid;
+		Solid.Init(40, 24, Types[uType], 6);
+		Image Source;
+		Source.Init(40, 24, Image::PIXELTYPE8888);
+		uint8_t* pPixel = Source.GetImage();
+		uint_t i = 0;
+		do {
+			pPixel[(i * 4) + 0] = 0x88;
+			pPixel[(i * 4) + 1] = 0x44;
+			pPixel[(i * 4) + 2] = 0xCC;
+			pPixel[(i * 4) + 3] = 0xFF;
+		} while (++i < (40 * 24));
+		Image Level0;
+		Level0.Init(40, 24, Types[uType], Solid.GetStride(),
+			Solid.GetImage(), Image::FLAGS_IMAGENOTALLOCATED);
+		Level0.Convert(&Source);
+		uintptr_t uFilter = 0;
+		do {
+			uTest = Solid.GenerateMipMaps(Filters[uFilter]);
+			uLevel = 1;
+			do {
+				const uintptr_t uBytes =
+					(Solid.GetWidth(uLevel) * Solid.GetBitsPerPixel()) >> 3;
+				const uint8_t* pRow = Solid.GetImage(uLevel);
+				uint_t y = 0;
+				do {
+					uTest |= MemoryCompare(pRow, Solid.GetImage(), uBytes);
+					pRow += Solid.GetStride(uLevel);
+				} while (++y < Solid.GetHeight(uLevel));
+			} while (++uLevel < 5);
+			ReportFailure(
+				"Image::GenerateMipMaps() solid color type %u filter %u "
+				"failed",
+				uTest, static_cast<uint_t>(Types[uType]),
+				Filters[uFilter]);
+			uFailure |= uTest;
+		} while (++uFilter < BURGER_ARRAYSIZE(Filters));
+	} while (++uType < BURGER_ARRAYSIZE(Types));
+
+	// Black and white average to half in linear space with sRGB
+	Image Checker;
+	Checker.Init(2, 2, Image::PIXELTYPE888, 2);
+	uint8_t* pChecker = Checker.GetImage();
+	memory_clear(pChecker, 12);
+	memory_set(pChecker, 255, 3);
+	memory_set(pChecker + 9, 255, 3);
+	Checker.GenerateMipMaps(Image::MIPMAP_BOX);
+	uTest = Checker.GetImage(1)[0] != 128;
+	Checker.GenerateMipMaps(Image::MIPMAP_BOX | Image::MIPMAP_SRGB);
+	const uint_t uSRGB = Checker.GetImage(1)[0];
+	uTest |= (uSRGB < 187) || (uSRGB > 188);
+	ReportFailure("Image::GenerateMipMaps() sRGB average is %u", uTest,
+		uSRGB);
+	uFailure |= uTest;
+
+	// Threaded generation matches single threaded
+	Image Single;
+	Image Threaded;
+	Single.Init(512, 300, Image::PIXELTYPE8888, 10);
+	Threaded.Init(512, 300, Image::PIXELTYPE8888, 10);
+	Base.Init(512, 300, Image::PIXELTYPE8888, Single.GetStride(),
+		Single.GetImage(), Image::FLAGS_IMAGENOTALLOCATED);
+	FillPattern(&Base);
+	const uintptr_t uSize = Single.GetSuggestedBufferSize();
+	uintptr_t uFilter = 0;
+	do {
+		memory_copy(Threaded.GetImage(), Single.GetImage(),
+			Single.GetStride() * 300);
+		uTest = Single.GenerateMipMaps(Filters[uFilter], 1);
+		uTest |= Threaded.GenerateMipMaps(Filters[uFilter], 4);
+		uTest |=
+			MemoryCompare(Single.GetImage(), Threaded.GetImage(), uSize) != 0;
+		ReportFailure(
+			"Image::GenerateMipMaps() filter %u with 4 threads failed",
+			uTest, Filters[uFilter]);
+		uFailure |= uTest;
+	} while (++uFilter < BURGER_ARRAYSIZE(Filters));
+
+	// Only the supported types with mip maps are allowed
+	Image Bad;
+	Bad.Init(16, 16, Image::PIXELTYPE8888);
+	uTest = !Bad.GenerateMipMaps();
+	Bad.Init(16, 16, Image::PIXELTYPE555, 4);
+	uTest |= !Bad.GenerateMipMaps();
+	ReportFailure("Image::GenerateMipMaps() accepted a bad image", uTest);
+	uFailure |= uTest;
+	return uFailure;
+}
+
+/***************************************
+
+	Test resampling
+
+***************************************/
+
+static uint_t BURGER_API TestResample(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+	static const Image::eResampleFilters Filters[] = {Image::RESAMPLE_NEAREST,
+		Image::RESAMPLE_BILINEAR, Image::RESAMPLE_BICUBIC,
+		Image::RESAMPLE_LANCZOS3};
+	static const Image::ePixelTypes Types[] = {
+		Image::PIXELTYPE8888, Image::PIXELTYPE888};
+
+	Image Source;
+	Image Source8888;
+	Image Output;
+	Source8888.Init(45, 31, Image::PIXELTYPE8888);
+	FillPattern(&Source8888);
+
+	// The same size is an exact copy with every filter
+	uintptr_t uType = 0;
+	do {
+		Source.Init(45, 31, Types[uType]);
+		Source.Convert(&Source8888);
+		Output.Init(45, 31, Types[uType]);
+		uintptr_t uFilter = 0;
+		do {
+			uint_t uTest = Output.Resample(&Source, Filters[uFilter]) != 0;
+			uTest |= CompareImages(&Source, &Output);
+			ReportFailure(
+				"Image::Resample() type %u filter %u same size failed",
+				uTest, static_cast<uint_t>(Types[uType]),
+				static_cast<uint_t>(Filters[uFilter]));
+			uFailure |= uTest;
+		} while (++uFilter < BURGER_ARRAYSIZE(Filters));
+	} while (++uType < BURGER_ARRAYSIZE(Types));
+
+	// Fixed point matches floating point when shrinking and growing
+	static const uint_t Sizes[][2] = {{20, 13}, {7, 3}, {97, 64}, {1, 1}};
+	float* pFloatInput =
+		static_cast<float*>(allocate_memory(45 * 31 * 4 * sizeof(float)));
+	float* pFloatOutput =
+		static_cast<float*>(allocate_memory(97 * 64 * 4 * sizeof(float)));
+	uint_t i = 0;
+	do {
+		pFloatInput[i] = static_cast<float>(Source8888.GetImage()[i]);
+	} while (++i < (45 * 31 * 4));
+	uintptr_t uSize = 0;
+	do {
+		const uint_t uWidth = Sizes[uSize][0];
+		const uint_t uHeight = Sizes[uSize][1];
+		Output.Init(uWidth, uHeight, Image::PIXELTYPE8888);
+		uintptr_t uFilter = 0;
+		do {
+			uint_t uTest = Output.Resample(&Source8888, Filters[uFilter]);
+			uTest |= Image::ResampleFloat(pFloatOutput, uWidth, uHeight,
+				uWidth * 4 * sizeof(float), pFloatInput, 45, 31,
+				45 * 4 * sizeof(float), 4, Filters[uFilter]);
+			if (!uTest) {
+				const uint8_t* pOutput = Output.GetImage();
+				i = 0;
+				do {
+					float fValue = pFloatOutput[i] + 0.5f;
+					if (fValue < 0.0f) {
+						fValue = 0.0f;
+					} else if (fValue > 255.0f) {
+						fValue = 255.0f;
+					}
+					const int iDelta =
+						static_cast<int>(pOutput[i]) - static_cast<int>(fValue);
+					uTest |= (iDelta < -2) || (iDelta > 2);
+				} while (++i < (uWidth * uHeight * 4));
+			}
+			ReportFailure("Image::Resample() 45x31 to %ux%u filter %u "
+						  "doesn't match ResampleFloat()",
+				uTest, uWidth, uHeight, static_cast<uint_t>(Filters[uFilter]));
+			uFailure |= uTest;
+		} while (++uFilter < BURGER_ARRAYSIZE(Filters));
+	} while (++uSize < BURGER_ARRAYSIZE(Sizes));
+	free_memory(pFloatInput);
+	free_memory(pFloatOutput);
+
+	// A solid color stays solid
+	Source.Init(33, 17, Image::PIXELTYPE888);
+	memory_set(Source.GetImage(), 0xC3, Source.GetStride() * 17);
+	Output.Init(70, 9, Image::PIXELTYPE888);
+	uintptr_t uFilter = 0;
+	do {
+		uint_t uTest = Output.Resample(&Source, Filters[uFilter]) != 0;
+		uint_t y = 0;
+		do {
+			const uint8_t* pRow = Output.GetImage() + (y * Output.GetStride());
+			i = 0;
+			do {
+				uTest |= pRow[i] != 0xC3;
+			} while (++i < (70 * 3));
+		} while (++y < 9);
+		ReportFailure("Image::Resample() solid color filter %u failed",
+			uTest, static_cast<uint_t>(Filters[uFilter]));
+		uFailure |= uTest;
+	} while (++uFilter < BURGER_ARRAYSIZE(Filters));
+
+	// Nearest doubles 16 bit pixels
+	Source.Init(3, 2, Image::PIXELTYPE565);
+	uint16_t* p565 = reinterpret_cast<uint16_t*>(Source.GetImage());
+	i = 0;
+	do {
+		p565[i] = static_cast<uint16_t>(0x1111U * (i + 1));
+	} while (++i < 6);
+	Output.Init(6, 4, Image::PIXELTYPE565);
+	uint_t uTest = Output.Resample(&Source, Image::RESAMPLE_NEAREST) != 0;
+	uint_t y = 0;
+	do {
+		const uint16_t* pRow =
+			reinterpret_cast<const uint16_t*>(Output.GetImage() +
+				(y * Output.GetStride()));
+		i = 0;
+		do {
+			uTest |= pRow[i] != (0x1111U * (((y >> 1) * 3) + (i >> 1) + 1));
+		} while (++i < 6);
+	} while (++y < 4);
+	ReportFailure("Image::Resample() nearest 565 failed", uTest);
+	uFailure |= uTest;
+
+	// Filters need 8 bits per channel
+	uTest = !Output.Resample(&Source, Image::RESAMPLE_BILINEAR);
+	Output.Init(6, 4, Image::PIXELTYPE8888);
+	uTest |= !Output.Resample(&Source, Image::RESAMPLE_NEAREST);
+	ReportFailure("Image::Resample() accepted a bad type", uTest);
+	uFailure |= uTest;
+
+	// Threaded matches single threaded
+	Source.Init(400, 300, Image::PIXELTYPE8888);
+	FillPattern(&Source);
+	Image Threaded;
+	Output.Init(333, 517, Image::PIXELTYPE8888);
+	Threaded.Init(333, 517, Image::PIXELTYPE8888);
+	uFilter = 0;
+	do {
+		uTest = Output.Resample(&Source, Filters[uFilter], 1) != 0;
+		uTest |= Threaded.Resample(&Source, Filters[uFilter], 4) != 0;
+		uTest |= CompareImages(&Output, &Threaded);
+		ReportFailure("Image::Resample() filter %u with 4 threads failed",
+			uTest, static_cast<uint_t>(Filters[uFilter]));
+		uFailure |= uTest;
+	} while (++uFilter < BURGER_ARRAYSIZE(Filters));
+	return uFailure;
+}
+
+/***************************************
+
+	Show the conversion speed of common type pairs
+
+***************************************/
+
+struct ConvertPair_t {
+	Image::ePixelTypes m_eInput;
+	Image::ePixelTypes m_eOutput;
+	uint_t m_uFlags;
+	const char* m_pName;
+};
+
+static void BURGER_API TimeConvert(void) BURGER_NOEXCEPT
+{
+	static const ConvertPair_t Pairs[] = {
+		{Image::PIXELTYPE888, Image::PIXELTYPE8888, 0, "888 to 8888"},
+		{Image::PIXELTYPE8888, Image::PIXELTYPE888, 0, "8888 to 888"},
+		{Image::PIXELTYPE8888, Image::PIXELTYPE565, 0, "8888 to 565"},
+		{Image::PIXELTYPE8BIT, Image::PIXELTYPE8888, 0, "8 bit to 8888"},
+		{Image::PIXELTYPE565, Image::PIXELTYPE8888, 0, "565 to 8888"},
+		{Image::PIXELTYPE8888, Image::PIXELTYPE4444, 0, "8888 to 4444"},
+		{Image::PIXELTYPE8888, Image::PIXELTYPE8888,
+			Image::CONVERT_PREMULTIPLY, "8888 premultiply"}};
+
+	const uint_t uWidth = 1024;
+	const uint_t uHeight = 512;
+	const uint_t uLoops = 10;
+	Image Source;
+	Image Output;
+	uintptr_t i = 0;
+	do {
+		const ConvertPair_t* pPair = &Pairs[i];
+		Source.Init(uWidth, uHeight, pPair->m_eInput);
+		Output.Init(uWidth, uHeight, pPair->m_eOutput);
+		memory_clear(Source.GetImage(), Source.GetStride() * uHeight);
+		uint64_t uMark = Tick::read_high_precision();
+		uint_t uLoop = 0;
+		do {
+			Output.Convert(&Source, NULL, pPair->m_uFlags);
+		} while (++uLoop < uLoops);
+		const uint64_t uSingle = Tick::read_high_precision() - uMark;
+
+		uMark = Tick::read_high_precision();
+		uLoop = 0;
+		do {
+			Output.Convert(&Source, NULL, pPair->m_uFlags, 4);
+		} while (++uLoop < uLoops);
+		const uint64_t uThreaded = Tick::read_high_precision() - uMark;
+
+		// Megapixels per second
+		const double dPixels =
+			static_cast<double>(uWidth) * uHeight * uLoops *
+			static_cast<double>(Tick::get_high_precision_frequency()) /
+			1000000.0;
+		Message("Image::Convert() %s, %.1f Mpixels/s, 4 threads %.1f "
+				"Mpixels/s",
+			pPair->m_pName, dPixels / static_cast<double>(uSingle),
+			dPixels / static_cast<double>(uThreaded));
+	} while (++i < BURGER_ARRAYSIZE(Pairs));
+}
+
+/***************************************
+
+	Show the speed of mip map generation
+
+***************************************/
+
+static void BURGER_API TimeGenerateMipMaps(void) BURGER_NOEXCEPT
+{
+	static const uint_t Filters[] = {Image::MIPMAP_BOX,
+		Image::MIPMAP_BOX | Image::MIPMAP_SRGB, Image::MIPMAP_KAISER,
+		Image::MIPMAP_KAISER | Image::MIPMAP_SRGB};
+	static const char* FilterNames[] = {
+		"box", "box sRGB", "Kaiser", "Kaiser sRGB"};
+	Image MipMaps;
+	MipMaps.Init(1024, 1024, Image::PIXELTYPE8888, 11);
+	memory_clear(MipMaps.GetImage(), MipMaps.GetSuggestedBufferSize());
+	const uint_t uLoops = 4;
+	uintptr_t i = 0;
+	do {
+		uint64_t uMark = Tick::read_high_precision();
+		uint_t uLoop = 0;
+		do {
+			MipMaps.GenerateMipMaps(Filters[i]);
+		} while (++uLoop < uLoops);
+		const uint64_t uSingle = Tick::read_high_precision() - uMark;
+
+		uMark = Tick::read_high_precision();
+		uLoop = 0;
+		do {
+			MipMaps.GenerateMipMaps(Filters[i], 4);
+		} while (++uLoop < uLoops);
+		const uint64_t uThreaded = Tick::read_high_precision() - uMark;
+
+		const double dScale = 1000.0 /
+			(static_cast<double>(Tick::get_high_precision_frequency()) *
+				static_cast<double>(uLoops));
+		Message("Image::GenerateMipMaps() 1024x1024 8888 %s, %.2f ms, 4 "
+				"threads %.2f ms",
+			FilterNames[i], static_cast<double>(uSingle) * dScale,
+			static_cast<double>(uThreaded) * dScale);
+	} while (++i < BURGER_ARRAYSIZE(Filters));
+}
+
+/***************************************
+
+	Show the speed of resampling
+
+***************************************/
+
+static void BURGER_API TimeResample(void) BURGER_NOEXCEPT
+{
+	static const Image::eResampleFilters Filters[] = {Image::RESAMPLE_NEAREST,
+		Image::RESAMPLE_BILINEAR, Image::RESAMPLE_BICUBIC,
+		Image::RESAMPLE_LANCZOS3};
+	static const char* FilterNames[] = {
+		"nearest", "bilinear", "bicubic", "Lanczos3"};
+	Image Source;
+	Source.Init(1024, 1024, Image::PIXELTYPE8888);
+	FillPattern(&Source);
+	Image Small;
+	Small.Init(512, 512, Image::PIXELTYPE8888);
+	Image Large;
+	Large.Init(1536, 1536, Image::PIXELTYPE8888);
+	const uint_t uLoops = 4;
+	const double dScale = 1000.0 /
+		(static_cast<double>(Tick::get_high_precision_frequency()) *
+			static_cast<double>(uLoops));
+	uintptr_t i = 0;
+	do {
+		uint64_t uMark = Tick::read_high_precision();
+		uint_t uLoop = 0;
+		do {
+			Small.Resample(&Source, Filters[i]);
+		} while (++uLoop < uLoops);
+		const uint64_t uShrink = Tick::read_high_precision() - uMark;
+
+		uMark = Tick::read_high_precision();
+		uLoop = 0;
+		do {
+			Large.Resample(&Source, Filters[i]);
+		} while (++uLoop < uLoops);
+		const uint64_t uGrow = Tick::read_high_precision() - uMark;
+
+		uMark = Tick::read_high_precision();
+		uLoop = 0;
+		do {
+			Large.Resample(&Source, Filters[i], 4);
+		} while (++uLoop < uLoops);
+		const uint64_t uThreaded = Tick::read_high_precision() - uMark;
+		Message("Image::Resample() 8888 %s, 1024 to 512 %.2f ms, 1024 to "
+				"1536 %.2f ms, 4 threads %.2f ms",
+			FilterNames[i], static_cast<double>(uShrink) * dScale,
+			static_cast<double>(uGrow) * dScale,
+			static_cast<double>(uThreaded) * dScale);
+	} while (++i < BURGER_ARRAYSIZE(Filters));
+}
+
+//
+// Perform all the tests for the Image class
+//
+
+int BURGER_API TestBrimage(uint_t uVerbose) BURGER_NOEXCEPT
+{
+	if (uVerbose & VERBOSE_MSG) {
+		Message("Running Image tests");
+	}
+
+	uint_t uTotal = TestConvertRoundTrip();
+	uTotal |= TestConvertDirect();
+	uTotal |= TestConvertPalette();
+	uTotal |= TestConvertPremultiply();
+	uTotal |= TestConvertThreads();
+	uTotal |= TestGenerateMipMaps();
+	uTotal |= TestResample();
+
+	if (!uTotal && (uVerbose & VERBOSE_TIME)) {
+		TimeConvert();
+		TimeGenerateMipMaps();
+		TimeResample();
+	}
+
+	if (!uTotal && (uVerbose & VERBOSE_MSG)) {
+		Message("Passed all Image tests!");
+	}
+	return static_cast<int>(uTotal);
+}
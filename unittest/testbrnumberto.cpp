@@ -13,8 +13,12 @@
 ***************************************/
 
 #include "testbrnumberto.h"
+#include "brasciito.h"
+#include "brmemoryfunctions.h"
 #include "brnumberto.h"
 #include "brstringfunctions.h"
+#include "brstructs.h"
+#include "brtick.h"
 #include "common.h"
 
 /***************************************
@@ -375,6 +379,233 @@ static uint_t BURGER_API TestNumberToAscii(void) BURGER_NOEXCEPT
 	return uFailure;
 }
 
+/***************************************
+
+	Test NumberToAscii(char *, double, uint_t) shortest round trip
+
+***************************************/
+
+struct NumberRealTests_t {
+	double m_dValue;
+	uint_t m_uDigits;
+	const char* m_pExpected;
+};
+
+static const NumberRealTests_t g_NumberRealTests[] = {{0.0, 0, "0"},
+	{-0.0, 0, "-0"}, {0.1, 0, "0.1"}, {1.0 / 3.0, 0, "0.3333333333333333"},
+	{100.0, 0, "100"}, {123456789012345680000.0, 0, "123456789012345680000"},
+	{1e21, 0, "1e+21"}, {1e-7, 0, "0.0000001"}, {1e-8, 0, "1e-8"},
+	{1.5e-6, 0, "0.0000015"},
+	{5e-324, 0, "5e-324"},
+	{1.7976931348623157e308, 0, "1.7976931348623157e+308"},
+	{2.5, 0, "2.5"}, {0.5, 0, "0.5"}, {2.5, 1, "2.5"}, {2.5, 3, "2.500"},
+	{1.0 / 3.0, 3, "0.333"}, {0.125, 2, "0.12"}, {0.375, 2, "0.38"},
+	{1.005, 2, "1.00"}, {-9.9999, 2, "-10.00"}};
+
+static uint_t BURGER_API TestNumberToAsciiReal(void) BURGER_NOEXCEPT
+{
+	char Buffer[64];
+	uint_t uFailure = FALSE;
+
+	const NumberRealTests_t* pWork = g_NumberRealTests;
+	uintptr_t uCount = BURGER_ARRAYSIZE(g_NumberRealTests);
+	do {
+		Burger::to_decimal_ascii(Buffer, pWork->m_dValue, pWork->m_uDigits);
+		const uint_t uTest = static_cast<uint_t>(
+			Burger::string_compare(Buffer, pWork->m_pExpected));
+		uFailure |= uTest;
+		ReportFailure(
+			"Burger::to_decimal_ascii(Buffer, %.17g, %u) = %s, expected %s", uTest,
+			pWork->m_dValue, pWork->m_uDigits, Buffer, pWork->m_pExpected);
+		++pWork;
+	} while (--uCount);
+
+	// Floats are printed with the fewest digits needed for a float
+	Burger::to_decimal_ascii(Buffer, 0.1f, 0);
+	uint_t uTest = static_cast<uint_t>(Burger::string_compare(Buffer, "0.1"));
+	uFailure |= uTest;
+	ReportFailure("Burger::to_decimal_ascii(Buffer, 0.1f, 0) = %s", uTest, Buffer);
+
+	Burger::to_decimal_ascii(Buffer, 3.4028235e38f, 0);
+	uTest =
+		static_cast<uint_t>(Burger::string_compare(Buffer, "3.4028235e+38"));
+	uFailure |= uTest;
+	ReportFailure(
+		"Burger::to_decimal_ascii(Buffer, 3.4028235e38f, 0) = %s", uTest, Buffer);
+	return uFailure;
+}
+
+/***************************************
+
+	Test AsciiToDouble(const char *, const char **)
+
+***************************************/
+
+struct AsciiToDoubleTests_t {
+	const char* m_pInput;
+	uint64_t m_uBits;
+};
+
+static const AsciiToDoubleTests_t g_AsciiToDoubleTests[] = {
+	{"0.1", 0x3FB999999999999AULL}, {"-0", 0x8000000000000000ULL},
+	{".5", 0x3FE0000000000000ULL}, {"5.", 0x4014000000000000ULL},
+	{"9007199254740993", 0x4340000000000000ULL},
+	{"9007199254740993.0000000001", 0x4340000000000001ULL},
+	{"7.3177701707893310e+15", 0x4339FF792393EDD3ULL},
+	{"123456789012345678901234567890", 0x45F8EE90FF6C373EULL},
+	{"0.000000000000000000000000000000000000000000001e45",
+		0x3FF0000000000000ULL},
+	{"2.2250738585072011e-308", 0x000FFFFFFFFFFFFFULL},
+	{"4.9406564584124654e-324", 0x0000000000000001ULL},
+	{"2.4703282292062327e-324", 0x0000000000000000ULL},
+	{"2.4703282292062328e-324", 0x0000000000000001ULL},
+	{"1e-400", 0x0000000000000000ULL},
+	{"1.7976931348623157e308", 0x7FEFFFFFFFFFFFFFULL},
+	{"1e400", 0x7FEFFFFFFFFFFFFFULL},
+	{"1.00000000000000011102230246251565404236316680908203125",
+		0x3FF0000000000000ULL},
+	{"1.00000000000000011102230246251565404236316680908203126",
+		0x3FF0000000000001ULL}};
+
+// Exact halfway point between zero and the smallest denormal
+static const char g_HalfSubnormal[] =
+	"2.47032822920623272088284396434110686182529901307162382212792841"
+	"2503377536351043759326499181808179961898982823477228588654633283"
+	"5517796989819938739800539093906315035659515570226392290858392449"
+	"1051844359318028499365361525003193704576782492193656236698636584"
+	"8075700158576926990370631192827955855133292783433840935197801553"
+	"1246597263579574622766465272827220056374006485499977096599470454"
+	"0208281662262378573934507363390079677619305775067401763246736009"
+	"6895134053553745851666113422376667860416215968046191446729184030"
+	"0530057530849048765391711386591646239524912623653881879636239373"
+	"2804238910186723484976682350898633885879256283027559956575244555"
+	"0725518931369083625477918694866799496832404970582102851318545139"
+	"6213837722826145437693412532098591327667236328125"
+	"e-324";
+
+static uint_t BURGER_API TestAsciiToDouble(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = FALSE;
+	Burger::uint64_double_t Result;
+
+	const AsciiToDoubleTests_t* pWork = g_AsciiToDoubleTests;
+	uintptr_t uCount = BURGER_ARRAYSIZE(g_AsciiToDoubleTests);
+	do {
+		Result.d = Burger::AsciiToDouble(pWork->m_pInput, nullptr);
+		const uint_t uTest = Result.w != pWork->m_uBits;
+		uFailure |= uTest;
+		ReportFailure("Burger::AsciiToDouble(\"%s\") = %.17g", uTest,
+			pWork->m_pInput, Result.d);
+		++pWork;
+	} while (--uCount);
+
+	// A tie rounds to even, anything above it rounds up
+	char Buffer[800];
+	Result.d = Burger::AsciiToDouble(g_HalfSubnormal, nullptr);
+	uint_t uTest = Result.w != 0;
+	uFailure |= uTest;
+	ReportFailure("Burger::AsciiToDouble(g_HalfSubnormal) = %.17g", uTest,
+		Result.d);
+
+	const uintptr_t uLength = sizeof(g_HalfSubnormal) - 6;
+	Burger::memory_copy(Buffer, g_HalfSubnormal, uLength);
+	Burger::string_copy(Buffer + uLength, "1e-324");
+	Result.d = Burger::AsciiToDouble(Buffer, nullptr);
+	uTest = Result.w != 1;
+	uFailure |= uTest;
+	ReportFailure(
+		"Burger::AsciiToDouble(g_HalfSubnormal + 1) = %.17g", uTest, Result.d);
+
+	// Floats round directly from the decimal digits
+	Burger::uint32_float_t FloatResult;
+	FloatResult.f = Burger::AsciiToFloat("16777217", nullptr);
+	uTest = FloatResult.w != 0x4B800000U;
+	uFailure |= uTest;
+	ReportFailure(
+		"Burger::AsciiToFloat(\"16777217\") = %.9g", uTest, FloatResult.f);
+	FloatResult.f = Burger::AsciiToFloat("3.4028235e38", nullptr);
+	uTest = FloatResult.w != 0x7F7FFFFFU;
+	uFailure |= uTest;
+	ReportFailure(
+		"Burger::AsciiToFloat(\"3.4028235e38\") = %.9g", uTest, FloatResult.f);
+
+	// The end pointer stops after the exponent
+	const char* pEnd;
+	Burger::AsciiToDouble("1.5e3x", &pEnd);
+	uTest = pEnd[0] != 'x';
+	uFailure |= uTest;
+	ReportFailure("Burger::AsciiToDouble(\"1.5e3x\") stopped at %s", uTest,
+		pEnd);
+
+	// Round trip the shortest strings of pseudo random doubles
+	uint64_t uSeed = 0x9E3779B97F4A7C15ULL;
+	uint_t i = 10000;
+	do {
+		uSeed ^= uSeed << 13U;
+		uSeed ^= uSeed >> 7U;
+		uSeed ^= uSeed << 17U;
+		Burger::uint64_double_t Input;
+		Input.w = uSeed & 0x7FEFFFFFFFFFFFFFULL;
+		Burger::to_decimal_ascii(Buffer, Input.d, 0);
+		Result.d = Burger::AsciiToDouble(Buffer, nullptr);
+		uTest = Result.w != Input.w;
+		uFailure |= uTest;
+		ReportFailure("Burger::AsciiToDouble(\"%s\") = %.17g", uTest, Buffer,
+			Result.d);
+	} while (--i);
+
+	// Eight digits at a time integer parsing
+	uint64_t uValue = Burger::AsciiToInteger64("12345678901234567890", nullptr);
+	uTest = uValue != 12345678901234567890ULL;
+	uFailure |= uTest;
+	ReportFailure("Burger::AsciiToInteger64(\"12345678901234567890\") failed",
+		uTest);
+	uValue = Burger::AsciiToInteger64("18446744073709551616", nullptr);
+	uTest = uValue != UINT64_MAX;
+	uFailure |= uTest;
+	ReportFailure(
+		"Burger::AsciiToInteger64(\"18446744073709551616\") didn't overflow",
+		uTest);
+	return uFailure;
+}
+
+/***************************************
+
+	Time AsciiToDouble(const char *, const char **)
+
+***************************************/
+
+static void BURGER_API TimeAsciiToDouble(void) BURGER_NOEXCEPT
+{
+	static char g_Strings[1000][32];
+	uint64_t uSeed = 0x9E3779B97F4A7C15ULL;
+	uint_t i = 0;
+	do {
+		uSeed ^= uSeed << 13U;
+		uSeed ^= uSeed >> 7U;
+		uSeed ^= uSeed << 17U;
+		Burger::uint64_double_t Input;
+		Input.w = uSeed & 0x7FEFFFFFFFFFFFFFULL;
+		Burger::to_decimal_ascii(g_Strings[i], Input.d, 0);
+	} while (++i < 1000);
+
+	double dTotal = 0.0;
+	uint_t uPass = 100;
+	const uint64_t uMark = Burger::Tick::read_high_precision();
+	do {
+		i = 0;
+		do {
+			dTotal += Burger::AsciiToDouble(g_Strings[i], nullptr) * 1e-300;
+		} while (++i < 1000);
+	} while (--uPass);
+	const uint64_t uElapsed = Burger::Tick::read_high_precision() - uMark;
+	Message("AsciiToDouble() %g ns per call (%g)",
+		(static_cast<double>(uElapsed) * 1.0e9) /
+			(static_cast<double>(Burger::Tick::get_high_precision_frequency()) *
+				100000.0),
+		dTotal);
+}
+
 /***************************************
 
 	Test NumberStringLength(T)
@@ -485,9 +716,107 @@ static uint_t BURGER_API TestNumberStringLength(void) BURGER_NOEXCEPT
 		"Burger::NumberStringLength(10000000000000000000ULL) = %u, expected 19",
 		uTest, uResult);
 
+	// Test both sides of every power of 10, 999 and 1000 and so on.
+	char Buffer[32];
+	uint64_t uPower = 10;
+	uint_t uDigits = 2;
+	do {
+		const uint64_t uNines = uPower - 1;
+		uTest = Burger::NumberStringLength(uNines) != (uDigits - 1);
+		uTest |= Burger::NumberStringLength(uPower) != uDigits;
+		if (uPower <= 0xFFFFFFFFULL) {
+			const uint32_t uNines32 = static_cast<uint32_t>(uNines);
+			const uint32_t uPower32 = static_cast<uint32_t>(uPower);
+			uTest |= Burger::NumberStringLength(uNines32) != (uDigits - 1);
+			uTest |= Burger::NumberStringLength(uPower32) != uDigits;
+		}
+
+		// Make sure the string matches the length and digits
+		char* pEnd = Burger::NumberToAscii(Buffer, uNines);
+		uTest |= (pEnd != (Buffer + uDigits - 1)) || pEnd[0];
+		uint_t i = 0;
+		do {
+			uTest |= Buffer[i] != '9';
+		} while (++i < (uDigits - 1));
+		pEnd = Burger::NumberToAscii(Buffer, uPower);
+		uTest |= (pEnd != (Buffer + uDigits)) || (Buffer[0] != '1');
+		i = 1;
+		do {
+			uTest |= Buffer[i] != '0';
+		} while (++i < uDigits);
+
+		uFailure |= uTest;
+		ReportFailure("Burger::NumberStringLength(%u digits) failed", uTest,
+			uDigits);
+		uPower *= 10U;
+	} while (++uDigits <= 20);
+
 	return uFailure;
 }
 
+/***************************************
+
+	Time NumberToAscii(char *, uint32_t, uint_t) with small, 32 bit and 64 bit
+	value distributions
+
+***************************************/
+
+static void BURGER_API TimeNumberToAscii(void) BURGER_NOEXCEPT
+{
+	static uint64_t g_Values[1000];
+	static const char* g_Names[3] = {"0-99", "32 bit", "64 bit"};
+	char Buffer[32];
+
+	uint_t uType = 0;
+	do {
+		// Fill the table with the distribution to test
+		uint64_t uSeed = 0x9E3779B97F4A7C15ULL;
+		uint_t i = 0;
+		do {
+			uSeed ^= uSeed << 13U;
+			uSeed ^= uSeed >> 7U;
+			uSeed ^= uSeed << 17U;
+			uint64_t uValue = uSeed;
+			if (!uType) {
+				uValue %= 100U;
+			} else if (uType == 1) {
+				// Spread evenly over the number of digits
+				uValue = (uValue & 0xFFFFFFFFU) >> ((uSeed >> 32U) % 32U);
+			} else {
+				uValue >>= (uSeed >> 58U);
+			}
+			g_Values[i] = uValue;
+		} while (++i < 1000);
+
+		uintptr_t uTotal = 0;
+		uint_t uPass = 1000;
+		const uint64_t uMark = Burger::Tick::read_high_precision();
+		do {
+			i = 0;
+			if (uType != 2) {
+				do {
+					uTotal += static_cast<uintptr_t>(
+						Burger::NumberToAscii(Buffer,
+							static_cast<uint32_t>(g_Values[i])) -
+						Buffer);
+				} while (++i < 1000);
+			} else {
+				do {
+					uTotal += static_cast<uintptr_t>(
+						Burger::NumberToAscii(Buffer, g_Values[i]) - Buffer);
+				} while (++i < 1000);
+			}
+		} while (--uPass);
+		const uint64_t uElapsed = Burger::Tick::read_high_precision() - uMark;
+		Message("NumberToAscii(%s) %g ns per call (%u)", g_Names[uType],
+			(static_cast<double>(uElapsed) * 1.0e9) /
+				(static_cast<double>(
+					 Burger::Tick::get_high_precision_frequency()) *
+					1000000.0),
+			static_cast<uint_t>(uTotal));
+	} while (++uType < 3);
+}
+
 /***************************************
 
 	Test NumberHexStringLength(T)
@@ -677,10 +1006,17 @@ int BURGER_API TestBrnumberto(uint_t uVerbose) BURGER_NOEXCEPT
 	uint_t uResult = TestNumberToAsciiHex();
 	uResult |= TestNumberToAsciiHexDigits();
 	uResult |= TestNumberToAscii();
+	uResult |= TestNumberToAsciiReal();
+	uResult |= TestAsciiToDouble();
 	uResult |= TestNumberStringLength();
 	uResult |= TestNumberHexStringLength();
 	uResult |= TestNumberOctalStringLength();
 
+	if (!uResult && (uVerbose & VERBOSE_TIME)) {
+		TimeAsciiToDouble();
+		TimeNumberToAscii();
+	}
+
 	// Intentional failures
 	// char Buffer[32];
 	// Burger::to_hex_ascii(Buffer, "Will not compile");
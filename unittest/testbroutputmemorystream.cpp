@@ -0,0 +1,176 @@
+/***************************************
+
+	Unit tests for OutputMemoryStream
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#include "testbroutputmemorystream.h"
+#include "brglobalmemorymanager.h"
+#include "brmemoryfunctions.h"
+#include "broutputmemorystream.h"
+#include "brstring.h"
+#include "brtick.h"
+#include "common.h"
+
+/***************************************
+
+	Test OutputMemoryStream chunk reuse and bulk writes
+
+***************************************/
+
+static uint_t BURGER_API TestOutputMemoryStream(void) BURGER_NOEXCEPT
+{
+	// Enough data to span three chunks
+	const uintptr_t uSize = Burger::OutputMemoryStream::kChunkSize * 2 + 1000;
+	uint8_t* pPattern =
+		static_cast<uint8_t*>(Burger::allocate_memory(uSize));
+	uintptr_t i = 0;
+	do {
+		pPattern[i] = static_cast<uint8_t>((i * 7) + (i >> 11));
+	} while (++i < uSize);
+
+	Burger::OutputMemoryStream Output;
+	uint_t uFailure = Output.Reserve(uSize) ||
+		(Output.GetCapacity() < uSize) || Output.GetSize() ||
+		Output.GetFlatData(nullptr);
+	ReportFailure("OutputMemoryStream::Reserve() failed", uFailure);
+
+	// Write in odd sized pieces so they straddle the chunks
+	const uintptr_t uCapacity = Output.GetCapacity();
+	i = 0;
+	do {
+		uintptr_t uStep = uSize - i;
+		if (uStep > 100003) {
+			uStep = 100003;
+		}
+		Output.Append(pPattern + i, uStep);
+		i += uStep;
+	} while (i < uSize);
+	Burger::String Text;
+	uint_t uTest = (Output.GetSize() != uSize) ||
+		(Output.GetCapacity() != uCapacity) || Output.Save(&Text) ||
+		(Text.length() != uSize) ||
+		Burger::MemoryCompare(Text.c_str(), pPattern, uSize) ||
+		Output.Compare(pPattern, uSize) || Output.GetFlatData(nullptr);
+	uFailure |= uTest;
+	ReportFailure("OutputMemoryStream::Append() bulk failed", uTest);
+
+	// Reset keeps the chunks, new gaps must be zero even though the chunks
+	// still hold the old data
+	Output.Reset();
+	uTest = Output.GetSize() || (Output.GetCapacity() != uCapacity);
+	Output.Append("abc");
+	Output.SetMark(10);
+	Output.Append(static_cast<uint8_t>('x'));
+	uintptr_t uLength = 0;
+	const uint8_t* pFlat =
+		static_cast<const uint8_t*>(Output.GetFlatData(&uLength));
+	uTest |= !pFlat || (uLength != 11) || (pFlat[0] != 'a') ||
+		(pFlat[2] != 'c') || (pFlat[10] != 'x');
+	if (pFlat) {
+		i = 3;
+		do {
+			uTest |= pFlat[i] != 0;
+		} while (++i < 10);
+	}
+
+	// Padding across a chunk boundary
+	Output.SetMark(uSize);
+	uTest |= Output.GetSize() != uSize;
+	if (!uTest) {
+		Burger::memory_clear(pPattern, uSize);
+		pPattern[0] = 'a';
+		pPattern[1] = 'b';
+		pPattern[2] = 'c';
+		pPattern[10] = 'x';
+		uTest |= Output.Compare(pPattern, uSize);
+	}
+	uFailure |= uTest;
+	ReportFailure("OutputMemoryStream::Reset() failed", uTest);
+
+	Burger::free_memory(pPattern);
+	return uFailure;
+}
+
+/***************************************
+
+	Time writing a stream that is reused
+
+***************************************/
+
+static void TimeOutputMemoryStream(void) BURGER_NOEXCEPT
+{
+	const uintptr_t uSize = 0x100000;
+	uint8_t* pBuffer =
+		static_cast<uint8_t*>(Burger::allocate_memory_clear(4096));
+	const uint_t uLoops = 100;
+
+	// New stream every time
+	uintptr_t uTotal = 0;
+	uint64_t uMark = Burger::Tick::read_high_precision();
+	uint_t i = 0;
+	do {
+		Burger::OutputMemoryStream Output;
+		uintptr_t j = 0;
+		do {
+			Output.Append(pBuffer, 4096);
+			j += 4096;
+		} while (j < uSize);
+		uTotal += Output.GetSize();
+	} while (++i < uLoops);
+	const uint64_t uFresh = Burger::Tick::read_high_precision() - uMark;
+
+	// Same stream, Reset() each time
+	Burger::OutputMemoryStream Reused;
+	uMark = Burger::Tick::read_high_precision();
+	i = 0;
+	do {
+		Reused.Reset();
+		uintptr_t j = 0;
+		do {
+			Reused.Append(pBuffer, 4096);
+			j += 4096;
+		} while (j < uSize);
+		uTotal += Reused.GetSize();
+	} while (++i < uLoops);
+	const uint64_t uReused = Burger::Tick::read_high_precision() - uMark;
+
+	const double dScale = 1000000.0 /
+		(static_cast<double>(Burger::Tick::get_high_precision_frequency()) *
+			static_cast<double>(uLoops));
+	Message("OutputMemoryStream 1MB in 4K appends, new stream %.1f us, "
+			"Reset() stream %.1f us (%u)",
+		static_cast<double>(uFresh) * dScale,
+		static_cast<double>(uReused) * dScale, static_cast<uint_t>(uTotal));
+	Burger::free_memory(pBuffer);
+}
+
+//
+// Perform all the tests for OutputMemoryStream
+//
+
+int BURGER_API TestBroutputmemorystream(uint_t uVerbose) BURGER_NOEXCEPT
+{
+	if (uVerbose & VERBOSE_MSG) {
+		Message("Running OutputMemoryStream tests");
+	}
+
+	uint_t uTotal = TestOutputMemoryStream();
+
+	if (!uTotal && (uVerbose & VERBOSE_TIME)) {
+		TimeOutputMemoryStream();
+	}
+
+	if (!uTotal && (uVerbose & VERBOSE_MSG)) {
+		Message("Passed all OutputMemoryStream tests!");
+	}
+	return static_cast<int>(uTotal);
+}
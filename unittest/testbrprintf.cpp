@@ -52,9 +52,11 @@
 #include "brassert.h"
 #include "bratomic.h"
 #include "brfpinfo.h"
+#include "brlogsink.h"
 #include "brmemoryfunctions.h"
 #include "brnumberstring.h"
 #include "brprintf.h"
+#include "brstring.h"
 #include "brstringfunctions.h"
 #include "brstructs.h"
 #include "brtick.h"
@@ -1969,6 +1971,453 @@ static uint_t BURGER_API TestRealFormats(uint_t uVerbose)
 }
 #endif
 
+/***************************************
+
+	Test real number formatting against known strings
+
+	These tests don't rely on the host's printf(), so they run everywhere.
+
+***************************************/
+
+struct RealFormatTest_t {
+	const char* m_pFormat;
+	double m_dValue;
+	const char* m_pExpected;
+};
+
+static const RealFormatTest_t g_RealFormatTests[] = {
+	{"%f", 0.0, "0.000000"},
+	{"%f", -1.5, "-1.500000"},
+	{"%.0f", 2.5, "2"},
+	{"%.0f", 3.5, "4"},
+	{"%.2f", 1.005, "1.00"},
+	{"%.3f", 2000.125, "2000.125"},
+	{"%10.3f", 3.14159, "     3.142"},
+	{"%-10.2f|", 2.5, "2.50      |"},
+	{"%+f", 1.0, "+1.000000"},
+	{"%010.2f", -3.25, "-000003.25"},
+	{"%.20f", 0.1, "0.10000000000000000555"},
+	{"%e", 123.456, "1.234560e+02"},
+	{"%.0e", 5.0, "5e+00"},
+	{"%E", 1e-300, "1.000000E-300"},
+	{"%.3e", 9.9996, "1.000e+01"},
+	{"%.20e", 0.1, "1.00000000000000005551e-01"},
+	{"%g", 1234567.0, "1.23457e+06"},
+	{"%g", 0.0001, "0.0001"},
+	{"%g", 1e-05, "1e-05"},
+	{"%g", 100.0, "100"},
+	{"%#g", 100.0, "100.000"},
+	{"%.3g", 999.5, "1e+03"},
+	{"%G", 1e-10, "1E-10"},
+	{"%.17g", 0.1, "0.10000000000000001"},
+	{"%f", 1e+22, "10000000000000000000000.000000"},
+	{"%.1f", 0.05, "0.1"},
+};
+
+static uint_t BURGER_API TestRealKnownStrings(void) BURGER_NOEXCEPT
+{
+	char Buffer[128];
+	uint_t uFailure = FALSE;
+
+	const RealFormatTest_t* pWork = g_RealFormatTests;
+	uintptr_t uCount = BURGER_ARRAYSIZE(g_RealFormatTests);
+	do {
+		Burger::Snprintf(
+			Buffer, sizeof(Buffer), pWork->m_pFormat, pWork->m_dValue);
+		const uint_t uTest = static_cast<uint_t>(
+			Burger::string_compare(Buffer, pWork->m_pExpected));
+		uFailure |= uTest;
+		ReportFailure("Snprintf(\"%s\", %.17g) = \"%s\", expected \"%s\"",
+			uTest, pWork->m_pFormat, pWork->m_dValue, Buffer,
+			pWork->m_pExpected);
+		++pWork;
+	} while (--uCount);
+	return uFailure;
+}
+
+/***************************************
+
+	Time real number formatting
+
+***************************************/
+
+static void BURGER_API TimeRealFormats(void) BURGER_NOEXCEPT
+{
+	char Buffer[128];
+	const double dFrequency =
+		static_cast<double>(Burger::Tick::get_high_precision_frequency());
+
+	static const char* g_TimeFormats[] = {"%f", "%e", "%g", "%.17g"};
+	uintptr_t i = 0;
+	do {
+		const char* pFormat = g_TimeFormats[i];
+		// Mix of magnitudes so every code path is exercised
+		double dValue = 1.0e-5;
+		uint_t uCount = 100000;
+		const uint64_t uMark = Burger::Tick::read_high_precision();
+		do {
+			Burger::Snprintf(Buffer, sizeof(Buffer), pFormat, dValue);
+			dValue *= 1.000173;
+		} while (--uCount);
+		const uint64_t uElapsed = Burger::Tick::read_high_precision() - uMark;
+		Message("Snprintf(\"%s\") %g ns per call", pFormat,
+			(static_cast<double>(uElapsed) * 1.0e9) / (dFrequency * 100000.0));
+	} while (++i < BURGER_ARRAYSIZE(g_TimeFormats));
+}
+
+/***************************************
+
+	Test CompiledFormat against Snprintf
+
+***************************************/
+
+static uint_t BURGER_API CompareCompiledFormat(const char* pFormat,
+	uintptr_t uArgCount, const Burger::ArgumentType** ppArgs)
+{
+	char Expected[256];
+	char Buffer[256];
+
+	const Burger::CompiledFormat Compiled(pFormat);
+	uint_t uFailure = Compiled.get_error() != Burger::kErrorNone;
+	ReportFailure("CompiledFormat(\"%s\") did not compile", uFailure, pFormat);
+
+	const intptr_t iExpected = Burger::Snprintf(
+		Expected, sizeof(Expected), pFormat, uArgCount, ppArgs);
+	const intptr_t iLength =
+		Compiled.format(Buffer, sizeof(Buffer), uArgCount, ppArgs);
+	uint_t uTest = (iLength != iExpected) ||
+		Burger::string_compare(Buffer, Expected);
+	uFailure |= uTest;
+	ReportFailure("CompiledFormat(\"%s\") = \"%s\", expected \"%s\"", uTest,
+		pFormat, Buffer, Expected);
+
+	Burger::String Output;
+	Compiled.format(&Output, uArgCount, ppArgs);
+	uTest =
+		static_cast<uint_t>(Burger::string_compare(Output.c_str(), Expected));
+	uFailure |= uTest;
+	ReportFailure("CompiledFormat(\"%s\") = \"%s\" to String, expected \"%s\"",
+		uTest, pFormat, Output.c_str(), Expected);
+	return uFailure;
+}
+
+static uint_t BURGER_API TestCompiledFormat(void) BURGER_NOEXCEPT
+{
+	char Buffer[256];
+
+	const char* pName = "burger";
+	const int iCount = -1234;
+	const unsigned int uHex = 0xBEEFU;
+	const double dValue = 3.25;
+	const Burger::ArgumentType ArgName(pName);
+	const Burger::ArgumentType ArgCount(iCount);
+	const Burger::ArgumentType ArgHex(uHex);
+	const Burger::ArgumentType ArgValue(dValue);
+
+	const Burger::ArgumentType* Args1[] = {&ArgName, &ArgCount};
+	uint_t uFailure = CompareCompiledFormat("%s: %d items\n", 2, Args1);
+	uFailure |= CompareCompiledFormat("%-12s|%08d|", 2, Args1);
+	uFailure |= CompareCompiledFormat("%2$d %1$s %2$+d", 2, Args1);
+
+	const Burger::ArgumentType* Args2[] = {
+		&ArgName, &ArgCount, &ArgHex, &ArgValue};
+	uFailure |= CompareCompiledFormat("%@ %@ %@ %@", 4, Args2);
+	uFailure |= CompareCompiledFormat("%4$g %3$X %2$d %1$s", 4, Args2);
+
+	const Burger::ArgumentType* Args3[] = {&ArgHex, &ArgValue};
+	uFailure |= CompareCompiledFormat("100%% %x %.2f%%", 2, Args3);
+	uFailure |= CompareCompiledFormat("No arguments", 0, nullptr);
+
+	// Output larger than the String and print() internal buffers
+	{
+		const Burger::CompiledFormat Compiled("[%600d]");
+		Burger::String Output;
+		Compiled.format(&Output, 42);
+		uint_t uTest = (Output.length() != 602) || (Output[0] != '[') ||
+			(Output[598] != ' ') || (Output[599] != '4') ||
+			(Output[601] != ']');
+		uFailure |= uTest;
+		ReportFailure("CompiledFormat(\"[%%600d]\") String length %u", uTest,
+			static_cast<uint_t>(Output.length()));
+
+		// Buffer too small returns an error and an empty string
+		const intptr_t iLength = Compiled.format(Buffer, 100, 42);
+		uTest = (iLength != Burger::kErrorBufferTooSmall) || Buffer[0];
+		uFailure |= uTest;
+		ReportFailure("CompiledFormat(\"[%%600d]\") buffer too small = %d",
+			uTest, static_cast<int>(iLength));
+	}
+
+	// Missing arguments and mismatched types are errors
+	{
+		const Burger::CompiledFormat Compiled("%s %d");
+		intptr_t iLength = Compiled.format(Buffer, sizeof(Buffer), pName);
+		uint_t uTest = (iLength != Burger::kErrorDataStarvation) ||
+			(Compiled.get_argument_count() != 2);
+		uFailure |= uTest;
+		ReportFailure("CompiledFormat(\"%%s %%d\") with one argument = %d",
+			uTest, static_cast<int>(iLength));
+
+		iLength = Compiled.format(Buffer, sizeof(Buffer), dValue, pName);
+		uTest = (iLength != Burger::kErrorInvalidArgument);
+		uFailure |= uTest;
+		ReportFailure("CompiledFormat(\"%%s %%d\") with wrong types = %d",
+			uTest, static_cast<int>(iLength));
+	}
+
+	// Bad format strings are caught by compile()
+	{
+		const Burger::CompiledFormat Compiled("%");
+		const uint_t uTest = (Compiled.get_error() == Burger::kErrorNone);
+		uFailure |= uTest;
+		ReportFailure("CompiledFormat(\"%%\") compiled", uTest);
+	}
+
+	// The cache returns the same object for the same string
+	{
+		static const char g_Cached[] = "Cached %d";
+		const Burger::CompiledFormat* pFirst =
+			Burger::CompiledFormat::get_cached(g_Cached);
+		const Burger::CompiledFormat* pSecond =
+			Burger::CompiledFormat::get_cached(g_Cached);
+		uint_t uTest = !pFirst || (pFirst != pSecond);
+		if (!uTest) {
+			pFirst->format(Buffer, sizeof(Buffer), 7);
+			uTest = static_cast<uint_t>(
+				Burger::string_compare(Buffer, "Cached 7"));
+		}
+		uFailure |= uTest;
+		ReportFailure("CompiledFormat::get_cached(\"%s\") failed", uTest,
+			g_Cached);
+		Burger::CompiledFormat::release_cache();
+	}
+	return uFailure;
+}
+
+/***************************************
+
+	Time CompiledFormat against Snprintf
+
+***************************************/
+
+static void BURGER_API TimeCompiledFormat(void) BURGER_NOEXCEPT
+{
+	char Buffer[256];
+	const double dFrequency =
+		static_cast<double>(Burger::Tick::get_high_precision_frequency());
+
+	static const char g_LogFormat[] =
+		"[%08X] %-10s frame %u took %d us (%s)\n";
+	const Burger::CompiledFormat Compiled(g_LogFormat);
+
+	uint_t uCount = 100000;
+	uint64_t uMark = Burger::Tick::read_high_precision();
+	do {
+		Burger::Snprintf(Buffer, sizeof(Buffer), g_LogFormat, uCount,
+			"renderer", uCount, 16666, "ok");
+	} while (--uCount);
+	uint64_t uElapsed = Burger::Tick::read_high_precision() - uMark;
+	Message("Snprintf() log line %g ns per call",
+		(static_cast<double>(uElapsed) * 1.0e9) / (dFrequency * 100000.0));
+
+	uCount = 100000;
+	uMark = Burger::Tick::read_high_precision();
+	do {
+		Compiled.format(
+			Buffer, sizeof(Buffer), uCount, "renderer", uCount, 16666, "ok");
+	} while (--uCount);
+	uElapsed = Burger::Tick::read_high_precision() - uMark;
+	Message("CompiledFormat::format() log line %g ns per call",
+		(static_cast<double>(uElapsed) * 1.0e9) / (dFrequency * 100000.0));
+}
+
+/***************************************
+
+	Test LogSink
+
+***************************************/
+
+struct LogSinkTest_t {
+	Burger::LogSink* m_pSink; // Sink to write to
+	uint_t m_uThread;         // Thread number
+	uint_t m_uCount;          // Number of lines to write
+};
+
+static uintptr_t BURGER_API LogSinkThread(void* pInput) BURGER_NOEXCEPT
+{
+	const LogSinkTest_t* pTest = static_cast<const LogSinkTest_t*>(pInput);
+	uint_t i = 0;
+	do {
+		Burger::Fprintf(pTest->m_pSink, "T%u %u\n", pTest->m_uThread, i);
+	} while (++i < pTest->m_uCount);
+	return 0;
+}
+
+static uint_t BURGER_API CheckLogSinkOutput(FILE* fp, const char* pName,
+	uint_t uThreads, uint_t uCount, uint_t bAllowDrops) BURGER_NOEXCEPT
+{
+	uint_t NextLine[4] = {0, 0, 0, 0};
+	uint_t uFailure = FALSE;
+	char Line[64];
+
+	// Every line must be intact, and in order for its thread
+	rewind(fp);
+	while (fgets(Line, sizeof(Line), fp)) {
+		unsigned int uThread = 0;
+		unsigned int uLine = 0;
+		uint_t uTest = (sscanf(Line, "T%u %u", &uThread, &uLine) != 2) ||
+			(uThread >= uThreads) || (uLine < NextLine[uThread]) ||
+			(!bAllowDrops && (uLine != NextLine[uThread]));
+		if (!uTest) {
+			NextLine[uThread] = uLine + 1;
+		}
+		uFailure |= uTest;
+		ReportFailure("LogSink %s bad line \"%s\"", uTest, pName, Line);
+		if (uFailure) {
+			break;
+		}
+	}
+	if (!bAllowDrops) {
+		uint_t i = 0;
+		do {
+			const uint_t uTest = (NextLine[i] != uCount);
+			uFailure |= uTest;
+			ReportFailure("LogSink %s thread %u wrote %u lines, expected %u",
+				uTest, pName, i, NextLine[i], uCount);
+		} while (++i < uThreads);
+	}
+	return uFailure;
+}
+
+static uint_t BURGER_API TestLogSink(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = FALSE;
+
+	// Small buffers so the overflow policies are exercised
+	static const Burger::LogSink::eOverflowPolicy g_Policies[2] = {
+		Burger::LogSink::kOverflowBlock, Burger::LogSink::kOverflowDrop};
+	static const char* g_PolicyNames[2] = {"block", "drop"};
+
+	uintptr_t uPolicy = 0;
+	do {
+		FILE* fp = tmpfile();
+		if (!fp) {
+			break;
+		}
+		Burger::LogSink Sink;
+		Sink.start(fp, g_Policies[uPolicy], 1024, 5);
+
+		LogSinkTest_t Tests[4];
+		Burger::Thread Threads[4];
+		uint_t i = 0;
+		do {
+			Tests[i].m_pSink = &Sink;
+			Tests[i].m_uThread = i;
+			Tests[i].m_uCount = 5000;
+			Threads[i].start(LogSinkThread, &Tests[i], "LogSinkTest");
+		} while (++i < 4);
+		i = 0;
+		do {
+			Threads[i].wait();
+		} while (++i < 4);
+		Sink.shutdown();
+
+		const uint_t bDrop =
+			g_Policies[uPolicy] == Burger::LogSink::kOverflowDrop;
+		uFailure |=
+			CheckLogSinkOutput(fp, g_PolicyNames[uPolicy], 4, 5000, bDrop);
+		uint_t uTest = !bDrop && Sink.get_dropped_count();
+		uFailure |= uTest;
+		ReportFailure("LogSink block dropped %u lines", uTest,
+			Sink.get_dropped_count());
+		fclose(fp);
+	} while (++uPolicy < BURGER_ARRAYSIZE(g_Policies));
+
+	// Text written from this thread, with a compiled format, and text larger
+	// than the buffer
+	FILE* fp = tmpfile();
+	if (fp) {
+		Burger::LogSink Sink;
+		Sink.start(fp, Burger::LogSink::kOverflowBlock, 256);
+		const Burger::CompiledFormat Format("T%u %u\n");
+		uint_t i = 0;
+		do {
+			if (i & 1) {
+				Sink.print(&Format, 0U, i);
+			} else {
+				Burger::Fprintf(&Sink, "T%u %u\n", 0U, i);
+			}
+		} while (++i < 100);
+		char Large[600];
+		Burger::memory_set(Large, 'x', sizeof(Large));
+		Sink.write(Large, sizeof(Large));
+		Sink.flush();
+
+		uint_t uTest = static_cast<uint_t>(ftell(fp) != (590 + 600));
+		uFailure |= uTest;
+		ReportFailure("LogSink flush() wrote %u bytes, expected 1190", uTest,
+			static_cast<uint_t>(ftell(fp)));
+		Sink.shutdown();
+		fclose(fp);
+	}
+
+	// signal_flush() bypasses the FILE stream, text must be written once
+	fp = tmpfile();
+	if (fp) {
+		Burger::LogSink Sink;
+		Sink.start(fp, Burger::LogSink::kOverflowBlock, 256, 100000);
+		Sink.write("Crash\n");
+		Sink.signal_flush();
+		Sink.shutdown();
+		fseek(fp, 0, SEEK_END);
+
+		uint_t uTest = static_cast<uint_t>(ftell(fp) != 6);
+		uFailure |= uTest;
+		ReportFailure("LogSink signal_flush() wrote %u bytes, expected 6",
+			uTest, static_cast<uint_t>(ftell(fp)));
+		fclose(fp);
+	}
+	return uFailure;
+}
+
+/***************************************
+
+	Time LogSink against Fprintf
+
+***************************************/
+
+static void BURGER_API TimeLogSink(void) BURGER_NOEXCEPT
+{
+	const double dFrequency =
+		static_cast<double>(Burger::Tick::get_high_precision_frequency());
+	FILE* fp = tmpfile();
+	if (fp) {
+		uint_t uCount = 100000;
+		uint64_t uMark = Burger::Tick::read_high_precision();
+		do {
+			Burger::Fprintf(fp, "[%08X] frame %u took %d us\n", uCount, uCount,
+				16666);
+		} while (--uCount);
+		uint64_t uElapsed = Burger::Tick::read_high_precision() - uMark;
+		Message("Fprintf(FILE*) %g ns per call",
+			(static_cast<double>(uElapsed) * 1.0e9) / (dFrequency * 100000.0));
+
+		Burger::LogSink Sink;
+		Sink.start(fp, Burger::LogSink::kOverflowBlock);
+		uCount = 100000;
+		uMark = Burger::Tick::read_high_precision();
+		do {
+			Burger::Fprintf(&Sink, "[%08X] frame %u took %d us\n", uCount,
+				uCount, 16666);
+		} while (--uCount);
+		uElapsed = Burger::Tick::read_high_precision() - uMark;
+		Message("Fprintf(LogSink*) %g ns per call",
+			(static_cast<double>(uElapsed) * 1.0e9) / (dFrequency * 100000.0));
+		Sink.shutdown();
+		fclose(fp);
+	}
+}
+
 int BURGER_API TestBrprintf(uint_t uVerbose)
 {
 	if (uVerbose & VERBOSE_MSG) {
@@ -1979,6 +2428,14 @@ int BURGER_API TestBrprintf(uint_t uVerbose)
 	uResult |= TestArgumentDetection(uVerbose);
 	uResult |= TestBinaryFormats(uVerbose);
 	uResult |= TestCharFormats(uVerbose);
+	uResult |= TestRealKnownStrings();
+	uResult |= TestCompiledFormat();
+	uResult |= TestLogSink();
+	if (!uResult && (uVerbose & VERBOSE_TIME)) {
+		TimeRealFormats();
+		TimeCompiledFormat();
+		TimeLogSink();
+	}
 
 #if defined(BURGER_WINDOWS) && (BURGER_MSVC >= 190000000)
 	uResult |= TestIntegerFormat(&SignedIntegerTests, uVerbose);
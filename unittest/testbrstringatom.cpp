@@ -0,0 +1,297 @@
+/***************************************
+
+	Unit tests for StringAtom
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#include "testbrstringatom.h"
+#include "brfileini.h"
+#include "brfilexml.h"
+#include "brinputmemorystream.h"
+#include "brnumberto.h"
+#include "brstringatom.h"
+#include "brstringfunctions.h"
+#include "brthread.h"
+#include "brtick.h"
+#include "common.h"
+
+/***************************************
+
+	Test StringAtom
+
+***************************************/
+
+// Names shared by all the atom threads
+static const char* g_AtomNames[] = {"Width", "Height", "Depth", "Color",
+	"WIDTH", "height", "x", "y", "z", "Name", "Value", "Item"};
+
+// Data for each atom thread
+struct AtomTest_t {
+	Burger::StringAtom m_Atoms[BURGER_ARRAYSIZE(g_AtomNames)];
+	uint_t m_uSeed;
+};
+
+static uintptr_t BURGER_API AtomThread(void* pInput) BURGER_NOEXCEPT
+{
+	AtomTest_t* pTest = static_cast<AtomTest_t*>(pInput);
+	uint_t i = 0;
+	do {
+		const uintptr_t uIndex =
+			(i + pTest->m_uSeed) % BURGER_ARRAYSIZE(g_AtomNames);
+		pTest->m_Atoms[uIndex] = Burger::StringAtom(g_AtomNames[uIndex]);
+	} while (++i < 2000);
+	return 0;
+}
+
+static uint_t BURGER_API TestStringAtom(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = FALSE;
+
+	// Invalid atoms
+	Burger::StringAtom Empty;
+	uint_t uTest = Empty.is_valid() || Empty.length() || Empty.c_str()[0] ||
+		(Empty != Burger::StringAtom(static_cast<const char*>(nullptr)));
+	uFailure |= uTest;
+	ReportFailure("StringAtom() is not invalid", uTest);
+
+	uTest = Burger::StringAtom::find("BurgerAtomNeverAdded").is_valid();
+	uFailure |= uTest;
+	ReportFailure("StringAtom::find() created an atom", uTest);
+
+	// Pointer equality
+	Burger::StringAtom Width("Width");
+	Burger::StringAtom Width2("Width");
+	uTest = !Width.is_valid() || (Width != Width2) ||
+		(Width.c_str() != Width2.c_str()) ||
+		Burger::string_compare(Width.c_str(), "Width") ||
+		(Width.length() != 5) ||
+		(Width.get_hash() != Burger::StringAtom::hash("Width", 5)) ||
+		(Burger::StringAtom::find("Width") != Width);
+	uFailure |= uTest;
+	ReportFailure("StringAtom(\"Width\") didn't intern", uTest);
+
+	// Length delimited strings
+	Burger::StringAtom Partial("Widths", 5);
+	uTest = (Partial != Width) ||
+		(Burger::StringAtom::find("Widthless", 5) != Width);
+	uFailure |= uTest;
+	ReportFailure("StringAtom(\"Widths\", 5) != StringAtom(\"Width\")", uTest);
+
+	// Case folding
+	Burger::StringAtom Upper("WIDTH");
+	Burger::StringAtom Lower("width");
+	uTest = (Upper == Width) || !Upper.is_case_equal(Width) ||
+		!Lower.is_case_equal(Width) || (Width.get_folded() != Lower) ||
+		(Lower.get_folded() != Lower) ||
+		(Upper.get_case_hash() != Lower.get_hash()) ||
+		(Burger::StringAtom::case_hash("wIdTh", 5) != Width.get_case_hash()) ||
+		Burger::StringAtom("Height").is_case_equal(Width) ||
+		Width.is_case_equal(Empty);
+	uFailure |= uTest;
+	ReportFailure("StringAtom::is_case_equal() failed", uTest);
+
+	// Strings longer than the folding buffer
+	char LongName[300];
+	uintptr_t i = 0;
+	do {
+		LongName[i] = static_cast<char>('A' + (i % 26));
+	} while (++i < sizeof(LongName) - 1);
+	LongName[sizeof(LongName) - 1] = 0;
+	Burger::StringAtom LongAtom(LongName);
+	Burger::StringLowercase(LongName);
+	uTest = !LongAtom.is_case_equal(Burger::StringAtom(LongName)) ||
+		(LongAtom.get_folded() != Burger::StringAtom::find(LongName));
+	uFailure |= uTest;
+	ReportFailure("StringAtom with a 299 character name failed", uTest);
+
+	// Enough atoms to grow the tables
+	const uintptr_t uStartCount = Burger::StringAtom::get_count();
+	char Name[32];
+	i = 0;
+	do {
+		Burger::string_copy(Name, "BurgerAtom");
+		Burger::NumberToAscii(Name + 10, static_cast<uint32_t>(i));
+		Burger::StringAtom(Name).is_valid();
+	} while (++i < 5000);
+	uTest = (Burger::StringAtom::get_count() < (uStartCount + 5000));
+	i = 0;
+	do {
+		Burger::string_copy(Name, "BurgerAtom");
+		Burger::NumberToAscii(Name + 10, static_cast<uint32_t>(i));
+		const Burger::StringAtom Found(Burger::StringAtom::find(Name));
+		uTest |= !Found.is_valid() ||
+			Burger::string_compare(Found.c_str(), Name);
+	} while (++i < 5000);
+	uFailure |= uTest;
+	ReportFailure("StringAtom failed after adding 5000 atoms", uTest);
+
+	// Many threads adding the same names must get the same atoms
+	AtomTest_t Tests[4];
+	Burger::Thread Threads[4];
+	i = 0;
+	do {
+		Tests[i].m_uSeed = static_cast<uint_t>(i * 5);
+		Threads[i].start(AtomThread, &Tests[i], "AtomTest");
+	} while (++i < 4);
+	i = 0;
+	do {
+		Threads[i].wait();
+	} while (++i < 4);
+	uTest = FALSE;
+	i = 0;
+	do {
+		const Burger::StringAtom Expected(g_AtomNames[i]);
+		uintptr_t j = 0;
+		do {
+			uTest |= (Tests[j].m_Atoms[i] != Expected);
+		} while (++j < 4);
+	} while (++i < BURGER_ARRAYSIZE(g_AtomNames));
+	uFailure |= uTest;
+	ReportFailure("StringAtom created duplicates across threads", uTest);
+
+	// FileINI lookups by atom
+	Burger::FileINI* pINI = Burger::FileINI::new_object();
+	Burger::FileINI::Section* pSection = pINI->AddSection("Video");
+	pSection->AddEntry("Width", "640");
+	pSection->AddEntry("Height", "480");
+	uTest = (pINI->FindSection(Burger::StringAtom("VIDEO")) != pSection) ||
+		(pSection->FindEntry(Upper) != pSection->FindEntry("width")) ||
+		!pSection->FindEntry(Upper) ||
+		pSection->FindEntry(Burger::StringAtom("Depth")) ||
+		pINI->FindSection(Burger::StringAtom("Audio"));
+	Burger::FileINI::Entry* pEntry =
+		pSection->FindEntry(Burger::StringAtom("Depth"), TRUE);
+	uTest |= !pEntry || (pEntry != pSection->FindEntry("depth"));
+	pEntry = pSection->FindEntry("Width");
+	pEntry->SetKey("Size");
+	uTest |= pSection->FindEntry(Width) ||
+		(pSection->FindEntry(Burger::StringAtom("size")) != pEntry);
+	Burger::delete_object(pINI);
+	uFailure |= uTest;
+	ReportFailure("FileINI lookup by StringAtom failed", uTest);
+
+	// FileXML lookups by atom
+	Burger::FileXML* pXML = Burger::FileXML::new_object();
+	Burger::FileXML::Element* pElement = pXML->AddElement("Window");
+	pElement->AddAttribute("Width", "640");
+	pElement->AddElement("Title");
+	uTest = (pXML->FindElement(Burger::StringAtom("window")) != pElement) ||
+		!pElement->FindElement(Burger::StringAtom("TITLE")) ||
+		(pElement->FindAttribute(Lower) != pElement->FindAttribute("Width")) ||
+		!pElement->FindAttribute(Lower) ||
+		pElement->FindAttribute(Burger::StringAtom("Height")) ||
+		pXML->FindElement(Burger::StringAtom("Title"));
+	uTest |= !pElement->FindElement(Burger::StringAtom("Icon"), TRUE) ||
+		!pElement->FindElement("icon");
+	Burger::delete_object(pXML);
+	uFailure |= uTest;
+	ReportFailure("FileXML lookup by StringAtom failed", uTest);
+
+	// Loading files must not add to the atom table
+	static const char g_INIText[] = "[AtomFreeSection]\nAtomFreeKey = 1\n";
+	static const char g_XMLText[] =
+		"<AtomFreeElement AtomFreeAttribute=\"1\"><AtomFreeChild/>"
+		"</AtomFreeElement>\n";
+	const uintptr_t uCount = Burger::StringAtom::get_count();
+	{
+		Burger::InputMemoryStream Input(
+			g_INIText, sizeof(g_INIText) - 1, TRUE);
+		pINI = Burger::FileINI::new_object(&Input);
+		Burger::InputMemoryStream Input2(
+			g_XMLText, sizeof(g_XMLText) - 1, TRUE);
+		pXML = Burger::FileXML::new_object();
+		pXML->Init(&Input2);
+	}
+	uTest = (Burger::StringAtom::get_count() != uCount) ||
+		!pINI->FindSection("atomfreesection") ||
+		!pXML->FindElement("ATOMFREEELEMENT");
+	pSection = pINI->FindSection("AtomFreeSection");
+	pElement = pXML->FindElement("AtomFreeElement");
+	uTest |= !pSection || !pElement ||
+		!pSection->FindEntry(Burger::StringAtom("ATOMFREEKEY")) ||
+		!pElement->FindAttribute(Burger::StringAtom("atomfreeattribute")) ||
+		!pElement->FindElement(Burger::StringAtom("AtomFreeChild"));
+	Burger::delete_object(pXML);
+	Burger::delete_object(pINI);
+	uFailure |= uTest;
+	ReportFailure("FileINI or FileXML added atoms while loading", uTest);
+
+	return uFailure;
+}
+
+/***************************************
+
+	Compare INI lookups by string and by atom
+
+***************************************/
+
+static void TimeStringAtom(void) BURGER_NOEXCEPT
+{
+	Burger::FileINI* pINI = Burger::FileINI::new_object();
+	Burger::FileINI::Section* pSection = pINI->AddSection("Settings");
+	char Name[32];
+	uint_t i = 0;
+	do {
+		Burger::string_copy(Name, "SettingName");
+		Burger::NumberToAscii(Name + 11, static_cast<uint32_t>(i));
+		pSection->AddEntry(Name, "1");
+	} while (++i < 64);
+
+	const char* pKey = "SETTINGNAME63";
+	const Burger::StringAtom Key(pKey);
+	const uint_t uLoops = 100000;
+	uintptr_t uFound = 0;
+
+	uint64_t uMark = Burger::Tick::read_high_precision();
+	i = 0;
+	do {
+		uFound += (pSection->FindEntry(pKey) != nullptr);
+	} while (++i < uLoops);
+	const uint64_t uString = Burger::Tick::read_high_precision() - uMark;
+
+	uMark = Burger::Tick::read_high_precision();
+	i = 0;
+	do {
+		uFound += (pSection->FindEntry(Key) != nullptr);
+	} while (++i < uLoops);
+	const uint64_t uAtom = Burger::Tick::read_high_precision() - uMark;
+
+	const double dScale = 1000000000.0 /
+		(static_cast<double>(Burger::Tick::get_high_precision_frequency()) *
+			static_cast<double>(uLoops));
+	Message("FileINI::Section::FindEntry() 64 entries, string %.1f ns, "
+			"StringAtom %.1f ns (%u)",
+		static_cast<double>(uString) * dScale,
+		static_cast<double>(uAtom) * dScale, static_cast<uint_t>(uFound));
+	Burger::delete_object(pINI);
+}
+
+//
+// Perform all the tests for StringAtom
+//
+
+int BURGER_API TestBrstringatom(uint_t uVerbose) BURGER_NOEXCEPT
+{
+	if (uVerbose & VERBOSE_MSG) {
+		Message("Running StringAtom tests");
+	}
+
+	uint_t uTotal = TestStringAtom();
+
+	if (!uTotal && (uVerbose & VERBOSE_TIME)) {
+		TimeStringAtom();
+	}
+
+	if (!uTotal && (uVerbose & VERBOSE_MSG)) {
+		Message("Passed all StringAtom tests!");
+	}
+	return static_cast<int>(uTotal);
+}
@@ -0,0 +1,24 @@
+/***************************************
+
+	Unit tests for StringAtom
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#ifndef __TESTBRSTRINGATOM_H__
+#define __TESTBRSTRINGATOM_H__
+
+#ifndef __BRTYPES_H__
+#include "brtypes.h"
+#endif
+
+extern int BURGER_API TestBrstringatom(uint_t uVerbose) BURGER_NOEXCEPT;
+
+#endif
@@ -17,8 +17,12 @@
 #include "brglobals.h"
 #include "brmemoryfunctions.h"
 #include "brosstringfunctions.h"
+#include "brstring16.h"
+#include "brstring32.h"
 #include "brstringfunctions.h"
+#include "brtick.h"
 #include "common.h"
+#include <string.h>
 
 static char gLargeString[] =
 	"This is a 100 character string "
@@ -194,6 +198,169 @@ static uint_t BURGER_API TestStringAppend(void) BURGER_NOEXCEPT
 	ReportFailure(
 		"String::append(const char *) failure = %s", uTest, Sample.c_str());
 
+	// Appending a string to itself must survive the buffer moving
+	Burger::String Twice("abcdefgh");
+	uintptr_t i = 0;
+	do {
+		Twice.append(Twice.c_str(), Twice.length());
+	} while (++i < 5);
+	uTest = Twice.length() != (8U << 5);
+	i = 0;
+	do {
+		uTest |= Twice[i] != static_cast<char>('a' + (i & 7));
+	} while (++i < (8U << 5));
+	uFailure |= uTest;
+	ReportFailure("String::append(self) failure length = %u", uTest,
+		static_cast<uint_t>(Twice.length()));
+
+	// Inserting a piece of a string into itself, before, across and after
+	// the insertion point, in the internal buffer and on the heap
+	const char* pSources[2] = {"abcdef", gLargeString};
+	char Expected[sizeof(gLargeString) * 2];
+	uint_t j = 0;
+	do {
+		const char* pSource = pSources[j];
+		const uintptr_t uSourceLength = Burger::string_length(pSource);
+		const uintptr_t uStep = j ? 7U : 1U;
+		uintptr_t uStart = 0;
+		do {
+			uintptr_t uOffset = 0;
+			do {
+				uintptr_t uCount = 1;
+				do {
+					Burger::memory_copy(Expected, pSource, uStart);
+					Burger::memory_copy(
+						Expected + uStart, pSource + uOffset, uCount);
+					Burger::memory_copy(Expected + uStart + uCount,
+						pSource + uStart, (uSourceLength - uStart) + 1);
+					Burger::String Self(pSource);
+					Self.insert(uStart, Self.c_str() + uOffset, uCount);
+					uTest = (Self.length() != (uSourceLength + uCount)) ||
+						Burger::string_compare(Self.c_str(), Expected);
+					uFailure |= uTest;
+					ReportFailure("String::insert(%u, self + %u, %u) = %s",
+						uTest, static_cast<uint_t>(uStart),
+						static_cast<uint_t>(uOffset),
+						static_cast<uint_t>(uCount), Self.c_str());
+					uCount += uStep;
+				} while (uCount <= (uSourceLength - uOffset));
+				uOffset += uStep;
+			} while (uOffset < uSourceLength);
+			uStart += uStep;
+		} while (uStart < uSourceLength);
+	} while (++j < 2);
+
+	static const char* s_Parts[] = {"one", nullptr, "two", "", "three"};
+	Burger::String Many("0");
+	Many.append_many(s_Parts, BURGER_ARRAYSIZE(s_Parts));
+	uTest = Burger::string_compare(Many.c_str(), "0onetwothree") != 0;
+	uFailure |= uTest;
+	ReportFailure("String::append_many() failure = %s", uTest, Many.c_str());
+
+	// Reserve keeps the string, shrink_to_fit returns to the internal buffer
+	Burger::String Reserved("reserve");
+	uTest = Reserved.reserve(1000) || (Reserved.capacity() < 1000) ||
+		Burger::string_compare(Reserved.c_str(), "reserve");
+	Reserved.shrink_to_fit();
+	uTest |= (Reserved.capacity() >= 1000) ||
+		Burger::string_compare(Reserved.c_str(), "reserve");
+	uFailure |= uTest;
+	ReportFailure("String::reserve() failure = %s", uTest, Reserved.c_str());
+
+#if defined(BURGER_RVALUE_REFERENCES)
+	// Moving must hand over the allocated buffer
+	const char* pBuffer = Sample.c_str();
+	const uintptr_t uLength = Sample.length();
+	Burger::String Moved(static_cast<Burger::String&&>(Sample));
+	uTest = (Moved.c_str() != pBuffer) || (Moved.length() != uLength) ||
+		Sample.length();
+	Sample = static_cast<Burger::String&&>(Moved);
+	uTest |= (Sample.c_str() != pBuffer) || Moved.length();
+	uFailure |= uTest;
+	ReportFailure("String(String&&) didn't take the buffer", uTest);
+#endif
+	return uFailure;
+}
+
+/***************************************
+
+	Test String16 and String32 appending and moving
+
+***************************************/
+
+static uint_t BURGER_API TestStringWideAppend(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+	Burger::String16 Sample16("abc");
+	Burger::String32 Sample32("abc");
+	uintptr_t i = 0;
+	do {
+		Sample16 += static_cast<uint16_t>('a' + (i % 26));
+		Sample32 += static_cast<uint32_t>('a' + (i % 26));
+	} while (++i < 500);
+	uint_t uTest = (Sample16.length() != 503) ||
+		(Sample16.capacity() < 503) || Sample16[503 - 1] != 'a' + (499 % 26);
+	uFailure |= uTest;
+	ReportFailure("String16::push_back() failure", uTest);
+	uTest = (Sample32.length() != 503) || (Sample32.capacity() < 503) ||
+		Sample32[503 - 1] != 'a' + (499 % 26);
+	uFailure |= uTest;
+	ReportFailure("String32::push_back() failure", uTest);
+
+	// Self append
+	Sample16.append(Sample16);
+	Sample32.append(Sample32);
+	uTest = (Sample16.length() != 1006) || Sample16[503] != 'a' ||
+		Sample16[1005] != Sample16[502];
+	uFailure |= uTest;
+	ReportFailure("String16::append(self) failure", uTest);
+	uTest = (Sample32.length() != 1006) || Sample32[503] != 'a' ||
+		Sample32[1005] != Sample32[502];
+	uFailure |= uTest;
+	ReportFailure("String32::append(self) failure", uTest);
+
+	// Grow the buffer with padding and check for zero fill
+	Burger::String16 Padded16("xy");
+	Padded16.SetBufferSize(200);
+	uTest = (Padded16.length() != 200) || (Padded16[1] != 'y') ||
+		Padded16[2] || Padded16[199];
+	uFailure |= uTest;
+	ReportFailure("String16::SetBufferSize() failure", uTest);
+
+	static const uint16_t s_Part16[] = {'h', 'i', 0};
+	static const uint32_t s_Part32[] = {'h', 'i', 0};
+	const uint16_t* Parts16[3] = {s_Part16, nullptr, s_Part16};
+	const uint32_t* Parts32[3] = {s_Part32, nullptr, s_Part32};
+	Burger::String16 Many16("0");
+	Burger::String32 Many32("0");
+	Many16.append_many(Parts16, 3);
+	Many32.append_many(Parts32, 3);
+	uTest = (Many16.length() != 5) || (Many16[4] != 'i') || Many16[5];
+	uTest |= (Many32.length() != 5) || (Many32[4] != 'i') || Many32[5];
+	uFailure |= uTest;
+	ReportFailure("String16/32::append_many() failure", uTest);
+
+	Sample16.shrink_to_fit();
+	Sample32.shrink_to_fit();
+	uTest = (Sample16.capacity() != 1006) || (Sample32.capacity() != 1006);
+	uFailure |= uTest;
+	ReportFailure("String16/32::shrink_to_fit() failure", uTest);
+
+#if defined(BURGER_RVALUE_REFERENCES)
+	const uint16_t* pBuffer16 = Sample16.c_str();
+	Burger::String16 Moved16(static_cast<Burger::String16&&>(Sample16));
+	const uint32_t* pBuffer32 = Sample32.c_str();
+	Burger::String32 Moved32(static_cast<Burger::String32&&>(Sample32));
+	uTest = (Moved16.c_str() != pBuffer16) || Sample16.length() ||
+		(Moved16.length() != 1006);
+	uTest |= (Moved32.c_str() != pBuffer32) || Sample32.length() ||
+		(Moved32.length() != 1006);
+	Sample16 = static_cast<Burger::String16&&>(Moved16);
+	Sample32 = static_cast<Burger::String32&&>(Moved32);
+	uTest |= (Sample16.c_str() != pBuffer16) || (Sample32.c_str() != pBuffer32);
+	uFailure |= uTest;
+	ReportFailure("String16/32 move didn't take the buffer", uTest);
+#endif
 	return uFailure;
 }
 
@@ -386,6 +553,825 @@ static uint_t TestStringToken(void) BURGER_NOEXCEPT
 	return uFailure;
 }
 
+/***************************************
+
+	Test the memory functions with every small size and alignment, the vector
+	versions have different code paths for each size range.
+
+***************************************/
+
+static const uintptr_t s_MemorySizes[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16,
+	17, 31, 32, 33, 63, 64, 65, 100, 127, 128, 129, 255, 256, 257, 511, 1000,
+	4095, 4096, 4097};
+
+#define MEMORY_BUFFER_SIZE 8192
+#define MEMORY_GUARD_SIZE 32
+
+static void BURGER_API FillPattern(
+	uint8_t* pOutput, uintptr_t uCount, uint_t uSeed) BURGER_NOEXCEPT
+{
+	uint32_t uValue = uSeed * 0x9E3779B1U + 1U;
+	if (uCount) {
+		do {
+			uValue = (uValue * 1103515245U) + 12345U;
+			pOutput[0] = static_cast<uint8_t>(uValue >> 16U);
+			++pOutput;
+		} while (--uCount);
+	}
+}
+
+static uint_t BURGER_API TestMemoryCopy(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = FALSE;
+	uint8_t* pSource = static_cast<uint8_t*>(
+		Burger::allocate_memory(MEMORY_BUFFER_SIZE + MEMORY_GUARD_SIZE * 2));
+	uint8_t* pDest = static_cast<uint8_t*>(
+		Burger::allocate_memory(MEMORY_BUFFER_SIZE + MEMORY_GUARD_SIZE * 2));
+	uint8_t* pExpected = static_cast<uint8_t*>(
+		Burger::allocate_memory(MEMORY_BUFFER_SIZE + MEMORY_GUARD_SIZE * 2));
+
+	if (pSource && pDest && pExpected) {
+		FillPattern(pSource, MEMORY_BUFFER_SIZE + MEMORY_GUARD_SIZE * 2, 1);
+		const uintptr_t* pSizes = s_MemorySizes;
+		uintptr_t uSizeCount = BURGER_ARRAYSIZE(s_MemorySizes);
+		do {
+			const uintptr_t uSize = pSizes[0];
+			uint_t uSourceAlign = 0;
+			do {
+				uint_t uDestAlign = 0;
+				do {
+					// memory_copy()
+					FillPattern(
+						pDest, MEMORY_BUFFER_SIZE + MEMORY_GUARD_SIZE * 2, 2);
+					memcpy(pExpected, pDest,
+						MEMORY_BUFFER_SIZE + MEMORY_GUARD_SIZE * 2);
+					memcpy(pExpected + MEMORY_GUARD_SIZE + uDestAlign,
+						pSource + uSourceAlign, uSize);
+					Burger::memory_copy(pDest + MEMORY_GUARD_SIZE + uDestAlign,
+						pSource + uSourceAlign, uSize);
+					uint_t uTest = static_cast<uint_t>(memcmp(pDest, pExpected,
+									   MEMORY_BUFFER_SIZE +
+										   MEMORY_GUARD_SIZE * 2) != 0);
+					uFailure |= uTest;
+					if (uTest) {
+						ReportFailure(
+							"Burger::memory_copy() size %u, source alignment %u, dest alignment %u",
+							uTest, static_cast<uint_t>(uSize), uSourceAlign,
+							uDestAlign);
+					}
+
+					// memory_set()
+					memset(pExpected + MEMORY_GUARD_SIZE + uDestAlign, 0xA5,
+						uSize);
+					Burger::memory_set(
+						pDest + MEMORY_GUARD_SIZE + uDestAlign, 0xA5, uSize);
+					uTest = static_cast<uint_t>(memcmp(pDest, pExpected,
+									MEMORY_BUFFER_SIZE +
+										MEMORY_GUARD_SIZE * 2) != 0);
+					uFailure |= uTest;
+					if (uTest) {
+						ReportFailure(
+							"Burger::memory_set() size %u, alignment %u", uTest,
+							static_cast<uint_t>(uSize), uDestAlign);
+					}
+
+					// memory_clear()
+					memset(
+						pExpected + MEMORY_GUARD_SIZE + uDestAlign, 0, uSize);
+					Burger::memory_clear(
+						pDest + MEMORY_GUARD_SIZE + uDestAlign, uSize);
+					uTest = static_cast<uint_t>(memcmp(pDest, pExpected,
+									MEMORY_BUFFER_SIZE +
+										MEMORY_GUARD_SIZE * 2) != 0);
+					uFailure |= uTest;
+					if (uTest) {
+						ReportFailure(
+							"Burger::memory_clear() size %u, alignment %u",
+							uTest, static_cast<uint_t>(uSize), uDestAlign);
+					}
+				} while (++uDestAlign < 16U);
+			} while (++uSourceAlign < 16U);
+			++pSizes;
+		} while (--uSizeCount);
+	}
+	Burger::free_memory(pExpected);
+	Burger::free_memory(pDest);
+	Burger::free_memory(pSource);
+	return uFailure;
+}
+
+/***************************************
+
+	Test memory_move() with overlapping buffers in both directions
+
+***************************************/
+
+static uint_t BURGER_API TestMemoryMove(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = FALSE;
+	uint8_t* pBuffer = static_cast<uint8_t*>(
+		Burger::allocate_memory(MEMORY_BUFFER_SIZE + MEMORY_GUARD_SIZE * 2));
+	uint8_t* pExpected = static_cast<uint8_t*>(
+		Burger::allocate_memory(MEMORY_BUFFER_SIZE + MEMORY_GUARD_SIZE * 2));
+
+	if (pBuffer && pExpected) {
+		const uintptr_t* pSizes = s_MemorySizes;
+		uintptr_t uSizeCount = BURGER_ARRAYSIZE(s_MemorySizes);
+		do {
+			const uintptr_t uSize = pSizes[0];
+			// Test distances from overlapping to disjoint
+			uint_t uDistance = 0;
+			do {
+				uint_t uDirection = 0;
+				do {
+					uint8_t* pSource = pBuffer + MEMORY_GUARD_SIZE;
+					uint8_t* pDest = pSource;
+					if (uDirection) {
+						pDest += uDistance;
+					} else {
+						pSource += uDistance;
+					}
+					if ((pSource + uSize) >
+						(pBuffer + MEMORY_BUFFER_SIZE + MEMORY_GUARD_SIZE)) {
+						continue;
+					}
+					if ((pDest + uSize) >
+						(pBuffer + MEMORY_BUFFER_SIZE + MEMORY_GUARD_SIZE)) {
+						continue;
+					}
+					FillPattern(
+						pBuffer, MEMORY_BUFFER_SIZE + MEMORY_GUARD_SIZE * 2, 3);
+					memcpy(pExpected, pBuffer,
+						MEMORY_BUFFER_SIZE + MEMORY_GUARD_SIZE * 2);
+					memmove(pExpected + (pDest - pBuffer),
+						pExpected + (pSource - pBuffer), uSize);
+					Burger::memory_move(pDest, pSource, uSize);
+					const uint_t uTest = static_cast<uint_t>(
+						memcmp(pBuffer, pExpected,
+							MEMORY_BUFFER_SIZE + MEMORY_GUARD_SIZE * 2) != 0);
+					uFailure |= uTest;
+					if (uTest) {
+						ReportFailure(
+							"Burger::memory_move() size %u, distance %d", uTest,
+							static_cast<uint_t>(uSize),
+							uDirection ? static_cast<int>(uDistance) :
+										 -static_cast<int>(uDistance));
+					}
+				} while (++uDirection < 2U);
+				uDistance = (uDistance < 40U) ? uDistance + 1U :
+												uDistance + 37U;
+			} while (uDistance < 600U);
+			++pSizes;
+		} while (--uSizeCount);
+	}
+	Burger::free_memory(pExpected);
+	Burger::free_memory(pBuffer);
+	return uFailure;
+}
+
+/***************************************
+
+	Test MemoryNot() and MemoryXor()
+
+***************************************/
+
+static uint_t BURGER_API TestMemoryXor(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = FALSE;
+	uint8_t Input1[300];
+	uint8_t Input2[300];
+	uint8_t Output[300];
+	uint8_t Expected[300];
+	FillPattern(Input1, sizeof(Input1), 4);
+	FillPattern(Input2, sizeof(Input2), 5);
+
+	const uintptr_t* pSizes = s_MemorySizes;
+	uintptr_t uSizeCount = BURGER_ARRAYSIZE(s_MemorySizes);
+	do {
+		const uintptr_t uSize = pSizes[0];
+		if (uSize > 256U) {
+			break;
+		}
+		uint_t uAlign = 0;
+		do {
+			// Expected results are built a byte at a time
+			uint_t uPass = 0;
+			do {
+				FillPattern(Output, sizeof(Output), 6);
+				memcpy(Expected, Output, sizeof(Output));
+				const uint8_t* pIn1 = Input1 + uAlign;
+				const uint8_t* pIn2 = Input2 + (uAlign ^ 7U);
+				uint8_t* pOut = Output + (uAlign ^ 3U);
+				uint8_t* pExp = Expected + (uAlign ^ 3U);
+				uintptr_t i = 0;
+				for (; i < uSize; ++i) {
+					switch (uPass) {
+					case 0:
+						pExp[i] = static_cast<uint8_t>(~pExp[i]);
+						break;
+					case 1:
+						pExp[i] = static_cast<uint8_t>(~pIn1[i]);
+						break;
+					case 2:
+						pExp[i] = static_cast<uint8_t>(pExp[i] ^ 0x5AU);
+						break;
+					case 3:
+						pExp[i] = static_cast<uint8_t>(pIn1[i] ^ 0x5AU);
+						break;
+					case 4:
+						pExp[i] = static_cast<uint8_t>(pExp[i] ^ pIn1[i]);
+						break;
+					default:
+						pExp[i] = static_cast<uint8_t>(pIn1[i] ^ pIn2[i]);
+						break;
+					}
+				}
+				const char* pName;
+				switch (uPass) {
+				case 0:
+					Burger::MemoryNot(pOut, uSize);
+					pName = "MemoryNot(void *,uintptr_t)";
+					break;
+				case 1:
+					Burger::MemoryNot(pOut, pIn1, uSize);
+					pName = "MemoryNot(void *,const void *,uintptr_t)";
+					break;
+				case 2:
+					Burger::MemoryXor(pOut, 0x5AU, uSize);
+					pName = "MemoryXor(void *,uint8_t,uintptr_t)";
+					break;
+				case 3:
+					Burger::MemoryXor(pOut, pIn1, 0x5AU, uSize);
+					pName = "MemoryXor(void *,const void *,uint8_t,uintptr_t)";
+					break;
+				case 4:
+					Burger::MemoryXor(pOut, pIn1, uSize);
+					pName = "MemoryXor(void *,const void *,uintptr_t)";
+					break;
+				default:
+					Burger::MemoryXor(pOut, pIn1, pIn2, uSize);
+					pName =
+						"MemoryXor(void *,const void *,const void *,uintptr_t)";
+					break;
+				}
+				const uint_t uTest = static_cast<uint_t>(
+					memcmp(Output, Expected, sizeof(Output)) != 0);
+				uFailure |= uTest;
+				if (uTest) {
+					ReportFailure("Burger::%s size %u, alignment %u", uTest,
+						pName, static_cast<uint_t>(uSize), uAlign);
+				}
+			} while (++uPass < 6U);
+		} while (++uAlign < 16U);
+		++pSizes;
+	} while (--uSizeCount);
+	return uFailure;
+}
+
+/***************************************
+
+	Test MemoryCompare() and MemoryCaseCompare() with a mismatch at every
+	position
+
+***************************************/
+
+static int BURGER_API ReferenceCaseCompare(
+	const uint8_t* pInput1, const uint8_t* pInput2, uintptr_t uCount)
+{
+	while (uCount) {
+		uint_t uTemp1 = pInput1[0];
+		uint_t uTemp2 = pInput2[0];
+		if ((uTemp1 >= 'A') && (uTemp1 <= 'Z')) {
+			uTemp1 += 32;
+		}
+		if ((uTemp2 >= 'A') && (uTemp2 <= 'Z')) {
+			uTemp2 += 32;
+		}
+		if (uTemp1 != uTemp2) {
+			return static_cast<int>(uTemp1) - static_cast<int>(uTemp2);
+		}
+		++pInput1;
+		++pInput2;
+		--uCount;
+	}
+	return 0;
+}
+
+static uint_t BURGER_API TestMemoryCompare(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = FALSE;
+	uint8_t Buffer1[160];
+	uint8_t Buffer2[160];
+
+	uintptr_t uSize = 0;
+	do {
+		uint_t uAlign = 0;
+		do {
+			uint8_t* pInput1 = Buffer1 + uAlign;
+			uint8_t* pInput2 = Buffer2 + (uAlign ^ 5U);
+
+			// Identical buffers, and all byte values for case folding
+			uintptr_t i = 0;
+			for (; i < uSize; ++i) {
+				pInput1[i] = static_cast<uint8_t>(i * 7U + uAlign);
+				pInput2[i] = pInput1[i];
+			}
+			int iResult = Burger::MemoryCompare(pInput1, pInput2, uSize);
+			uint_t uTest = (iResult != 0);
+			uFailure |= uTest;
+			if (uTest) {
+				ReportFailure("Burger::MemoryCompare() size %u = %d, expected 0",
+					uTest, static_cast<uint_t>(uSize), iResult);
+			}
+
+			// Change the case of every letter in the second buffer
+			for (i = 0; i < uSize; ++i) {
+				const uint_t uTemp = pInput2[i];
+				if (((uTemp >= 'A') && (uTemp <= 'Z')) ||
+					((uTemp >= 'a') && (uTemp <= 'z'))) {
+					pInput2[i] = static_cast<uint8_t>(uTemp ^ 0x20U);
+				}
+			}
+			iResult = Burger::MemoryCaseCompare(pInput1, pInput2, uSize);
+			int iExpected = ReferenceCaseCompare(pInput1, pInput2, uSize);
+			uTest = (iResult != iExpected);
+			uFailure |= uTest;
+			if (uTest) {
+				ReportFailure(
+					"Burger::MemoryCaseCompare() size %u = %d, expected %d",
+					uTest, static_cast<uint_t>(uSize), iResult, iExpected);
+			}
+
+			// Mismatch at each position
+			for (i = 0; i < uSize; ++i) {
+				memcpy(pInput2, pInput1, uSize);
+				pInput2[i] = static_cast<uint8_t>(pInput2[i] + 0x41U);
+				iResult = Burger::MemoryCompare(pInput1, pInput2, uSize);
+				iExpected = static_cast<int>(pInput1[i]) -
+					static_cast<int>(pInput2[i]);
+				uTest = (iResult != iExpected);
+				uFailure |= uTest;
+				if (uTest) {
+					ReportFailure(
+						"Burger::MemoryCompare() size %u, mismatch at %u = %d, expected %d",
+						uTest, static_cast<uint_t>(uSize),
+						static_cast<uint_t>(i), iResult, iExpected);
+				}
+				iResult = Burger::MemoryCaseCompare(pInput1, pInput2, uSize);
+				iExpected = ReferenceCaseCompare(pInput1, pInput2, uSize);
+				uTest = (iResult != iExpected);
+				uFailure |= uTest;
+				if (uTest) {
+					ReportFailure(
+						"Burger::MemoryCaseCompare() size %u, mismatch at %u = %d, expected %d",
+						uTest, static_cast<uint_t>(uSize),
+						static_cast<uint_t>(i), iResult, iExpected);
+				}
+			}
+		} while (++uAlign < 16U);
+	} while (++uSize < 130U);
+	return uFailure;
+}
+
+/***************************************
+
+	Test the character scanning functions with the match at every position
+
+***************************************/
+
+static uint_t BURGER_API TestMemoryCharacter(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = FALSE;
+	char Buffer[160];
+	uint16_t Buffer16[80];
+
+	uintptr_t uSize = 0;
+	do {
+		uint_t uAlign = 0;
+		do {
+			char* pInput = Buffer + uAlign;
+			memset(Buffer, 'a', sizeof(Buffer));
+			// Zero terminate the string
+			pInput[uSize] = 0;
+
+			// Not found
+			const char* pResult = Burger::MemoryCharacter(pInput, uSize, 'b');
+			uint_t uTest = (pResult != nullptr);
+			pResult = Burger::MemoryCharacterReverse(pInput, uSize, 'b');
+			uTest |= (pResult != nullptr);
+			pResult = Burger::StringCharacter(pInput, 'b');
+			uTest |= (pResult != nullptr);
+			const uintptr_t uLength = Burger::string_length(pInput);
+			uTest |= (uLength != uSize);
+			uFailure |= uTest;
+			if (uTest) {
+				ReportFailure(
+					"Character scan size %u, alignment %u, no match failed",
+					uTest, static_cast<uint_t>(uSize), uAlign);
+			}
+
+			uintptr_t i = 0;
+			for (; i < uSize; ++i) {
+				pInput[i] = 'b';
+				pResult = Burger::MemoryCharacter(pInput, uSize, 'b');
+				uTest = (pResult != (pInput + i));
+				pResult = Burger::MemoryCharacterReverse(pInput, uSize, 'b');
+				uTest |= (pResult != (pInput + i));
+				pResult = Burger::StringCharacter(pInput, 'b');
+				uTest |= (pResult != (pInput + i));
+				uFailure |= uTest;
+				if (uTest) {
+					ReportFailure(
+						"Character scan size %u, alignment %u, match at %u failed",
+						uTest, static_cast<uint_t>(uSize), uAlign,
+						static_cast<uint_t>(i));
+				}
+				pInput[i] = 'a';
+			}
+		} while (++uAlign < 16U);
+	} while (++uSize < 130U);
+
+	// 16 bit versions
+	uSize = 0;
+	do {
+		uint_t uAlign = 0;
+		do {
+			uint16_t* pInput = Buffer16 + uAlign;
+			uintptr_t i = 0;
+			for (; i < BURGER_ARRAYSIZE(Buffer16); ++i) {
+				Buffer16[i] = 0x1234U;
+			}
+			pInput[uSize] = 0;
+			uint_t uTest = (Burger::string_length(pInput) != uSize);
+			uTest |= (Burger::MemoryCharacter(pInput, uSize * 2, 0x4321U) !=
+				nullptr);
+			uTest |= (Burger::MemoryCharacterReverse(
+						  pInput, uSize * 2, 0x4321U) != nullptr);
+			uFailure |= uTest;
+			if (uTest) {
+				ReportFailure(
+					"16 bit character scan size %u, alignment %u, no match failed",
+					uTest, static_cast<uint_t>(uSize), uAlign);
+			}
+			for (i = 0; i < uSize; ++i) {
+				pInput[i] = 0x4321U;
+				uTest = (Burger::MemoryCharacter(pInput, uSize * 2, 0x4321U) !=
+					(pInput + i));
+				uTest |= (Burger::MemoryCharacterReverse(
+							  pInput, uSize * 2, 0x4321U) != (pInput + i));
+				uFailure |= uTest;
+				if (uTest) {
+					ReportFailure(
+						"16 bit character scan size %u, alignment %u, match at %u failed",
+						uTest, static_cast<uint_t>(uSize), uAlign,
+						static_cast<uint_t>(i));
+				}
+				pInput[i] = 0x1234U;
+			}
+		} while (++uAlign < 8U);
+	} while (++uSize < 64U);
+	return uFailure;
+}
+
+/***************************************
+
+	Test the substring search functions
+
+***************************************/
+
+struct StringSearch_t {
+	const char* m_pInput;
+	const char* m_pTest;
+	int m_iOffset;
+	int m_iCaseOffset;
+};
+
+static const StringSearch_t s_StringSearches[] = {{"", "", -1, -1},
+	{"", "a", -1, -1}, {"abc", "", 0, 0}, {"abc", "abc", 0, 0},
+	{"abc", "abcd", -1, -1}, {"abc", "C", -1, 2}, {"aaaaaaaaaaaaaaab", "ab", 14, 14},
+	{"This is a test of the emergency broadcast system", "system", 42, 42},
+	{"This is a test of the emergency broadcast system", "SYSTEM", -1, 42},
+	{"This is a test of the emergency broadcast system", "Emergency", -1, 22},
+	{"This is a test of the emergency broadcast system", "systems", -1, -1},
+	{"0123456789abcdef0123456789ABCDEFxyz", "fx", -1, 31},
+	{"0123456789abcdef0123456789ABCDEFxyz", "Fxy", 31, 31},
+	{"[Section]\nEntry=Value\n[Other]\nName=Data", "[other]", -1, 22}};
+
+static uint_t BURGER_API TestStringSearch(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = FALSE;
+	char Buffer[128];
+	const StringSearch_t* pWork = s_StringSearches;
+	uintptr_t uCount = BURGER_ARRAYSIZE(s_StringSearches);
+	do {
+		// Test at every alignment
+		uint_t uAlign = 0;
+		do {
+			char* pInput = Buffer + uAlign;
+			Burger::string_copy(pInput, pWork->m_pInput);
+
+			const char* pResult = Burger::StringString(pInput, pWork->m_pTest);
+			int iResult =
+				pResult ? static_cast<int>(pResult - pInput) : -1;
+			uint_t uTest = (iResult != pWork->m_iOffset);
+
+			pResult = Burger::StringString(pInput, pWork->m_pTest,
+				Burger::string_length(pWork->m_pTest));
+			iResult = pResult ? static_cast<int>(pResult - pInput) : -1;
+			uTest |= (iResult != pWork->m_iOffset);
+			uFailure |= uTest;
+			if (uTest) {
+				ReportFailure("Burger::StringString(\"%s\",\"%s\") = %d, expected %d",
+					uTest, pWork->m_pInput, pWork->m_pTest, iResult,
+					pWork->m_iOffset);
+			}
+
+			pResult = Burger::StringCaseString(pInput, pWork->m_pTest);
+			iResult = pResult ? static_cast<int>(pResult - pInput) : -1;
+			uTest = (iResult != pWork->m_iCaseOffset);
+			uFailure |= uTest;
+			if (uTest) {
+				ReportFailure(
+					"Burger::StringCaseString(\"%s\",\"%s\") = %d, expected %d",
+					uTest, pWork->m_pInput, pWork->m_pTest, iResult,
+					pWork->m_iCaseOffset);
+			}
+		} while (++uAlign < 16U);
+		++pWork;
+	} while (--uCount);
+	return uFailure;
+}
+
+/***************************************
+
+	Benchmark the search functions against the C library
+
+***************************************/
+
+static void BURGER_API TimeSearchFunctions(void) BURGER_NOEXCEPT
+{
+	char* pBuffer = static_cast<char*>(Burger::allocate_memory(65536 + 16));
+	if (pBuffer) {
+		// Build a large block of text
+		uintptr_t i = 0;
+		do {
+			pBuffer[i] = static_cast<char>('a' + (i % 23U));
+		} while (++i < 65536U);
+		pBuffer[65535] = 0;
+		const char* pNeedle = "needle";
+		Burger::string_copy(pBuffer + 65520, pNeedle);
+
+		// Prevent the compiler from hoisting the C library calls
+		char* volatile pVolatile = pBuffer;
+
+		const double dFrequency = static_cast<double>(
+			Burger::Tick::get_high_precision_frequency());
+		const double dBytes = 65536.0 * 1000.0 / 1048576.0;
+		uintptr_t uResult = 0;
+
+		uint64_t uMark = Burger::Tick::read_high_precision();
+		i = 1000;
+		do {
+			uResult += Burger::string_length(pVolatile);
+		} while (--i);
+		uint64_t uTime1 = Burger::Tick::read_high_precision() - uMark;
+		uMark = Burger::Tick::read_high_precision();
+		i = 1000;
+		do {
+			uResult += strlen(pVolatile);
+		} while (--i);
+		uint64_t uTime2 = Burger::Tick::read_high_precision() - uMark;
+		Message("string_length %8.1f MB/s, strlen %8.1f MB/s",
+			dBytes * dFrequency / static_cast<double>(uTime1 + 1),
+			dBytes * dFrequency / static_cast<double>(uTime2 + 1));
+
+		uMark = Burger::Tick::read_high_precision();
+		i = 1000;
+		do {
+			uResult += reinterpret_cast<uintptr_t>(
+				Burger::MemoryCharacter(pVolatile, 65536, 'z'));
+		} while (--i);
+		uTime1 = Burger::Tick::read_high_precision() - uMark;
+		uMark = Burger::Tick::read_high_precision();
+		i = 1000;
+		do {
+			uResult += reinterpret_cast<uintptr_t>(memchr(pVolatile, 'z', 65536));
+		} while (--i);
+		uTime2 = Burger::Tick::read_high_precision() - uMark;
+		Message("MemoryCharacter %8.1f MB/s, memchr %8.1f MB/s",
+			dBytes * dFrequency / static_cast<double>(uTime1 + 1),
+			dBytes * dFrequency / static_cast<double>(uTime2 + 1));
+
+		uMark = Burger::Tick::read_high_precision();
+		i = 1000;
+		do {
+			uResult += reinterpret_cast<uintptr_t>(
+				Burger::StringString(pVolatile, pNeedle));
+		} while (--i);
+		uTime1 = Burger::Tick::read_high_precision() - uMark;
+		uMark = Burger::Tick::read_high_precision();
+		i = 1000;
+		do {
+			uResult += reinterpret_cast<uintptr_t>(strstr(pVolatile, pNeedle));
+		} while (--i);
+		uTime2 = Burger::Tick::read_high_precision() - uMark;
+		Message("StringString %8.1f MB/s, strstr %8.1f MB/s",
+			dBytes * dFrequency / static_cast<double>(uTime1 + 1),
+			dBytes * dFrequency / static_cast<double>(uTime2 + 1));
+
+		uMark = Burger::Tick::read_high_precision();
+		i = 1000;
+		do {
+			uResult += static_cast<uintptr_t>(
+				Burger::MemoryCaseCompare(pBuffer, pBuffer + 23, 65536 - 32));
+		} while (--i);
+		uTime1 = Burger::Tick::read_high_precision() - uMark;
+		Message("MemoryCaseCompare %8.1f MB/s (%u)",
+			dBytes * dFrequency / static_cast<double>(uTime1 + 1),
+			static_cast<uint_t>(uResult & 1U));
+		Burger::free_memory(pBuffer);
+	}
+}
+
+/***************************************
+
+	Benchmark the memory functions against the C library for a range of sizes
+	and alignments
+
+***************************************/
+
+static const uintptr_t s_BenchSizes[] = {
+	8, 64, 256, 4096, 65536, 1048576, 8388608};
+
+static void BURGER_API TimeMemoryFunctions(void) BURGER_NOEXCEPT
+{
+	uint8_t* pSource =
+		static_cast<uint8_t*>(Burger::allocate_memory(8388608 + 64));
+	uint8_t* pDest =
+		static_cast<uint8_t*>(Burger::allocate_memory(8388608 + 64));
+	if (pSource && pDest) {
+		Burger::memory_set(pSource, 0x55, 8388608 + 64);
+		Burger::memory_clear(pDest, 8388608 + 64);
+		const double dFrequency = static_cast<double>(
+			Burger::Tick::get_high_precision_frequency());
+
+		uintptr_t i = 0;
+		do {
+			const uintptr_t uSize = s_BenchSizes[i];
+			// Move about 64MB per test
+			uintptr_t uLoops = 67108864U / uSize;
+			if (uLoops > 1000000U) {
+				uLoops = 1000000U;
+			}
+			uint_t uAlign = 0;
+			do {
+				uint8_t* pOut = pDest + uAlign;
+				const uint8_t* pIn = pSource + (uAlign ? 3U : 0U);
+				uintptr_t uCount = uLoops;
+				uint64_t uMark = Burger::Tick::read_high_precision();
+				do {
+					Burger::memory_copy(pOut, pIn, uSize);
+				} while (--uCount);
+				const uint64_t uCopy =
+					Burger::Tick::read_high_precision() - uMark;
+
+				uCount = uLoops;
+				uMark = Burger::Tick::read_high_precision();
+				do {
+					memcpy(pOut, pIn, uSize);
+				} while (--uCount);
+				const uint64_t uLibCopy =
+					Burger::Tick::read_high_precision() - uMark;
+
+				uCount = uLoops;
+				uMark = Burger::Tick::read_high_precision();
+				do {
+					Burger::memory_set(pOut, 0x33, uSize);
+				} while (--uCount);
+				const uint64_t uSet =
+					Burger::Tick::read_high_precision() - uMark;
+
+				uCount = uLoops;
+				uMark = Burger::Tick::read_high_precision();
+				do {
+					memset(pOut, 0x33, uSize);
+				} while (--uCount);
+				const uint64_t uLibSet =
+					Burger::Tick::read_high_precision() - uMark;
+
+				const double dBytes =
+					static_cast<double>(uSize) * static_cast<double>(uLoops);
+				Message(
+					"Size %8u, alignment %2u: memory_copy %8.1f MB/s, memcpy %8.1f MB/s, memory_set %8.1f MB/s, memset %8.1f MB/s",
+					static_cast<uint_t>(uSize), uAlign,
+					dBytes * dFrequency /
+						(static_cast<double>(uCopy + 1) * 1048576.0),
+					dBytes * dFrequency /
+						(static_cast<double>(uLibCopy + 1) * 1048576.0),
+					dBytes * dFrequency /
+						(static_cast<double>(uSet + 1) * 1048576.0),
+					dBytes * dFrequency /
+						(static_cast<double>(uLibSet + 1) * 1048576.0));
+				uAlign = uAlign ? 64U : 1U;
+			} while (uAlign < 64U);
+		} while (++i < BURGER_ARRAYSIZE(s_BenchSizes));
+	}
+	Burger::free_memory(pDest);
+	Burger::free_memory(pSource);
+}
+
+/***************************************
+
+	Time appending to strings and returning them by value
+
+***************************************/
+
+static Burger::String BURGER_API MakeLongString(uint_t uIndex) BURGER_NOEXCEPT
+{
+	Burger::String Result(gLargeString);
+	Result.push_back(static_cast<char>('a' + (uIndex & 15)));
+	return Result;
+}
+
+static void TimeStringAppend(void) BURGER_NOEXCEPT
+{
+	const uint_t uLoops = 1000;
+	const uint_t uAppends = 1000;
+	uintptr_t uTotal = 0;
+
+	uint64_t uMark = Burger::Tick::read_high_precision();
+	uint_t i = 0;
+	do {
+		Burger::String Work;
+		uint_t j = 0;
+		do {
+			Work.push_back('x');
+		} while (++j < uAppends);
+		uTotal += Work.length();
+	} while (++i < uLoops);
+	const uint64_t uPushBack = Burger::Tick::read_high_precision() - uMark;
+
+	static const char* s_Parts[] = {"alpha ", "beta ", "gamma ", "delta "};
+	uMark = Burger::Tick::read_high_precision();
+	i = 0;
+	do {
+		Burger::String Work;
+		uint_t j = 0;
+		do {
+			Work.append(s_Parts[0]);
+			Work.append(s_Parts[1]);
+			Work.append(s_Parts[2]);
+			Work.append(s_Parts[3]);
+		} while (++j < (uAppends / 10));
+		uTotal += Work.length();
+	} while (++i < uLoops);
+	const uint64_t uAppend = Burger::Tick::read_high_precision() - uMark;
+
+	uMark = Burger::Tick::read_high_precision();
+	i = 0;
+	do {
+		Burger::String Work;
+		uint_t j = 0;
+		do {
+			Work.append_many(s_Parts, BURGER_ARRAYSIZE(s_Parts));
+		} while (++j < (uAppends / 10));
+		uTotal += Work.length();
+	} while (++i < uLoops);
+	const uint64_t uMany = Burger::Tick::read_high_precision() - uMark;
+
+	// Return by value, the copy is forced with a const reference
+	uMark = Burger::Tick::read_high_precision();
+	i = 0;
+	do {
+		const Burger::String& rTemp = MakeLongString(i);
+		Burger::String Copied(rTemp);
+		uTotal += Copied.length();
+	} while (++i < (uLoops * 10));
+	const uint64_t uCopy = Burger::Tick::read_high_precision() - uMark;
+
+	uMark = Burger::Tick::read_high_precision();
+	i = 0;
+	Burger::String Moved;
+	do {
+		Moved = MakeLongString(i);
+		uTotal += Moved.length();
+	} while (++i < (uLoops * 10));
+	const uint64_t uMove = Burger::Tick::read_high_precision() - uMark;
+
+	const double dScale = 1000000000.0 /
+		static_cast<double>(Burger::Tick::get_high_precision_frequency());
+	const double dLoops = static_cast<double>(uLoops);
+	Message("String 1000 push_back() %.1f ns, 400 append() %.1f ns, "
+			"100 append_many() %.1f ns",
+		static_cast<double>(uPushBack) * dScale / dLoops,
+		static_cast<double>(uAppend) * dScale / dLoops,
+		static_cast<double>(uMany) * dScale / dLoops);
+	Message("String return by value, copy %.1f ns, move %.1f ns (%u)",
+		static_cast<double>(uCopy) * dScale / (dLoops * 10.0),
+		static_cast<double>(uMove) * dScale / (dLoops * 10.0),
+		static_cast<uint_t>(uTotal));
+}
+
 //
 // Perform all the tests for the Burgerlib Endian Manager
 //
@@ -403,11 +1389,24 @@ int BURGER_API TestBrstrings(uint_t uVerbose) BURGER_NOEXCEPT
 	uTotal |= TestParseQuotedString();
 	uTotal |= TestStringConstructors();
 	uTotal |= TestStringAppend();
+	uTotal |= TestStringWideAppend();
 	uTotal |= TestStringFind();
 	uTotal |= TestGetEnvironmentString(uVerbose);
 	uTotal |= TestStringStopAt();
 	uTotal |= TestStringSkipOver();
 	uTotal |= TestStringToken();
+	uTotal |= TestMemoryCopy();
+	uTotal |= TestMemoryMove();
+	uTotal |= TestMemoryXor();
+	uTotal |= TestMemoryCompare();
+	uTotal |= TestMemoryCharacter();
+	uTotal |= TestStringSearch();
+
+	if (!uTotal && (uVerbose & VERBOSE_TIME)) {
+		TimeMemoryFunctions();
+		TimeSearchFunctions();
+		TimeStringAppend();
+	}
 
 	if (uVerbose & VERBOSE_MSG) {
 		Burger::String TempString;
@@ -0,0 +1,372 @@
+/***************************************
+
+	Unit tests for XMLReader and XMLDocument
+
+	Copyright (c) 2025 by Rebecca Ann Heineman <becky@burgerbecky.com>
+
+	It is released under an MIT Open Source license. Please see LICENSE for
+	license details. Yes, you can use it in a commercial title without paying
+	anything, just give me a credit.
+
+	Please? It's not like I'm asking you for money!
+
+***************************************/
+
+#include "testbrxmlreader.h"
+#include "brfilexml.h"
+#include "brglobalmemorymanager.h"
+#include "brinputmemorystream.h"
+#include "brmemoryfunctions.h"
+#include "brnumberto.h"
+#include "brstring.h"
+#include "brstringfunctions.h"
+#include "brtick.h"
+#include "brxmlreader.h"
+#include "common.h"
+
+/***************************************
+
+	Test XMLReader and XMLDocument
+
+***************************************/
+
+static const char g_XMLSample[] =
+	"\xEF\xBB\xBF<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	"<!DOCTYPE config [ <!ENTITY foo \"bar\"> ]>\n"
+	"<!-- A comment -->\n"
+	"<Config Name=\"Test &amp; more\" single='x' bare=5>\n"
+	"\t<Sound Volume=\"255\"/>\n"
+	"\t<Text>\n\t\tHello &lt;world&gt;\r\n&#65;&#x42;&#x20AC;&bad;\n\t</Text>\n"
+	"\t<![CDATA[<raw>]]>\n"
+	"</config>\n";
+
+static const Burger::XMLReader::eEvent g_XMLSampleEvents[] = {
+	Burger::XMLReader::kEventDeclaration, Burger::XMLReader::kEventDocType,
+	Burger::XMLReader::kEventComment, Burger::XMLReader::kEventStartElement,
+	Burger::XMLReader::kEventStartElement, Burger::XMLReader::kEventEndElement,
+	Burger::XMLReader::kEventStartElement, Burger::XMLReader::kEventText,
+	Burger::XMLReader::kEventEndElement, Burger::XMLReader::kEventCData,
+	Burger::XMLReader::kEventEndElement,
+	Burger::XMLReader::kEventEndOfDocument};
+
+static const char* g_XMLBadSamples[] = {"<a><b></a>", "<a>", "text",
+	"<a b=></a>", "<a><!-- unterminated</a>", "<a></b>", "</a>"};
+
+static uint_t BURGER_API TestXMLReader(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+
+	// Check the event sequence
+	Burger::XMLReader Reader(g_XMLSample, sizeof(g_XMLSample) - 1);
+	uintptr_t i = 0;
+	uint_t uTest;
+	do {
+		const Burger::XMLReader::eEvent uEvent = Reader.next();
+		uTest = uEvent != g_XMLSampleEvents[i];
+		uFailure |= uTest;
+		ReportFailure("XMLReader::next() event %u = %u, expected %u", uTest,
+			static_cast<uint_t>(i), static_cast<uint_t>(uEvent),
+			static_cast<uint_t>(g_XMLSampleEvents[i]));
+		if (uTest) {
+			break;
+		}
+		Burger::XMLReader::Attribute_t Attribute;
+		Burger::String Decoded;
+		switch (i) {
+		case 0:
+			uTest = !Burger::XMLReader::is_match(Reader.get_name(), "xml") ||
+				(Reader.get_attribute_count() != 2) ||
+				!Reader.find_attribute(&Attribute, "ENCODING") ||
+				!Burger::XMLReader::is_match(Attribute.m_Value, "utf-8");
+			break;
+		case 1:
+			uTest =
+				!Burger::XMLReader::is_match(Reader.get_name(), "DOCTYPE") ||
+				!Burger::XMLReader::is_match(
+					Reader.get_text(), "config [ <!ENTITY foo \"bar\"> ]");
+			break;
+		case 2:
+			uTest = !Burger::XMLReader::is_match(
+				Reader.get_text(), " A comment ");
+			break;
+		case 3:
+			// Iterate over the attributes in order
+			uTest = (Reader.get_attribute_count() != 3) ||
+				(Reader.get_depth() != 1) || !Reader.next_attribute(&Attribute);
+			if (!uTest) {
+				Burger::XMLReader::decode(&Decoded, Attribute.m_Value);
+				uTest = !Burger::XMLReader::is_match(Attribute.m_Key, "name") ||
+					Burger::string_compare(Decoded.c_str(), "Test & more") ||
+					!Reader.next_attribute(&Attribute) ||
+					!Burger::XMLReader::is_match(Attribute.m_Value, "x") ||
+					!Reader.next_attribute(&Attribute) ||
+					!Burger::XMLReader::is_match(Attribute.m_Value, "5") ||
+					Reader.next_attribute(&Attribute);
+			}
+			break;
+		case 4:
+			uTest = !Reader.is_empty_element() ||
+				(Reader.get_depth() != 2) ||
+				!Reader.find_attribute(&Attribute, "volume") ||
+				!Burger::XMLReader::is_match(Attribute.m_Value, "255");
+			break;
+		case 5:
+			uTest = !Burger::XMLReader::is_match(Reader.get_name(), "Sound") ||
+				(Reader.get_depth() != 1);
+			break;
+		case 7:
+			Burger::XMLReader::decode(&Decoded, Reader.get_text());
+			uTest = !Burger::XMLReader::needs_decoding(Reader.get_text()) ||
+				Burger::string_compare(Decoded.c_str(),
+					"Hello <world>\nAB\xE2\x82\xAC&bad;");
+			break;
+		case 9:
+			uTest = !Burger::XMLReader::is_match(Reader.get_text(), "<raw>");
+			break;
+		case 10:
+			uTest = (Reader.get_depth() != 0) ||
+				!Burger::XMLReader::is_match(Reader.get_name(), "config");
+			break;
+		default:
+			break;
+		}
+		uFailure |= uTest;
+		ReportFailure("XMLReader event %u has bad data", uTest,
+			static_cast<uint_t>(i));
+	} while (++i < BURGER_ARRAYSIZE(g_XMLSampleEvents));
+
+	// Decode in place
+	char InPlace[] = "a&amp;b&#x7F8E;c";
+	Burger::XMLReader::Text_t Text = {InPlace, sizeof(InPlace) - 1};
+	const uintptr_t uLength = Burger::XMLReader::decode(InPlace, Text);
+	uTest = (uLength != 7) ||
+		Burger::MemoryCompare(InPlace, "a&b\xE7\xBE\x8E" "c", 7);
+	uFailure |= uTest;
+	ReportFailure("XMLReader::decode() in place failed", uTest);
+
+	// Malformed documents must report errors
+	i = 0;
+	do {
+		const char* pBad = g_XMLBadSamples[i];
+		Reader.init(pBad, Burger::string_length(pBad));
+		Burger::XMLReader::eEvent uEvent;
+		do {
+			uEvent = Reader.next();
+		} while (uEvent > Burger::XMLReader::kEventError);
+		uTest = (uEvent != Burger::XMLReader::kEventError) ||
+			!Reader.get_error();
+		uFailure |= uTest;
+		ReportFailure("XMLReader didn't fail on \"%s\"", uTest, pBad);
+	} while (++i < BURGER_ARRAYSIZE(g_XMLBadSamples));
+
+	// Build a tree
+	Burger::XMLDocument Document;
+	uTest = Document.parse(g_XMLSample, sizeof(g_XMLSample) - 1) != 0;
+	const Burger::XMLDocument::Node_t* pConfig = nullptr;
+	const Burger::XMLDocument::Node_t* pText = nullptr;
+	const Burger::XMLReader::Attribute_t* pVolume = nullptr;
+	if (!uTest) {
+		pConfig = Burger::XMLDocument::find_element(
+			Document.get_root(), "config");
+	}
+	if (pConfig) {
+		const Burger::XMLDocument::Node_t* pSound =
+			Burger::XMLDocument::find_element(pConfig, "Sound");
+		if (pSound) {
+			pVolume = Burger::XMLDocument::find_attribute(pSound, "Volume");
+			pText = Burger::XMLDocument::next_element(pSound, "text");
+		}
+	}
+	uTest = !pVolume || !pText || !pText->m_pFirstChild ||
+		!Burger::XMLReader::is_match(pVolume->m_Value, "255") ||
+		(pText->m_pFirstChild->m_uType != Burger::XMLReader::kEventText) ||
+		(pConfig->m_uAttributeCount != 3) || !Document.get_arena_size();
+	uFailure |= uTest;
+	ReportFailure("XMLDocument::parse() failed", uTest);
+
+	uTest = !Document.parse(g_XMLBadSamples[0],
+				Burger::string_length(g_XMLBadSamples[0])) ||
+		Document.get_arena_size() || Document.get_root()->m_pFirstChild;
+	uFailure |= uTest;
+	ReportFailure("XMLDocument::parse() didn't fail", uTest);
+	return uFailure;
+}
+
+/***************************************
+
+	Memory manager that tracks the peak memory in use
+
+***************************************/
+
+struct PeakMemory_t: public Burger::MemoryManager {
+	Burger::MemoryManager* m_pPrevious;
+	uintptr_t m_uCurrent;
+	uintptr_t m_uPeak;
+};
+
+// Size of the header that holds the allocation size
+static const uintptr_t kPeakHeaderSize = 16;
+
+static void* BURGER_API PeakAllocate(
+	Burger::MemoryManager* pThis, uintptr_t uSize)
+{
+	PeakMemory_t* pPeak = static_cast<PeakMemory_t*>(pThis);
+	uint8_t* pResult = static_cast<uint8_t*>(
+		pPeak->m_pPrevious->allocate_memory(uSize + kPeakHeaderSize));
+	if (pResult) {
+		reinterpret_cast<uintptr_t*>(pResult)[0] = uSize;
+		pPeak->m_uCurrent += uSize;
+		if (pPeak->m_uCurrent > pPeak->m_uPeak) {
+			pPeak->m_uPeak = pPeak->m_uCurrent;
+		}
+		pResult += kPeakHeaderSize;
+	}
+	return pResult;
+}
+
+static void BURGER_API PeakFree(
+	Burger::MemoryManager* pThis, const void* pInput)
+{
+	if (pInput) {
+		PeakMemory_t* pPeak = static_cast<PeakMemory_t*>(pThis);
+		const uint8_t* pBase =
+			static_cast<const uint8_t*>(pInput) - kPeakHeaderSize;
+		pPeak->m_uCurrent -= reinterpret_cast<const uintptr_t*>(pBase)[0];
+		pPeak->m_pPrevious->free_memory(pBase);
+	}
+}
+
+static void* BURGER_API PeakReallocate(
+	Burger::MemoryManager* pThis, const void* pInput, uintptr_t uSize)
+{
+	if (!pInput) {
+		return PeakAllocate(pThis, uSize);
+	}
+	PeakMemory_t* pPeak = static_cast<PeakMemory_t*>(pThis);
+	const uint8_t* pBase =
+		static_cast<const uint8_t*>(pInput) - kPeakHeaderSize;
+	const uintptr_t uOldSize = reinterpret_cast<const uintptr_t*>(pBase)[0];
+	uint8_t* pResult = static_cast<uint8_t*>(
+		pPeak->m_pPrevious->reallocate_memory(pBase, uSize + kPeakHeaderSize));
+	if (pResult) {
+		reinterpret_cast<uintptr_t*>(pResult)[0] = uSize;
+		pPeak->m_uCurrent += uSize - uOldSize;
+		if (pPeak->m_uCurrent > pPeak->m_uPeak) {
+			pPeak->m_uPeak = pPeak->m_uCurrent;
+		}
+		pResult += kPeakHeaderSize;
+	}
+	return pResult;
+}
+
+static void BURGER_API PeakShutdown(Burger::MemoryManager* /* pThis */) {}
+
+static void BURGER_API PeakStart(PeakMemory_t* pPeak) BURGER_NOEXCEPT
+{
+	pPeak->m_pAllocate = PeakAllocate;
+	pPeak->m_pFree = PeakFree;
+	pPeak->m_pReallocate = PeakReallocate;
+	pPeak->m_pShutdown = PeakShutdown;
+	pPeak->m_uCurrent = 0;
+	pPeak->m_uPeak = 0;
+	pPeak->m_pPrevious = Burger::GlobalMemoryManager::init(pPeak);
+}
+
+/***************************************
+
+	Compare FileXML to XMLReader and XMLDocument
+
+***************************************/
+
+static void TimeXMLReader(void) BURGER_NOEXCEPT
+{
+	// Create a few megabytes of XML
+	Burger::String Source("<?xml version=\"1.0\"?>\n<Root>\n");
+	char Number[32];
+	uint_t i = 0;
+	do {
+		Burger::NumberToAscii(Number, static_cast<uint32_t>(i));
+		const char* Parts[] = {"\t<Item id=\"", Number, "\" name=\"Item &amp; ",
+			Number,
+			"\" value=\"3.5\">\n\t\t<Child>Some text &lt;here&gt;</Child>\n"
+			"\t\t<Empty flag=\"1\"/>\n\t</Item>\n"};
+		Source.append_many(Parts, BURGER_ARRAYSIZE(Parts));
+	} while (++i < 40000);
+	Source.append("</Root>\n");
+
+	const double dFrequency =
+		static_cast<double>(Burger::Tick::get_high_precision_frequency());
+	const double dMegabytes =
+		static_cast<double>(Source.length()) / (1024.0 * 1024.0);
+	PeakMemory_t Peak;
+
+	// Full DOM
+	PeakStart(&Peak);
+	uint64_t uMark = Burger::Tick::read_high_precision();
+	{
+		Burger::InputMemoryStream Input(Source.c_str(), Source.length(), TRUE);
+		Burger::FileXML XML;
+		XML.Init(&Input);
+	}
+	const uint64_t uFileXML = Burger::Tick::read_high_precision() - uMark;
+	Burger::GlobalMemoryManager::init(Peak.m_pPrevious);
+	const uintptr_t uFileXMLPeak = Peak.m_uPeak;
+
+	// Pull parser
+	uintptr_t uCount = 0;
+	PeakStart(&Peak);
+	uMark = Burger::Tick::read_high_precision();
+	{
+		Burger::XMLReader Reader(Source.c_str(), Source.length());
+		while (Reader.next() > Burger::XMLReader::kEventError) {
+			++uCount;
+		}
+	}
+	const uint64_t uReader = Burger::Tick::read_high_precision() - uMark;
+	Burger::GlobalMemoryManager::init(Peak.m_pPrevious);
+	const uintptr_t uReaderPeak = Peak.m_uPeak;
+
+	// Arena tree
+	PeakStart(&Peak);
+	uMark = Burger::Tick::read_high_precision();
+	{
+		Burger::XMLDocument Document;
+		Document.parse(Source.c_str(), Source.length());
+	}
+	const uint64_t uDocument = Burger::Tick::read_high_precision() - uMark;
+	Burger::GlobalMemoryManager::init(Peak.m_pPrevious);
+	const uintptr_t uDocumentPeak = Peak.m_uPeak;
+
+	Message("XML %.1f MB, FileXML %.1f MB/s %u KB, XMLReader %.1f MB/s %u KB, "
+			"XMLDocument %.1f MB/s %u KB (%u)",
+		dMegabytes,
+		dMegabytes * dFrequency / static_cast<double>(uFileXML + 1),
+		static_cast<uint_t>(uFileXMLPeak >> 10U),
+		dMegabytes * dFrequency / static_cast<double>(uReader + 1),
+		static_cast<uint_t>(uReaderPeak >> 10U),
+		dMegabytes * dFrequency / static_cast<double>(uDocument + 1),
+		static_cast<uint_t>(uDocumentPeak >> 10U),
+		static_cast<uint_t>(uCount));
+}
+
+//
+// Perform all the tests for XMLReader
+//
+
+int BURGER_API TestBrxmlreader(uint_t uVerbose) BURGER_NOEXCEPT
+{
+	if (uVerbose & VERBOSE_MSG) {
+		Message("Running XMLReader tests");
+	}
+
+	uint_t uTotal = TestXMLReader();
+
+	if (!uTotal && (uVerbose & VERBOSE_TIME)) {
+		TimeXMLReader();
+	}
+
+	if (!uTotal && (uVerbose & VERBOSE_MSG)) {
+		Message("Passed all XMLReader tests!");
+	}
+	return static_cast<int>(uTotal);
+}
@@ -14,9 +14,11 @@
 
 #include "testcharset.h"
 #include "brisolatin1.h"
+#include "brglobalmemorymanager.h"
 #include "brmacromanus.h"
 #include "brmemoryfunctions.h"
 #include "brstringfunctions.h"
+#include "brtick.h"
 #include "brutf16.h"
 #include "brutf32.h"
 #include "brutf8.h"
@@ -1590,6 +1592,508 @@ static uint_t TestUTF32(void) BURGER_NOEXCEPT
 	return uResult;
 }
 
+/***************************************
+
+	Test UTF8::is_valid() on sequences placed across 16 byte boundaries
+
+***************************************/
+
+struct UTF8Sequence_t {
+	const char* m_pUTF8; // UTF8 sequence
+	uint_t m_uValid;     // TRUE if valid
+};
+
+static const UTF8Sequence_t gIsValidTest8[] = {{"\x7F", TRUE},
+	{"\xC2\x80", TRUE}, {"\xDF\xBF", TRUE}, {"\xE0\xA0\x80", TRUE},
+	{"\xE2\x82\xAC", TRUE}, {"\xED\x9F\xBF", TRUE}, {"\xEE\x80\x80", TRUE},
+	{"\xEF\xBF\xBF", TRUE}, {"\xF0\x90\x80\x80", TRUE},
+	{"\xF0\x9F\xA4\xA2", TRUE}, {"\xF4\x8F\xBF\xBF", TRUE},
+	{"\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80", TRUE},
+	// Lone continuation bytes
+	{"\x80", FALSE}, {"\xBF", FALSE}, {"\xC2\x80\x80", FALSE},
+	// Overlong encodings
+	{"\xC0\x80", FALSE}, {"\xC1\xBF", FALSE}, {"\xE0\x80\x80", FALSE},
+	{"\xE0\x9F\xBF", FALSE}, {"\xF0\x80\x80\x80", FALSE},
+	{"\xF0\x8F\xBF\xBF", FALSE},
+	// Surrogates
+	{"\xED\xA0\x80", FALSE}, {"\xED\xBF\xBF", FALSE},
+	// Too large
+	{"\xF4\x90\x80\x80", FALSE}, {"\xF5\x80\x80\x80", FALSE},
+	{"\xFF", FALSE},
+	// Truncated
+	{"\xC2", FALSE}, {"\xE2\x82", FALSE}, {"\xF0\x9F\xA4", FALSE},
+	{"\xE2\x41\x82", FALSE}, {"\xF0\x9F\x41\xA2", FALSE}};
+
+static uint_t BURGER_API TestUTF8IsValid(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+	char Buffer[128];
+	const UTF8Sequence_t* pWork = gIsValidTest8;
+	uintptr_t uCount = BURGER_ARRAYSIZE(gIsValidTest8);
+	do {
+		const uintptr_t uLength = Burger::string_length(pWork->m_pUTF8);
+		// Slide the sequence across two vector blocks
+		uintptr_t uOffset = 0;
+		do {
+			uintptr_t uPadding = 0;
+			do {
+				Burger::memory_set(Buffer, 'a', uOffset);
+				Burger::memory_copy(Buffer + uOffset, pWork->m_pUTF8, uLength);
+				Burger::memory_set(Buffer + uOffset + uLength, 'b', uPadding);
+				const uintptr_t uTotal = uOffset + uLength + uPadding;
+				Buffer[uTotal] = 0;
+
+				uint_t uTest =
+					Burger::UTF8::is_valid(Buffer, uTotal) != pWork->m_uValid;
+				uFailure |= uTest;
+				ReportFailure(
+					"Burger::UTF8::is_valid(\"%s\", %u) offset %u padding %u is invalid!",
+					uTest, pWork->m_pUTF8, static_cast<uint_t>(uTotal),
+					static_cast<uint_t>(uOffset),
+					static_cast<uint_t>(uPadding));
+
+				uTest = Burger::UTF8::is_valid(Buffer) != pWork->m_uValid;
+				uFailure |= uTest;
+				ReportFailure(
+					"Burger::UTF8::is_valid(\"%s\") offset %u padding %u is invalid!",
+					uTest, pWork->m_pUTF8, static_cast<uint_t>(uOffset),
+					static_cast<uint_t>(uPadding));
+				uPadding += 7;
+			} while (uPadding < 40);
+		} while (++uOffset < 40);
+		++pWork;
+	} while (--uCount);
+	return uFailure;
+}
+
+/***************************************
+
+	Test the bulk ASCII conversion between UTF8, UTF16 and UTF32 by placing a
+	non-ASCII character at every position of a long string and checking the
+	results against the expected values, even when the output is truncated.
+
+***************************************/
+
+static uint_t BURGER_API TestUTFTranscode(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+	char Source[112];
+	char Result8[112];
+	uint16_t Expected16[112];
+	uint16_t Result16[112];
+	uint32_t Expected32[112];
+	uint32_t Result32[112];
+
+	// Place U+00E9 at each position of a 100 character string
+	uintptr_t uPosition = 0;
+	do {
+		uintptr_t uLength = 0;
+		uintptr_t i = 0;
+		do {
+			if (i == uPosition) {
+				Source[uLength] = static_cast<char>(0xC3);
+				Source[uLength + 1] = static_cast<char>(0xA9);
+				uLength += 2;
+				Expected16[i] = 0xE9U;
+				Expected32[i] = 0xE9U;
+			} else {
+				const uint_t uChar = static_cast<uint_t>('A' + (i % 26U));
+				Source[uLength] = static_cast<char>(uChar);
+				++uLength;
+				Expected16[i] = static_cast<uint16_t>(uChar);
+				Expected32[i] = uChar;
+			}
+		} while (++i < 100);
+		Source[uLength] = 0;
+
+		// Full and truncated output buffers
+		static const uintptr_t s_OutputSizes[] = {104, 101, 100, 50, 17, 1};
+		uintptr_t uSizeIndex = 0;
+		do {
+			const uintptr_t uOutputSize = s_OutputSizes[uSizeIndex];
+			const uintptr_t uValid = uOutputSize - 1U;
+			// Number of values that fit before the terminating zero
+			const uintptr_t uWide = (uValid < 100U) ? uValid : 100U;
+			// Partial UTF8 sequences are written if they are truncated
+			const uintptr_t uExpected = (uLength < uValid) ? uLength : uValid;
+
+			// UTF8 to UTF16, "C" string and sized
+			uint_t uPass = 0;
+			do {
+				Burger::memory_set(Result16, 0xCC, sizeof(Result16));
+				uintptr_t uCount;
+				if (uPass) {
+					uCount = Burger::UTF16::translate_from_UTF8(
+						Result16, uOutputSize, Source, uLength);
+				} else {
+					uCount = Burger::UTF16::translate_from_UTF8(
+						Result16, uOutputSize, Source);
+				}
+				uint_t uTest = (uCount != 100) ||
+					Burger::MemoryCompare(
+						Result16, Expected16, uWide * sizeof(uint16_t)) ||
+					Result16[uWide] || (Result16[uOutputSize] != 0xCCCCU);
+				uFailure |= uTest;
+				ReportFailure(
+					"Burger::UTF16::translate_from_UTF8() position %u, size %u, pass %u",
+					uTest, static_cast<uint_t>(uPosition),
+					static_cast<uint_t>(uOutputSize), uPass);
+
+				Burger::memory_set(Result32, 0xCC, sizeof(Result32));
+				if (uPass) {
+					uCount = Burger::UTF32::translate_from_UTF8(
+						Result32, uOutputSize, Source, uLength);
+				} else {
+					uCount = Burger::UTF32::translate_from_UTF8(
+						Result32, uOutputSize, Source);
+				}
+				uTest = (uCount != 100) ||
+					Burger::MemoryCompare(
+						Result32, Expected32, uWide * sizeof(uint32_t)) ||
+					Result32[uWide] || (Result32[uOutputSize] != 0xCCCCCCCCU);
+				uFailure |= uTest;
+				ReportFailure(
+					"Burger::UTF32::translate_from_UTF8() position %u, size %u, pass %u",
+					uTest, static_cast<uint_t>(uPosition),
+					static_cast<uint_t>(uOutputSize), uPass);
+
+				// Back to UTF8, only check the bytes that fit
+				Expected16[100] = 0;
+				Expected32[100] = 0;
+				Burger::memory_set(Result8, 0xCC, sizeof(Result8));
+				if (uPass) {
+					uCount = Burger::UTF8::from_UTF16(
+						Result8, uOutputSize, Expected16, 100);
+				} else {
+					uCount =
+						Burger::UTF8::from_UTF16(Result8, uOutputSize, Expected16);
+				}
+				uintptr_t uTerminator = Burger::string_length(Result8);
+				uTest = (uCount != uLength) || (uTerminator != uExpected) ||
+					Burger::MemoryCompare(Result8, Source, uTerminator) ||
+					(static_cast<uint8_t>(Result8[uOutputSize]) != 0xCCU);
+				uFailure |= uTest;
+				ReportFailure(
+					"Burger::UTF8::from_UTF16() position %u, size %u, pass %u",
+					uTest, static_cast<uint_t>(uPosition),
+					static_cast<uint_t>(uOutputSize), uPass);
+
+				Burger::memory_set(Result8, 0xCC, sizeof(Result8));
+				if (uPass) {
+					uCount = Burger::UTF8::from_UTF32(
+						Result8, uOutputSize, Expected32, 100);
+				} else {
+					uCount =
+						Burger::UTF8::from_UTF32(Result8, uOutputSize, Expected32);
+				}
+				uTerminator = Burger::string_length(Result8);
+				uTest = (uCount != uLength) || (uTerminator != uExpected) ||
+					Burger::MemoryCompare(Result8, Source, uTerminator) ||
+					(static_cast<uint8_t>(Result8[uOutputSize]) != 0xCCU);
+				uFailure |= uTest;
+				ReportFailure(
+					"Burger::UTF8::from_UTF32() position %u, size %u, pass %u",
+					uTest, static_cast<uint_t>(uPosition),
+					static_cast<uint_t>(uOutputSize), uPass);
+			} while (++uPass < 2);
+		} while (++uSizeIndex < BURGER_ARRAYSIZE(s_OutputSizes));
+	} while (++uPosition < 100);
+	return uFailure;
+}
+
+/***************************************
+
+	Test the ASCII scanning functions shared by the code page converters
+
+***************************************/
+
+static uint_t BURGER_API TestASCIISpan(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+	char Buffer[80];
+	Burger::memory_set(Buffer, 'x', sizeof(Buffer));
+
+	// Place a high ASCII character at every position
+	uintptr_t uPosition = 0;
+	do {
+		Buffer[uPosition] = static_cast<char>(0x80U + uPosition);
+		uintptr_t uLength = 0;
+		do {
+			const uintptr_t uExpected =
+				(uPosition < uLength) ? uPosition : uLength;
+			uint_t uTest = Burger::ASCII_span(Buffer, uLength) != uExpected;
+			uFailure |= uTest;
+			ReportFailure("Burger::ASCII_span(Buffer, %u) position %u",
+				uTest, static_cast<uint_t>(uLength),
+				static_cast<uint_t>(uPosition));
+
+			uTest = Burger::count_high_ASCII(Buffer, uLength) !=
+				((uPosition < uLength) ? 1U : 0U);
+			uFailure |= uTest;
+			ReportFailure("Burger::count_high_ASCII(Buffer, %u) position %u",
+				uTest, static_cast<uint_t>(uLength),
+				static_cast<uint_t>(uPosition));
+		} while (++uLength <= sizeof(Buffer));
+		Buffer[uPosition] = 'x';
+	} while (++uPosition < sizeof(Buffer));
+
+	// Count every high ASCII character in a large buffer, enough to overflow
+	// 8 bit vector counters
+	const uintptr_t kSize = 16 * 300 + 7;
+	uint8_t* pLarge = static_cast<uint8_t*>(Burger::allocate_memory(kSize));
+	if (pLarge) {
+		uintptr_t uExpected = 0;
+		uintptr_t i = 0;
+		do {
+			const uint8_t uValue = static_cast<uint8_t>(i * 7U);
+			pLarge[i] = uValue;
+			uExpected += uValue >> 7U;
+		} while (++i < kSize);
+		const uint_t uTest = Burger::count_high_ASCII(
+			reinterpret_cast<const char*>(pLarge), kSize) != uExpected;
+		uFailure |= uTest;
+		ReportFailure("Burger::count_high_ASCII(pLarge, %u)", uTest,
+			static_cast<uint_t>(kSize));
+		Burger::free_memory(pLarge);
+	}
+	return uFailure;
+}
+
+/***************************************
+
+	Test the bulk code page conversions against the single character
+	versions on strings long enough to use the vector paths.
+
+***************************************/
+
+typedef uintptr_t(BURGER_API* FromCharProc)(
+	char* pOutput, uint_t uInput) BURGER_NOEXCEPT;
+typedef uintptr_t(BURGER_API* FromStringProc)(
+	char* pOutput, uintptr_t uOutputSize, const char* pInput) BURGER_NOEXCEPT;
+typedef uintptr_t(BURGER_API* FromBufferProc)(char* pOutput,
+	uintptr_t uOutputSize, const char* pInput,
+	uintptr_t uInputSize) BURGER_NOEXCEPT;
+typedef uintptr_t(BURGER_API* SizeProc)(
+	const char* pInput, uintptr_t uInputSize) BURGER_NOEXCEPT;
+typedef uintptr_t(BURGER_API* ToBufferProc)(char* pOutput,
+	uintptr_t uOutputSize, const char* pInput,
+	uintptr_t uInputSize) BURGER_NOEXCEPT;
+
+struct CodePageTest_t {
+	const char* m_pName;
+	FromCharProc m_pFromChar;
+	FromStringProc m_pFromString;
+	FromBufferProc m_pFromBuffer;
+	SizeProc m_pSize;
+	ToBufferProc m_pToBuffer;
+};
+
+static const CodePageTest_t g_CodePageTests[] = {
+	{"ISOLatin1", Burger::UTF8::FromISOLatin1, Burger::UTF8::FromISOLatin1,
+		Burger::UTF8::FromISOLatin1, Burger::UTF8::GetISOLatin1Size,
+		Burger::ISOLatin1::translate_from_UTF8},
+	{"Win1252", Burger::UTF8::FromWin1252, Burger::UTF8::FromWin1252,
+		Burger::UTF8::FromWin1252, Burger::UTF8::GetWin1252Size,
+		Burger::Win1252::translate_from_UTF8},
+	{"Win437", Burger::UTF8::FromWin437, Burger::UTF8::FromWin437,
+		Burger::UTF8::FromWin437, Burger::UTF8::GetWin437Size,
+		Burger::Win437::translate_from_UTF8},
+	{"MacRomanUS", Burger::UTF8::FromMacRomanUS, Burger::UTF8::FromMacRomanUS,
+		Burger::UTF8::FromMacRomanUS, Burger::UTF8::GetMacRomanUSSize,
+		Burger::MacRomanUS::translate_from_UTF8}};
+
+static uint_t BURGER_API TestCodePageBulk(void) BURGER_NOEXCEPT
+{
+	uint_t uFailure = 0;
+	char Source[72];
+	char Expected[72 * 4];
+	char Result[72 * 4 + 8];
+
+	const CodePageTest_t* pWork = g_CodePageTests;
+	uintptr_t uCount = BURGER_ARRAYSIZE(g_CodePageTests);
+	do {
+		// Insert two high ASCII characters at different positions
+		uintptr_t uPosition = 0;
+		do {
+			uintptr_t uExpectedLength = 0;
+			uintptr_t i = 0;
+			do {
+				uint_t uChar = 'a' + static_cast<uint_t>(i % 26U);
+				if ((i == uPosition) || (i == (uPosition * 3U + 5U))) {
+					// 0xC0-0xFF map to unique UTF8 tokens in every code page
+					uChar = 0xC0U + static_cast<uint_t>((uPosition + i) & 0x3FU);
+				}
+				Source[i] = static_cast<char>(uChar);
+				uExpectedLength +=
+					pWork->m_pFromChar(Expected + uExpectedLength, uChar);
+			} while (++i < 71);
+			Source[71] = 0;
+			Expected[uExpectedLength] = 0;
+
+			uint_t uTest = pWork->m_pSize(Source, 71) != uExpectedLength;
+			uFailure |= uTest;
+			ReportFailure("Burger::UTF8::Get%sSize() position %u", uTest,
+				pWork->m_pName, static_cast<uint_t>(uPosition));
+
+			static const uintptr_t s_OutputSizes[] = {
+				72 * 4 + 1, 80, 65, 17, 1, 0};
+			uintptr_t uSizeIndex = 0;
+			do {
+				const uintptr_t uOutputSize = s_OutputSizes[uSizeIndex];
+				uint_t uPass = 0;
+				do {
+					Burger::memory_set(Result, 0x7E, sizeof(Result));
+					uintptr_t uLength;
+					if (uPass) {
+						uLength = pWork->m_pFromBuffer(
+							Result, uOutputSize, Source, 71);
+					} else {
+						uLength =
+							pWork->m_pFromString(Result, uOutputSize, Source);
+					}
+					uTest = uLength != uExpectedLength;
+					if (uOutputSize) {
+						// Bytes that fit must match, then a terminating zero
+						uintptr_t uValid = uOutputSize - 1;
+						if (uValid > uExpectedLength) {
+							uValid = uExpectedLength;
+						}
+						uTest |= (Burger::MemoryCompare(
+									  Result, Expected, uValid) != 0) ||
+							Result[uValid] || (Result[uOutputSize] != 0x7E);
+					} else {
+						uTest |= Result[0] != 0x7E;
+					}
+					uFailure |= uTest;
+					ReportFailure(
+						"Burger::UTF8::From%s() position %u, size %u, pass %u",
+						uTest, pWork->m_pName, static_cast<uint_t>(uPosition),
+						static_cast<uint_t>(uOutputSize), uPass);
+				} while (++uPass < 2);
+
+				// Convert back from UTF8
+				Burger::memory_set(Result, 0x7E, sizeof(Result));
+				const uintptr_t uLength = pWork->m_pToBuffer(
+					Result, uOutputSize, Expected, uExpectedLength);
+				uTest = uLength != 71;
+				if (uOutputSize) {
+					uintptr_t uValid = uOutputSize - 1;
+					if (uValid > 71) {
+						uValid = 71;
+					}
+					uTest |=
+						(Burger::MemoryCompare(Result, Source, uValid) != 0) ||
+						Result[uValid] || (Result[uOutputSize] != 0x7E);
+				}
+				uFailure |= uTest;
+				ReportFailure(
+					"Burger::%s::translate_from_UTF8() position %u, size %u",
+					uTest, pWork->m_pName, static_cast<uint_t>(uPosition),
+					static_cast<uint_t>(uOutputSize));
+			} while (++uSizeIndex < BURGER_ARRAYSIZE(s_OutputSizes));
+		} while (++uPosition < 71);
+		++pWork;
+	} while (--uCount);
+	return uFailure;
+}
+
+/***************************************
+
+	Time UTF8 validation and conversion of mostly ASCII text, and the
+	conversion of a code page to UTF8
+
+***************************************/
+
+static void BURGER_API TimeUTF8(void) BURGER_NOEXCEPT
+{
+	const uintptr_t kTextSize = 1048576;
+	char* pText = static_cast<char*>(Burger::allocate_memory(kTextSize + 1));
+	uint16_t* pUTF16 = static_cast<uint16_t*>(
+		Burger::allocate_memory((kTextSize + 1) * sizeof(uint16_t)));
+	if (pText && pUTF16) {
+		// Mostly ASCII, with a 2 byte character on every line
+		uintptr_t i = 0;
+		do {
+			if ((i & 63U) == 62U) {
+				pText[i] = static_cast<char>(0xC3);
+				pText[i + 1] = static_cast<char>(0xA9);
+				++i;
+			} else {
+				pText[i] = static_cast<char>('a' + (i % 26U));
+			}
+		} while (++i < kTextSize);
+		pText[kTextSize] = 0;
+
+		const double dFrequency = static_cast<double>(
+			Burger::Tick::get_high_precision_frequency());
+		const double dMegabytes = 64.0 * static_cast<double>(kTextSize) /
+			(1024.0 * 1024.0);
+
+		uint_t uValid = 0;
+		uint_t uCount = 64;
+		uint64_t uMark = Burger::Tick::read_high_precision();
+		do {
+			uValid += Burger::UTF8::is_valid(pText, kTextSize);
+		} while (--uCount);
+		const uint64_t uValidate = Burger::Tick::read_high_precision() - uMark;
+
+		uintptr_t uLength = 0;
+		uCount = 64;
+		uMark = Burger::Tick::read_high_precision();
+		do {
+			uLength += Burger::UTF16::translate_from_UTF8(
+				pUTF16, kTextSize + 1, pText, kTextSize);
+		} while (--uCount);
+		const uint64_t uToUTF16 = Burger::Tick::read_high_precision() - uMark;
+
+		uCount = 64;
+		uMark = Burger::Tick::read_high_precision();
+		do {
+			uLength += Burger::UTF8::from_UTF16(pText, kTextSize + 1, pUTF16);
+		} while (--uCount);
+		const uint64_t uFromUTF16 = Burger::Tick::read_high_precision() - uMark;
+
+		// Mostly ASCII Win1252 text
+		char* pWin1252 = reinterpret_cast<char*>(pUTF16);
+		i = 0;
+		do {
+			pWin1252[i] = ((i & 63U) == 62U) ?
+				static_cast<char>(0xE9) :
+				static_cast<char>('a' + (i % 26U));
+		} while (++i < kTextSize);
+
+		uCount = 64;
+		uMark = Burger::Tick::read_high_precision();
+		do {
+			uLength += Burger::UTF8::GetWin1252Size(pWin1252, kTextSize);
+		} while (--uCount);
+		const uint64_t uWin1252Size =
+			Burger::Tick::read_high_precision() - uMark;
+
+		uCount = 64;
+		uMark = Burger::Tick::read_high_precision();
+		do {
+			uLength += Burger::UTF8::FromWin1252(
+				pText, kTextSize + 1, pWin1252, kTextSize);
+		} while (--uCount);
+		const uint64_t uFromWin1252 =
+			Burger::Tick::read_high_precision() - uMark;
+
+		Message("UTF8::GetWin1252Size %8.1f MB/s, UTF8::FromWin1252 %8.1f MB/s",
+			dMegabytes * dFrequency / static_cast<double>(uWin1252Size),
+			dMegabytes * dFrequency / static_cast<double>(uFromWin1252));
+
+		Message(
+			"UTF8::is_valid %8.1f MB/s, UTF16::translate_from_UTF8 %8.1f MB/s, UTF8::from_UTF16 %8.1f MB/s (%u, %u)",
+			dMegabytes * dFrequency / static_cast<double>(uValidate),
+			dMegabytes * dFrequency / static_cast<double>(uToUTF16),
+			dMegabytes * dFrequency / static_cast<double>(uFromUTF16), uValid,
+			static_cast<uint_t>(uLength));
+	}
+	Burger::free_memory(pUTF16);
+	Burger::free_memory(pText);
+}
+
 /***************************************
 
 	Perform the tests for the macros and compiler settings
@@ -1611,5 +2115,13 @@ int BURGER_API TestCharset(uint_t uVerbose) BURGER_NOEXCEPT
 	uFailure |= TestUTF16IsValid();
 	uFailure |= TestUTF16();
 	uFailure |= TestUTF32();
+	uFailure |= TestUTF8IsValid();
+	uFailure |= TestUTFTranscode();
+	uFailure |= TestASCIISpan();
+	uFailure |= TestCodePageBulk();
+
+	if (!uFailure && (uVerbose & VERBOSE_TIME)) {
+		TimeUTF8();
+	}
 	return static_cast<int>(uFailure);
 }